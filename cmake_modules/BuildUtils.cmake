@@ -331,3 +331,38 @@ function(add_paimon_test REL_TEST_NAME)
                   ${PCH_ARGS}
                   ${ARG_UNPARSED_ARGUMENTS})
 endfunction()
+
+# Adding benchmarks, they are googletest executables built only with PAIMON_BUILD_BENCHMARKS and
+# are not added to ctest, so they never run as part of the unit tests.
+#
+# \arg SOURCES the C++ source files to compile into the benchmark executable
+# \arg STATIC_LINK_LIBS the libraries to link the benchmark executable with
+function(add_paimon_benchmark REL_BENCHMARK_NAME)
+    set(options)
+    set(one_value_args)
+    set(multi_value_args SOURCES STATIC_LINK_LIBS)
+    cmake_parse_arguments(ARG
+                          "${options}"
+                          "${one_value_args}"
+                          "${multi_value_args}"
+                          ${ARGN})
+    if(ARG_UNPARSED_ARGUMENTS)
+        message(SEND_ERROR "Error: unrecognized arguments: ${ARG_UNPARSED_ARGUMENTS}")
+    endif()
+
+    if(NOT PAIMON_BUILD_BENCHMARKS)
+        return()
+    endif()
+    get_filename_component(BENCHMARK_NAME ${REL_BENCHMARK_NAME} NAME_WE)
+    set(BENCHMARK_NAME "paimon-${BENCHMARK_NAME}")
+    # Make sure the executable name contains only hyphens, not underscores
+    string(REPLACE "_" "-" BENCHMARK_NAME ${BENCHMARK_NAME})
+    message(STATUS ${BENCHMARK_NAME})
+    add_executable(${BENCHMARK_NAME} ${ARG_SOURCES})
+    target_link_libraries(${BENCHMARK_NAME} PRIVATE ${ARG_STATIC_LINK_LIBS})
+    if(CMAKE_CXX_COMPILER_ID STREQUAL "Clang")
+        target_compile_options(${BENCHMARK_NAME} PRIVATE -Wno-global-constructors)
+    endif()
+    target_compile_options(${BENCHMARK_NAME} PRIVATE -fno-access-control)
+    add_dependencies(paimon-benchmarks ${BENCHMARK_NAME})
+endfunction()
@@ -100,6 +100,8 @@ if("${CMAKE_SOURCE_DIR}" STREQUAL "${CMAKE_CURRENT_SOURCE_DIR}")
 
     define_option(PAIMON_BUILD_TESTS "Build the Paimon googletest unit tests" OFF)
 
+    define_option(PAIMON_BUILD_BENCHMARKS "Build the Paimon googletest based benchmarks" OFF)
+
     if(PAIMON_BUILD_SHARED)
         set(PAIMON_TEST_LINKAGE_DEFAULT "shared")
     else()
@@ -144,6 +144,12 @@ struct PAIMON_EXPORT Options {
     /// compaction of manifest, default value is 16MB.
     static const char MANIFEST_FULL_COMPACTION_FILE_SIZE[];
 
+    /// "manifest.cache.max-memory-size" - Max memory of the process-wide cache of decoded
+    /// manifest lists and manifest files, which is shared by the scans of all tables. The cache is
+    /// sized by the first scan using it, tables with a positive value only share it. 0 disables
+    /// the cache for the table. Default value is 0.
+    static const char MANIFEST_CACHE_MAX_MEMORY_SIZE[];
+
     /// "source.split.target-size" - Target size of a source split when scanning a bucket. Default
     /// value is 128MB.
     static const char SOURCE_SPLIT_TARGET_SIZE[];
@@ -164,6 +170,21 @@ struct PAIMON_EXPORT Options {
     /// The default value is 1024.
     static const char READ_BATCH_SIZE[];
 
+    /// "read.merge.section-parallelism" - The max number of non-overlapping sections of a split
+    /// merged concurrently in merge-on-read, "1" merges sections one after another on the reading
+    /// thread. The default value is 4.
+    static const char READ_MERGE_SECTION_PARALLELISM[];
+
+    /// "read.file-lookahead" - The max number of upcoming data files of a split opened in the
+    /// background (footer, schema, index and deletion vector) and warmed with their first batch
+    /// while the current file is read. "0" opens all files before reading. The default value is 0.
+    static const char READ_FILE_LOOKAHEAD[];
+
+    /// "read.file-lookahead.memory-budget" - Upper bound of the total size of the data files
+    /// opened ahead by "read.file-lookahead"; at least one file is always opened ahead.
+    /// The default value is 64 mb.
+    static const char READ_FILE_LOOKAHEAD_MEMORY_BUDGET[];
+
     /// "write.batch-size" - Write batch size for any file format if it supports.
     /// The default value is 1024.
     static const char WRITE_BATCH_SIZE[];
@@ -172,6 +193,34 @@ struct PAIMON_EXPORT Options {
     /// on-disk file. The default value is 256 mb
     static const char WRITE_BUFFER_SIZE[];
 
+    /// "write-buffer-total-size" - Total memory of the write buffers of all writers of a
+    /// FileStoreWrite. Once exceeded, the largest write buffers are flushed first; each write
+    /// buffer still flushes at "write-buffer-size". "0" means no shared limit. The default value
+    /// is 0.
+    static const char WRITE_BUFFER_TOTAL_SIZE[];
+
+    /// "write-buffer-spillable" - Whether a full write buffer of a primary key table is sorted
+    /// and spilled to a local file instead of being flushed, so that spilled runs and the last
+    /// buffer are merged into one large level 0 file at flush time. The default value is false.
+    static const char WRITE_BUFFER_SPILLABLE[];
+
+    /// "write-buffer-spill.max-disk-size" - The max local disk size of spilled runs of a writer,
+    /// the write buffer is flushed once it is reached. The default value is unlimited.
+    static const char WRITE_BUFFER_SPILL_MAX_DISK_SIZE[];
+
+    /// "write-buffer-spill.dir" - Local directory of spilled runs. The default value is the
+    /// temporary directory of the system.
+    static const char WRITE_BUFFER_SPILL_DIR[];
+
+    /// "local-sort.max-num-file-handles" - The max number of spilled runs merged at once, the
+    /// write buffer is flushed once a writer has spilled this number of runs. Should be greater
+    /// than 1. The default value is 128.
+    static const char LOCAL_SORT_MAX_NUM_FILE_HANDLES[];
+
+    /// "spill-compression" - Compression of spilled runs, "none", "lz4" or "zstd". The default
+    /// value is "zstd".
+    static const char SPILL_COMPRESSION[];
+
     /// "snapshot.num-retained.min" - The minimum number of completed snapshots to retain. Should be
     /// greater than or equal to 1. Default value is 10
     static const char SNAPSHOT_NUM_RETAINED_MIN[];
@@ -215,6 +264,11 @@ struct PAIMON_EXPORT Options {
     /// "min-heap", "loser-tree". Default value is "loser-tree".
     static const char SORT_ENGINE[];
 
+    /// "sort.normalized-key.enabled" - Whether sort merge readers encode the leading primary key
+    /// fields of each record into a normalized key once, and compare the normalized keys before
+    /// comparing keys field by field. Default value is "true".
+    static const char SORT_NORMALIZED_KEY_ENABLED[];
+
     /// "ignore-delete" - Whether to ignore delete records. Default value is "false".
     static const char IGNORE_DELETE[];
 
@@ -228,6 +282,12 @@ struct PAIMON_EXPORT Options {
     /// Default value is false.
     static const char DELETION_VECTORS_ENABLED[];
 
+    /// "deletion-vectors.cache.max-memory-size" - Max memory of the process-wide cache of decoded
+    /// deletion vectors, which is shared by the reads of all tables. The cache is sized by the
+    /// first read using it, tables with a positive value only share it. 0 disables the cache for
+    /// the table. Default value is 0.
+    static const char DELETION_VECTORS_CACHE_MAX_MEMORY_SIZE[];
+
     ///  @note `CHANGELOG_PRODUCER` currently only support `none`
     ///
     /// "changelog-producer" - Whether to double write to a changelog file. This changelog file
@@ -258,6 +318,10 @@ struct PAIMON_EXPORT Options {
 
     /// "file-index.read.enabled" - Whether enabled read file index. Default value is "true".
     static const char FILE_INDEX_READ_ENABLED[];
+    /// "file-index.in-manifest-threshold" - The threshold to store file index bytes in manifest.
+    /// Indexes of a data file larger than it are written to a separate index file. Default value
+    /// is "500 bytes".
+    static const char FILE_INDEX_IN_MANIFEST_THRESHOLD[];
 
     /// "data-file.external-paths" - The external paths where the data of this table will be
     /// written, multiple elements separated by commas.
@@ -287,6 +351,48 @@ struct PAIMON_EXPORT Options {
     /// "global-index.external-path" - Global index root directory, if not set, the global index
     /// files will be stored under the index directory.
     static const char GLOBAL_INDEX_EXTERNAL_PATH[];
+    /// "write-only" - If set to "true", compactions will be skipped by writers, a dedicated
+    /// compaction job is expected to compact the table. Default value is "false".
+    static const char WRITE_ONLY[];
+    /// "num-sorted-run.compaction-trigger" - The sorted run number to trigger compaction of
+    /// primary key table. Includes level0 files (one file one sorted run) and high-level runs (one
+    /// level one sorted run). Default value is 5.
+    static const char NUM_SORTED_RUNS_COMPACTION_TRIGGER[];
+    /// "num-sorted-run.stop-trigger" - The number of sorted runs that trigger the stopping of
+    /// writes, writers wait for the running compaction to finish. Default value is
+    /// "num-sorted-run.compaction-trigger" + 3.
+    static const char NUM_SORTED_RUNS_STOP_TRIGGER[];
+    /// "num-levels" - Total level number of primary key table, for example, there are 3 levels,
+    /// including 0, 1, 2 levels. Default value is "num-sorted-run.compaction-trigger" + 1.
+    static const char NUM_LEVELS[];
+    /// "compaction.max-size-amplification-percent" - The size amplification is defined as the
+    /// amount (in percentage) of additional storage needed to store a single byte of data in the
+    /// merge tree for primary key table. Default value is 200.
+    static const char COMPACTION_MAX_SIZE_AMPLIFICATION_PERCENT[];
+    /// "compaction.size-ratio" - Percentage flexibility while comparing sorted run size for
+    /// primary key table. If the candidate sorted run(s) size is 1% smaller than the next sorted
+    /// run's size, then include next sorted run into this candidate set. Default value is 1.
+    static const char COMPACTION_SIZE_RATIO[];
+    /// "compaction.min.file-num" - For file set [f_0,...,f_N], the minimum file number to trigger
+    /// a compaction for append table. Default value is 5.
+    static const char COMPACTION_MIN_FILE_NUM[];
+    /// "compaction.max.file-num" - For file set [f_0,...,f_N], the maximum file number to trigger
+    /// a compaction for append table, even if sum(size(f_i)) < targetFileSize. This value avoids
+    /// pending too much small files. Default value is 50.
+    static const char COMPACTION_MAX_FILE_NUM[];
+    /// "compaction.max-concurrent-tasks" - The maximum number of append table compaction tasks
+    /// running concurrently in one write, compaction of other buckets is postponed to their next
+    /// trigger once the limit is reached. Default value is unlimited.
+    static const char COMPACTION_MAX_CONCURRENT_TASKS[];
+    /// "write.row-to-batch.thread-number" - The number of threads converting merged key values to
+    /// arrow batches when a primary key table flushes the write buffer or compacts. Default value
+    /// is 1.
+    static const char WRITE_ROW_TO_BATCH_THREAD_NUMBER[];
+    /// "write.stats-in-flight.enabled" - Whether to collect the column stats of data files from the
+    /// written batches rather than reading them back from the closed files. Default value is
+    /// "true" for "orc" and "parquet" files, whose stats extractors report the same stats, and
+    /// "false" for other formats.
+    static const char WRITE_STATS_IN_FLIGHT_ENABLED[];
 };
 
 static constexpr int64_t BATCH_WRITE_COMMIT_IDENTIFIER = std::numeric_limits<int64_t>::max();
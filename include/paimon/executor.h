@@ -19,17 +19,35 @@
 #include <cstdint>
 #include <functional>
 #include <memory>
+#include <utility>
 
 #include "paimon/visibility.h"
 
 namespace paimon {
 class Executor;
+class Metrics;
 
 static constexpr uint32_t DEFAULT_EXECUTOR_THREAD_COUNT = 4;
 
-/// Get a system wide singleton executor.
+/// Priority of a task added to an `Executor`.
+enum class TaskPriority {
+    /// Latency sensitive tasks, run before any other queued task.
+    HIGH = 0,
+    /// Foreground tasks such as reads, the priority of `Executor::Add(func)`.
+    NORMAL = 1,
+    /// Background tasks such as compaction, only run when no other task is queued.
+    LOW = 2,
+};
+
+/// Get a system wide singleton executor. Unless replaced by `SetGlobalDefaultExecutor()`, it is a
+/// default executor with `std::thread::hardware_concurrency()` threads created on the first call.
 PAIMON_EXPORT std::shared_ptr<Executor> GetGlobalDefaultExecutor();
 
+/// Replace the system wide singleton executor, e.g. with an executor sharing the threads of the
+/// embedding engine or a default executor with fewer threads. Executors already obtained from
+/// `GetGlobalDefaultExecutor()` are not affected. Passing nullptr restores the default one.
+PAIMON_EXPORT void SetGlobalDefaultExecutor(const std::shared_ptr<Executor>& executor);
+
 /// Create a default implementation of executor with `DEFAULT_EXECUTOR_THREAD_COUNT`.
 PAIMON_EXPORT std::unique_ptr<Executor> CreateDefaultExecutor();
 
@@ -51,6 +69,21 @@ class PAIMON_EXPORT Executor {
     /// @note This method should be thread-safe and can be called from multiple threads
     /// simultaneously.
     virtual void Add(std::function<void()> func) = 0;
+
+    /// Add a task to the executor with priority. The default implementation ignores the priority.
+    ///
+    /// @param func The task to be executed.
+    /// @param priority The priority of the task, queued tasks of higher priority run first.
+    virtual void Add(std::function<void()> func, TaskPriority priority) {
+        Add(std::move(func));
+    }
+
+    /// Get the metrics of the executor, nullptr if not supported. The default executor reports
+    /// "queuedTasks", "completedTasks", "stolenTasks", "taskQueueLatencyTotal" and
+    /// "taskQueueLatencyMax" (latencies in microseconds, from adding to starting a task).
+    virtual std::shared_ptr<Metrics> GetMetrics() const {
+        return nullptr;
+    }
 };
 
 }  // namespace paimon
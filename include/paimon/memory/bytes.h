@@ -57,6 +57,17 @@ class PAIMON_EXPORT Bytes {
     /// @param pool Memory pool to use for allocation.
     Bytes(const std::string& str, MemoryPool* pool);
 
+    /// Constructor that takes over memory already obtained from a memory pool.
+    ///
+    /// The memory is not copied and is returned to `pool` with `MemoryPool::Free()` on
+    /// destruction. A pool whose `Free()` does nothing turns the object into a view of memory
+    /// owned elsewhere, e.g. a memory mapped file.
+    ///
+    /// @param data Pointer to the memory.
+    /// @param size Size of the memory in bytes.
+    /// @param pool Memory pool the memory is returned to.
+    Bytes(char* data, size_t size, MemoryPool* pool);
+
     /// Create a copy of existing Bytes with specified size.
     ///
     /// Creates a new Bytes object by copying data from an existing Bytes object.
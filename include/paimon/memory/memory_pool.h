@@ -31,10 +31,25 @@ namespace paimon {
 
 class MemoryPool;
 
+/// Implementations of memory pool.
+enum class MemoryPoolType {
+    /// Every block is allocated from and freed to the system allocator.
+    SYSTEM = 1,
+    /// Blocks up to 32KB are served from size-class slabs with per-thread caches, larger blocks
+    /// come from the system allocator. Suits workloads with many small allocations from
+    /// multiple threads, at the cost of keeping freed slabs until the pool is destroyed.
+    SLAB = 2,
+};
+
 /// Create a default implementation of memory pool.
 /// @return Unique pointer to a newly created `MemoryPool` instance.
 PAIMON_EXPORT std::unique_ptr<MemoryPool> GetMemoryPool();
 
+/// Create a memory pool of the specified implementation.
+/// @param type Implementation of the memory pool.
+/// @return Unique pointer to a newly created `MemoryPool` instance.
+PAIMON_EXPORT std::unique_ptr<MemoryPool> GetMemoryPool(MemoryPoolType type);
+
 /// Get a system-wide singleton memory pool.
 /// @return Shared pointer to the singleton `MemoryPool` instance.
 PAIMON_EXPORT std::shared_ptr<MemoryPool> GetDefaultPool();
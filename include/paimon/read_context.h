@@ -23,6 +23,7 @@
 #include <string>
 #include <vector>
 
+#include "paimon/memory/memory_pool.h"
 #include "paimon/predicate/predicate.h"
 #include "paimon/result.h"
 #include "paimon/type_fwd.h"
@@ -285,6 +286,12 @@ class PAIMON_EXPORT ReadContextBuilder {
     /// @note If not set, the default system memory pool will be used.
     ReadContextBuilder& WithMemoryPool(const std::shared_ptr<MemoryPool>& memory_pool);
 
+    /// Set a new memory pool of the specified implementation for memory management, e.g.
+    /// `MemoryPoolType::SLAB` for the many small allocations of decoding and merging.
+    /// @param type Implementation of the memory pool, which is owned by the read context.
+    /// @return Reference to this builder for method chaining.
+    ReadContextBuilder& WithMemoryPoolType(MemoryPoolType type);
+
     /// Set custom executor for task execution.
     /// @param executor The executor to use.
     /// @return Reference to this builder for method chaining.
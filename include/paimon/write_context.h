@@ -23,6 +23,7 @@
 #include <string>
 #include <vector>
 
+#include "paimon/memory/memory_pool.h"
 #include "paimon/result.h"
 #include "paimon/type_fwd.h"
 #include "paimon/visibility.h"
@@ -158,6 +159,12 @@ class PAIMON_EXPORT WriteContextBuilder {
     /// @return Reference to this builder for method chaining.
     WriteContextBuilder& WithMemoryPool(const std::shared_ptr<MemoryPool>& memory_pool);
 
+    /// Set a new memory pool of the specified implementation for memory management, e.g.
+    /// `MemoryPoolType::SLAB` for the many small allocations of write buffers and file writers.
+    /// @param type Implementation of the memory pool, which is owned by the write context.
+    /// @return Reference to this builder for method chaining.
+    WriteContextBuilder& WithMemoryPoolType(MemoryPoolType type);
+
     /// Set custom executor for task execution.
     /// @param executor The executor to use.
     /// @return Reference to this builder for method chaining.
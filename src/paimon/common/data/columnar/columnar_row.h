@@ -137,6 +137,16 @@ class ColumnarRow : public InternalRow {
         return fmt::format("ColumnarRow, row_id {}", row_id_);
     }
 
+    /// Returns the array of field `pos`, which allows callers on hot paths (e.g. key comparison)
+    /// to read the arrow buffers directly instead of through the virtual getters.
+    const arrow::Array* GetFieldArray(int32_t pos) const {
+        return array_vec_[pos];
+    }
+
+    int64_t GetRowId() const {
+        return row_id_;
+    }
+
  private:
     /// @note `struct_array_` is the data holder for columnar row, ensure that the data life
     /// cycle is consistent with the columnar row, `array_vec_` maybe a subset of
@@ -15,17 +15,23 @@
  */
 
 #include <atomic>
+#include <chrono>
 #include <cstdint>
 #include <future>
 #include <memory>
+#include <mutex>
+#include <thread>
 #include <utility>
 #include <vector>
 
 #include "gtest/gtest.h"
+#include "paimon/common/executor/executor_metrics.h"
 #include "paimon/common/executor/future.h"
 #include "paimon/executor.h"
+#include "paimon/metrics.h"
 #include "paimon/result.h"
 #include "paimon/status.h"
+#include "paimon/testing/utils/testharness.h"
 
 namespace paimon::test {
 
@@ -80,4 +86,78 @@ TEST(DefaultExecutorTest, TestViaWithException) {
     ASSERT_THROW(future.get(), std::runtime_error);
 }
 
+TEST(DefaultExecutorTest, TestPriority) {
+    auto executor = CreateDefaultExecutor(/*thread_count=*/1);
+    std::promise<void> blocker;
+    std::shared_future<void> blocked = blocker.get_future().share();
+    executor->Add([blocked]() { blocked.wait(); });
+
+    std::mutex mutex;
+    std::vector<int32_t> order;
+    auto record = [&mutex, &order](int32_t value) {
+        return [&mutex, &order, value]() {
+            std::lock_guard<std::mutex> lock(mutex);
+            order.push_back(value);
+        };
+    };
+    executor->Add(record(2), TaskPriority::LOW);
+    executor->Add(record(1));
+    executor->Add(record(0), TaskPriority::HIGH);
+    blocker.set_value();
+    // tasks queued before destruction are still executed
+    executor.reset();
+    ASSERT_EQ(order, std::vector<int32_t>({0, 1, 2}));
+}
+
+TEST(DefaultExecutorTest, TestWorkStealingAndMetrics) {
+    std::shared_ptr<Executor> executor = CreateDefaultExecutor(/*thread_count=*/4);
+    std::atomic<int32_t> count = 0;
+    std::vector<std::future<void>> futures;
+    std::mutex mutex;
+    // tasks added from a worker go to its own deque, idle workers steal them
+    Via(executor.get(), [&]() {
+        for (int32_t i = 0; i < 100; ++i) {
+            auto future = Via(executor.get(), [&count]() {
+                std::this_thread::sleep_for(std::chrono::milliseconds(1));
+                count++;
+            });
+            std::lock_guard<std::mutex> lock(mutex);
+            futures.push_back(std::move(future));
+        }
+    }).get();
+    Wait(futures);
+    ASSERT_EQ(100, count.load());
+
+    // futures are fulfilled inside the tasks, wait for the tasks to be counted as completed
+    std::shared_ptr<Metrics> metrics;
+    uint64_t completed = 0;
+    for (int32_t retry = 0; retry < 1000 && completed < 101; ++retry) {
+        metrics = executor->GetMetrics();
+        ASSERT_TRUE(metrics);
+        ASSERT_OK_AND_ASSIGN(completed, metrics->GetCounter(ExecutorMetrics::COMPLETED_TASKS));
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    ASSERT_EQ(101, completed);
+    ASSERT_OK_AND_ASSIGN(uint64_t stolen, metrics->GetCounter(ExecutorMetrics::STOLEN_TASKS));
+    ASSERT_GT(stolen, 0);
+    ASSERT_OK_AND_ASSIGN(uint64_t queued, metrics->GetCounter(ExecutorMetrics::QUEUED_TASKS));
+    ASSERT_EQ(0, queued);
+    ASSERT_OK_AND_ASSIGN(uint64_t latency_total,
+                         metrics->GetCounter(ExecutorMetrics::TASK_QUEUE_LATENCY_TOTAL));
+    ASSERT_OK_AND_ASSIGN(uint64_t latency_max,
+                         metrics->GetCounter(ExecutorMetrics::TASK_QUEUE_LATENCY_MAX));
+    ASSERT_GE(latency_total, latency_max);
+}
+
+TEST(DefaultExecutorTest, TestSetGlobalDefaultExecutor) {
+    std::shared_ptr<Executor> executor = CreateDefaultExecutor(/*thread_count=*/1);
+    SetGlobalDefaultExecutor(executor);
+    ASSERT_EQ(executor, GetGlobalDefaultExecutor());
+    SetGlobalDefaultExecutor(nullptr);
+    auto global_executor = GetGlobalDefaultExecutor();
+    ASSERT_TRUE(global_executor);
+    ASSERT_NE(executor, global_executor);
+    ASSERT_EQ(global_executor, GetGlobalDefaultExecutor());
+}
+
 }  // namespace paimon::test
@@ -16,98 +16,237 @@
 
 #include "paimon/executor.h"
 
+#include <algorithm>
+#include <atomic>
+#include <chrono>
 #include <condition_variable>
+#include <deque>
 #include <functional>
 #include <mutex>
-#include <queue>
 #include <thread>
 #include <utility>
 #include <vector>
 
+#include "paimon/common/executor/executor_metrics.h"
+#include "paimon/common/metrics/metrics_impl.h"
+#include "paimon/metrics.h"
+
 namespace paimon {
 
+/// A work-stealing thread pool. Every worker owns a deque of normal priority tasks, tasks added
+/// from a worker go to its own deque and others are distributed round-robin, idle workers steal
+/// from the back of the other deques. High and low priority tasks are kept in two shared lanes,
+/// workers take high priority tasks first and low priority tasks only when no other task is
+/// queued.
 class DefaultExecutor : public Executor {
  public:
     explicit DefaultExecutor(uint32_t thread_count);
     ~DefaultExecutor() override;
 
-    void Add(std::function<void()> func) override;
+    void Add(std::function<void()> func) override {
+        Add(std::move(func), TaskPriority::NORMAL);
+    }
+
+    void Add(std::function<void()> func, TaskPriority priority) override;
+
+    std::shared_ptr<Metrics> GetMetrics() const override;
 
  private:
-    void WorkerThread();
+    struct Task {
+        std::function<void()> func;
+        std::chrono::steady_clock::time_point add_time;
+    };
+
+    struct TaskQueue {
+        std::mutex mutex;
+        std::deque<Task> tasks;
+
+        void Push(Task&& task) {
+            std::lock_guard<std::mutex> lock(mutex);
+            tasks.push_back(std::move(task));
+        }
+
+        bool PopFront(Task* task) {
+            std::lock_guard<std::mutex> lock(mutex);
+            if (tasks.empty()) {
+                return false;
+            }
+            *task = std::move(tasks.front());
+            tasks.pop_front();
+            return true;
+        }
+
+        bool PopBack(Task* task) {
+            std::lock_guard<std::mutex> lock(mutex);
+            if (tasks.empty()) {
+                return false;
+            }
+            *task = std::move(tasks.back());
+            tasks.pop_back();
+            return true;
+        }
+    };
+
+    void WorkerThread(uint32_t index);
+    bool PopTask(uint32_t index, Task* task);
+    void RunTask(Task* task);
+
+    // the executor and index of the worker running on the current thread
+    static thread_local const DefaultExecutor* current_executor_;
+    static thread_local uint32_t current_worker_index_;
 
     uint32_t thread_count_;
-    std::vector<std::thread> workers_;
-    std::queue<std::function<void()>> tasks_;
-    std::mutex queue_mutex_;
+    TaskQueue high_priority_tasks_;
+    std::vector<std::unique_ptr<TaskQueue>> worker_tasks_;
+    TaskQueue low_priority_tasks_;
+    std::atomic<uint32_t> next_worker_ = 0;
+
+    // number of tasks added but not started yet
+    std::atomic<int64_t> queued_tasks_ = 0;
+    std::atomic<uint64_t> completed_tasks_ = 0;
+    std::atomic<uint64_t> stolen_tasks_ = 0;
+    std::atomic<uint64_t> total_queue_latency_us_ = 0;
+    std::atomic<uint64_t> max_queue_latency_us_ = 0;
+
+    // idle workers wait on `condition_`, `idle_workers_` is modified with `sleep_mutex_` held
+    std::mutex sleep_mutex_;
     std::condition_variable condition_;
-    bool stop_ = false;
-    int32_t active_tasks_ = 0;
+    std::atomic<int32_t> idle_workers_ = 0;
+    std::atomic<bool> stop_ = false;
+    std::vector<std::thread> workers_;
 };
 
-DefaultExecutor::DefaultExecutor(uint32_t thread_count) : thread_count_(thread_count) {
+thread_local const DefaultExecutor* DefaultExecutor::current_executor_ = nullptr;
+thread_local uint32_t DefaultExecutor::current_worker_index_ = 0;
+
+DefaultExecutor::DefaultExecutor(uint32_t thread_count)
+    : thread_count_(std::max<uint32_t>(thread_count, 1)) {
+    worker_tasks_.reserve(thread_count_);
     for (uint32_t i = 0; i < thread_count_; ++i) {
-        workers_.emplace_back(&DefaultExecutor::WorkerThread, this);
+        worker_tasks_.push_back(std::make_unique<TaskQueue>());
+    }
+    workers_.reserve(thread_count_);
+    for (uint32_t i = 0; i < thread_count_; ++i) {
+        workers_.emplace_back(&DefaultExecutor::WorkerThread, this, i);
     }
 }
 
 DefaultExecutor::~DefaultExecutor() {
     {
-        std::unique_lock<std::mutex> lock(queue_mutex_);
+        std::unique_lock<std::mutex> lock(sleep_mutex_);
         stop_ = true;
-        condition_.notify_all();
     }
+    condition_.notify_all();
+    // queued tasks are still executed before workers exit
     for (std::thread& worker : workers_) {
         worker.join();
     }
 }
 
-void DefaultExecutor::Add(std::function<void()> func) {
-    if (!func) {
+void DefaultExecutor::Add(std::function<void()> func, TaskPriority priority) {
+    if (!func || stop_) {
         return;
     }
-    {
-        std::unique_lock<std::mutex> lock(queue_mutex_);
-        if (stop_) {
-            return;
+    Task task{std::move(func), std::chrono::steady_clock::now()};
+    // count the task before it is visible, so a worker never sleeps with a queued task
+    ++queued_tasks_;
+    if (priority == TaskPriority::HIGH) {
+        high_priority_tasks_.Push(std::move(task));
+    } else if (priority == TaskPriority::LOW) {
+        low_priority_tasks_.Push(std::move(task));
+    } else if (current_executor_ == this) {
+        worker_tasks_[current_worker_index_]->Push(std::move(task));
+    } else {
+        worker_tasks_[next_worker_.fetch_add(1) % thread_count_]->Push(std::move(task));
+    }
+    if (idle_workers_ > 0) {
+        {
+            // a worker checking `queued_tasks_` holds the mutex until it waits, so the
+            // notification is not lost
+            std::lock_guard<std::mutex> lock(sleep_mutex_);
         }
-        tasks_.emplace(std::move(func));
+        condition_.notify_one();
+    }
+}
+
+bool DefaultExecutor::PopTask(uint32_t index, Task* task) {
+    bool found = high_priority_tasks_.PopFront(task) || worker_tasks_[index]->PopFront(task);
+    for (uint32_t i = 1; !found && i < thread_count_; ++i) {
+        found = worker_tasks_[(index + i) % thread_count_]->PopBack(task);
+        if (found) {
+            ++stolen_tasks_;
+        }
+    }
+    found = found || low_priority_tasks_.PopFront(task);
+    if (found) {
+        --queued_tasks_;
+    }
+    return found;
+}
+
+void DefaultExecutor::RunTask(Task* task) {
+    auto latency = std::chrono::duration_cast<std::chrono::microseconds>(
+                       std::chrono::steady_clock::now() - task->add_time)
+                       .count();
+    auto latency_us = static_cast<uint64_t>(std::max<int64_t>(latency, 0));
+    total_queue_latency_us_ += latency_us;
+    uint64_t max_latency_us = max_queue_latency_us_.load();
+    while (latency_us > max_latency_us &&
+           !max_queue_latency_us_.compare_exchange_weak(max_latency_us, latency_us)) {
     }
-    condition_.notify_one();
+    task->func();
+    // release captured resources before the task is counted as completed
+    task->func = nullptr;
+    ++completed_tasks_;
 }
 
-void DefaultExecutor::WorkerThread() {
+void DefaultExecutor::WorkerThread(uint32_t index) {
+    current_executor_ = this;
+    current_worker_index_ = index;
     while (true) {
-        std::function<void()> task;
-        {
-            std::unique_lock<std::mutex> lock(queue_mutex_);
-            condition_.wait(lock, [this] { return stop_ || !tasks_.empty(); });
-            if (stop_ && tasks_.empty() && active_tasks_ == 0) {
-                condition_.notify_all();
-                return;
-            }
-            if (!tasks_.empty()) {
-                task = std::move(tasks_.front());
-                tasks_.pop();
-                ++active_tasks_;
-            }
+        Task task;
+        if (PopTask(index, &task)) {
+            RunTask(&task);
+            continue;
         }
-        if (task) {
-            task();
-            std::unique_lock<std::mutex> lock(queue_mutex_);
-            --active_tasks_;
-            if (tasks_.empty() && active_tasks_ == 0) {
-                condition_.notify_all();
-            }
+        std::unique_lock<std::mutex> lock(sleep_mutex_);
+        ++idle_workers_;
+        condition_.wait(lock, [this] { return stop_ || queued_tasks_ > 0; });
+        --idle_workers_;
+        if (stop_ && queued_tasks_ == 0) {
+            return;
         }
     }
 }
 
+std::shared_ptr<Metrics> DefaultExecutor::GetMetrics() const {
+    auto metrics = std::make_shared<MetricsImpl>();
+    metrics->SetCounter(ExecutorMetrics::QUEUED_TASKS,
+                        static_cast<uint64_t>(std::max<int64_t>(queued_tasks_, 0)));
+    metrics->SetCounter(ExecutorMetrics::COMPLETED_TASKS, completed_tasks_);
+    metrics->SetCounter(ExecutorMetrics::STOLEN_TASKS, stolen_tasks_);
+    metrics->SetCounter(ExecutorMetrics::TASK_QUEUE_LATENCY_TOTAL, total_queue_latency_us_);
+    metrics->SetCounter(ExecutorMetrics::TASK_QUEUE_LATENCY_MAX, max_queue_latency_us_);
+    return metrics;
+}
+
+namespace {
+std::mutex global_executor_mutex;
+std::shared_ptr<Executor> global_executor;
+}  // namespace
+
 PAIMON_EXPORT std::shared_ptr<Executor> GetGlobalDefaultExecutor() {
-    static uint32_t all_cores = std::thread::hardware_concurrency();
-    static std::shared_ptr<Executor> internal =
-        std::make_shared<DefaultExecutor>(/*thread_count=*/all_cores);
-    return internal;
+    std::lock_guard<std::mutex> lock(global_executor_mutex);
+    if (!global_executor) {
+        uint32_t all_cores = std::thread::hardware_concurrency();
+        global_executor = std::make_shared<DefaultExecutor>(/*thread_count=*/all_cores);
+    }
+    return global_executor;
+}
+
+PAIMON_EXPORT void SetGlobalDefaultExecutor(const std::shared_ptr<Executor>& executor) {
+    std::lock_guard<std::mutex> lock(global_executor_mutex);
+    global_executor = executor;
 }
 
 PAIMON_EXPORT std::unique_ptr<Executor> CreateDefaultExecutor() {
@@ -41,12 +41,14 @@ namespace paimon {
 /// @param executor The executor to run the function on. Must provide an `Add` method for task
 /// submission.
 /// @param func The function to execute asynchronously. Can be any callable object.
+/// @param priority The priority of the task in the executor.
 /// @return std::future<decltype(func())> A future that holds the result of the function
 /// execution.
 ///
 /// @note If `func` returns `void`, the returned future is of type `std::future<void>`.
 template <typename Func>
-auto Via(Executor* executor, Func&& func) -> std::future<decltype(func())> {
+auto Via(Executor* executor, Func&& func, TaskPriority priority = TaskPriority::NORMAL)
+    -> std::future<decltype(func())> {
     using ResultType = decltype(func());
 
     // Check if func is callable (invocable)
@@ -65,18 +67,20 @@ auto Via(Executor* executor, Func&& func) -> std::future<decltype(func())> {
     auto future = promise->get_future();  // Retrieve the future associated with the promise.
 
     // Wrap the task and submit it to the executor.
-    executor->Add([promise, func = std::forward<Func>(func)]() mutable {
-        try {
-            if constexpr (std::is_void_v<ResultType>) {
-                func();
-                promise->set_value();
-            } else {
-                promise->set_value(func());
+    executor->Add(
+        [promise, func = std::forward<Func>(func)]() mutable {
+            try {
+                if constexpr (std::is_void_v<ResultType>) {
+                    func();
+                    promise->set_value();
+                } else {
+                    promise->set_value(func());
+                }
+            } catch (...) {
+                promise->set_exception(std::current_exception());
             }
-        } catch (...) {
-            promise->set_exception(std::current_exception());
-        }
-    });
+        },
+        priority);
 
     return future;
 }
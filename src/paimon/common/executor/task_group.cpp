@@ -0,0 +1,84 @@
+/*
+ * Copyright 2024-present Alibaba Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "paimon/common/executor/task_group.h"
+
+#include <utility>
+
+#include "fmt/format.h"
+
+namespace paimon {
+
+TaskGroup::TaskGroup(const std::shared_ptr<Executor>& executor, TaskPriority priority)
+    : executor_(executor), priority_(priority), state_(std::make_shared<State>()) {}
+
+TaskGroup::~TaskGroup() {
+    Cancel();
+    [[maybe_unused]] Status status = Wait();
+}
+
+void TaskGroup::Add(std::function<Status()> task) {
+    {
+        std::lock_guard<std::mutex> lock(state_->mutex);
+        if (state_->cancelled) {
+            state_->skipped_tasks++;
+            return;
+        }
+        state_->pending_tasks++;
+    }
+    executor_->Add(
+        [state = state_, task = std::move(task)]() {
+            bool cancelled = false;
+            {
+                std::lock_guard<std::mutex> lock(state->mutex);
+                cancelled = state->cancelled;
+            }
+            Status status = cancelled ? Status::OK() : task();
+            {
+                std::lock_guard<std::mutex> lock(state->mutex);
+                if (cancelled) {
+                    state->skipped_tasks++;
+                } else if (!status.ok() && state->status.ok()) {
+                    state->status = status;
+                    // fail fast, the result of the group is already decided
+                    state->cancelled = true;
+                }
+                state->pending_tasks--;
+            }
+            state->condition.notify_all();
+        },
+        priority_);
+}
+
+void TaskGroup::Cancel() {
+    std::lock_guard<std::mutex> lock(state_->mutex);
+    state_->cancelled = true;
+}
+
+Status TaskGroup::Wait() {
+    std::unique_lock<std::mutex> lock(state_->mutex);
+    state_->condition.wait(lock, [this]() { return state_->pending_tasks == 0; });
+    if (!state_->status.ok()) {
+        return state_->status;
+    }
+    if (state_->skipped_tasks > 0) {
+        return Status::Invalid(
+            fmt::format("task group is cancelled, {} tasks are skipped", state_->skipped_tasks));
+    }
+    return Status::OK();
+}
+
+}  // namespace paimon
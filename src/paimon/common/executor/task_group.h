@@ -0,0 +1,69 @@
+/*
+ * Copyright 2024-present Alibaba Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+
+#include "paimon/executor.h"
+#include "paimon/status.h"
+
+namespace paimon {
+
+/// A group of tasks added to an `Executor` which are waited for or cancelled together. The first
+/// failed task cancels the tasks of the group not started yet.
+class TaskGroup {
+ public:
+    explicit TaskGroup(const std::shared_ptr<Executor>& executor,
+                       TaskPriority priority = TaskPriority::NORMAL);
+
+    /// Cancels the tasks not started yet and waits for the running ones.
+    ~TaskGroup();
+
+    TaskGroup(const TaskGroup&) = delete;
+    TaskGroup& operator=(const TaskGroup&) = delete;
+
+    void Add(std::function<Status()> task);
+
+    /// Tasks not started yet are skipped, running tasks are not interrupted.
+    void Cancel();
+
+    /// Waits for all added tasks to finish or be skipped.
+    ///
+    /// @return The status of the first failed task, Invalid if the group is cancelled before all
+    /// tasks run, otherwise OK.
+    Status Wait();
+
+ private:
+    struct State {
+        std::mutex mutex;
+        std::condition_variable condition;
+        int64_t pending_tasks = 0;
+        int64_t skipped_tasks = 0;
+        bool cancelled = false;
+        Status status;
+    };
+
+    std::shared_ptr<Executor> executor_;
+    TaskPriority priority_;
+    std::shared_ptr<State> state_;
+};
+
+}  // namespace paimon
@@ -0,0 +1,99 @@
+/*
+ * Copyright 2024-present Alibaba Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "paimon/common/executor/task_group.h"
+
+#include <atomic>
+#include <chrono>
+#include <future>
+#include <memory>
+#include <thread>
+
+#include "gtest/gtest.h"
+#include "paimon/executor.h"
+#include "paimon/status.h"
+#include "paimon/testing/utils/testharness.h"
+
+namespace paimon::test {
+
+TEST(TaskGroupTest, TestWait) {
+    std::shared_ptr<Executor> executor = CreateDefaultExecutor(/*thread_count=*/2);
+    std::atomic<int32_t> count = 0;
+    TaskGroup group(executor);
+    for (int32_t i = 0; i < 10; ++i) {
+        group.Add([&count]() {
+            count++;
+            return Status::OK();
+        });
+    }
+    ASSERT_OK(group.Wait());
+    ASSERT_EQ(10, count.load());
+    // wait again is fine
+    ASSERT_OK(group.Wait());
+}
+
+TEST(TaskGroupTest, TestFailFast) {
+    std::shared_ptr<Executor> executor = CreateDefaultExecutor(/*thread_count=*/1);
+    std::promise<void> blocker;
+    std::shared_future<void> blocked = blocker.get_future().share();
+    std::atomic<int32_t> count = 0;
+    TaskGroup group(executor, TaskPriority::LOW);
+    group.Add([blocked]() {
+        blocked.wait();
+        return Status::IOError("mock error");
+    });
+    for (int32_t i = 0; i < 10; ++i) {
+        group.Add([&count]() {
+            count++;
+            return Status::OK();
+        });
+    }
+    blocker.set_value();
+    ASSERT_NOK_WITH_MSG(group.Wait(), "mock error");
+    ASSERT_EQ(0, count.load());
+}
+
+TEST(TaskGroupTest, TestCancel) {
+    std::shared_ptr<Executor> executor = CreateDefaultExecutor(/*thread_count=*/1);
+    std::promise<void> blocker;
+    std::shared_future<void> blocked = blocker.get_future().share();
+    std::promise<void> started;
+    std::atomic<int32_t> count = 0;
+    TaskGroup group(executor);
+    group.Add([blocked, &started, &count]() {
+        started.set_value();
+        blocked.wait();
+        count++;
+        return Status::OK();
+    });
+    started.get_future().wait();
+    group.Add([&count]() {
+        count++;
+        return Status::OK();
+    });
+    group.Cancel();
+    // tasks added after cancel are skipped too
+    group.Add([&count]() {
+        count++;
+        return Status::OK();
+    });
+    blocker.set_value();
+    ASSERT_NOK_WITH_MSG(group.Wait(), "task group is cancelled, 2 tasks are skipped");
+    // the running task is not interrupted
+    ASSERT_EQ(1, count.load());
+}
+
+}  // namespace paimon::test
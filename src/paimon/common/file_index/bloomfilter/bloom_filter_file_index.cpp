@@ -20,7 +20,10 @@
 #include <functional>
 #include <utility>
 
+#include "arrow/api.h"
 #include "fmt/format.h"
+#include "paimon/common/predicate/literal_converter.h"
+#include "paimon/common/utils/options_utils.h"
 #include "paimon/fs/file_system.h"
 #include "paimon/memory/bytes.h"
 #include "paimon/predicate/literal.h"
@@ -29,7 +32,85 @@
 namespace paimon {
 class MemoryPool;
 
-BloomFilterFileIndex::BloomFilterFileIndex(const std::map<std::string, std::string>& options) {}
+BloomFilterFileIndex::BloomFilterFileIndex(const std::map<std::string, std::string>& options)
+    : options_(options) {}
+
+Result<std::shared_ptr<FileIndexWriter>> BloomFilterFileIndex::CreateWriter(
+    ::ArrowSchema* c_arrow_schema, const std::shared_ptr<MemoryPool>& pool) const {
+    PAIMON_ASSIGN_OR_RAISE_FROM_ARROW(std::shared_ptr<arrow::Schema> arrow_schema,
+                                      arrow::ImportSchema(c_arrow_schema));
+    if (arrow_schema->num_fields() != 1) {
+        return Status::Invalid(
+            "invalid schema for BloomFilterFileIndexWriter, supposed to have single "
+            "field.");
+    }
+    return BloomFilterFileIndexWriter::Create(arrow_schema, options_, pool);
+}
+
+Result<std::shared_ptr<BloomFilterFileIndexWriter>> BloomFilterFileIndexWriter::Create(
+    const std::shared_ptr<arrow::Schema>& arrow_schema,
+    const std::map<std::string, std::string>& options, const std::shared_ptr<MemoryPool>& pool) {
+    PAIMON_ASSIGN_OR_RAISE(int64_t items,
+                           OptionsUtils::GetValueFromMap<int64_t>(
+                               options, BloomFilterFileIndex::ITEMS,
+                               BloomFilterFileIndex::DEFAULT_ITEMS));
+    PAIMON_ASSIGN_OR_RAISE(double fpp, OptionsUtils::GetValueFromMap<double>(
+                                           options, BloomFilterFileIndex::FPP,
+                                           BloomFilterFileIndex::DEFAULT_FPP));
+    if (items <= 0 || fpp <= 0 || fpp >= 1) {
+        return Status::Invalid(fmt::format(
+            "invalid options for BloomFilterFileIndexWriter, items {}, fpp {}", items, fpp));
+    }
+    auto arrow_field = arrow_schema->field(0);
+    PAIMON_ASSIGN_OR_RAISE(FastHash::HashFunction hash_function,
+                           FastHash::GetHashFunction(arrow_field->type()));
+    return std::shared_ptr<BloomFilterFileIndexWriter>(
+        new BloomFilterFileIndexWriter(arrow::struct_({arrow_field}), hash_function,
+                                       BloomFilter64(items, fpp, pool), pool));
+}
+
+BloomFilterFileIndexWriter::BloomFilterFileIndexWriter(
+    const std::shared_ptr<arrow::DataType>& struct_type,
+    const FastHash::HashFunction& hash_function, BloomFilter64&& filter,
+    const std::shared_ptr<MemoryPool>& pool)
+    : struct_type_(struct_type),
+      hash_function_(hash_function),
+      filter_(std::move(filter)),
+      pool_(pool) {}
+
+Status BloomFilterFileIndexWriter::AddBatch(::ArrowArray* batch) {
+    PAIMON_ASSIGN_OR_RAISE_FROM_ARROW(std::shared_ptr<arrow::Array> arrow_array,
+                                      arrow::ImportArray(batch, struct_type_));
+    auto struct_array = std::dynamic_pointer_cast<arrow::StructArray>(arrow_array);
+    if (!struct_array || struct_array->num_fields() != 1) {
+        return Status::Invalid(
+            "invalid batch for BloomFilterFileIndexWriter, supposed to be struct array with single "
+            "field.");
+    }
+    PAIMON_ASSIGN_OR_RAISE(
+        std::vector<Literal> array_values,
+        LiteralConverter::ConvertLiteralsFromArray(*(struct_array->field(0)), /*own_data=*/false));
+    for (const auto& value : array_values) {
+        if (!value.IsNull()) {
+            filter_.AddHash(hash_function_(value));
+        }
+    }
+    return Status::OK();
+}
+
+Result<PAIMON_UNIQUE_PTR<Bytes>> BloomFilterFileIndexWriter::SerializedBytes() const {
+    const BloomFilter64::BitSet& bit_set = filter_.GetBitSet();
+    int32_t num_hash_functions = filter_.GetNumHashFunctions();
+    auto bytes = Bytes::AllocateBytes(sizeof(int32_t) + bit_set.BitSize() / 8, pool_.get());
+    // compatible with java, big endian
+    char* data = bytes->data();
+    data[0] = static_cast<char>((num_hash_functions >> 24) & 0xFF);
+    data[1] = static_cast<char>((num_hash_functions >> 16) & 0xFF);
+    data[2] = static_cast<char>((num_hash_functions >> 8) & 0xFF);
+    data[3] = static_cast<char>(num_hash_functions & 0xFF);
+    bit_set.CopyTo(data + sizeof(int32_t));
+    return bytes;
+}
 Result<std::shared_ptr<FileIndexReader>> BloomFilterFileIndex::CreateReader(
     ::ArrowSchema* c_arrow_schema, int32_t start, int32_t length,
     const std::shared_ptr<InputStream>& input_stream,
@@ -79,4 +160,14 @@ Result<std::shared_ptr<FileIndexResult>> BloomFilterFileIndexReader::VisitEqual(
                                                       : FileIndexResult::Skip();
 }
 
+Result<std::shared_ptr<FileIndexResult>> BloomFilterFileIndexReader::VisitIn(
+    const std::vector<Literal>& literals) {
+    for (const auto& literal : literals) {
+        if (literal.IsNull() || filter_.TestHash(hash_function_(literal))) {
+            return FileIndexResult::Remain();
+        }
+    }
+    return FileIndexResult::Skip();
+}
+
 }  // namespace paimon
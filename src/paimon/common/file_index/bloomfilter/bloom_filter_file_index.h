@@ -20,6 +20,7 @@
 #include <map>
 #include <memory>
 #include <string>
+#include <vector>
 
 #include "arrow/c/bridge.h"
 #include "paimon/common/file_index/bloomfilter/fast_hash.h"
@@ -27,6 +28,7 @@
 #include "paimon/common/utils/bloom_filter64.h"
 #include "paimon/file_index/file_index_reader.h"
 #include "paimon/file_index/file_index_result.h"
+#include "paimon/file_index/file_index_writer.h"
 #include "paimon/file_index/file_indexer.h"
 #include "paimon/result.h"
 namespace paimon {
@@ -53,11 +55,40 @@ class BloomFilterFileIndex : public FileIndexer {
         const std::shared_ptr<MemoryPool>& pool) const override;
 
     Result<std::shared_ptr<FileIndexWriter>> CreateWriter(
-        ::ArrowSchema* arrow_schema, const std::shared_ptr<MemoryPool>& pool) const override {
-        PAIMON_ASSIGN_OR_RAISE_FROM_ARROW(std::shared_ptr<arrow::DataType> arrow_type,
-                                          arrow::ImportType(arrow_schema));
-        return Status::NotImplemented("do not support index writer in bloom filter");
-    }
+        ::ArrowSchema* arrow_schema, const std::shared_ptr<MemoryPool>& pool) const override;
+
+ public:
+    static constexpr char ITEMS[] = "items";
+    static constexpr char FPP[] = "fpp";
+    static constexpr int64_t DEFAULT_ITEMS = 1000000;
+    static constexpr double DEFAULT_FPP = 0.1;
+
+ private:
+    std::map<std::string, std::string> options_;
+};
+
+class BloomFilterFileIndexWriter : public FileIndexWriter {
+ public:
+    static Result<std::shared_ptr<BloomFilterFileIndexWriter>> Create(
+        const std::shared_ptr<arrow::Schema>& arrow_schema,
+        const std::map<std::string, std::string>& options, const std::shared_ptr<MemoryPool>& pool);
+
+    /// Hashes the non-null values of the batch into the filter.
+    Status AddBatch(::ArrowArray* batch) override;
+
+    Result<PAIMON_UNIQUE_PTR<Bytes>> SerializedBytes() const override;
+
+ private:
+    BloomFilterFileIndexWriter(const std::shared_ptr<arrow::DataType>& struct_type,
+                               const FastHash::HashFunction& hash_function, BloomFilter64&& filter,
+                               const std::shared_ptr<MemoryPool>& pool);
+
+ private:
+    /// @note struct_type_ contains only the indexed field, used for import from C ArrowArray
+    std::shared_ptr<arrow::DataType> struct_type_;
+    FastHash::HashFunction hash_function_;
+    BloomFilter64 filter_;
+    std::shared_ptr<MemoryPool> pool_;
 };
 
 class BloomFilterFileIndexReader : public FileIndexReader {
@@ -67,6 +98,10 @@ class BloomFilterFileIndexReader : public FileIndexReader {
 
     Result<std::shared_ptr<FileIndexResult>> VisitEqual(const Literal& literal) override;
 
+    /// Probes the literals one after another and stops at the first possible hit, instead of
+    /// combining one result per literal.
+    Result<std::shared_ptr<FileIndexResult>> VisitIn(const std::vector<Literal>& literals) override;
+
  private:
     BloomFilterFileIndexReader(const FastHash::HashFunction& hash_function, BloomFilter64&& filter);
 
@@ -16,9 +16,14 @@
 
 #include "paimon/common/file_index/bloomfilter/bloom_filter_file_index.h"
 
+#include <map>
+#include <string>
 #include <utility>
 #include <vector>
 
+#include "arrow/api.h"
+#include "arrow/c/bridge.h"
+#include "arrow/ipc/json_simple.h"
 #include "gtest/gtest.h"
 #include "paimon/common/utils/field_type_utils.h"
 #include "paimon/data/timestamp.h"
@@ -47,6 +52,22 @@ class BloomFilterIndexReaderTest : public ::testing::Test {
         return c_schema;
     }
 
+    Result<PAIMON_UNIQUE_PTR<Bytes>> WriteIndex(
+        const std::shared_ptr<arrow::DataType>& type, const std::string& json_data,
+        const std::map<std::string, std::string>& options) const {
+        auto struct_type = arrow::struct_({arrow::field("f0", type)});
+        PAIMON_ASSIGN_OR_RAISE_FROM_ARROW(
+            std::shared_ptr<arrow::Array> array,
+            arrow::ipc::internal::json::ArrayFromJSON(struct_type, json_data));
+        BloomFilterFileIndex file_index(options);
+        PAIMON_ASSIGN_OR_RAISE(auto writer,
+                               file_index.CreateWriter(CreateArrowSchema(type).get(), pool_));
+        ArrowArray c_array;
+        PAIMON_RETURN_NOT_OK_FROM_ARROW(arrow::ExportArray(*array, &c_array));
+        PAIMON_RETURN_NOT_OK(writer->AddBatch(&c_array));
+        return writer->SerializedBytes();
+    }
+
  private:
     std::shared_ptr<MemoryPool> pool_;
 };
@@ -69,6 +90,49 @@ TEST_F(BloomFilterIndexReaderTest, TestStringType) {
     ASSERT_TRUE(reader->VisitEqual(Literal(FieldType::STRING)).value()->IsRemain().value());
 }
 
+TEST_F(BloomFilterIndexReaderTest, TestWriteAndRead) {
+    std::map<std::string, std::string> options = {{"items", "100"}, {"fpp", "0.01"}};
+    ASSERT_OK_AND_ASSIGN(auto index_bytes,
+                         WriteIndex(arrow::int32(), R"([[1], [null], [-1], [123]])", options));
+    auto input_stream =
+        std::make_shared<ByteArrayInputStream>(index_bytes->data(), index_bytes->size());
+    BloomFilterFileIndex file_index(options);
+    ASSERT_OK_AND_ASSIGN(
+        auto reader,
+        file_index.CreateReader(CreateArrowSchema(arrow::int32()).get(),
+                                /*start=*/0, /*length=*/index_bytes->size(), input_stream, pool_));
+    for (int32_t value : {1, -1, 123}) {
+        ASSERT_TRUE(reader->VisitEqual(Literal(value)).value()->IsRemain().value());
+    }
+    int32_t false_positives = 0;
+    for (int32_t value = 1000; value < 1100; ++value) {
+        if (reader->VisitEqual(Literal(value)).value()->IsRemain().value()) {
+            false_positives++;
+        }
+    }
+    ASSERT_LT(false_positives, 10);
+}
+
+TEST_F(BloomFilterIndexReaderTest, TestWriteStringType) {
+    ASSERT_OK_AND_ASSIGN(auto index_bytes,
+                         WriteIndex(arrow::utf8(), R"([["a"], ["b"], [""]])", {{"items", "10"}}));
+    auto input_stream =
+        std::make_shared<ByteArrayInputStream>(index_bytes->data(), index_bytes->size());
+    BloomFilterFileIndex file_index({});
+    ASSERT_OK_AND_ASSIGN(
+        auto reader,
+        file_index.CreateReader(CreateArrowSchema(arrow::utf8()).get(),
+                                /*start=*/0, /*length=*/index_bytes->size(), input_stream, pool_));
+    ASSERT_TRUE(reader->VisitEqual(Literal(FieldType::STRING, "a", 1)).value()->IsRemain().value());
+    ASSERT_TRUE(reader->VisitEqual(Literal(FieldType::STRING, "b", 1)).value()->IsRemain().value());
+    ASSERT_TRUE(reader->VisitEqual(Literal(FieldType::STRING, "", 0)).value()->IsRemain().value());
+}
+
+TEST_F(BloomFilterIndexReaderTest, TestWriteInvalidOptions) {
+    BloomFilterFileIndex file_index({{"fpp", "1.5"}});
+    ASSERT_NOK(file_index.CreateWriter(CreateArrowSchema(arrow::int32()).get(), pool_));
+}
+
 TEST_F(BloomFilterIndexReaderTest, TestIntegerTypes) {
     // data: 1, 2, -1, 123
     std::vector<uint8_t> index_bytes = {0, 0, 0, 6, 24, 4, 79, 0, 35, 128, 1, 136, 26, 64, 129};
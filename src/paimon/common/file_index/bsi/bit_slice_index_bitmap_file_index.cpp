@@ -16,11 +16,15 @@
 
 #include "paimon/common/file_index/bsi/bit_slice_index_bitmap_file_index.h"
 
+#include <algorithm>
 #include <cassert>
 #include <cstddef>
 
+#include "arrow/api.h"
 #include "fmt/format.h"
 #include "paimon/common/file_index/bsi/bit_slice_index_roaring_bitmap.h"
+#include "paimon/common/memory/memory_segment_utils.h"
+#include "paimon/common/predicate/literal_converter.h"
 #include "paimon/common/utils/date_time_utils.h"
 #include "paimon/common/utils/field_type_utils.h"
 #include "paimon/data/timestamp.h"
@@ -89,6 +93,22 @@ Result<std::shared_ptr<FileIndexReader>> BitSliceIndexBitmapFileIndex::CreateRea
                                                                 negative);
 }
 
+Result<std::shared_ptr<FileIndexWriter>> BitSliceIndexBitmapFileIndex::CreateWriter(
+    ::ArrowSchema* c_arrow_schema, const std::shared_ptr<MemoryPool>& pool) const {
+    PAIMON_ASSIGN_OR_RAISE_FROM_ARROW(std::shared_ptr<arrow::Schema> arrow_schema,
+                                      arrow::ImportSchema(c_arrow_schema));
+    if (arrow_schema->num_fields() != 1) {
+        return Status::Invalid(
+            "invalid schema for BitSliceIndexBitmapFileIndexWriter, supposed to have single "
+            "field.");
+    }
+    auto arrow_field = arrow_schema->field(0);
+    PAIMON_ASSIGN_OR_RAISE(BitSliceIndexBitmapFileIndex::ValueMapperType value_mapper,
+                           GetValueMapper(arrow_field->type()));
+    return std::make_shared<BitSliceIndexBitmapFileIndexWriter>(arrow::struct_({arrow_field}),
+                                                                value_mapper, pool);
+}
+
 // precondition, literal is not null
 Result<BitSliceIndexBitmapFileIndex::ValueMapperType> BitSliceIndexBitmapFileIndex::GetValueMapper(
     const std::shared_ptr<arrow::DataType>& arrow_type) {
@@ -139,6 +159,70 @@ Result<BitSliceIndexBitmapFileIndex::ValueMapperType> BitSliceIndexBitmapFileInd
     }
 }
 
+BitSliceIndexBitmapFileIndexWriter::BitSliceIndexBitmapFileIndexWriter(
+    const std::shared_ptr<arrow::DataType>& struct_type,
+    const BitSliceIndexBitmapFileIndex::ValueMapperType& value_mapper,
+    const std::shared_ptr<MemoryPool>& pool)
+    : struct_type_(struct_type), value_mapper_(value_mapper), pool_(pool) {}
+
+Status BitSliceIndexBitmapFileIndexWriter::AddBatch(::ArrowArray* batch) {
+    PAIMON_ASSIGN_OR_RAISE_FROM_ARROW(std::shared_ptr<arrow::Array> arrow_array,
+                                      arrow::ImportArray(batch, struct_type_));
+    auto struct_array = std::dynamic_pointer_cast<arrow::StructArray>(arrow_array);
+    if (!struct_array || struct_array->num_fields() != 1) {
+        return Status::Invalid(
+            "invalid batch for BitSliceIndexBitmapFileIndexWriter, supposed to be struct array "
+            "with single field.");
+    }
+    PAIMON_ASSIGN_OR_RAISE(
+        std::vector<Literal> array_values,
+        LiteralConverter::ConvertLiteralsFromArray(*(struct_array->field(0)), /*own_data=*/false));
+    for (const auto& value : array_values) {
+        if (!value.IsNull()) {
+            PAIMON_ASSIGN_OR_RAISE(int64_t mapped_value, value_mapper_(value));
+            // the absolute value of int64 min does not fit into int64
+            if (mapped_value == std::numeric_limits<int64_t>::min()) {
+                return Status::Invalid(fmt::format(
+                    "value {} is out of range for BitSliceIndexBitmapFileIndexWriter",
+                    mapped_value));
+            }
+            ValueCollector& collector = mapped_value < 0 ? negative_ : positive_;
+            int64_t abs_value = mapped_value < 0 ? -mapped_value : mapped_value;
+            collector.row_ids.push_back(row_number_);
+            collector.values.push_back(abs_value);
+            collector.min = std::min(collector.min, abs_value);
+            collector.max = std::max(collector.max, abs_value);
+        }
+        row_number_++;
+    }
+    return Status::OK();
+}
+
+Status BitSliceIndexBitmapFileIndexWriter::ValueCollector::Serialize(
+    const std::shared_ptr<MemoryPool>& pool, MemorySegmentOutputStream* out) const {
+    out->WriteValue<int8_t>(values.empty() ? 0 : 1);
+    if (values.empty()) {
+        return Status::OK();
+    }
+    PAIMON_ASSIGN_OR_RAISE(std::unique_ptr<BitSliceIndexRoaringBitmap::Appender> appender,
+                           BitSliceIndexRoaringBitmap::Appender::Create(min, max));
+    for (size_t i = 0; i < values.size(); ++i) {
+        PAIMON_RETURN_NOT_OK(appender->Append(row_ids[i], values[i]));
+    }
+    out->WriteBytes(appender->Serialize(pool));
+    return Status::OK();
+}
+
+Result<PAIMON_UNIQUE_PTR<Bytes>> BitSliceIndexBitmapFileIndexWriter::SerializedBytes() const {
+    MemorySegmentOutputStream out(MemorySegmentOutputStream::DEFAULT_SEGMENT_SIZE, pool_);
+    out.WriteValue<int8_t>(BitSliceIndexBitmapFileIndex::VERSION_1);
+    out.WriteValue<int32_t>(row_number_);
+    PAIMON_RETURN_NOT_OK(positive_.Serialize(pool_, &out));
+    PAIMON_RETURN_NOT_OK(negative_.Serialize(pool_, &out));
+    return MemorySegmentUtils::CopyToBytes(out.Segments(), /*offset=*/0,
+                                           static_cast<int32_t>(out.CurrentSize()), pool_.get());
+}
+
 BitSliceIndexBitmapFileIndexReader::BitSliceIndexBitmapFileIndexReader(
     int32_t row_number, const BitSliceIndexBitmapFileIndex::ValueMapperType& value_mapper,
     const std::shared_ptr<BitSliceIndexRoaringBitmap>& positive,
@@ -18,6 +18,7 @@
 
 #include <cstdint>
 #include <functional>
+#include <limits>
 #include <map>
 #include <memory>
 #include <string>
@@ -26,9 +27,11 @@
 
 #include "arrow/c/bridge.h"
 #include "arrow/type.h"
+#include "paimon/common/io/memory_segment_output_stream.h"
 #include "paimon/common/utils/arrow/status_utils.h"
 #include "paimon/file_index/file_index_reader.h"
 #include "paimon/file_index/file_index_result.h"
+#include "paimon/file_index/file_index_writer.h"
 #include "paimon/file_index/file_indexer.h"
 #include "paimon/predicate/literal.h"
 #include "paimon/result.h"
@@ -52,11 +55,7 @@ class BitSliceIndexBitmapFileIndex : public FileIndexer {
         const std::shared_ptr<MemoryPool>& pool) const override;
 
     Result<std::shared_ptr<FileIndexWriter>> CreateWriter(
-        ::ArrowSchema* arrow_schema, const std::shared_ptr<MemoryPool>& pool) const override {
-        PAIMON_ASSIGN_OR_RAISE_FROM_ARROW(std::shared_ptr<arrow::DataType> arrow_type,
-                                          arrow::ImportType(arrow_schema));
-        return Status::NotImplemented("do not support index writer in bsi");
-    }
+        ::ArrowSchema* arrow_schema, const std::shared_ptr<MemoryPool>& pool) const override;
 
     using ValueMapperType = std::function<Result<int64_t>(const Literal& literal)>;
 
@@ -74,9 +73,45 @@ class BitSliceIndexBitmapFileIndex : public FileIndexer {
     }
 
  private:
+    friend class BitSliceIndexBitmapFileIndexWriter;
     static constexpr int8_t VERSION_1 = 1;
 };
 
+/// Keeps the mapped values of a file and builds the positive and negative bit slice indexes on
+/// serialization, when their value ranges are known.
+class BitSliceIndexBitmapFileIndexWriter : public FileIndexWriter {
+ public:
+    BitSliceIndexBitmapFileIndexWriter(
+        const std::shared_ptr<arrow::DataType>& struct_type,
+        const BitSliceIndexBitmapFileIndex::ValueMapperType& value_mapper,
+        const std::shared_ptr<MemoryPool>& pool);
+
+    Status AddBatch(::ArrowArray* batch) override;
+
+    Result<PAIMON_UNIQUE_PTR<Bytes>> SerializedBytes() const override;
+
+ private:
+    /// Non-null values with the same sign, negative values are kept as absolute values.
+    struct ValueCollector {
+        Status Serialize(const std::shared_ptr<MemoryPool>& pool,
+                         MemorySegmentOutputStream* out) const;
+
+        std::vector<int32_t> row_ids;
+        std::vector<int64_t> values;
+        int64_t min = std::numeric_limits<int64_t>::max();
+        int64_t max = std::numeric_limits<int64_t>::min();
+    };
+
+ private:
+    /// @note struct_type_ contains only the indexed field, used for import from C ArrowArray
+    std::shared_ptr<arrow::DataType> struct_type_;
+    BitSliceIndexBitmapFileIndex::ValueMapperType value_mapper_;
+    std::shared_ptr<MemoryPool> pool_;
+    int32_t row_number_ = 0;
+    ValueCollector positive_;
+    ValueCollector negative_;
+};
+
 class BitSliceIndexBitmapFileIndexReader
     : public FileIndexReader,
       public std::enable_shared_from_this<BitSliceIndexBitmapFileIndexReader> {
@@ -18,6 +18,9 @@
 
 #include <utility>
 
+#include "arrow/api.h"
+#include "arrow/c/bridge.h"
+#include "arrow/ipc/json_simple.h"
 #include "gtest/gtest.h"
 #include "paimon/common/utils/field_type_utils.h"
 #include "paimon/data/timestamp.h"
@@ -57,6 +60,21 @@ class BitSliceIndexBitmapIndexReaderTest : public ::testing::Test {
             << ", expected=" << RoaringBitmap32::From(expected).ToString();
     }
 
+    Result<PAIMON_UNIQUE_PTR<Bytes>> WriteIndex(const std::shared_ptr<arrow::DataType>& type,
+                                                const std::string& json_data) const {
+        auto struct_type = arrow::struct_({arrow::field("f0", type)});
+        PAIMON_ASSIGN_OR_RAISE_FROM_ARROW(
+            std::shared_ptr<arrow::Array> array,
+            arrow::ipc::internal::json::ArrayFromJSON(struct_type, json_data));
+        BitSliceIndexBitmapFileIndex file_index({});
+        PAIMON_ASSIGN_OR_RAISE(auto writer,
+                               file_index.CreateWriter(CreateArrowSchema(type).get(), pool_));
+        ArrowArray c_array;
+        PAIMON_RETURN_NOT_OK_FROM_ARROW(arrow::ExportArray(*array, &c_array));
+        PAIMON_RETURN_NOT_OK(writer->AddBatch(&c_array));
+        return writer->SerializedBytes();
+    }
+
  private:
     std::shared_ptr<MemoryPool> pool_;
 };
@@ -116,6 +134,55 @@ TEST_F(BitSliceIndexBitmapIndexReaderTest, TestMix) {
     CheckResult(reader->VisitGreaterOrEqual(Literal(2)).value(), {1, 7, 9});
 }
 
+TEST_F(BitSliceIndexBitmapIndexReaderTest, TestWriteCompatibleWithJava) {
+    // data: 1, 2, null, -2, -2, -1, null, 2, 0, 5, null, same as TestMix
+    std::vector<char> expected_bytes = {
+        1, 0, 0, 0,  11, 1,  1,  0, 0, 0, 0,  0, 0, 0, 0, 0,  0,  0,  0,  0,  0, 0, 5, 58, 48,
+        0, 0, 1, 0,  0,  0,  0,  0, 4, 0, 16, 0, 0, 0, 0, 0,  1,  0,  7,  0,  8, 0, 9, 0,  0,
+        0, 0, 3, 58, 48, 0,  0,  1, 0, 0, 0,  0, 0, 1, 0, 16, 0,  0,  0,  0,  0, 9, 0, 58, 48,
+        0, 0, 1, 0,  0,  0,  0,  0, 1, 0, 16, 0, 0, 0, 1, 0,  7,  0,  58, 48, 0, 0, 1, 0,  0,
+        0, 0, 0, 0,  0,  16, 0,  0, 0, 9, 0,  1, 1, 0, 0, 0,  0,  0,  0,  0,  0, 0, 0, 0,  0,
+        0, 0, 0, 2,  58, 48, 0,  0, 1, 0, 0,  0, 0, 0, 2, 0,  16, 0,  0,  0,  3, 0, 4, 0,  5,
+        0, 0, 0, 0,  2,  58, 48, 0, 0, 1, 0,  0, 0, 0, 0, 0,  0,  16, 0,  0,  0, 5, 0, 58, 48,
+        0, 0, 1, 0,  0,  0,  0,  0, 1, 0, 16, 0, 0, 0, 3, 0,  4,  0};
+    ASSERT_OK_AND_ASSIGN(auto index_bytes,
+                         WriteIndex(arrow::int32(), R"([[1], [2], [null], [-2], [-2], [-1], [null],
+                                                         [2], [0], [5], [null]])"));
+    ASSERT_EQ(std::vector<char>(index_bytes->data(), index_bytes->data() + index_bytes->size()),
+              expected_bytes);
+}
+
+TEST_F(BitSliceIndexBitmapIndexReaderTest, TestWriteAndRead) {
+    auto check = [&](const std::shared_ptr<arrow::DataType>& type, const std::string& json_data,
+                     const Literal& literal, const std::vector<int32_t>& expected_equal,
+                     const std::vector<int32_t>& expected_less_than) {
+        ASSERT_OK_AND_ASSIGN(auto index_bytes, WriteIndex(type, json_data));
+        auto input_stream =
+            std::make_shared<ByteArrayInputStream>(index_bytes->data(), index_bytes->size());
+        BitSliceIndexBitmapFileIndex file_index({});
+        ASSERT_OK_AND_ASSIGN(auto reader, file_index.CreateReader(
+                                              CreateArrowSchema(type).get(), /*start=*/0,
+                                              /*length=*/index_bytes->size(), input_stream, pool_));
+        CheckResult(reader->VisitEqual(literal).value(), expected_equal);
+        CheckResult(reader->VisitLessThan(literal).value(), expected_less_than);
+    };
+    // positive only
+    check(arrow::int64(), R"([[3], [null], [7], [3], [0]])", Literal(static_cast<int64_t>(3)),
+          {0, 3}, {4});
+    // negative only
+    check(arrow::int16(), R"([[-3], [-7], [null], [-1]])", Literal(static_cast<int16_t>(-3)), {0},
+          {1});
+    // all null
+    check(arrow::int32(), R"([[null], [null]])", Literal(1), {}, {});
+    // date
+    check(arrow::date32(), R"([[10], [-10], [20]])", Literal(FieldType::DATE, 10), {0}, {1});
+}
+
+TEST_F(BitSliceIndexBitmapIndexReaderTest, TestWriteInvalidType) {
+    BitSliceIndexBitmapFileIndex file_index({});
+    ASSERT_NOK(file_index.CreateWriter(CreateArrowSchema(arrow::utf8()).get(), pool_));
+}
+
 TEST_F(BitSliceIndexBitmapIndexReaderTest, TestPositiveOnly) {
     // data: 0, 1, null, 3, 4, 5, 6, 0, null
     std::vector<char> index_bytes = {
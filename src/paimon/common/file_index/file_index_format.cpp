@@ -17,6 +17,7 @@
 #include "paimon/file_index/file_index_format.h"
 
 #include <cassert>
+#include <limits>
 #include <map>
 #include <unordered_map>
 #include <utility>
@@ -25,6 +26,8 @@
 #include "arrow/type.h"
 #include "fmt/format.h"
 #include "paimon/common/file_index/empty/empty_file_index_reader.h"
+#include "paimon/common/io/memory_segment_output_stream.h"
+#include "paimon/common/memory/memory_segment_utils.h"
 #include "paimon/common/utils/arrow/status_utils.h"
 #include "paimon/file_index/file_indexer.h"
 #include "paimon/file_index/file_indexer_factory.h"
@@ -151,4 +154,60 @@ Result<std::unique_ptr<FileIndexFormat::Reader>> FileIndexFormat::CreateReader(
     const std::shared_ptr<InputStream>& input_stream, const std::shared_ptr<MemoryPool>& pool) {
     return FileIndexFormatReaderImpl::Create(input_stream, pool);
 }
+
+Result<PAIMON_UNIQUE_PTR<Bytes>> FileIndexFormat::WriteColumnIndexes(
+    const std::map<std::string, std::map<std::string, std::shared_ptr<Bytes>>>& column_indexes,
+    const std::shared_ptr<MemoryPool>& pool) {
+    // magic + version + head length + column number + redundant length
+    int64_t head_length = 8 + 4 + 4 + 4 + 4;
+    int64_t body_length = 0;
+    for (const auto& [column_name, indexes] : column_indexes) {
+        // column name + index number
+        head_length += 2 + column_name.size() + 4;
+        for (const auto& [index_type, bytes] : indexes) {
+            // index name + start pos + length
+            head_length += 2 + index_type.size() + 4 + 4;
+            body_length += bytes ? bytes->size() : 0;
+        }
+    }
+    if (head_length + body_length > std::numeric_limits<int32_t>::max()) {
+        return Status::Invalid(
+            fmt::format("file index is too large, head length {}, body length {}", head_length,
+                        body_length));
+    }
+
+    MemorySegmentOutputStream out(MemorySegmentOutputStream::DEFAULT_SEGMENT_SIZE, pool);
+    out.WriteValue<int64_t>(MAGIC);
+    out.WriteValue<int32_t>(V_1);
+    out.WriteValue<int32_t>(static_cast<int32_t>(head_length));
+    out.WriteValue<int32_t>(static_cast<int32_t>(column_indexes.size()));
+    auto start = static_cast<int32_t>(head_length);
+    for (const auto& [column_name, indexes] : column_indexes) {
+        out.WriteString(column_name);
+        out.WriteValue<int32_t>(static_cast<int32_t>(indexes.size()));
+        for (const auto& [index_type, bytes] : indexes) {
+            out.WriteString(index_type);
+            if (bytes == nullptr || bytes->size() == 0) {
+                out.WriteValue<int32_t>(EMPTY_INDEX_FLAG);
+                out.WriteValue<int32_t>(0);
+            } else {
+                out.WriteValue<int32_t>(start);
+                out.WriteValue<int32_t>(static_cast<int32_t>(bytes->size()));
+                start += bytes->size();
+            }
+        }
+    }
+    // redundant length
+    out.WriteValue<int32_t>(0);
+    for (const auto& [column_name, indexes] : column_indexes) {
+        for (const auto& [index_type, bytes] : indexes) {
+            if (bytes != nullptr && bytes->size() > 0) {
+                out.WriteBytes(bytes);
+            }
+        }
+    }
+    assert(out.CurrentSize() == head_length + body_length);
+    return MemorySegmentUtils::CopyToBytes(out.Segments(), /*offset=*/0,
+                                           static_cast<int32_t>(out.CurrentSize()), pool.get());
+}
 }  // namespace paimon
@@ -15,7 +15,10 @@
  */
 #include "paimon/file_index/file_index_format.h"
 
+#include <map>
+#include <string>
 #include <utility>
+#include <vector>
 
 #include "gtest/gtest.h"
 #include "paimon/common/file_index/bitmap/bitmap_file_index.h"
@@ -149,6 +152,58 @@ TEST_F(FileIndexFormatTest, TestSimple) {
     }
 }
 
+TEST_F(FileIndexFormatTest, TestWriteCompatibleWithJava) {
+    // same file as TestSimple, bitmap index bodies of f0, f1, f2 start at 96, 227 and 301
+    std::vector<uint8_t> index_file_bytes = {
+        0,   5,   78,  78,  208, 26,  53,  174, 0,   0,   0,   1,   0,  0,   0,   96,  0,   0,
+        0,   3,   0,   2,   102, 48,  0,   0,   0,   1,   0,   6,   98, 105, 116, 109, 97,  112,
+        0,   0,   0,   96,  0,   0,   0,   131, 0,   2,   102, 49,  0,  0,   0,   1,   0,   6,
+        98,  105, 116, 109, 97,  112, 0,   0,   0,   227, 0,   0,   0,  74,  0,   2,   102, 50,
+        0,   0,   0,   1,   0,   6,   98,  105, 116, 109, 97,  112, 0,  0,   1,   45,  0,   0,
+        0,   76,  0,   0,   0,   0,   1,   0,   0,   0,   8,   0,   0,  0,   5,   0,   0,   0,
+        0,   5,   65,  108, 105, 99,  101, 0,   0,   0,   0,   0,   0,  0,   4,   76,  117, 99,
+        121, 255, 255, 255, 251, 0,   0,   0,   3,   66,  111, 98,  0,  0,   0,   20,  0,   0,
+        0,   5,   69,  109, 105, 108, 121, 255, 255, 255, 253, 0,   0,  0,   4,   84,  111, 110,
+        121, 0,   0,   0,   40,  58,  48,  0,   0,   1,   0,   0,   0,  0,   0,   1,   0,   16,
+        0,   0,   0,   0,   0,   7,   0,   58,  48,  0,   0,   1,   0,  0,   0,   0,   0,   1,
+        0,   16,  0,   0,   0,   1,   0,   5,   0,   58,  48,  0,   0,  1,   0,   0,   0,   0,
+        0,   1,   0,   16,  0,   0,   0,   3,   0,   6,   0,   1,   0,  0,   0,   8,   0,   0,
+        0,   2,   0,   0,   0,   0,   20,  0,   0,   0,   0,   0,   0,  0,   10,  0,   0,   0,
+        22,  58,  48,  0,   0,   1,   0,   0,   0,   0,   0,   2,   0,  16,  0,   0,   0,   4,
+        0,   6,   0,   7,   0,   58,  48,  0,   0,   1,   0,   0,   0,  0,   0,   4,   0,   16,
+        0,   0,   0,   0,   0,   1,   0,   2,   0,   3,   0,   5,   0,  1,   0,   0,   0,   8,
+        0,   0,   0,   2,   1,   255, 255, 255, 248, 0,   0,   0,   0,  0,   0,   0,   0,   0,
+        0,   0,   1,   0,   0,   0,   22,  58,  48,  0,   0,   1,   0,  0,   0,   0,   0,   2,
+        0,   16,  0,   0,   0,   2,   0,   3,   0,   6,   0,   58,  48, 0,   0,   1,   0,   0,
+        0,   0,   0,   3,   0,   16,  0,   0,   0,   0,   0,   1,   0,  4,   0,   5,   0};
+    auto body = [&](int32_t start, int32_t length) {
+        return std::make_shared<Bytes>(
+            std::string(reinterpret_cast<char*>(index_file_bytes.data()) + start, length),
+            pool_.get());
+    };
+    std::map<std::string, std::map<std::string, std::shared_ptr<Bytes>>> column_indexes = {
+        {"f0", {{"bitmap", body(96, 131)}}},
+        {"f1", {{"bitmap", body(227, 74)}}},
+        {"f2", {{"bitmap", body(301, 76)}}}};
+    ASSERT_OK_AND_ASSIGN(auto bytes, FileIndexFormat::WriteColumnIndexes(column_indexes, pool_));
+    ASSERT_EQ(std::string(reinterpret_cast<char*>(index_file_bytes.data()),
+                          index_file_bytes.size()),
+              std::string(bytes->data(), bytes->size()));
+}
+
+TEST_F(FileIndexFormatTest, TestWriteAndReadEmptyIndex) {
+    auto schema = arrow::schema({arrow::field("c1", arrow::int32())});
+    std::map<std::string, std::map<std::string, std::shared_ptr<Bytes>>> column_indexes = {
+        {"c1", {{"bloom-filter", nullptr}}}};
+    ASSERT_OK_AND_ASSIGN(auto bytes, FileIndexFormat::WriteColumnIndexes(column_indexes, pool_));
+    auto input_stream = std::make_shared<ByteArrayInputStream>(bytes->data(), bytes->size());
+    ASSERT_OK_AND_ASSIGN(auto reader, FileIndexFormat::CreateReader(input_stream, pool_));
+    ASSERT_OK_AND_ASSIGN(auto index_file_readers,
+                         reader->ReadColumnIndex("c1", CreateArrowSchema(schema).get()));
+    ASSERT_EQ(1, index_file_readers.size());
+    ASSERT_TRUE(dynamic_cast<EmptyFileIndexReader*>(index_file_readers[0].get()));
+}
+
 // NOLINTNEXTLINE(google-readability-function-size)
 TEST_F(FileIndexFormatTest, TestBitmapIndexWithTimestamp) {
     auto schema = arrow::schema({
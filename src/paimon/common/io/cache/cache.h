@@ -19,6 +19,7 @@
 #include <functional>
 #include <memory>
 #include <string>
+#include <unordered_map>
 
 #include "paimon/common/io/cache/cache_key.h"
 #include "paimon/common/memory/memory_segment.h"
@@ -27,6 +28,14 @@
 namespace paimon {
 class CacheValue;
 
+/// Snapshot of the counters of a `Cache`.
+struct CacheStats {
+    uint64_t hit_count = 0;
+    uint64_t miss_count = 0;
+    uint64_t eviction_count = 0;
+    uint64_t used_bytes = 0;
+};
+
 class Cache {
  public:
     virtual ~Cache() = default;
@@ -42,6 +51,10 @@ class Cache {
     virtual void InvalidateAll() = 0;
 
     virtual std::unordered_map<std::shared_ptr<CacheKey>, std::shared_ptr<CacheValue>> AsMap() = 0;
+
+    virtual CacheStats Stats() const {
+        return {};
+    }
 };
 
 class NoCache : public Cache {
@@ -61,10 +74,17 @@ class CacheValue {
  public:
     explicit CacheValue(const std::shared_ptr<MemorySegment>& segment) : segment_(segment) {}
 
+    virtual ~CacheValue() = default;
+
     std::shared_ptr<MemorySegment> GetSegment() {
         return segment_;
     }
 
+    /// @return bytes charged to a memory-bounded cache for this value.
+    virtual int64_t Weight() const {
+        return segment_ ? segment_->Size() : 0;
+    }
+
  private:
     std::shared_ptr<MemorySegment> segment_;
 };
@@ -23,6 +23,11 @@ std::shared_ptr<CacheKey> CacheKey::ForPosition(const std::string& file_path, in
     return std::make_shared<PositionCacheKey>(file_path, position, length, is_index);
 }
 
+std::shared_ptr<CacheKey> CacheKey::ForFile(const std::string& file_path) {
+    return std::make_shared<PositionCacheKey>(file_path, /*position=*/0, /*length=*/-1,
+                                              /*is_index=*/false);
+}
+
 bool PositionCacheKey::IsIndex() {
     return is_index_;
 }
@@ -41,6 +46,11 @@ bool PositionCacheKey::operator==(const PositionCacheKey& other) const {
            length_ == other.length_ && is_index_ == other.is_index_;
 }
 
+bool PositionCacheKey::Equals(const CacheKey& other) const {
+    const auto* position_key = dynamic_cast<const PositionCacheKey*>(&other);
+    return position_key != nullptr && *this == *position_key;
+}
+
 size_t PositionCacheKey::HashCode() const {
     size_t seed = 0;
     seed ^= std::hash<std::string>{}(file_path_) + HASH_CONSTANT + (seed << 6) + (seed >> 2);
@@ -28,11 +28,31 @@ class CacheKey {
  public:
     static std::shared_ptr<CacheKey> ForPosition(const std::string& file_path, int64_t position,
                                                  int32_t length, bool is_index);
+    /// @return the key of a whole file, which is cached as one value.
+    static std::shared_ptr<CacheKey> ForFile(const std::string& file_path);
 
  public:
     virtual ~CacheKey() = default;
 
     virtual bool IsIndex() = 0;
+
+    virtual size_t HashCode() const = 0;
+    virtual bool Equals(const CacheKey& other) const = 0;
+};
+
+/// Hashes the pointed `CacheKey`, for containers keyed by `std::shared_ptr<CacheKey>`.
+struct CacheKeyHash {
+    size_t operator()(const std::shared_ptr<CacheKey>& key) const {
+        return key->HashCode();
+    }
+};
+
+/// Compares the pointed `CacheKey`s, for containers keyed by `std::shared_ptr<CacheKey>`.
+struct CacheKeyEqual {
+    bool operator()(const std::shared_ptr<CacheKey>& lhs,
+                    const std::shared_ptr<CacheKey>& rhs) const {
+        return lhs->Equals(*rhs);
+    }
 };
 
 class PositionCacheKey : public CacheKey {
@@ -46,7 +66,8 @@ class PositionCacheKey : public CacheKey {
     int32_t Length() const;
 
     bool operator==(const PositionCacheKey& other) const;
-    size_t HashCode() const;
+    size_t HashCode() const override;
+    bool Equals(const CacheKey& other) const override;
 
  private:
     static constexpr uint64_t HASH_CONSTANT = 0x9e3779b97f4a7c15ULL;
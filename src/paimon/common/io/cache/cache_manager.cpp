@@ -16,8 +16,23 @@
 
 #include "paimon/common/io/cache/cache_manager.h"
 
+#include <algorithm>
+
+#include "paimon/common/io/cache/cache_metrics.h"
+#include "paimon/common/io/cache/lru_cache.h"
+#include "paimon/common/metrics/metrics_impl.h"
+
 namespace paimon {
 
+CacheManager::CacheManager(int64_t max_memory_size, double high_priority_pool_ratio,
+                           const std::shared_ptr<MemoryPool>& pool)
+    : pool_(pool) {
+    double ratio = std::min(std::max(high_priority_pool_ratio, 0.0), 1.0);
+    auto index_cache_size = static_cast<int64_t>(max_memory_size * ratio);
+    index_cache_ = std::make_shared<LruCache>(index_cache_size);
+    data_cache_ = std::make_shared<LruCache>(max_memory_size - index_cache_size);
+}
+
 std::shared_ptr<MemorySegment> CacheManager::GetPage(
     std::shared_ptr<CacheKey>& key,
     std::function<Result<MemorySegment>(const std::shared_ptr<CacheKey>&)> reader) {
@@ -31,7 +46,8 @@ std::shared_ptr<MemorySegment> CacheManager::GetPage(
         auto ptr = std::make_shared<MemorySegment>(segment);
         return std::make_shared<CacheValue>(ptr);
     };
-    return cache->Get(key, supplier)->GetSegment();
+    auto value = cache->Get(key, supplier);
+    return value ? value->GetSegment() : nullptr;
 }
 
 void CacheManager::InvalidPage(std::shared_ptr<CacheKey>& key) {
@@ -42,4 +58,19 @@ void CacheManager::InvalidPage(std::shared_ptr<CacheKey>& key) {
     }
 }
 
+std::shared_ptr<Metrics> CacheManager::GetMetrics() const {
+    auto metrics = std::make_shared<MetricsImpl>();
+    CacheStats index_stats = index_cache_->Stats();
+    metrics->SetCounter(CacheMetrics::INDEX_CACHE_HITS, index_stats.hit_count);
+    metrics->SetCounter(CacheMetrics::INDEX_CACHE_MISSES, index_stats.miss_count);
+    metrics->SetCounter(CacheMetrics::INDEX_CACHE_EVICTIONS, index_stats.eviction_count);
+    metrics->SetCounter(CacheMetrics::INDEX_CACHE_USED_BYTES, index_stats.used_bytes);
+    CacheStats data_stats = data_cache_->Stats();
+    metrics->SetCounter(CacheMetrics::DATA_CACHE_HITS, data_stats.hit_count);
+    metrics->SetCounter(CacheMetrics::DATA_CACHE_MISSES, data_stats.miss_count);
+    metrics->SetCounter(CacheMetrics::DATA_CACHE_EVICTIONS, data_stats.eviction_count);
+    metrics->SetCounter(CacheMetrics::DATA_CACHE_USED_BYTES, data_stats.used_bytes);
+    return metrics;
+}
+
 }  // namespace paimon
@@ -26,21 +26,41 @@
 #include "paimon/result.h"
 
 namespace paimon {
+class MemoryPool;
+class Metrics;
+
+/// Holds the block caches of index and data pages. A cache manager can be shared by the readers
+/// of many files, so that the cached pages are bounded by one process-wide budget.
 class CacheManager {
  public:
+    /// Creates a cache manager which caches nothing.
     CacheManager() {
-        // todo implements cache
         data_cache_ = std::make_shared<NoCache>();
         index_cache_ = std::make_shared<NoCache>();
     }
 
+    /// Creates a cache manager bounded by `max_memory_size` bytes. Index pages get a separate
+    /// tier of `max_memory_size * high_priority_pool_ratio` bytes, so that scanning data pages
+    /// never evicts them. Pages are allocated from `pool`, which is charged for the cached bytes.
+    CacheManager(int64_t max_memory_size, double high_priority_pool_ratio,
+                 const std::shared_ptr<MemoryPool>& pool);
+
+    /// @return the page of `key`, or nullptr if `reader` fails to read it.
     std::shared_ptr<MemorySegment> GetPage(
         std::shared_ptr<CacheKey>& key,
         std::function<Result<MemorySegment>(const std::shared_ptr<CacheKey>&)> reader);
 
     void InvalidPage(std::shared_ptr<CacheKey>& key);
 
+    /// @return the pool to allocate cached pages from, nullptr if pages are not cached.
+    const std::shared_ptr<MemoryPool>& GetMemoryPool() const {
+        return pool_;
+    }
+
+    std::shared_ptr<Metrics> GetMetrics() const;
+
  private:
+    std::shared_ptr<MemoryPool> pool_;
     std::shared_ptr<Cache> data_cache_;
     std::shared_ptr<Cache> index_cache_;
 };
@@ -0,0 +1,34 @@
+/*
+ * Copyright 2026-present Alibaba Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+namespace paimon {
+
+/// Metrics of the block caches held by a cache manager.
+class CacheMetrics {
+ public:
+    static constexpr char INDEX_CACHE_HITS[] = "indexCacheHits";
+    static constexpr char INDEX_CACHE_MISSES[] = "indexCacheMisses";
+    static constexpr char INDEX_CACHE_EVICTIONS[] = "indexCacheEvictions";
+    static constexpr char INDEX_CACHE_USED_BYTES[] = "indexCacheUsedBytes";
+    static constexpr char DATA_CACHE_HITS[] = "dataCacheHits";
+    static constexpr char DATA_CACHE_MISSES[] = "dataCacheMisses";
+    static constexpr char DATA_CACHE_EVICTIONS[] = "dataCacheEvictions";
+    static constexpr char DATA_CACHE_USED_BYTES[] = "dataCacheUsedBytes";
+};
+
+}  // namespace paimon
@@ -0,0 +1,196 @@
+/*
+ * Copyright 2026-present Alibaba Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "paimon/common/io/cache/lru_cache.h"
+
+#include <algorithm>
+#include <iterator>
+#include <utility>
+
+namespace paimon {
+
+LruCache::LruCache(int64_t capacity, int32_t num_shards)
+    : capacity_(std::max<int64_t>(capacity, 0)) {
+    // avoid shards too small to hold any block
+    int32_t shard_count = capacity_ < num_shards ? 1 : std::max(num_shards, 1);
+    shards_.reserve(shard_count);
+    for (int32_t i = 0; i < shard_count; ++i) {
+        shards_.push_back(std::make_unique<Shard>(capacity_ / shard_count));
+    }
+}
+
+std::shared_ptr<CacheValue> LruCache::Get(
+    const std::shared_ptr<CacheKey>& key,
+    std::function<std::shared_ptr<CacheValue>(const std::shared_ptr<CacheKey>&)> supplier) {
+    auto value = GetShard(key)->Lookup(key);
+    if (value) {
+        hit_count_.fetch_add(1, std::memory_order_relaxed);
+        return value;
+    }
+    miss_count_.fetch_add(1, std::memory_order_relaxed);
+    // load outside the shard lock, concurrent misses of the same key may load it more than once
+    value = supplier(key);
+    if (value) {
+        Put(key, value);
+    }
+    return value;
+}
+
+void LruCache::Put(const std::shared_ptr<CacheKey>& key, const std::shared_ptr<CacheValue>& value) {
+    uint64_t evicted = GetShard(key)->Insert(key, value, WeightOf(value));
+    if (evicted > 0) {
+        eviction_count_.fetch_add(evicted, std::memory_order_relaxed);
+    }
+}
+
+void LruCache::Invalidate(const std::shared_ptr<CacheKey>& key) {
+    GetShard(key)->Erase(key);
+}
+
+void LruCache::InvalidateAll() {
+    for (const auto& shard : shards_) {
+        shard->Clear();
+    }
+}
+
+std::unordered_map<std::shared_ptr<CacheKey>, std::shared_ptr<CacheValue>> LruCache::AsMap() {
+    std::unordered_map<std::shared_ptr<CacheKey>, std::shared_ptr<CacheValue>> map;
+    for (const auto& shard : shards_) {
+        shard->CollectTo(&map);
+    }
+    return map;
+}
+
+CacheStats LruCache::Stats() const {
+    CacheStats stats;
+    stats.hit_count = hit_count_.load(std::memory_order_relaxed);
+    stats.miss_count = miss_count_.load(std::memory_order_relaxed);
+    stats.eviction_count = eviction_count_.load(std::memory_order_relaxed);
+    for (const auto& shard : shards_) {
+        stats.used_bytes += shard->Usage();
+    }
+    return stats;
+}
+
+LruCache::Shard* LruCache::GetShard(const std::shared_ptr<CacheKey>& key) const {
+    return shards_[key->HashCode() % shards_.size()].get();
+}
+
+int64_t LruCache::WeightOf(const std::shared_ptr<CacheValue>& value) {
+    return value ? value->Weight() : 0;
+}
+
+LruCache::Shard::Shard(int64_t capacity)
+    : capacity_(capacity), protected_capacity_(static_cast<int64_t>(capacity * PROTECTED_RATIO)) {}
+
+std::shared_ptr<CacheValue> LruCache::Shard::Lookup(const std::shared_ptr<CacheKey>& key) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto iter = index_.find(key);
+    if (iter == index_.end()) {
+        return nullptr;
+    }
+    auto entry = iter->second;
+    if (entry->in_protected) {
+        protected_.splice(protected_.begin(), protected_, entry);
+    } else {
+        // a second access promotes the entry from probation to protected
+        protected_.splice(protected_.begin(), probation_, entry);
+        entry->in_protected = true;
+        protected_usage_ += entry->weight;
+        BalanceProtectedLocked();
+    }
+    return entry->value;
+}
+
+uint64_t LruCache::Shard::Insert(const std::shared_ptr<CacheKey>& key,
+                                 const std::shared_ptr<CacheValue>& value, int64_t weight) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto iter = index_.find(key);
+    if (iter != index_.end()) {
+        RemoveLocked(iter->second);
+    }
+    if (weight > capacity_) {
+        return 0;
+    }
+    probation_.push_front(Entry{key, value, weight, /*in_protected=*/false});
+    index_.emplace(key, probation_.begin());
+    usage_ += weight;
+    return EvictLocked();
+}
+
+void LruCache::Shard::Erase(const std::shared_ptr<CacheKey>& key) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto iter = index_.find(key);
+    if (iter != index_.end()) {
+        RemoveLocked(iter->second);
+    }
+}
+
+void LruCache::Shard::Clear() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    index_.clear();
+    probation_.clear();
+    protected_.clear();
+    usage_ = 0;
+    protected_usage_ = 0;
+}
+
+void LruCache::Shard::CollectTo(
+    std::unordered_map<std::shared_ptr<CacheKey>, std::shared_ptr<CacheValue>>* map) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    for (const auto& [key, entry] : index_) {
+        map->emplace(key, entry->value);
+    }
+}
+
+int64_t LruCache::Shard::Usage() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return usage_;
+}
+
+void LruCache::Shard::RemoveLocked(EntryList::iterator entry) {
+    usage_ -= entry->weight;
+    index_.erase(entry->key);
+    if (entry->in_protected) {
+        protected_usage_ -= entry->weight;
+        protected_.erase(entry);
+    } else {
+        probation_.erase(entry);
+    }
+}
+
+void LruCache::Shard::BalanceProtectedLocked() {
+    // demote the least recently used protected entries, they get another chance in probation
+    while (protected_usage_ > protected_capacity_ && protected_.size() > 1) {
+        auto entry = std::prev(protected_.end());
+        probation_.splice(probation_.begin(), protected_, entry);
+        entry->in_protected = false;
+        protected_usage_ -= entry->weight;
+    }
+}
+
+uint64_t LruCache::Shard::EvictLocked() {
+    uint64_t evicted = 0;
+    while (usage_ > capacity_) {
+        // never evict the entry just inserted at the head of probation
+        EntryList& victims = probation_.size() > 1 || protected_.empty() ? probation_ : protected_;
+        RemoveLocked(std::prev(victims.end()));
+        ++evicted;
+    }
+    return evicted;
+}
+
+}  // namespace paimon
@@ -0,0 +1,111 @@
+/*
+ * Copyright 2026-present Alibaba Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+#include "paimon/common/io/cache/cache.h"
+#include "paimon/common/io/cache/cache_key.h"
+
+namespace paimon {
+
+/// A memory-bounded cache, which is split into shards by key hash to reduce lock contention.
+///
+/// Every shard is a segmented LRU: a newly inserted entry lands in the probation segment and is
+/// promoted to the protected segment when it is hit again. Evictions drain the probation segment
+/// first, so a one-off scan over many blocks does not flush blocks which are read repeatedly. The
+/// weight of an entry is `CacheValue::Weight()`.
+class LruCache : public Cache {
+ public:
+    static constexpr int32_t DEFAULT_NUM_SHARDS = 16;
+    static constexpr double PROTECTED_RATIO = 0.8;
+
+    explicit LruCache(int64_t capacity, int32_t num_shards = DEFAULT_NUM_SHARDS);
+
+    std::shared_ptr<CacheValue> Get(
+        const std::shared_ptr<CacheKey>& key,
+        std::function<std::shared_ptr<CacheValue>(const std::shared_ptr<CacheKey>&)> supplier)
+        override;
+    void Put(const std::shared_ptr<CacheKey>& key,
+             const std::shared_ptr<CacheValue>& value) override;
+    void Invalidate(const std::shared_ptr<CacheKey>& key) override;
+    void InvalidateAll() override;
+    std::unordered_map<std::shared_ptr<CacheKey>, std::shared_ptr<CacheValue>> AsMap() override;
+    CacheStats Stats() const override;
+
+    int64_t Capacity() const {
+        return capacity_;
+    }
+
+ private:
+    struct Entry {
+        std::shared_ptr<CacheKey> key;
+        std::shared_ptr<CacheValue> value;
+        int64_t weight;
+        bool in_protected;
+    };
+
+    using EntryList = std::list<Entry>;
+
+    class Shard {
+     public:
+        explicit Shard(int64_t capacity);
+
+        std::shared_ptr<CacheValue> Lookup(const std::shared_ptr<CacheKey>& key);
+        /// @return number of entries evicted to make room for the new one.
+        uint64_t Insert(const std::shared_ptr<CacheKey>& key,
+                        const std::shared_ptr<CacheValue>& value, int64_t weight);
+        void Erase(const std::shared_ptr<CacheKey>& key);
+        void Clear();
+        void CollectTo(
+            std::unordered_map<std::shared_ptr<CacheKey>, std::shared_ptr<CacheValue>>* map);
+        int64_t Usage() const;
+
+     private:
+        void RemoveLocked(EntryList::iterator iter);
+        void BalanceProtectedLocked();
+        uint64_t EvictLocked();
+
+        const int64_t capacity_;
+        const int64_t protected_capacity_;
+        mutable std::mutex mutex_;
+        EntryList probation_;
+        EntryList protected_;
+        int64_t usage_ = 0;
+        int64_t protected_usage_ = 0;
+        std::unordered_map<std::shared_ptr<CacheKey>, EntryList::iterator, CacheKeyHash,
+                           CacheKeyEqual>
+            index_;
+    };
+
+    Shard* GetShard(const std::shared_ptr<CacheKey>& key) const;
+    static int64_t WeightOf(const std::shared_ptr<CacheValue>& value);
+
+    const int64_t capacity_;
+    std::vector<std::unique_ptr<Shard>> shards_;
+    std::atomic<uint64_t> hit_count_{0};
+    std::atomic<uint64_t> miss_count_{0};
+    std::atomic<uint64_t> eviction_count_{0};
+};
+
+}  // namespace paimon
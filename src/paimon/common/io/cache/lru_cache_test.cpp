@@ -0,0 +1,157 @@
+/*
+ * Copyright 2026-present Alibaba Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "paimon/common/io/cache/lru_cache.h"
+
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "paimon/memory/memory_pool.h"
+
+namespace paimon::test {
+
+class LruCacheTest : public ::testing::Test {
+ public:
+    void SetUp() override {
+        pool_ = GetDefaultPool();
+    }
+
+    std::shared_ptr<CacheKey> Key(int64_t position, bool is_index = false) const {
+        return CacheKey::ForPosition("file", position, /*length=*/10, is_index);
+    }
+
+    std::shared_ptr<CacheValue> Value(int32_t size) const {
+        auto segment = MemorySegment::AllocateHeapMemory(size, pool_.get());
+        return std::make_shared<CacheValue>(std::make_shared<MemorySegment>(segment));
+    }
+
+    std::shared_ptr<CacheValue> GetOrLoad(LruCache* cache, int64_t position, int32_t size,
+                                          int32_t* loads) const {
+        return cache->Get(Key(position), [&](const std::shared_ptr<CacheKey>&) {
+            ++(*loads);
+            return Value(size);
+        });
+    }
+
+ protected:
+    std::shared_ptr<MemoryPool> pool_;
+};
+
+TEST_F(LruCacheTest, TestHitAndMiss) {
+    LruCache cache(/*capacity=*/100, /*num_shards=*/1);
+    int32_t loads = 0;
+    auto value = GetOrLoad(&cache, 0, 10, &loads);
+    ASSERT_EQ(value, GetOrLoad(&cache, 0, 10, &loads));
+    ASSERT_EQ(1, loads);
+    CacheStats stats = cache.Stats();
+    ASSERT_EQ(1, stats.hit_count);
+    ASSERT_EQ(1, stats.miss_count);
+    ASSERT_EQ(0, stats.eviction_count);
+    ASSERT_EQ(10, stats.used_bytes);
+
+    cache.Invalidate(Key(0));
+    ASSERT_EQ(0, cache.Stats().used_bytes);
+    GetOrLoad(&cache, 0, 10, &loads);
+    ASSERT_EQ(2, loads);
+}
+
+TEST_F(LruCacheTest, TestFailedLoadIsNotCached) {
+    LruCache cache(/*capacity=*/100, /*num_shards=*/1);
+    auto value = cache.Get(Key(0), [](const std::shared_ptr<CacheKey>&) { return nullptr; });
+    ASSERT_EQ(nullptr, value);
+    ASSERT_TRUE(cache.AsMap().empty());
+}
+
+TEST_F(LruCacheTest, TestEvictLeastRecentlyUsed) {
+    LruCache cache(/*capacity=*/30, /*num_shards=*/1);
+    int32_t loads = 0;
+    for (int64_t i = 0; i < 4; ++i) {
+        GetOrLoad(&cache, i, 10, &loads);
+    }
+    CacheStats stats = cache.Stats();
+    ASSERT_EQ(1, stats.eviction_count);
+    ASSERT_EQ(30, stats.used_bytes);
+    auto map = cache.AsMap();
+    ASSERT_EQ(3, map.size());
+    ASSERT_EQ(map.end(), map.find(Key(0)));
+}
+
+TEST_F(LruCacheTest, TestScanDoesNotEvictHotEntries) {
+    LruCache cache(/*capacity=*/50, /*num_shards=*/1);
+    int32_t loads = 0;
+    // the hot entry is promoted to the protected segment by its second access
+    GetOrLoad(&cache, 0, 10, &loads);
+    GetOrLoad(&cache, 0, 10, &loads);
+    for (int64_t i = 1; i <= 20; ++i) {
+        GetOrLoad(&cache, i, 10, &loads);
+    }
+    ASSERT_EQ(21, loads);
+    GetOrLoad(&cache, 0, 10, &loads);
+    ASSERT_EQ(21, loads);
+    ASSERT_EQ(16, cache.Stats().eviction_count);
+}
+
+TEST_F(LruCacheTest, TestOversizedValueIsNotCached) {
+    LruCache cache(/*capacity=*/30, /*num_shards=*/1);
+    int32_t loads = 0;
+    GetOrLoad(&cache, 0, 10, &loads);
+    auto value = GetOrLoad(&cache, 1, 40, &loads);
+    ASSERT_EQ(40, value->GetSegment()->Size());
+    CacheStats stats = cache.Stats();
+    ASSERT_EQ(10, stats.used_bytes);
+    ASSERT_EQ(0, stats.eviction_count);
+}
+
+TEST_F(LruCacheTest, TestPutReplacesValue) {
+    LruCache cache(/*capacity=*/100, /*num_shards=*/1);
+    cache.Put(Key(0), Value(10));
+    auto value = Value(20);
+    cache.Put(Key(0), value);
+    ASSERT_EQ(20, cache.Stats().used_bytes);
+    auto map = cache.AsMap();
+    ASSERT_EQ(1, map.size());
+    ASSERT_EQ(value, map.begin()->second);
+    cache.InvalidateAll();
+    ASSERT_TRUE(cache.AsMap().empty());
+    ASSERT_EQ(0, cache.Stats().used_bytes);
+}
+
+TEST_F(LruCacheTest, TestConcurrentAccess) {
+    LruCache cache(/*capacity=*/1000);
+    std::vector<std::thread> threads;
+    for (int32_t t = 0; t < 8; ++t) {
+        threads.emplace_back([&, t]() {
+            for (int64_t i = 0; i < 2000; ++i) {
+                int64_t position = (i * (t + 1)) % 300;
+                auto value = cache.Get(Key(position), [&](const std::shared_ptr<CacheKey>&) {
+                    return Value(10);
+                });
+                ASSERT_EQ(10, value->GetSegment()->Size());
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    CacheStats stats = cache.Stats();
+    ASSERT_EQ(8 * 2000, stats.hit_count + stats.miss_count);
+    ASSERT_LE(stats.used_bytes, 1000);
+    ASSERT_GT(stats.eviction_count, 0);
+}
+
+}  // namespace paimon::test
@@ -0,0 +1,45 @@
+/*
+ * Copyright 2024-present Alibaba Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <memory>
+
+#include "paimon/fs/file_system.h"
+#include "paimon/memory/bytes.h"
+#include "paimon/result.h"
+
+namespace paimon {
+
+/// Implemented by input streams that can hand out the file content without copying it, e.g. local
+/// files opened in mmap mode. Only for immutable files, a view may outlive the stream.
+class ZeroCopyInputStream {
+ public:
+    virtual ~ZeroCopyInputStream() = default;
+
+    /// @return a read-only view of `size` bytes at `offset`, which keeps the underlying memory
+    /// alive until released; nullptr if the stream cannot provide a view, callers read a copy
+    /// then.
+    virtual Result<std::shared_ptr<Bytes>> ReadView(uint32_t size, uint64_t offset) = 0;
+
+    /// @return `in` as a zero copy stream, nullptr if it is not one.
+    static ZeroCopyInputStream* From(InputStream* in) {
+        return dynamic_cast<ZeroCopyInputStream*>(in);
+    }
+};
+
+}  // namespace paimon
@@ -51,6 +51,10 @@ Bytes::Bytes(const std::string& str, MemoryPool* pool) : pool_(pool), size_(str.
     }
 }
 
+Bytes::Bytes(char* data, size_t size, MemoryPool* pool) : pool_(pool), data_(data), size_(size) {
+    assert(pool_ || data_ == nullptr);
+}
+
 Bytes::Bytes(Bytes&& other) noexcept {
     *this = std::move(other);
 }
@@ -16,7 +16,9 @@
 
 #include "paimon/memory/bytes.h"
 
+#include <cstring>
 #include <memory>
+#include <string>
 #include <utility>
 
 #include "gtest/gtest.h"
@@ -82,4 +84,18 @@ TEST(BytesTest, TestCompare) {
     ASSERT_LT(*bytes1, *bytes2);
     ASSERT_FALSE(*bytes1 < *bytes1);
 }
+
+TEST(BytesTest, TestTakeOverMemory) {
+    auto pool = paimon::GetMemoryPool();
+    auto* data = static_cast<char*>(pool->Malloc(5));
+    std::memcpy(data, "abcde", 5);
+    {
+        Bytes bytes(data, 5, pool.get());
+        ASSERT_EQ(data, bytes.data());
+        ASSERT_EQ("abcde", std::string(bytes.data(), bytes.size()));
+        ASSERT_EQ(5, pool->CurrentUsage());
+    }
+    // returned to the pool on destruction
+    ASSERT_EQ(0, pool->CurrentUsage());
+}
 }  // namespace paimon::test
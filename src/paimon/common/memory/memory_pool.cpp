@@ -23,6 +23,8 @@
 #include <cstring>
 #include <memory>
 
+#include "paimon/common/memory/slab_memory_pool.h"
+
 namespace paimon {
 
 class MemoryPoolImpl : public MemoryPool {
@@ -38,6 +40,14 @@ class MemoryPoolImpl : public MemoryPool {
         return max_allocated.load();
     }
 
+ private:
+    void AddAllocated(int64_t size) {
+        int64_t current = total_allocated_size.fetch_add(size) + size;
+        int64_t max = max_allocated.load();
+        while (current > max && !max_allocated.compare_exchange_weak(max, current)) {
+        }
+    }
+
  protected:
     std::atomic<int64_t> total_allocated_size = {0};
     std::atomic<int64_t> max_allocated = {0};
@@ -50,16 +60,14 @@ void* MemoryPoolImpl::Malloc(uint64_t size, uint64_t alignment) {
                        alignment == 0 ? DEFAULT_ALIGNMENT : alignment, size) != 0) {
         throw std::bad_alloc();
     }
-    total_allocated_size.fetch_add(size);
-    max_allocated.store(std::max(total_allocated_size.load(), max_allocated.load()));
+    AddAllocated(size);
     return memptr;
 }
 
 void* MemoryPoolImpl::Realloc(void* p, size_t old_size, size_t new_size, size_t alignment) {
     if (alignment == 0) {
         void* memptr = ::realloc(p, new_size);
-        total_allocated_size.fetch_add(new_size - old_size);
-        max_allocated.store(std::max(total_allocated_size.load(), max_allocated.load()));
+        AddAllocated(new_size - old_size);
         return memptr;
     } else {
         if (p == nullptr) {
@@ -70,8 +78,7 @@ void* MemoryPoolImpl::Realloc(void* p, size_t old_size, size_t new_size, size_t
             Free(p, old_size);
             return Malloc(0, alignment);
         } else if (new_size < old_size && old_size / 2 < new_size) {
-            total_allocated_size.fetch_add(new_size - old_size);
-            max_allocated.store(std::max(total_allocated_size.load(), max_allocated.load()));
+            AddAllocated(new_size - old_size);
             // do not shrink to fit, when new size is not very small, to avoid memory copy
             return p;
         } else {
@@ -101,4 +108,14 @@ PAIMON_EXPORT std::unique_ptr<MemoryPool> GetMemoryPool() {
     return std::make_unique<MemoryPoolImpl>();
 }
 
+PAIMON_EXPORT std::unique_ptr<MemoryPool> GetMemoryPool(MemoryPoolType type) {
+    switch (type) {
+        case MemoryPoolType::SLAB:
+            return std::make_unique<SlabMemoryPool>();
+        case MemoryPoolType::SYSTEM:
+        default:
+            return std::make_unique<MemoryPoolImpl>();
+    }
+}
+
 }  // namespace paimon
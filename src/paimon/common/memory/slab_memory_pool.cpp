@@ -0,0 +1,385 @@
+/*
+ * Copyright 2024-present Alibaba Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "paimon/common/memory/slab_memory_pool.h"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstdlib>
+#include <cstring>
+#include <mutex>
+#include <new>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+#include "paimon/macros.h"
+
+namespace paimon {
+
+namespace {
+
+constexpr uint64_t DEFAULT_ALIGNMENT = 64;
+constexpr uint64_t MIN_CHUNK_SIZE = 64 * 1024;
+constexpr uint64_t MIN_BLOCKS_PER_CHUNK = 8;
+
+// ids are never reused, unlike addresses of arenas
+std::atomic<uint64_t> next_arena_id = {1};
+
+uint64_t BlockSizeOf(int32_t size_class) {
+    return SlabMemoryPool::MIN_SLAB_BLOCK_SIZE << size_class;
+}
+
+// number of blocks a thread cache exchanges with the arena at once
+int32_t BatchCountOf(int32_t size_class) {
+    return static_cast<int32_t>(
+        std::clamp<uint64_t>(32 * 1024 / BlockSizeOf(size_class), /*lo=*/2, /*hi=*/32));
+}
+
+void* SystemAllocate(uint64_t size, uint64_t alignment) {
+    void* memptr = nullptr;
+    if (posix_memalign(&memptr, std::max(alignment, DEFAULT_ALIGNMENT), size) != 0) {
+        throw std::bad_alloc();
+    }
+    return memptr;
+}
+
+}  // namespace
+
+/// Free blocks of a size class, linked through their first bytes.
+struct SlabFreeList {
+    void Push(void* block) {
+        *reinterpret_cast<void**>(block) = head;
+        head = block;
+        count++;
+    }
+
+    void* Pop() {
+        void* block = head;
+        if (block) {
+            head = *reinterpret_cast<void**>(block);
+            count--;
+        }
+        return block;
+    }
+
+    void* head = nullptr;
+    int32_t count = 0;
+};
+
+/// Free blocks and memory usage cached by a thread, only accessed by the owner thread except
+/// `usage_delta`, which is read by `SlabArena::CurrentUsage()`.
+class SlabThreadCache {
+ public:
+    std::array<SlabFreeList, SlabMemoryPool::NUM_SIZE_CLASSES> free_lists;
+    std::atomic<int64_t> usage_delta = {0};
+};
+
+/// The state shared by all threads of a `SlabMemoryPool`.
+class SlabArena {
+ public:
+    SlabArena() : id_(next_arena_id.fetch_add(1)) {}
+
+    ~SlabArena() {
+        for (void* chunk : chunks_) {
+            std::free(chunk);
+        }
+    }
+
+    uint64_t Id() const {
+        return id_;
+    }
+
+    /// Moves a batch of free blocks of `size_class` into `free_list`, carves a new chunk if
+    /// there is no free block.
+    void Fetch(int32_t size_class, SlabFreeList* free_list) {
+        int32_t batch_count = BatchCountOf(size_class);
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto& blocks = free_blocks_[size_class];
+        if (blocks.empty()) {
+            uint64_t block_size = BlockSizeOf(size_class);
+            uint64_t chunk_size = std::max(MIN_CHUNK_SIZE, block_size * MIN_BLOCKS_PER_CHUNK);
+            auto* chunk = static_cast<char*>(SystemAllocate(chunk_size, block_size));
+            chunks_.push_back(chunk);
+            // push in reverse so that blocks are handed out in address order
+            for (uint64_t offset = chunk_size; offset > 0; offset -= block_size) {
+                blocks.push_back(chunk + offset - block_size);
+            }
+        }
+        for (int32_t i = 0; i < batch_count && !blocks.empty(); i++) {
+            free_list->Push(blocks.back());
+            blocks.pop_back();
+        }
+    }
+
+    /// Moves `count` blocks of `size_class` from `free_list` back to the arena.
+    void Release(int32_t size_class, int32_t count, SlabFreeList* free_list) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto& blocks = free_blocks_[size_class];
+        for (int32_t i = 0; i < count && free_list->head; i++) {
+            blocks.push_back(free_list->Pop());
+        }
+    }
+
+    SlabThreadCache* NewThreadCache() {
+        std::lock_guard<std::mutex> lock(mutex_);
+        thread_caches_.push_back(std::make_unique<SlabThreadCache>());
+        return thread_caches_.back().get();
+    }
+
+    /// Takes back the free blocks and memory usage of an exiting thread.
+    void ReleaseThreadCache(SlabThreadCache* cache) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        for (int32_t size_class = 0; size_class < SlabMemoryPool::NUM_SIZE_CLASSES;
+             size_class++) {
+            auto& free_list = cache->free_lists[size_class];
+            while (free_list.head) {
+                free_blocks_[size_class].push_back(free_list.Pop());
+            }
+        }
+        AddUsage(cache->usage_delta.load(std::memory_order_relaxed));
+        auto iter = std::find_if(thread_caches_.begin(), thread_caches_.end(),
+                                 [cache](const auto& item) { return item.get() == cache; });
+        if (iter != thread_caches_.end()) {
+            thread_caches_.erase(iter);
+        }
+    }
+
+    void AddUsage(int64_t delta) {
+        int64_t current = usage_.fetch_add(delta) + delta;
+        int64_t max = max_usage_.load();
+        while (current > max && !max_usage_.compare_exchange_weak(max, current)) {
+        }
+    }
+
+    int64_t CurrentUsage() const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        int64_t usage = usage_.load();
+        for (const auto& cache : thread_caches_) {
+            usage += cache->usage_delta.load(std::memory_order_relaxed);
+        }
+        return usage;
+    }
+
+    int64_t MaxUsage() const {
+        return max_usage_.load();
+    }
+
+    /// Records a block of at most `MAX_SLAB_BLOCK_SIZE` bytes allocated from the system because
+    /// of its alignment, its size alone would map it to a size class.
+    void AddSystemBlock(void* block) {
+        std::lock_guard<std::mutex> lock(system_blocks_mutex_);
+        system_blocks_.insert(block);
+        system_block_count_.store(system_blocks_.size());
+    }
+
+    /// @return Whether `block` was recorded by `AddSystemBlock()`, the record is removed.
+    bool RemoveSystemBlock(void* block) {
+        // blocks with such alignments are rare, do not lock for the others
+        if (PAIMON_LIKELY(system_block_count_.load() == 0)) {
+            return false;
+        }
+        std::lock_guard<std::mutex> lock(system_blocks_mutex_);
+        bool removed = system_blocks_.erase(block) > 0;
+        system_block_count_.store(system_blocks_.size());
+        return removed;
+    }
+
+ private:
+    const uint64_t id_;
+    mutable std::mutex mutex_;
+    std::vector<void*> chunks_;
+    std::array<std::vector<void*>, SlabMemoryPool::NUM_SIZE_CLASSES> free_blocks_;
+    std::vector<std::unique_ptr<SlabThreadCache>> thread_caches_;
+    std::atomic<int64_t> usage_ = {0};
+    std::atomic<int64_t> max_usage_ = {0};
+    std::mutex system_blocks_mutex_;
+    std::unordered_set<void*> system_blocks_;
+    std::atomic<size_t> system_block_count_ = {0};
+};
+
+namespace {
+
+/// Thread caches of the current thread, one per arena the thread has allocated from. Caches are
+/// owned by their arenas, and returned to them when the thread exits.
+class SlabThreadCacheRegistry {
+ public:
+    ~SlabThreadCacheRegistry() {
+        for (auto& entry : entries_) {
+            if (auto arena = entry.arena.lock()) {
+                arena->ReleaseThreadCache(entry.cache);
+            }
+        }
+    }
+
+    SlabThreadCache* Find(uint64_t arena_id) {
+        if (PAIMON_LIKELY(last_arena_id_ == arena_id)) {
+            return last_cache_;
+        }
+        for (const auto& entry : entries_) {
+            if (entry.arena_id == arena_id) {
+                last_arena_id_ = arena_id;
+                last_cache_ = entry.cache;
+                return entry.cache;
+            }
+        }
+        return nullptr;
+    }
+
+    void Add(const std::shared_ptr<SlabArena>& arena, SlabThreadCache* cache) {
+        // forget caches of destroyed arenas, which have been freed with the arenas
+        entries_.erase(std::remove_if(entries_.begin(), entries_.end(),
+                                      [](const Entry& entry) { return entry.arena.expired(); }),
+                       entries_.end());
+        entries_.push_back({arena->Id(), cache, arena});
+        last_arena_id_ = arena->Id();
+        last_cache_ = cache;
+    }
+
+ private:
+    struct Entry {
+        uint64_t arena_id;
+        SlabThreadCache* cache;
+        std::weak_ptr<SlabArena> arena;
+    };
+
+    std::vector<Entry> entries_;
+    uint64_t last_arena_id_ = 0;
+    SlabThreadCache* last_cache_ = nullptr;
+};
+
+void AddThreadUsage(SlabThreadCache* cache, SlabArena* arena, int64_t delta) {
+    // only the owner thread writes the delta, so a plain load and store is enough
+    int64_t usage_delta = cache->usage_delta.load(std::memory_order_relaxed) + delta;
+    if (PAIMON_UNLIKELY(usage_delta > SlabMemoryPool::USAGE_FLUSH_THRESHOLD ||
+                        usage_delta < -SlabMemoryPool::USAGE_FLUSH_THRESHOLD)) {
+        arena->AddUsage(usage_delta);
+        usage_delta = 0;
+    }
+    cache->usage_delta.store(usage_delta, std::memory_order_relaxed);
+}
+
+}  // namespace
+
+SlabMemoryPool::SlabMemoryPool() : arena_(std::make_shared<SlabArena>()) {}
+
+SlabMemoryPool::~SlabMemoryPool() = default;
+
+int32_t SlabMemoryPool::SizeClassOf(uint64_t size, uint64_t alignment) {
+    uint64_t block_size = std::max({size, alignment, MIN_SLAB_BLOCK_SIZE});
+    if (block_size > MAX_SLAB_BLOCK_SIZE) {
+        return -1;
+    }
+    // ceil(log2(block_size)) - log2(MIN_SLAB_BLOCK_SIZE)
+    return 64 - __builtin_clzll(block_size - 1) - 6;
+}
+
+SlabThreadCache* SlabMemoryPool::GetThreadCache() const {
+    static thread_local SlabThreadCacheRegistry registry;
+    SlabThreadCache* cache = registry.Find(arena_->Id());
+    if (PAIMON_UNLIKELY(cache == nullptr)) {
+        cache = arena_->NewThreadCache();
+        registry.Add(arena_, cache);
+    }
+    return cache;
+}
+
+void* SlabMemoryPool::Malloc(uint64_t size, uint64_t alignment) {
+    SlabThreadCache* cache = GetThreadCache();
+    int32_t size_class = SizeClassOf(size, alignment);
+    void* memptr = nullptr;
+    if (size_class < 0) {
+        memptr = SystemAllocate(size, alignment);
+        if (size <= MAX_SLAB_BLOCK_SIZE) {
+            arena_->AddSystemBlock(memptr);
+        }
+    } else {
+        SlabFreeList* free_list = &cache->free_lists[size_class];
+        if (PAIMON_UNLIKELY(free_list->head == nullptr)) {
+            arena_->Fetch(size_class, free_list);
+        }
+        memptr = free_list->Pop();
+    }
+    AddThreadUsage(cache, arena_.get(), static_cast<int64_t>(size));
+    return memptr;
+}
+
+void* SlabMemoryPool::Realloc(void* p, size_t old_size, size_t new_size, uint64_t alignment) {
+    if (p == nullptr) {
+        return Malloc(new_size, alignment);
+    }
+    int32_t old_class = SizeClassOf(old_size, alignment);
+    int32_t new_class = SizeClassOf(new_size, alignment);
+    bool fits_in_place = (old_class >= 0 && old_class == new_class);
+    // do not shrink to fit a system block, when new size is not very small, to avoid memory copy
+    bool keep_system_block = (old_class < 0 && new_class < 0 && new_size <= old_size &&
+                              old_size / 2 < new_size);
+    if (fits_in_place || keep_system_block) {
+        if (keep_system_block && old_size > MAX_SLAB_BLOCK_SIZE &&
+            new_size <= MAX_SLAB_BLOCK_SIZE) {
+            arena_->AddSystemBlock(p);
+        }
+        AddThreadUsage(GetThreadCache(), arena_.get(),
+                       static_cast<int64_t>(new_size) - static_cast<int64_t>(old_size));
+        return p;
+    }
+    void* memptr = Malloc(new_size, alignment);
+    memcpy(memptr, p, std::min(old_size, new_size));
+    Free(p, old_size, alignment);
+    return memptr;
+}
+
+void SlabMemoryPool::Free(void* p, uint64_t size) {
+    if (size <= MAX_SLAB_BLOCK_SIZE && arena_->RemoveSystemBlock(p)) {
+        std::free(p);
+        AddThreadUsage(GetThreadCache(), arena_.get(), -static_cast<int64_t>(size));
+        return;
+    }
+    Free(p, size, /*alignment=*/0);
+}
+
+void SlabMemoryPool::Free(void* p, uint64_t size, uint64_t alignment) {
+    if (PAIMON_UNLIKELY(p == nullptr)) {
+        return;
+    }
+    SlabThreadCache* cache = GetThreadCache();
+    int32_t size_class = SizeClassOf(size, alignment);
+    if (size_class < 0) {
+        if (size <= MAX_SLAB_BLOCK_SIZE) {
+            arena_->RemoveSystemBlock(p);
+        }
+        std::free(p);
+    } else {
+        SlabFreeList* free_list = &cache->free_lists[size_class];
+        free_list->Push(p);
+        int32_t batch_count = BatchCountOf(size_class);
+        if (PAIMON_UNLIKELY(free_list->count > 2 * batch_count)) {
+            arena_->Release(size_class, batch_count, free_list);
+        }
+    }
+    AddThreadUsage(cache, arena_.get(), -static_cast<int64_t>(size));
+}
+
+uint64_t SlabMemoryPool::CurrentUsage() const {
+    return std::max<int64_t>(arena_->CurrentUsage(), 0);
+}
+
+uint64_t SlabMemoryPool::MaxMemoryUsage() const {
+    return std::max<int64_t>(arena_->MaxUsage(), arena_->CurrentUsage());
+}
+
+}  // namespace paimon
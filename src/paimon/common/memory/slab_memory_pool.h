@@ -0,0 +1,76 @@
+/*
+ * Copyright 2024-present Alibaba Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+#include "paimon/memory/memory_pool.h"
+#include "paimon/visibility.h"
+
+namespace paimon {
+
+class SlabArena;
+class SlabThreadCache;
+
+/// A memory pool which serves small blocks from size-class slabs.
+///
+/// Blocks up to `MAX_SLAB_BLOCK_SIZE` bytes are carved from chunks of power-of-two size classes,
+/// a block of a size class is aligned to its class size. Larger blocks, or blocks with a larger
+/// alignment, come from the system allocator. Each thread caches free blocks per size class and
+/// exchanges them with the shared free lists in batches, so that the common Malloc() and Free()
+/// neither lock nor touch a cache line shared with other threads.
+///
+/// Memory usage is accumulated per thread as well. `CurrentUsage()` sums the usage of all
+/// threads, while `MaxMemoryUsage()` is only updated when the usage of a thread drifts by more
+/// than `USAGE_FLUSH_THRESHOLD`, so it may lag behind the real peak by that much per thread.
+///
+/// Chunks are returned to the system only when the pool is destroyed, so the pool suits a
+/// steady working set, e.g., the pool of a reader or a writer.
+class PAIMON_EXPORT SlabMemoryPool : public MemoryPool {
+ public:
+    static constexpr uint64_t MIN_SLAB_BLOCK_SIZE = 64;
+    static constexpr uint64_t MAX_SLAB_BLOCK_SIZE = 32 * 1024;
+    static constexpr int32_t NUM_SIZE_CLASSES = 10;
+    static constexpr int64_t USAGE_FLUSH_THRESHOLD = 1024 * 1024;
+
+    SlabMemoryPool();
+    ~SlabMemoryPool() override;
+
+    void* Malloc(uint64_t size, uint64_t alignment) override;
+    void* Realloc(void* p, size_t old_size, size_t new_size, uint64_t alignment) override;
+    /// A slab block allocated with an alignment larger than its size should be freed with the
+    /// alignment, otherwise it is kept in a smaller size class, which is safe but wastes memory.
+    /// Blocks allocated from the system because of their alignment are recorded by the pool, so
+    /// they are always returned to the system.
+    void Free(void* p, uint64_t size) override;
+    void Free(void* p, uint64_t size, uint64_t alignment) override;
+    uint64_t CurrentUsage() const override;
+    uint64_t MaxMemoryUsage() const override;
+
+    /// @return The size class serving a block of `size` and `alignment`, or -1 if the block is
+    /// allocated from the system.
+    static int32_t SizeClassOf(uint64_t size, uint64_t alignment);
+
+ private:
+    SlabThreadCache* GetThreadCache() const;
+
+    std::shared_ptr<SlabArena> arena_;
+};
+
+}  // namespace paimon
@@ -0,0 +1,90 @@
+/*
+ * Copyright 2024-present Alibaba Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <chrono>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "arrow/api.h"
+#include "arrow/array/concatenate.h"
+#include "gtest/gtest.h"
+#include "paimon/common/data/binary_row.h"
+#include "paimon/common/utils/arrow/mem_utils.h"
+#include "paimon/memory/memory_pool.h"
+#include "paimon/testing/utils/binary_row_generator.h"
+#include "paimon/testing/utils/testharness.h"
+
+namespace paimon::test {
+// Reports the time of the allocation pattern of the write path (serializing rows and building
+// small batches) and of the read path (concatenating small batches), per memory pool type.
+TEST(SlabMemoryPoolBenchmark, ReadAndWritePath) {
+    const int32_t batch_count = 2000;
+    const int32_t batch_size = 256;
+    std::vector<std::pair<std::string, MemoryPoolType>> pool_types = {
+        {"system", MemoryPoolType::SYSTEM}, {"slab", MemoryPoolType::SLAB}};
+    for (const auto& [name, type] : pool_types) {
+        std::shared_ptr<MemoryPool> pool = GetMemoryPool(type);
+        auto arrow_pool = GetArrowPool(pool);
+
+        auto write_start = std::chrono::steady_clock::now();
+        arrow::ArrayVector batches;
+        batches.reserve(batch_count);
+        for (int32_t i = 0; i < batch_count; ++i) {
+            arrow::Int64Builder key_builder(arrow_pool.get());
+            arrow::StringBuilder value_builder(arrow_pool.get());
+            for (int32_t j = 0; j < batch_size; ++j) {
+                int64_t key = static_cast<int64_t>(i) * batch_size + j;
+                std::string value = "value-" + std::to_string(key);
+                BinaryRow row = BinaryRowGenerator::GenerateRow({key, value}, pool.get());
+                ASSERT_EQ(2, row.GetFieldCount());
+                ASSERT_TRUE(key_builder.Append(key).ok());
+                ASSERT_TRUE(value_builder.Append(value).ok());
+            }
+            std::shared_ptr<arrow::Array> keys;
+            std::shared_ptr<arrow::Array> values;
+            ASSERT_TRUE(key_builder.Finish(&keys).ok());
+            ASSERT_TRUE(value_builder.Finish(&values).ok());
+            auto batch = arrow::StructArray::Make({keys, values}, {"key", "value"});
+            ASSERT_TRUE(batch.ok());
+            batches.push_back(batch.ValueOrDie());
+        }
+        auto write_end = std::chrono::steady_clock::now();
+
+        auto read_start = std::chrono::steady_clock::now();
+        for (int32_t i = 0; i + 8 <= batch_count; i += 8) {
+            arrow::ArrayVector group(batches.begin() + i, batches.begin() + i + 8);
+            auto merged = arrow::Concatenate(group, arrow_pool.get());
+            ASSERT_TRUE(merged.ok());
+            ASSERT_EQ(8 * batch_size, merged.ValueOrDie()->length());
+        }
+        auto read_end = std::chrono::steady_clock::now();
+        batches.clear();
+        ASSERT_EQ(0, pool->CurrentUsage());
+
+        std::cout << name << " pool: write path "
+                  << std::chrono::duration_cast<std::chrono::microseconds>(write_end -
+                                                                           write_start)
+                         .count()
+                  << " us, read path "
+                  << std::chrono::duration_cast<std::chrono::microseconds>(read_end - read_start)
+                         .count()
+                  << " us, peak " << pool->MaxMemoryUsage() << " bytes" << std::endl;
+    }
+}
+}  // namespace paimon::test
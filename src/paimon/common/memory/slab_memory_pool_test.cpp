@@ -0,0 +1,216 @@
+/*
+ * Copyright 2024-present Alibaba Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "paimon/common/memory/slab_memory_pool.h"
+
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <random>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "paimon/memory/memory_pool.h"
+
+namespace paimon::test {
+
+bool IsAligned(const void* p, uint64_t alignment) {
+    return reinterpret_cast<uintptr_t>(p) % alignment == 0;
+}
+
+TEST(SlabMemoryPoolTest, TestSizeClassOf) {
+    ASSERT_EQ(0, SlabMemoryPool::SizeClassOf(/*size=*/0, /*alignment=*/0));
+    ASSERT_EQ(0, SlabMemoryPool::SizeClassOf(/*size=*/1, /*alignment=*/0));
+    ASSERT_EQ(0, SlabMemoryPool::SizeClassOf(/*size=*/64, /*alignment=*/8));
+    ASSERT_EQ(1, SlabMemoryPool::SizeClassOf(/*size=*/65, /*alignment=*/0));
+    ASSERT_EQ(1, SlabMemoryPool::SizeClassOf(/*size=*/128, /*alignment=*/0));
+    ASSERT_EQ(6, SlabMemoryPool::SizeClassOf(/*size=*/100, /*alignment=*/4096));
+    ASSERT_EQ(9, SlabMemoryPool::SizeClassOf(/*size=*/32 * 1024, /*alignment=*/0));
+    ASSERT_EQ(-1, SlabMemoryPool::SizeClassOf(/*size=*/32 * 1024 + 1, /*alignment=*/0));
+    ASSERT_EQ(-1, SlabMemoryPool::SizeClassOf(/*size=*/64, /*alignment=*/64 * 1024));
+}
+
+TEST(SlabMemoryPoolTest, TestMallocAndFree) {
+    auto pool = GetMemoryPool(MemoryPoolType::SLAB);
+    auto* p1 = pool->Malloc(10);
+    ASSERT_TRUE(p1);
+    ASSERT_TRUE(IsAligned(p1, 64));
+    ASSERT_EQ(10, pool->CurrentUsage());
+
+    auto* p2 = pool->Malloc(100, /*alignment=*/4096);
+    ASSERT_TRUE(IsAligned(p2, 4096));
+    auto* p3 = pool->Malloc(1024 * 1024);
+    ASSERT_TRUE(IsAligned(p3, 64));
+    memset(p3, 0xff, 1024 * 1024);
+    ASSERT_EQ(10 + 100 + 1024 * 1024, pool->CurrentUsage());
+
+    pool->Free(p3, 1024 * 1024);
+    pool->Free(p2, 100, /*alignment=*/4096);
+    ASSERT_EQ(10, pool->CurrentUsage());
+    pool->Free(p1, 10);
+    ASSERT_EQ(0, pool->CurrentUsage());
+
+    // freed blocks are cached by the thread and reused
+    auto* p4 = pool->Malloc(20);
+    ASSERT_EQ(p1, p4);
+    pool->Free(p4, 20);
+    ASSERT_EQ(0, pool->CurrentUsage());
+}
+
+TEST(SlabMemoryPoolTest, TestFreeOverAlignedBlockWithoutAlignment) {
+    auto pool = GetMemoryPool(MemoryPoolType::SLAB);
+    // cache a free block of the size class, a wrongly freed block would be handed out before it
+    auto* cached = pool->Malloc(100);
+    pool->Free(cached, 100);
+
+    // the alignment exceeds any size class, the block comes from the system and is returned to it
+    // even if freed without the alignment
+    auto* p1 = pool->Malloc(100, /*alignment=*/64 * 1024);
+    ASSERT_TRUE(IsAligned(p1, 64 * 1024));
+    pool->Free(p1, 100);
+    ASSERT_EQ(0, pool->CurrentUsage());
+    auto* p2 = pool->Malloc(100);
+    ASSERT_EQ(cached, p2);
+    pool->Free(p2, 100);
+
+    // so is a system block shrunk in place to a slab size
+    cached = pool->Malloc(30 * 1024);
+    pool->Free(cached, 30 * 1024);
+    auto* p3 = pool->Malloc(48 * 1024, /*alignment=*/64 * 1024);
+    ASSERT_EQ(p3, pool->Realloc(p3, 48 * 1024, 30 * 1024, /*alignment=*/64 * 1024));
+    pool->Free(p3, 30 * 1024);
+    auto* p4 = pool->Malloc(30 * 1024);
+    ASSERT_EQ(cached, p4);
+    pool->Free(p4, 30 * 1024);
+    ASSERT_EQ(0, pool->CurrentUsage());
+}
+
+TEST(SlabMemoryPoolTest, TestMaxMemoryUsage) {
+    auto pool = GetMemoryPool(MemoryPoolType::SLAB);
+    std::vector<void*> blocks;
+    // allocate more than the flush threshold, so that the peak is recorded
+    for (int32_t i = 0; i < 64; i++) {
+        blocks.push_back(pool->Malloc(32 * 1024));
+    }
+    ASSERT_EQ(64 * 32 * 1024, pool->CurrentUsage());
+    for (void* block : blocks) {
+        pool->Free(block, 32 * 1024);
+    }
+    ASSERT_EQ(0, pool->CurrentUsage());
+    ASSERT_GE(pool->MaxMemoryUsage(), SlabMemoryPool::USAGE_FLUSH_THRESHOLD);
+    ASSERT_LE(pool->MaxMemoryUsage(), 64 * 32 * 1024);
+}
+
+TEST(SlabMemoryPoolTest, TestRealloc) {
+    auto pool = GetMemoryPool(MemoryPoolType::SLAB);
+    auto* p1 = static_cast<char*>(pool->Malloc(40));
+    memcpy(p1, "0123456789", 10);
+
+    // same size class, reallocate in place
+    auto* p2 = static_cast<char*>(pool->Realloc(p1, /*old_size=*/40, /*new_size=*/60));
+    ASSERT_EQ(p1, p2);
+    ASSERT_EQ(60, pool->CurrentUsage());
+
+    // larger size class, move the content
+    auto* p3 = static_cast<char*>(pool->Realloc(p2, /*old_size=*/60, /*new_size=*/200));
+    ASSERT_NE(p2, p3);
+    ASSERT_EQ(0, memcmp(p3, "0123456789", 10));
+    ASSERT_EQ(200, pool->CurrentUsage());
+
+    // from slab to system
+    auto* p4 = static_cast<char*>(pool->Realloc(p3, /*old_size=*/200, /*new_size=*/100000));
+    ASSERT_EQ(0, memcmp(p4, "0123456789", 10));
+    ASSERT_EQ(100000, pool->CurrentUsage());
+
+    // do not shrink a system block to fit when new size is not very small
+    auto* p5 = static_cast<char*>(pool->Realloc(p4, /*old_size=*/100000, /*new_size=*/60000));
+    ASSERT_EQ(p4, p5);
+    ASSERT_EQ(60000, pool->CurrentUsage());
+
+    auto* p6 = static_cast<char*>(pool->Realloc(p5, /*old_size=*/60000, /*new_size=*/10));
+    ASSERT_EQ(0, memcmp(p6, "0123456789", 10));
+    ASSERT_EQ(10, pool->CurrentUsage());
+
+    auto* p7 = pool->Realloc(nullptr, /*old_size=*/0, /*new_size=*/30);
+    ASSERT_TRUE(p7);
+    ASSERT_EQ(40, pool->CurrentUsage());
+    pool->Free(p7, 30);
+    pool->Free(p6, 10);
+    ASSERT_EQ(0, pool->CurrentUsage());
+}
+
+TEST(SlabMemoryPoolTest, TestMultiThreads) {
+    auto pool = GetMemoryPool(MemoryPoolType::SLAB);
+    int32_t thread_count = 8;
+    std::vector<std::thread> threads;
+    // blocks allocated by a thread and freed by another one
+    std::vector<std::vector<std::pair<void*, uint64_t>>> handed_over(thread_count);
+    for (int32_t t = 0; t < thread_count; t++) {
+        threads.emplace_back([&pool, &handed_over, t]() {
+            std::mt19937 random(t);
+            std::uniform_int_distribution<uint64_t> size_dist(1, 40 * 1024);
+            std::vector<std::pair<void*, uint64_t>> blocks;
+            for (int32_t i = 0; i < 10000; i++) {
+                if (blocks.empty() || random() % 3 != 0) {
+                    uint64_t size = size_dist(random);
+                    auto* block = static_cast<uint8_t*>(pool->Malloc(size));
+                    block[0] = static_cast<uint8_t>(size);
+                    block[size - 1] = static_cast<uint8_t>(size);
+                    blocks.emplace_back(block, size);
+                } else {
+                    auto [block, size] = blocks.back();
+                    blocks.pop_back();
+                    auto* bytes = static_cast<uint8_t*>(block);
+                    ASSERT_EQ(static_cast<uint8_t>(size), bytes[0]);
+                    ASSERT_EQ(static_cast<uint8_t>(size), bytes[size - 1]);
+                    pool->Free(block, size);
+                }
+            }
+            handed_over[t] = std::move(blocks);
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    ASSERT_GT(pool->CurrentUsage(), 0);
+    // caches of exited threads are returned to the pool
+    for (const auto& blocks : handed_over) {
+        for (const auto& [block, size] : blocks) {
+            pool->Free(block, size);
+        }
+    }
+    ASSERT_EQ(0, pool->CurrentUsage());
+}
+
+TEST(SlabMemoryPoolTest, TestPoolDestroyedBeforeThread) {
+    // the thread cache of this thread outlives the pools
+    for (int32_t i = 0; i < 3; i++) {
+        auto pool = GetMemoryPool(MemoryPoolType::SLAB);
+        void* block = pool->Malloc(100);
+        pool->Free(block, 100);
+    }
+    std::thread thread([]() {
+        auto pool = GetMemoryPool(MemoryPoolType::SLAB);
+        void* block = pool->Malloc(100);
+        pool->Free(block, 100);
+        pool.reset();
+    });
+    thread.join();
+}
+
+}  // namespace paimon::test
@@ -27,6 +27,7 @@
 #include "fmt/format.h"
 #include "paimon/common/predicate/compound_function.h"
 #include "paimon/common/predicate/predicate_filter.h"
+#include "paimon/common/predicate/predicate_kernels.h"
 #include "paimon/predicate/predicate.h"
 #include "paimon/result.h"
 #include "paimon/status.h"
@@ -58,8 +59,10 @@ class And : public CompoundFunction {
                     fmt::format("child filter {} does not support Test", child->ToString()));
             }
             PAIMON_ASSIGN_OR_RAISE(std::vector<char> child_valid, child_filter->Test(array));
-            for (size_t i = 0; i < is_valid.size(); i++) {
-                is_valid[i] = (is_valid[i] & child_valid[i]);
+            PredicateKernels::AndMask(child_valid.data(), is_valid.size(), is_valid.data());
+            if (!is_valid.empty() && PredicateKernels::NoneSet(is_valid.data(), is_valid.size())) {
+                // the remaining children cannot change the result
+                break;
             }
         }
         return is_valid;
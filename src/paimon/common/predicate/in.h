@@ -64,6 +64,21 @@ class In : public MultiLiteralsLeafFunction {
         return false;
     }
 
+    bool InnerTest(const arrow::Array& array, const LiteralSet& literal_set,
+                   char* result) const override {
+        return literal_set.Contains(array, /*negate=*/false, result);
+    }
+
+    Result<bool> InnerTest(const Literal& field, const LiteralSet& literal_set) const override {
+        return literal_set.Contains(field);
+    }
+
+    Result<bool> InnerTest(int64_t row_count, const Literal& min_value, const Literal& max_value,
+                           const std::optional<int64_t>& null_count,
+                           const LiteralSet& literal_set) const override {
+        return literal_set.ContainsAnyInRange(min_value, max_value);
+    }
+
     Type GetType() const override {
         return Type::IN;
     }
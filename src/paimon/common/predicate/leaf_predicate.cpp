@@ -40,8 +40,10 @@ const Function& LeafPredicate::GetFunction() const {
 
 std::shared_ptr<Predicate> LeafPredicate::Negate() const {
     const auto& negate_func = leaf_function_.Negate();
+    // IN and NOT IN negate to each other and can share the literal set
+    const auto* impl = dynamic_cast<const LeafPredicateImpl*>(this);
     return std::make_shared<LeafPredicateImpl>(negate_func, field_index_, field_name_, field_type_,
-                                               literals_);
+                                               literals_, impl ? impl->GetLiteralSet() : nullptr);
 }
 
 bool LeafPredicate::operator==(const Predicate& other) const {
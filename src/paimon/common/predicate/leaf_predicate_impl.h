@@ -24,6 +24,8 @@
 #include "paimon/common/predicate/compound_function.h"
 #include "paimon/common/predicate/leaf_function.h"
 #include "paimon/common/predicate/literal_converter.h"
+#include "paimon/common/predicate/literal_set.h"
+#include "paimon/common/predicate/multi_literals_leaf_function.h"
 #include "paimon/common/predicate/predicate_filter.h"
 #include "paimon/predicate/leaf_predicate.h"
 namespace paimon {
@@ -32,12 +34,33 @@ class LeafPredicateImpl : public LeafPredicate, public PredicateFilter {
     LeafPredicateImpl(const LeafFunction& leaf_function, int32_t field_index,
                       const std::string& field_name, const FieldType& field_type,
                       const std::vector<Literal>& literals)
-        : LeafPredicate(leaf_function, field_index, field_name, field_type, literals) {}
+        : LeafPredicateImpl(leaf_function, field_index, field_name, field_type, literals,
+                            /*literal_set=*/nullptr) {}
+
+    /// @param literal_set a set already built from `literals` and `field_type`, to be shared
+    /// between predicates derived from each other; built here if null.
+    LeafPredicateImpl(const LeafFunction& leaf_function, int32_t field_index,
+                      const std::string& field_name, const FieldType& field_type,
+                      const std::vector<Literal>& literals,
+                      const std::shared_ptr<const LiteralSet>& literal_set)
+        : LeafPredicate(leaf_function, field_index, field_name, field_type, literals),
+          multi_literals_function_(
+              dynamic_cast<const MultiLiteralsLeafFunction*>(&leaf_function)) {
+        if (multi_literals_function_) {
+            literal_set_ = literal_set ? literal_set : LiteralSet::Create(field_type, literals);
+        }
+    }
 
     const LeafFunction& GetLeafFunction() const {
         return leaf_function_;
     }
 
+    /// @return the lookup set of an IN / NOT IN predicate, or null if literals are compared
+    /// one by one.
+    const std::shared_ptr<const LiteralSet>& GetLiteralSet() const {
+        return literal_set_;
+    }
+
     Result<std::vector<char>> Test(const arrow::Array& array) const override {
         const auto& struct_array = arrow::internal::checked_cast<const arrow::StructArray&>(array);
         if (field_index_ >= static_cast<int32_t>(struct_array.fields().size())) {
@@ -46,6 +69,9 @@ class LeafPredicateImpl : public LeafPredicate, public PredicateFilter {
                             struct_array.fields().size()));
         }
         const auto& field_array = struct_array.field(field_index_);
+        if (literal_set_) {
+            return multi_literals_function_->Test(*field_array, literals_, *literal_set_);
+        }
         return leaf_function_.Test(*field_array, literals_);
     }
 
@@ -57,6 +83,9 @@ class LeafPredicateImpl : public LeafPredicate, public PredicateFilter {
         }
         PAIMON_ASSIGN_OR_RAISE(Literal value, LiteralConverter::ConvertLiteralsFromRow(
                                                   schema, row, field_index_, field_type_));
+        if (literal_set_) {
+            return multi_literals_function_->Test(value, literals_, *literal_set_);
+        }
         return leaf_function_.Test(value, literals_);
     }
 
@@ -80,17 +109,25 @@ class LeafPredicateImpl : public LeafPredicate, public PredicateFilter {
                 return true;
             }
         }
+        if (literal_set_) {
+            return multi_literals_function_->Test(row_count, min_value, max_value, null_count,
+                                                  literals_, *literal_set_);
+        }
         return leaf_function_.Test(row_count, min_value, max_value, null_count, literals_);
     }
 
     std::shared_ptr<LeafPredicateImpl> NewLeafPredicate(int32_t new_field_index) const {
         return std::make_shared<LeafPredicateImpl>(leaf_function_, new_field_index, field_name_,
-                                                   field_type_, literals_);
+                                                   field_type_, literals_, literal_set_);
     }
 
     std::shared_ptr<LeafPredicateImpl> NewLeafPredicate(const std::string& new_field_name) const {
         return std::make_shared<LeafPredicateImpl>(leaf_function_, field_index_, new_field_name,
-                                                   field_type_, literals_);
+                                                   field_type_, literals_, literal_set_);
     }
+
+ private:
+    const MultiLiteralsLeafFunction* multi_literals_function_;
+    std::shared_ptr<const LiteralSet> literal_set_;
 };
 }  // namespace paimon
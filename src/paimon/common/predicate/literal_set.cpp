@@ -0,0 +1,353 @@
+/*
+ * Copyright 2024-present Alibaba Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "paimon/common/predicate/literal_set.h"
+
+#include <algorithm>
+#include <cmath>
+#include <optional>
+#include <utility>
+
+#include "arrow/array/array_base.h"
+#include "arrow/array/array_binary.h"
+#include "arrow/array/array_decimal.h"
+#include "arrow/array/array_primitive.h"
+#include "arrow/type.h"
+#include "arrow/util/checked_cast.h"
+#include "paimon/common/predicate/predicate_kernels.h"
+#include "paimon/common/utils/date_time_utils.h"
+
+namespace paimon {
+namespace {
+bool IsNaN(const Literal& literal) {
+    if (literal.GetType() == FieldType::FLOAT) {
+        return std::isnan(literal.GetValue<float>());
+    }
+    if (literal.GetType() == FieldType::DOUBLE) {
+        return std::isnan(literal.GetValue<double>());
+    }
+    return false;
+}
+
+int64_t IntegerValue(const Literal& literal) {
+    switch (literal.GetType()) {
+        case FieldType::BOOLEAN:
+            return literal.GetValue<bool>();
+        case FieldType::TINYINT:
+            return literal.GetValue<int8_t>();
+        case FieldType::SMALLINT:
+            return literal.GetValue<int16_t>();
+        case FieldType::INT:
+        case FieldType::DATE:
+            return literal.GetValue<int32_t>();
+        default:
+            return literal.GetValue<int64_t>();
+    }
+}
+
+double FloatingValue(const Literal& literal) {
+    // float to double is exact and keeps the order
+    return literal.GetType() == FieldType::FLOAT ? literal.GetValue<float>()
+                                                 : literal.GetValue<double>();
+}
+
+// the field type of the literals converted from an array of this type, see LiteralConverter
+std::optional<FieldType> FieldTypeOfArray(const arrow::Array& array) {
+    switch (array.type_id()) {
+        case arrow::Type::type::BOOL:
+            return FieldType::BOOLEAN;
+        case arrow::Type::type::INT8:
+            return FieldType::TINYINT;
+        case arrow::Type::type::INT16:
+            return FieldType::SMALLINT;
+        case arrow::Type::type::INT32:
+            return FieldType::INT;
+        case arrow::Type::type::DATE32:
+            return FieldType::DATE;
+        case arrow::Type::type::INT64:
+            return FieldType::BIGINT;
+        case arrow::Type::type::FLOAT:
+            return FieldType::FLOAT;
+        case arrow::Type::type::DOUBLE:
+            return FieldType::DOUBLE;
+        case arrow::Type::type::STRING:
+            return FieldType::STRING;
+        case arrow::Type::type::BINARY:
+            return FieldType::BINARY;
+        case arrow::Type::type::TIMESTAMP:
+            return FieldType::TIMESTAMP;
+        case arrow::Type::type::DECIMAL128:
+            return FieldType::DECIMAL;
+        default:
+            return std::nullopt;
+    }
+}
+
+template <typename ArrayType, typename Probe>
+void ProbeArray(const arrow::Array& array, bool negate, Probe&& probe, char* result) {
+    const auto& typed_array = arrow::internal::checked_cast<const ArrayType&>(array);
+    for (int64_t i = 0; i < typed_array.length(); ++i) {
+        result[i] = (probe(typed_array.GetView(i)) != negate);
+    }
+}
+}  // namespace
+
+LiteralSet::LiteralSet(FieldType type, bool contains_null, std::vector<Literal>&& literals)
+    : type_(type), contains_null_(contains_null), literals_(std::move(literals)) {
+    for (const auto& literal : literals_) {
+        switch (type_) {
+            case FieldType::FLOAT:
+            case FieldType::DOUBLE:
+                floatings_.push_back(FloatingValue(literal));
+                break;
+            case FieldType::STRING:
+            case FieldType::BINARY:
+                strings_.push_back(literal.GetValue<std::string>());
+                break;
+            case FieldType::TIMESTAMP:
+                timestamps_.push_back(literal.GetValue<Timestamp>());
+                break;
+            case FieldType::DECIMAL:
+                decimals_.push_back(literal.GetValue<Decimal>());
+                break;
+            default:
+                integers_.push_back(IntegerValue(literal));
+                break;
+        }
+    }
+    // views are taken after `strings_` stops growing
+    string_set_.reserve(strings_.size());
+    for (const auto& str : strings_) {
+        string_set_.insert(str);
+    }
+}
+
+std::shared_ptr<const LiteralSet> LiteralSet::Create(FieldType field_type,
+                                                     const std::vector<Literal>& literals) {
+    switch (field_type) {
+        case FieldType::BOOLEAN:
+        case FieldType::TINYINT:
+        case FieldType::SMALLINT:
+        case FieldType::INT:
+        case FieldType::BIGINT:
+        case FieldType::FLOAT:
+        case FieldType::DOUBLE:
+        case FieldType::STRING:
+        case FieldType::BINARY:
+        case FieldType::TIMESTAMP:
+        case FieldType::DECIMAL:
+        case FieldType::DATE:
+            break;
+        default:
+            return nullptr;
+    }
+    bool contains_null = false;
+    std::vector<Literal> values;
+    std::vector<Literal> nan_values;
+    values.reserve(literals.size());
+    for (const auto& literal : literals) {
+        if (literal.IsNull()) {
+            contains_null = true;
+        } else if (literal.GetType() != field_type) {
+            return nullptr;
+        } else if (IsNaN(literal)) {
+            // NaN equals nothing, keep it out of the ordered part
+            nan_values.push_back(literal);
+        } else {
+            values.push_back(literal);
+        }
+    }
+    // literals are non-null and of the same type, CompareTo cannot fail
+    std::sort(values.begin(), values.end(), [](const Literal& lhs, const Literal& rhs) {
+        return lhs.CompareTo(rhs).value() < 0;
+    });
+    values.erase(std::unique(values.begin(), values.end(),
+                             [](const Literal& lhs, const Literal& rhs) {
+                                 return lhs.CompareTo(rhs).value() == 0;
+                             }),
+                 values.end());
+    std::shared_ptr<LiteralSet> literal_set(
+        new LiteralSet(field_type, contains_null, std::move(values)));
+    literal_set->literals_.insert(literal_set->literals_.end(), nan_values.begin(),
+                                  nan_values.end());
+    if (contains_null) {
+        literal_set->literals_.emplace_back(field_type);
+    }
+    return literal_set;
+}
+
+bool LiteralSet::ContainsInteger(int64_t value) const {
+    return std::binary_search(integers_.begin(), integers_.end(), value);
+}
+
+bool LiteralSet::ContainsFloating(double value) const {
+    // NaN is neither less nor greater than any literal, binary search would report it as found
+    if (std::isnan(value)) {
+        return false;
+    }
+    return std::binary_search(floatings_.begin(), floatings_.end(), value);
+}
+
+bool LiteralSet::ContainsString(std::string_view value) const {
+    return string_set_.find(value) != string_set_.end();
+}
+
+bool LiteralSet::ContainsTimestamp(const Timestamp& value) const {
+    return std::binary_search(timestamps_.begin(), timestamps_.end(), value);
+}
+
+bool LiteralSet::ContainsDecimal(const Decimal& value) const {
+    auto iter = std::lower_bound(
+        decimals_.begin(), decimals_.end(), value,
+        [](const Decimal& lhs, const Decimal& rhs) { return lhs.CompareTo(rhs) < 0; });
+    return iter != decimals_.end() && iter->CompareTo(value) == 0;
+}
+
+bool LiteralSet::Contains(const Literal& value) const {
+    switch (type_) {
+        case FieldType::FLOAT:
+        case FieldType::DOUBLE:
+            return ContainsFloating(FloatingValue(value));
+        case FieldType::STRING:
+        case FieldType::BINARY:
+            return ContainsString(value.GetValue<std::string>());
+        case FieldType::TIMESTAMP:
+            return ContainsTimestamp(value.GetValue<Timestamp>());
+        case FieldType::DECIMAL:
+            return ContainsDecimal(value.GetValue<Decimal>());
+        default:
+            return ContainsInteger(IntegerValue(value));
+    }
+}
+
+bool LiteralSet::ContainsAnyInRange(const Literal& min_value, const Literal& max_value) const {
+    // the smallest literal not less than min_value decides
+    switch (type_) {
+        case FieldType::FLOAT:
+        case FieldType::DOUBLE: {
+            double min_floating = FloatingValue(min_value);
+            double max_floating = FloatingValue(max_value);
+            if (std::isnan(min_floating) || std::isnan(max_floating)) {
+                return false;
+            }
+            auto iter = std::lower_bound(floatings_.begin(), floatings_.end(), min_floating);
+            return iter != floatings_.end() && *iter <= max_floating;
+        }
+        case FieldType::STRING:
+        case FieldType::BINARY: {
+            std::string min_str = min_value.GetValue<std::string>();
+            auto iter = std::lower_bound(strings_.begin(), strings_.end(), min_str);
+            return iter != strings_.end() && *iter <= max_value.GetValue<std::string>();
+        }
+        case FieldType::TIMESTAMP: {
+            Timestamp max_ts = max_value.GetValue<Timestamp>();
+            auto iter = std::lower_bound(timestamps_.begin(), timestamps_.end(),
+                                         min_value.GetValue<Timestamp>());
+            return iter != timestamps_.end() && !(max_ts < *iter);
+        }
+        case FieldType::DECIMAL: {
+            auto iter = std::lower_bound(
+                decimals_.begin(), decimals_.end(), min_value.GetValue<Decimal>(),
+                [](const Decimal& lhs, const Decimal& rhs) { return lhs.CompareTo(rhs) < 0; });
+            return iter != decimals_.end() && iter->CompareTo(max_value.GetValue<Decimal>()) <= 0;
+        }
+        default: {
+            auto iter =
+                std::lower_bound(integers_.begin(), integers_.end(), IntegerValue(min_value));
+            return iter != integers_.end() && *iter <= IntegerValue(max_value);
+        }
+    }
+}
+
+bool LiteralSet::Contains(const arrow::Array& array, bool negate, char* result) const {
+    std::optional<FieldType> array_type = FieldTypeOfArray(array);
+    if (array_type != type_) {
+        return false;
+    }
+    auto probe_integer = [this](int64_t value) { return ContainsInteger(value); };
+    auto probe_floating = [this](double value) { return ContainsFloating(value); };
+    switch (array.type_id()) {
+        case arrow::Type::type::BOOL:
+            ProbeArray<arrow::BooleanArray>(array, negate, probe_integer, result);
+            break;
+        case arrow::Type::type::INT8:
+            ProbeArray<arrow::Int8Array>(array, negate, probe_integer, result);
+            break;
+        case arrow::Type::type::INT16:
+            ProbeArray<arrow::Int16Array>(array, negate, probe_integer, result);
+            break;
+        case arrow::Type::type::INT32:
+            ProbeArray<arrow::Int32Array>(array, negate, probe_integer, result);
+            break;
+        case arrow::Type::type::DATE32:
+            ProbeArray<arrow::Date32Array>(array, negate, probe_integer, result);
+            break;
+        case arrow::Type::type::INT64:
+            ProbeArray<arrow::Int64Array>(array, negate, probe_integer, result);
+            break;
+        case arrow::Type::type::FLOAT:
+            ProbeArray<arrow::FloatArray>(array, negate, probe_floating, result);
+            break;
+        case arrow::Type::type::DOUBLE:
+            ProbeArray<arrow::DoubleArray>(array, negate, probe_floating, result);
+            break;
+        case arrow::Type::type::STRING:
+            ProbeArray<arrow::StringArray>(
+                array, negate, [this](std::string_view value) { return ContainsString(value); },
+                result);
+            break;
+        case arrow::Type::type::BINARY:
+            ProbeArray<arrow::BinaryArray>(
+                array, negate, [this](std::string_view value) { return ContainsString(value); },
+                result);
+            break;
+        case arrow::Type::type::TIMESTAMP: {
+            const auto& timestamp_array =
+                arrow::internal::checked_cast<const arrow::TimestampArray&>(array);
+            auto timestamp_type =
+                arrow::internal::checked_pointer_cast<arrow::TimestampType>(array.type());
+            DateTimeUtils::TimeType time_type =
+                DateTimeUtils::GetTimeTypeFromArrowType(timestamp_type);
+            for (int64_t i = 0; i < timestamp_array.length(); ++i) {
+                auto [milli, nano] = DateTimeUtils::TimestampConverter(
+                    timestamp_array.Value(i), time_type, DateTimeUtils::TimeType::MILLISECOND,
+                    DateTimeUtils::TimeType::NANOSECOND);
+                result[i] = (ContainsTimestamp(Timestamp(milli, nano)) != negate);
+            }
+            break;
+        }
+        case arrow::Type::type::DECIMAL128: {
+            const auto& decimal_array =
+                arrow::internal::checked_cast<const arrow::Decimal128Array&>(array);
+            const auto& decimal_type =
+                arrow::internal::checked_cast<const arrow::Decimal128Type&>(*array.type());
+            for (int64_t i = 0; i < decimal_array.length(); ++i) {
+                const arrow::Decimal128 decimal(decimal_array.GetValue(i));
+                Decimal::int128_t value =
+                    static_cast<Decimal::int128_t>(decimal.high_bits()) << 64 | decimal.low_bits();
+                result[i] = (ContainsDecimal(Decimal(decimal_type.precision(),
+                                                     decimal_type.scale(), value)) != negate);
+            }
+            break;
+        }
+        default:
+            return false;
+    }
+    PredicateKernels::ClearNulls(array, result);
+    return true;
+}
+
+}  // namespace paimon
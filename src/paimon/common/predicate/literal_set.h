@@ -0,0 +1,95 @@
+/*
+ * Copyright 2024-present Alibaba Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <unordered_set>
+#include <vector>
+
+#include "paimon/data/decimal.h"
+#include "paimon/data/timestamp.h"
+#include "paimon/defs.h"
+#include "paimon/predicate/literal.h"
+
+namespace arrow {
+class Array;
+}  // namespace arrow
+
+namespace paimon {
+/// Lookup structure built once from the literals of an IN / NOT IN predicate, so that testing a
+/// row or a min/max range does not compare against every literal. Fixed-width values are kept
+/// in a sorted array probed by binary search, strings and binaries additionally in a hash set.
+class LiteralSet {
+ public:
+    /// @return nullptr if the non-null literals are not all of `field_type`, or the type is not
+    /// supported; callers then compare literal by literal.
+    static std::shared_ptr<const LiteralSet> Create(FieldType field_type,
+                                                    const std::vector<Literal>& literals);
+
+    FieldType GetType() const {
+        return type_;
+    }
+
+    /// @return true if any of the literals is null.
+    bool ContainsNull() const {
+        return contains_null_;
+    }
+
+    /// Distinct literals in ascending order, followed by NaN literals and at most one null
+    /// literal. Equivalent to the original literals for IN / NOT IN semantics.
+    const std::vector<Literal>& Literals() const {
+        return literals_;
+    }
+
+    /// @return true if a non-null literal equals `value`.
+    /// Precondition: `value` is not null and of the type of this set.
+    bool Contains(const Literal& value) const;
+
+    /// @return true if a non-null literal lies in [min_value, max_value].
+    /// Precondition: `min_value` and `max_value` are not null and of the type of this set.
+    bool ContainsAnyInRange(const Literal& min_value, const Literal& max_value) const;
+
+    /// Writes into `result` for every row of `array` whether it is non-null and its membership
+    /// differs from `negate`.
+    /// @return false if `array` does not match the type of this set, `result` is untouched then.
+    bool Contains(const arrow::Array& array, bool negate, char* result) const;
+
+ private:
+    LiteralSet(FieldType type, bool contains_null, std::vector<Literal>&& literals);
+
+    bool ContainsInteger(int64_t value) const;
+    bool ContainsFloating(double value) const;
+    bool ContainsString(std::string_view value) const;
+    bool ContainsTimestamp(const Timestamp& value) const;
+    bool ContainsDecimal(const Decimal& value) const;
+
+    FieldType type_;
+    bool contains_null_;
+    std::vector<Literal> literals_;
+    // only the container matching `type_` is filled, all sorted ascending without duplicates
+    std::vector<int64_t> integers_;
+    std::vector<double> floatings_;
+    std::vector<std::string> strings_;
+    std::unordered_set<std::string_view> string_set_;
+    std::vector<Timestamp> timestamps_;
+    std::vector<Decimal> decimals_;
+};
+}  // namespace paimon
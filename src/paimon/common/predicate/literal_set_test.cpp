@@ -0,0 +1,177 @@
+/*
+ * Copyright 2024-present Alibaba Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "paimon/common/predicate/literal_set.h"
+
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "arrow/api.h"
+#include "arrow/ipc/json_simple.h"
+#include "gtest/gtest.h"
+#include "paimon/common/predicate/literal_converter.h"
+#include "paimon/data/decimal.h"
+#include "paimon/data/timestamp.h"
+#include "paimon/defs.h"
+#include "paimon/predicate/literal.h"
+#include "paimon/testing/utils/testharness.h"
+
+namespace paimon::test {
+namespace {
+std::shared_ptr<arrow::Array> FromJSON(const std::shared_ptr<arrow::DataType>& type,
+                                       const std::string& json) {
+    return arrow::ipc::internal::json::ArrayFromJSON(type, json).ValueOrDie();
+}
+
+// probes the array with the set and compares with a linear scan over the literals
+void CheckContains(const std::shared_ptr<arrow::Array>& array, FieldType type,
+                   const std::vector<Literal>& literals) {
+    auto literal_set = LiteralSet::Create(type, literals);
+    ASSERT_TRUE(literal_set);
+    auto values = LiteralConverter::ConvertLiteralsFromArray(*array, /*own_data=*/false);
+    ASSERT_TRUE(values.ok());
+    std::vector<char> expected(array->length(), false);
+    for (int64_t i = 0; i < array->length(); i++) {
+        if (array->IsNull(i)) {
+            continue;
+        }
+        for (const auto& literal : literals) {
+            if (!literal.IsNull() && values.value()[i].CompareTo(literal).value() == 0) {
+                expected[i] = true;
+                break;
+            }
+        }
+        ASSERT_EQ(expected[i], literal_set->Contains(values.value()[i])) << array->ToString();
+    }
+    std::vector<char> result(array->length(), 2);
+    ASSERT_TRUE(literal_set->Contains(*array, /*negate=*/false, result.data()));
+    ASSERT_EQ(expected, result) << array->ToString();
+
+    ASSERT_TRUE(literal_set->Contains(*array, /*negate=*/true, result.data()));
+    for (int64_t i = 0; i < array->length(); i++) {
+        ASSERT_EQ(!array->IsNull(i) && !expected[i], static_cast<bool>(result[i]))
+            << array->ToString() << " " << i;
+    }
+}
+}  // namespace
+
+TEST(LiteralSetTest, TestCreate) {
+    // literals of another type are compared one by one
+    ASSERT_FALSE(
+        LiteralSet::Create(FieldType::INT, {Literal(1), Literal(static_cast<int64_t>(2))}));
+    ASSERT_FALSE(LiteralSet::Create(FieldType::ARRAY, {}));
+
+    auto literal_set = LiteralSet::Create(
+        FieldType::INT, {Literal(3), Literal(1), Literal(FieldType::INT), Literal(3), Literal(2)});
+    ASSERT_TRUE(literal_set);
+    ASSERT_TRUE(literal_set->ContainsNull());
+    ASSERT_EQ(FieldType::INT, literal_set->GetType());
+    std::vector<Literal> expected = {Literal(1), Literal(2), Literal(3), Literal(FieldType::INT)};
+    ASSERT_EQ(expected, literal_set->Literals());
+}
+
+TEST(LiteralSetTest, TestContainsNumeric) {
+    CheckContains(FromJSON(arrow::int8(), "[1, -3, null, 5, 2, 2]"), FieldType::TINYINT,
+                  {Literal(static_cast<int8_t>(2)), Literal(static_cast<int8_t>(-3))});
+    CheckContains(FromJSON(arrow::int16(), "[100, null, -7, 8]"), FieldType::SMALLINT,
+                  {Literal(static_cast<int16_t>(8)), Literal(FieldType::SMALLINT)});
+    CheckContains(FromJSON(arrow::int32(), "[4, 5, null, 6, 1, 2, 3, 4, 5, 6, 7]"),
+                  FieldType::INT, {Literal(4), Literal(7), Literal(100), Literal(-1)});
+    CheckContains(FromJSON(arrow::int64(), "[null, 9, 10, 11]"), FieldType::BIGINT,
+                  {Literal(static_cast<int64_t>(10)), Literal(static_cast<int64_t>(11))});
+    CheckContains(FromJSON(arrow::boolean(), "[true, false, null, true]"), FieldType::BOOLEAN,
+                  {Literal(true)});
+    CheckContains(FromJSON(arrow::date32(), "[19000, null, 19001]"), FieldType::DATE,
+                  {Literal(FieldType::DATE, 19000)});
+
+    double nan = std::numeric_limits<double>::quiet_NaN();
+    CheckContains(FromJSON(arrow::float64(), "[0.1, null, 0.2, -0.3, NaN]"), FieldType::DOUBLE,
+                  {Literal(0.2), Literal(nan), Literal(-0.3)});
+    CheckContains(FromJSON(arrow::float32(), "[1.5, null, 2.5]"), FieldType::FLOAT,
+                  {Literal(1.5f)});
+}
+
+TEST(LiteralSetTest, TestNaNIsNotContained) {
+    double nan = std::numeric_limits<double>::quiet_NaN();
+    auto literal_set = LiteralSet::Create(FieldType::DOUBLE, {Literal(-0.3), Literal(0.2)});
+    ASSERT_TRUE(literal_set);
+    ASSERT_FALSE(literal_set->Contains(Literal(nan)));
+
+    auto array = FromJSON(arrow::float64(), "[NaN, 0.2, null]");
+    std::vector<char> result(array->length(), 2);
+    ASSERT_TRUE(literal_set->Contains(*array, /*negate=*/false, result.data()));
+    ASSERT_EQ(std::vector<char>({false, true, false}), result);
+    // NOT IN keeps NaN rows
+    ASSERT_TRUE(literal_set->Contains(*array, /*negate=*/true, result.data()));
+    ASSERT_EQ(std::vector<char>({true, false, false}), result);
+
+    ASSERT_FALSE(literal_set->ContainsAnyInRange(Literal(nan), Literal(1.0)));
+    ASSERT_FALSE(literal_set->ContainsAnyInRange(Literal(-1.0), Literal(nan)));
+    ASSERT_TRUE(literal_set->ContainsAnyInRange(Literal(-1.0), Literal(1.0)));
+}
+
+TEST(LiteralSetTest, TestContainsString) {
+    CheckContains(FromJSON(arrow::utf8(), R"(["apple", null, "banana", "", "cherry"])"),
+                  FieldType::STRING,
+                  {Literal(FieldType::STRING, "banana", 6), Literal(FieldType::STRING, "", 0),
+                   Literal(FieldType::STRING, "durian", 6)});
+    CheckContains(FromJSON(arrow::binary(), R"(["abc", "abd", null])"), FieldType::BINARY,
+                  {Literal(FieldType::BINARY, "abc", 3)});
+    auto strings = FromJSON(arrow::utf8(), R"(["a", null, "b", "c", "d"])");
+    CheckContains(strings->Slice(1, 3), FieldType::STRING, {Literal(FieldType::STRING, "b", 1)});
+}
+
+TEST(LiteralSetTest, TestContainsTimestampAndDecimal) {
+    CheckContains(FromJSON(arrow::timestamp(arrow::TimeUnit::MICRO), "[-1, 2000001, null, 0]"),
+                  FieldType::TIMESTAMP,
+                  {Literal(Timestamp(2000, 1000)), Literal(Timestamp(-1, 999000))});
+    CheckContains(FromJSON(arrow::decimal128(10, 2), R"(["1.23", "-4.50", null, "99.99"])"),
+                  FieldType::DECIMAL, {Literal(Decimal(10, 2, 123)), Literal(Decimal(5, 2, -450))});
+}
+
+TEST(LiteralSetTest, TestContainsAnyInRange) {
+    auto literal_set = LiteralSet::Create(FieldType::INT, {Literal(10), Literal(20), Literal(30)});
+    ASSERT_TRUE(literal_set);
+    ASSERT_TRUE(literal_set->ContainsAnyInRange(Literal(5), Literal(10)));
+    ASSERT_TRUE(literal_set->ContainsAnyInRange(Literal(11), Literal(25)));
+    ASSERT_TRUE(literal_set->ContainsAnyInRange(Literal(30), Literal(30)));
+    ASSERT_FALSE(literal_set->ContainsAnyInRange(Literal(11), Literal(19)));
+    ASSERT_FALSE(literal_set->ContainsAnyInRange(Literal(31), Literal(100)));
+    ASSERT_FALSE(literal_set->ContainsAnyInRange(Literal(0), Literal(9)));
+
+    auto string_set = LiteralSet::Create(FieldType::STRING, {Literal(FieldType::STRING, "b", 1),
+                                                             Literal(FieldType::STRING, "d", 1)});
+    ASSERT_TRUE(string_set);
+    ASSERT_TRUE(string_set->ContainsAnyInRange(Literal(FieldType::STRING, "a", 1),
+                                               Literal(FieldType::STRING, "c", 1)));
+    ASSERT_FALSE(string_set->ContainsAnyInRange(Literal(FieldType::STRING, "ba", 2),
+                                                Literal(FieldType::STRING, "c", 1)));
+}
+
+TEST(LiteralSetTest, TestTypeMismatch) {
+    auto literal_set = LiteralSet::Create(FieldType::BIGINT, {Literal(static_cast<int64_t>(1))});
+    ASSERT_TRUE(literal_set);
+    auto array = FromJSON(arrow::int32(), "[1, 2]");
+    std::vector<char> result(array->length(), 2);
+    ASSERT_FALSE(literal_set->Contains(*array, /*negate=*/false, result.data()));
+    ASSERT_EQ(std::vector<char>(array->length(), 2), result);
+}
+
+}  // namespace paimon::test
@@ -16,6 +16,7 @@
 
 #pragma once
 
+#include <optional>
 #include <vector>
 
 #include "arrow/array/array_nested.h"
@@ -23,6 +24,7 @@
 #include "arrow/util/checked_cast.h"
 #include "paimon/common/predicate/leaf_function.h"
 #include "paimon/common/predicate/literal_converter.h"
+#include "paimon/common/predicate/literal_set.h"
 #include "paimon/common/utils/arrow/status_utils.h"
 #include "paimon/status.h"
 
@@ -60,6 +62,42 @@ class MultiLiteralsLeafFunction : public LeafFunction {
         return InnerTest(field, literals);
     }
 
+    /// Same as the overloads above, but probes `literal_set` built from `literals` instead of
+    /// comparing with every literal. Falls back to `literals` if the input does not fit the set.
+    Result<std::vector<char>> Test(const arrow::Array& array, const std::vector<Literal>& literals,
+                                   const LiteralSet& literal_set) const {
+        std::vector<char> is_valid(array.length(), false);
+        if (InnerTest(array, literal_set, is_valid.data())) {
+            return is_valid;
+        }
+        return Test(array, literals);
+    }
+
+    Result<bool> Test(const Literal& field, const std::vector<Literal>& literals,
+                      const LiteralSet& literal_set) const {
+        if (field.IsNull()) {
+            return false;
+        }
+        if (field.GetType() != literal_set.GetType()) {
+            return InnerTest(field, literals);
+        }
+        return InnerTest(field, literal_set);
+    }
+
+    Result<bool> Test(int64_t row_count, const Literal& min_value, const Literal& max_value,
+                      const std::optional<int64_t>& null_count,
+                      const std::vector<Literal>& literals, const LiteralSet& literal_set) const {
+        if (null_count != std::nullopt && row_count == null_count.value()) {
+            return false;
+        }
+        if (min_value.IsNull() || max_value.IsNull() ||
+            min_value.GetType() != literal_set.GetType() ||
+            max_value.GetType() != literal_set.GetType()) {
+            return InnerTest(row_count, min_value, max_value, null_count, literals);
+        }
+        return InnerTest(row_count, min_value, max_value, null_count, literal_set);
+    }
+
     // Precondition: field is not empty
     virtual Result<bool> InnerTest(const Literal& field,
                                    const std::vector<Literal>& literals) const = 0;
@@ -68,5 +106,19 @@ class MultiLiteralsLeafFunction : public LeafFunction {
                                    const Literal& max_value,
                                    const std::optional<int64_t>& null_count,
                                    const std::vector<Literal>& literals) const = 0;
+
+    // Writes the result of every row into `result`, returns false if `array` does not fit
+    // `literal_set`.
+    virtual bool InnerTest(const arrow::Array& array, const LiteralSet& literal_set,
+                           char* result) const = 0;
+
+    // Precondition: field is not empty and of the type of `literal_set`
+    virtual Result<bool> InnerTest(const Literal& field, const LiteralSet& literal_set) const = 0;
+
+    // Precondition: min_value and max_value are not empty and of the type of `literal_set`
+    virtual Result<bool> InnerTest(int64_t row_count, const Literal& min_value,
+                                   const Literal& max_value,
+                                   const std::optional<int64_t>& null_count,
+                                   const LiteralSet& literal_set) const = 0;
 };
 }  // namespace paimon
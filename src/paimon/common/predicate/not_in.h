@@ -15,6 +15,7 @@
  */
 
 #pragma once
+#include <algorithm>
 #include <cstdint>
 #include <optional>
 #include <string>
@@ -66,6 +67,32 @@ class NotIn : public MultiLiteralsLeafFunction {
         return true;
     }
 
+    bool InnerTest(const arrow::Array& array, const LiteralSet& literal_set,
+                   char* result) const override {
+        if (!literal_set.Contains(array, /*negate=*/true, result)) {
+            return false;
+        }
+        if (literal_set.ContainsNull()) {
+            std::fill(result, result + array.length(), false);
+        }
+        return true;
+    }
+
+    Result<bool> InnerTest(const Literal& field, const LiteralSet& literal_set) const override {
+        return !literal_set.ContainsNull() && !literal_set.Contains(field);
+    }
+
+    Result<bool> InnerTest(int64_t row_count, const Literal& min_value, const Literal& max_value,
+                           const std::optional<int64_t>& null_count,
+                           const LiteralSet& literal_set) const override {
+        if (literal_set.ContainsNull()) {
+            return false;
+        }
+        // only a single-valued range can be fully excluded
+        PAIMON_ASSIGN_OR_RAISE(int32_t ret, min_value.CompareTo(max_value));
+        return ret != 0 || !literal_set.Contains(min_value);
+    }
+
     Type GetType() const override {
         return Type::NOT_IN;
     }
@@ -24,6 +24,7 @@
 #include "fmt/format.h"
 #include "paimon/common/predicate/leaf_function.h"
 #include "paimon/common/predicate/literal_converter.h"
+#include "paimon/common/predicate/predicate_kernels.h"
 #include "paimon/common/utils/arrow/status_utils.h"
 #include "paimon/status.h"
 
@@ -39,6 +40,10 @@ class NullFalseLeafBinaryFunction : public LeafFunction {
         if (literals[0].IsNull()) {
             return is_valid;
         }
+        if (PredicateKernels::Compare(array, literals[0], GetType(), is_valid.data())) {
+            return is_valid;
+        }
+        // no typed kernel for this array, compare row by row
         PAIMON_ASSIGN_OR_RAISE(
             std::vector<Literal> array_values,
             LiteralConverter::ConvertLiteralsFromArray(array, /*own_data=*/false));
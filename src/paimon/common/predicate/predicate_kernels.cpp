@@ -0,0 +1,341 @@
+/*
+ * Copyright 2024-present Alibaba Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "paimon/common/predicate/predicate_kernels.h"
+
+#include <cstring>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <type_traits>
+
+#include "arrow/array/array_base.h"
+#include "arrow/array/array_binary.h"
+#include "arrow/array/array_primitive.h"
+#include "arrow/type.h"
+#include "arrow/util/bit_util.h"
+#include "arrow/util/checked_cast.h"
+#include "paimon/common/utils/date_time_utils.h"
+#include "paimon/data/decimal.h"
+#include "paimon/data/timestamp.h"
+#include "paimon/defs.h"
+
+namespace paimon {
+namespace {
+// The comparators reproduce `Literal::CompareTo` which treats every value that is neither equal
+// to nor less than the literal as greater, e.g., NaN is greater than any float literal.
+struct EqualOp {
+    template <typename T>
+    bool operator()(const T& value, const T& literal) const {
+        return value == literal;
+    }
+};
+struct NotEqualOp {
+    template <typename T>
+    bool operator()(const T& value, const T& literal) const {
+        return !(value == literal);
+    }
+};
+struct LessThanOp {
+    template <typename T>
+    bool operator()(const T& value, const T& literal) const {
+        return value < literal;
+    }
+};
+struct LessOrEqualOp {
+    template <typename T>
+    bool operator()(const T& value, const T& literal) const {
+        return value <= literal;
+    }
+};
+struct GreaterThanOp {
+    template <typename T>
+    bool operator()(const T& value, const T& literal) const {
+        return !(value <= literal);
+    }
+};
+struct GreaterOrEqualOp {
+    template <typename T>
+    bool operator()(const T& value, const T& literal) const {
+        return !(value < literal);
+    }
+};
+
+template <typename Visitor>
+bool DispatchOp(Function::Type type, Visitor&& visitor) {
+    switch (type) {
+        case Function::Type::EQUAL:
+            visitor(EqualOp());
+            return true;
+        case Function::Type::NOT_EQUAL:
+            visitor(NotEqualOp());
+            return true;
+        case Function::Type::LESS_THAN:
+            visitor(LessThanOp());
+            return true;
+        case Function::Type::LESS_OR_EQUAL:
+            visitor(LessOrEqualOp());
+            return true;
+        case Function::Type::GREATER_THAN:
+            visitor(GreaterThanOp());
+            return true;
+        case Function::Type::GREATER_OR_EQUAL:
+            visitor(GreaterOrEqualOp());
+            return true;
+        default:
+            return false;
+    }
+}
+
+// branch-free loop over a contiguous value buffer, slots under nulls are masked afterwards
+template <typename T>
+bool ComparePrimitive(const T* values, int64_t length, T literal, Function::Type type,
+                      char* result) {
+    return DispatchOp(type, [&](auto op) {
+        for (int64_t i = 0; i < length; ++i) {
+            result[i] = op(values[i], literal);
+        }
+    });
+}
+
+template <typename ArrowType, typename T>
+bool CompareNumeric(const arrow::Array& array, T literal, Function::Type type, char* result) {
+    using CType = typename ArrowType::c_type;
+    static_assert(std::is_same_v<CType, T>);
+    const CType* values = array.data()->GetValues<CType>(1);
+    return ComparePrimitive<CType>(values, array.length(), literal, type, result);
+}
+
+bool CompareBoolean(const arrow::Array& array, bool literal, Function::Type type, char* result) {
+    const auto& bool_array = arrow::internal::checked_cast<const arrow::BooleanArray&>(array);
+    return DispatchOp(type, [&](auto op) {
+        for (int64_t i = 0; i < bool_array.length(); ++i) {
+            result[i] = op(bool_array.Value(i), literal);
+        }
+    });
+}
+
+template <typename ArrayType>
+bool CompareBinary(const arrow::Array& array, std::string_view literal, Function::Type type,
+                   char* result) {
+    const auto& binary_array = arrow::internal::checked_cast<const ArrayType&>(array);
+    return DispatchOp(type, [&](auto op) {
+        for (int64_t i = 0; i < binary_array.length(); ++i) {
+            result[i] = op(binary_array.GetView(i), literal);
+        }
+    });
+}
+
+bool CompareDecimal(const arrow::Array& array, const Decimal& literal, Function::Type type,
+                    char* result) {
+    const auto& decimal_type =
+        arrow::internal::checked_cast<const arrow::Decimal128Type&>(*array.type());
+    if (decimal_type.scale() != literal.Scale()) {
+        // unscaled values are only comparable within the same scale
+        return false;
+    }
+    const uint8_t* bytes = array.data()->GetValues<uint8_t>(1, /*absolute_offset=*/0) +
+                           array.offset() * decimal_type.byte_width();
+    Decimal::int128_t literal_value = literal.Value();
+    return DispatchOp(type, [&](auto op) {
+        for (int64_t i = 0; i < array.length(); ++i) {
+            Decimal::int128_t value;
+            std::memcpy(&value, bytes + i * sizeof(Decimal::int128_t), sizeof(value));
+            result[i] = op(value, literal_value);
+        }
+    });
+}
+
+bool CompareTimestamp(const arrow::Array& array, const Timestamp& literal, Function::Type type,
+                      char* result) {
+    auto timestamp_type = arrow::internal::checked_pointer_cast<arrow::TimestampType>(array.type());
+    DateTimeUtils::TimeType time_type = DateTimeUtils::GetTimeTypeFromArrowType(timestamp_type);
+    // convert the literal into the unit of the array, only exact conversions preserve ordering
+    constexpr int64_t NANOS_PER_MILLIS = 1000000;
+    int64_t nanos = literal.GetNanoOfMillisecond();
+    int64_t literal_value = 0;
+    switch (time_type) {
+        case DateTimeUtils::TimeType::SECOND:
+            if (nanos != 0 || literal.GetMillisecond() % 1000 != 0) {
+                return false;
+            }
+            literal_value = literal.GetMillisecond() / 1000;
+            break;
+        case DateTimeUtils::TimeType::MILLISECOND:
+            if (nanos != 0) {
+                return false;
+            }
+            literal_value = literal.GetMillisecond();
+            break;
+        case DateTimeUtils::TimeType::MICROSECOND:
+            if (nanos % 1000 != 0 ||
+                __builtin_mul_overflow(literal.GetMillisecond(), 1000, &literal_value) ||
+                __builtin_add_overflow(literal_value, nanos / 1000, &literal_value)) {
+                return false;
+            }
+            break;
+        case DateTimeUtils::TimeType::NANOSECOND:
+            if (__builtin_mul_overflow(literal.GetMillisecond(), NANOS_PER_MILLIS,
+                                       &literal_value) ||
+                __builtin_add_overflow(literal_value, nanos, &literal_value)) {
+                return false;
+            }
+            break;
+        default:
+            return false;
+    }
+    return CompareNumeric<arrow::TimestampType>(array, literal_value, type, result);
+}
+
+bool CompareValues(const arrow::Array& array, const Literal& literal, Function::Type type,
+                   char* result) {
+    FieldType literal_type = literal.GetType();
+    switch (array.type_id()) {
+        case arrow::Type::type::BOOL:
+            return literal_type == FieldType::BOOLEAN &&
+                   CompareBoolean(array, literal.GetValue<bool>(), type, result);
+        case arrow::Type::type::INT8:
+            return literal_type == FieldType::TINYINT &&
+                   CompareNumeric<arrow::Int8Type>(array, literal.GetValue<int8_t>(), type,
+                                                   result);
+        case arrow::Type::type::INT16:
+            return literal_type == FieldType::SMALLINT &&
+                   CompareNumeric<arrow::Int16Type>(array, literal.GetValue<int16_t>(), type,
+                                                    result);
+        case arrow::Type::type::INT32:
+            return literal_type == FieldType::INT &&
+                   CompareNumeric<arrow::Int32Type>(array, literal.GetValue<int32_t>(), type,
+                                                    result);
+        case arrow::Type::type::DATE32:
+            return literal_type == FieldType::DATE &&
+                   CompareNumeric<arrow::Date32Type>(array, literal.GetValue<int32_t>(), type,
+                                                     result);
+        case arrow::Type::type::INT64:
+            return literal_type == FieldType::BIGINT &&
+                   CompareNumeric<arrow::Int64Type>(array, literal.GetValue<int64_t>(), type,
+                                                    result);
+        case arrow::Type::type::FLOAT:
+            return literal_type == FieldType::FLOAT &&
+                   CompareNumeric<arrow::FloatType>(array, literal.GetValue<float>(), type,
+                                                    result);
+        case arrow::Type::type::DOUBLE:
+            return literal_type == FieldType::DOUBLE &&
+                   CompareNumeric<arrow::DoubleType>(array, literal.GetValue<double>(), type,
+                                                     result);
+        case arrow::Type::type::STRING: {
+            if (literal_type != FieldType::STRING) {
+                return false;
+            }
+            std::string value = literal.GetValue<std::string>();
+            return CompareBinary<arrow::StringArray>(array, value, type, result);
+        }
+        case arrow::Type::type::BINARY: {
+            if (literal_type != FieldType::BINARY) {
+                return false;
+            }
+            std::string value = literal.GetValue<std::string>();
+            return CompareBinary<arrow::BinaryArray>(array, value, type, result);
+        }
+        case arrow::Type::type::TIMESTAMP:
+            return literal_type == FieldType::TIMESTAMP &&
+                   CompareTimestamp(array, literal.GetValue<Timestamp>(), type, result);
+        case arrow::Type::type::DECIMAL128:
+            return literal_type == FieldType::DECIMAL &&
+                   CompareDecimal(array, literal.GetValue<Decimal>(), type, result);
+        default:
+            return false;
+    }
+}
+
+constexpr uint64_t ALL_SET_WORD = 0x0101010101010101ULL;
+
+template <typename Combine>
+void CombineMask(const char* other, size_t length, char* result, Combine combine) {
+    size_t i = 0;
+    for (; i + sizeof(uint64_t) <= length; i += sizeof(uint64_t)) {
+        uint64_t lhs;
+        uint64_t rhs;
+        std::memcpy(&lhs, result + i, sizeof(uint64_t));
+        std::memcpy(&rhs, other + i, sizeof(uint64_t));
+        lhs = combine(lhs, rhs);
+        std::memcpy(result + i, &lhs, sizeof(uint64_t));
+    }
+    for (; i < length; ++i) {
+        result[i] = static_cast<char>(combine(static_cast<uint64_t>(result[i]),
+                                              static_cast<uint64_t>(other[i])));
+    }
+}
+
+bool AllWordsEqual(const char* mask, size_t length, uint64_t word) {
+    size_t i = 0;
+    for (; i + sizeof(uint64_t) <= length; i += sizeof(uint64_t)) {
+        uint64_t value;
+        std::memcpy(&value, mask + i, sizeof(uint64_t));
+        if (value != word) {
+            return false;
+        }
+    }
+    for (; i < length; ++i) {
+        if (static_cast<uint8_t>(mask[i]) != (word & 0xFF)) {
+            return false;
+        }
+    }
+    return true;
+}
+}  // namespace
+
+bool PredicateKernels::Compare(const arrow::Array& array, const Literal& literal,
+                               Function::Type type, char* result) {
+    if (literal.IsNull() || !CompareValues(array, literal, type, result)) {
+        return false;
+    }
+    ClearNulls(array, result);
+    return true;
+}
+
+void PredicateKernels::ClearNulls(const arrow::Array& array, char* result) {
+    if (array.null_count() == 0) {
+        return;
+    }
+    const uint8_t* validity = array.null_bitmap_data();
+    if (validity == nullptr) {
+        // null type arrays or unions have no validity bitmap
+        std::memset(result, 0, array.length());
+        return;
+    }
+    int64_t offset = array.offset();
+    for (int64_t i = 0; i < array.length(); ++i) {
+        result[i] &= static_cast<char>(arrow::bit_util::GetBit(validity, offset + i));
+    }
+}
+
+void PredicateKernels::AndMask(const char* other, size_t length, char* result) {
+    CombineMask(other, length, result, [](uint64_t lhs, uint64_t rhs) { return lhs & rhs; });
+}
+
+void PredicateKernels::OrMask(const char* other, size_t length, char* result) {
+    CombineMask(other, length, result, [](uint64_t lhs, uint64_t rhs) { return lhs | rhs; });
+}
+
+bool PredicateKernels::NoneSet(const char* mask, size_t length) {
+    return AllWordsEqual(mask, length, /*word=*/0);
+}
+
+bool PredicateKernels::AllSet(const char* mask, size_t length) {
+    return AllWordsEqual(mask, length, ALL_SET_WORD);
+}
+
+}  // namespace paimon
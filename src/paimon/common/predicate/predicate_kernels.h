@@ -0,0 +1,59 @@
+/*
+ * Copyright 2024-present Alibaba Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include "paimon/predicate/function.h"
+#include "paimon/predicate/literal.h"
+
+namespace arrow {
+class Array;
+}  // namespace arrow
+
+namespace paimon {
+/// Typed kernels used by batch predicate evaluation. Instead of materializing one `Literal` per
+/// row, they compare the raw value buffer of an arrow array against a single literal and write
+/// the result into a byte mask, in tight loops the compiler can auto-vectorize. Null slots
+/// always evaluate to false.
+class PredicateKernels {
+ public:
+    PredicateKernels() = delete;
+    ~PredicateKernels() = delete;
+
+    /// Evaluates `array <op> literal` into `result`, which must hold `array.length()` bytes.
+    /// @param type one of EQUAL, NOT_EQUAL, LESS_THAN, LESS_OR_EQUAL, GREATER_THAN and
+    /// GREATER_OR_EQUAL.
+    /// @return false if no kernel matches the array type, the literal type and `type`, in which
+    /// case `result` is untouched and the caller must fall back to `Literal::CompareTo`.
+    static bool Compare(const arrow::Array& array, const Literal& literal, Function::Type type,
+                        char* result);
+
+    /// Resets the bytes of `result` at null slots of `array`.
+    static void ClearNulls(const arrow::Array& array, char* result);
+
+    /// Masks hold 0 or 1 per row. result[i] &= other[i], processing 8 bytes at a time.
+    static void AndMask(const char* other, size_t length, char* result);
+    /// result[i] |= other[i], processing 8 bytes at a time.
+    static void OrMask(const char* other, size_t length, char* result);
+    /// @return true if no byte of `mask` is set.
+    static bool NoneSet(const char* mask, size_t length);
+    /// @return true if every byte of `mask` is set.
+    static bool AllSet(const char* mask, size_t length);
+};
+}  // namespace paimon
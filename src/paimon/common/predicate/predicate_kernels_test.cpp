@@ -0,0 +1,212 @@
+/*
+ * Copyright 2024-present Alibaba Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "paimon/common/predicate/predicate_kernels.h"
+
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "arrow/api.h"
+#include "arrow/ipc/json_simple.h"
+#include "gtest/gtest.h"
+#include "paimon/common/predicate/literal_converter.h"
+#include "paimon/data/decimal.h"
+#include "paimon/data/timestamp.h"
+#include "paimon/defs.h"
+#include "paimon/predicate/function.h"
+#include "paimon/predicate/literal.h"
+#include "paimon/testing/utils/testharness.h"
+
+namespace paimon::test {
+namespace {
+const std::vector<Function::Type> kCompareTypes = {
+    Function::Type::EQUAL,        Function::Type::NOT_EQUAL,
+    Function::Type::LESS_THAN,    Function::Type::LESS_OR_EQUAL,
+    Function::Type::GREATER_THAN, Function::Type::GREATER_OR_EQUAL};
+
+// evaluates the predicate row by row with Literal::CompareTo as the reference result
+std::vector<char> CompareByLiterals(const arrow::Array& array, const Literal& literal,
+                                    Function::Type type) {
+    auto values = LiteralConverter::ConvertLiteralsFromArray(array, /*own_data=*/false);
+    EXPECT_TRUE(values.ok());
+    std::vector<char> expected(array.length(), false);
+    for (int64_t i = 0; i < array.length(); i++) {
+        if (array.IsNull(i)) {
+            continue;
+        }
+        int32_t res = values.value()[i].CompareTo(literal).value();
+        switch (type) {
+            case Function::Type::EQUAL:
+                expected[i] = res == 0;
+                break;
+            case Function::Type::NOT_EQUAL:
+                expected[i] = res != 0;
+                break;
+            case Function::Type::LESS_THAN:
+                expected[i] = res < 0;
+                break;
+            case Function::Type::LESS_OR_EQUAL:
+                expected[i] = res <= 0;
+                break;
+            case Function::Type::GREATER_THAN:
+                expected[i] = res > 0;
+                break;
+            default:
+                expected[i] = res >= 0;
+                break;
+        }
+    }
+    return expected;
+}
+
+void CheckCompare(const std::shared_ptr<arrow::Array>& array, const Literal& literal) {
+    for (auto type : kCompareTypes) {
+        std::vector<char> result(array->length(), 2);
+        ASSERT_TRUE(PredicateKernels::Compare(*array, literal, type, result.data()))
+            << array->ToString() << " " << literal.ToString();
+        ASSERT_EQ(CompareByLiterals(*array, literal, type), result)
+            << array->ToString() << " " << literal.ToString() << " " << static_cast<int>(type);
+    }
+}
+
+std::shared_ptr<arrow::Array> FromJSON(const std::shared_ptr<arrow::DataType>& type,
+                                       const std::string& json) {
+    return arrow::ipc::internal::json::ArrayFromJSON(type, json).ValueOrDie();
+}
+}  // namespace
+
+TEST(PredicateKernelsTest, TestCompareNumeric) {
+    CheckCompare(FromJSON(arrow::int8(), "[1, -3, null, 5, 2, 2]"),
+                 Literal(static_cast<int8_t>(2)));
+    CheckCompare(FromJSON(arrow::int16(), "[100, null, -7, 8]"), Literal(static_cast<int16_t>(8)));
+    CheckCompare(FromJSON(arrow::int32(), "[4, 5, null, 6, 1, 2, 3, 4, 5, 6, 7]"), Literal(4));
+    CheckCompare(FromJSON(arrow::int64(), "[null, 9, 10, 11]"), Literal(static_cast<int64_t>(10)));
+    CheckCompare(FromJSON(arrow::boolean(), "[true, false, null, true]"), Literal(true));
+    CheckCompare(FromJSON(arrow::date32(), "[19000, null, 19001, 18999]"),
+                 Literal(FieldType::DATE, 19000));
+}
+
+TEST(PredicateKernelsTest, TestCompareFloatingPoint) {
+    float nan = std::numeric_limits<float>::quiet_NaN();
+    arrow::FloatBuilder builder;
+    ASSERT_TRUE(builder.AppendValues({1.5f, nan, -2.0f, 0.0f}).ok());
+    ASSERT_TRUE(builder.AppendNull().ok());
+    std::shared_ptr<arrow::Array> float_array = builder.Finish().ValueOrDie();
+    CheckCompare(float_array, Literal(1.5f));
+    CheckCompare(float_array, Literal(nan));
+    CheckCompare(FromJSON(arrow::float64(), "[0.1, null, 0.2, -0.3]"), Literal(0.2));
+}
+
+TEST(PredicateKernelsTest, TestCompareString) {
+    auto array = FromJSON(arrow::utf8(), R"(["apple", null, "banana", "", "apple2", "Apple"])");
+    CheckCompare(array, Literal(FieldType::STRING, "apple", 5));
+    CheckCompare(array, Literal(FieldType::STRING, "", 0));
+    auto binary = FromJSON(arrow::binary(), R"(["abc", "abd", null, "ab"])");
+    CheckCompare(binary, Literal(FieldType::BINARY, "abc", 3));
+}
+
+TEST(PredicateKernelsTest, TestCompareTimestamp) {
+    auto second = FromJSON(arrow::timestamp(arrow::TimeUnit::SECOND), "[1, 2, null, 3]");
+    CheckCompare(second, Literal(Timestamp(2000, 0)));
+    auto milli = FromJSON(arrow::timestamp(arrow::TimeUnit::MILLI), "[1999, 2000, null, 2001]");
+    CheckCompare(milli, Literal(Timestamp(2000, 0)));
+    auto micro = FromJSON(arrow::timestamp(arrow::TimeUnit::MICRO), "[-1, 2000001, null, 0]");
+    CheckCompare(micro, Literal(Timestamp(2000, 1000)));
+    CheckCompare(micro, Literal(Timestamp(-1, 999000)));
+    auto nano = FromJSON(arrow::timestamp(arrow::TimeUnit::NANO), "[2000000001, null, 5]");
+    CheckCompare(nano, Literal(Timestamp(2000, 1)));
+
+    // a literal that cannot be represented in the unit of the array is left to the fallback
+    std::vector<char> result(second->length(), 0);
+    ASSERT_FALSE(PredicateKernels::Compare(*second, Literal(Timestamp(2500, 0)),
+                                           Function::Type::EQUAL, result.data()));
+    ASSERT_FALSE(PredicateKernels::Compare(*micro, Literal(Timestamp(2000, 1)),
+                                           Function::Type::EQUAL, result.data()));
+}
+
+TEST(PredicateKernelsTest, TestCompareDecimal) {
+    auto array = FromJSON(arrow::decimal128(10, 2), R"(["1.23", "-4.50", null, "99.99"])");
+    CheckCompare(array, Literal(Decimal(10, 2, 123)));
+    CheckCompare(array, Literal(Decimal(5, 2, -450)));
+
+    // different scales fall back to Decimal::CompareTo
+    std::vector<char> result(array->length(), 0);
+    ASSERT_FALSE(PredicateKernels::Compare(*array, Literal(Decimal(10, 3, 1230)),
+                                           Function::Type::EQUAL, result.data()));
+}
+
+TEST(PredicateKernelsTest, TestCompareSlicedArray) {
+    auto array = FromJSON(arrow::int32(), "[1, null, 3, 4, null, 6, 7, 8, 9, null]");
+    CheckCompare(array->Slice(3), Literal(6));
+    auto strings = FromJSON(arrow::utf8(), R"(["a", null, "b", "c", "d"])");
+    CheckCompare(strings->Slice(1, 3), Literal(FieldType::STRING, "b", 1));
+    auto decimals = FromJSON(arrow::decimal128(5, 1), R"(["1.0", null, "2.0", "3.0"])");
+    CheckCompare(decimals->Slice(2), Literal(Decimal(5, 1, 20)));
+}
+
+TEST(PredicateKernelsTest, TestUnsupportedInput) {
+    auto array = FromJSON(arrow::int32(), "[1, 2, 3]");
+    std::vector<char> result(array->length(), 0);
+    // mismatched literal type keeps the error reporting of the literal path
+    ASSERT_FALSE(PredicateKernels::Compare(*array, Literal(static_cast<int64_t>(1)),
+                                           Function::Type::EQUAL, result.data()));
+    ASSERT_FALSE(PredicateKernels::Compare(*array, Literal(FieldType::INT), Function::Type::EQUAL,
+                                           result.data()));
+    ASSERT_FALSE(
+        PredicateKernels::Compare(*array, Literal(1), Function::Type::IS_NULL, result.data()));
+    auto large_string = FromJSON(arrow::large_utf8(), R"(["a"])");
+    ASSERT_FALSE(PredicateKernels::Compare(*large_string, Literal(FieldType::STRING, "a", 1),
+                                           Function::Type::EQUAL, result.data()));
+    ASSERT_EQ(std::vector<char>(3, 0), result);
+}
+
+TEST(PredicateKernelsTest, TestMasks) {
+    for (size_t length : {0, 1, 7, 8, 9, 17, 64}) {
+        std::vector<char> lhs(length);
+        std::vector<char> rhs(length);
+        for (size_t i = 0; i < length; i++) {
+            lhs[i] = (i % 3 == 0);
+            rhs[i] = (i % 2 == 0);
+        }
+        std::vector<char> and_result = lhs;
+        PredicateKernels::AndMask(rhs.data(), length, and_result.data());
+        std::vector<char> or_result = lhs;
+        PredicateKernels::OrMask(rhs.data(), length, or_result.data());
+        for (size_t i = 0; i < length; i++) {
+            ASSERT_EQ(lhs[i] & rhs[i], and_result[i]);
+            ASSERT_EQ(lhs[i] | rhs[i], or_result[i]);
+        }
+
+        std::vector<char> zeros(length, 0);
+        std::vector<char> ones(length, 1);
+        ASSERT_TRUE(PredicateKernels::NoneSet(zeros.data(), length));
+        ASSERT_TRUE(PredicateKernels::AllSet(ones.data(), length));
+        if (length > 0) {
+            ASSERT_EQ(length == 1, PredicateKernels::AllSet(lhs.data(), length));
+            ASSERT_FALSE(PredicateKernels::NoneSet(lhs.data(), length));
+            zeros[length - 1] = 1;
+            ones[length - 1] = 0;
+            ASSERT_FALSE(PredicateKernels::NoneSet(zeros.data(), length));
+            ASSERT_FALSE(PredicateKernels::AllSet(ones.data(), length));
+        }
+    }
+}
+
+}  // namespace paimon::test
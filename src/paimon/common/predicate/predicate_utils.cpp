@@ -25,6 +25,15 @@
 #include "paimon/predicate/predicate_builder.h"
 
 namespace paimon {
+const std::vector<Literal>& PredicateUtils::DistinctLiterals(
+    const std::shared_ptr<LeafPredicate>& predicate) {
+    auto leaf_predicate = std::dynamic_pointer_cast<LeafPredicateImpl>(predicate);
+    if (leaf_predicate && leaf_predicate->GetLiteralSet()) {
+        return leaf_predicate->GetLiteralSet()->Literals();
+    }
+    return predicate->Literals();
+}
+
 Result<bool> PredicateUtils::ContainAnyField(const std::shared_ptr<Predicate>& predicate,
                                              const std::set<std::string>& field_names) {
     if (auto leaf_predicate = std::dynamic_pointer_cast<LeafPredicate>(predicate)) {
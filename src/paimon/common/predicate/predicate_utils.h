@@ -94,9 +94,9 @@ class PAIMON_EXPORT PredicateUtils {
                 return visitor->VisitLessOrEqual(predicate->Literals()[0]);
             }
             case Function::Type::IN:
-                return visitor->VisitIn(predicate->Literals());
+                return visitor->VisitIn(DistinctLiterals(predicate));
             case Function::Type::NOT_IN:
-                return visitor->VisitNotIn(predicate->Literals());
+                return visitor->VisitNotIn(DistinctLiterals(predicate));
             default:
                 // TODO(xinyu.lxy): support StartsWith/EndsWith/Contains
                 return Status::Invalid(fmt::format("invalid {} function in leaf predicate",
@@ -105,6 +105,11 @@ class PAIMON_EXPORT PredicateUtils {
     }
 
  private:
+    /// @return the literals of an IN / NOT IN predicate without duplicates if they are kept in a
+    /// literal set, otherwise the literals as given.
+    static const std::vector<Literal>& DistinctLiterals(
+        const std::shared_ptr<LeafPredicate>& predicate);
+
     static Result<std::optional<std::shared_ptr<Predicate>>> ReconstructPredicateWithPickedFields(
         const std::shared_ptr<Predicate>& predicate,
         const std::map<std::string, int32_t>& picked_field_name_to_idx);
@@ -0,0 +1,234 @@
+/*
+ * Copyright 2024-present Alibaba Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "paimon/common/reader/lookahead_concat_batch_reader.h"
+
+#include <algorithm>
+#include <utility>
+
+#include "paimon/common/metrics/metrics_impl.h"
+#include "paimon/common/reader/reader_utils.h"
+#include "paimon/common/utils/arrow/mem_utils.h"
+#include "paimon/executor.h"
+
+namespace paimon {
+
+LookaheadConcatBatchReader::LookaheadConcatBatchReader(
+    std::vector<DeferredReader>&& deferred_readers, int32_t lookahead, int64_t memory_budget,
+    const std::shared_ptr<Executor>& executor, const std::shared_ptr<MemoryPool>& pool)
+    : arrow_pool_(GetArrowPool(pool)),
+      executor_(executor),
+      state_(std::make_shared<SharedState>()),
+      lookahead_(std::max(lookahead, 1)),
+      memory_budget_(memory_budget) {
+    state_->slots.resize(deferred_readers.size());
+    for (size_t i = 0; i < deferred_readers.size(); i++) {
+        state_->slots[i].deferred = std::move(deferred_readers[i]);
+    }
+}
+
+LookaheadConcatBatchReader::~LookaheadConcatBatchReader() {
+    Close();
+}
+
+void LookaheadConcatBatchReader::OpenSlot(const std::shared_ptr<SharedState>& state,
+                                          size_t index) {
+    // slots are never resized, the reference is stable
+    Slot& slot = state->slots[index];
+    Result<std::unique_ptr<BatchReader>> result = slot.deferred.supplier();
+    Status status = result.status();
+    std::unique_ptr<BatchReader> reader;
+    std::optional<ReadBatchWithBitmap> first_batch;
+    if (result.ok()) {
+        reader = std::move(result).value();
+    }
+    if (reader) {
+        // warm up the reader, e.g., the first row group or stripe is fetched and decoded
+        Result<ReadBatchWithBitmap> batch = reader->NextBatchWithBitmap();
+        if (batch.ok()) {
+            first_batch = std::move(batch).value();
+        } else {
+            status = batch.status();
+        }
+    }
+    std::lock_guard<std::mutex> lock(state->mutex);
+    slot.deferred.supplier = nullptr;
+    slot.reader = std::move(reader);
+    slot.first_batch = std::move(first_batch);
+    slot.status = std::move(status);
+    slot.state = OpenState::OPENED;
+    state->condition.notify_all();
+}
+
+void LookaheadConcatBatchReader::OpenSlotIfQueued(const std::shared_ptr<SharedState>& state,
+                                                  size_t index) {
+    {
+        std::lock_guard<std::mutex> lock(state->mutex);
+        Slot& slot = state->slots[index];
+        if (slot.state != OpenState::QUEUED) {
+            // already opened by the consuming thread
+            return;
+        }
+        if (state->closed) {
+            slot.state = OpenState::PENDING;
+            return;
+        }
+        slot.state = OpenState::OPENING;
+    }
+    OpenSlot(state, index);
+}
+
+void LookaheadConcatBatchReader::ScheduleLookaheadLocked(std::vector<size_t>* to_schedule) {
+    std::vector<Slot>& slots = state_->slots;
+    next_to_schedule_ = std::max(next_to_schedule_, current_ + 1);
+    while (next_to_schedule_ < slots.size() &&
+           next_to_schedule_ - current_ - 1 < static_cast<size_t>(lookahead_)) {
+        Slot& slot = slots[next_to_schedule_];
+        bool has_ahead = next_to_schedule_ > current_ + 1;
+        if (has_ahead && ahead_memory_ + slot.deferred.memory_size > memory_budget_) {
+            break;
+        }
+        ahead_memory_ += slot.deferred.memory_size;
+        slot.ahead = true;
+        slot.state = OpenState::QUEUED;
+        to_schedule->push_back(next_to_schedule_++);
+    }
+}
+
+void LookaheadConcatBatchReader::Submit(const std::vector<size_t>& to_schedule) {
+    for (size_t index : to_schedule) {
+        executor_->Add([state = state_, index]() { OpenSlotIfQueued(state, index); });
+    }
+}
+
+Status LookaheadConcatBatchReader::TakeCurrentReader() {
+    std::vector<size_t> to_schedule;
+    std::unique_lock<std::mutex> lock(state_->mutex);
+    Slot& slot = state_->slots[current_];
+    if (slot.ahead) {
+        // the slot is current now, make room for the next one
+        slot.ahead = false;
+        ahead_memory_ -= slot.deferred.memory_size;
+    }
+    ScheduleLookaheadLocked(&to_schedule);
+    lock.unlock();
+    Submit(to_schedule);
+    lock.lock();
+    while (slot.state != OpenState::OPENED) {
+        if (slot.state == OpenState::OPENING) {
+            state_->condition.wait(lock);
+            continue;
+        }
+        // the open task is not started yet, e.g., all threads of executor are busy, open in
+        // place instead of waiting
+        slot.state = OpenState::OPENING;
+        lock.unlock();
+        OpenSlot(state_, current_);
+        lock.lock();
+    }
+    PAIMON_RETURN_NOT_OK(slot.status);
+    slot.state = OpenState::TAKEN;
+    std::unique_ptr<BatchReader> reader = std::move(slot.reader);
+    std::optional<ReadBatchWithBitmap> first_batch = std::move(slot.first_batch);
+    lock.unlock();
+    if (reader) {
+        readers_.push_back(std::move(reader));
+        current_first_batch_ = std::move(first_batch);
+        current_taken_ = true;
+    } else {
+        // nothing to read, e.g., skipped by index
+        current_++;
+    }
+    return Status::OK();
+}
+
+Result<BatchReader::ReadBatch> LookaheadConcatBatchReader::NextBatch() {
+    PAIMON_ASSIGN_OR_RAISE(BatchReader::ReadBatchWithBitmap batch_with_bitmap,
+                           NextBatchWithBitmap());
+    return ReaderUtils::ApplyBitmapToReadBatch(std::move(batch_with_bitmap), arrow_pool_.get());
+}
+
+Result<BatchReader::ReadBatchWithBitmap> LookaheadConcatBatchReader::NextBatchWithBitmap() {
+    while (current_ < state_->slots.size()) {
+        if (!current_taken_) {
+            PAIMON_RETURN_NOT_OK(TakeCurrentReader());
+            continue;
+        }
+        auto& current_reader = readers_.back();
+        BatchReader::ReadBatchWithBitmap result;
+        if (current_first_batch_) {
+            result = std::move(current_first_batch_).value();
+            current_first_batch_.reset();
+        } else {
+            PAIMON_ASSIGN_OR_RAISE(result, current_reader->NextBatchWithBitmap());
+        }
+        if (!BatchReader::IsEofBatch(result)) {
+            // current reader not eof, just return
+            return result;
+        }
+        // current meets eof, move to next reader
+        current_reader->Close();
+        current_taken_ = false;
+        current_++;
+    }
+    // read finish
+    return BatchReader::MakeEofBatchWithBitmap();
+}
+
+void LookaheadConcatBatchReader::Close() {
+    std::vector<Slot>& slots = state_->slots;
+    {
+        std::unique_lock<std::mutex> lock(state_->mutex);
+        if (state_->closed) {
+            return;
+        }
+        state_->closed = true;
+        // wait for running tasks, tasks not started yet will skip opening
+        state_->condition.wait(lock, [&slots]() {
+            return std::none_of(slots.begin(), slots.end(), [](const Slot& slot) {
+                return slot.state == OpenState::OPENING;
+            });
+        });
+    }
+    if (current_taken_) {
+        readers_.back()->Close();
+        current_taken_ = false;
+    }
+    if (current_first_batch_) {
+        ReaderUtils::ReleaseReadBatch(std::move(current_first_batch_.value().first));
+        current_first_batch_.reset();
+    }
+    for (; current_ < slots.size(); current_++) {
+        Slot& slot = slots[current_];
+        if (slot.state != OpenState::OPENED) {
+            continue;
+        }
+        if (slot.reader) {
+            slot.reader->Close();
+        }
+        if (slot.first_batch) {
+            ReaderUtils::ReleaseReadBatch(std::move(slot.first_batch.value().first));
+        }
+        slot.reader.reset();
+        slot.first_batch.reset();
+    }
+}
+
+std::shared_ptr<Metrics> LookaheadConcatBatchReader::GetReaderMetrics() const {
+    return MetricsImpl::CollectReadMetrics(readers_);
+}
+
+}  // namespace paimon
@@ -0,0 +1,131 @@
+/*
+ * Copyright 2024-present Alibaba Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <vector>
+
+#include "arrow/api.h"
+#include "paimon/metrics.h"
+#include "paimon/reader/batch_reader.h"
+#include "paimon/result.h"
+#include "paimon/status.h"
+
+namespace paimon {
+class Executor;
+class MemoryPool;
+
+/// Like `ConcatBatchReader`, returns the batches of a list of readers one reader after another,
+/// but the readers are created lazily. While the current reader is consumed, up to `lookahead`
+/// following readers are created on an `Executor` and read their first batch, so that opening a
+/// file (footer, schema, index, deletion vector) overlaps with decoding the previous one. The
+/// readers opened ahead hold at most `memory_budget` bytes of estimated memory, except that one
+/// reader is always opened ahead.
+///
+/// Errors of creating a reader are returned when the reader becomes current, so the order of
+/// results is the same as `ConcatBatchReader`.
+class LookaheadConcatBatchReader : public BatchReader {
+ public:
+    /// Creates a reader, returns nullptr if there is nothing to read (e.g., the file is skipped by
+    /// index). Called on the executor, so it must be thread-safe.
+    using ReaderSupplier = std::function<Result<std::unique_ptr<BatchReader>>()>;
+
+    struct DeferredReader {
+        ReaderSupplier supplier;
+        /// Estimated memory held by the reader once opened, e.g., the file size.
+        int64_t memory_size = 0;
+    };
+
+    LookaheadConcatBatchReader(std::vector<DeferredReader>&& deferred_readers, int32_t lookahead,
+                               int64_t memory_budget, const std::shared_ptr<Executor>& executor,
+                               const std::shared_ptr<MemoryPool>& pool);
+    ~LookaheadConcatBatchReader() override;
+
+    Result<ReadBatch> NextBatch() override;
+    Result<ReadBatchWithBitmap> NextBatchWithBitmap() override;
+    void Close() override;
+    std::shared_ptr<Metrics> GetReaderMetrics() const override;
+
+ private:
+    enum class OpenState {
+        /// Not scheduled.
+        PENDING,
+        /// An open task is added to the executor but not started.
+        QUEUED,
+        /// The reader is being created, by a task or by the consuming thread.
+        OPENING,
+        /// The reader is created and its first batch is read, or an error occurs.
+        OPENED,
+        /// The reader is taken by the consuming thread.
+        TAKEN,
+    };
+
+    struct Slot {
+        DeferredReader deferred;
+        OpenState state = OpenState::PENDING;
+        std::unique_ptr<BatchReader> reader;
+        std::optional<ReadBatchWithBitmap> first_batch;
+        Status status;
+        /// Whether the memory of the slot is counted in `ahead_memory_`.
+        bool ahead = false;
+    };
+
+    /// Shared with open tasks, so that tasks never access a destroyed reader.
+    struct SharedState {
+        std::mutex mutex;
+        std::condition_variable condition;
+        std::vector<Slot> slots;
+        bool closed = false;
+    };
+
+    /// Creates the reader of slot `index` and reads its first batch, the caller marks the slot as
+    /// OPENING before.
+    static void OpenSlot(const std::shared_ptr<SharedState>& state, size_t index);
+
+    /// Task body, skips the slot if it is already opened by the consuming thread.
+    static void OpenSlotIfQueued(const std::shared_ptr<SharedState>& state, size_t index);
+
+    /// Queues the slots after the current one while the lookahead and memory budget allow, and
+    /// records them to be added to the executor after the lock is released.
+    void ScheduleLookaheadLocked(std::vector<size_t>* to_schedule);
+    void Submit(const std::vector<size_t>& to_schedule);
+
+    /// Waits for (or creates in place) the reader of the current slot and moves it out.
+    Status TakeCurrentReader();
+
+ private:
+    std::unique_ptr<arrow::MemoryPool> arrow_pool_;
+    std::shared_ptr<Executor> executor_;
+    std::shared_ptr<SharedState> state_;
+    int32_t lookahead_;
+    int64_t memory_budget_;
+    /// Estimated memory of the slots scheduled ahead and not taken yet.
+    int64_t ahead_memory_ = 0;
+    size_t current_ = 0;
+    size_t next_to_schedule_ = 0;
+    bool current_taken_ = false;
+    /// Taken readers, the last one is being read if `current_taken_`.
+    std::vector<std::unique_ptr<BatchReader>> readers_;
+    std::optional<ReadBatchWithBitmap> current_first_batch_;
+};
+}  // namespace paimon
@@ -0,0 +1,195 @@
+/*
+ * Copyright 2024-present Alibaba Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "paimon/common/reader/lookahead_concat_batch_reader.h"
+
+#include <atomic>
+#include <cstdint>
+#include <string>
+#include <utility>
+
+#include "arrow/api.h"
+#include "arrow/array/array_base.h"
+#include "arrow/array/array_nested.h"
+#include "arrow/ipc/json_simple.h"
+#include "gtest/gtest.h"
+#include "paimon/common/reader/reader_utils.h"
+#include "paimon/executor.h"
+#include "paimon/memory/memory_pool.h"
+#include "paimon/status.h"
+#include "paimon/testing/mock/mock_file_batch_reader.h"
+#include "paimon/testing/utils/read_result_collector.h"
+#include "paimon/testing/utils/testharness.h"
+#include "paimon/utils/roaring_bitmap32.h"
+
+namespace paimon::test {
+class LookaheadConcatBatchReaderTest : public ::testing::Test {
+ public:
+    void SetUp() override {
+        pool_ = GetDefaultPool();
+    }
+
+    /// An empty batch string stands for a reader skipped by index.
+    std::vector<LookaheadConcatBatchReader::DeferredReader> CreateDeferredReaders(
+        const std::vector<std::pair<std::string, std::vector<int32_t>>>& batches,
+        int32_t batch_size, std::atomic<int32_t>* open_count = nullptr) const {
+        std::vector<LookaheadConcatBatchReader::DeferredReader> deferred_readers;
+        for (const auto& [batch_str, bitmap_data] : batches) {
+            if (batch_str.empty()) {
+                deferred_readers.push_back(
+                    {[]() { return std::unique_ptr<BatchReader>(); }, /*memory_size=*/10});
+                continue;
+            }
+            auto f1 =
+                arrow::ipc::internal::json::ArrayFromJSON(arrow::int32(), batch_str).ValueOrDie();
+            std::shared_ptr<arrow::Array> data =
+                arrow::StructArray::Make({f1}, {arrow::field("f1", arrow::int32())}).ValueOrDie();
+            auto bitmap = RoaringBitmap32::From(bitmap_data);
+            auto supplier = [data, bitmap, batch_size,
+                             open_count]() -> Result<std::unique_ptr<BatchReader>> {
+                if (open_count) {
+                    (*open_count)++;
+                }
+                return std::make_unique<MockFileBatchReader>(data, data->type(), bitmap,
+                                                             batch_size);
+            };
+            deferred_readers.push_back({supplier, /*memory_size=*/10});
+        }
+        return deferred_readers;
+    }
+
+    void CheckResult(const std::vector<std::pair<std::string, std::vector<int32_t>>>& batches,
+                     const std::string& expected) const {
+        for (uint32_t thread_count : {1, 4}) {
+            std::shared_ptr<Executor> executor = CreateDefaultExecutor(thread_count);
+            for (int32_t lookahead : {1, 2, 8}) {
+                for (int64_t memory_budget : {0, 1024}) {
+                    for (int32_t batch_size : {1, 2, 8}) {
+                        auto reader = std::make_unique<LookaheadConcatBatchReader>(
+                            CreateDeferredReaders(batches, batch_size), lookahead, memory_budget,
+                            executor, pool_);
+                        ASSERT_OK_AND_ASSIGN(auto result_chunk_array,
+                                             ReadResultCollector::CollectResult(reader.get()));
+                        if (expected.empty()) {
+                            ASSERT_FALSE(result_chunk_array);
+                            continue;
+                        }
+                        auto expected_f1 =
+                            arrow::ipc::internal::json::ArrayFromJSON(arrow::int32(), expected)
+                                .ValueOrDie();
+                        std::shared_ptr<arrow::Array> expected_array =
+                            arrow::StructArray::Make({expected_f1},
+                                                     {arrow::field("f1", arrow::int32())})
+                                .ValueOrDie();
+                        auto expected_chunk_array =
+                            std::make_shared<arrow::ChunkedArray>(expected_array);
+                        ASSERT_TRUE(expected_chunk_array->Equals(result_chunk_array))
+                            << result_chunk_array->ToString();
+                    }
+                }
+            }
+        }
+    }
+
+ protected:
+    std::shared_ptr<MemoryPool> pool_;
+};
+
+TEST_F(LookaheadConcatBatchReaderTest, TestSimple) {
+    CheckResult({{"[10, 11, 12, 13, 14]", {0, 1, 2, 3, 4}}}, "[10, 11, 12, 13, 14]");
+    CheckResult({{"[10, 11, 12, 13, 14]", {0, 1, 2, 3, 4}},
+                 {"[16, 17, 20]", {0, 1, 2}},
+                 {"[24]", {0}},
+                 {"[100]", {0}}},
+                "[10, 11, 12, 13, 14, 16, 17, 20, 24, 100]");
+    CheckResult({{"[]", {}}, {"[10, 11]", {0, 1}}, {"[]", {}}, {"[16, 17, 20]", {0, 1, 2}}},
+                "[10, 11, 16, 17, 20]");
+    // no data in reader
+    CheckResult({{"[]", {}}, {"[]", {}}}, "");
+    // no reader
+    CheckResult({}, "");
+}
+
+TEST_F(LookaheadConcatBatchReaderTest, TestWithBitmap) {
+    CheckResult({{"[10, 11, 12, 13, 14]", {1, 2, 3}},
+                 {"[16, 17, 20]", {0, 2}},
+                 {"[24]", {}},
+                 {"[100]", {0}}},
+                "[11, 12, 13, 16, 20, 100]");
+}
+
+TEST_F(LookaheadConcatBatchReaderTest, TestSkippedReader) {
+    CheckResult({{"", {}}, {"[10, 11]", {0, 1}}, {"", {}}, {"", {}}, {"[16, 17, 20]", {0, 1, 2}}},
+                "[10, 11, 16, 17, 20]");
+    CheckResult({{"", {}}, {"", {}}}, "");
+}
+
+TEST_F(LookaheadConcatBatchReaderTest, TestOpenFailure) {
+    std::shared_ptr<Executor> executor = CreateDefaultExecutor(2);
+    auto deferred_readers = CreateDeferredReaders({{"[10, 11, 12]", {0, 1, 2}}}, /*batch_size=*/1);
+    deferred_readers.push_back(
+        {[]() -> Result<std::unique_ptr<BatchReader>> {
+             return Status::IOError("mock open failure");
+         },
+         /*memory_size=*/10});
+    LookaheadConcatBatchReader reader(std::move(deferred_readers), /*lookahead=*/2,
+                                      /*memory_budget=*/1024, executor, pool_);
+    // the batches before the failed reader are returned first
+    for (int32_t i = 0; i < 3; i++) {
+        ASSERT_OK_AND_ASSIGN(auto batch, reader.NextBatch());
+        ASSERT_FALSE(BatchReader::IsEofBatch(batch));
+        ReaderUtils::ReleaseReadBatch(std::move(batch));
+    }
+    ASSERT_NOK_WITH_MSG(reader.NextBatch(), "mock open failure");
+    ASSERT_NOK_WITH_MSG(reader.NextBatch(), "mock open failure");
+}
+
+TEST_F(LookaheadConcatBatchReaderTest, TestMemoryBudget) {
+    std::shared_ptr<Executor> executor = CreateDefaultExecutor(4);
+    std::atomic<int32_t> open_count = 0;
+    auto deferred_readers = CreateDeferredReaders({{"[10, 11]", {0, 1}},
+                                                   {"[12, 13]", {0, 1}},
+                                                   {"[14, 15]", {0, 1}},
+                                                   {"[16, 17]", {0, 1}},
+                                                   {"[18, 19]", {0, 1}}},
+                                                  /*batch_size=*/1, &open_count);
+    // each reader costs 10 bytes, so only one reader is opened ahead despite the lookahead
+    LookaheadConcatBatchReader reader(std::move(deferred_readers), /*lookahead=*/4,
+                                      /*memory_budget=*/15, executor, pool_);
+    ASSERT_OK_AND_ASSIGN(auto batch, reader.NextBatch());
+    ASSERT_FALSE(BatchReader::IsEofBatch(batch));
+    ReaderUtils::ReleaseReadBatch(std::move(batch));
+    ASSERT_LE(open_count.load(), 2);
+    reader.Close();
+}
+
+TEST_F(LookaheadConcatBatchReaderTest, TestCloseBeforeFinish) {
+    std::shared_ptr<Executor> executor = CreateDefaultExecutor(4);
+    auto deferred_readers = CreateDeferredReaders({{"[10, 11, 12, 13]", {0, 1, 2, 3}},
+                                                   {"[16, 17, 20]", {0, 1, 2}},
+                                                   {"[24, 25]", {0, 1}}},
+                                                  /*batch_size=*/1);
+    LookaheadConcatBatchReader reader(std::move(deferred_readers), /*lookahead=*/2,
+                                      /*memory_budget=*/1024, executor, pool_);
+    ASSERT_OK_AND_ASSIGN(auto batch, reader.NextBatch());
+    ASSERT_FALSE(BatchReader::IsEofBatch(batch));
+    ReaderUtils::ReleaseReadBatch(std::move(batch));
+    reader.Close();
+    // close again is no-op
+    reader.Close();
+}
+
+}  // namespace paimon::test
@@ -0,0 +1,209 @@
+/*
+ * Copyright 2024-present Alibaba Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "paimon/common/reader/parallel_concat_batch_reader.h"
+
+#include <algorithm>
+#include <utility>
+
+#include "paimon/common/metrics/metrics_impl.h"
+#include "paimon/common/reader/reader_utils.h"
+#include "paimon/common/utils/arrow/mem_utils.h"
+#include "paimon/executor.h"
+
+namespace paimon {
+
+ParallelConcatBatchReader::ParallelConcatBatchReader(
+    std::vector<std::unique_ptr<BatchReader>>&& readers, int32_t parallelism,
+    int32_t max_buffered_batches, const std::shared_ptr<Executor>& executor,
+    const std::shared_ptr<MemoryPool>& pool)
+    : arrow_pool_(GetArrowPool(pool)),
+      executor_(executor),
+      state_(std::make_shared<SharedState>()),
+      parallelism_(std::max(parallelism, 1)) {
+    state_->max_buffered_batches = std::max(max_buffered_batches, 1);
+    state_->sections.resize(readers.size());
+    for (size_t i = 0; i < readers.size(); i++) {
+        state_->sections[i].reader = std::move(readers[i]);
+    }
+}
+
+ParallelConcatBatchReader::~ParallelConcatBatchReader() {
+    Close();
+}
+
+bool ParallelConcatBatchReader::ReadOneBatch(const std::shared_ptr<SharedState>& state,
+                                             size_t index, bool continue_reading) {
+    // sections are never resized, the reference is stable
+    Section& section = state->sections[index];
+    Result<ReadBatchWithBitmap> result = section.reader->NextBatchWithBitmap();
+    std::lock_guard<std::mutex> lock(state->mutex);
+    bool can_continue = false;
+    if (!result.ok()) {
+        section.status = result.status();
+        section.finished = true;
+    } else if (BatchReader::IsEofBatch(result.value())) {
+        section.finished = true;
+    } else {
+        section.batches.push_back(std::move(result).value());
+        can_continue =
+            !state->closed &&
+            static_cast<int32_t>(section.batches.size()) < state->max_buffered_batches;
+    }
+    if (!can_continue || !continue_reading) {
+        section.state = ReadState::IDLE;
+    }
+    state->condition.notify_all();
+    return can_continue && continue_reading;
+}
+
+void ParallelConcatBatchReader::ReadSection(const std::shared_ptr<SharedState>& state,
+                                            size_t index) {
+    {
+        std::lock_guard<std::mutex> lock(state->mutex);
+        Section& section = state->sections[index];
+        if (section.state != ReadState::QUEUED) {
+            // already read by the consuming thread
+            return;
+        }
+        if (state->closed) {
+            section.state = ReadState::IDLE;
+            return;
+        }
+        section.state = ReadState::READING;
+    }
+    while (ReadOneBatch(state, index, /*continue_reading=*/true)) {
+    }
+}
+
+void ParallelConcatBatchReader::ScheduleLocked(size_t index, std::vector<size_t>* to_schedule) {
+    Section& section = state_->sections[index];
+    if (section.state == ReadState::IDLE && !section.finished) {
+        section.state = ReadState::QUEUED;
+        to_schedule->push_back(index);
+    }
+}
+
+void ParallelConcatBatchReader::Submit(const std::vector<size_t>& to_schedule) {
+    for (size_t index : to_schedule) {
+        executor_->Add([state = state_, index]() { ReadSection(state, index); });
+    }
+}
+
+Result<BatchReader::ReadBatch> ParallelConcatBatchReader::NextBatch() {
+    PAIMON_ASSIGN_OR_RAISE(BatchReader::ReadBatchWithBitmap batch_with_bitmap,
+                           NextBatchWithBitmap());
+    return ReaderUtils::ApplyBitmapToReadBatch(std::move(batch_with_bitmap), arrow_pool_.get());
+}
+
+Result<BatchReader::ReadBatchWithBitmap> ParallelConcatBatchReader::NextBatchWithBitmap() {
+    std::vector<Section>& sections = state_->sections;
+    std::vector<size_t> to_schedule;
+    if (!started_) {
+        started_ = true;
+        {
+            std::lock_guard<std::mutex> lock(state_->mutex);
+            size_t end = std::min(sections.size(), static_cast<size_t>(parallelism_));
+            for (size_t i = 0; i < end; i++) {
+                ScheduleLocked(i, &to_schedule);
+            }
+        }
+        Submit(to_schedule);
+        to_schedule.clear();
+    }
+    std::unique_lock<std::mutex> lock(state_->mutex);
+    while (current_ < sections.size()) {
+        Section& section = sections[current_];
+        if (!section.batches.empty()) {
+            ReadBatchWithBitmap batch = std::move(section.batches.front());
+            section.batches.pop_front();
+            // resume the section paused by a full buffer
+            ScheduleLocked(current_, &to_schedule);
+            lock.unlock();
+            Submit(to_schedule);
+            return batch;
+        }
+        if (section.finished) {
+            PAIMON_RETURN_NOT_OK(section.status);
+            size_t finished = current_++;
+            size_t next = finished + parallelism_;
+            if (next < sections.size()) {
+                ScheduleLocked(next, &to_schedule);
+            }
+            lock.unlock();
+            sections[finished].reader->Close();
+            Submit(to_schedule);
+            to_schedule.clear();
+            lock.lock();
+            continue;
+        }
+        if (section.state != ReadState::READING) {
+            // the read task is not started yet, e.g., all threads of executor are busy, read in
+            // place instead of waiting
+            section.state = ReadState::READING;
+            lock.unlock();
+            ReadOneBatch(state_, current_, /*continue_reading=*/false);
+            lock.lock();
+            continue;
+        }
+        state_->condition.wait(lock);
+    }
+    // read finish
+    return BatchReader::MakeEofBatchWithBitmap();
+}
+
+void ParallelConcatBatchReader::Close() {
+    std::vector<Section>& sections = state_->sections;
+    {
+        std::unique_lock<std::mutex> lock(state_->mutex);
+        if (state_->closed) {
+            return;
+        }
+        state_->closed = true;
+        // wait for running tasks, tasks not started yet will skip reading
+        state_->condition.wait(lock, [&sections]() {
+            return std::none_of(sections.begin(), sections.end(), [](const Section& section) {
+                return section.state == ReadState::READING;
+            });
+        });
+    }
+    for (; current_ < sections.size(); current_++) {
+        Section& section = sections[current_];
+        section.reader->Close();
+        for (auto& batch : section.batches) {
+            ReaderUtils::ReleaseReadBatch(std::move(batch.first));
+        }
+        section.batches.clear();
+    }
+}
+
+std::shared_ptr<Metrics> ParallelConcatBatchReader::GetReaderMetrics() const {
+    auto metrics = std::make_shared<MetricsImpl>();
+    std::lock_guard<std::mutex> lock(state_->mutex);
+    for (const auto& section : state_->sections) {
+        // skip sections being read by other threads, they are collected next time
+        if (section.state == ReadState::READING) {
+            continue;
+        }
+        auto reader_metrics = section.reader->GetReaderMetrics();
+        if (reader_metrics) {
+            metrics->Merge(reader_metrics);
+        }
+    }
+    return metrics;
+}
+
+}  // namespace paimon
@@ -0,0 +1,107 @@
+/*
+ * Copyright 2024-present Alibaba Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include "arrow/api.h"
+#include "paimon/metrics.h"
+#include "paimon/reader/batch_reader.h"
+#include "paimon/result.h"
+#include "paimon/status.h"
+
+namespace paimon {
+class Executor;
+class MemoryPool;
+
+/// Like `ConcatBatchReader`, returns the batches of a list of readers one reader after another,
+/// but reads up to `parallelism` readers ahead concurrently on an `Executor`. Each reader buffers
+/// at most `max_buffered_batches` batches which are not returned yet, so the memory used for
+/// reordering is bounded. A reader whose buffer is full stops reading until the buffer is drained.
+///
+/// Readers are only called from one thread at a time, but different readers may be called
+/// concurrently, so they must not share mutable state.
+class ParallelConcatBatchReader : public BatchReader {
+ public:
+    static constexpr int32_t DEFAULT_MAX_BUFFERED_BATCHES = 4;
+
+    ParallelConcatBatchReader(std::vector<std::unique_ptr<BatchReader>>&& readers,
+                              int32_t parallelism, int32_t max_buffered_batches,
+                              const std::shared_ptr<Executor>& executor,
+                              const std::shared_ptr<MemoryPool>& pool);
+    ~ParallelConcatBatchReader() override;
+
+    Result<ReadBatch> NextBatch() override;
+    Result<ReadBatchWithBitmap> NextBatchWithBitmap() override;
+    void Close() override;
+    std::shared_ptr<Metrics> GetReaderMetrics() const override;
+
+ private:
+    enum class ReadState {
+        /// No task reads the reader, e.g., not started yet or buffer is full.
+        IDLE,
+        /// A read task is added to the executor but not started.
+        QUEUED,
+        /// The reader is being read, by a task or by the consuming thread.
+        READING,
+    };
+
+    struct Section {
+        std::unique_ptr<BatchReader> reader;
+        std::deque<ReadBatchWithBitmap> batches;
+        ReadState state = ReadState::IDLE;
+        bool finished = false;
+        Status status;
+    };
+
+    /// Shared with read tasks, so that tasks never access a destroyed reader.
+    struct SharedState {
+        std::mutex mutex;
+        std::condition_variable condition;
+        std::vector<Section> sections;
+        int32_t max_buffered_batches;
+        bool closed = false;
+    };
+
+    /// Reads one batch of section `index` into its buffer, the caller marks the section as
+    /// READING before. Returns whether the section stays READING and should be read further.
+    static bool ReadOneBatch(const std::shared_ptr<SharedState>& state, size_t index,
+                             bool continue_reading);
+
+    /// Reads section `index` until its buffer is full, it is finished or the reader is closed.
+    static void ReadSection(const std::shared_ptr<SharedState>& state, size_t index);
+
+    /// Marks section `index` as QUEUED and records it to be added to the executor after the lock
+    /// is released.
+    void ScheduleLocked(size_t index, std::vector<size_t>* to_schedule);
+    void Submit(const std::vector<size_t>& to_schedule);
+
+ private:
+    std::unique_ptr<arrow::MemoryPool> arrow_pool_;
+    std::shared_ptr<Executor> executor_;
+    std::shared_ptr<SharedState> state_;
+    int32_t parallelism_;
+    size_t current_ = 0;
+    bool started_ = false;
+};
+}  // namespace paimon
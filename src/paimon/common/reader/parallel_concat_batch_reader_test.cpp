@@ -0,0 +1,156 @@
+/*
+ * Copyright 2024-present Alibaba Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "paimon/common/reader/parallel_concat_batch_reader.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <string>
+#include <utility>
+
+#include "arrow/api.h"
+#include "arrow/array/array_base.h"
+#include "arrow/array/array_nested.h"
+#include "arrow/ipc/json_simple.h"
+#include "gtest/gtest.h"
+#include "paimon/executor.h"
+#include "paimon/memory/memory_pool.h"
+#include "paimon/status.h"
+#include "paimon/testing/mock/mock_file_batch_reader.h"
+#include "paimon/testing/utils/read_result_collector.h"
+#include "paimon/testing/utils/testharness.h"
+#include "paimon/utils/roaring_bitmap32.h"
+
+namespace paimon::test {
+class ParallelConcatBatchReaderTest : public ::testing::Test {
+ public:
+    void SetUp() override {
+        pool_ = GetDefaultPool();
+    }
+
+    std::vector<std::unique_ptr<BatchReader>> CreateReaders(
+        const std::vector<std::pair<std::string, std::vector<int32_t>>>& batches,
+        int32_t batch_size) const {
+        std::vector<std::unique_ptr<BatchReader>> readers;
+        for (const auto& [batch_str, bitmap_data] : batches) {
+            auto f1 =
+                arrow::ipc::internal::json::ArrayFromJSON(arrow::int32(), batch_str).ValueOrDie();
+            std::shared_ptr<arrow::Array> data =
+                arrow::StructArray::Make({f1}, {arrow::field("f1", arrow::int32())}).ValueOrDie();
+            readers.push_back(std::make_unique<MockFileBatchReader>(
+                data, data->type(), RoaringBitmap32::From(bitmap_data), batch_size));
+        }
+        return readers;
+    }
+
+    void CheckResult(const std::vector<std::pair<std::string, std::vector<int32_t>>>& batches,
+                     const std::string& expected) const {
+        for (uint32_t thread_count : {1, 4}) {
+            std::shared_ptr<Executor> executor = CreateDefaultExecutor(thread_count);
+            for (int32_t parallelism : {1, 2, 8}) {
+                for (int32_t max_buffered_batches : {1, 4}) {
+                    for (int32_t batch_size : {1, 2, 8}) {
+                        auto reader = std::make_unique<ParallelConcatBatchReader>(
+                            CreateReaders(batches, batch_size), parallelism, max_buffered_batches,
+                            executor, pool_);
+                        ASSERT_OK_AND_ASSIGN(auto result_chunk_array,
+                                             ReadResultCollector::CollectResult(reader.get()));
+                        if (expected.empty()) {
+                            ASSERT_FALSE(result_chunk_array);
+                            continue;
+                        }
+                        auto expected_f1 =
+                            arrow::ipc::internal::json::ArrayFromJSON(arrow::int32(), expected)
+                                .ValueOrDie();
+                        std::shared_ptr<arrow::Array> expected_array =
+                            arrow::StructArray::Make({expected_f1},
+                                                     {arrow::field("f1", arrow::int32())})
+                                .ValueOrDie();
+                        auto expected_chunk_array =
+                            std::make_shared<arrow::ChunkedArray>(expected_array);
+                        ASSERT_TRUE(expected_chunk_array->Equals(result_chunk_array))
+                            << result_chunk_array->ToString();
+                    }
+                }
+            }
+        }
+    }
+
+ protected:
+    std::shared_ptr<MemoryPool> pool_;
+};
+
+namespace {
+class FailedBatchReader : public BatchReader {
+ public:
+    Result<ReadBatch> NextBatch() override {
+        return Status::IOError("mock read failure");
+    }
+    std::shared_ptr<Metrics> GetReaderMetrics() const override {
+        return nullptr;
+    }
+    void Close() override {}
+};
+}  // namespace
+
+TEST_F(ParallelConcatBatchReaderTest, TestSimple) {
+    CheckResult({{"[10, 11, 12, 13, 14]", {0, 1, 2, 3, 4}}}, "[10, 11, 12, 13, 14]");
+    CheckResult({{"[10, 11, 12, 13, 14]", {0, 1, 2, 3, 4}},
+                 {"[16, 17, 20]", {0, 1, 2}},
+                 {"[24]", {0}},
+                 {"[100]", {0}}},
+                "[10, 11, 12, 13, 14, 16, 17, 20, 24, 100]");
+    CheckResult({{"[]", {}}, {"[10, 11]", {0, 1}}, {"[]", {}}, {"[16, 17, 20]", {0, 1, 2}}},
+                "[10, 11, 16, 17, 20]");
+    // no data in reader
+    CheckResult({{"[]", {}}, {"[]", {}}}, "");
+    // no reader
+    CheckResult({}, "");
+}
+
+TEST_F(ParallelConcatBatchReaderTest, TestWithBitmap) {
+    CheckResult({{"[10, 11, 12, 13, 14]", {1, 2, 3}},
+                 {"[16, 17, 20]", {0, 2}},
+                 {"[24]", {}},
+                 {"[100]", {0}}},
+                "[11, 12, 13, 16, 20, 100]");
+}
+
+TEST_F(ParallelConcatBatchReaderTest, TestReadFailure) {
+    std::shared_ptr<Executor> executor = CreateDefaultExecutor(2);
+    auto readers = CreateReaders({{"[10, 11, 12]", {0, 1, 2}}}, /*batch_size=*/1);
+    readers.push_back(std::make_unique<FailedBatchReader>());
+    ParallelConcatBatchReader reader(std::move(readers), /*parallelism=*/2,
+                                     /*max_buffered_batches=*/1, executor, pool_);
+    ASSERT_NOK_WITH_MSG(ReadResultCollector::CollectResult(&reader), "mock read failure");
+}
+
+TEST_F(ParallelConcatBatchReaderTest, TestCloseBeforeFinish) {
+    std::shared_ptr<Executor> executor = CreateDefaultExecutor(4);
+    auto readers = CreateReaders({{"[10, 11, 12, 13]", {0, 1, 2, 3}},
+                                  {"[16, 17, 20]", {0, 1, 2}},
+                                  {"[24, 25]", {0, 1}}},
+                                 /*batch_size=*/1);
+    ParallelConcatBatchReader reader(std::move(readers), /*parallelism=*/3,
+                                     /*max_buffered_batches=*/2, executor, pool_);
+    ASSERT_OK_AND_ASSIGN(auto batch, reader.NextBatch());
+    ASSERT_FALSE(BatchReader::IsEofBatch(batch));
+    reader.Close();
+    // close again is no-op
+    reader.Close();
+}
+
+}  // namespace paimon::test
@@ -89,10 +89,20 @@ Result<RoaringBitmap32> PredicateBatchReader::Filter(
     const std::shared_ptr<arrow::Array>& array) const {
     PAIMON_ASSIGN_OR_RAISE(std::vector<char> result, predicate_filter_->Test(*array));
     assert(result.size() == static_cast<size_t>(array->length()));
+    // add runs of selected rows as ranges instead of one row at a time
     RoaringBitmap32 is_valid;
-    for (int32_t i = 0; i < static_cast<int32_t>(result.size()); i++) {
-        if (result[i]) {
-            is_valid.Add(i);
+    int32_t length = static_cast<int32_t>(result.size());
+    int32_t i = 0;
+    while (i < length) {
+        while (i < length && !result[i]) {
+            i++;
+        }
+        int32_t run_start = i;
+        while (i < length && result[i]) {
+            i++;
+        }
+        if (run_start < i) {
+            is_valid.AddRange(run_start, i);
         }
     }
     return is_valid;
@@ -17,9 +17,10 @@
 #pragma once
 
 #include <memory>
-#include <unordered_map>
+#include <string>
 
 #include "paimon/common/io/cache/cache_manager.h"
+#include "paimon/common/io/zero_copy_input_stream.h"
 #include "paimon/common/memory/memory_segment.h"
 #include "paimon/fs/file_system.h"
 #include "paimon/reader/batch_reader.h"
@@ -27,36 +28,39 @@
 
 namespace paimon {
 
+/// Reads blocks of one sst file through a cache manager, which may be shared by many readers.
 class BlockCache {
  public:
     BlockCache(std::string& file_path, const std::shared_ptr<InputStream>& in,
                const std::shared_ptr<MemoryPool>& pool,
-               std::unique_ptr<CacheManager>&& cache_manager)
-        : file_path_(file_path), in_(in), pool_(pool), cache_manager_(std::move(cache_manager)) {}
+               const std::shared_ptr<CacheManager>& cache_manager)
+        : file_path_(file_path), in_(in), pool_(pool), cache_manager_(cache_manager) {}
 
     ~BlockCache() = default;
 
     std::shared_ptr<MemorySegment> GetBlock(int64_t position, int32_t length, bool is_index) {
         auto key = CacheKey::ForPosition(file_path_, position, length, is_index);
-
-        auto it = blocks_.find(key);
-        if (it == blocks_.end()) {
-            auto segment = cache_manager_->GetPage(
-                key, [&](const std::shared_ptr<paimon::CacheKey>&) -> Result<MemorySegment> {
-                    return ReadFrom(position, length);
-                });
-            if (!segment.get()) {
-                blocks_.insert({key, std::make_shared<CacheValue>(segment)});
-            }
-            return segment;
-        }
-        return it->second->GetSegment();
+        return cache_manager_->GetPage(
+            key, [&](const std::shared_ptr<paimon::CacheKey>&) -> Result<MemorySegment> {
+                return ReadFrom(position, length);
+            });
     }
 
  private:
     Result<MemorySegment> ReadFrom(int64_t offset, int length) {
+        if (auto* zero_copy_in = ZeroCopyInputStream::From(in_.get())) {
+            // sst files are immutable, the block can point into the mapping of the file
+            PAIMON_ASSIGN_OR_RAISE(std::shared_ptr<Bytes> view,
+                                   zero_copy_in->ReadView(length, offset));
+            if (view) {
+                return MemorySegment::Wrap(view);
+            }
+        }
         PAIMON_RETURN_NOT_OK(in_->Seek(offset, SeekOrigin::FS_SEEK_SET));
-        auto segment = MemorySegment::AllocateHeapMemory(length, pool_.get());
+        // cached blocks outlive this reader, charge them to the pool of the cache manager
+        MemoryPool* pool =
+            cache_manager_->GetMemoryPool() ? cache_manager_->GetMemoryPool().get() : pool_.get();
+        auto segment = MemorySegment::AllocateHeapMemory(length, pool);
         PAIMON_RETURN_NOT_OK(in_->Read(segment.GetHeapMemory()->data(), length));
         return segment;
     }
@@ -66,7 +70,6 @@ class BlockCache {
     std::shared_ptr<InputStream> in_;
     std::shared_ptr<MemoryPool> pool_;
 
-    std::unique_ptr<CacheManager> cache_manager_;
-    std::unordered_map<std::shared_ptr<CacheKey>, std::shared_ptr<CacheValue>> blocks_;
+    std::shared_ptr<CacheManager> cache_manager_;
 };
 }  // namespace paimon
@@ -26,10 +26,12 @@
 #include "arrow/array/builder_primitive.h"
 #include "arrow/ipc/json_simple.h"
 #include "gtest/gtest.h"
+#include "paimon/common/io/cache/cache_metrics.h"
 #include "paimon/common/sst/sst_file_reader.h"
 #include "paimon/common/sst/sst_file_writer.h"
 #include "paimon/defs.h"
 #include "paimon/memory/memory_pool.h"
+#include "paimon/metrics.h"
 #include "paimon/predicate/literal.h"
 #include "paimon/predicate/predicate_builder.h"
 #include "paimon/status.h"
@@ -119,7 +121,7 @@ TEST_F(SstFileIOTest, TestSimple) {
 
     ASSERT_OK_AND_ASSIGN(std::shared_ptr<InputStream> in, fs_->Open(index_path_));
     auto block_cache =
-        std::make_shared<BlockCache>(index_path_, in, pool_, std::make_unique<CacheManager>());
+        std::make_shared<BlockCache>(index_path_, in, pool_, std::make_shared<CacheManager>());
 
     // bloom filter test
     auto entries = bloom_filter_handle->ExpectedEntries();
@@ -168,7 +170,7 @@ TEST_F(SstFileIOTest, TestJavaCompatitable) {
     std::string file = GetDataDir() + "/sst/none/79d01717-8380-4504-86e1-387e6c058d0a";
     ASSERT_OK_AND_ASSIGN(std::shared_ptr<InputStream> in, fs_->Open(file));
     auto block_cache =
-        std::make_shared<BlockCache>(index_path_, in, pool_, std::make_unique<CacheManager>());
+        std::make_shared<BlockCache>(index_path_, in, pool_, std::make_shared<CacheManager>());
 
     // test read
     auto reader_ret = SstFileReader::Create(pool_, block_cache, in->Length().value(), comparator_);
@@ -196,4 +198,43 @@ TEST_F(SstFileIOTest, TestJavaCompatitable) {
     ASSERT_EQ("1314521", string1314521);
 }
 
+TEST_F(SstFileIOTest, TestSharedCacheManager) {
+    std::string file = GetDataDir() + "/sst/none/79d01717-8380-4504-86e1-387e6c058d0a";
+    std::shared_ptr<MemoryPool> cache_pool = GetMemoryPool();
+    auto cache_manager = std::make_shared<CacheManager>(/*max_memory_size=*/8 * 1024 * 1024,
+                                                        /*high_priority_pool_ratio=*/0.25,
+                                                        cache_pool);
+    std::string k1314520 = "1314520";
+    for (int32_t i = 0; i < 2; ++i) {
+        // every reader has its own stream, but the blocks are cached by the shared manager
+        ASSERT_OK_AND_ASSIGN(std::shared_ptr<InputStream> in, fs_->Open(file));
+        auto block_cache = std::make_shared<BlockCache>(file, in, pool_, cache_manager);
+        ASSERT_OK_AND_ASSIGN(
+            std::shared_ptr<SstFileReader> reader,
+            SstFileReader::Create(pool_, block_cache, in->Length().value(), comparator_));
+        auto value = reader->Lookup(std::make_shared<Bytes>(k1314520, pool_.get()));
+        ASSERT_TRUE(value);
+        ASSERT_EQ("1314520", std::string(value->data(), value->size()));
+    }
+    auto metrics = cache_manager->GetMetrics();
+    ASSERT_OK_AND_ASSIGN(uint64_t index_misses,
+                         metrics->GetCounter(CacheMetrics::INDEX_CACHE_MISSES));
+    ASSERT_OK_AND_ASSIGN(uint64_t index_hits, metrics->GetCounter(CacheMetrics::INDEX_CACHE_HITS));
+    ASSERT_OK_AND_ASSIGN(uint64_t data_misses,
+                         metrics->GetCounter(CacheMetrics::DATA_CACHE_MISSES));
+    ASSERT_OK_AND_ASSIGN(uint64_t data_hits, metrics->GetCounter(CacheMetrics::DATA_CACHE_HITS));
+    ASSERT_GT(index_misses, 0);
+    // the second reader reads every block from the cache
+    ASSERT_EQ(index_misses, index_hits);
+    ASSERT_EQ(1, data_misses);
+    ASSERT_EQ(1, data_hits);
+    ASSERT_OK_AND_ASSIGN(uint64_t index_bytes,
+                         metrics->GetCounter(CacheMetrics::INDEX_CACHE_USED_BYTES));
+    ASSERT_OK_AND_ASSIGN(uint64_t data_bytes,
+                         metrics->GetCounter(CacheMetrics::DATA_CACHE_USED_BYTES));
+    // cached blocks are charged to the pool of the cache manager
+    ASSERT_GT(index_bytes + data_bytes, 0);
+    ASSERT_GE(cache_pool->CurrentUsage(), index_bytes + data_bytes);
+}
+
 }  // namespace paimon::test
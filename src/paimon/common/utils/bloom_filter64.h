@@ -52,6 +52,8 @@ class PAIMON_EXPORT BloomFilter64 {
         void Set(int32_t index);
         bool Get(int32_t index) const;
         int32_t BitSize() const;
+        /// Copies the bits to `dest`, which must hold `BitSize() / 8` bytes.
+        void CopyTo(char* dest) const;
 
      private:
         static constexpr int8_t MASK = 0x07;
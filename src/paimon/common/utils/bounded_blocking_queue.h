@@ -0,0 +1,103 @@
+/*
+ * Copyright 2024-present Alibaba Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <mutex>
+#include <optional>
+#include <utility>
+
+namespace paimon {
+
+/// A bounded multi-producer multi-consumer queue. `push()` blocks while the queue is full and
+/// `pop()` blocks while it is empty, waiters are woken by condition variables instead of polling.
+/// After `close()`, pushes are rejected and pops drain the remaining elements before returning
+/// std::nullopt.
+template <typename T>
+class BoundedBlockingQueue {
+ public:
+    explicit BoundedBlockingQueue(size_t capacity) : capacity_(capacity > 0 ? capacity : 1) {}
+
+    /// @return false if the queue is closed, the value is not enqueued.
+    bool push(T&& value) {
+        std::unique_lock<std::mutex> lock(mtx_);
+        not_full_.wait(lock, [this] { return closed_ || queue_.size() < capacity_; });
+        if (closed_) {
+            return false;
+        }
+        queue_.push_back(std::move(value));
+        lock.unlock();
+        not_empty_.notify_one();
+        return true;
+    }
+
+    /// @return std::nullopt if the queue is closed and drained.
+    std::optional<T> pop() {
+        std::unique_lock<std::mutex> lock(mtx_);
+        not_empty_.wait(lock, [this] { return closed_ || !queue_.empty(); });
+        return PopLocked(&lock);
+    }
+
+    std::optional<T> try_pop() {
+        std::unique_lock<std::mutex> lock(mtx_);
+        return PopLocked(&lock);
+    }
+
+    /// Wakes up all blocked producers and consumers.
+    void close() {
+        {
+            std::lock_guard<std::mutex> lock(mtx_);
+            closed_ = true;
+        }
+        not_full_.notify_all();
+        not_empty_.notify_all();
+    }
+
+    bool closed() const {
+        std::lock_guard<std::mutex> lock(mtx_);
+        return closed_;
+    }
+
+    size_t size() const {
+        std::lock_guard<std::mutex> lock(mtx_);
+        return queue_.size();
+    }
+
+ private:
+    std::optional<T> PopLocked(std::unique_lock<std::mutex>* lock) {
+        if (queue_.empty()) {
+            return std::nullopt;
+        }
+        std::optional<T> front(std::move(queue_.front()));
+        queue_.pop_front();
+        lock->unlock();
+        not_full_.notify_one();
+        return front;
+    }
+
+ private:
+    const size_t capacity_;
+    bool closed_ = false;
+    std::deque<T> queue_;
+    mutable std::mutex mtx_;
+    std::condition_variable not_full_;
+    std::condition_variable not_empty_;
+};
+
+}  // namespace paimon
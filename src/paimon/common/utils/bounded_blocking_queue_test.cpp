@@ -0,0 +1,95 @@
+/*
+ * Copyright 2024-present Alibaba Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "paimon/common/utils/bounded_blocking_queue.h"
+
+#include <thread>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+namespace paimon::test {
+
+TEST(BoundedBlockingQueueTest, PushPop) {
+    BoundedBlockingQueue<int> q(/*capacity=*/2);
+    ASSERT_TRUE(q.push(1));
+    ASSERT_TRUE(q.push(2));
+    ASSERT_EQ(q.size(), 2);
+    ASSERT_EQ(q.pop(), 1);
+    ASSERT_EQ(q.try_pop(), 2);
+    ASSERT_EQ(q.try_pop(), std::nullopt);
+}
+
+TEST(BoundedBlockingQueueTest, Close) {
+    BoundedBlockingQueue<int> q(/*capacity=*/2);
+    ASSERT_TRUE(q.push(1));
+    q.close();
+    ASSERT_TRUE(q.closed());
+    ASSERT_FALSE(q.push(2));
+    // remaining elements are still drained
+    ASSERT_EQ(q.pop(), 1);
+    ASSERT_EQ(q.pop(), std::nullopt);
+}
+
+TEST(BoundedBlockingQueueTest, CloseWakesUpWaiters) {
+    BoundedBlockingQueue<int> q(/*capacity=*/1);
+    ASSERT_TRUE(q.push(1));
+    std::thread producer([&q]() { ASSERT_FALSE(q.push(2)); });
+    BoundedBlockingQueue<int> empty_q(/*capacity=*/1);
+    std::thread consumer([&empty_q]() { ASSERT_EQ(empty_q.pop(), std::nullopt); });
+    q.close();
+    empty_q.close();
+    producer.join();
+    consumer.join();
+}
+
+TEST(BoundedBlockingQueueTest, MultiProducerMultiConsumer) {
+    constexpr int32_t kProducers = 4;
+    constexpr int32_t kValuesPerProducer = 10000;
+    BoundedBlockingQueue<int64_t> q(/*capacity=*/16);
+    std::vector<std::thread> producers;
+    for (int32_t p = 0; p < kProducers; ++p) {
+        producers.emplace_back([&q]() {
+            for (int32_t i = 1; i <= kValuesPerProducer; ++i) {
+                ASSERT_TRUE(q.push(i));
+            }
+        });
+    }
+    std::vector<int64_t> sums(kProducers, 0);
+    std::vector<std::thread> consumers;
+    for (int32_t c = 0; c < kProducers; ++c) {
+        consumers.emplace_back([&q, &sums, c]() {
+            while (auto value = q.pop()) {
+                sums[c] += value.value();
+            }
+        });
+    }
+    for (auto& producer : producers) {
+        producer.join();
+    }
+    q.close();
+    for (auto& consumer : consumers) {
+        consumer.join();
+    }
+    int64_t total = 0;
+    for (int64_t sum : sums) {
+        total += sum;
+    }
+    ASSERT_EQ(total, static_cast<int64_t>(kProducers) * kValuesPerProducer *
+                         (kValuesPerProducer + 1) / 2);
+}
+
+}  // namespace paimon::test
@@ -0,0 +1,131 @@
+/*
+ * Copyright 2024-present Alibaba Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "paimon/core/append/append_compact_rewriter.h"
+
+#include <functional>
+#include <optional>
+#include <string>
+#include <utility>
+
+#include "arrow/c/abi.h"
+#include "arrow/c/bridge.h"
+#include "arrow/c/helpers.h"
+#include "paimon/common/utils/arrow/status_utils.h"
+#include "paimon/common/utils/long_counter.h"
+#include "paimon/common/utils/scope_guard.h"
+#include "paimon/core/io/data_file_index_writer.h"
+#include "paimon/core/io/data_file_path_factory.h"
+#include "paimon/core/io/data_file_writer.h"
+#include "paimon/core/io/single_file_writer.h"
+#include "paimon/core/manifest/file_source.h"
+#include "paimon/core/operation/raw_file_split_read.h"
+#include "paimon/core/stats/batch_stats_collector.h"
+#include "paimon/format/file_format.h"
+#include "paimon/format/writer_builder.h"
+#include "paimon/reader/batch_reader.h"
+
+namespace paimon {
+class FormatStatsExtractor;
+
+AppendCompactRewriter::AppendCompactRewriter(
+    const BinaryRow& partition, int64_t schema_id,
+    const std::shared_ptr<arrow::Schema>& write_schema,
+    const std::shared_ptr<DataFilePathFactory>& data_file_path_factory,
+    std::unique_ptr<RawFileSplitRead>&& raw_read, const CoreOptions& options,
+    const std::shared_ptr<MemoryPool>& pool)
+    : partition_(partition),
+      schema_id_(schema_id),
+      write_schema_(write_schema),
+      data_file_path_factory_(data_file_path_factory),
+      raw_read_(std::move(raw_read)),
+      options_(options),
+      pool_(pool) {}
+
+AppendCompactRewriter::~AppendCompactRewriter() = default;
+
+Result<std::vector<std::shared_ptr<DataFileMeta>>> AppendCompactRewriter::Rewrite(
+    const std::vector<std::shared_ptr<DataFileMeta>>& files) const {
+    if (files.empty()) {
+        return std::vector<std::shared_ptr<DataFileMeta>>();
+    }
+    // rewritten files take over the sequence numbers of the input files
+    auto seq_num_counter = std::make_shared<LongCounter>(files[0]->min_sequence_number);
+    auto rolling_writer = CreateRollingWriter(seq_num_counter);
+    ScopeGuard guard([&rolling_writer]() { rolling_writer->Abort(); });
+    PAIMON_ASSIGN_OR_RAISE(
+        std::unique_ptr<BatchReader> reader,
+        raw_read_->CreateCompactReader(partition_, files, data_file_path_factory_));
+    ScopeGuard reader_guard([&reader]() { reader->Close(); });
+    while (true) {
+        PAIMON_ASSIGN_OR_RAISE(BatchReader::ReadBatch batch, reader->NextBatch());
+        if (BatchReader::IsEofBatch(batch)) {
+            break;
+        }
+        auto& [array, schema] = batch;
+        if (schema) {
+            ArrowSchemaRelease(schema.get());
+        }
+        PAIMON_RETURN_NOT_OK(rolling_writer->Write(array.get()));
+    }
+    PAIMON_RETURN_NOT_OK(rolling_writer->Close());
+    PAIMON_ASSIGN_OR_RAISE(std::vector<std::shared_ptr<DataFileMeta>> after,
+                           rolling_writer->GetResult());
+    guard.Release();
+    return after;
+}
+
+std::unique_ptr<RollingFileWriter<::ArrowArray*, std::shared_ptr<DataFileMeta>>>
+AppendCompactRewriter::CreateRollingWriter(
+    const std::shared_ptr<LongCounter>& seq_num_counter) const {
+    auto create_file_writer = [this, seq_num_counter]()
+        -> Result<std::unique_ptr<SingleFileWriter<::ArrowArray*, std::shared_ptr<DataFileMeta>>>> {
+        ::ArrowSchema arrow_schema;
+        ScopeGuard guard([&arrow_schema]() { ArrowSchemaRelease(&arrow_schema); });
+        PAIMON_RETURN_NOT_OK_FROM_ARROW(arrow::ExportSchema(*write_schema_, &arrow_schema));
+        auto format = options_.GetWriteFileFormat();
+        PAIMON_ASSIGN_OR_RAISE(
+            std::shared_ptr<WriterBuilder> writer_builder,
+            format->CreateWriterBuilder(&arrow_schema, options_.GetWriteBatchSize()));
+        writer_builder->WithMemoryPool(pool_);
+        PAIMON_RETURN_NOT_OK_FROM_ARROW(arrow::ExportSchema(*write_schema_, &arrow_schema));
+        PAIMON_ASSIGN_OR_RAISE(std::shared_ptr<FormatStatsExtractor> stats_extractor,
+                               format->CreateStatsExtractor(&arrow_schema));
+        auto writer = std::make_unique<DataFileWriter>(
+            options_.GetFileCompression(), std::function<Status(ArrowArray*, ArrowArray*)>(),
+            schema_id_, seq_num_counter, FileSource::Compact(), stats_extractor,
+            data_file_path_factory_->IsExternalPath(), /*write_cols=*/std::nullopt, pool_);
+        if (options_.WriteStatsInFlightEnabled()) {
+            PAIMON_ASSIGN_OR_RAISE(std::unique_ptr<BatchStatsCollector> stats_collector,
+                                   BatchStatsCollector::Create(write_schema_));
+            writer->WithStatsCollector(std::move(stats_collector));
+        }
+        PAIMON_ASSIGN_OR_RAISE(
+            std::unique_ptr<DataFileIndexWriter> file_index_writer,
+            DataFileIndexWriter::Create(write_schema_, options_.ToMap(),
+                                        options_.GetFileIndexInManifestThreshold(), pool_));
+        if (file_index_writer) {
+            writer->WithFileIndexWriter(std::move(file_index_writer));
+        }
+        PAIMON_RETURN_NOT_OK(writer->Init(options_.GetFileSystem(),
+                                          data_file_path_factory_->NewPath(), writer_builder));
+        return writer;
+    };
+    return std::make_unique<RollingFileWriter<::ArrowArray*, std::shared_ptr<DataFileMeta>>>(
+        options_.GetTargetFileSize(), create_file_writer);
+}
+
+}  // namespace paimon
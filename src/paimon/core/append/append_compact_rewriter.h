@@ -0,0 +1,71 @@
+/*
+ * Copyright 2024-present Alibaba Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "paimon/common/data/binary_row.h"
+#include "paimon/core/core_options.h"
+#include "paimon/core/io/data_file_meta.h"
+#include "paimon/core/io/rolling_file_writer.h"
+#include "paimon/result.h"
+
+struct ArrowArray;
+
+namespace arrow {
+class Schema;
+}  // namespace arrow
+
+namespace paimon {
+class DataFilePathFactory;
+class LongCounter;
+class MemoryPool;
+class RawFileSplitRead;
+
+/// Rewrites sequence-contiguous files of an append table bucket into files of the target file
+/// size. Records are copied in sequence order and keep their sequence numbers.
+class AppendCompactRewriter {
+ public:
+    /// @param write_schema Schema of all table fields, same as the read schema of `raw_read`.
+    AppendCompactRewriter(const BinaryRow& partition, int64_t schema_id,
+                          const std::shared_ptr<arrow::Schema>& write_schema,
+                          const std::shared_ptr<DataFilePathFactory>& data_file_path_factory,
+                          std::unique_ptr<RawFileSplitRead>&& raw_read, const CoreOptions& options,
+                          const std::shared_ptr<MemoryPool>& pool);
+
+    ~AppendCompactRewriter();
+
+    /// @pre `files` are ordered by sequence number.
+    Result<std::vector<std::shared_ptr<DataFileMeta>>> Rewrite(
+        const std::vector<std::shared_ptr<DataFileMeta>>& files) const;
+
+ private:
+    std::unique_ptr<RollingFileWriter<::ArrowArray*, std::shared_ptr<DataFileMeta>>>
+    CreateRollingWriter(const std::shared_ptr<LongCounter>& seq_num_counter) const;
+
+ private:
+    BinaryRow partition_;
+    int64_t schema_id_;
+    std::shared_ptr<arrow::Schema> write_schema_;
+    std::shared_ptr<DataFilePathFactory> data_file_path_factory_;
+    std::unique_ptr<RawFileSplitRead> raw_read_;
+    CoreOptions options_;
+    std::shared_ptr<MemoryPool> pool_;
+};
+}  // namespace paimon
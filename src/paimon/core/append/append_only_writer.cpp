@@ -16,7 +16,9 @@
 
 #include "paimon/core/append/append_only_writer.h"
 
+#include <algorithm>
 #include <functional>
+#include <set>
 #include <string>
 #include <utility>
 
@@ -30,6 +32,7 @@
 #include "paimon/common/utils/long_counter.h"
 #include "paimon/common/utils/scope_guard.h"
 #include "paimon/core/io/compact_increment.h"
+#include "paimon/core/io/data_file_index_writer.h"
 #include "paimon/core/io/data_file_path_factory.h"
 #include "paimon/core/io/data_file_writer.h"
 #include "paimon/core/io/data_increment.h"
@@ -37,6 +40,7 @@
 #include "paimon/core/io/rolling_file_writer.h"
 #include "paimon/core/io/single_file_writer.h"
 #include "paimon/core/manifest/file_source.h"
+#include "paimon/core/stats/batch_stats_collector.h"
 #include "paimon/core/utils/commit_increment.h"
 #include "paimon/format/file_format.h"
 #include "paimon/format/file_format_factory.h"
@@ -55,7 +59,8 @@ AppendOnlyWriter::AppendOnlyWriter(const CoreOptions& options, int64_t schema_id
                                    const std::optional<std::vector<std::string>>& write_cols,
                                    int64_t max_sequence_number,
                                    const std::shared_ptr<DataFilePathFactory>& path_factory,
-                                   const std::shared_ptr<MemoryPool>& memory_pool)
+                                   const std::shared_ptr<MemoryPool>& memory_pool,
+                                   const std::shared_ptr<CompactManager>& compact_manager)
     : options_(options),
       schema_id_(schema_id),
       write_schema_(write_schema),
@@ -63,7 +68,8 @@ AppendOnlyWriter::AppendOnlyWriter(const CoreOptions& options, int64_t schema_id
       seq_num_counter_(std::make_shared<LongCounter>(max_sequence_number + 1)),
       path_factory_(path_factory),
       memory_pool_(memory_pool),
-      metrics_(std::make_shared<MetricsImpl>()) {}
+      metrics_(std::make_shared<MetricsImpl>()),
+      compact_manager_(compact_manager) {}
 
 AppendOnlyWriter::~AppendOnlyWriter() = default;
 
@@ -84,17 +90,58 @@ Status AppendOnlyWriter::Write(std::unique_ptr<RecordBatch>&& batch) {
 
 Result<CommitIncrement> AppendOnlyWriter::PrepareCommit(bool wait_compaction) {
     PAIMON_RETURN_NOT_OK(Flush());
+    if (compact_manager_) {
+        PAIMON_RETURN_NOT_OK(TrySyncLatestCompaction(wait_compaction));
+    }
     return DrainIncrement();
 }
 
 Result<CommitIncrement> AppendOnlyWriter::DrainIncrement() {
     DataIncrement data_increment(std::move(new_files_), std::move(deleted_files_), {});
-    CompactIncrement compact_increment({}, {}, {});
+    CompactIncrement compact_increment(std::move(compact_before_), std::move(compact_after_), {});
     new_files_.clear();
     deleted_files_.clear();
+    compact_before_.clear();
+    compact_after_.clear();
     return CommitIncrement(data_increment, compact_increment);
 }
 
+Status AppendOnlyWriter::TrySyncLatestCompaction(bool blocking) {
+    PAIMON_ASSIGN_OR_RAISE(std::optional<CompactResult> result,
+                           compact_manager_->GetCompactionResult(blocking));
+    if (result) {
+        PAIMON_RETURN_NOT_OK(UpdateCompactResult(result.value()));
+    }
+    return Status::OK();
+}
+
+Status AppendOnlyWriter::UpdateCompactResult(const CompactResult& result) {
+    std::set<std::string> after_files;
+    for (const auto& file : result.After()) {
+        after_files.insert(file->file_name);
+    }
+    for (const auto& file : result.Before()) {
+        auto iter = std::find_if(compact_after_.begin(), compact_after_.end(),
+                                 [&file](const std::shared_ptr<DataFileMeta>& compacted) {
+                                     return compacted->file_name == file->file_name;
+                                 });
+        if (iter == compact_after_.end()) {
+            compact_before_.push_back(file);
+            continue;
+        }
+        compact_after_.erase(iter);
+        // an intermediate file produced and consumed by compactions within one commit is never
+        // visible to readers, delete it together with its extra files (e.g. the file index)
+        if (after_files.find(file->file_name) == after_files.end()) {
+            for (const auto& path : path_factory_->CollectFiles(file)) {
+                PAIMON_RETURN_NOT_OK(options_.GetFileSystem()->Delete(path, false));
+            }
+        }
+    }
+    compact_after_.insert(compact_after_.end(), result.After().begin(), result.After().end());
+    return Status::OK();
+}
+
 Status AppendOnlyWriter::Flush() {
     if (writer_) {
         PAIMON_RETURN_NOT_OK(writer_->Close());
@@ -103,6 +150,15 @@ Status AppendOnlyWriter::Flush() {
         new_files_.insert(new_files_.end(), flushed_files.begin(), flushed_files.end());
         metrics_->Merge(writer_->GetMetrics());
         writer_.reset();
+        if (compact_manager_) {
+            for (const auto& file : flushed_files) {
+                compact_manager_->AddNewFile(file);
+            }
+        }
+    }
+    if (compact_manager_) {
+        PAIMON_RETURN_NOT_OK(TrySyncLatestCompaction(/*blocking=*/false));
+        PAIMON_RETURN_NOT_OK(compact_manager_->TriggerCompaction(/*full_compaction=*/false));
     }
     return Status::OK();
 }
@@ -140,6 +196,18 @@ AppendOnlyWriter::SingleFileWriterCreator AppendOnlyWriter::GetDataFileWriterCre
                 options_.GetFileCompression(), std::function<Status(ArrowArray*, ArrowArray*)>(),
                 schema_id_, seq_num_counter_, FileSource::Append(), stats_extractor,
                 path_factory_->IsExternalPath(), write_cols, memory_pool_);
+            if (options_.WriteStatsInFlightEnabled()) {
+                PAIMON_ASSIGN_OR_RAISE(std::unique_ptr<BatchStatsCollector> stats_collector,
+                                       BatchStatsCollector::Create(schema));
+                writer->WithStatsCollector(std::move(stats_collector));
+            }
+            PAIMON_ASSIGN_OR_RAISE(std::unique_ptr<DataFileIndexWriter> file_index_writer,
+                                   DataFileIndexWriter::Create(
+                                       schema, options_.ToMap(),
+                                       options_.GetFileIndexInManifestThreshold(), memory_pool_));
+            if (file_index_writer) {
+                writer->WithFileIndexWriter(std::move(file_index_writer));
+            }
             PAIMON_RETURN_NOT_OK(
                 writer->Init(options_.GetFileSystem(), path_factory_->NewPath(), writer_builder));
             return writer;
@@ -202,6 +270,25 @@ Status AppendOnlyWriter::Close() {
         writer_->Abort();
         writer_.reset();
     }
+    if (compact_manager_) {
+        // collect the output of the in-flight compaction, a failed compaction has no output
+        Result<std::optional<CompactResult>> compact_result =
+            compact_manager_->GetCompactionResult(/*blocking=*/true);
+        if (compact_result.ok() && compact_result.value()) {
+            PAIMON_RETURN_NOT_OK(UpdateCompactResult(compact_result.value().value()));
+        }
+        PAIMON_RETURN_NOT_OK(compact_manager_->Close());
+    }
+    // compaction output is not committed, append compaction always rewrites files so none of them
+    // is a committed file
+    for (const auto& file : compact_after_) {
+        for (const auto& path : path_factory_->CollectFiles(file)) {
+            // delete quietly, a leftover file is cleaned by orphan files cleaning
+            [[maybe_unused]] auto status = options_.GetFileSystem()->Delete(path, false);
+        }
+    }
+    compact_before_.clear();
+    compact_after_.clear();
     return Status::OK();
 }
 
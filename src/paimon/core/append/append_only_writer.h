@@ -24,6 +24,8 @@
 #include <vector>
 
 #include "paimon/common/data/blob_utils.h"
+#include "paimon/core/compact/compact_manager.h"
+#include "paimon/core/compact/compact_result.h"
 #include "paimon/core/core_options.h"
 #include "paimon/core/io/data_file_meta.h"
 #include "paimon/core/io/single_file_writer.h"
@@ -51,21 +53,25 @@ class Metrics;
 class FormatStatsExtractor;
 class WriterBuilder;
 
+/// Writer of a bucket of append table. Flushed files are handed to the compact manager (if any),
+/// whose compaction runs in background and is collected into `CompactIncrement`.
 class AppendOnlyWriter : public BatchWriter {
  public:
+    /// @param compact_manager nullptr indicates no compaction (e.g., write-only).
     AppendOnlyWriter(const CoreOptions& options, int64_t schema_id,
                      const std::shared_ptr<arrow::Schema>& write_schema,
                      const std::optional<std::vector<std::string>>& write_cols,
                      int64_t max_sequence_number,
                      const std::shared_ptr<DataFilePathFactory>& path_factory,
-                     const std::shared_ptr<MemoryPool>& memory_pool);
+                     const std::shared_ptr<MemoryPool>& memory_pool,
+                     const std::shared_ptr<CompactManager>& compact_manager = nullptr);
     ~AppendOnlyWriter() override;
 
     Status Write(std::unique_ptr<RecordBatch>&& batch) override;
     Result<CommitIncrement> PrepareCommit(bool wait_compaction) override;
     Status Close() override;
     bool IsCompacting() const override {
-        return false;
+        return compact_manager_ && compact_manager_->CompactNotCompleted();
     }
     std::shared_ptr<Metrics> GetMetrics() const override {
         return metrics_;
@@ -83,6 +89,8 @@ class AppendOnlyWriter : public BatchWriter {
 
     Result<CommitIncrement> DrainIncrement();
     Status Flush();
+    Status TrySyncLatestCompaction(bool blocking);
+    Status UpdateCompactResult(const CompactResult& result);
 
     SingleFileWriterCreator GetDataFileWriterCreator(
         const std::shared_ptr<arrow::Schema>& schema,
@@ -101,9 +109,12 @@ class AppendOnlyWriter : public BatchWriter {
     std::shared_ptr<DataFilePathFactory> path_factory_;
     std::shared_ptr<MemoryPool> memory_pool_;
     std::shared_ptr<Metrics> metrics_;
+    std::shared_ptr<CompactManager> compact_manager_;
 
     std::vector<std::shared_ptr<DataFileMeta>> new_files_;
     std::vector<std::shared_ptr<DataFileMeta>> deleted_files_;
+    std::vector<std::shared_ptr<DataFileMeta>> compact_before_;
+    std::vector<std::shared_ptr<DataFileMeta>> compact_after_;
 
     std::unique_ptr<RollingFileWriter<::ArrowArray*, std::shared_ptr<DataFileMeta>>> writer_;
 };
@@ -17,10 +17,13 @@
 #include "paimon/core/append/append_only_writer.h"
 
 #include <cstddef>
+#include <future>
 #include <map>
 #include <memory>
+#include <optional>
 #include <string>
 #include <utility>
+#include <vector>
 
 #include "arrow/api.h"
 #include "arrow/array/builder_binary.h"
@@ -31,12 +34,18 @@
 #include "arrow/type.h"
 #include "gtest/gtest.h"
 #include "paimon/common/fs/external_path_provider.h"
+#include "paimon/core/append/bucketed_append_compact_manager.h"
+#include "paimon/core/compact/compact_result.h"
 #include "paimon/core/core_options.h"
 #include "paimon/core/io/compact_increment.h"
+#include "paimon/core/io/data_file_meta.h"
 #include "paimon/core/io/data_file_path_factory.h"
 #include "paimon/core/io/data_increment.h"
+#include "paimon/core/manifest/file_source.h"
+#include "paimon/core/stats/simple_stats.h"
 #include "paimon/core/utils/commit_increment.h"
 #include "paimon/defs.h"
+#include "paimon/executor.h"
 #include "paimon/fs/file_system.h"
 #include "paimon/fs/local/local_file_system.h"
 #include "paimon/memory/memory_pool.h"
@@ -224,4 +233,128 @@ TEST_F(AppendOnlyWriterTest, TestInvalidRowKind) {
     ASSERT_TRUE(file_status_list.empty());
 }
 
+TEST_F(AppendOnlyWriterTest, TestDeleteIntermediateCompactFiles) {
+    std::map<std::string, std::string> raw_options;
+    raw_options[Options::FILE_FORMAT] = "mock_format";
+    raw_options[Options::FILE_SYSTEM] = "local";
+    raw_options[Options::MANIFEST_FORMAT] = "mock_format";
+    ASSERT_OK_AND_ASSIGN(CoreOptions options, CoreOptions::FromMap(raw_options));
+    auto schema = arrow::schema({arrow::field("f0", arrow::utf8())});
+
+    auto dir = UniqueTestDirectory::Create();
+    ASSERT_TRUE(dir);
+    auto path_factory = std::make_shared<DataFilePathFactory>();
+    ASSERT_OK(path_factory->Init(dir->Str(), "mock_format", options.DataFilePrefix(), nullptr));
+    AppendOnlyWriter writer(options, /*schema_id=*/0, schema, /*write_cols=*/std::nullopt,
+                            /*max_sequence_number=*/-1, path_factory, memory_pool_);
+
+    auto new_file = [](const std::string& file_name,
+                       const std::vector<std::optional<std::string>>& extra_files) {
+        return DataFileMeta::ForAppend(file_name, /*file_size=*/10, /*row_count=*/10,
+                                       SimpleStats::EmptyStats(), /*min_sequence_number=*/0,
+                                       /*max_sequence_number=*/9, /*schema_id=*/0, extra_files,
+                                       /*embedded_index=*/nullptr, FileSource::Compact(),
+                                       std::nullopt, std::nullopt, std::nullopt, std::nullopt)
+            .value();
+    };
+    auto committed = new_file("committed.mock_format", {});
+    auto intermediate = new_file("intermediate.mock_format", {"intermediate.mock_format.index"});
+    auto compacted = new_file("compacted.mock_format", {});
+    auto file_system = std::make_shared<LocalFileSystem>();
+    for (const auto& path : path_factory->CollectFiles(intermediate)) {
+        ASSERT_OK(file_system->WriteFile(path, "data", /*overwrite=*/false));
+    }
+
+    ASSERT_OK(writer.UpdateCompactResult(CompactResult({committed}, {intermediate})));
+    ASSERT_OK(writer.UpdateCompactResult(CompactResult({intermediate}, {compacted})));
+    // the intermediate file and its index are never committed
+    for (const auto& path : path_factory->CollectFiles(intermediate)) {
+        ASSERT_OK_AND_ASSIGN(bool exists, file_system->Exists(path));
+        ASSERT_FALSE(exists) << path;
+    }
+    ASSERT_OK_AND_ASSIGN(CommitIncrement inc, writer.PrepareCommit(true));
+    ASSERT_EQ(inc.GetCompactIncrement().CompactBefore(),
+              std::vector<std::shared_ptr<DataFileMeta>>({committed}));
+    ASSERT_EQ(inc.GetCompactIncrement().CompactAfter(),
+              std::vector<std::shared_ptr<DataFileMeta>>({compacted}));
+    ASSERT_OK(writer.Close());
+}
+
+TEST_F(AppendOnlyWriterTest, TestCloseWithUncommittedCompaction) {
+    std::map<std::string, std::string> raw_options;
+    raw_options[Options::FILE_FORMAT] = "orc";
+    raw_options[Options::FILE_SYSTEM] = "local";
+    raw_options[Options::MANIFEST_FORMAT] = "orc";
+    ASSERT_OK_AND_ASSIGN(CoreOptions options, CoreOptions::FromMap(raw_options));
+    arrow::FieldVector fields = {arrow::field("f0", arrow::utf8())};
+    auto schema = arrow::schema(fields);
+
+    auto dir = UniqueTestDirectory::Create();
+    ASSERT_TRUE(dir);
+    auto path_factory = std::make_shared<DataFilePathFactory>();
+    ASSERT_OK(path_factory->Init(dir->Str(), "orc", options.DataFilePrefix(), nullptr));
+    auto file_system = std::make_shared<LocalFileSystem>();
+
+    // the rewriter writes the compaction output and its index file, and only returns after
+    // `finish` is set
+    std::promise<void> finish;
+    std::shared_future<void> finished = finish.get_future().share();
+    std::vector<std::string> compacted_paths;
+    auto rewriter = [&](const std::vector<std::shared_ptr<DataFileMeta>>& files)
+        -> Result<std::vector<std::shared_ptr<DataFileMeta>>> {
+        finished.wait();
+        PAIMON_ASSIGN_OR_RAISE(
+            std::shared_ptr<DataFileMeta> compacted,
+            DataFileMeta::ForAppend("compacted.orc", /*file_size=*/10, files[0]->row_count,
+                                    SimpleStats::EmptyStats(), files[0]->min_sequence_number,
+                                    files[0]->max_sequence_number, /*schema_id=*/0,
+                                    /*extra_files=*/{"compacted.orc.index"},
+                                    /*embedded_index=*/nullptr, FileSource::Compact(),
+                                    std::nullopt, std::nullopt, std::nullopt, std::nullopt));
+        compacted_paths = path_factory->CollectFiles(compacted);
+        for (const auto& path : compacted_paths) {
+            PAIMON_RETURN_NOT_OK(file_system->WriteFile(path, "data", /*overwrite=*/false));
+        }
+        return std::vector<std::shared_ptr<DataFileMeta>>({compacted});
+    };
+    auto compact_manager = std::make_shared<BucketedAppendCompactManager>(
+        CreateDefaultExecutor(/*thread_count=*/1),
+        /*restored=*/std::vector<std::shared_ptr<DataFileMeta>>(), /*min_file_num=*/1,
+        /*max_file_num=*/1, /*target_file_size=*/1024, /*compaction_file_size=*/512, rewriter,
+        /*limiter=*/nullptr);
+    AppendOnlyWriter writer(options, /*schema_id=*/0, schema, /*write_cols=*/std::nullopt,
+                            /*max_sequence_number=*/-1, path_factory, memory_pool_,
+                            compact_manager);
+
+    arrow::StructBuilder struct_builder(arrow::struct_(fields), arrow::default_memory_pool(),
+                                        {std::make_shared<arrow::StringBuilder>()});
+    auto string_builder = static_cast<arrow::StringBuilder*>(struct_builder.field_builder(0));
+    ASSERT_TRUE(struct_builder.Append().ok());
+    ASSERT_TRUE(string_builder->Append("row0").ok());
+    std::shared_ptr<arrow::Array> array;
+    ASSERT_TRUE(struct_builder.Finish(&array).ok());
+    ::ArrowArray arrow_array;
+    ASSERT_TRUE(arrow::ExportArray(*array, &arrow_array).ok());
+    RecordBatchBuilder batch_builder(&arrow_array);
+    ASSERT_OK_AND_ASSIGN(auto record_batch, batch_builder.Finish());
+    ASSERT_OK(writer.Write(std::move(record_batch)));
+    ASSERT_OK_AND_ASSIGN(CommitIncrement inc, writer.PrepareCommit(/*wait_compaction=*/false));
+    ASSERT_EQ(1, inc.GetNewFilesIncrement().NewFiles().size());
+    ASSERT_TRUE(inc.GetCompactIncrement().IsEmpty());
+    ASSERT_TRUE(writer.IsCompacting());
+
+    // the compaction finishes, but its result is never committed
+    finish.set_value();
+    ASSERT_OK(writer.Close());
+    ASSERT_EQ(2, compacted_paths.size());
+    for (const auto& path : compacted_paths) {
+        ASSERT_OK_AND_ASSIGN(bool exists, file_system->Exists(path));
+        ASSERT_FALSE(exists) << path;
+    }
+    // the flushed file is committed, it is kept
+    ASSERT_OK_AND_ASSIGN(bool exists, file_system->Exists(path_factory->ToPath(
+                                          inc.GetNewFilesIncrement().NewFiles()[0])));
+    ASSERT_TRUE(exists);
+}
+
 }  // namespace paimon::test
@@ -0,0 +1,215 @@
+/*
+ * Copyright 2024-present Alibaba Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "paimon/core/append/bucketed_append_compact_manager.h"
+
+#include <algorithm>
+#include <deque>
+#include <utility>
+
+#include "paimon/common/executor/future.h"
+#include "paimon/common/utils/scope_guard.h"
+#include "paimon/core/compact/compact_task_limiter.h"
+#include "paimon/executor.h"
+
+namespace paimon {
+
+BucketedAppendCompactManager::BucketedAppendCompactManager(
+    const std::shared_ptr<Executor>& executor,
+    const std::vector<std::shared_ptr<DataFileMeta>>& restored, int32_t min_file_num,
+    int32_t max_file_num, int64_t target_file_size, int64_t compaction_file_size,
+    const CompactRewriter& rewriter, const std::shared_ptr<CompactTaskLimiter>& limiter)
+    : executor_(executor),
+      min_file_num_(min_file_num),
+      max_file_num_(max_file_num),
+      target_file_size_(target_file_size),
+      compaction_file_size_(compaction_file_size),
+      rewriter_(rewriter),
+      limiter_(limiter),
+      to_compact_(restored) {
+    std::stable_sort(to_compact_.begin(), to_compact_.end(), FileComparator(false));
+}
+
+void BucketedAppendCompactManager::AddNewFile(const std::shared_ptr<DataFileMeta>& file) {
+    AddToCompact(file);
+}
+
+void BucketedAppendCompactManager::AddToCompact(const std::shared_ptr<DataFileMeta>& file) {
+    auto iter = std::upper_bound(to_compact_.begin(), to_compact_.end(), file,
+                                 FileComparator(/*ignore_overlap=*/true));
+    to_compact_.insert(iter, file);
+}
+
+std::vector<std::shared_ptr<DataFileMeta>> BucketedAppendCompactManager::AllFiles() const {
+    std::vector<std::shared_ptr<DataFileMeta>> all_files = compacting_;
+    all_files.insert(all_files.end(), to_compact_.begin(), to_compact_.end());
+    return all_files;
+}
+
+Status BucketedAppendCompactManager::TriggerCompaction(bool full_compaction) {
+    if (full_compaction) {
+        if (task_future_.valid()) {
+            return Status::Invalid(
+                "A compaction task is still running while the user forces a new compaction. This "
+                "is unexpected.");
+        }
+        if (to_compact_.size() < 2) {
+            return Status::OK();
+        }
+        // a forced compaction is not limited
+        std::vector<std::shared_ptr<DataFileMeta>> files = std::move(to_compact_);
+        to_compact_.clear();
+        SubmitCompaction(std::move(files), /*full_compaction=*/true);
+        return Status::OK();
+    }
+    if (task_future_.valid()) {
+        return Status::OK();
+    }
+    std::optional<std::vector<std::shared_ptr<DataFileMeta>>> picked = PickCompactBefore();
+    if (!picked) {
+        return Status::OK();
+    }
+    if (limiter_ && !limiter_->TryAcquire()) {
+        // too many compactions in this write, retry on the next trigger
+        for (const auto& file : picked.value()) {
+            AddToCompact(file);
+        }
+        return Status::OK();
+    }
+    SubmitCompaction(std::move(picked).value(), /*full_compaction=*/false);
+    return Status::OK();
+}
+
+std::optional<std::vector<std::shared_ptr<DataFileMeta>>>
+BucketedAppendCompactManager::PickCompactBefore() {
+    int64_t total_file_size = 0;
+    int32_t file_num = 0;
+    std::deque<std::shared_ptr<DataFileMeta>> candidates;
+    size_t next = 0;
+    bool picked = false;
+    for (; next < to_compact_.size(); ++next) {
+        const auto& file = to_compact_[next];
+        candidates.push_back(file);
+        total_file_size += file->file_size;
+        file_num++;
+        if ((total_file_size >= target_file_size_ && file_num >= min_file_num_) ||
+            file_num >= max_file_num_) {
+            picked = true;
+            break;
+        }
+        if (total_file_size >= target_file_size_) {
+            // the window already makes a file of target size, shift it one file to the right
+            total_file_size -= candidates.front()->file_size;
+            candidates.pop_front();
+            file_num--;
+        }
+    }
+    if (!picked) {
+        return std::nullopt;
+    }
+    // candidates are contiguous and end at `next`
+    size_t begin = next + 1 - candidates.size();
+    to_compact_.erase(to_compact_.begin() + begin, to_compact_.begin() + next + 1);
+    return std::vector<std::shared_ptr<DataFileMeta>>(candidates.begin(), candidates.end());
+}
+
+void BucketedAppendCompactManager::SubmitCompaction(
+    std::vector<std::shared_ptr<DataFileMeta>>&& files, bool full_compaction) {
+    compacting_ = files;
+    auto limiter = full_compaction ? nullptr : limiter_;
+    auto task = [files = std::move(files), full_compaction, limiter,
+                 compaction_file_size = compaction_file_size_,
+                 rewriter = rewriter_]() -> Result<CompactResult> {
+        ScopeGuard guard([&limiter]() {
+            if (limiter) {
+                limiter->Release();
+            }
+        });
+        if (full_compaction) {
+            return FullCompact(files, compaction_file_size, rewriter);
+        }
+        return AutoCompact(files, rewriter);
+    };
+    // compaction is background work, it yields to reads and flushes sharing the executor
+    task_future_ = Via(executor_.get(), std::move(task), TaskPriority::LOW);
+}
+
+Result<CompactResult> BucketedAppendCompactManager::FullCompact(
+    std::vector<std::shared_ptr<DataFileMeta>> files, int64_t compaction_file_size,
+    const CompactRewriter& rewriter) {
+    // large files at the head are already compacted, keep them
+    auto first_small = std::find_if(files.begin(), files.end(), [&](const auto& file) {
+        return file->file_size < compaction_file_size;
+    });
+    files.erase(files.begin(), first_small);
+    int32_t big = 0;
+    int32_t small = 0;
+    for (const auto& file : files) {
+        if (file->file_size >= compaction_file_size) {
+            big++;
+        } else {
+            small++;
+        }
+    }
+    if (files.size() < 2 || small <= big) {
+        // rewriting mostly large files is not worth it
+        return CompactResult();
+    }
+    return AutoCompact(files, rewriter);
+}
+
+Result<CompactResult> BucketedAppendCompactManager::AutoCompact(
+    const std::vector<std::shared_ptr<DataFileMeta>>& files, const CompactRewriter& rewriter) {
+    PAIMON_ASSIGN_OR_RAISE(std::vector<std::shared_ptr<DataFileMeta>> rewritten, rewriter(files));
+    return CompactResult(files, rewritten);
+}
+
+Result<std::optional<CompactResult>> BucketedAppendCompactManager::GetCompactionResult(
+    bool blocking) {
+    bool was_running = task_future_.valid();
+    Result<std::optional<CompactResult>> result = ObtainCompactResult(blocking);
+    if (!was_running || task_future_.valid()) {
+        // the running compaction is not finished
+        return result;
+    }
+    std::vector<std::shared_ptr<DataFileMeta>> compacting = std::move(compacting_);
+    compacting_.clear();
+    if (!result.ok()) {
+        // input files stay in the bucket, they may be compacted again later
+        for (const auto& file : compacting) {
+            AddToCompact(file);
+        }
+        return result;
+    }
+    const std::optional<CompactResult>& compact_result = result.value();
+    // files kept by a full compaction are not in the result, they wait for the next compaction
+    for (const auto& file : compacting) {
+        const auto& before = compact_result->Before();
+        if (std::find(before.begin(), before.end(), file) == before.end()) {
+            AddToCompact(file);
+        }
+    }
+    if (!compact_result->After().empty()) {
+        // if the last compacted file is still small, add it back to the head
+        const auto& last_file = compact_result->After().back();
+        if (IsSmallFile(last_file)) {
+            AddToCompact(last_file);
+        }
+    }
+    return result;
+}
+
+}  // namespace paimon
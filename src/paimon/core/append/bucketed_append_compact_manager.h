@@ -16,17 +16,66 @@
 
 #pragma once
 
+#include <cstdint>
 #include <functional>
 #include <memory>
+#include <optional>
+#include <vector>
 
+#include "paimon/core/compact/compact_future_manager.h"
+#include "paimon/core/compact/compact_result.h"
 #include "paimon/core/io/data_file_meta.h"
+#include "paimon/result.h"
+#include "paimon/status.h"
 
 namespace paimon {
+class CompactTaskLimiter;
+class Executor;
+
 /// Compact manager for `AppendOnlyFileStore`.
-class BucketedAppendCompactManager {
+///
+/// Files of a bucket are kept in sequence order, a compaction picks a window of sequence-contiguous
+/// files once it holds `min_file_num` files reaching the target file size, or `max_file_num` files
+/// of any size. The window slides forward while fewer files already reach the target file size.
+/// Picked files are rewritten on the executor, so the order of records in the bucket is kept.
+class BucketedAppendCompactManager : public CompactFutureManager {
  public:
-    BucketedAppendCompactManager() = delete;
-    ~BucketedAppendCompactManager() = delete;
+    /// Rewrites sequence-contiguous files into new files of the target file size.
+    using CompactRewriter = std::function<Result<std::vector<std::shared_ptr<DataFileMeta>>>(
+        const std::vector<std::shared_ptr<DataFileMeta>>&)>;
+
+    /// @param limiter Shared by the compact managers of a write to cap concurrent compactions.
+    BucketedAppendCompactManager(const std::shared_ptr<Executor>& executor,
+                                 const std::vector<std::shared_ptr<DataFileMeta>>& restored,
+                                 int32_t min_file_num, int32_t max_file_num,
+                                 int64_t target_file_size, int64_t compaction_file_size,
+                                 const CompactRewriter& rewriter,
+                                 const std::shared_ptr<CompactTaskLimiter>& limiter);
+
+    ~BucketedAppendCompactManager() override {
+        [[maybe_unused]] auto status = Close();
+    }
+
+    bool ShouldWaitForLatestCompaction() const override {
+        return false;
+    }
+
+    bool ShouldWaitForPreparingCheckpoint() const override {
+        return false;
+    }
+
+    void AddNewFile(const std::shared_ptr<DataFileMeta>& file) override;
+
+    std::vector<std::shared_ptr<DataFileMeta>> AllFiles() const override;
+
+    Status TriggerCompaction(bool full_compaction) override;
+
+    Result<std::optional<CompactResult>> GetCompactionResult(bool blocking) override;
+
+    /// Files waiting for compaction, in sequence order.
+    const std::vector<std::shared_ptr<DataFileMeta>>& ToCompact() const {
+        return to_compact_;
+    }
 
     /// New files may be created during the compaction process, then the results of the compaction
     /// may be put after the new files, and this order will be disrupted. We need to ensure this
@@ -47,10 +96,42 @@ class BucketedAppendCompactManager {
     }
 
  private:
+    /// Picks sequence-contiguous files from the head of `to_compact_`, std::nullopt if there is
+    /// not enough small files.
+    std::optional<std::vector<std::shared_ptr<DataFileMeta>>> PickCompactBefore();
+
+    void SubmitCompaction(std::vector<std::shared_ptr<DataFileMeta>>&& files, bool full_compaction);
+
+    static Result<CompactResult> FullCompact(std::vector<std::shared_ptr<DataFileMeta>> files,
+                                             int64_t compaction_file_size,
+                                             const CompactRewriter& rewriter);
+
+    static Result<CompactResult> AutoCompact(
+        const std::vector<std::shared_ptr<DataFileMeta>>& files, const CompactRewriter& rewriter);
+
+    bool IsSmallFile(const std::shared_ptr<DataFileMeta>& file) const {
+        return file->file_size < compaction_file_size_;
+    }
+
+    void AddToCompact(const std::shared_ptr<DataFileMeta>& file);
+
     static bool IsOverlap(const std::shared_ptr<DataFileMeta>& o1,
                           const std::shared_ptr<DataFileMeta>& o2) {
         return o2->min_sequence_number <= o1->max_sequence_number &&
                o2->max_sequence_number >= o1->min_sequence_number;
     }
+
+ private:
+    std::shared_ptr<Executor> executor_;
+    int32_t min_file_num_;
+    int32_t max_file_num_;
+    int64_t target_file_size_;
+    int64_t compaction_file_size_;
+    CompactRewriter rewriter_;
+    std::shared_ptr<CompactTaskLimiter> limiter_;
+    // files waiting for compaction, ordered by sequence number
+    std::vector<std::shared_ptr<DataFileMeta>> to_compact_;
+    // files of the running compaction
+    std::vector<std::shared_ptr<DataFileMeta>> compacting_;
 };
 }  // namespace paimon
@@ -22,10 +22,14 @@
 #include <vector>
 
 #include "gtest/gtest.h"
+#include "paimon/core/compact/compact_task_limiter.h"
 #include "paimon/core/io/data_file_meta.h"
 #include "paimon/core/manifest/file_source.h"
 #include "paimon/core/stats/simple_stats.h"
+#include "paimon/executor.h"
 #include "paimon/result.h"
+#include "paimon/status.h"
+#include "paimon/testing/utils/testharness.h"
 
 namespace paimon::test {
 
@@ -56,7 +60,39 @@ class BucketedAppendCompactManagerTest : public testing::Test {
         return metas;
     }
 
- private:
+    static std::shared_ptr<DataFileMeta> NewFile(const std::string& name, int64_t file_size,
+                                                 int64_t min_sequence_number,
+                                                 int64_t max_sequence_number) {
+        return DataFileMeta::ForAppend(name, file_size, /*row_count=*/file_size,
+                                       SimpleStats::EmptyStats(), min_sequence_number,
+                                       max_sequence_number, 0, FileSource::Append(), std::nullopt,
+                                       std::nullopt, std::nullopt, std::nullopt)
+            .value();
+    }
+
+    /// Merges all input files into one file covering their sequence numbers.
+    static Result<std::vector<std::shared_ptr<DataFileMeta>>> MergeFiles(
+        const std::vector<std::shared_ptr<DataFileMeta>>& files) {
+        int64_t file_size = 0;
+        for (const auto& file : files) {
+            file_size += file->file_size;
+        }
+        return std::vector<std::shared_ptr<DataFileMeta>>(
+            {NewFile("compact-" + files.front()->file_name, file_size,
+                     files.front()->min_sequence_number, files.back()->max_sequence_number)});
+    }
+
+    static std::vector<std::string> FileNames(
+        const std::vector<std::shared_ptr<DataFileMeta>>& files) {
+        std::vector<std::string> names;
+        for (const auto& file : files) {
+            names.push_back(file->file_name);
+        }
+        return names;
+    }
+
+ protected:
+    std::shared_ptr<Executor> executor_ = CreateDefaultExecutor(/*thread_count=*/2);
 };
 
 TEST_F(BucketedAppendCompactManagerTest, TestFileComparatorWithoutOverlap) {
@@ -96,4 +132,137 @@ TEST_F(BucketedAppendCompactManagerTest, TestIsOverlap) {
     EXPECT_FALSE(BucketedAppendCompactManager::IsOverlap(file2, file3));
 }
 
+TEST_F(BucketedAppendCompactManagerTest, TestPickCompactBefore) {
+    // file sizes with target 100, compaction file size 80 and min file num 3
+    std::vector<std::shared_ptr<DataFileMeta>> restored = {
+        NewFile("f0", 90, 0, 9), NewFile("f1", 20, 10, 19), NewFile("f2", 50, 20, 29),
+        NewFile("f3", 40, 30, 39)};
+    BucketedAppendCompactManager manager(executor_, restored, /*min_file_num=*/3,
+                                         /*max_file_num=*/50, /*target_file_size=*/100,
+                                         /*compaction_file_size=*/80, MergeFiles,
+                                         /*limiter=*/nullptr);
+    auto picked = manager.PickCompactBefore();
+    ASSERT_TRUE(picked);
+    // f0 and f1 already reach the target size, the window slides over f0
+    ASSERT_EQ(FileNames(picked.value()), std::vector<std::string>({"f1", "f2", "f3"}));
+    ASSERT_EQ(FileNames(manager.ToCompact()), std::vector<std::string>({"f0"}));
+    ASSERT_FALSE(manager.PickCompactBefore());
+}
+
+TEST_F(BucketedAppendCompactManagerTest, TestPickCompactBeforeBelowTargetSize) {
+    // min file num is reached, but the files do not make a file of target size
+    std::vector<std::shared_ptr<DataFileMeta>> restored = {
+        NewFile("f0", 20, 0, 9), NewFile("f1", 20, 10, 19), NewFile("f2", 20, 20, 29),
+        NewFile("f3", 20, 30, 39)};
+    BucketedAppendCompactManager manager(executor_, restored, /*min_file_num=*/3,
+                                         /*max_file_num=*/50, /*target_file_size=*/100,
+                                         /*compaction_file_size=*/80, MergeFiles,
+                                         /*limiter=*/nullptr);
+    ASSERT_FALSE(manager.PickCompactBefore());
+    ASSERT_EQ(FileNames(manager.ToCompact()), std::vector<std::string>({"f0", "f1", "f2", "f3"}));
+}
+
+TEST_F(BucketedAppendCompactManagerTest, TestPickCompactBeforeByMaxFileNum) {
+    // too many small files are compacted even if they do not reach the target size
+    std::vector<std::shared_ptr<DataFileMeta>> restored = {
+        NewFile("f0", 10, 0, 9), NewFile("f1", 10, 10, 19), NewFile("f2", 10, 20, 29),
+        NewFile("f3", 10, 30, 39), NewFile("f4", 10, 40, 49)};
+    BucketedAppendCompactManager manager(executor_, restored, /*min_file_num=*/3,
+                                         /*max_file_num=*/4, /*target_file_size=*/100,
+                                         /*compaction_file_size=*/80, MergeFiles,
+                                         /*limiter=*/nullptr);
+    auto picked = manager.PickCompactBefore();
+    ASSERT_TRUE(picked);
+    ASSERT_EQ(FileNames(picked.value()), std::vector<std::string>({"f0", "f1", "f2", "f3"}));
+    ASSERT_EQ(FileNames(manager.ToCompact()), std::vector<std::string>({"f4"}));
+    ASSERT_FALSE(manager.PickCompactBefore());
+}
+
+TEST_F(BucketedAppendCompactManagerTest, TestCompaction) {
+    BucketedAppendCompactManager manager(executor_, /*restored=*/{}, /*min_file_num=*/3,
+                                         /*max_file_num=*/50, /*target_file_size=*/30,
+                                         /*compaction_file_size=*/80, MergeFiles,
+                                         /*limiter=*/nullptr);
+    manager.AddNewFile(NewFile("f1", 10, 10, 19));
+    manager.AddNewFile(NewFile("f0", 10, 0, 9));
+    ASSERT_OK(manager.TriggerCompaction(/*full_compaction=*/false));
+    ASSERT_FALSE(manager.CompactNotCompleted());
+
+    manager.AddNewFile(NewFile("f2", 10, 20, 29));
+    ASSERT_OK(manager.TriggerCompaction(/*full_compaction=*/false));
+    ASSERT_TRUE(manager.CompactNotCompleted());
+    // new files can be added while compacting
+    manager.AddNewFile(NewFile("f3", 10, 30, 39));
+    ASSERT_EQ(manager.AllFiles().size(), 4);
+
+    ASSERT_OK_AND_ASSIGN(std::optional<CompactResult> result,
+                         manager.GetCompactionResult(/*blocking=*/true));
+    ASSERT_TRUE(result);
+    ASSERT_EQ(FileNames(result->Before()), std::vector<std::string>({"f0", "f1", "f2"}));
+    ASSERT_EQ(FileNames(result->After()), std::vector<std::string>({"compact-f0"}));
+    ASSERT_FALSE(manager.CompactNotCompleted());
+    // the small compacted file is put back in front of newer files
+    ASSERT_EQ(FileNames(manager.ToCompact()), std::vector<std::string>({"compact-f0", "f3"}));
+}
+
+TEST_F(BucketedAppendCompactManagerTest, TestCompactionFailure) {
+    auto rewriter = [](const std::vector<std::shared_ptr<DataFileMeta>>&)
+        -> Result<std::vector<std::shared_ptr<DataFileMeta>>> {
+        return Status::IOError("mock rewrite failure");
+    };
+    std::vector<std::shared_ptr<DataFileMeta>> restored = {
+        NewFile("f0", 10, 0, 9), NewFile("f1", 10, 10, 19), NewFile("f2", 10, 20, 29)};
+    BucketedAppendCompactManager manager(executor_, restored, /*min_file_num=*/3,
+                                         /*max_file_num=*/50, /*target_file_size=*/30,
+                                         /*compaction_file_size=*/80, rewriter,
+                                         /*limiter=*/nullptr);
+    ASSERT_OK(manager.TriggerCompaction(/*full_compaction=*/false));
+    ASSERT_TRUE(manager.ToCompact().empty());
+    ASSERT_NOK(manager.GetCompactionResult(/*blocking=*/true));
+    // input files wait for the next compaction
+    ASSERT_EQ(FileNames(manager.ToCompact()), std::vector<std::string>({"f0", "f1", "f2"}));
+}
+
+TEST_F(BucketedAppendCompactManagerTest, TestFullCompaction) {
+    std::vector<std::shared_ptr<DataFileMeta>> restored = {
+        NewFile("f0", 90, 0, 9), NewFile("f1", 10, 10, 19), NewFile("f2", 10, 20, 29)};
+    BucketedAppendCompactManager manager(executor_, restored, /*min_file_num=*/5,
+                                         /*max_file_num=*/50, /*target_file_size=*/100,
+                                         /*compaction_file_size=*/80, MergeFiles,
+                                         /*limiter=*/nullptr);
+    ASSERT_OK(manager.TriggerCompaction(/*full_compaction=*/true));
+    ASSERT_NOK(manager.TriggerCompaction(/*full_compaction=*/true));
+    ASSERT_OK_AND_ASSIGN(std::optional<CompactResult> result,
+                         manager.GetCompactionResult(/*blocking=*/true));
+    ASSERT_TRUE(result);
+    // the large file at the head is kept
+    ASSERT_EQ(FileNames(result->Before()), std::vector<std::string>({"f1", "f2"}));
+    ASSERT_EQ(FileNames(manager.ToCompact()), std::vector<std::string>({"f0", "compact-f1"}));
+}
+
+TEST_F(BucketedAppendCompactManagerTest, TestLimiter) {
+    auto limiter = std::make_shared<CompactTaskLimiter>(/*max_tasks=*/1);
+    std::vector<std::shared_ptr<DataFileMeta>> restored = {NewFile("f0", 10, 0, 9),
+                                                           NewFile("f1", 10, 10, 19)};
+    BucketedAppendCompactManager manager1(executor_, restored, /*min_file_num=*/2,
+                                          /*max_file_num=*/50, /*target_file_size=*/20,
+                                          /*compaction_file_size=*/80, MergeFiles, limiter);
+    BucketedAppendCompactManager manager2(executor_, restored, /*min_file_num=*/2,
+                                          /*max_file_num=*/50, /*target_file_size=*/20,
+                                          /*compaction_file_size=*/80, MergeFiles, limiter);
+    ASSERT_TRUE(limiter->TryAcquire());
+    ASSERT_OK(manager1.TriggerCompaction(/*full_compaction=*/false));
+    ASSERT_FALSE(manager1.CompactNotCompleted());
+    ASSERT_EQ(manager1.ToCompact().size(), 2);
+    limiter->Release();
+
+    ASSERT_OK(manager1.TriggerCompaction(/*full_compaction=*/false));
+    ASSERT_TRUE(manager1.CompactNotCompleted());
+    ASSERT_OK(manager1.GetCompactionResult(/*blocking=*/true));
+    ASSERT_EQ(limiter->RunningTasks(), 0);
+    ASSERT_OK(manager2.TriggerCompaction(/*full_compaction=*/false));
+    ASSERT_TRUE(manager2.CompactNotCompleted());
+    ASSERT_OK(manager2.GetCompactionResult(/*blocking=*/true));
+}
+
 }  // namespace paimon::test
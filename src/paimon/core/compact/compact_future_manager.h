@@ -0,0 +1,61 @@
+/*
+ * Copyright 2024-present Alibaba Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <chrono>
+#include <future>
+#include <optional>
+#include <utility>
+
+#include "paimon/core/compact/compact_manager.h"
+#include "paimon/core/compact/compact_result.h"
+#include "paimon/result.h"
+
+namespace paimon {
+/// Base implementation of `CompactManager` which holds the future of the running compaction task
+/// submitted to an `Executor`.
+class CompactFutureManager : public CompactManager {
+ public:
+    bool CompactNotCompleted() const override {
+        return task_future_.valid();
+    }
+
+    Status Close() override {
+        if (task_future_.valid()) {
+            // the result is discarded, writers collect it before closing the manager to delete
+            // the produced files, otherwise they are cleaned by orphan files cleaning
+            [[maybe_unused]] auto result = task_future_.get();
+        }
+        return Status::OK();
+    }
+
+ protected:
+    Result<std::optional<CompactResult>> ObtainCompactResult(bool blocking) {
+        if (!task_future_.valid()) {
+            return std::optional<CompactResult>();
+        }
+        if (!blocking && task_future_.wait_for(std::chrono::seconds(0)) !=
+                             std::future_status::ready) {
+            return std::optional<CompactResult>();
+        }
+        PAIMON_ASSIGN_OR_RAISE(CompactResult result, task_future_.get());
+        return std::optional<CompactResult>(std::move(result));
+    }
+
+    std::future<Result<CompactResult>> task_future_;
+};
+}  // namespace paimon
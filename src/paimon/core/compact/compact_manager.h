@@ -0,0 +1,61 @@
+/*
+ * Copyright 2024-present Alibaba Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <memory>
+#include <optional>
+#include <vector>
+
+#include "paimon/core/compact/compact_result.h"
+#include "paimon/core/io/data_file_meta.h"
+#include "paimon/result.h"
+#include "paimon/status.h"
+
+namespace paimon {
+/// Manager to submit compaction task of a bucket, at most one compaction task is running at a
+/// time. All methods are expected to be called from the writer thread.
+class CompactManager {
+ public:
+    virtual ~CompactManager() = default;
+
+    /// Should wait compaction finish before accepting more writes.
+    virtual bool ShouldWaitForLatestCompaction() const = 0;
+
+    /// Should wait compaction finish before preparing commit.
+    virtual bool ShouldWaitForPreparingCheckpoint() const = 0;
+
+    /// Add a new file, which is produced by flushing the write buffer.
+    virtual void AddNewFile(const std::shared_ptr<DataFileMeta>& file) = 0;
+
+    virtual std::vector<std::shared_ptr<DataFileMeta>> AllFiles() const = 0;
+
+    /// Trigger a new compaction task if no compaction is running and the files need compaction.
+    ///
+    /// @param full_compaction If true, all files are picked and compacted to the max level.
+    virtual Status TriggerCompaction(bool full_compaction) = 0;
+
+    /// Get compaction result, wait for the running compaction to finish if `blocking` is true.
+    /// Returns std::nullopt if there is no finished compaction.
+    virtual Result<std::optional<CompactResult>> GetCompactionResult(bool blocking) = 0;
+
+    /// Check if a compaction is in progress, or if a compaction result remains to be fetched.
+    virtual bool CompactNotCompleted() const = 0;
+
+    /// Wait for the running compaction (if any) and discard its result.
+    virtual Status Close() = 0;
+};
+}  // namespace paimon
@@ -0,0 +1,59 @@
+/*
+ * Copyright 2024-present Alibaba Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "paimon/core/io/data_file_meta.h"
+
+namespace paimon {
+/// Result of compaction, files before and after the compaction.
+class CompactResult {
+ public:
+    CompactResult() = default;
+    CompactResult(const std::vector<std::shared_ptr<DataFileMeta>>& before,
+                  const std::vector<std::shared_ptr<DataFileMeta>>& after)
+        : before_(before), after_(after) {}
+
+    const std::vector<std::shared_ptr<DataFileMeta>>& Before() const {
+        return before_;
+    }
+
+    const std::vector<std::shared_ptr<DataFileMeta>>& After() const {
+        return after_;
+    }
+
+    void AddBefore(const std::shared_ptr<DataFileMeta>& file) {
+        before_.push_back(file);
+    }
+
+    void AddAfter(const std::shared_ptr<DataFileMeta>& file) {
+        after_.push_back(file);
+    }
+
+    void Merge(const CompactResult& that) {
+        before_.insert(before_.end(), that.before_.begin(), that.before_.end());
+        after_.insert(after_.end(), that.after_.begin(), that.after_.end());
+    }
+
+ private:
+    std::vector<std::shared_ptr<DataFileMeta>> before_;
+    std::vector<std::shared_ptr<DataFileMeta>> after_;
+};
+}  // namespace paimon
@@ -0,0 +1,60 @@
+/*
+ * Copyright 2024-present Alibaba Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <optional>
+
+namespace paimon {
+/// Limits the number of compaction tasks running concurrently, shared by the compact managers of
+/// all buckets in one write. Compact managers skip triggering when no slot is available and retry
+/// on their next trigger, so the limiter never blocks.
+class CompactTaskLimiter {
+ public:
+    /// @param max_tasks std::nullopt indicates unlimited.
+    explicit CompactTaskLimiter(std::optional<int32_t> max_tasks) : max_tasks_(max_tasks) {}
+
+    bool TryAcquire() {
+        if (!max_tasks_) {
+            return true;
+        }
+        int32_t running = running_tasks_.load(std::memory_order_relaxed);
+        while (running < max_tasks_.value()) {
+            if (running_tasks_.compare_exchange_weak(running, running + 1,
+                                                     std::memory_order_acq_rel)) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    void Release() {
+        if (max_tasks_) {
+            running_tasks_.fetch_sub(1, std::memory_order_acq_rel);
+        }
+    }
+
+    int32_t RunningTasks() const {
+        return running_tasks_.load(std::memory_order_acquire);
+    }
+
+ private:
+    std::optional<int32_t> max_tasks_;
+    std::atomic<int32_t> running_tasks_{0};
+};
+}  // namespace paimon
@@ -16,6 +16,7 @@
 
 #include "paimon/core/core_options.h"
 
+#include <algorithm>
 #include <cstring>
 #include <limits>
 #include <memory>
@@ -251,7 +252,12 @@ struct CoreOptions::Impl {
     int64_t source_split_open_file_cost = 4 * 1024 * 1024;
     int64_t manifest_target_file_size = 8 * 1024 * 1024;
     int64_t manifest_full_compaction_file_size = 16 * 1024 * 1024;
+    int64_t manifest_cache_max_memory_size = 0;
+    int64_t deletion_vectors_cache_max_memory_size = 0;
     int64_t write_buffer_size = 256 * 1024 * 1024;
+    int64_t write_buffer_total_size = 0;
+    int64_t write_buffer_spill_max_disk_size = std::numeric_limits<int64_t>::max();
+    int64_t read_file_lookahead_memory_budget = 64 * 1024 * 1024;
     int64_t commit_timeout = std::numeric_limits<int64_t>::max();
 
     std::shared_ptr<FileFormat> file_format;
@@ -267,6 +273,8 @@ struct CoreOptions::Impl {
     StartupMode startup_mode = StartupMode::Default();
     std::string file_compression = "zstd";
     std::string manifest_compression = "zstd";
+    std::string spill_compression = "zstd";
+    std::string write_buffer_spill_dir;
     std::string branch = BranchManager::DEFAULT_MAIN_BRANCH;
     std::string data_file_prefix = "data-";
     std::string file_system_scheme_to_identifier_map_str;
@@ -281,7 +289,10 @@ struct CoreOptions::Impl {
 
     int32_t manifest_merge_min_count = 30;
     int32_t read_batch_size = 1024;
+    int32_t read_merge_section_parallelism = 4;
+    int32_t read_file_lookahead = 0;
     int32_t write_batch_size = 1024;
+    int32_t local_sort_max_num_file_handles = 128;
     int32_t commit_max_retries = 10;
 
     SortOrder sequence_field_sort_order = SortOrder::ASCENDING;
@@ -291,18 +302,32 @@ struct CoreOptions::Impl {
     ExternalPathStrategy external_path_strategy = ExternalPathStrategy::NONE;
 
     int32_t file_compression_zstd_level = 1;
+    int32_t num_sorted_runs_compaction_trigger = 5;
+    std::optional<int32_t> num_sorted_runs_stop_trigger;
+    std::optional<int32_t> num_levels;
+    int32_t compaction_max_size_amplification_percent = 200;
+    int32_t compaction_size_ratio = 1;
+    int32_t compaction_min_file_num = 5;
+    int32_t compaction_max_file_num = 50;
+    std::optional<int32_t> compaction_max_concurrent_tasks;
+    int32_t write_row_to_batch_thread_number = 1;
 
     bool ignore_delete = false;
     bool deletion_vectors_enabled = false;
     bool force_lookup = false;
     bool partial_update_remove_record_on_delete = false;
     bool file_index_read_enabled = true;
+    int64_t file_index_in_manifest_threshold = 500;
     bool enable_adaptive_prefetch_strategy = true;
     bool index_file_in_data_file_dir = false;
     bool row_tracking_enabled = false;
     bool data_evolution_enabled = false;
     bool legacy_partition_name_enabled = true;
     bool global_index_enabled = true;
+    bool write_only = false;
+    bool write_stats_in_flight_enabled = true;
+    bool write_buffer_spillable = false;
+    bool sort_normalized_key_enabled = true;
     std::optional<std::string> global_index_external_path;
 };
 
@@ -322,9 +347,45 @@ Result<CoreOptions> CoreOptions::FromMap(
         parser.Parse(Options::MANIFEST_MERGE_MIN_COUNT, &impl->manifest_merge_min_count));
     PAIMON_RETURN_NOT_OK(parser.Parse(Options::SCAN_SNAPSHOT_ID, &impl->scan_snapshot_id));
     PAIMON_RETURN_NOT_OK(parser.Parse(Options::READ_BATCH_SIZE, &impl->read_batch_size));
+    PAIMON_RETURN_NOT_OK(parser.Parse(Options::READ_MERGE_SECTION_PARALLELISM,
+                                      &impl->read_merge_section_parallelism));
+    if (impl->read_merge_section_parallelism <= 0) {
+        return Status::Invalid(fmt::format("{} must be greater than 0, but is {}",
+                                           Options::READ_MERGE_SECTION_PARALLELISM,
+                                           impl->read_merge_section_parallelism));
+    }
+    PAIMON_RETURN_NOT_OK(parser.Parse(Options::READ_FILE_LOOKAHEAD, &impl->read_file_lookahead));
+    if (impl->read_file_lookahead < 0) {
+        return Status::Invalid(fmt::format("{} must not be negative, but is {}",
+                                           Options::READ_FILE_LOOKAHEAD,
+                                           impl->read_file_lookahead));
+    }
+    PAIMON_RETURN_NOT_OK(parser.ParseMemorySize(Options::READ_FILE_LOOKAHEAD_MEMORY_BUDGET,
+                                                &impl->read_file_lookahead_memory_budget));
     PAIMON_RETURN_NOT_OK(parser.Parse(Options::WRITE_BATCH_SIZE, &impl->write_batch_size));
     PAIMON_RETURN_NOT_OK(
         parser.ParseMemorySize(Options::WRITE_BUFFER_SIZE, &impl->write_buffer_size));
+    PAIMON_RETURN_NOT_OK(
+        parser.ParseMemorySize(Options::WRITE_BUFFER_TOTAL_SIZE, &impl->write_buffer_total_size));
+    PAIMON_RETURN_NOT_OK(
+        parser.Parse<bool>(Options::WRITE_BUFFER_SPILLABLE, &impl->write_buffer_spillable));
+    PAIMON_RETURN_NOT_OK(parser.ParseMemorySize(Options::WRITE_BUFFER_SPILL_MAX_DISK_SIZE,
+                                                &impl->write_buffer_spill_max_disk_size));
+    PAIMON_RETURN_NOT_OK(
+        parser.ParseString(Options::WRITE_BUFFER_SPILL_DIR, &impl->write_buffer_spill_dir));
+    PAIMON_RETURN_NOT_OK(parser.Parse(Options::LOCAL_SORT_MAX_NUM_FILE_HANDLES,
+                                      &impl->local_sort_max_num_file_handles));
+    if (impl->local_sort_max_num_file_handles < 2) {
+        return Status::Invalid(fmt::format("{} must be greater than 1, but is {}",
+                                           Options::LOCAL_SORT_MAX_NUM_FILE_HANDLES,
+                                           impl->local_sort_max_num_file_handles));
+    }
+    PAIMON_RETURN_NOT_OK(parser.ParseString(Options::SPILL_COMPRESSION, &impl->spill_compression));
+    if (impl->spill_compression != "none" && impl->spill_compression != "lz4" &&
+        impl->spill_compression != "zstd") {
+        return Status::Invalid(fmt::format("invalid {}: {}, only none, lz4 and zstd are supported",
+                                           Options::SPILL_COMPRESSION, impl->spill_compression));
+    }
     PAIMON_RETURN_NOT_OK(parser.Parse(Options::COMMIT_MAX_RETRIES, &impl->commit_max_retries));
     PAIMON_RETURN_NOT_OK(parser.ParseString(Options::FILE_COMPRESSION, &impl->file_compression));
     PAIMON_RETURN_NOT_OK(
@@ -349,6 +410,8 @@ Result<CoreOptions> CoreOptions::FromMap(
                                                 &impl->source_split_open_file_cost));
     PAIMON_RETURN_NOT_OK(parser.ParseMemorySize(Options::MANIFEST_FULL_COMPACTION_FILE_SIZE,
                                                 &impl->manifest_full_compaction_file_size));
+    PAIMON_RETURN_NOT_OK(parser.ParseMemorySize(Options::MANIFEST_CACHE_MAX_MEMORY_SIZE,
+                                                &impl->manifest_cache_max_memory_size));
 
     // Parse file format and file system configurations
     PAIMON_RETURN_NOT_OK(parser.ParseObject<FileFormatFactory>(
@@ -403,6 +466,8 @@ Result<CoreOptions> CoreOptions::FromMap(
     PAIMON_RETURN_NOT_OK(parser.ParseSortOrder(&impl->sequence_field_sort_order));
     // Parse merge and sort engine
     PAIMON_RETURN_NOT_OK(parser.ParseSortEngine(&impl->sort_engine));
+    PAIMON_RETURN_NOT_OK(parser.Parse<bool>(Options::SORT_NORMALIZED_KEY_ENABLED,
+                                            &impl->sort_normalized_key_enabled));
     PAIMON_RETURN_NOT_OK(parser.ParseMergeEngine(&impl->merge_engine));
     // Parse ignore delete
     PAIMON_RETURN_NOT_OK(parser.Parse<bool>(Options::IGNORE_DELETE, &impl->ignore_delete));
@@ -416,6 +481,8 @@ Result<CoreOptions> CoreOptions::FromMap(
     // Parse deletion vectors enabled & force lookup
     PAIMON_RETURN_NOT_OK(
         parser.Parse<bool>(Options::DELETION_VECTORS_ENABLED, &impl->deletion_vectors_enabled));
+    PAIMON_RETURN_NOT_OK(parser.ParseMemorySize(Options::DELETION_VECTORS_CACHE_MAX_MEMORY_SIZE,
+                                                &impl->deletion_vectors_cache_max_memory_size));
     PAIMON_RETURN_NOT_OK(parser.Parse<bool>(Options::FORCE_LOOKUP, &impl->force_lookup));
     // Parse changelog producer
     PAIMON_RETURN_NOT_OK(parser.ParseChangelogProducer(&impl->changelog_producer));
@@ -440,6 +507,9 @@ Result<CoreOptions> CoreOptions::FromMap(
     // Parse file-index.read.enabled
     PAIMON_RETURN_NOT_OK(
         parser.Parse<bool>(Options::FILE_INDEX_READ_ENABLED, &impl->file_index_read_enabled));
+    // Parse file-index.in-manifest-threshold
+    PAIMON_RETURN_NOT_OK(parser.ParseMemorySize(Options::FILE_INDEX_IN_MANIFEST_THRESHOLD,
+                                                &impl->file_index_in_manifest_threshold));
 
     // Parse data-file.external-paths
     std::string data_file_external_paths;
@@ -480,6 +550,60 @@ Result<CoreOptions> CoreOptions::FromMap(
         impl->global_index_external_path = global_index_external_path;
     }
 
+    // Parse compaction configurations of primary key table
+    PAIMON_RETURN_NOT_OK(parser.Parse<bool>(Options::WRITE_ONLY, &impl->write_only));
+    PAIMON_RETURN_NOT_OK(parser.Parse(Options::NUM_SORTED_RUNS_COMPACTION_TRIGGER,
+                                      &impl->num_sorted_runs_compaction_trigger));
+    if (options_map.find(Options::NUM_SORTED_RUNS_STOP_TRIGGER) != options_map.end()) {
+        int32_t stop_trigger = 0;
+        PAIMON_RETURN_NOT_OK(parser.Parse(Options::NUM_SORTED_RUNS_STOP_TRIGGER, &stop_trigger));
+        impl->num_sorted_runs_stop_trigger = stop_trigger;
+    }
+    if (options_map.find(Options::NUM_LEVELS) != options_map.end()) {
+        int32_t num_levels = 0;
+        PAIMON_RETURN_NOT_OK(parser.Parse(Options::NUM_LEVELS, &num_levels));
+        impl->num_levels = num_levels;
+    }
+    PAIMON_RETURN_NOT_OK(parser.Parse(Options::COMPACTION_MAX_SIZE_AMPLIFICATION_PERCENT,
+                                      &impl->compaction_max_size_amplification_percent));
+    PAIMON_RETURN_NOT_OK(
+        parser.Parse(Options::COMPACTION_SIZE_RATIO, &impl->compaction_size_ratio));
+    if (impl->num_sorted_runs_compaction_trigger <= 0) {
+        return Status::Invalid(fmt::format("{} must be greater than 0, but is {}",
+                                           Options::NUM_SORTED_RUNS_COMPACTION_TRIGGER,
+                                           impl->num_sorted_runs_compaction_trigger));
+    }
+    // Parse compaction configurations of append table
+    PAIMON_RETURN_NOT_OK(
+        parser.Parse(Options::COMPACTION_MIN_FILE_NUM, &impl->compaction_min_file_num));
+    PAIMON_RETURN_NOT_OK(
+        parser.Parse(Options::COMPACTION_MAX_FILE_NUM, &impl->compaction_max_file_num));
+    if (options_map.find(Options::COMPACTION_MAX_CONCURRENT_TASKS) != options_map.end()) {
+        int32_t max_concurrent_tasks = 0;
+        PAIMON_RETURN_NOT_OK(
+            parser.Parse(Options::COMPACTION_MAX_CONCURRENT_TASKS, &max_concurrent_tasks));
+        if (max_concurrent_tasks <= 0) {
+            return Status::Invalid(fmt::format("{} must be greater than 0, but is {}",
+                                               Options::COMPACTION_MAX_CONCURRENT_TASKS,
+                                               max_concurrent_tasks));
+        }
+        impl->compaction_max_concurrent_tasks = max_concurrent_tasks;
+    }
+    PAIMON_RETURN_NOT_OK(parser.Parse(Options::WRITE_ROW_TO_BATCH_THREAD_NUMBER,
+                                      &impl->write_row_to_batch_thread_number));
+    if (impl->write_row_to_batch_thread_number <= 0) {
+        return Status::Invalid(fmt::format("{} must be greater than 0, but is {}",
+                                           Options::WRITE_ROW_TO_BATCH_THREAD_NUMBER,
+                                           impl->write_row_to_batch_thread_number));
+    }
+    // in-flight stats are only collected by default for the formats whose stats extractor
+    // reports the same min, max and null count, other formats keep the stats of their files
+    const std::string& format_identifier = impl->file_format->Identifier();
+    impl->write_stats_in_flight_enabled =
+        format_identifier == "orc" || format_identifier == "parquet";
+    PAIMON_RETURN_NOT_OK(parser.Parse<bool>(Options::WRITE_STATS_IN_FLIGHT_ENABLED,
+                                            &impl->write_stats_in_flight_enabled));
+
     return options;
 }
 
@@ -550,6 +674,10 @@ int64_t CoreOptions::GetManifestTargetFileSize() const {
     return impl_->manifest_target_file_size;
 }
 
+int64_t CoreOptions::GetManifestCacheMaxMemorySize() const {
+    return impl_->manifest_cache_max_memory_size;
+}
+
 int32_t CoreOptions::GetManifestMergeMinCount() const {
     return impl_->manifest_merge_min_count;
 }
@@ -576,6 +704,18 @@ int32_t CoreOptions::GetReadBatchSize() const {
     return impl_->read_batch_size;
 }
 
+int32_t CoreOptions::GetReadMergeSectionParallelism() const {
+    return impl_->read_merge_section_parallelism;
+}
+
+int32_t CoreOptions::GetReadFileLookahead() const {
+    return impl_->read_file_lookahead;
+}
+
+int64_t CoreOptions::GetReadFileLookaheadMemoryBudget() const {
+    return impl_->read_file_lookahead_memory_budget;
+}
+
 int32_t CoreOptions::GetWriteBatchSize() const {
     return impl_->write_batch_size;
 }
@@ -584,6 +724,30 @@ int64_t CoreOptions::GetWriteBufferSize() const {
     return impl_->write_buffer_size;
 }
 
+int64_t CoreOptions::GetWriteBufferTotalSize() const {
+    return impl_->write_buffer_total_size;
+}
+
+bool CoreOptions::WriteBufferSpillable() const {
+    return impl_->write_buffer_spillable;
+}
+
+int64_t CoreOptions::GetWriteBufferSpillMaxDiskSize() const {
+    return impl_->write_buffer_spill_max_disk_size;
+}
+
+const std::string& CoreOptions::GetWriteBufferSpillDir() const {
+    return impl_->write_buffer_spill_dir;
+}
+
+int32_t CoreOptions::GetLocalSortMaxNumFileHandles() const {
+    return impl_->local_sort_max_num_file_handles;
+}
+
+const std::string& CoreOptions::GetSpillCompression() const {
+    return impl_->spill_compression;
+}
+
 int64_t CoreOptions::GetCommitTimeout() const {
     return impl_->commit_timeout;
 }
@@ -612,6 +776,10 @@ SortEngine CoreOptions::GetSortEngine() const {
     return impl_->sort_engine;
 }
 
+bool CoreOptions::SortNormalizedKeyEnabled() const {
+    return impl_->sort_normalized_key_enabled;
+}
+
 bool CoreOptions::IgnoreDelete() const {
     return impl_->ignore_delete;
 }
@@ -650,6 +818,10 @@ bool CoreOptions::DeletionVectorsEnabled() const {
     return impl_->deletion_vectors_enabled;
 }
 
+int64_t CoreOptions::GetDeletionVectorsCacheMaxMemorySize() const {
+    return impl_->deletion_vectors_cache_max_memory_size;
+}
+
 ChangelogProducer CoreOptions::GetChangelogProducer() const {
     return impl_->changelog_producer;
 }
@@ -700,6 +872,10 @@ bool CoreOptions::FileIndexReadEnabled() const {
     return impl_->file_index_read_enabled;
 }
 
+int64_t CoreOptions::GetFileIndexInManifestThreshold() const {
+    return impl_->file_index_in_manifest_threshold;
+}
+
 std::optional<std::string> CoreOptions::GetDataFileExternalPaths() const {
     return impl_->data_file_external_paths;
 }
@@ -757,6 +933,61 @@ bool CoreOptions::GlobalIndexEnabled() const {
     return impl_->global_index_enabled;
 }
 
+bool CoreOptions::WriteOnly() const {
+    return impl_->write_only;
+}
+
+int32_t CoreOptions::GetNumSortedRunsCompactionTrigger() const {
+    return impl_->num_sorted_runs_compaction_trigger;
+}
+
+int32_t CoreOptions::GetNumSortedRunsStopTrigger() const {
+    int32_t stop_trigger = impl_->num_sorted_runs_stop_trigger.value_or(
+        impl_->num_sorted_runs_compaction_trigger + 3);
+    return std::max(impl_->num_sorted_runs_compaction_trigger, stop_trigger);
+}
+
+int32_t CoreOptions::GetNumLevels() const {
+    // By default, this ensures that the compaction does not fall to level 0, but at least to
+    // level 1
+    return impl_->num_levels.value_or(impl_->num_sorted_runs_compaction_trigger + 1);
+}
+
+int32_t CoreOptions::GetCompactionMaxSizeAmplificationPercent() const {
+    return impl_->compaction_max_size_amplification_percent;
+}
+
+int32_t CoreOptions::GetCompactionSizeRatio() const {
+    return impl_->compaction_size_ratio;
+}
+
+int32_t CoreOptions::GetCompactionMinFileNum() const {
+    return impl_->compaction_min_file_num;
+}
+
+int32_t CoreOptions::GetCompactionMaxFileNum() const {
+    return impl_->compaction_max_file_num;
+}
+
+std::optional<int32_t> CoreOptions::GetCompactionMaxConcurrentTasks() const {
+    return impl_->compaction_max_concurrent_tasks;
+}
+
+int32_t CoreOptions::GetWriteRowToBatchThreadNumber() const {
+    return impl_->write_row_to_batch_thread_number;
+}
+
+bool CoreOptions::WriteStatsInFlightEnabled() const {
+    return impl_->write_stats_in_flight_enabled;
+}
+
+int64_t CoreOptions::GetCompactionFileSize() const {
+    // file size to join the compaction, we don't process on middle file size to avoid compact a
+    // same file twice (the compression is not calculate so accurately. the output file maybe be
+    // smaller than target file size)
+    return static_cast<int64_t>(impl_->target_file_size * 0.7);
+}
+
 std::optional<std::string> CoreOptions::GetGlobalIndexExternalPath() const {
     return impl_->global_index_external_path;
 }
@@ -70,11 +70,21 @@ class PAIMON_EXPORT CoreOptions {
     std::optional<int64_t> GetScanSnapshotId() const;
 
     int64_t GetManifestTargetFileSize() const;
+    int64_t GetManifestCacheMaxMemorySize() const;
     StartupMode GetStartupMode() const;
 
     int32_t GetReadBatchSize() const;
+    int32_t GetReadMergeSectionParallelism() const;
+    int32_t GetReadFileLookahead() const;
+    int64_t GetReadFileLookaheadMemoryBudget() const;
     int32_t GetWriteBatchSize() const;
     int64_t GetWriteBufferSize() const;
+    int64_t GetWriteBufferTotalSize() const;
+    bool WriteBufferSpillable() const;
+    int64_t GetWriteBufferSpillMaxDiskSize() const;
+    const std::string& GetWriteBufferSpillDir() const;
+    int32_t GetLocalSortMaxNumFileHandles() const;
+    const std::string& GetSpillCompression() const;
 
     const ExpireConfig& GetExpireConfig() const;
 
@@ -85,15 +95,18 @@ class PAIMON_EXPORT CoreOptions {
     bool SequenceFieldSortOrderIsAscending() const;
     MergeEngine GetMergeEngine() const;
     SortEngine GetSortEngine() const;
+    bool SortNormalizedKeyEnabled() const;
     bool IgnoreDelete() const;
 
     std::optional<std::string> GetFieldsDefaultFunc() const;
     Result<std::optional<std::string>> GetFieldAggFunc(const std::string& field_name) const;
     Result<bool> FieldAggIgnoreRetract(const std::string& field_name) const;
     bool DeletionVectorsEnabled() const;
+    int64_t GetDeletionVectorsCacheMaxMemorySize() const;
     ChangelogProducer GetChangelogProducer() const;
     bool NeedLookup() const;
     bool FileIndexReadEnabled() const;
+    int64_t GetFileIndexInManifestThreshold() const;
 
     std::map<std::string, std::string> GetFieldsSequenceGroups() const;
     bool PartialUpdateRemoveRecordOnDelete() const;
@@ -118,6 +131,19 @@ class PAIMON_EXPORT CoreOptions {
     bool GlobalIndexEnabled() const;
     Result<std::optional<std::string>> CreateGlobalIndexExternalPath() const;
 
+    bool WriteOnly() const;
+    int32_t GetNumSortedRunsCompactionTrigger() const;
+    int32_t GetNumSortedRunsStopTrigger() const;
+    int32_t GetNumLevels() const;
+    int32_t GetCompactionMaxSizeAmplificationPercent() const;
+    int32_t GetCompactionSizeRatio() const;
+    int32_t GetCompactionMinFileNum() const;
+    int32_t GetCompactionMaxFileNum() const;
+    std::optional<int32_t> GetCompactionMaxConcurrentTasks() const;
+    int32_t GetWriteRowToBatchThreadNumber() const;
+    bool WriteStatsInFlightEnabled() const;
+    int64_t GetCompactionFileSize() const;
+
     const std::map<std::string, std::string>& ToMap() const;
 
  private:
@@ -48,11 +48,21 @@ TEST(CoreOptionsTest, TestDefaultValue) {
     ASSERT_EQ(8 * 1024 * 1024L, core_options.GetManifestTargetFileSize());
     ASSERT_EQ(16 * 1024 * 1024L, core_options.GetManifestFullCompactionThresholdSize());
     ASSERT_EQ(30, core_options.GetManifestMergeMinCount());
+    ASSERT_EQ(0, core_options.GetManifestCacheMaxMemorySize());
     ASSERT_EQ(128 * 1024 * 1024L, core_options.GetSourceSplitTargetSize());
     ASSERT_EQ(4 * 1024 * 1024L, core_options.GetSourceSplitOpenFileCost());
     ASSERT_EQ(1024, core_options.GetReadBatchSize());
+    ASSERT_EQ(4, core_options.GetReadMergeSectionParallelism());
+    ASSERT_EQ(0, core_options.GetReadFileLookahead());
+    ASSERT_EQ(64 * 1024 * 1024, core_options.GetReadFileLookaheadMemoryBudget());
     ASSERT_EQ(1024, core_options.GetWriteBatchSize());
     ASSERT_EQ(256 * 1024 * 1024, core_options.GetWriteBufferSize());
+    ASSERT_EQ(0, core_options.GetWriteBufferTotalSize());
+    ASSERT_FALSE(core_options.WriteBufferSpillable());
+    ASSERT_EQ(std::numeric_limits<int64_t>::max(), core_options.GetWriteBufferSpillMaxDiskSize());
+    ASSERT_EQ("", core_options.GetWriteBufferSpillDir());
+    ASSERT_EQ(128, core_options.GetLocalSortMaxNumFileHandles());
+    ASSERT_EQ("zstd", core_options.GetSpillCompression());
     ASSERT_EQ(std::numeric_limits<int64_t>::max(), core_options.GetCommitTimeout());
     ASSERT_EQ(10, core_options.GetCommitMaxRetries());
     ExpireConfig expire_config = core_options.GetExpireConfig();
@@ -65,11 +75,13 @@ TEST(CoreOptionsTest, TestDefaultValue) {
     ASSERT_TRUE(core_options.SequenceFieldSortOrderIsAscending());
     ASSERT_EQ(MergeEngine::DEDUPLICATE, core_options.GetMergeEngine());
     ASSERT_EQ(SortEngine::LOSER_TREE, core_options.GetSortEngine());
+    ASSERT_TRUE(core_options.SortNormalizedKeyEnabled());
     ASSERT_FALSE(core_options.IgnoreDelete());
     ASSERT_EQ(std::nullopt, core_options.GetFieldsDefaultFunc());
     ASSERT_EQ(std::nullopt, core_options.GetFieldAggFunc("f0").value());
     ASSERT_FALSE(core_options.FieldAggIgnoreRetract("f1").value());
     ASSERT_FALSE(core_options.DeletionVectorsEnabled());
+    ASSERT_EQ(0, core_options.GetDeletionVectorsCacheMaxMemorySize());
     ASSERT_EQ(ChangelogProducer::NONE, core_options.GetChangelogProducer());
     ASSERT_FALSE(core_options.NeedLookup());
     ASSERT_TRUE(core_options.GetFieldsSequenceGroups().empty());
@@ -78,6 +90,7 @@ TEST(CoreOptionsTest, TestDefaultValue) {
     ASSERT_EQ(std::nullopt, core_options.GetScanFallbackBranch());
     ASSERT_EQ("main", core_options.GetBranch());
     ASSERT_TRUE(core_options.FileIndexReadEnabled());
+    ASSERT_EQ(500, core_options.GetFileIndexInManifestThreshold());
     ASSERT_EQ(std::nullopt, core_options.GetDataFileExternalPaths());
     ASSERT_EQ(ExternalPathStrategy::NONE, core_options.GetExternalPathStrategy());
     ASSERT_TRUE(core_options.EnableAdaptivePrefetchStrategy());
@@ -88,6 +101,17 @@ TEST(CoreOptionsTest, TestDefaultValue) {
     ASSERT_TRUE(core_options.LegacyPartitionNameEnabled());
     ASSERT_TRUE(core_options.GlobalIndexEnabled());
     ASSERT_FALSE(core_options.GetGlobalIndexExternalPath());
+    ASSERT_FALSE(core_options.WriteOnly());
+    ASSERT_EQ(5, core_options.GetNumSortedRunsCompactionTrigger());
+    ASSERT_EQ(8, core_options.GetNumSortedRunsStopTrigger());
+    ASSERT_EQ(6, core_options.GetNumLevels());
+    ASSERT_EQ(200, core_options.GetCompactionMaxSizeAmplificationPercent());
+    ASSERT_EQ(1, core_options.GetCompactionSizeRatio());
+    ASSERT_EQ(5, core_options.GetCompactionMinFileNum());
+    ASSERT_EQ(50, core_options.GetCompactionMaxFileNum());
+    ASSERT_EQ(std::nullopt, core_options.GetCompactionMaxConcurrentTasks());
+    ASSERT_EQ(1, core_options.GetWriteRowToBatchThreadNumber());
+    ASSERT_TRUE(core_options.WriteStatsInFlightEnabled());
 }
 
 TEST(CoreOptionsTest, TestFromMap) {
@@ -103,10 +127,20 @@ TEST(CoreOptionsTest, TestFromMap) {
         {Options::MANIFEST_TARGET_FILE_SIZE, "16MB"},
         {Options::MANIFEST_FULL_COMPACTION_FILE_SIZE, "32MB"},
         {Options::MANIFEST_MERGE_MIN_COUNT, "2"},
+        {Options::MANIFEST_CACHE_MAX_MEMORY_SIZE, "64MB"},
         {Options::SOURCE_SPLIT_TARGET_SIZE, "24MB"},
         {Options::SOURCE_SPLIT_OPEN_FILE_COST, "32MB"},
         {Options::READ_BATCH_SIZE, "2048"},
+        {Options::READ_MERGE_SECTION_PARALLELISM, "8"},
+        {Options::READ_FILE_LOOKAHEAD, "3"},
+        {Options::READ_FILE_LOOKAHEAD_MEMORY_BUDGET, "16MB"},
         {Options::WRITE_BUFFER_SIZE, "16MB"},
+        {Options::WRITE_BUFFER_TOTAL_SIZE, "128MB"},
+        {Options::WRITE_BUFFER_SPILLABLE, "true"},
+        {Options::WRITE_BUFFER_SPILL_MAX_DISK_SIZE, "1GB"},
+        {Options::WRITE_BUFFER_SPILL_DIR, "/tmp/spill"},
+        {Options::LOCAL_SORT_MAX_NUM_FILE_HANDLES, "16"},
+        {Options::SPILL_COMPRESSION, "lz4"},
         {Options::WRITE_BATCH_SIZE, "1234"},
         {Options::COMMIT_TIMEOUT, "120s"},
         {Options::COMMIT_MAX_RETRIES, "20"},
@@ -120,11 +154,13 @@ TEST(CoreOptionsTest, TestFromMap) {
         {Options::SEQUENCE_FIELD_SORT_ORDER, "descending"},
         {Options::MERGE_ENGINE, "partial-update"},
         {Options::SORT_ENGINE, "min-heap"},
+        {Options::SORT_NORMALIZED_KEY_ENABLED, "false"},
         {Options::IGNORE_DELETE, "true"},
         {Options::FIELDS_DEFAULT_AGG_FUNC, "sum"},
         {"fields.f0.aggregate-function", "min"},
         {"fields.f1.ignore-retract", "true"},
         {Options::DELETION_VECTORS_ENABLED, "true"},
+        {Options::DELETION_VECTORS_CACHE_MAX_MEMORY_SIZE, "32MB"},
         {Options::CHANGELOG_PRODUCER, "full-compaction"},
         {Options::FORCE_LOOKUP, "true"},
         {"fields.g_1,g_3.sequence-group", "c,d"},
@@ -133,6 +169,7 @@ TEST(CoreOptionsTest, TestFromMap) {
         {Options::SCAN_FALLBACK_BRANCH, "fallback"},
         {Options::BRANCH, "rt"},
         {Options::FILE_INDEX_READ_ENABLED, "false"},
+        {Options::FILE_INDEX_IN_MANIFEST_THRESHOLD, "1 kb"},
         {Options::DATA_FILE_EXTERNAL_PATHS, "FILE:///tmp/index"},
         {Options::DATA_FILE_EXTERNAL_PATHS_STRATEGY, "round-robin"},
         {Options::FILE_COMPRESSION, "snappy"},
@@ -146,6 +183,17 @@ TEST(CoreOptionsTest, TestFromMap) {
         {Options::PARTITION_GENERATE_LEGACY_NAME, "false"},
         {Options::GLOBAL_INDEX_ENABLED, "false"},
         {Options::GLOBAL_INDEX_EXTERNAL_PATH, "FILE:///tmp/global_index/"},
+        {Options::WRITE_ONLY, "true"},
+        {Options::NUM_SORTED_RUNS_COMPACTION_TRIGGER, "3"},
+        {Options::NUM_SORTED_RUNS_STOP_TRIGGER, "10"},
+        {Options::NUM_LEVELS, "4"},
+        {Options::COMPACTION_MAX_SIZE_AMPLIFICATION_PERCENT, "300"},
+        {Options::COMPACTION_SIZE_RATIO, "5"},
+        {Options::COMPACTION_MIN_FILE_NUM, "8"},
+        {Options::COMPACTION_MAX_FILE_NUM, "40"},
+        {Options::COMPACTION_MAX_CONCURRENT_TASKS, "2"},
+        {Options::WRITE_ROW_TO_BATCH_THREAD_NUMBER, "4"},
+        {Options::WRITE_STATS_IN_FLIGHT_ENABLED, "false"},
     };
 
     ASSERT_OK_AND_ASSIGN(CoreOptions core_options, CoreOptions::FromMap(options));
@@ -166,11 +214,21 @@ TEST(CoreOptionsTest, TestFromMap) {
     ASSERT_EQ(16 * 1024 * 1024L, core_options.GetManifestTargetFileSize());
     ASSERT_EQ(32 * 1024 * 1024L, core_options.GetManifestFullCompactionThresholdSize());
     ASSERT_EQ(2, core_options.GetManifestMergeMinCount());
+    ASSERT_EQ(64 * 1024 * 1024L, core_options.GetManifestCacheMaxMemorySize());
     ASSERT_EQ(24 * 1024 * 1024L, core_options.GetSourceSplitTargetSize());
     ASSERT_EQ(32 * 1024 * 1024L, core_options.GetSourceSplitOpenFileCost());
     ASSERT_EQ(2048, core_options.GetReadBatchSize());
+    ASSERT_EQ(8, core_options.GetReadMergeSectionParallelism());
+    ASSERT_EQ(3, core_options.GetReadFileLookahead());
+    ASSERT_EQ(16 * 1024 * 1024, core_options.GetReadFileLookaheadMemoryBudget());
     ASSERT_EQ(1234, core_options.GetWriteBatchSize());
     ASSERT_EQ(16 * 1024 * 1024, core_options.GetWriteBufferSize());
+    ASSERT_EQ(128 * 1024 * 1024, core_options.GetWriteBufferTotalSize());
+    ASSERT_TRUE(core_options.WriteBufferSpillable());
+    ASSERT_EQ(1024 * 1024 * 1024, core_options.GetWriteBufferSpillMaxDiskSize());
+    ASSERT_EQ("/tmp/spill", core_options.GetWriteBufferSpillDir());
+    ASSERT_EQ(16, core_options.GetLocalSortMaxNumFileHandles());
+    ASSERT_EQ("lz4", core_options.GetSpillCompression());
     ASSERT_EQ(120 * 1000, core_options.GetCommitTimeout());
     ASSERT_EQ(20, core_options.GetCommitMaxRetries());
     ASSERT_EQ(5, core_options.GetScanSnapshotId().value_or(-1));
@@ -184,12 +242,14 @@ TEST(CoreOptionsTest, TestFromMap) {
     ASSERT_FALSE(core_options.SequenceFieldSortOrderIsAscending());
     ASSERT_EQ(MergeEngine::PARTIAL_UPDATE, core_options.GetMergeEngine());
     ASSERT_EQ(SortEngine::MIN_HEAP, core_options.GetSortEngine());
+    ASSERT_FALSE(core_options.SortNormalizedKeyEnabled());
     ASSERT_TRUE(core_options.IgnoreDelete());
     ASSERT_EQ("sum", core_options.GetFieldsDefaultFunc().value());
     ASSERT_EQ("min", core_options.GetFieldAggFunc("f0").value().value());
     ASSERT_TRUE(core_options.FieldAggIgnoreRetract("f1").value());
     ASSERT_TRUE(core_options.FieldAggIgnoreRetract("f1").value());
     ASSERT_TRUE(core_options.DeletionVectorsEnabled());
+    ASSERT_EQ(32 * 1024 * 1024L, core_options.GetDeletionVectorsCacheMaxMemorySize());
     ASSERT_EQ(ChangelogProducer::FULL_COMPACTION, core_options.GetChangelogProducer());
     ASSERT_TRUE(core_options.NeedLookup());
     std::map<std::string, std::string> seq_grp;
@@ -201,6 +261,7 @@ TEST(CoreOptionsTest, TestFromMap) {
     ASSERT_EQ(core_options.GetScanFallbackBranch(), std::optional<std::string>("fallback"));
     ASSERT_EQ(core_options.GetBranch(), "rt");
     ASSERT_FALSE(core_options.FileIndexReadEnabled());
+    ASSERT_EQ(1024, core_options.GetFileIndexInManifestThreshold());
     ASSERT_EQ(core_options.GetDataFileExternalPaths(),
               std::optional<std::string>("FILE:///tmp/index"));
     ASSERT_EQ(core_options.GetExternalPathStrategy(), ExternalPathStrategy::ROUND_ROBIN);
@@ -216,6 +277,32 @@ TEST(CoreOptionsTest, TestFromMap) {
     ASSERT_FALSE(core_options.GlobalIndexEnabled());
     ASSERT_TRUE(core_options.GetGlobalIndexExternalPath());
     ASSERT_EQ(core_options.GetGlobalIndexExternalPath().value(), "FILE:///tmp/global_index/");
+    ASSERT_TRUE(core_options.WriteOnly());
+    ASSERT_EQ(3, core_options.GetNumSortedRunsCompactionTrigger());
+    ASSERT_EQ(10, core_options.GetNumSortedRunsStopTrigger());
+    ASSERT_EQ(4, core_options.GetNumLevels());
+    ASSERT_EQ(300, core_options.GetCompactionMaxSizeAmplificationPercent());
+    ASSERT_EQ(5, core_options.GetCompactionSizeRatio());
+    ASSERT_EQ(8, core_options.GetCompactionMinFileNum());
+    ASSERT_EQ(40, core_options.GetCompactionMaxFileNum());
+    ASSERT_EQ(2, core_options.GetCompactionMaxConcurrentTasks());
+    ASSERT_EQ(4, core_options.GetWriteRowToBatchThreadNumber());
+    ASSERT_FALSE(core_options.WriteStatsInFlightEnabled());
+}
+
+TEST(CoreOptionsTest, TestStatsInFlightDefaultPerFormat) {
+    for (const auto& format : {"parquet", "orc"}) {
+        ASSERT_OK_AND_ASSIGN(CoreOptions core_options,
+                             CoreOptions::FromMap({{Options::FILE_FORMAT, format}}));
+        ASSERT_TRUE(core_options.WriteStatsInFlightEnabled()) << format;
+    }
+    ASSERT_OK_AND_ASSIGN(CoreOptions mock_options,
+                         CoreOptions::FromMap({{Options::FILE_FORMAT, "mock_format"}}));
+    ASSERT_FALSE(mock_options.WriteStatsInFlightEnabled());
+    ASSERT_OK_AND_ASSIGN(mock_options,
+                         CoreOptions::FromMap({{Options::FILE_FORMAT, "mock_format"},
+                                               {Options::WRITE_STATS_IN_FLIGHT_ENABLED, "true"}}));
+    ASSERT_TRUE(mock_options.WriteStatsInFlightEnabled());
 }
 
 TEST(CoreOptionsTest, TestInvalidCase) {
@@ -231,6 +318,14 @@ TEST(CoreOptionsTest, TestInvalidCase) {
                         "invalid merge engine: invalid");
     ASSERT_NOK_WITH_MSG(CoreOptions::FromMap({{Options::CHANGELOG_PRODUCER, "invalid"}}),
                         "invalid changelog producer: invalid");
+    ASSERT_NOK_WITH_MSG(CoreOptions::FromMap({{Options::READ_MERGE_SECTION_PARALLELISM, "0"}}),
+                        "read.merge.section-parallelism must be greater than 0");
+    ASSERT_NOK_WITH_MSG(CoreOptions::FromMap({{Options::READ_FILE_LOOKAHEAD, "-1"}}),
+                        "read.file-lookahead must not be negative");
+    ASSERT_NOK_WITH_MSG(CoreOptions::FromMap({{Options::LOCAL_SORT_MAX_NUM_FILE_HANDLES, "1"}}),
+                        "local-sort.max-num-file-handles must be greater than 1");
+    ASSERT_NOK_WITH_MSG(CoreOptions::FromMap({{Options::SPILL_COMPRESSION, "snappy"}}),
+                        "invalid spill-compression: snappy");
 }
 
 TEST(CoreOptionsTest, TestCreateExternalPath) {
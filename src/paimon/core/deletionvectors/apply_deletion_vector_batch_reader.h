@@ -38,7 +38,7 @@ class Metrics;
 class ApplyDeletionVectorBatchReader : public BatchReader {
  public:
     ApplyDeletionVectorBatchReader(std::unique_ptr<FileBatchReader>&& reader,
-                                   PAIMON_UNIQUE_PTR<DeletionVector>&& deletion_vector)
+                                   std::shared_ptr<const DeletionVector>&& deletion_vector)
         : reader_(std::move(reader)), deletion_vector_(std::move(deletion_vector)) {
         assert(reader_);
     }
@@ -81,6 +81,6 @@ class ApplyDeletionVectorBatchReader : public BatchReader {
 
  private:
     std::unique_ptr<FileBatchReader> reader_;
-    PAIMON_UNIQUE_PTR<DeletionVector> deletion_vector_;
+    std::shared_ptr<const DeletionVector> deletion_vector_;
 };
 }  // namespace paimon
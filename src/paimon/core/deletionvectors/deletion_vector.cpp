@@ -20,6 +20,7 @@
 #include <string>
 
 #include "fmt/format.h"
+#include "paimon/common/io/zero_copy_input_stream.h"
 #include "paimon/core/deletionvectors/bitmap_deletion_vector.h"
 #include "paimon/core/table/source/deletion_file.h"
 #include "paimon/fs/file_system.h"
@@ -46,6 +47,15 @@ Result<PAIMON_UNIQUE_PTR<DeletionVector>> DeletionVector::Read(const FileSystem*
             fmt::format("Size not match, actual size: {}, expect size: {}, , file path: {}",
                         actual_length, deletion_file.length, deletion_file.path));
     }
+    if (auto* zero_copy_input = ZeroCopyInputStream::From(input.get())) {
+        // deserialize straight from the mapping of the index file, skipping the length field
+        PAIMON_ASSIGN_OR_RAISE(std::shared_ptr<Bytes> view,
+                               zero_copy_input->ReadView(deletion_file.length,
+                                                         deletion_file.offset + sizeof(int32_t)));
+        if (view) {
+            return DeserializeFromBytes(view.get(), pool);
+        }
+    }
     auto bytes = Bytes::AllocateBytes(deletion_file.length, pool);
     PAIMON_RETURN_NOT_OK(file_input_stream.ReadBytes(bytes.get()));
     return DeserializeFromBytes(bytes.get(), pool);
@@ -0,0 +1,182 @@
+/*
+ * Copyright 2024-present Alibaba Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "paimon/core/deletionvectors/deletion_vector_loader.h"
+
+#include <algorithm>
+#include <limits>
+#include <map>
+#include <utility>
+
+#include "fmt/format.h"
+#include "paimon/common/io/cache/cache.h"
+#include "paimon/common/io/cache/cache_key.h"
+#include "paimon/common/io/cache/lru_cache.h"
+#include "paimon/common/io/zero_copy_input_stream.h"
+#include "paimon/core/deletionvectors/bitmap_deletion_vector.h"
+#include "paimon/core/utils/objects_cache.h"
+#include "paimon/fs/file_system.h"
+#include "paimon/io/byte_array_input_stream.h"
+#include "paimon/io/data_input_stream.h"
+#include "paimon/memory/bytes.h"
+#include "paimon/memory/memory_pool.h"
+
+namespace paimon {
+
+namespace {
+/// A decoded deletion vector, charged to the cache by its serialized size.
+class DeletionVectorCacheValue : public CacheValue {
+ public:
+    DeletionVectorCacheValue(const std::shared_ptr<const DeletionVector>& deletion_vector,
+                             int64_t weight)
+        : CacheValue(/*segment=*/nullptr), deletion_vector_(deletion_vector), weight_(weight) {}
+
+    const std::shared_ptr<const DeletionVector>& GetDeletionVector() const {
+        return deletion_vector_;
+    }
+
+    int64_t Weight() const override {
+        return weight_;
+    }
+
+ private:
+    std::shared_ptr<const DeletionVector> deletion_vector_;
+    int64_t weight_;
+};
+
+std::shared_ptr<CacheKey> ToCacheKey(const DeletionFile& deletion_file) {
+    return CacheKey::ForPosition(deletion_file.path, deletion_file.offset,
+                                 static_cast<int32_t>(deletion_file.length), /*is_index=*/true);
+}
+
+/// End of a deletion vector in its index file, including the length field.
+int64_t EndOf(const DeletionFile& deletion_file) {
+    return deletion_file.offset + static_cast<int64_t>(sizeof(int32_t)) + deletion_file.length;
+}
+}  // namespace
+
+DeletionVectorLoader::DeletionVectorLoader(const std::shared_ptr<FileSystem>& file_system,
+                                           const std::shared_ptr<Cache>& cache,
+                                           const std::shared_ptr<MemoryPool>& pool)
+    : file_system_(file_system), cache_(cache), pool_(pool) {}
+
+std::shared_ptr<Cache> DeletionVectorLoader::GetGlobalCache(int64_t max_memory_size) {
+    if (max_memory_size <= 0) {
+        return nullptr;
+    }
+    // one cache for the whole process, so that the memory of deletion vectors stays bounded by a
+    // single budget however many tables are read
+    static std::shared_ptr<Cache> global_cache = std::make_shared<LruCache>(max_memory_size);
+    return global_cache;
+}
+
+Result<DeletionVectorMap> DeletionVectorLoader::Load(
+    const std::unordered_map<std::string, DeletionFile>& deletion_files) const {
+    DeletionVectorMap deletion_vectors;
+    // ordered by path, so that index files are read in a stable order
+    std::map<std::string, std::vector<LoadRequest>> requests_by_path;
+    for (const auto& [data_file_name, deletion_file] : deletion_files) {
+        if (cache_) {
+            auto value = cache_->Get(ToCacheKey(deletion_file),
+                                     [](const std::shared_ptr<CacheKey>&) { return nullptr; });
+            if (auto cached = std::dynamic_pointer_cast<DeletionVectorCacheValue>(value)) {
+                deletion_vectors.emplace(data_file_name, cached->GetDeletionVector());
+                continue;
+            }
+        }
+        requests_by_path[deletion_file.path].push_back({&data_file_name, &deletion_file});
+    }
+    for (auto& [path, requests] : requests_by_path) {
+        PAIMON_RETURN_NOT_OK(LoadIndexFile(path, &requests, &deletion_vectors));
+    }
+    return deletion_vectors;
+}
+
+Status DeletionVectorLoader::LoadIndexFile(const std::string& path,
+                                           std::vector<LoadRequest>* requests,
+                                           DeletionVectorMap* deletion_vectors) const {
+    std::sort(requests->begin(), requests->end(),
+              [](const LoadRequest& lhs, const LoadRequest& rhs) {
+                  return lhs.deletion_file->offset < rhs.deletion_file->offset;
+              });
+    PAIMON_ASSIGN_OR_RAISE(std::shared_ptr<InputStream> input, file_system_->Open(path));
+    auto* zero_copy_input = ZeroCopyInputStream::From(input.get());
+    size_t begin = 0;
+    while (begin < requests->size()) {
+        int64_t range_start = (*requests)[begin].deletion_file->offset;
+        int64_t range_end = EndOf(*(*requests)[begin].deletion_file);
+        size_t end = begin + 1;
+        for (; end < requests->size(); end++) {
+            const DeletionFile& next = *(*requests)[end].deletion_file;
+            int64_t next_end = std::max(range_end, EndOf(next));
+            if (next.offset - range_end > MAX_COALESCE_GAP ||
+                next_end - range_start > std::numeric_limits<int32_t>::max()) {
+                break;
+            }
+            range_end = next_end;
+        }
+        auto range_length = static_cast<uint32_t>(range_end - range_start);
+        std::shared_ptr<Bytes> range;
+        if (zero_copy_input) {
+            PAIMON_ASSIGN_OR_RAISE(range, zero_copy_input->ReadView(range_length, range_start));
+        }
+        if (!range) {
+            range = Bytes::AllocateBytes(range_length, pool_.get());
+            PAIMON_ASSIGN_OR_RAISE(int32_t read_length,
+                                   input->Read(range->data(), range_length, range_start));
+            if (static_cast<uint32_t>(read_length) != range_length) {
+                return Status::IOError(
+                    fmt::format("read {} bytes at offset {} of deletion vector index file {}, "
+                                "expect {} bytes",
+                                read_length, range_start, path, range_length));
+            }
+        }
+        for (size_t i = begin; i < end; i++) {
+            const LoadRequest& request = (*requests)[i];
+            PAIMON_ASSIGN_OR_RAISE(
+                std::shared_ptr<const DeletionVector> deletion_vector,
+                Decode(*request.deletion_file,
+                       range->data() + (request.deletion_file->offset - range_start)));
+            deletion_vectors->emplace(*request.data_file_name, deletion_vector);
+        }
+        begin = end;
+    }
+    return input->Close();
+}
+
+Result<std::shared_ptr<const DeletionVector>> DeletionVectorLoader::Decode(
+    const DeletionFile& deletion_file, const char* data) const {
+    auto in = std::make_shared<ByteArrayInputStream>(data, sizeof(int32_t));
+    DataInputStream input(in);
+    PAIMON_ASSIGN_OR_RAISE(int32_t actual_length, input.ReadValue<int32_t>());
+    if (actual_length != deletion_file.length) {
+        return Status::Invalid(
+            fmt::format("Size not match, actual size: {}, expect size: {}, , file path: {}",
+                        actual_length, deletion_file.length, deletion_file.path));
+    }
+    // cached deletion vectors outlive the pool of any reader
+    MemoryPool* pool = cache_ ? ObjectsCache::GetPool().get() : pool_.get();
+    PAIMON_ASSIGN_OR_RAISE(
+        std::shared_ptr<const DeletionVector> deletion_vector,
+        BitmapDeletionVector::Deserialize(data + sizeof(int32_t), actual_length, pool));
+    if (cache_) {
+        cache_->Put(ToCacheKey(deletion_file), std::make_shared<DeletionVectorCacheValue>(
+                                                   deletion_vector, deletion_file.length));
+    }
+    return deletion_vector;
+}
+
+}  // namespace paimon
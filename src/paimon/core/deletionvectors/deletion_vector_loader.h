@@ -0,0 +1,84 @@
+/*
+ * Copyright 2024-present Alibaba Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "paimon/core/deletionvectors/deletion_vector.h"
+#include "paimon/core/table/source/deletion_file.h"
+#include "paimon/result.h"
+#include "paimon/status.h"
+
+namespace paimon {
+class Cache;
+class FileSystem;
+class MemoryPool;
+
+/// Deletion vectors keyed by data file name.
+using DeletionVectorMap = std::unordered_map<std::string, std::shared_ptr<const DeletionVector>>;
+
+/// Loads the deletion vectors of the data files of a split. Deletion vectors are grouped by
+/// index file, and nearby deletion vectors of one index file are fetched with one ranged read,
+/// instead of opening the index file and seeking once per data file.
+///
+/// Deletion vector index files are never modified once written, so decoded deletion vectors can
+/// be cached by (path, offset) and shared by all readers of the process.
+class DeletionVectorLoader {
+ public:
+    /// Deletion vectors of one index file closer than this are fetched by the same read, the gap
+    /// is read and dropped.
+    static constexpr int64_t MAX_COALESCE_GAP = 512 * 1024;
+
+    /// @param cache Cache of decoded deletion vectors, nullptr disables caching.
+    DeletionVectorLoader(const std::shared_ptr<FileSystem>& file_system,
+                         const std::shared_ptr<Cache>& cache,
+                         const std::shared_ptr<MemoryPool>& pool);
+
+    /// @param deletion_files Deletion files keyed by data file name.
+    Result<DeletionVectorMap> Load(
+        const std::unordered_map<std::string, DeletionFile>& deletion_files) const;
+
+    /// @return the process-wide cache of deletion vectors, or nullptr if `max_memory_size` is not
+    /// positive. The cache is shared by all tables and bounded by the `max_memory_size` of the
+    /// first call creating it, later sizes are ignored.
+    static std::shared_ptr<Cache> GetGlobalCache(int64_t max_memory_size);
+
+ private:
+    struct LoadRequest {
+        const std::string* data_file_name;
+        const DeletionFile* deletion_file;
+    };
+
+    /// Loads `requests` which all point to index file `path`.
+    Status LoadIndexFile(const std::string& path, std::vector<LoadRequest>* requests,
+                         DeletionVectorMap* deletion_vectors) const;
+
+    /// Decodes the deletion vector at the start of `data`, which begins with the length field.
+    Result<std::shared_ptr<const DeletionVector>> Decode(const DeletionFile& deletion_file,
+                                                         const char* data) const;
+
+ private:
+    std::shared_ptr<FileSystem> file_system_;
+    std::shared_ptr<Cache> cache_;
+    std::shared_ptr<MemoryPool> pool_;
+};
+
+}  // namespace paimon
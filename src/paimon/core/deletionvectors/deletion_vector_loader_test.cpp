@@ -0,0 +1,150 @@
+/*
+ * Copyright 2024-present Alibaba Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "paimon/core/deletionvectors/deletion_vector_loader.h"
+
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "paimon/common/io/cache/lru_cache.h"
+#include "paimon/core/deletionvectors/bitmap_deletion_vector.h"
+#include "paimon/fs/file_system.h"
+#include "paimon/memory/memory_pool.h"
+#include "paimon/testing/utils/testharness.h"
+
+namespace paimon::test {
+class DeletionVectorLoaderTest : public ::testing::Test {
+ public:
+    void SetUp() override {
+        dir_ = UniqueTestDirectory::Create();
+        fs_ = dir_->GetFileSystem();
+        pool_ = GetDefaultPool();
+    }
+
+    /// Writes `deleted_rows` as deletion vectors into one index file, each one preceded by
+    /// `padding` bytes, and returns the deletion files keyed by `file_prefix` + index.
+    std::unordered_map<std::string, DeletionFile> WriteIndexFile(
+        const std::string& path, const std::vector<std::vector<int32_t>>& deleted_rows,
+        int64_t padding, const std::string& file_prefix) const {
+        std::string content;
+        std::unordered_map<std::string, DeletionFile> deletion_files;
+        for (size_t i = 0; i < deleted_rows.size(); i++) {
+            content.append(padding, '\0');
+            BitmapDeletionVector deletion_vector(RoaringBitmap32::From(deleted_rows[i]));
+            auto bytes = deletion_vector.SerializeToBytes(pool_).value();
+            auto length = static_cast<int32_t>(bytes->size());
+            int64_t offset = content.size();
+            // length field is big endian
+            for (int32_t shift = 24; shift >= 0; shift -= 8) {
+                content.push_back(static_cast<char>((length >> shift) & 0xff));
+            }
+            content.append(bytes->data(), bytes->size());
+            deletion_files.emplace(file_prefix + std::to_string(i),
+                                   DeletionFile(path, offset, length, deleted_rows[i].size()));
+        }
+        EXPECT_OK(fs_->WriteFile(path, content, /*overwrite=*/true));
+        return deletion_files;
+    }
+
+    void CheckDeletionVectors(const DeletionVectorMap& deletion_vectors,
+                              const std::map<std::string, std::vector<int32_t>>& expected) const {
+        ASSERT_EQ(deletion_vectors.size(), expected.size());
+        for (const auto& [data_file_name, deleted_rows] : expected) {
+            auto iter = deletion_vectors.find(data_file_name);
+            ASSERT_TRUE(iter != deletion_vectors.end()) << data_file_name;
+            auto* bitmap_dv = dynamic_cast<const BitmapDeletionVector*>(iter->second.get());
+            ASSERT_TRUE(bitmap_dv);
+            ASSERT_EQ(*bitmap_dv->GetBitmap(), RoaringBitmap32::From(deleted_rows));
+        }
+    }
+
+ protected:
+    std::unique_ptr<UniqueTestDirectory> dir_;
+    std::shared_ptr<FileSystem> fs_;
+    std::shared_ptr<MemoryPool> pool_;
+};
+
+TEST_F(DeletionVectorLoaderTest, TestLoadFromSeveralIndexFiles) {
+    std::vector<std::vector<int32_t>> rows1 = {{0, 1, 2}, {5}, {3, 100, 100000}};
+    std::vector<std::vector<int32_t>> rows2 = {{7, 8}, {9}};
+    auto deletion_files = WriteIndexFile(dir_->Str() + "/index-1", rows1, /*padding=*/0, "a-");
+    // the second deletion vector of index-2 is too far away to be coalesced with the first one
+    auto deletion_files2 =
+        WriteIndexFile(dir_->Str() + "/index-2", rows2,
+                       /*padding=*/DeletionVectorLoader::MAX_COALESCE_GAP + 10, "b-");
+    deletion_files.insert(deletion_files2.begin(), deletion_files2.end());
+
+    DeletionVectorLoader loader(fs_, /*cache=*/nullptr, pool_);
+    ASSERT_OK_AND_ASSIGN(DeletionVectorMap deletion_vectors, loader.Load(deletion_files));
+    CheckDeletionVectors(deletion_vectors, {{"a-0", rows1[0]},
+                                            {"a-1", rows1[1]},
+                                            {"a-2", rows1[2]},
+                                            {"b-0", rows2[0]},
+                                            {"b-1", rows2[1]}});
+
+    ASSERT_OK_AND_ASSIGN(DeletionVectorMap empty, loader.Load({}));
+    ASSERT_TRUE(empty.empty());
+}
+
+TEST_F(DeletionVectorLoaderTest, TestLoadThroughCache) {
+    std::vector<std::vector<int32_t>> rows = {{1, 3}, {2, 4, 6}};
+    std::string path = dir_->Str() + "/index-1";
+    auto deletion_files = WriteIndexFile(path, rows, /*padding=*/16, "a-");
+
+    auto cache = std::make_shared<LruCache>(/*capacity=*/1024 * 1024);
+    DeletionVectorLoader loader(fs_, cache, pool_);
+    ASSERT_OK_AND_ASSIGN(DeletionVectorMap first, loader.Load(deletion_files));
+    CheckDeletionVectors(first, {{"a-0", rows[0]}, {"a-1", rows[1]}});
+
+    // cached deletion vectors are served without touching the index file
+    ASSERT_OK(fs_->Delete(path));
+    ASSERT_OK_AND_ASSIGN(DeletionVectorMap second, loader.Load(deletion_files));
+    ASSERT_EQ(first.at("a-0").get(), second.at("a-0").get());
+    ASSERT_EQ(first.at("a-1").get(), second.at("a-1").get());
+
+    // without cache the index file is read again
+    DeletionVectorLoader no_cache_loader(fs_, /*cache=*/nullptr, pool_);
+    ASSERT_NOK(no_cache_loader.Load(deletion_files));
+}
+
+TEST_F(DeletionVectorLoaderTest, TestGlobalCache) {
+    ASSERT_FALSE(DeletionVectorLoader::GetGlobalCache(0));
+    ASSERT_FALSE(DeletionVectorLoader::GetGlobalCache(-1));
+    auto cache = DeletionVectorLoader::GetGlobalCache(1024 * 1024);
+    ASSERT_TRUE(cache);
+    int64_t capacity = std::dynamic_pointer_cast<LruCache>(cache)->Capacity();
+    ASSERT_GT(capacity, 0);
+    ASSERT_EQ(cache, DeletionVectorLoader::GetGlobalCache(1024 * 1024));
+    // tables configured with other sizes share the same cache, which keeps its size
+    ASSERT_EQ(cache, DeletionVectorLoader::GetGlobalCache(2 * 1024 * 1024));
+    ASSERT_EQ(capacity, std::dynamic_pointer_cast<LruCache>(cache)->Capacity());
+}
+
+TEST_F(DeletionVectorLoaderTest, TestLengthNotMatch) {
+    std::vector<std::vector<int32_t>> rows = {{1, 3}};
+    auto deletion_files = WriteIndexFile(dir_->Str() + "/index-1", rows, /*padding=*/0, "a-");
+    DeletionFile& deletion_file = deletion_files.at("a-0");
+    deletion_file = DeletionFile(deletion_file.path, deletion_file.offset,
+                                 deletion_file.length - 1, deletion_file.cardinality);
+    DeletionVectorLoader loader(fs_, /*cache=*/nullptr, pool_);
+    ASSERT_NOK_WITH_MSG(loader.Load(deletion_files), "Size not match");
+}
+}  // namespace paimon::test
@@ -16,9 +16,7 @@
 
 #include "paimon/core/io/async_key_value_producer_and_consumer.h"
 
-#include <unistd.h>
-
-#include <chrono>
+#include <algorithm>
 #include <type_traits>
 
 #include "arrow/c/abi.h"
@@ -27,213 +25,220 @@
 #include "paimon/reader/batch_reader.h"
 
 namespace paimon {
-class MemoryPool;
 
 template <typename T, typename R>
 AsyncKeyValueProducerAndConsumer<T, R>::AsyncKeyValueProducerAndConsumer(
     std::unique_ptr<SortMergeReader>&& sort_merge_reader,
     const std::function<Result<std::unique_ptr<RowToArrowArrayConverter<T, R>>>()>& create_consumer,
     int32_t batch_size, int32_t consumer_thread_num, const std::shared_ptr<MemoryPool>& pool)
-    : batch_size_(batch_size),
-      consumer_thread_num_(consumer_thread_num),
+    : batch_size_(std::max(batch_size, 1)),
+      consumer_thread_num_(std::max(consumer_thread_num, 1)),
       pool_(pool),
       sort_merge_reader_(std::move(sort_merge_reader)),
-      create_consumer_(create_consumer) {
-    kv_queue_.set_capacity(batch_size);
-    result_queue_.set_capacity(RESULT_BATCH_COUNT);
-}
+      create_consumer_(create_consumer),
+      // keep every consumer busy while the next chunk is produced
+      chunk_queue_(2 * consumer_thread_num_) {}
 
 template <typename T, typename R>
-Status AsyncKeyValueProducerAndConsumer<T, R>::CheckStatus() const {
-    // check producer status
-    std::chrono::microseconds span(0);
-    std::future_status status = producer_future_.wait_for(span);
-    if (status == std::future_status::ready) {
-        PAIMON_RETURN_NOT_OK(producer_future_.get());
-    }
-    // check consumer status
+Status AsyncKeyValueProducerAndConsumer<T, R>::Start() {
+    started_ = true;
+    consumers_.reserve(consumer_thread_num_);
+    for (int32_t i = 0; i < consumer_thread_num_; i++) {
+        Result<std::unique_ptr<RowToArrowArrayConverter<T, R>>> consumer = create_consumer_();
+        PAIMON_RETURN_NOT_OK(consumer.status());
+        consumers_.push_back(std::move(consumer).value());
+    }
+    producer_future_ = std::async(std::launch::async,
+                                  &AsyncKeyValueProducerAndConsumer<T, R>::ProduceLoop, this);
+    consumer_futures_.reserve(consumer_thread_num_);
     for (const auto& consumer : consumers_) {
-        PAIMON_RETURN_NOT_OK(consumer->GetStatus());
+        consumer_futures_.push_back(std::async(std::launch::async,
+                                               &AsyncKeyValueProducerAndConsumer<T, R>::ConsumeLoop,
+                                               this, consumer.get()));
     }
     return Status::OK();
 }
 
-template <typename T, typename R>
-Status AsyncKeyValueProducerAndConsumer<T, R>::CheckStatusAndCleanUp() {
-    auto status = CheckStatus();
-    if (!status.ok()) {
-        CleanUp();
-    }
-    return status;
-}
-
 template <typename T, typename R>
 Result<R> AsyncKeyValueProducerAndConsumer<T, R>::NextBatch() {
-    if (!producer_future_.valid()) {
-        producer_future_ = std::async(std::launch::async,
-                                      &AsyncKeyValueProducerAndConsumer<T, R>::ProduceLoop, this)
-                               .share();
-    }
-    if (consumers_.empty()) {
-        consumers_.reserve(consumer_thread_num_);
-        for (int32_t i = 0; i < consumer_thread_num_; i++) {
-            Result<std::unique_ptr<RowToArrowArrayConverter<T, R>>> consumer = create_consumer_();
-            PAIMON_RETURN_NOT_OK(consumer.status());
-            auto async_consumer = std::make_unique<AsyncKeyValueConsumer<T, R>>(
-                batch_size_ / consumer_thread_num_, std::move(consumer).value(), consume_finished_,
-                consumer_finished_count_, kv_queue_, result_queue_);
-            consumers_.push_back(std::move(async_consumer));
+    if (!started_) {
+        Status status = Start();
+        if (!status.ok()) {
+            CleanUp();
+            return status;
         }
     }
-    PAIMON_RETURN_NOT_OK(CheckStatusAndCleanUp());
-
     if (next_batch_finished_) {
         // projection reader is eof
         return R();
     }
-
-    R result;
-    while (!result_queue_.try_pop(result)) {
-        PAIMON_RETURN_NOT_OK(CheckStatusAndCleanUp());
-        if (consumer_finished_count_ == consumer_thread_num_ && result_queue_.empty()) {
-            // all consume thread finished
-            next_batch_finished_ = true;
-            return R();
-        }
-        usleep(1000);
+    std::unique_lock<std::mutex> lock(result_mutex_);
+    result_cv_.wait(lock, [this]() {
+        return !error_.ok() || results_.count(next_result_index_) > 0 ||
+               (total_chunk_count_ >= 0 && next_result_index_ >= total_chunk_count_);
+    });
+    if (!error_.ok()) {
+        Status status = error_;
+        lock.unlock();
+        CleanUp();
+        return status;
     }
-
+    auto iter = results_.find(next_result_index_);
+    if (iter == results_.end()) {
+        // all chunks are converted and returned
+        next_batch_finished_ = true;
+        return R();
+    }
+    R result = std::move(iter->second);
+    results_.erase(iter);
+    next_result_index_++;
+    lock.unlock();
+    // a consumer may wait for the room of its converted batch
+    result_cv_.notify_all();
     return result;
 }
 
 template <typename T, typename R>
 Status AsyncKeyValueProducerAndConsumer<T, R>::ProduceLoop() {
-    while (!consume_finished_) {
-        PAIMON_ASSIGN_OR_RAISE(std::unique_ptr<SortMergeReader::Iterator> iterator,
-                               sort_merge_reader_->NextBatch());
-        if (iterator == nullptr) {
-            // all iterator is all visited
-            kv_queue_.push(std::nullopt);
-            break;
-        }
-        while (!consume_finished_) {
-            PAIMON_ASSIGN_OR_RAISE(bool has_next, iterator->HasNext());
-            if (!has_next) {
-                // current iterator is all visited
+    int64_t chunk_index = 0;
+    auto produce = [this, &chunk_index]() -> Status {
+        std::vector<T> rows;
+        rows.reserve(batch_size_);
+        auto push_chunk = [this, &chunk_index, &rows]() -> bool {
+            KeyValueChunk chunk;
+            chunk.index = chunk_index;
+            chunk.rows = std::move(rows);
+            rows = std::vector<T>();
+            rows.reserve(batch_size_);
+            if (!chunk_queue_.push(std::move(chunk))) {
+                // cancelled
+                return false;
+            }
+            chunk_index++;
+            return true;
+        };
+        while (true) {
+            PAIMON_ASSIGN_OR_RAISE(std::unique_ptr<SortMergeReader::Iterator> iterator,
+                                   sort_merge_reader_->NextBatch());
+            if (iterator == nullptr) {
+                // all iterator is all visited
                 break;
             }
-            std::optional<KeyValue> kv = std::move(iterator->Next());
-            kv_queue_.push(std::move(kv));
+            while (true) {
+                PAIMON_ASSIGN_OR_RAISE(bool has_next, iterator->HasNext());
+                if (!has_next) {
+                    // current iterator is all visited
+                    break;
+                }
+                rows.push_back(std::move(iterator->Next()));
+                if (static_cast<int32_t>(rows.size()) >= batch_size_ && !push_chunk()) {
+                    return Status::OK();
+                }
+            }
         }
+        if (!rows.empty()) {
+            push_chunk();
+        }
+        return Status::OK();
+    };
+    Status status = produce();
+    {
+        std::lock_guard<std::mutex> lock(result_mutex_);
+        total_chunk_count_ = chunk_index;
     }
-    return Status::OK();
-}
-
-template <typename T, typename R>
-void AsyncKeyValueProducerAndConsumer<T, R>::CleanUp() {
-    consume_finished_ = true;
-    next_batch_finished_ = true;
-    CleanUpQueue();
-    if (producer_future_.valid()) {
-        [[maybe_unused]] Status status = producer_future_.get();
-    }
-    for (auto& consumer : consumers_) {
-        consumer->CleanUp();
+    if (!status.ok()) {
+        SetError(status);
     }
-    CleanUpQueue();
+    result_cv_.notify_all();
+    // consumers drain the remaining chunks and exit
+    chunk_queue_.close();
+    return status;
 }
 
 template <typename T, typename R>
-void AsyncKeyValueProducerAndConsumer<T, R>::CleanUpQueue() {
-    R read_batch;
-    while (result_queue_.try_pop(read_batch)) {
-        if constexpr (std::is_same_v<R, BatchReader::ReadBatch>) {
-            if (!BatchReader::IsEofBatch(read_batch)) {
-                ReaderUtils::ReleaseReadBatch(std::move(read_batch));
-            }
-        } else if constexpr (std::is_same_v<R, KeyValueBatch>) {
-            if (read_batch.batch) {
-                ArrowArrayRelease(read_batch.batch.get());
-            }
+Status AsyncKeyValueProducerAndConsumer<T, R>::ConsumeLoop(
+    RowToArrowArrayConverter<T, R>* converter) {
+    // the window always contains the next batch to return, so the consumer converting it never
+    // blocks and others wait for room without deadlock
+    const int64_t window = RESULT_BATCH_COUNT + consumer_thread_num_;
+    while (std::optional<KeyValueChunk> chunk = chunk_queue_.pop()) {
+        Result<R> result = converter->NextBatch(chunk->rows);
+        if (!result.ok()) {
+            SetError(result.status());
+            // stop the producer
+            chunk_queue_.close();
+            return result.status();
         }
+        R batch = std::move(result).value();
+        std::unique_lock<std::mutex> lock(result_mutex_);
+        result_cv_.wait(lock, [this, &chunk, window]() {
+            return cancelled_ || chunk->index < next_result_index_ + window;
+        });
+        if (cancelled_) {
+            lock.unlock();
+            ReleaseBatch(&batch);
+            break;
+        }
+        results_.emplace(chunk->index, std::move(batch));
+        lock.unlock();
+        result_cv_.notify_all();
     }
-
-    std::optional<KeyValue> kv;
-    while (kv_queue_.try_pop(kv)) {
-    }
-}
-
-template class AsyncKeyValueProducerAndConsumer<KeyValue, BatchReader::ReadBatch>;
-template class AsyncKeyValueProducerAndConsumer<KeyValue, KeyValueBatch>;
-
-template <typename T, typename R>
-AsyncKeyValueConsumer<T, R>::AsyncKeyValueConsumer(
-    int32_t batch_size, std::unique_ptr<RowToArrowArrayConverter<T, R>>&& key_value_consumer,
-    std::atomic<bool>& consume_finished, std::atomic<int32_t>& consumer_finished_count,
-    tbb::concurrent_bounded_queue<std::optional<KeyValue>>& kv_queue,
-    tbb::concurrent_bounded_queue<R>& result_queue)
-    : batch_size_(batch_size),
-      key_value_consumer_(std::move(key_value_consumer)),
-      consume_finished_(consume_finished),
-      consumer_finished_count_(consumer_finished_count),
-      kv_queue_(kv_queue),
-      result_queue_(result_queue) {
-    consumer_future_ =
-        std::async(std::launch::async, &AsyncKeyValueConsumer<T, R>::ConsumeLoop, this).share();
+    return Status::OK();
 }
 
 template <typename T, typename R>
-Status AsyncKeyValueConsumer<T, R>::GetStatus() const {
-    // check consumer status
-    std::chrono::microseconds span(0);
-    std::future_status status = consumer_future_.wait_for(span);
-    if (status == std::future_status::ready) {
-        PAIMON_RETURN_NOT_OK(consumer_future_.get());
+void AsyncKeyValueProducerAndConsumer<T, R>::SetError(const Status& status) {
+    {
+        std::lock_guard<std::mutex> lock(result_mutex_);
+        if (error_.ok()) {
+            error_ = status;
+        }
     }
-    return Status::OK();
+    result_cv_.notify_all();
 }
 
 template <typename T, typename R>
-Status AsyncKeyValueConsumer<T, R>::ConsumeLoop() {
-    while (!consume_finished_) {
-        int32_t cur_batch_size = 0;
-        std::vector<KeyValue> key_value_vec;
-        key_value_vec.reserve(batch_size_);
-        while (!consume_finished_) {
-            std::optional<KeyValue> kv;
-            if (!kv_queue_.try_pop(kv)) {
-                usleep(1);
-                continue;
-            }
-            if (!kv) {
-                consume_finished_ = true;
-                break;
-            }
-            key_value_vec.push_back(std::move(kv).value());
-            cur_batch_size++;
-            if (cur_batch_size >= batch_size_) {
-                break;
-            }
-        }
-
-        if (cur_batch_size > 0) {
-            PAIMON_ASSIGN_OR_RAISE(R result, key_value_consumer_->NextBatch(key_value_vec));
-            result_queue_.push(std::move(result));
+void AsyncKeyValueProducerAndConsumer<T, R>::CleanUp() {
+    next_batch_finished_ = true;
+    {
+        std::lock_guard<std::mutex> lock(result_mutex_);
+        cancelled_ = true;
+    }
+    result_cv_.notify_all();
+    chunk_queue_.close();
+    if (producer_future_.valid()) {
+        [[maybe_unused]] Status status = producer_future_.get();
+    }
+    for (auto& consumer_future : consumer_futures_) {
+        if (consumer_future.valid()) {
+            [[maybe_unused]] Status status = consumer_future.get();
         }
     }
-    consumer_finished_count_++;
-    return Status::OK();
+    while (chunk_queue_.try_pop()) {
+    }
+    for (auto& [index, batch] : results_) {
+        ReleaseBatch(&batch);
+    }
+    results_.clear();
+    for (auto& consumer : consumers_) {
+        consumer->CleanUp();
+    }
 }
 
 template <typename T, typename R>
-void AsyncKeyValueConsumer<T, R>::CleanUp() {
-    if (consumer_future_.valid()) {
-        [[maybe_unused]] Status status = consumer_future_.get();
+void AsyncKeyValueProducerAndConsumer<T, R>::ReleaseBatch(R* batch) {
+    if constexpr (std::is_same_v<R, BatchReader::ReadBatch>) {
+        if (!BatchReader::IsEofBatch(*batch)) {
+            ReaderUtils::ReleaseReadBatch(std::move(*batch));
+        }
+    } else if constexpr (std::is_same_v<R, KeyValueBatch>) {
+        if (batch->batch) {
+            ArrowArrayRelease(batch->batch.get());
+        }
     }
-    key_value_consumer_->CleanUp();
 }
 
-template class AsyncKeyValueConsumer<KeyValue, BatchReader::ReadBatch>;
-template class AsyncKeyValueConsumer<KeyValue, KeyValueBatch>;
+template class AsyncKeyValueProducerAndConsumer<KeyValue, BatchReader::ReadBatch>;
+template class AsyncKeyValueProducerAndConsumer<KeyValue, KeyValueBatch>;
 
 }  // namespace paimon
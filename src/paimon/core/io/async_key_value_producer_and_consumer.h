@@ -16,30 +16,35 @@
 
 #pragma once
 
-#include <atomic>
+#include <condition_variable>
 #include <cstdint>
 #include <functional>
 #include <future>
+#include <map>
 #include <memory>
+#include <mutex>
+#include <optional>
 #include <utility>
 #include <vector>
 
 #include "arrow/api.h"
+#include "paimon/common/utils/bounded_blocking_queue.h"
 #include "paimon/core/io/row_to_arrow_array_converter.h"
 #include "paimon/core/key_value.h"
 #include "paimon/core/mergetree/compact/sort_merge_reader.h"
 #include "paimon/result.h"
 #include "paimon/status.h"
-#include "tbb/concurrent_queue.h"
 
 namespace paimon {
-template <typename T, typename R>
-class AsyncKeyValueConsumer;
 class MemoryPool;
 class Metrics;
 
 // Asynchronous iterate SortMergeReader (producer) and row-to-array conversion (consumer), support
-// multi-threaded conversion, R can be BatchReader::ReadBatch, KeyValueBatch
+// multi-threaded conversion, R can be BatchReader::ReadBatch, KeyValueBatch.
+//
+// The producer hands KeyValues to consumers in chunks of `batch_size` through a bounded blocking
+// queue, each chunk is converted to one batch by a consumer. Converted batches are returned in
+// chunk order, so the output keeps the order of the SortMergeReader with any number of consumers.
 template <typename T, typename R>
 class AsyncKeyValueProducerAndConsumer {
  public:
@@ -65,12 +70,19 @@ class AsyncKeyValueProducerAndConsumer {
     }
 
  private:
+    struct KeyValueChunk {
+        int64_t index = 0;
+        std::vector<T> rows;
+    };
+
+    // converted batches waiting to be returned, besides the ones being converted
     static constexpr int32_t RESULT_BATCH_COUNT = 3;
-    void CleanUpQueue();
+    Status Start();
     Status ProduceLoop();
+    Status ConsumeLoop(RowToArrowArrayConverter<T, R>* converter);
+    void SetError(const Status& status);
     void CleanUp();
-    Status CheckStatus() const;
-    Status CheckStatusAndCleanUp();
+    static void ReleaseBatch(R* batch);
 
  private:
     int32_t batch_size_;
@@ -79,45 +91,23 @@ class AsyncKeyValueProducerAndConsumer {
     std::unique_ptr<SortMergeReader> sort_merge_reader_;
     std::function<Result<std::unique_ptr<RowToArrowArrayConverter<T, R>>>()> create_consumer_;
 
-    // produce: merge sort KeyValue and push result KeyValue to kv_queue_, consume: project KeyValue
-    // to arrow array and push result array to result_queue_
-    std::atomic<bool> consume_finished_ = false;
-    std::atomic<bool> next_batch_finished_ = false;
-    std::shared_future<Status> producer_future_;
-    std::vector<std::unique_ptr<AsyncKeyValueConsumer<T, R>>> consumers_;
-    std::atomic<int32_t> consumer_finished_count_ = 0;
-    tbb::concurrent_bounded_queue<std::optional<KeyValue>> kv_queue_;
-    tbb::concurrent_bounded_queue<R> result_queue_;
-};
-
-template <typename T, typename R>
-class AsyncKeyValueConsumer {
- public:
-    AsyncKeyValueConsumer(int32_t batch_size,
-                          std::unique_ptr<RowToArrowArrayConverter<T, R>>&& key_value_consumer,
-                          std::atomic<bool>& consume_finished,
-                          std::atomic<int32_t>& consumer_finished_count,
-                          tbb::concurrent_bounded_queue<std::optional<KeyValue>>& kv_queue,
-                          tbb::concurrent_bounded_queue<R>& result_queue);
-
-    ~AsyncKeyValueConsumer() {
-        CleanUp();
-    }
-
-    Status GetStatus() const;
-    void CleanUp();
-
- private:
-    Status ConsumeLoop();
-
- private:
-    int32_t batch_size_;
-    std::unique_ptr<RowToArrowArrayConverter<T, R>> key_value_consumer_;
-    std::shared_future<Status> consumer_future_;
-    std::atomic<bool>& consume_finished_;
-    std::atomic<int32_t>& consumer_finished_count_;
-    tbb::concurrent_bounded_queue<std::optional<KeyValue>>& kv_queue_;
-    tbb::concurrent_bounded_queue<R>& result_queue_;
+    bool started_ = false;
+    bool next_batch_finished_ = false;
+    std::future<Status> producer_future_;
+    std::vector<std::unique_ptr<RowToArrowArrayConverter<T, R>>> consumers_;
+    std::vector<std::future<Status>> consumer_futures_;
+    BoundedBlockingQueue<KeyValueChunk> chunk_queue_;
+
+    // guards the fields below, `result_cv_` is notified whenever one of them changes
+    std::mutex result_mutex_;
+    std::condition_variable result_cv_;
+    // converted batches by chunk index
+    std::map<int64_t, R> results_;
+    int64_t next_result_index_ = 0;
+    // number of chunks produced, -1 until the producer finishes
+    int64_t total_chunk_count_ = -1;
+    bool cancelled_ = false;
+    Status error_;
 };
 
 }  // namespace paimon
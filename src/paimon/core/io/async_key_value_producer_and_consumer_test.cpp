@@ -0,0 +1,143 @@
+/*
+ * Copyright 2024-present Alibaba Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "paimon/core/io/async_key_value_producer_and_consumer.h"
+
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "arrow/api.h"
+#include "arrow/util/checked_cast.h"
+#include "gtest/gtest.h"
+#include "paimon/common/reader/reader_utils.h"
+#include "paimon/common/types/data_field.h"
+#include "paimon/common/utils/arrow/mem_utils.h"
+#include "paimon/core/io/async_key_value_projection_reader.h"
+#include "paimon/core/io/concat_key_value_record_reader.h"
+#include "paimon/core/io/key_value_data_file_record_reader.h"
+#include "paimon/core/io/key_value_record_reader.h"
+#include "paimon/core/mergetree/compact/deduplicate_merge_function.h"
+#include "paimon/core/mergetree/compact/reducer_merge_function_wrapper.h"
+#include "paimon/core/mergetree/compact/sort_merge_reader_with_min_heap.h"
+#include "paimon/core/utils/fields_comparator.h"
+#include "paimon/memory/memory_pool.h"
+#include "paimon/testing/mock/mock_file_batch_reader.h"
+#include "paimon/testing/utils/read_result_collector.h"
+#include "paimon/testing/utils/testharness.h"
+
+namespace paimon::test {
+class AsyncKeyValueProducerAndConsumerTest : public testing::Test {
+ public:
+    void SetUp() override {
+        pool_ = GetDefaultPool();
+        fields_ = {arrow::field("_SEQUENCE_NUMBER", arrow::int64()),
+                   arrow::field("_VALUE_KIND", arrow::int8()), arrow::field("k0", arrow::int32()),
+                   arrow::field("v0", arrow::int64())};
+        value_schema_ = arrow::schema({fields_[2], fields_[3]});
+    }
+
+    /// Generates `key_count` sorted rows whose value is twice the key.
+    std::shared_ptr<arrow::Array> GenerateSortedArray(int32_t key_count) const {
+        auto arrow_pool = GetArrowPool(pool_);
+        std::unique_ptr<arrow::ArrayBuilder> array_builder;
+        EXPECT_TRUE(
+            arrow::MakeBuilder(arrow_pool.get(), arrow::struct_(fields_), &array_builder).ok());
+        auto struct_builder =
+            arrow::internal::checked_pointer_cast<arrow::StructBuilder>(std::move(array_builder));
+        auto seq_builder = static_cast<arrow::Int64Builder*>(struct_builder->field_builder(0));
+        auto kind_builder = static_cast<arrow::Int8Builder*>(struct_builder->field_builder(1));
+        auto key_builder = static_cast<arrow::Int32Builder*>(struct_builder->field_builder(2));
+        auto value_builder = static_cast<arrow::Int64Builder*>(struct_builder->field_builder(3));
+        for (int32_t i = 0; i < key_count; ++i) {
+            EXPECT_TRUE(struct_builder->Append().ok());
+            EXPECT_TRUE(seq_builder->Append(0).ok());
+            EXPECT_TRUE(kind_builder->Append(0).ok());
+            EXPECT_TRUE(key_builder->Append(i).ok());
+            EXPECT_TRUE(value_builder->Append(2L * i).ok());
+        }
+        std::shared_ptr<arrow::Array> array;
+        EXPECT_TRUE(struct_builder->Finish(&array).ok());
+        return array;
+    }
+
+    std::unique_ptr<BatchReader> CreateReader(const std::shared_ptr<arrow::Array>& src_array,
+                                              int32_t batch_size, int32_t thread_num) const {
+        std::vector<DataField> key_fields = {DataField(/*id=*/0, fields_[2])};
+        EXPECT_OK_AND_ASSIGN(std::shared_ptr<FieldsComparator> key_comparator,
+                             FieldsComparator::Create(key_fields, /*sort_fields=*/{0},
+                                                      /*is_ascending_order=*/true,
+                                                      /*use_view=*/true));
+        auto merge_function_wrapper = std::make_shared<ReducerMergeFunctionWrapper>(
+            std::make_unique<DeduplicateMergeFunction>(/*ignore_delete=*/false));
+        auto file_batch_reader = std::make_unique<MockFileBatchReader>(src_array, src_array->type(),
+                                                                       /*batch_size=*/batch_size);
+        std::vector<std::unique_ptr<KeyValueRecordReader>> readers;
+        readers.push_back(std::make_unique<KeyValueDataFileRecordReader>(
+            std::move(file_batch_reader), /*key_arity=*/1, value_schema_, /*level=*/0, pool_));
+        std::vector<std::unique_ptr<KeyValueRecordReader>> concat_readers;
+        concat_readers.push_back(std::make_unique<ConcatKeyValueRecordReader>(std::move(readers)));
+        auto sort_merge_reader = std::make_unique<SortMergeReaderWithMinHeap>(
+            std::move(concat_readers), key_comparator,
+            /*user_defined_seq_comparator=*/nullptr, merge_function_wrapper,
+            /*use_normalized_key=*/true);
+        std::vector<int32_t> target_to_src_mapping = {0, 1};
+        return std::make_unique<AsyncKeyValueProjectionReader>(std::move(sort_merge_reader),
+                                                               value_schema_, target_to_src_mapping,
+                                                               batch_size, thread_num, pool_);
+    }
+
+ protected:
+    std::shared_ptr<MemoryPool> pool_;
+    arrow::FieldVector fields_;
+    std::shared_ptr<arrow::Schema> value_schema_;
+};
+
+TEST_F(AsyncKeyValueProducerAndConsumerTest, TestOrderWithMultipleConsumers) {
+    auto src_array = GenerateSortedArray(/*key_count=*/1000);
+    auto typed_array = arrow::internal::checked_pointer_cast<arrow::StructArray>(src_array);
+    auto expected = arrow::StructArray::Make({typed_array->field(2), typed_array->field(3)},
+                                             value_schema_->fields())
+                        .ValueOrDie();
+    for (int32_t thread_num : {1, 2, 4}) {
+        for (int32_t batch_size : {1, 7, 100, 2000}) {
+            auto reader = CreateReader(src_array, batch_size, thread_num);
+            ASSERT_OK_AND_ASSIGN(std::shared_ptr<arrow::ChunkedArray> result,
+                                 ReadResultCollector::CollectResult(reader.get()));
+            ASSERT_TRUE(result);
+            // batches are returned in the order of the sort merge reader without sorting
+            ASSERT_TRUE(result->Equals(arrow::ChunkedArray(expected)))
+                << "thread_num " << thread_num << ", batch_size " << batch_size;
+            ASSERT_OK_AND_ASSIGN(auto eof_batch, reader->NextBatch());
+            ASSERT_TRUE(BatchReader::IsEofBatch(eof_batch));
+            reader->Close();
+        }
+    }
+}
+
+TEST_F(AsyncKeyValueProducerAndConsumerTest, TestCloseBeforeEof) {
+    auto src_array = GenerateSortedArray(/*key_count=*/10000);
+    for (int32_t thread_num : {1, 4}) {
+        auto reader = CreateReader(src_array, /*batch_size=*/10, thread_num);
+        ASSERT_OK_AND_ASSIGN(auto batch, reader->NextBatch());
+        ASSERT_FALSE(BatchReader::IsEofBatch(batch));
+        ReaderUtils::ReleaseReadBatch(std::move(batch));
+        // producer and consumers blocked on full queues are woken up and stopped
+        reader->Close();
+    }
+}
+
+}  // namespace paimon::test
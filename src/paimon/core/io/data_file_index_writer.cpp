@@ -0,0 +1,179 @@
+/*
+ * Copyright 2024-present Alibaba Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "paimon/core/io/data_file_index_writer.h"
+
+#include <string>
+#include <utility>
+
+#include "arrow/api.h"
+#include "arrow/c/bridge.h"
+#include "arrow/util/checked_cast.h"
+#include "fmt/format.h"
+#include "paimon/common/utils/arrow/status_utils.h"
+#include "paimon/common/utils/path_util.h"
+#include "paimon/common/utils/scope_guard.h"
+#include "paimon/common/utils/string_utils.h"
+#include "paimon/core/io/data_file_path_factory.h"
+#include "paimon/file_index/file_index_format.h"
+#include "paimon/file_index/file_index_writer.h"
+#include "paimon/file_index/file_indexer.h"
+#include "paimon/file_index/file_indexer_factory.h"
+#include "paimon/fs/file_system.h"
+
+namespace paimon {
+
+const char DataFileIndexWriter::FILE_INDEX_PREFIX[] = "file-index.";
+const char DataFileIndexWriter::COLUMNS[] = "columns";
+
+DataFileIndexWriter::DataFileIndexWriter(const std::shared_ptr<arrow::Schema>& schema,
+                                         std::vector<IndexMaintainer>&& maintainers,
+                                         int64_t in_manifest_threshold,
+                                         const std::shared_ptr<MemoryPool>& pool)
+    : struct_type_(arrow::struct_(schema->fields())),
+      maintainers_(std::move(maintainers)),
+      in_manifest_threshold_(in_manifest_threshold),
+      pool_(pool) {}
+
+Result<std::map<std::string, std::map<std::string, std::map<std::string, std::string>>>>
+DataFileIndexWriter::ParseIndexOptions(const std::map<std::string, std::string>& options) {
+    // index type -> columns
+    std::map<std::string, std::vector<std::string>> type_to_columns;
+    const std::string file_index_prefix = FILE_INDEX_PREFIX;
+    for (const auto& [key, value] : options) {
+        if (!StringUtils::StartsWith(key, file_index_prefix)) {
+            continue;
+        }
+        std::string type_and_key = key.substr(file_index_prefix.size());
+        size_t pos = type_and_key.find('.');
+        if (pos == std::string::npos || type_and_key.substr(pos + 1) != COLUMNS) {
+            continue;
+        }
+        std::vector<std::string>& columns = type_to_columns[type_and_key.substr(0, pos)];
+        for (std::string column : StringUtils::Split(value, ",")) {
+            StringUtils::Trim(&column);
+            if (!column.empty()) {
+                columns.push_back(std::move(column));
+            }
+        }
+    }
+
+    std::map<std::string, std::map<std::string, std::map<std::string, std::string>>> result;
+    for (const auto& [index_type, columns] : type_to_columns) {
+        std::string type_prefix = file_index_prefix + index_type + ".";
+        for (const auto& column : columns) {
+            std::string column_prefix = type_prefix + column + ".";
+            std::map<std::string, std::string> index_options;
+            // options of the index type first, then overridden by options of the column
+            for (const auto& [key, value] : options) {
+                if (StringUtils::StartsWith(key, type_prefix)) {
+                    std::string option_key = key.substr(type_prefix.size());
+                    if (option_key != COLUMNS && option_key.find('.') == std::string::npos) {
+                        index_options.emplace(option_key, value);
+                    }
+                }
+            }
+            for (const auto& [key, value] : options) {
+                if (StringUtils::StartsWith(key, column_prefix)) {
+                    index_options[key.substr(column_prefix.size())] = value;
+                }
+            }
+            result[column][index_type] = std::move(index_options);
+        }
+    }
+    return result;
+}
+
+Result<std::unique_ptr<DataFileIndexWriter>> DataFileIndexWriter::Create(
+    const std::shared_ptr<arrow::Schema>& schema,
+    const std::map<std::string, std::string>& options, int64_t in_manifest_threshold,
+    const std::shared_ptr<MemoryPool>& pool) {
+    PAIMON_ASSIGN_OR_RAISE(auto column_to_indexes, ParseIndexOptions(options));
+    if (column_to_indexes.empty()) {
+        return std::unique_ptr<DataFileIndexWriter>();
+    }
+    std::vector<IndexMaintainer> maintainers;
+    for (const auto& [column_name, indexes] : column_to_indexes) {
+        int32_t field_index = schema->GetFieldIndex(column_name);
+        if (field_index < 0) {
+            return Status::Invalid(
+                fmt::format("file index column {} does not exist in schema {}", column_name,
+                            schema->ToString()));
+        }
+        auto index_schema = arrow::schema({schema->field(field_index)});
+        for (const auto& [index_type, index_options] : indexes) {
+            PAIMON_ASSIGN_OR_RAISE(std::unique_ptr<FileIndexer> file_indexer,
+                                   FileIndexerFactory::Get(index_type, index_options));
+            if (file_indexer == nullptr) {
+                return Status::Invalid(fmt::format("unknown file index type {} for column {}",
+                                                   index_type, column_name));
+            }
+            ::ArrowSchema c_schema;
+            PAIMON_RETURN_NOT_OK_FROM_ARROW(arrow::ExportSchema(*index_schema, &c_schema));
+            PAIMON_ASSIGN_OR_RAISE(std::shared_ptr<FileIndexWriter> writer,
+                                   file_indexer->CreateWriter(&c_schema, pool));
+            maintainers.push_back({column_name, field_index, index_type, std::move(writer)});
+        }
+    }
+    return std::unique_ptr<DataFileIndexWriter>(
+        new DataFileIndexWriter(schema, std::move(maintainers), in_manifest_threshold, pool));
+}
+
+Status DataFileIndexWriter::Write(::ArrowArray* batch) {
+    PAIMON_ASSIGN_OR_RAISE_FROM_ARROW(std::shared_ptr<arrow::Array> array,
+                                      arrow::ImportArray(batch, struct_type_));
+    const auto& struct_array = arrow::internal::checked_cast<const arrow::StructArray&>(*array);
+    auto write_batch = [&]() -> Status {
+        for (const auto& maintainer : maintainers_) {
+            const auto& field = struct_type_->field(maintainer.field_index);
+            PAIMON_ASSIGN_OR_RAISE_FROM_ARROW(
+                std::shared_ptr<arrow::StructArray> index_array,
+                arrow::StructArray::Make({struct_array.field(maintainer.field_index)}, {field}));
+            ::ArrowArray c_index_array;
+            PAIMON_RETURN_NOT_OK_FROM_ARROW(arrow::ExportArray(*index_array, &c_index_array));
+            ScopeGuard guard([&c_index_array]() { ArrowArrayRelease(&c_index_array); });
+            PAIMON_RETURN_NOT_OK(maintainer.writer->AddBatch(&c_index_array));
+        }
+        return Status::OK();
+    };
+    Status status = write_batch();
+    PAIMON_RETURN_NOT_OK_FROM_ARROW(arrow::ExportArray(*array, batch));
+    return status;
+}
+
+Result<DataFileIndexWriter::FileIndexResult> DataFileIndexWriter::Finish(
+    const std::shared_ptr<FileSystem>& fs, const std::string& data_file_path) const {
+    std::map<std::string, std::map<std::string, std::shared_ptr<Bytes>>> column_indexes;
+    for (const auto& maintainer : maintainers_) {
+        PAIMON_ASSIGN_OR_RAISE(PAIMON_UNIQUE_PTR<Bytes> index_bytes,
+                               maintainer.writer->SerializedBytes());
+        column_indexes[maintainer.column_name][maintainer.index_type] = std::move(index_bytes);
+    }
+    PAIMON_ASSIGN_OR_RAISE(PAIMON_UNIQUE_PTR<Bytes> bytes,
+                           FileIndexFormat::WriteColumnIndexes(column_indexes, pool_));
+    FileIndexResult result;
+    if (static_cast<int64_t>(bytes->size()) <= in_manifest_threshold_) {
+        result.embedded_index = std::move(bytes);
+        return result;
+    }
+    std::string index_file_path = data_file_path + DataFilePathFactory::INDEX_PATH_SUFFIX;
+    PAIMON_RETURN_NOT_OK(fs->WriteFile(index_file_path, std::string(bytes->data(), bytes->size()),
+                                       /*overwrite=*/false));
+    result.index_file_name = PathUtil::GetName(index_file_path);
+    return result;
+}
+
+}  // namespace paimon
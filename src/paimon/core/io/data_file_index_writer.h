@@ -0,0 +1,98 @@
+/*
+ * Copyright 2024-present Alibaba Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include "arrow/c/abi.h"
+#include "paimon/memory/bytes.h"
+#include "paimon/result.h"
+#include "paimon/status.h"
+
+namespace arrow {
+class DataType;
+class Schema;
+}  // namespace arrow
+
+namespace paimon {
+
+class FileIndexWriter;
+class FileSystem;
+class MemoryPool;
+
+/// Builds the file indexes of a data file from the batches written to it, driven by table options
+/// like `file-index.bloom-filter.columns`.
+///
+/// Options of an index type are given by `file-index.<type>.<key>` and can be overridden for a
+/// column by `file-index.<type>.<column>.<key>`. When finished, the serialized indexes are embedded
+/// in the data file meta if they are not larger than `file-index.in-manifest-threshold`, otherwise
+/// they are written to an index file next to the data file.
+class DataFileIndexWriter {
+ public:
+    struct FileIndexResult {
+        std::shared_ptr<Bytes> embedded_index;
+        /// File name of the independent index file.
+        std::optional<std::string> index_file_name;
+    };
+
+    static const char FILE_INDEX_PREFIX[];
+    static const char COLUMNS[];
+
+    /// @return nullptr if no file index is configured in `options`.
+    static Result<std::unique_ptr<DataFileIndexWriter>> Create(
+        const std::shared_ptr<arrow::Schema>& schema,
+        const std::map<std::string, std::string>& options, int64_t in_manifest_threshold,
+        const std::shared_ptr<MemoryPool>& pool);
+
+    /// Adds `batch`, a struct array of the schema, to the index writers of the indexed columns.
+    /// The batch is imported and exported back in place, so the caller still owns it afterwards.
+    Status Write(::ArrowArray* batch);
+
+    /// Serializes the indexes of the data file at `data_file_path`. If an index file is written,
+    /// it is `data_file_path` with suffix `DataFilePathFactory::INDEX_PATH_SUFFIX`.
+    Result<FileIndexResult> Finish(const std::shared_ptr<FileSystem>& fs,
+                                   const std::string& data_file_path) const;
+
+ private:
+    struct IndexMaintainer {
+        std::string column_name;
+        int32_t field_index;
+        std::string index_type;
+        std::shared_ptr<FileIndexWriter> writer;
+    };
+
+    DataFileIndexWriter(const std::shared_ptr<arrow::Schema>& schema,
+                        std::vector<IndexMaintainer>&& maintainers, int64_t in_manifest_threshold,
+                        const std::shared_ptr<MemoryPool>& pool);
+
+    /// @return column name -> (index type -> index options)
+    static Result<std::map<std::string, std::map<std::string, std::map<std::string, std::string>>>>
+    ParseIndexOptions(const std::map<std::string, std::string>& options);
+
+ private:
+    std::shared_ptr<arrow::DataType> struct_type_;
+    std::vector<IndexMaintainer> maintainers_;
+    int64_t in_manifest_threshold_;
+    std::shared_ptr<MemoryPool> pool_;
+};
+
+}  // namespace paimon
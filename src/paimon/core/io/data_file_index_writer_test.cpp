@@ -0,0 +1,184 @@
+/*
+ * Copyright 2024-present Alibaba Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "paimon/core/io/data_file_index_writer.h"
+
+#include <map>
+#include <string>
+#include <utility>
+
+#include "arrow/api.h"
+#include "arrow/c/abi.h"
+#include "arrow/c/bridge.h"
+#include "arrow/c/helpers.h"
+#include "arrow/ipc/json_simple.h"
+#include "gtest/gtest.h"
+#include "paimon/common/file_index/bitmap/bitmap_file_index.h"
+#include "paimon/common/file_index/bloomfilter/bloom_filter_file_index.h"
+#include "paimon/common/utils/arrow/status_utils.h"
+#include "paimon/core/core_options.h"
+#include "paimon/defs.h"
+#include "paimon/file_index/file_index_format.h"
+#include "paimon/fs/file_system.h"
+#include "paimon/io/byte_array_input_stream.h"
+#include "paimon/memory/memory_pool.h"
+#include "paimon/predicate/literal.h"
+#include "paimon/testing/utils/testharness.h"
+
+namespace paimon::test {
+
+class DataFileIndexWriterTest : public ::testing::Test {
+ public:
+    void SetUp() override {
+        pool_ = GetDefaultPool();
+        schema_ = arrow::schema({arrow::field("f0", arrow::int32()),
+                                 arrow::field("f1", arrow::utf8()),
+                                 arrow::field("f2", arrow::float64())});
+    }
+
+    void WriteBatch(DataFileIndexWriter* writer, const std::string& json_data) const {
+        auto array = arrow::ipc::internal::json::ArrayFromJSON(arrow::struct_(schema_->fields()),
+                                                                json_data)
+                         .ValueOrDie();
+        ::ArrowArray c_array;
+        ASSERT_TRUE(arrow::ExportArray(*array, &c_array).ok());
+        ASSERT_OK(writer->Write(&c_array));
+        // the batch is still owned by caller after written
+        ASSERT_FALSE(ArrowArrayIsReleased(&c_array));
+        auto imported = arrow::ImportArray(&c_array, arrow::struct_(schema_->fields()));
+        ASSERT_TRUE(imported.ok());
+        ASSERT_TRUE(imported.ValueOrDie()->Equals(array));
+    }
+
+    std::unique_ptr<::ArrowSchema> CreateArrowSchema() const {
+        auto c_schema = std::make_unique<::ArrowSchema>();
+        EXPECT_TRUE(arrow::ExportSchema(*schema_, c_schema.get()).ok());
+        return c_schema;
+    }
+
+ protected:
+    std::shared_ptr<MemoryPool> pool_;
+    std::shared_ptr<arrow::Schema> schema_;
+};
+
+TEST_F(DataFileIndexWriterTest, TestNoIndex) {
+    ASSERT_OK_AND_ASSIGN(
+        auto writer,
+        DataFileIndexWriter::Create(schema_, {{Options::FILE_INDEX_READ_ENABLED, "true"}},
+                                    /*in_manifest_threshold=*/500, pool_));
+    ASSERT_FALSE(writer);
+}
+
+TEST_F(DataFileIndexWriterTest, TestInvalidOptions) {
+    ASSERT_NOK_WITH_MSG(
+        DataFileIndexWriter::Create(schema_, {{"file-index.bitmap.columns", "non-exist"}},
+                                    /*in_manifest_threshold=*/500, pool_),
+        "file index column non-exist does not exist");
+    ASSERT_NOK_WITH_MSG(DataFileIndexWriter::Create(schema_, {{"file-index.unknown.columns", "f0"}},
+                                                    /*in_manifest_threshold=*/500, pool_),
+                        "unknown file index type unknown");
+    // options of column override options of index type
+    ASSERT_NOK(DataFileIndexWriter::Create(schema_,
+                                           {{"file-index.bloom-filter.columns", "f0"},
+                                            {"file-index.bloom-filter.fpp", "0.01"},
+                                            {"file-index.bloom-filter.f0.fpp", "2"}},
+                                           /*in_manifest_threshold=*/500, pool_));
+}
+
+TEST_F(DataFileIndexWriterTest, TestEmbeddedIndex) {
+    std::map<std::string, std::string> options = {
+        {"file-index.bitmap.columns", "f0, f1"},
+        {"file-index.bloom-filter.columns", "f0"},
+        {"file-index.bloom-filter.items", "100"},
+    };
+    ASSERT_OK_AND_ASSIGN(auto writer, DataFileIndexWriter::Create(
+                                          schema_, options, /*in_manifest_threshold=*/4096, pool_));
+    ASSERT_TRUE(writer);
+    WriteBatch(writer.get(), R"([[1, "a", 1.0], [2, null, 2.0]])");
+    WriteBatch(writer.get(), R"([[null, "b", 3.0], [1, "a", null]])");
+
+    auto dir = UniqueTestDirectory::Create();
+    ASSERT_TRUE(dir);
+    ASSERT_OK_AND_ASSIGN(CoreOptions core_options, CoreOptions::FromMap({}));
+    auto fs = core_options.GetFileSystem();
+    ASSERT_OK_AND_ASSIGN(auto result, writer->Finish(fs, dir->Str() + "/data-0.orc"));
+    ASSERT_FALSE(result.index_file_name);
+    ASSERT_TRUE(result.embedded_index);
+
+    auto input_stream = std::make_shared<ByteArrayInputStream>(result.embedded_index->data(),
+                                                               result.embedded_index->size());
+    ASSERT_OK_AND_ASSIGN(auto reader, FileIndexFormat::CreateReader(input_stream, pool_));
+    {
+        ASSERT_OK_AND_ASSIGN(auto index_readers,
+                             reader->ReadColumnIndex("f0", CreateArrowSchema().get()));
+        ASSERT_EQ(2, index_readers.size());
+        for (const auto& index_reader : index_readers) {
+            if (dynamic_cast<BitmapFileIndexReader*>(index_reader.get())) {
+                ASSERT_OK_AND_ASSIGN(auto equal_result, index_reader->VisitEqual(Literal(1)));
+                ASSERT_EQ("{0,3}", equal_result->ToString());
+                ASSERT_OK_AND_ASSIGN(auto null_result, index_reader->VisitIsNull());
+                ASSERT_EQ("{2}", null_result->ToString());
+            } else {
+                ASSERT_TRUE(dynamic_cast<BloomFilterFileIndexReader*>(index_reader.get()));
+                ASSERT_OK_AND_ASSIGN(auto equal_result, index_reader->VisitEqual(Literal(2)));
+                ASSERT_TRUE(equal_result->IsRemain().value());
+            }
+        }
+    }
+    {
+        ASSERT_OK_AND_ASSIGN(auto index_readers,
+                             reader->ReadColumnIndex("f1", CreateArrowSchema().get()));
+        ASSERT_EQ(1, index_readers.size());
+        ASSERT_OK_AND_ASSIGN(auto equal_result,
+                             index_readers[0]->VisitEqual(Literal(FieldType::STRING, "a", 1)));
+        ASSERT_EQ("{0,3}", equal_result->ToString());
+    }
+    {
+        ASSERT_OK_AND_ASSIGN(auto index_readers,
+                             reader->ReadColumnIndex("f2", CreateArrowSchema().get()));
+        ASSERT_TRUE(index_readers.empty());
+    }
+}
+
+TEST_F(DataFileIndexWriterTest, TestIndependentIndexFile) {
+    std::map<std::string, std::string> options = {{"file-index.bitmap.columns", "f1"}};
+    ASSERT_OK_AND_ASSIGN(auto writer, DataFileIndexWriter::Create(
+                                          schema_, options, /*in_manifest_threshold=*/0, pool_));
+    ASSERT_TRUE(writer);
+    WriteBatch(writer.get(), R"([[1, "a", 1.0], [2, "b", 2.0], [3, "a", 3.0]])");
+
+    auto dir = UniqueTestDirectory::Create();
+    ASSERT_TRUE(dir);
+    ASSERT_OK_AND_ASSIGN(CoreOptions core_options, CoreOptions::FromMap({}));
+    auto fs = core_options.GetFileSystem();
+    ASSERT_OK_AND_ASSIGN(auto result, writer->Finish(fs, dir->Str() + "/data-0.orc"));
+    ASSERT_FALSE(result.embedded_index);
+    ASSERT_EQ(std::optional<std::string>("data-0.orc.index"), result.index_file_name);
+
+    std::string index_file_bytes;
+    ASSERT_OK(fs->ReadFile(dir->Str() + "/data-0.orc.index", &index_file_bytes));
+    auto input_stream =
+        std::make_shared<ByteArrayInputStream>(index_file_bytes.data(), index_file_bytes.size());
+    ASSERT_OK_AND_ASSIGN(auto reader, FileIndexFormat::CreateReader(input_stream, pool_));
+    ASSERT_OK_AND_ASSIGN(auto index_readers,
+                         reader->ReadColumnIndex("f1", CreateArrowSchema().get()));
+    ASSERT_EQ(1, index_readers.size());
+    ASSERT_OK_AND_ASSIGN(auto equal_result,
+                         index_readers[0]->VisitEqual(Literal(FieldType::STRING, "a", 1)));
+    ASSERT_EQ("{0,2}", equal_result->ToString());
+}
+
+}  // namespace paimon::test
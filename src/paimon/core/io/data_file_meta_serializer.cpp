@@ -102,10 +102,6 @@ Result<std::shared_ptr<DataFileMeta>> DataFileMetaSerializer::FromRow(
     auto file_name = row.GetString(0);
     auto file_size = row.GetLong(1);
     auto row_count = row.GetLong(2);
-    auto min_key = row.GetBinary(3);
-    auto max_key = row.GetBinary(4);
-    auto key_stats_row = row.GetRow(5, 3);
-    auto value_stats_row = row.GetRow(6, 3);
     auto min_sequence_number = row.GetLong(7);
     auto max_sequence_number = row.GetLong(8);
     auto schema_id = row.GetLong(9);
@@ -113,7 +109,6 @@ Result<std::shared_ptr<DataFileMeta>> DataFileMetaSerializer::FromRow(
     std::shared_ptr<InternalArray> extra_files = row.GetArray(11);
     auto creation_time = row.GetTimestamp(12, 3);
 
-    assert(min_key && max_key && key_stats_row && value_stats_row);
     if (extra_files == nullptr) {
         return Status::Invalid("extra files is empty");
     }
@@ -158,12 +153,31 @@ Result<std::shared_ptr<DataFileMeta>> DataFileMetaSerializer::FromRow(
         }
         write_cols = InternalRowUtils::FromNotNullStringArrayData(array.get());
     }
-    PAIMON_ASSIGN_OR_RAISE(BinaryRow min_values, SerializationUtils::DeserializeBinaryRow(min_key));
-    PAIMON_ASSIGN_OR_RAISE(BinaryRow max_values, SerializationUtils::DeserializeBinaryRow(max_key));
-    PAIMON_ASSIGN_OR_RAISE(SimpleStats key_stats,
-                           SimpleStats::FromRow(key_stats_row.get(), pool_.get()));
-    PAIMON_ASSIGN_OR_RAISE(SimpleStats value_stats,
-                           SimpleStats::FromRow(value_stats_row.get(), pool_.get()));
+    // the key range and stats are null if they are not read, see
+    // `ManifestFile::ReadWithoutStats()`
+    BinaryRow min_values = BinaryRow::EmptyRow();
+    BinaryRow max_values = BinaryRow::EmptyRow();
+    SimpleStats key_stats = SimpleStats::EmptyStats();
+    SimpleStats value_stats = SimpleStats::EmptyStats();
+    if (!row.IsNullAt(3)) {
+        PAIMON_ASSIGN_OR_RAISE(min_values,
+                               SerializationUtils::DeserializeBinaryRow(row.GetBinary(3)));
+    }
+    if (!row.IsNullAt(4)) {
+        PAIMON_ASSIGN_OR_RAISE(max_values,
+                               SerializationUtils::DeserializeBinaryRow(row.GetBinary(4)));
+    }
+    if (!row.IsNullAt(5)) {
+        auto key_stats_row = row.GetRow(5, 3);
+        assert(key_stats_row);
+        PAIMON_ASSIGN_OR_RAISE(key_stats, SimpleStats::FromRow(key_stats_row.get(), pool_.get()));
+    }
+    if (!row.IsNullAt(6)) {
+        auto value_stats_row = row.GetRow(6, 3);
+        assert(value_stats_row);
+        PAIMON_ASSIGN_OR_RAISE(value_stats,
+                               SimpleStats::FromRow(value_stats_row.get(), pool_.get()));
+    }
     return std::make_shared<DataFileMeta>(
         file_name.ToString(), file_size, row_count, min_values, max_values, key_stats, value_stats,
         min_sequence_number, max_sequence_number, schema_id, level,
@@ -60,17 +60,25 @@ Result<std::shared_ptr<DataFileMeta>> DataFileWriter::GetResult() {
         PAIMON_ASSIGN_OR_RAISE(Path external_path, PathUtil::ToPath(path_));
         final_path = external_path.ToString();
     }
+    std::vector<std::optional<std::string>> extra_files;
+    if (file_index_result_.index_file_name) {
+        extra_files.push_back(file_index_result_.index_file_name);
+    }
     return DataFileMeta::ForAppend(
         PathUtil::GetName(path_), output_bytes_, RecordCount(), stats,
         seq_num_counter_->GetValue() - RecordCount(), seq_num_counter_->GetValue() - 1, schema_id_,
-        {}, /*embedded_index=*/nullptr, file_source_, /*value_stats_cols=*/std::nullopt, final_path,
-        /*first_row_id=*/std::nullopt, write_cols_);
+        extra_files, file_index_result_.embedded_index, file_source_,
+        /*value_stats_cols=*/std::nullopt, final_path, /*first_row_id=*/std::nullopt, write_cols_);
 }
 
 Result<std::vector<std::shared_ptr<ColumnStats>>> DataFileWriter::GetFieldStats() {
     if (!closed_) {
         return Status::Invalid("Cannot access metric unless the writer is closed.");
     }
+    if (stats_collector_) {
+        // stats were collected while writing, no need to read the file again
+        return stats_collector_->GetResult();
+    }
     if (stats_extractor_ == nullptr) {
         assert(false);
         return Status::Invalid("simple stats extractor is null pointer.");
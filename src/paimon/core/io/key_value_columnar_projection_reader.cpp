@@ -0,0 +1,127 @@
+/*
+ * Copyright 2024-present Alibaba Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "paimon/core/io/key_value_columnar_projection_reader.h"
+
+#include <utility>
+
+#include "arrow/array/array_nested.h"
+#include "arrow/array/array_primitive.h"
+#include "arrow/c/abi.h"
+#include "arrow/c/bridge.h"
+#include "fmt/format.h"
+#include "paimon/common/reader/reader_utils.h"
+#include "paimon/common/table/special_fields.h"
+#include "paimon/common/types/row_kind.h"
+#include "paimon/common/utils/arrow/mem_utils.h"
+#include "paimon/common/utils/arrow/status_utils.h"
+#include "paimon/utils/roaring_bitmap32.h"
+
+namespace paimon {
+
+KeyValueColumnarProjectionReader::KeyValueColumnarProjectionReader(
+    std::unique_ptr<BatchReader>&& reader, const std::shared_ptr<arrow::Schema>& target_schema,
+    int32_t value_kind_index, std::vector<int32_t>&& target_to_src_mapping,
+    const std::shared_ptr<MemoryPool>& pool)
+    : arrow_pool_(GetArrowPool(pool)),
+      reader_(std::move(reader)),
+      target_schema_(target_schema),
+      value_kind_index_(value_kind_index),
+      target_to_src_mapping_(std::move(target_to_src_mapping)) {}
+
+Result<std::unique_ptr<KeyValueColumnarProjectionReader>> KeyValueColumnarProjectionReader::Create(
+    std::unique_ptr<BatchReader>&& reader, const std::shared_ptr<arrow::Schema>& read_schema,
+    const std::shared_ptr<arrow::Schema>& target_schema, const std::shared_ptr<MemoryPool>& pool) {
+    int32_t value_kind_index = read_schema->GetFieldIndex(SpecialFields::ValueKind().Name());
+    if (value_kind_index < 0) {
+        return Status::Invalid(
+            fmt::format("cannot find field {} in key value read schema {}",
+                        SpecialFields::ValueKind().Name(), read_schema->ToString()));
+    }
+    std::vector<int32_t> target_to_src_mapping;
+    target_to_src_mapping.reserve(target_schema->num_fields());
+    for (const auto& field : target_schema->fields()) {
+        int32_t src_index = read_schema->GetFieldIndex(field->name());
+        if (src_index < 0) {
+            return Status::Invalid(fmt::format("cannot find field {} in key value read schema {}",
+                                               field->name(), read_schema->ToString()));
+        }
+        target_to_src_mapping.push_back(src_index);
+    }
+    return std::unique_ptr<KeyValueColumnarProjectionReader>(new KeyValueColumnarProjectionReader(
+        std::move(reader), target_schema, value_kind_index, std::move(target_to_src_mapping),
+        pool));
+}
+
+Result<BatchReader::ReadBatch> KeyValueColumnarProjectionReader::NextBatch() {
+    PAIMON_ASSIGN_OR_RAISE(BatchReader::ReadBatchWithBitmap batch_with_bitmap,
+                           NextBatchWithBitmap());
+    return ReaderUtils::ApplyBitmapToReadBatch(std::move(batch_with_bitmap), arrow_pool_.get());
+}
+
+Result<BatchReader::ReadBatchWithBitmap> KeyValueColumnarProjectionReader::NextBatchWithBitmap() {
+    while (true) {
+        PAIMON_ASSIGN_OR_RAISE(BatchReader::ReadBatchWithBitmap batch_with_bitmap,
+                               reader_->NextBatchWithBitmap());
+        if (BatchReader::IsEofBatch(batch_with_bitmap)) {
+            return batch_with_bitmap;
+        }
+        auto& [batch, bitmap] = batch_with_bitmap;
+        auto& [c_array, c_schema] = batch;
+        PAIMON_ASSIGN_OR_RAISE_FROM_ARROW(std::shared_ptr<arrow::Array> arrow_array,
+                                          arrow::ImportArray(c_array.get(), c_schema.get()));
+        auto struct_array = std::dynamic_pointer_cast<arrow::StructArray>(arrow_array);
+        if (!struct_array) {
+            return Status::Invalid(
+                "cannot cast array to StructArray in KeyValueColumnarProjectionReader");
+        }
+        // drop retract rows as DropDeleteReader, keys in a sorted run are unique
+        auto kind_array =
+            std::dynamic_pointer_cast<arrow::Int8Array>(struct_array->field(value_kind_index_));
+        if (!kind_array) {
+            return Status::Invalid(
+                "cannot cast value kind array to Int8Array in KeyValueColumnarProjectionReader");
+        }
+        const int8_t* kinds = kind_array->raw_values();
+        int8_t update_before = RowKind::UpdateBefore()->ToByteValue();
+        int8_t delete_kind = RowKind::Delete()->ToByteValue();
+        RoaringBitmap32 retract_rows;
+        for (int32_t i = 0; i < static_cast<int32_t>(kind_array->length()); ++i) {
+            if (kinds[i] == update_before || kinds[i] == delete_kind) {
+                retract_rows.Add(i);
+            }
+        }
+        if (!retract_rows.IsEmpty()) {
+            bitmap -= retract_rows;
+            if (bitmap.IsEmpty()) {
+                continue;
+            }
+        }
+        arrow::ArrayVector target_fields;
+        target_fields.reserve(target_to_src_mapping_.size());
+        for (int32_t src_index : target_to_src_mapping_) {
+            target_fields.push_back(struct_array->field(src_index));
+        }
+        PAIMON_ASSIGN_OR_RAISE_FROM_ARROW(
+            std::shared_ptr<arrow::StructArray> target_array,
+            arrow::StructArray::Make(target_fields, target_schema_->fields()));
+        PAIMON_RETURN_NOT_OK_FROM_ARROW(
+            arrow::ExportArray(*target_array, c_array.get(), c_schema.get()));
+        return batch_with_bitmap;
+    }
+}
+
+}  // namespace paimon
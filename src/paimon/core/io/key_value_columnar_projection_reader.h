@@ -0,0 +1,73 @@
+/*
+ * Copyright 2024-present Alibaba Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "arrow/api.h"
+#include "paimon/reader/batch_reader.h"
+#include "paimon/result.h"
+
+namespace arrow {
+class Schema;
+}  // namespace arrow
+
+namespace paimon {
+class MemoryPool;
+class Metrics;
+
+// Projects a single sorted run (e.g., a section without overlapping files) to target schema in
+// columnar form. Keys in a sorted run are unique, so no merge is needed: retract rows are removed
+// from the valid bitmap and target fields are picked from the key value batch by name, which
+// avoids the round trip through KeyValue objects of KeyValueProjectionReader.
+class KeyValueColumnarProjectionReader : public BatchReader {
+ public:
+    // `reader` returns batches in `read_schema` (special fields + key fields + non-key fields)
+    static Result<std::unique_ptr<KeyValueColumnarProjectionReader>> Create(
+        std::unique_ptr<BatchReader>&& reader, const std::shared_ptr<arrow::Schema>& read_schema,
+        const std::shared_ptr<arrow::Schema>& target_schema,
+        const std::shared_ptr<MemoryPool>& pool);
+
+    Result<ReadBatch> NextBatch() override;
+
+    Result<ReadBatchWithBitmap> NextBatchWithBitmap() override;
+
+    std::shared_ptr<Metrics> GetReaderMetrics() const override {
+        return reader_->GetReaderMetrics();
+    }
+
+    void Close() override {
+        reader_->Close();
+    }
+
+ private:
+    KeyValueColumnarProjectionReader(std::unique_ptr<BatchReader>&& reader,
+                                     const std::shared_ptr<arrow::Schema>& target_schema,
+                                     int32_t value_kind_index,
+                                     std::vector<int32_t>&& target_to_src_mapping,
+                                     const std::shared_ptr<MemoryPool>& pool);
+
+ private:
+    std::unique_ptr<arrow::MemoryPool> arrow_pool_;
+    std::unique_ptr<BatchReader> reader_;
+    std::shared_ptr<arrow::Schema> target_schema_;
+    int32_t value_kind_index_;
+    std::vector<int32_t> target_to_src_mapping_;
+};
+}  // namespace paimon
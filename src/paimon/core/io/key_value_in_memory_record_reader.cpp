@@ -30,9 +30,11 @@
 #include "paimon/common/data/columnar/columnar_row.h"
 #include "paimon/common/data/internal_row.h"
 #include "paimon/common/types/row_kind.h"
+#include "paimon/common/utils/arrow/mem_utils.h"
 #include "paimon/common/utils/arrow/status_utils.h"
 #include "paimon/core/mergetree/compact/merge_function_wrapper.h"
 #include "paimon/core/utils/fields_comparator.h"
+#include "paimon/core/utils/radix_sorter.h"
 #include "paimon/status.h"
 
 namespace paimon {
@@ -80,6 +82,7 @@ KeyValueInMemoryRecordReader::KeyValueInMemoryRecordReader(
       primary_keys_(primary_keys),
       user_defined_sequence_fields_(user_defined_sequence_fields),
       pool_(pool),
+      arrow_pool_(GetArrowPool(pool)),
       value_struct_array_(std::move(struct_array)),
       row_kinds_(std::move(row_kinds)),
       key_comparator_(key_comparator),
@@ -119,6 +122,18 @@ void KeyValueInMemoryRecordReader::Close() {
 
 Result<std::shared_ptr<arrow::NumericArray<arrow::UInt64Type>>>
 KeyValueInMemoryRecordReader::SortBatch() const {
+    std::vector<RadixSorter::SortKey> radix_keys;
+    radix_keys.reserve(primary_keys_.size() + user_defined_sequence_fields_.size());
+    for (const auto& name : primary_keys_) {
+        radix_keys.emplace_back(value_struct_array_->GetFieldByName(name), /*ascending=*/true);
+    }
+    for (const auto& name : user_defined_sequence_fields_) {
+        radix_keys.emplace_back(value_struct_array_->GetFieldByName(name), /*ascending=*/true);
+    }
+    if (RadixSorter::IsSupported(radix_keys)) {
+        return RadixSorter::SortIndices(radix_keys, value_struct_array_->length(),
+                                        arrow_pool_.get());
+    }
     std::vector<arrow::compute::SortKey> sort_keys;
     sort_keys.reserve(primary_keys_.size() + user_defined_sequence_fields_.size());
     for (const auto& name : primary_keys_) {
@@ -129,9 +144,10 @@ KeyValueInMemoryRecordReader::SortBatch() const {
     }
     auto sort_options =
         arrow::compute::SortOptions(sort_keys, arrow::compute::NullPlacement::AtStart);
+    arrow::compute::ExecContext ctx(arrow_pool_.get());
     PAIMON_ASSIGN_OR_RAISE_FROM_ARROW(
         std::shared_ptr<arrow::Array> sorted_indices,
-        arrow::compute::SortIndices(arrow::Datum(value_struct_array_), sort_options));
+        arrow::compute::SortIndices(arrow::Datum(value_struct_array_), sort_options, &ctx));
     auto typed_indices =
         arrow::internal::checked_pointer_cast<arrow::NumericArray<arrow::UInt64Type>>(
             sorted_indices);
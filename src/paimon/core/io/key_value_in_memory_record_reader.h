@@ -83,6 +83,8 @@ class KeyValueInMemoryRecordReader : public KeyValueRecordReader {
     std::vector<std::string> primary_keys_;
     std::vector<std::string> user_defined_sequence_fields_;
     std::shared_ptr<MemoryPool> pool_;
+    // declared before sort_indices_, which is allocated from it
+    std::unique_ptr<arrow::MemoryPool> arrow_pool_;
     std::shared_ptr<arrow::StructArray> value_struct_array_;
     std::vector<RecordBatch::RowKind> row_kinds_;
     std::shared_ptr<FieldsComparator> key_comparator_;
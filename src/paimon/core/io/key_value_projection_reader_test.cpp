@@ -89,7 +89,8 @@ class KeyValueProjectionReaderTest : public testing::Test,
 
         auto sort_merge_reader = std::make_unique<SortMergeReaderWithMinHeap>(
             std::move(concat_readers), user_key_comparator,
-            /*user_defined_seq_comparator=*/nullptr, merge_function_wrapper);
+            /*user_defined_seq_comparator=*/nullptr, merge_function_wrapper,
+            /*use_normalized_key=*/true);
         if (!multi_thread_row_to_batch) {
             EXPECT_OK_AND_ASSIGN(auto projection_reader, KeyValueProjectionReader::Create(
                                                              std::move(sort_merge_reader),
@@ -20,6 +20,7 @@
 #include <cstdint>
 #include <functional>
 #include <memory>
+#include <optional>
 #include <string>
 #include <utility>
 
@@ -28,8 +29,11 @@
 #include "fmt/format.h"
 #include "paimon/common/utils/arrow/arrow_utils.h"
 #include "paimon/common/utils/scope_guard.h"
+#include "paimon/core/io/data_file_index_writer.h"
 #include "paimon/core/io/data_file_meta.h"
+#include "paimon/core/io/data_file_path_factory.h"
 #include "paimon/core/io/file_writer.h"
+#include "paimon/core/stats/batch_stats_collector.h"
 #include "paimon/format/format_writer.h"
 #include "paimon/format/writer_builder.h"
 #include "paimon/fs/file_system.h"
@@ -54,22 +58,35 @@ class SingleFileWriter : public FileWriter<T, R> {
     /// Abort executor to just have reference of path instead of whole writer.
     class AbortExecutor {
      public:
-        AbortExecutor(const std::shared_ptr<FileSystem>& fs, const std::string& path)
-            : fs_(fs), path_(path), logger_(Logger::GetLogger("AbortExecutor")) {}
+        AbortExecutor(const std::shared_ptr<FileSystem>& fs, const std::string& path,
+                      const std::optional<std::string>& index_path = std::nullopt)
+            : fs_(fs),
+              path_(path),
+              index_path_(index_path),
+              logger_(Logger::GetLogger("AbortExecutor")) {}
 
         void Abort() {
             if (fs_) {
-                auto status = fs_->Delete(path_);
-                if (!status.ok()) {
-                    PAIMON_LOG_WARN(logger_, "Exception occurs when deleting %s: %s", path_.c_str(),
-                                    status.ToString().c_str());
+                Delete(path_);
+                if (index_path_) {
+                    Delete(index_path_.value());
                 }
             }
         }
 
+     private:
+        void Delete(const std::string& path) {
+            auto status = fs_->Delete(path);
+            if (!status.ok()) {
+                PAIMON_LOG_WARN(logger_, "Exception occurs when deleting %s: %s", path.c_str(),
+                                status.ToString().c_str());
+            }
+        }
+
      private:
         std::shared_ptr<FileSystem> fs_;
         std::string path_;
+        std::optional<std::string> index_path_;
         std::shared_ptr<Logger> logger_;
     };
 
@@ -103,13 +120,23 @@ class SingleFileWriter : public FileWriter<T, R> {
         if (closed_ == false) {
             return Status::Invalid("Writer should be closed!");
         }
-        return AbortExecutor(fs_, path_);
+        return AbortExecutor(fs_, path_, IndexFilePath());
     }
 
     std::string GetPath() const {
         return path_;
     }
 
+    /// Collects column stats from every written batch, see `BatchStatsCollector`.
+    void WithStatsCollector(std::unique_ptr<BatchStatsCollector>&& stats_collector) {
+        stats_collector_ = std::move(stats_collector);
+    }
+
+    /// Builds file indexes from every written batch, see `DataFileIndexWriter`.
+    void WithFileIndexWriter(std::unique_ptr<DataFileIndexWriter>&& file_index_writer) {
+        file_index_writer_ = std::move(file_index_writer);
+    }
+
  protected:
     int64_t output_bytes_ = -1;
     std::string compression_;
@@ -118,6 +145,17 @@ class SingleFileWriter : public FileWriter<T, R> {
     std::shared_ptr<OutputStream> out_;  // nullptr for DirectWriterBuilder
     bool closed_ = false;
     std::string path_;
+    std::unique_ptr<BatchStatsCollector> stats_collector_;
+    std::unique_ptr<DataFileIndexWriter> file_index_writer_;
+    DataFileIndexWriter::FileIndexResult file_index_result_;
+
+ private:
+    std::optional<std::string> IndexFilePath() const {
+        if (file_index_result_.index_file_name) {
+            return path_ + DataFilePathFactory::INDEX_PATH_SUFFIX;
+        }
+        return std::nullopt;
+    }
 
  private:
     int64_t record_count_ = 0;
@@ -168,6 +206,12 @@ Status SingleFileWriter<T, R>::Write(T record) {
         if constexpr (std::is_same_v<T, ::ArrowArray*>) {
             record_count = record->length;
             ScopeGuard inner_guard([&record]() { ArrowArrayRelease(record); });
+            if (stats_collector_) {
+                PAIMON_RETURN_NOT_OK(stats_collector_->Collect(record));
+            }
+            if (file_index_writer_) {
+                PAIMON_RETURN_NOT_OK(file_index_writer_->Write(record));
+            }
             PAIMON_RETURN_NOT_OK(writer_->AddBatch(record));
             inner_guard.Release();
         } else {
@@ -179,6 +223,12 @@ Status SingleFileWriter<T, R>::Write(T record) {
         ScopeGuard inner_guard([&array]() { ArrowArrayRelease(&array); });
         PAIMON_RETURN_NOT_OK(converter_(std::move(record), &array));
         record_count = array.length;
+        if (stats_collector_) {
+            PAIMON_RETURN_NOT_OK(stats_collector_->Collect(&array));
+        }
+        if (file_index_writer_) {
+            PAIMON_RETURN_NOT_OK(file_index_writer_->Write(&array));
+        }
         PAIMON_RETURN_NOT_OK(writer_->AddBatch(&array));
         inner_guard.Release();
     }
@@ -208,6 +258,9 @@ Status SingleFileWriter<T, R>::Close() {
         PAIMON_ASSIGN_OR_RAISE(std::unique_ptr<FileStatus> file_status, fs_->GetFileStatus(path_));
         output_bytes_ = file_status->GetLen();
     }
+    if (file_index_writer_) {
+        PAIMON_ASSIGN_OR_RAISE(file_index_result_, file_index_writer_->Finish(fs_, path_));
+    }
     closed_ = true;
     guard.Release();
     return Status::OK();
@@ -233,6 +286,18 @@ void SingleFileWriter<T, R>::Abort() {
             PAIMON_LOG_WARN(logger_, "Exception occurs when closing %s: %s", path_.c_str(),
                             status.ToString().c_str());
         }
+        if (file_index_writer_) {
+            // the index file may be partially written when finishing the index fails
+            std::string index_path = path_ + DataFilePathFactory::INDEX_PATH_SUFFIX;
+            Result<bool> exists = fs_->Exists(index_path);
+            if (!exists.ok() || exists.value()) {
+                status = fs_->Delete(index_path);
+                if (!status.ok()) {
+                    PAIMON_LOG_WARN(logger_, "Exception occurs when closing %s: %s",
+                                    index_path.c_str(), status.ToString().c_str());
+                }
+            }
+        }
     }
 }
 
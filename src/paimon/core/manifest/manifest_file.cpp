@@ -21,6 +21,8 @@
 
 #include "arrow/c/abi.h"
 #include "arrow/c/bridge.h"
+#include "arrow/type.h"
+#include "arrow/util/checked_cast.h"
 #include "paimon/common/utils/arrow/status_utils.h"
 #include "paimon/core/io/rolling_file_writer.h"
 #include "paimon/core/manifest/manifest_entry.h"
@@ -51,13 +53,15 @@ ManifestFile::ManifestFile(const std::shared_ptr<FileSystem>& file_system,
                            const std::shared_ptr<PathFactory>& path_factory,
                            int64_t target_file_size, const std::shared_ptr<MemoryPool>& pool,
                            const CoreOptions& options,
-                           const std::shared_ptr<arrow::Schema>& partition_type)
+                           const std::shared_ptr<arrow::Schema>& partition_type,
+                           bool skip_nested_fields)
     : ObjectsFile<ManifestEntry>(file_system, reader_builder, writer_builder,
                                  std::make_unique<ManifestEntrySerializer>(pool), compression,
                                  path_factory, pool),
       target_file_size_(target_file_size),
       options_(options),
-      partition_type_(partition_type) {}
+      partition_type_(partition_type),
+      skip_nested_fields_(skip_nested_fields) {}
 
 Result<std::unique_ptr<ManifestFile>> ManifestFile::Create(
     const std::shared_ptr<FileSystem>& file_system, const std::shared_ptr<FileFormat>& file_format,
@@ -80,7 +84,34 @@ Result<std::unique_ptr<ManifestFile>> ManifestFile::Create(
     std::shared_ptr<PathFactory> manifest_file_factory = path_factory->CreateManifestFileFactory();
     return std::unique_ptr<ManifestFile>(
         new ManifestFile(file_system, reader_builder, writer_builder, compression,
-                         manifest_file_factory, target_file_size, pool, options, partition_type));
+                         manifest_file_factory, target_file_size, pool, options, partition_type,
+                         /*skip_nested_fields=*/file_format->Identifier() == "avro"));
+}
+
+Status ManifestFile::ReadWithoutStats(
+    const std::string& file_name, const std::function<Result<bool>(const ManifestEntry&)>& filter,
+    std::vector<ManifestEntry>* result) const {
+    if (!skip_nested_fields_) {
+        // orc and parquet readers read `_FILE` as a whole
+        return Read(file_name, filter, result);
+    }
+    static const std::shared_ptr<arrow::DataType> read_type = []() {
+        std::shared_ptr<arrow::DataType> data_type =
+            VersionedObjectSerializer<ManifestEntry>::VersionType(ManifestEntry::DataType());
+        const auto& entry_type =
+            arrow::internal::checked_cast<const arrow::StructType&>(*data_type);
+        int32_t file_index = entry_type.GetFieldIndex("_FILE");
+        std::shared_ptr<arrow::DataType> file_type = entry_type.field(file_index)->type();
+        for (const auto& name : {"_MIN_KEY", "_MAX_KEY", "_KEY_STATS", "_VALUE_STATS"}) {
+            const auto& file_struct_type =
+                arrow::internal::checked_cast<const arrow::StructType&>(*file_type);
+            file_type = file_struct_type.RemoveField(file_struct_type.GetFieldIndex(name))
+                            .ValueOr(nullptr);
+        }
+        return entry_type.SetField(file_index, entry_type.field(file_index)->WithType(file_type))
+            .ValueOr(nullptr);
+    }();
+    return ReadProjected(file_name, read_type, filter, result);
 }
 
 Result<std::vector<ManifestFileMeta>> ManifestFile::Write(
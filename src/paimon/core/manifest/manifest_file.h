@@ -17,6 +17,7 @@
 #pragma once
 
 #include <cstdint>
+#include <functional>
 #include <memory>
 #include <string>
 #include <vector>
@@ -60,18 +61,29 @@ class ManifestFile : public ObjectsFile<ManifestEntry> {
     /// @note This method is atomic.
     Result<std::vector<ManifestFileMeta>> Write(const std::vector<ManifestEntry>& entries);
 
+    /// Read the entries without decoding the key range and stats of their data files, which are
+    /// empty in the returned entries. For readers only interested in the files of the entries,
+    /// e.g. snapshot expiration. Only avro readers skip fields nested in `_FILE`, the entries
+    /// are read completely from other formats.
+    Status ReadWithoutStats(const std::string& file_name,
+                            const std::function<Result<bool>(const ManifestEntry&)>& filter,
+                            std::vector<ManifestEntry>* result) const;
+
  private:
     ManifestFile(const std::shared_ptr<FileSystem>& file_system,
                  const std::shared_ptr<ReaderBuilder>& reader_builder,
                  const std::shared_ptr<WriterBuilder>& writer_builder,
                  const std::string& compression, const std::shared_ptr<PathFactory>& path_factory,
                  int64_t target_file_size, const std::shared_ptr<MemoryPool>& pool,
-                 const CoreOptions& options, const std::shared_ptr<arrow::Schema>& partition_type);
+                 const CoreOptions& options, const std::shared_ptr<arrow::Schema>& partition_type,
+                 bool skip_nested_fields);
 
  private:
     int64_t target_file_size_;
     CoreOptions options_;
     std::shared_ptr<arrow::Schema> partition_type_;
+    // whether the reader of the manifest format skips fields nested in a struct
+    bool skip_nested_fields_;
 };
 
 }  // namespace paimon
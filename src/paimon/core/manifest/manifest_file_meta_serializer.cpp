@@ -99,13 +99,17 @@ Result<ManifestFileMeta> ManifestFileMetaSerializer::ConvertFrom(int32_t version
     auto file_size = row.GetLong(1);
     auto num_added_files = row.GetLong(2);
     auto num_deleted_files = row.GetLong(3);
-    auto partition_stats_row = row.GetRow(4, 3);
-    if (partition_stats_row == nullptr) {
-        return Status::Invalid(
-            "ManifestFileMeta convert from row failed, with null partition stats");
+    // partition stats are null if they are not read, see `ManifestList::ReadWithoutStats()`
+    SimpleStats partition_stats = SimpleStats::EmptyStats();
+    if (!row.IsNullAt(4)) {
+        auto partition_stats_row = row.GetRow(4, 3);
+        if (partition_stats_row == nullptr) {
+            return Status::Invalid(
+                "ManifestFileMeta convert from row failed, with null partition stats");
+        }
+        PAIMON_ASSIGN_OR_RAISE(partition_stats,
+                               SimpleStats::FromRow(partition_stats_row.get(), pool_.get()));
     }
-    PAIMON_ASSIGN_OR_RAISE(SimpleStats partition_stats,
-                           SimpleStats::FromRow(partition_stats_row.get(), pool_.get()));
 
     auto schema_id = row.GetLong(5);
     std::optional<int32_t> min_bucket;
@@ -46,10 +46,9 @@
 namespace paimon::test {
 class ManifestFileTest : public testing::Test {
  public:
-    std::vector<ManifestEntry> ReadManifestEntry(const std::string& file_format_str,
-                                                 const std::string& root_path,
-                                                 const std::string& file_name,
-                                                 const std::shared_ptr<MemoryPool>& pool) const {
+    std::unique_ptr<ManifestFile> CreateManifestFile(
+        const std::string& file_format_str, const std::string& root_path,
+        const std::shared_ptr<MemoryPool>& pool) const {
         std::shared_ptr<FileSystem> file_system = std::make_shared<LocalFileSystem>();
         EXPECT_OK_AND_ASSIGN(std::shared_ptr<FileFormat> file_format,
                              FileFormatFactory::Get(file_format_str, {}));
@@ -69,6 +68,14 @@ class ManifestFileTest : public testing::Test {
             std::unique_ptr<ManifestFile> manifest_file,
             ManifestFile::Create(file_system, file_format, "zstd", path_factory,
                                  /*target_file_size=*/1024, pool, options, unused_schema));
+        return manifest_file;
+    }
+
+    std::vector<ManifestEntry> ReadManifestEntry(const std::string& file_format_str,
+                                                 const std::string& root_path,
+                                                 const std::string& file_name,
+                                                 const std::shared_ptr<MemoryPool>& pool) const {
+        auto manifest_file = CreateManifestFile(file_format_str, root_path, pool);
         std::vector<ManifestEntry> manifest_entries;
         EXPECT_OK(manifest_file->Read(file_name, /*filter=*/nullptr, &manifest_entries));
 
@@ -309,4 +316,43 @@ TEST_F(ManifestFileTest, TestManifestFileCompatibleWithJavaPaimon11) {
     ASSERT_EQ(expected_manifest_entries, manifest_entries);
 }
 
+TEST_F(ManifestFileTest, TestReadWithoutStats) {
+    auto pool = GetDefaultPool();
+    auto manifest_file = CreateManifestFile("avro", paimon::test::GetDataDir() + "/avro", pool);
+    std::vector<ManifestEntry> manifest_entries;
+    ASSERT_OK(manifest_file->ReadWithoutStats("avro_manifest_11", /*filter=*/nullptr,
+                                              &manifest_entries));
+    ASSERT_EQ(manifest_entries.size(), 1);
+    // key range and stats of the data file are skipped by the avro reader
+    auto file_meta = std::make_shared<DataFileMeta>(
+        "data-0ff223ba-0d95-4c43-a25f-bcee3c051e58-0.avro", /*file_size=*/1615, /*row_count=*/3,
+        /*min_key=*/BinaryRow::EmptyRow(), /*max_key=*/BinaryRow::EmptyRow(),
+        /*key_stats=*/SimpleStats::EmptyStats(), /*value_stats=*/SimpleStats::EmptyStats(),
+        /*min_sequence_number=*/0, /*max_sequence_number=*/2, /*schema_id=*/0,
+        /*level=*/0, /*extra_files=*/std::vector<std::optional<std::string>>(),
+        /*creation_time=*/Timestamp(1754048761150ll, 0),
+        /*delete_row_count=*/0, /*embedded_index=*/nullptr, FileSource::Append(),
+        /*value_stats_cols=*/std::nullopt, /*external_path=*/std::nullopt,
+        /*first_row_id=*/std::nullopt,
+        /*write_cols=*/std::nullopt);
+    auto manifest_entry = ManifestEntry(FileKind::Add(), /*partition=*/BinaryRow::EmptyRow(),
+                                        /*bucket=*/0, /*total_buckets=*/-1, file_meta);
+
+    std::vector<ManifestEntry> expected_manifest_entries;
+    expected_manifest_entries.emplace_back(manifest_entry);
+    ASSERT_EQ(expected_manifest_entries, manifest_entries);
+}
+
+TEST_F(ManifestFileTest, TestReadWithoutStatsFallbackToRead) {
+    auto pool = GetDefaultPool();
+    std::string root_path = paimon::test::GetDataDir() + "/orc/append_09.db/append_09";
+    std::string file_name = "manifest-3ea5ee21-d399-4f1c-a749-2fc63dbf0852-1";
+    auto manifest_file = CreateManifestFile("orc", root_path, pool);
+    // orc reader cannot skip fields nested in `_FILE`, entries are read completely
+    std::vector<ManifestEntry> manifest_entries;
+    ASSERT_OK(manifest_file->ReadWithoutStats(file_name, /*filter=*/nullptr, &manifest_entries));
+    ASSERT_EQ(manifest_entries.size(), 5);
+    ASSERT_EQ(ReadManifestEntry("orc", root_path, file_name, pool), manifest_entries);
+}
+
 }  // namespace paimon::test
@@ -18,6 +18,8 @@
 
 #include "arrow/c/abi.h"
 #include "arrow/c/bridge.h"
+#include "arrow/type.h"
+#include "arrow/util/checked_cast.h"
 #include "paimon/common/utils/arrow/status_utils.h"
 #include "paimon/core/manifest/manifest_file_meta.h"
 #include "paimon/core/manifest/manifest_file_meta_serializer.h"
@@ -72,6 +74,17 @@ Result<std::unique_ptr<ManifestList>> ManifestList::Create(
         fs, reader_builder, writer_builder, compression, manifest_list_path_factory, pool));
 }
 
+Status ManifestList::ReadWithoutStats(const std::string& file_name,
+                                      std::vector<ManifestFileMeta>* result) const {
+    static const std::shared_ptr<arrow::DataType> read_type = []() {
+        std::shared_ptr<arrow::DataType> data_type =
+            VersionedObjectSerializer<ManifestFileMeta>::VersionType(ManifestFileMeta::DataType());
+        const auto& meta_type = arrow::internal::checked_cast<const arrow::StructType&>(*data_type);
+        return meta_type.RemoveField(meta_type.GetFieldIndex("_PARTITION_STATS")).ValueOr(nullptr);
+    }();
+    return ReadProjected(file_name, read_type, /*filter=*/nullptr, result);
+}
+
 Result<std::pair<std::string, int64_t>> ManifestList::Write(
     const std::vector<ManifestFileMeta>& metas) {
     return WriteWithoutRolling(metas);
@@ -57,6 +57,12 @@ class ManifestList : public ObjectsFile<ManifestFileMeta> {
     /// @note This method is atomic.
     Result<std::pair<std::string, int64_t>> Write(const std::vector<ManifestFileMeta>& metas);
 
+    /// Read the manifest file metas without decoding their partition stats, which are empty in
+    /// the returned metas. For readers only interested in the manifest files, e.g. snapshot
+    /// expiration.
+    Status ReadWithoutStats(const std::string& file_name,
+                            std::vector<ManifestFileMeta>* result) const;
+
     /// Return all `ManifestFileMeta` instances for either data or changelog manifests in this
     /// snapshot.
     ///
@@ -17,13 +17,17 @@
 #include "paimon/core/manifest/manifest_list.h"
 
 #include <map>
+#include <string>
+#include <utility>
 #include <variant>
 
 #include "arrow/type.h"
 #include "gtest/gtest.h"
+#include "paimon/common/io/cache/lru_cache.h"
 #include "paimon/core/manifest/manifest_file_meta.h"
 #include "paimon/core/stats/simple_stats.h"
 #include "paimon/core/utils/file_store_path_factory.h"
+#include "paimon/core/utils/objects_cache.h"
 #include "paimon/format/file_format.h"
 #include "paimon/format/file_format_factory.h"
 #include "paimon/fs/local/local_file_system.h"
@@ -107,6 +111,27 @@ TEST_F(ManifestListTest, TestSimple) {
     ASSERT_EQ(manifest_file_metas, expected_manifest_file_metas);
 }
 
+TEST_F(ManifestListTest, TestReadWithoutStats) {
+    auto pool = GetDefaultPool();
+    auto manifest_list = CreateManifestList(
+        "orc", paimon::test::GetDataDir() + "/orc/append_09.db/append_09", pool);
+    std::vector<ManifestFileMeta> manifest_file_metas;
+    ASSERT_OK(manifest_list->ReadWithoutStats(
+        "manifest-list-f2d59cb8-3ec6-4860-b34b-050b1a533416-2", &manifest_file_metas));
+    ASSERT_EQ(manifest_file_metas.size(), 4);
+    // partition stats are not read
+    std::vector<std::pair<std::string, int64_t>> expected_files = {
+        {"manifest-f8b15cfc-437a-4d21-a6a0-e45b639ae7ed-0", 2666},
+        {"manifest-3a44a0da-1008-463c-914e-28d271375e24-0", 2617},
+        {"manifest-c5904353-0236-46a2-891f-62a326dd8e5e-0", 2360},
+        {"manifest-3ea5ee21-d399-4f1c-a749-2fc63dbf0852-0", 2366}};
+    for (size_t i = 0; i < manifest_file_metas.size(); ++i) {
+        ASSERT_EQ(manifest_file_metas[i].FileName(), expected_files[i].first);
+        ASSERT_EQ(manifest_file_metas[i].FileSize(), expected_files[i].second);
+        ASSERT_EQ(manifest_file_metas[i].PartitionStats(), SimpleStats::EmptyStats());
+    }
+}
+
 TEST_F(ManifestListTest, TestReadWithBucketsAndLevel) {
     auto pool = GetDefaultPool();
     auto manifest_file_metas =
@@ -200,4 +225,52 @@ TEST_F(ManifestListTest, TestReadWithMinAndMaxRowId) {
     ASSERT_EQ(manifest_file_metas2, expected_manifest_file_metas);
 }
 
+TEST_F(ManifestListTest, TestReadWithCache) {
+    auto pool = GetDefaultPool();
+    auto dir = UniqueTestDirectory::Create();
+    ASSERT_TRUE(dir);
+    auto manifest_list = CreateManifestList("orc", dir->Str(), pool);
+    std::vector<ManifestFileMeta> metas;
+    for (int32_t i = 0; i < 3; ++i) {
+        metas.emplace_back("manifest-" + std::to_string(i), /*file_size=*/1000 + i,
+                           /*num_added_files=*/i, /*num_deleted_files=*/0,
+                           SimpleStats::EmptyStats(), /*schema_id=*/0,
+                           /*min_bucket=*/std::nullopt, /*max_bucket=*/std::nullopt,
+                           /*min_level=*/std::nullopt, /*max_level=*/std::nullopt,
+                           /*min_row_id=*/std::nullopt, /*max_row_id=*/std::nullopt);
+    }
+    ASSERT_OK_AND_ASSIGN(auto file_meta, manifest_list->Write(metas));
+
+    auto cache = std::make_shared<LruCache>(/*capacity=*/1024 * 1024);
+    manifest_list->SetCache(cache);
+    std::vector<ManifestFileMeta> result;
+    ASSERT_OK(manifest_list->Read(file_meta.first, /*filter=*/nullptr, &result));
+    ASSERT_EQ(metas, result);
+    ASSERT_EQ(1, cache->Stats().miss_count);
+    ASSERT_GT(cache->Stats().used_bytes, 0);
+
+    // the second read is served by the cache, even if the file is gone
+    ASSERT_OK(std::make_shared<LocalFileSystem>()->Delete(
+        manifest_list->path_factory_->ToPath(file_meta.first)));
+    result.clear();
+    auto filter = [](const ManifestFileMeta& meta) -> Result<bool> {
+        return meta.NumAddedFiles() > 0;
+    };
+    ASSERT_OK(manifest_list->Read(file_meta.first, filter, &result));
+    ASSERT_EQ(std::vector<ManifestFileMeta>({metas[1], metas[2]}), result);
+    ASSERT_EQ(1, cache->Stats().hit_count);
+}
+
+TEST_F(ManifestListTest, TestGlobalObjectsCache) {
+    ASSERT_EQ(nullptr, ObjectsCache::GetGlobal(/*max_memory_size=*/0));
+    auto cache = ObjectsCache::GetGlobal(/*max_memory_size=*/1024);
+    ASSERT_TRUE(cache);
+    int64_t capacity = std::dynamic_pointer_cast<LruCache>(cache)->Capacity();
+    ASSERT_GT(capacity, 0);
+    ASSERT_EQ(cache, ObjectsCache::GetGlobal(/*max_memory_size=*/1024));
+    // tables configured with other sizes share the same cache, which keeps its size
+    ASSERT_EQ(cache, ObjectsCache::GetGlobal(/*max_memory_size=*/2048));
+    ASSERT_EQ(capacity, std::dynamic_pointer_cast<LruCache>(cache)->Capacity());
+}
+
 }  // namespace paimon::test
@@ -0,0 +1,482 @@
+/*
+ * Copyright 2024-present Alibaba Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "paimon/core/mergetree/compact/columnar_key_value_merger.h"
+
+#include <algorithm>
+#include <optional>
+#include <utility>
+
+#include "arrow/array/array_base.h"
+#include "arrow/array/array_binary.h"
+#include "arrow/array/array_decimal.h"
+#include "arrow/array/array_nested.h"
+#include "arrow/array/array_primitive.h"
+#include "arrow/array/concatenate.h"
+#include "arrow/c/abi.h"
+#include "arrow/c/bridge.h"
+#include "arrow/compute/api.h"
+#include "arrow/compute/ordering.h"
+#include "arrow/util/checked_cast.h"
+#include "fmt/format.h"
+#include "paimon/common/data/columnar/columnar_row.h"
+#include "paimon/common/table/special_fields.h"
+#include "paimon/common/types/row_kind.h"
+#include "paimon/common/utils/arrow/mem_utils.h"
+#include "paimon/common/utils/arrow/status_utils.h"
+#include "paimon/core/core_options.h"
+#include "paimon/core/io/key_value_meta_projection_consumer.h"
+#include "paimon/core/mergetree/compact/merge_function_wrapper.h"
+#include "paimon/core/utils/radix_sorter.h"
+
+namespace paimon {
+namespace {
+bool IsRetractKind(int8_t kind) {
+    return kind == RowKind::UpdateBefore()->ToByteValue() ||
+           kind == RowKind::Delete()->ToByteValue();
+}
+
+// Compares adjacent rows in sorted order, null equals null and differs from any non-null value.
+template <typename ArrayType>
+void MarkKeyChanges(const arrow::Array& array, const uint64_t* sorted_indices, int64_t length,
+                    std::vector<uint8_t>* run_starts) {
+    const auto& typed_array = arrow::internal::checked_cast<const ArrayType&>(array);
+    bool may_have_nulls = typed_array.null_count() > 0;
+    auto& starts = *run_starts;
+    for (int64_t i = 1; i < length; ++i) {
+        if (starts[i]) {
+            continue;
+        }
+        auto prev = static_cast<int64_t>(sorted_indices[i - 1]);
+        auto current = static_cast<int64_t>(sorted_indices[i]);
+        if (may_have_nulls) {
+            bool prev_null = typed_array.IsNull(prev);
+            bool current_null = typed_array.IsNull(current);
+            if (prev_null || current_null) {
+                starts[i] = static_cast<uint8_t>(prev_null != current_null);
+                continue;
+            }
+        }
+        starts[i] = static_cast<uint8_t>(typed_array.GetView(prev) != typed_array.GetView(current));
+    }
+}
+}  // namespace
+
+ColumnarKeyValueMerger::ColumnarKeyValueMerger(
+    const std::shared_ptr<arrow::Schema>& write_schema,
+    const std::vector<std::string>& trimmed_primary_keys,
+    const std::vector<std::string>& sequence_fields, bool sequence_ascending,
+    MergeEngine merge_engine, bool ignore_delete,
+    const std::shared_ptr<MergeFunctionWrapper<KeyValue>>& wrapper,
+    const std::shared_ptr<MemoryPool>& pool)
+    : write_schema_(write_schema),
+      trimmed_primary_keys_(trimmed_primary_keys),
+      sequence_fields_(sequence_fields),
+      sequence_ascending_(sequence_ascending),
+      merge_engine_(merge_engine),
+      ignore_delete_(ignore_delete),
+      merge_function_wrapper_(wrapper),
+      pool_(pool),
+      arrow_pool_(GetArrowPool(pool)) {}
+
+bool ColumnarKeyValueMerger::IsSupportedKeyType(const arrow::DataType& type) {
+    switch (type.id()) {
+        case arrow::Type::type::BOOL:
+        case arrow::Type::type::INT8:
+        case arrow::Type::type::INT16:
+        case arrow::Type::type::INT32:
+        case arrow::Type::type::INT64:
+        case arrow::Type::type::FLOAT:
+        case arrow::Type::type::DOUBLE:
+        case arrow::Type::type::DATE32:
+        case arrow::Type::type::TIMESTAMP:
+        case arrow::Type::type::DECIMAL128:
+        case arrow::Type::type::STRING:
+        case arrow::Type::type::BINARY:
+            return true;
+        default:
+            return false;
+    }
+}
+
+std::unique_ptr<ColumnarKeyValueMerger> ColumnarKeyValueMerger::Create(
+    const std::shared_ptr<arrow::Schema>& value_schema,
+    const std::shared_ptr<arrow::Schema>& write_schema,
+    const std::vector<std::string>& trimmed_primary_keys, const CoreOptions& options,
+    const std::shared_ptr<MergeFunctionWrapper<KeyValue>>& merge_function_wrapper,
+    const std::shared_ptr<MemoryPool>& pool) {
+    if (trimmed_primary_keys.empty()) {
+        return nullptr;
+    }
+    for (const auto& key : trimmed_primary_keys) {
+        auto field = value_schema->GetFieldByName(key);
+        if (field == nullptr || !IsSupportedKeyType(*field->type())) {
+            return nullptr;
+        }
+    }
+    for (const auto& sequence_field : options.GetSequenceField()) {
+        if (value_schema->GetFieldByName(sequence_field) == nullptr) {
+            return nullptr;
+        }
+    }
+    return std::unique_ptr<ColumnarKeyValueMerger>(new ColumnarKeyValueMerger(
+        write_schema, trimmed_primary_keys, options.GetSequenceField(),
+        options.SequenceFieldSortOrderIsAscending(), options.GetMergeEngine(),
+        options.IgnoreDelete(), merge_function_wrapper, pool));
+}
+
+Result<std::shared_ptr<arrow::StructArray>> ColumnarKeyValueMerger::Merge(
+    const std::vector<std::shared_ptr<arrow::StructArray>>& batches,
+    const std::vector<std::vector<RecordBatch::RowKind>>& row_kinds,
+    int64_t first_sequence_number) const {
+    if (batches.size() != row_kinds.size()) {
+        return Status::Invalid(
+            fmt::format("batch count {} mismatches row kind count {} in columnar merge",
+                        batches.size(), row_kinds.size()));
+    }
+    // 1. concatenate buffered batches and row kinds
+    PAIMON_ASSIGN_OR_RAISE(std::shared_ptr<arrow::StructArray> values, Concatenate(batches));
+    int64_t length = values->length();
+    std::vector<int8_t> kinds(length, RowKind::Insert()->ToByteValue());
+    int64_t offset = 0;
+    for (size_t i = 0; i < batches.size(); ++i) {
+        const auto& batch_kinds = row_kinds[i];
+        if (!batch_kinds.empty()) {
+            if (static_cast<int64_t>(batch_kinds.size()) != batches[i]->length()) {
+                return Status::Invalid(fmt::format(
+                    "row kind count {} mismatches batch length {} in columnar merge",
+                    batch_kinds.size(), batches[i]->length()));
+            }
+            for (size_t j = 0; j < batch_kinds.size(); ++j) {
+                kinds[offset + j] = static_cast<int8_t>(batch_kinds[j]);
+            }
+        }
+        offset += batches[i]->length();
+    }
+
+    // 2. sort once and detect runs of equal keys
+    PAIMON_ASSIGN_OR_RAISE(std::shared_ptr<arrow::UInt64Array> sorted, SortIndices(values));
+    const uint64_t* sorted_indices = sorted->raw_values();
+    PAIMON_ASSIGN_OR_RAISE(std::vector<uint8_t> run_starts,
+                           DetectRunStarts(values, sorted_indices, length));
+
+    // 3. resolve runs to a selection vector, index >= length refers to merged_rows
+    bool pick_winner = merge_engine_ == MergeEngine::DEDUPLICATE ||
+                       merge_engine_ == MergeEngine::FIRST_ROW;
+    arrow::ArrayVector key_fields;
+    if (!pick_winner) {
+        key_fields.reserve(trimmed_primary_keys_.size());
+        for (const auto& key : trimmed_primary_keys_) {
+            key_fields.push_back(values->GetFieldByName(key));
+        }
+    }
+    std::vector<int64_t> selection;
+    selection.reserve(length);
+    std::vector<KeyValue> merged_rows;
+    int64_t run_begin = 0;
+    for (int64_t i = 1; i <= length; ++i) {
+        if (i < length && !run_starts[i]) {
+            continue;
+        }
+        if (i - run_begin == 1) {
+            selection.push_back(static_cast<int64_t>(sorted_indices[run_begin]));
+        } else if (pick_winner) {
+            PAIMON_RETURN_NOT_OK(PickWinner(sorted_indices, kinds, run_begin, i, &selection));
+        } else {
+            size_t merged_count = merged_rows.size();
+            PAIMON_RETURN_NOT_OK(MergeRun(values, key_fields, sorted_indices, kinds,
+                                          first_sequence_number, run_begin, i, &merged_rows));
+            if (merged_rows.size() > merged_count) {
+                selection.push_back(length + static_cast<int64_t>(merged_count));
+            }
+        }
+        run_begin = i;
+    }
+    // 4. assemble output in write schema with a single take
+    return AssembleOutput(values, kinds, first_sequence_number, merged_rows, selection);
+}
+
+Result<std::shared_ptr<arrow::StructArray>> ColumnarKeyValueMerger::Concatenate(
+    const std::vector<std::shared_ptr<arrow::StructArray>>& batches) const {
+    if (batches.empty()) {
+        return Status::Invalid("cannot merge empty batches");
+    }
+    if (batches.size() == 1) {
+        return batches[0];
+    }
+    arrow::ArrayVector arrays(batches.begin(), batches.end());
+    PAIMON_ASSIGN_OR_RAISE_FROM_ARROW(std::shared_ptr<arrow::Array> concatenated,
+                                      arrow::Concatenate(arrays, arrow_pool_.get()));
+    return arrow::internal::checked_pointer_cast<arrow::StructArray>(concatenated);
+}
+
+Result<std::shared_ptr<arrow::UInt64Array>> ColumnarKeyValueMerger::SortIndices(
+    const std::shared_ptr<arrow::StructArray>& values) const {
+    // sort is stable, rows with equal keys and sequence fields keep the order of sequence number
+    std::vector<RadixSorter::SortKey> radix_keys;
+    radix_keys.reserve(trimmed_primary_keys_.size() + sequence_fields_.size());
+    for (const auto& name : trimmed_primary_keys_) {
+        radix_keys.emplace_back(values->GetFieldByName(name), /*ascending=*/true);
+    }
+    for (const auto& name : sequence_fields_) {
+        radix_keys.emplace_back(values->GetFieldByName(name), sequence_ascending_);
+    }
+    if (RadixSorter::IsSupported(radix_keys)) {
+        return RadixSorter::SortIndices(radix_keys, values->length(), arrow_pool_.get());
+    }
+    std::vector<arrow::compute::SortKey> sort_keys;
+    sort_keys.reserve(trimmed_primary_keys_.size() + sequence_fields_.size());
+    for (const auto& name : trimmed_primary_keys_) {
+        sort_keys.emplace_back(name, arrow::compute::SortOrder::Ascending);
+    }
+    auto sequence_order = sequence_ascending_ ? arrow::compute::SortOrder::Ascending
+                                              : arrow::compute::SortOrder::Descending;
+    for (const auto& name : sequence_fields_) {
+        sort_keys.emplace_back(name, sequence_order);
+    }
+    arrow::compute::SortOptions sort_options(sort_keys, arrow::compute::NullPlacement::AtStart);
+    arrow::compute::ExecContext ctx(arrow_pool_.get());
+    PAIMON_ASSIGN_OR_RAISE_FROM_ARROW(
+        std::shared_ptr<arrow::Array> sorted_indices,
+        arrow::compute::SortIndices(arrow::Datum(values), sort_options, &ctx));
+    auto typed_indices = arrow::internal::checked_pointer_cast<arrow::UInt64Array>(sorted_indices);
+    if (!typed_indices) {
+        return Status::Invalid("cannot cast sorted indices to UInt64Array");
+    }
+    return typed_indices;
+}
+
+Result<std::vector<uint8_t>> ColumnarKeyValueMerger::DetectRunStarts(
+    const std::shared_ptr<arrow::StructArray>& values, const uint64_t* sorted_indices,
+    int64_t length) const {
+    std::vector<uint8_t> run_starts(length, 0);
+    if (length == 0) {
+        return run_starts;
+    }
+    run_starts[0] = 1;
+    for (const auto& key : trimmed_primary_keys_) {
+        auto key_array = values->GetFieldByName(key);
+        if (!key_array) {
+            return Status::Invalid(fmt::format("cannot find field {} in data batch", key));
+        }
+        switch (key_array->type_id()) {
+            case arrow::Type::type::BOOL:
+                MarkKeyChanges<arrow::BooleanArray>(*key_array, sorted_indices, length,
+                                                    &run_starts);
+                break;
+            case arrow::Type::type::INT8:
+                MarkKeyChanges<arrow::Int8Array>(*key_array, sorted_indices, length, &run_starts);
+                break;
+            case arrow::Type::type::INT16:
+                MarkKeyChanges<arrow::Int16Array>(*key_array, sorted_indices, length,
+                                                  &run_starts);
+                break;
+            case arrow::Type::type::INT32:
+                MarkKeyChanges<arrow::Int32Array>(*key_array, sorted_indices, length,
+                                                  &run_starts);
+                break;
+            case arrow::Type::type::INT64:
+                MarkKeyChanges<arrow::Int64Array>(*key_array, sorted_indices, length,
+                                                  &run_starts);
+                break;
+            case arrow::Type::type::FLOAT:
+                MarkKeyChanges<arrow::FloatArray>(*key_array, sorted_indices, length,
+                                                  &run_starts);
+                break;
+            case arrow::Type::type::DOUBLE:
+                MarkKeyChanges<arrow::DoubleArray>(*key_array, sorted_indices, length,
+                                                   &run_starts);
+                break;
+            case arrow::Type::type::DATE32:
+                MarkKeyChanges<arrow::Date32Array>(*key_array, sorted_indices, length,
+                                                   &run_starts);
+                break;
+            case arrow::Type::type::TIMESTAMP:
+                MarkKeyChanges<arrow::TimestampArray>(*key_array, sorted_indices, length,
+                                                      &run_starts);
+                break;
+            case arrow::Type::type::DECIMAL128:
+                MarkKeyChanges<arrow::Decimal128Array>(*key_array, sorted_indices, length,
+                                                       &run_starts);
+                break;
+            case arrow::Type::type::STRING:
+                MarkKeyChanges<arrow::StringArray>(*key_array, sorted_indices, length,
+                                                   &run_starts);
+                break;
+            case arrow::Type::type::BINARY:
+                MarkKeyChanges<arrow::BinaryArray>(*key_array, sorted_indices, length,
+                                                   &run_starts);
+                break;
+            default:
+                return Status::NotImplemented(
+                    fmt::format("columnar merge does not support key type {}",
+                                key_array->type()->ToString()));
+        }
+    }
+    return run_starts;
+}
+
+Status ColumnarKeyValueMerger::PickWinner(const uint64_t* sorted_indices,
+                                          const std::vector<int8_t>& kinds, int64_t begin,
+                                          int64_t end, std::vector<int64_t>* selection) const {
+    if (merge_engine_ == MergeEngine::DEDUPLICATE) {
+        // keep the latest row, retract rows are skipped when ignore delete
+        for (int64_t i = end - 1; i >= begin; --i) {
+            auto index = static_cast<int64_t>(sorted_indices[i]);
+            if (ignore_delete_ && IsRetractKind(kinds[index])) {
+                continue;
+            }
+            selection->push_back(index);
+            return Status::OK();
+        }
+        return Status::OK();
+    }
+    // first row merge engine keeps the first add row
+    std::optional<int64_t> winner;
+    for (int64_t i = begin; i < end; ++i) {
+        auto index = static_cast<int64_t>(sorted_indices[i]);
+        if (IsRetractKind(kinds[index])) {
+            if (ignore_delete_) {
+                continue;
+            }
+            return Status::Invalid(
+                "By default, First row merge engine can not accept DELETE/UPDATE_BEFORE "
+                "records. You can config 'first-row.ignore-delete' to ignore the "
+                "DELETE/UPDATE_BEFORE records.");
+        }
+        if (winner == std::nullopt) {
+            winner = index;
+        }
+    }
+    if (winner != std::nullopt) {
+        selection->push_back(winner.value());
+    }
+    return Status::OK();
+}
+
+Status ColumnarKeyValueMerger::MergeRun(const std::shared_ptr<arrow::StructArray>& values,
+                                        const arrow::ArrayVector& key_fields,
+                                        const uint64_t* sorted_indices,
+                                        const std::vector<int8_t>& kinds,
+                                        int64_t first_sequence_number, int64_t begin, int64_t end,
+                                        std::vector<KeyValue>* merged_rows) const {
+    merge_function_wrapper_->Reset();
+    for (int64_t i = begin; i < end; ++i) {
+        auto index = static_cast<int64_t>(sorted_indices[i]);
+        PAIMON_ASSIGN_OR_RAISE(const RowKind* row_kind, RowKind::FromByteValue(kinds[index]));
+        auto key = std::make_unique<ColumnarRow>(values, key_fields, pool_, index);
+        auto value = std::make_unique<ColumnarRow>(values, values->fields(), pool_, index);
+        KeyValue kv(row_kind, first_sequence_number + index,
+                    /*level=*/KeyValue::UNKNOWN_LEVEL, std::move(key), std::move(value));
+        PAIMON_RETURN_NOT_OK(merge_function_wrapper_->Add(std::move(kv)));
+    }
+    PAIMON_ASSIGN_OR_RAISE(std::optional<KeyValue> result, merge_function_wrapper_->GetResult());
+    if (result != std::nullopt) {
+        merged_rows->push_back(std::move(result).value());
+    }
+    return Status::OK();
+}
+
+Result<std::shared_ptr<arrow::StructArray>> ColumnarKeyValueMerger::AssembleOutput(
+    const std::shared_ptr<arrow::StructArray>& values, const std::vector<int8_t>& kinds,
+    int64_t first_sequence_number, const std::vector<KeyValue>& merged_rows,
+    const std::vector<int64_t>& selection) const {
+    int64_t length = values->length();
+    arrow::Int64Builder sequence_builder(arrow_pool_.get());
+    PAIMON_RETURN_NOT_OK_FROM_ARROW(sequence_builder.Reserve(length));
+    for (int64_t i = 0; i < length; ++i) {
+        sequence_builder.UnsafeAppend(first_sequence_number + i);
+    }
+    std::shared_ptr<arrow::Array> sequence_array;
+    PAIMON_RETURN_NOT_OK_FROM_ARROW(sequence_builder.Finish(&sequence_array));
+    arrow::Int8Builder kind_builder(arrow_pool_.get());
+    PAIMON_RETURN_NOT_OK_FROM_ARROW(kind_builder.AppendValues(kinds));
+    std::shared_ptr<arrow::Array> kind_array;
+    PAIMON_RETURN_NOT_OK_FROM_ARROW(kind_builder.Finish(&kind_array));
+
+    arrow::ArrayVector children = {sequence_array, kind_array};
+    children.insert(children.end(), values->fields().begin(), values->fields().end());
+    PAIMON_ASSIGN_OR_RAISE_FROM_ARROW(std::shared_ptr<arrow::StructArray> candidates,
+                                      arrow::StructArray::Make(children, write_schema_->fields()));
+    if (!merged_rows.empty()) {
+        PAIMON_ASSIGN_OR_RAISE(std::unique_ptr<KeyValueMetaProjectionConsumer> consumer,
+                               KeyValueMetaProjectionConsumer::Create(write_schema_, pool_));
+        PAIMON_ASSIGN_OR_RAISE(KeyValueBatch merged_batch, consumer->NextBatch(merged_rows));
+        PAIMON_ASSIGN_OR_RAISE_FROM_ARROW(
+            std::shared_ptr<arrow::Array> merged_array,
+            arrow::ImportArray(merged_batch.batch.get(), candidates->type()));
+        PAIMON_ASSIGN_OR_RAISE_FROM_ARROW(
+            std::shared_ptr<arrow::Array> concatenated,
+            arrow::Concatenate({candidates, merged_array}, arrow_pool_.get()));
+        candidates = arrow::internal::checked_pointer_cast<arrow::StructArray>(concatenated);
+    }
+    if (static_cast<int64_t>(selection.size()) == length && merged_rows.empty() &&
+        std::is_sorted(selection.begin(), selection.end())) {
+        // already sorted and no row merged, e.g., sorted input with unique keys
+        return candidates;
+    }
+    arrow::Int64Builder selection_builder(arrow_pool_.get());
+    PAIMON_RETURN_NOT_OK_FROM_ARROW(selection_builder.AppendValues(selection));
+    std::shared_ptr<arrow::Array> selection_array;
+    PAIMON_RETURN_NOT_OK_FROM_ARROW(selection_builder.Finish(&selection_array));
+    arrow::compute::ExecContext ctx(arrow_pool_.get());
+    PAIMON_ASSIGN_OR_RAISE_FROM_ARROW(
+        arrow::Datum taken,
+        arrow::compute::Take(arrow::Datum(candidates), arrow::Datum(selection_array),
+                             arrow::compute::TakeOptions::Defaults(), &ctx));
+    return arrow::internal::checked_pointer_cast<arrow::StructArray>(taken.make_array());
+}
+
+Result<KeyValueBatch> ColumnarKeyValueMerger::ToKeyValueBatch(
+    const std::shared_ptr<arrow::StructArray>& merged, int64_t offset, int64_t length) const {
+    if (length <= 0 || offset + length > merged->length()) {
+        return Status::Invalid(fmt::format("invalid slice [{}, {}) of merged array with length {}",
+                                           offset, offset + length, merged->length()));
+    }
+    auto slice = arrow::internal::checked_pointer_cast<arrow::StructArray>(
+        merged->Slice(offset, length));
+    const auto& sequence_array =
+        arrow::internal::checked_cast<const arrow::Int64Array&>(*slice->field(0));
+    const auto& kind_array =
+        arrow::internal::checked_cast<const arrow::Int8Array&>(*slice->field(1));
+    KeyValueBatch key_value_batch;
+    for (int64_t i = 0; i < length; ++i) {
+        if (IsRetractKind(kind_array.Value(i))) {
+            key_value_batch.delete_row_count++;
+        }
+        int64_t sequence_number = sequence_array.Value(i);
+        key_value_batch.min_sequence_number =
+            std::min(key_value_batch.min_sequence_number, sequence_number);
+        key_value_batch.max_sequence_number =
+            std::max(key_value_batch.max_sequence_number, sequence_number);
+    }
+    arrow::ArrayVector key_fields;
+    key_fields.reserve(trimmed_primary_keys_.size());
+    for (const auto& key : trimmed_primary_keys_) {
+        auto key_array = slice->GetFieldByName(key);
+        if (!key_array) {
+            return Status::Invalid(fmt::format("cannot find field {} in merged batch", key));
+        }
+        key_fields.push_back(key_array);
+    }
+    key_value_batch.min_key = std::make_shared<ColumnarRow>(slice, key_fields, pool_, 0);
+    key_value_batch.max_key = std::make_shared<ColumnarRow>(slice, key_fields, pool_, length - 1);
+    key_value_batch.batch = std::make_unique<ArrowArray>();
+    PAIMON_RETURN_NOT_OK_FROM_ARROW(arrow::ExportArray(*slice, key_value_batch.batch.get()));
+    return std::move(key_value_batch);
+}
+
+}  // namespace paimon
@@ -0,0 +1,125 @@
+/*
+ * Copyright 2024-present Alibaba Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "arrow/api.h"
+#include "paimon/core/key_value.h"
+#include "paimon/core/options/merge_engine.h"
+#include "paimon/record_batch.h"
+#include "paimon/result.h"
+#include "paimon/status.h"
+
+namespace arrow {
+class MemoryPool;
+class Schema;
+class StructArray;
+}  // namespace arrow
+
+namespace paimon {
+class CoreOptions;
+class MemoryPool;
+class RowKind;
+template <typename T>
+class MergeFunctionWrapper;
+
+/// Sorts and merges the buffered record batches of a write buffer in columnar form.
+///
+/// All batches are concatenated and sorted once by (primary keys, user defined sequence fields,
+/// sequence number), runs of equal keys are detected with typed column comparisons. A run with a
+/// single row is taken as is, runs of deduplicate and first-row merge engines are resolved by
+/// picking the winner index directly. Only runs that need the real merge function (e.g.,
+/// partial-update and aggregation) are materialized as `KeyValue` and go through
+/// `MergeFunctionWrapper`. The output is assembled with a single take in write schema order
+/// (sequence number, value kind, value fields).
+class ColumnarKeyValueMerger {
+ public:
+    /// @return nullptr if any primary key type is not supported by columnar run detection, the
+    /// caller is expected to fall back to the row-based sort merge reader.
+    static std::unique_ptr<ColumnarKeyValueMerger> Create(
+        const std::shared_ptr<arrow::Schema>& value_schema,
+        const std::shared_ptr<arrow::Schema>& write_schema,
+        const std::vector<std::string>& trimmed_primary_keys, const CoreOptions& options,
+        const std::shared_ptr<MergeFunctionWrapper<KeyValue>>& merge_function_wrapper,
+        const std::shared_ptr<MemoryPool>& pool);
+
+    /// Merges `batches` whose rows are assigned with continuous sequence numbers starting from
+    /// `first_sequence_number`. An empty row kind vector indicates all rows are inserts.
+    /// @return the merged array in write schema, sorted by primary keys.
+    Result<std::shared_ptr<arrow::StructArray>> Merge(
+        const std::vector<std::shared_ptr<arrow::StructArray>>& batches,
+        const std::vector<std::vector<RecordBatch::RowKind>>& row_kinds,
+        int64_t first_sequence_number) const;
+
+    /// Exports [offset, offset + length) of a merged array as `KeyValueBatch`, collects delete
+    /// row count, min/max key and min/max sequence number.
+    Result<KeyValueBatch> ToKeyValueBatch(const std::shared_ptr<arrow::StructArray>& merged,
+                                          int64_t offset, int64_t length) const;
+
+    static bool IsSupportedKeyType(const arrow::DataType& type);
+
+ private:
+    ColumnarKeyValueMerger(const std::shared_ptr<arrow::Schema>& write_schema,
+                           const std::vector<std::string>& trimmed_primary_keys,
+                           const std::vector<std::string>& sequence_fields,
+                           bool sequence_ascending, MergeEngine merge_engine, bool ignore_delete,
+                           const std::shared_ptr<MergeFunctionWrapper<KeyValue>>& wrapper,
+                           const std::shared_ptr<MemoryPool>& pool);
+
+    Result<std::shared_ptr<arrow::StructArray>> Concatenate(
+        const std::vector<std::shared_ptr<arrow::StructArray>>& batches) const;
+
+    Result<std::shared_ptr<arrow::UInt64Array>> SortIndices(
+        const std::shared_ptr<arrow::StructArray>& values) const;
+
+    /// Marks the sorted positions that start a new key, position 0 always starts a run.
+    Result<std::vector<uint8_t>> DetectRunStarts(const std::shared_ptr<arrow::StructArray>& values,
+                                                 const uint64_t* sorted_indices,
+                                                 int64_t length) const;
+
+    /// Resolves the sorted run [begin, end) of deduplicate or first-row merge engine, appends
+    /// the winner index (if any) to `selection`.
+    Status PickWinner(const uint64_t* sorted_indices, const std::vector<int8_t>& kinds,
+                      int64_t begin, int64_t end, std::vector<int64_t>* selection) const;
+
+    /// Merges the sorted run [begin, end) with the merge function, appends the result (if any)
+    /// to `merged_rows`.
+    Status MergeRun(const std::shared_ptr<arrow::StructArray>& values,
+                    const arrow::ArrayVector& key_fields, const uint64_t* sorted_indices,
+                    const std::vector<int8_t>& kinds, int64_t first_sequence_number,
+                    int64_t begin, int64_t end, std::vector<KeyValue>* merged_rows) const;
+
+    Result<std::shared_ptr<arrow::StructArray>> AssembleOutput(
+        const std::shared_ptr<arrow::StructArray>& values, const std::vector<int8_t>& kinds,
+        int64_t first_sequence_number, const std::vector<KeyValue>& merged_rows,
+        const std::vector<int64_t>& selection) const;
+
+ private:
+    std::shared_ptr<arrow::Schema> write_schema_;
+    std::vector<std::string> trimmed_primary_keys_;
+    std::vector<std::string> sequence_fields_;
+    bool sequence_ascending_;
+    MergeEngine merge_engine_;
+    bool ignore_delete_;
+    std::shared_ptr<MergeFunctionWrapper<KeyValue>> merge_function_wrapper_;
+    std::shared_ptr<MemoryPool> pool_;
+    std::unique_ptr<arrow::MemoryPool> arrow_pool_;
+};
+}  // namespace paimon
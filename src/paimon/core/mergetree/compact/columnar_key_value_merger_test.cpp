@@ -0,0 +1,197 @@
+/*
+ * Copyright 2024-present Alibaba Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "paimon/core/mergetree/compact/columnar_key_value_merger.h"
+
+#include <map>
+#include <string>
+#include <utility>
+
+#include "arrow/api.h"
+#include "arrow/array/array_base.h"
+#include "arrow/array/array_nested.h"
+#include "arrow/c/bridge.h"
+#include "arrow/ipc/json_simple.h"
+#include "gtest/gtest.h"
+#include "paimon/common/table/special_fields.h"
+#include "paimon/common/types/data_field.h"
+#include "paimon/core/core_options.h"
+#include "paimon/core/mergetree/compact/merge_function.h"
+#include "paimon/core/mergetree/compact/reducer_merge_function_wrapper.h"
+#include "paimon/core/utils/primary_key_table_utils.h"
+#include "paimon/defs.h"
+#include "paimon/memory/memory_pool.h"
+#include "paimon/status.h"
+#include "paimon/testing/utils/testharness.h"
+
+namespace paimon::test {
+class ColumnarKeyValueMergerTest : public testing::Test {
+ public:
+    void SetUp() override {
+        pool_ = GetDefaultPool();
+        value_schema_ = arrow::schema({arrow::field("k0", arrow::int32()),
+                                       arrow::field("v0", arrow::utf8()),
+                                       arrow::field("v1", arrow::int32())});
+        arrow::FieldVector write_fields = {
+            DataField::ConvertDataFieldToArrowField(SpecialFields::SequenceNumber()),
+            DataField::ConvertDataFieldToArrowField(SpecialFields::ValueKind())};
+        write_fields.insert(write_fields.end(), value_schema_->fields().begin(),
+                            value_schema_->fields().end());
+        write_schema_ = arrow::schema(write_fields);
+    }
+
+    std::unique_ptr<ColumnarKeyValueMerger> CreateMerger(
+        const std::map<std::string, std::string>& options_map) const {
+        auto options = CoreOptions::FromMap(options_map).value();
+        auto merge_function =
+            PrimaryKeyTableUtils::CreateMergeFunction(value_schema_, {"k0"}, options).value();
+        auto wrapper = std::make_shared<ReducerMergeFunctionWrapper>(std::move(merge_function));
+        return ColumnarKeyValueMerger::Create(value_schema_, write_schema_, {"k0"}, options,
+                                              wrapper, pool_);
+    }
+
+    std::shared_ptr<arrow::StructArray> MakeValues(const std::string& json) const {
+        return std::dynamic_pointer_cast<arrow::StructArray>(
+            arrow::ipc::internal::json::ArrayFromJSON(arrow::struct_(value_schema_->fields()),
+                                                      json)
+                .ValueOrDie());
+    }
+
+    std::shared_ptr<arrow::Array> MakeExpected(const std::string& json) const {
+        return arrow::ipc::internal::json::ArrayFromJSON(arrow::struct_(write_schema_->fields()),
+                                                         json)
+            .ValueOrDie();
+    }
+
+    Result<std::shared_ptr<arrow::StructArray>> Merge(const ColumnarKeyValueMerger& merger) const {
+        std::vector<std::shared_ptr<arrow::StructArray>> batches = {
+            MakeValues(R"([[1, "a", null], [2, "b", 20], [1, null, 10]])"),
+            MakeValues(R"([[3, "d", 30], [2, "e", 21]])")};
+        std::vector<std::vector<RecordBatch::RowKind>> row_kinds = {
+            {}, {RecordBatch::RowKind::INSERT, RecordBatch::RowKind::DELETE}};
+        return merger.Merge(batches, row_kinds, /*first_sequence_number=*/0);
+    }
+
+ private:
+    std::shared_ptr<MemoryPool> pool_;
+    std::shared_ptr<arrow::Schema> value_schema_;
+    std::shared_ptr<arrow::Schema> write_schema_;
+};
+
+TEST_F(ColumnarKeyValueMergerTest, TestDeduplicate) {
+    {
+        auto merger = CreateMerger({});
+        ASSERT_TRUE(merger);
+        ASSERT_OK_AND_ASSIGN(std::shared_ptr<arrow::StructArray> merged, Merge(*merger));
+        auto expected = MakeExpected(R"([
+            [2, 0, 1, null, 10],
+            [4, 3, 2, "e", 21],
+            [3, 0, 3, "d", 30]
+        ])");
+        ASSERT_TRUE(expected->Equals(*merged)) << merged->ToString();
+    }
+    {
+        auto merger = CreateMerger({{Options::IGNORE_DELETE, "true"}});
+        ASSERT_TRUE(merger);
+        ASSERT_OK_AND_ASSIGN(std::shared_ptr<arrow::StructArray> merged, Merge(*merger));
+        auto expected = MakeExpected(R"([
+            [2, 0, 1, null, 10],
+            [1, 0, 2, "b", 20],
+            [3, 0, 3, "d", 30]
+        ])");
+        ASSERT_TRUE(expected->Equals(*merged)) << merged->ToString();
+    }
+}
+
+TEST_F(ColumnarKeyValueMergerTest, TestDeduplicateWithSequenceField) {
+    auto merger = CreateMerger({{Options::SEQUENCE_FIELD, "v1"}});
+    ASSERT_TRUE(merger);
+    std::vector<std::shared_ptr<arrow::StructArray>> batches = {
+        MakeValues(R"([[1, "a", 30], [1, "b", 10], [2, "c", null]])"),
+        MakeValues(R"([[1, "d", 20], [2, "e", 5]])")};
+    ASSERT_OK_AND_ASSIGN(std::shared_ptr<arrow::StructArray> merged,
+                         merger->Merge(batches, {{}, {}}, /*first_sequence_number=*/10));
+    auto expected = MakeExpected(R"([
+        [10, 0, 1, "a", 30],
+        [14, 0, 2, "e", 5]
+    ])");
+    ASSERT_TRUE(expected->Equals(*merged)) << merged->ToString();
+}
+
+TEST_F(ColumnarKeyValueMergerTest, TestFirstRow) {
+    {
+        auto merger = CreateMerger(
+            {{Options::MERGE_ENGINE, "first-row"}, {Options::IGNORE_DELETE, "true"}});
+        ASSERT_TRUE(merger);
+        ASSERT_OK_AND_ASSIGN(std::shared_ptr<arrow::StructArray> merged, Merge(*merger));
+        auto expected = MakeExpected(R"([
+            [0, 0, 1, "a", null],
+            [1, 0, 2, "b", 20],
+            [3, 0, 3, "d", 30]
+        ])");
+        ASSERT_TRUE(expected->Equals(*merged)) << merged->ToString();
+    }
+    {
+        auto merger = CreateMerger({{Options::MERGE_ENGINE, "first-row"}});
+        ASSERT_TRUE(merger);
+        ASSERT_NOK_WITH_MSG(Merge(*merger),
+                            "First row merge engine can not accept DELETE/UPDATE_BEFORE");
+    }
+}
+
+TEST_F(ColumnarKeyValueMergerTest, TestPartialUpdate) {
+    auto merger = CreateMerger({{Options::MERGE_ENGINE, "partial-update"},
+                                {Options::IGNORE_DELETE, "true"}});
+    ASSERT_TRUE(merger);
+    ASSERT_OK_AND_ASSIGN(std::shared_ptr<arrow::StructArray> merged, Merge(*merger));
+    // key 3 is not merged and taken directly, key 1 and key 2 go through merge function
+    auto expected = MakeExpected(R"([
+        [2, 0, 1, "a", 10],
+        [1, 0, 2, "b", 20],
+        [3, 0, 3, "d", 30]
+    ])");
+    ASSERT_TRUE(expected->Equals(*merged)) << merged->ToString();
+}
+
+TEST_F(ColumnarKeyValueMergerTest, TestToKeyValueBatch) {
+    auto merger = CreateMerger({});
+    ASSERT_TRUE(merger);
+    ASSERT_OK_AND_ASSIGN(std::shared_ptr<arrow::StructArray> merged, Merge(*merger));
+    ASSERT_OK_AND_ASSIGN(KeyValueBatch key_value_batch,
+                         merger->ToKeyValueBatch(merged, /*offset=*/1, /*length=*/2));
+    ASSERT_EQ(1, key_value_batch.delete_row_count);
+    ASSERT_EQ(3, key_value_batch.min_sequence_number);
+    ASSERT_EQ(4, key_value_batch.max_sequence_number);
+    ASSERT_EQ(2, key_value_batch.min_key->GetInt(0));
+    ASSERT_EQ(3, key_value_batch.max_key->GetInt(0));
+    auto exported = arrow::ImportArray(key_value_batch.batch.get(), merged->type()).ValueOrDie();
+    ASSERT_TRUE(exported->Equals(*merged->Slice(1, 2))) << exported->ToString();
+
+    ASSERT_NOK_WITH_MSG(merger->ToKeyValueBatch(merged, /*offset=*/2, /*length=*/2),
+                        "invalid slice");
+}
+
+TEST_F(ColumnarKeyValueMergerTest, TestUnsupportedKeyType) {
+    auto value_schema = arrow::schema({arrow::field("k0", arrow::list(arrow::int32())),
+                                       arrow::field("v0", arrow::int32())});
+    auto options = CoreOptions::FromMap(std::map<std::string, std::string>()).value();
+    ASSERT_FALSE(ColumnarKeyValueMerger::Create(value_schema, value_schema, {"k0"}, options,
+                                                /*merge_function_wrapper=*/nullptr, pool_));
+    ASSERT_TRUE(ColumnarKeyValueMerger::IsSupportedKeyType(*arrow::utf8()));
+    ASSERT_FALSE(ColumnarKeyValueMerger::IsSupportedKeyType(*arrow::struct_({})));
+}
+
+}  // namespace paimon::test
@@ -21,13 +21,15 @@
 
 namespace paimon {
 LoserTree::LoserTree(std::vector<std::unique_ptr<KeyValueRecordReader>>&& readers,
-                     const CompareFunc& first_comparator, const CompareFunc& second_comparator)
+                     const CompareFunc& first_comparator, const CompareFunc& second_comparator,
+                     const std::shared_ptr<FieldsComparator>& normalized_key_comparator)
     : size_(readers.size()),
       initialized_(false),
       readers_holder_(std::move(readers)),
       tree_(size_),
       first_comparator_(first_comparator),
-      second_comparator_(second_comparator) {
+      second_comparator_(second_comparator),
+      normalized_key_comparator_(normalized_key_comparator) {
     leaves_.reserve(size_);
     for (const auto& reader : readers_holder_) {
         leaves_.emplace_back(reader.get());
@@ -38,7 +40,7 @@ Status LoserTree::InitializeIfNeeded() {
     if (!initialized_) {
         std::fill(tree_.begin(), tree_.end(), -1);
         for (int32_t i = size_ - 1; i >= 0; i--) {
-            PAIMON_RETURN_NOT_OK(leaves_[i].AdvanceIfAvailable());
+            PAIMON_RETURN_NOT_OK(leaves_[i].AdvanceIfAvailable(normalized_key_comparator_.get()));
             Adjust(i);
         }
         initialized_ = true;
@@ -49,7 +51,7 @@ Status LoserTree::InitializeIfNeeded() {
 Status LoserTree::AdjustForNextLoop() {
     LeafIterator* winner = &leaves_[tree_[0]];
     while (winner->state == State::WINNER_POPPED) {
-        PAIMON_RETURN_NOT_OK(winner->AdvanceIfAvailable());
+        PAIMON_RETURN_NOT_OK(winner->AdvanceIfAvailable(normalized_key_comparator_.get()));
         Adjust(tree_[0]);
         winner = &leaves_[tree_[0]];
     }
@@ -153,7 +155,7 @@ void LoserTree::AdjustWithNewWinnerKey(int32_t index, LeafIterator* parent_node,
             // when the new winner is also a new key, it needs to be compared.
             const auto& parent_key = parent_node->Peek();
             const auto& child_key = winner_node->Peek();
-            int32_t first_result = first_comparator_(parent_key, child_key);
+            int32_t first_result = CompareKey(*parent_node, *winner_node);
             if (first_result == 0) {
                 // if the compared keys are the same, we need to update the state of the node
                 // and record the index of the same key for the winner.
@@ -191,4 +193,17 @@ void LoserTree::AdjustWithNewWinnerKey(int32_t index, LeafIterator* parent_node,
     }
 }
 
+int32_t LoserTree::CompareKey(const LeafIterator& parent_node,
+                              const LeafIterator& winner_node) const {
+    const auto& parent_key = parent_node.Peek();
+    const auto& child_key = winner_node.Peek();
+    if (normalized_key_comparator_ && parent_key != std::nullopt && child_key != std::nullopt) {
+        // child and parent are swapped as in first_comparator_, so that the smaller key wins
+        return normalized_key_comparator_->CompareTo(
+            winner_node.normalized_key, *(child_key.value().key), parent_node.normalized_key,
+            *(parent_key.value().key));
+    }
+    return first_comparator_(parent_key, child_key);
+}
+
 }  // namespace paimon
@@ -25,6 +25,7 @@
 #include "paimon/common/metrics/metrics_impl.h"
 #include "paimon/core/io/key_value_record_reader.h"
 #include "paimon/core/key_value.h"
+#include "paimon/core/utils/fields_comparator.h"
 #include "paimon/result.h"
 #include "paimon/status.h"
 
@@ -35,8 +36,12 @@ class LoserTree {
  public:
     using CompareFunc =
         std::function<int32_t(const std::optional<KeyValue>&, const std::optional<KeyValue>&)>;
+    /// @param normalized_key_comparator the user key comparator if keys are compared by their
+    /// normalized keys before `first_comparator`, otherwise nullptr. The normalized key of each
+    /// key is encoded once when it is read.
     LoserTree(std::vector<std::unique_ptr<KeyValueRecordReader>>&& readers,
-              const CompareFunc& first_comparator, const CompareFunc& second_comparator);
+              const CompareFunc& first_comparator, const CompareFunc& second_comparator,
+              const std::shared_ptr<FieldsComparator>& normalized_key_comparator);
 
     /// Initialize the loser tree in the same way as the regular loser tree.
     Status InitializeIfNeeded();
@@ -76,6 +81,9 @@ class LoserTree {
     void AdjustWithNewWinnerKey(int32_t index, LeafIterator* parent_node,
                                 LeafIterator* winner_node);
 
+    /// Same as `first_comparator_`, but compares normalized keys first if enabled.
+    int32_t CompareKey(const LeafIterator& parent_node, const LeafIterator& winner_node) const;
+
  private:
     enum class State {
         LOSER_WITH_NEW_KEY = 1,
@@ -112,8 +120,9 @@ class LoserTree {
             }
         }
 
-        /// Reads the next kv if any, otherwise returns null.
-        Status AdvanceIfAvailable() {
+        /// Reads the next kv if any, otherwise returns null. Encodes the normalized key of the kv
+        /// with `normalized_key_comparator` if it is not nullptr.
+        Status AdvanceIfAvailable(const FieldsComparator* normalized_key_comparator) {
             first_same_key_index = -1;
             state = State::WINNER_WITH_NEW_KEY;
             if (iterator == nullptr || !iterator->HasNext()) {
@@ -132,6 +141,9 @@ class LoserTree {
             } else {
                 PAIMON_ASSIGN_OR_RAISE(kv, iterator->Next());
             }
+            if (normalized_key_comparator != nullptr && kv != std::nullopt) {
+                normalized_key = normalized_key_comparator->NormalizedKey(*(kv.value().key));
+            }
             return Status::OK();
         }
 
@@ -141,6 +153,7 @@ class LoserTree {
         KeyValueRecordReader* reader;
         std::unique_ptr<KeyValueRecordReader::Iterator> iterator;
         std::optional<KeyValue> kv;
+        uint64_t normalized_key = 0;
     };
 
  private:
@@ -157,5 +170,6 @@ class LoserTree {
     CompareFunc first_comparator_;
     /// same as first_comparator, but mainly used to compare sequenceNumber.
     CompareFunc second_comparator_;
+    std::shared_ptr<FieldsComparator> normalized_key_comparator_;
 };
 }  // namespace paimon
@@ -0,0 +1,87 @@
+/*
+ * Copyright 2024-present Alibaba Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "paimon/core/mergetree/compact/merge_tree_compact_manager.h"
+
+#include <utility>
+
+#include "paimon/common/executor/future.h"
+#include "paimon/core/mergetree/compact/merge_tree_compact_rewriter.h"
+#include "paimon/core/mergetree/compact/merge_tree_compact_task.h"
+#include "paimon/core/utils/fields_comparator.h"
+#include "paimon/executor.h"
+
+namespace paimon {
+
+MergeTreeCompactManager::MergeTreeCompactManager(
+    const std::shared_ptr<Executor>& executor, std::unique_ptr<Levels>&& levels,
+    const UniversalCompaction& strategy, const std::shared_ptr<FieldsComparator>& key_comparator,
+    int64_t compaction_file_size, int32_t num_sorted_run_stop_trigger,
+    const std::shared_ptr<MergeTreeCompactRewriter>& rewriter)
+    : executor_(executor),
+      levels_(std::move(levels)),
+      strategy_(strategy),
+      key_comparator_(key_comparator),
+      compaction_file_size_(compaction_file_size),
+      num_sorted_run_stop_trigger_(num_sorted_run_stop_trigger),
+      rewriter_(rewriter) {}
+
+Status MergeTreeCompactManager::TriggerCompaction(bool full_compaction) {
+    std::optional<CompactUnit> unit;
+    std::vector<LevelSortedRun> runs = levels_->LevelSortedRuns();
+    if (full_compaction) {
+        if (task_future_.valid()) {
+            return Status::Invalid(
+                "A compaction task is still running while the user forces a new compaction. This "
+                "is unexpected.");
+        }
+        unit = UniversalCompaction::PickFullCompaction(levels_->NumberOfLevels(), runs);
+    } else {
+        if (task_future_.valid()) {
+            return Status::OK();
+        }
+        unit = strategy_.Pick(levels_->NumberOfLevels(), runs);
+    }
+    if (!unit || unit->Files().empty()) {
+        return Status::OK();
+    }
+    // As long as there is no older data, we can drop the deletion. If the output level is 0,
+    // there may be older data not involved in compaction.
+    bool drop_delete =
+        unit->OutputLevel() != 0 && unit->OutputLevel() >= levels_->NonEmptyHighestLevel();
+    SubmitCompaction(unit.value(), drop_delete);
+    return Status::OK();
+}
+
+void MergeTreeCompactManager::SubmitCompaction(const CompactUnit& unit, bool drop_delete) {
+    auto task = std::make_shared<MergeTreeCompactTask>(key_comparator_, compaction_file_size_,
+                                                       rewriter_, unit, levels_->MaxLevel(),
+                                                       drop_delete);
+    // compaction is background work, it yields to reads and flushes sharing the executor
+    task_future_ = Via(
+        executor_.get(), [task]() -> Result<CompactResult> { return task->Run(); },
+        TaskPriority::LOW);
+}
+
+Result<std::optional<CompactResult>> MergeTreeCompactManager::GetCompactionResult(bool blocking) {
+    PAIMON_ASSIGN_OR_RAISE(std::optional<CompactResult> result, ObtainCompactResult(blocking));
+    if (result) {
+        PAIMON_RETURN_NOT_OK(levels_->Update(result->Before(), result->After()));
+    }
+    return result;
+}
+
+}  // namespace paimon
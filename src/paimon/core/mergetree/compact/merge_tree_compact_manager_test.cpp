@@ -0,0 +1,156 @@
+/*
+ * Copyright 2024-present Alibaba Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "paimon/core/mergetree/compact/merge_tree_compact_manager.h"
+
+#include <optional>
+#include <string>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "paimon/common/types/data_field.h"
+#include "paimon/core/manifest/file_source.h"
+#include "paimon/core/stats/simple_stats.h"
+#include "paimon/core/utils/fields_comparator.h"
+#include "paimon/data/timestamp.h"
+#include "paimon/executor.h"
+#include "paimon/memory/memory_pool.h"
+#include "paimon/testing/utils/binary_row_generator.h"
+#include "paimon/testing/utils/testharness.h"
+
+namespace paimon::test {
+// files in these tests do not overlap and are larger than the compaction file size, they are
+// upgraded without a rewriter
+class MergeTreeCompactManagerTest : public testing::Test {
+ public:
+    void SetUp() override {
+        ASSERT_OK_AND_ASSIGN(
+            comparator_,
+            FieldsComparator::Create({DataField(0, arrow::field("test", arrow::int32()))},
+                                     /*is_ascending_order=*/true, /*use_view=*/false));
+    }
+
+    std::shared_ptr<DataFileMeta> CreateDataFileMeta(const std::string& file_name, int32_t level,
+                                                     int32_t min_key, int32_t max_key,
+                                                     int64_t file_size,
+                                                     int64_t max_sequence_number) {
+        auto pool = GetDefaultPool();
+        return std::make_shared<DataFileMeta>(
+            file_name, file_size, /*row_count=*/1,
+            /*min_key=*/BinaryRowGenerator::GenerateRow({min_key}, pool.get()), /*max_key=*/
+            BinaryRowGenerator::GenerateRow({max_key}, pool.get()),
+            /*key_stats=*/
+            SimpleStats::EmptyStats(),
+            /*value_stats=*/
+            SimpleStats::EmptyStats(),
+            /*min_sequence_number=*/0, max_sequence_number, /*schema_id=*/0, level,
+            /*extra_files=*/std::vector<std::optional<std::string>>(),
+            /*creation_time=*/Timestamp(0ll, 0),
+            /*delete_row_count=*/0, /*embedded_index=*/nullptr, FileSource::Append(),
+            /*value_stats_cols=*/std::nullopt, /*external_path=*/std::nullopt,
+            /*first_row_id=*/std::nullopt,
+            /*write_cols=*/std::nullopt);
+    }
+
+    /// A manager of 4 levels with a large file in the max level.
+    std::unique_ptr<MergeTreeCompactManager> CreateManager(int32_t num_run_compaction_trigger,
+                                                           int32_t num_sorted_run_stop_trigger) {
+        auto large = CreateDataFileMeta("large", /*level=*/3, 100, 200, /*file_size=*/1000,
+                                        /*max_sequence_number=*/0);
+        auto levels = Levels::Create(comparator_, {large}, /*num_levels=*/4).value();
+        UniversalCompaction strategy(/*max_size_amp=*/200, /*size_ratio=*/1,
+                                     num_run_compaction_trigger);
+        return std::make_unique<MergeTreeCompactManager>(
+            executor_, std::move(levels), strategy, comparator_, /*compaction_file_size=*/50,
+            num_sorted_run_stop_trigger, /*rewriter=*/nullptr);
+    }
+
+    static std::vector<std::string> FileNames(
+        const std::vector<std::shared_ptr<DataFileMeta>>& files) {
+        std::vector<std::string> names;
+        for (const auto& file : files) {
+            names.push_back(file->file_name);
+        }
+        return names;
+    }
+
+ protected:
+    std::shared_ptr<FieldsComparator> comparator_;
+    std::shared_ptr<Executor> executor_ = CreateDefaultExecutor(/*thread_count=*/2);
+};
+
+TEST_F(MergeTreeCompactManagerTest, TestPickRunsByTrigger) {
+    auto manager = CreateManager(/*num_run_compaction_trigger=*/3,
+                                 /*num_sorted_run_stop_trigger=*/2);
+    manager->AddNewFile(CreateDataFileMeta("f1", /*level=*/0, 1, 10, /*file_size=*/100,
+                                           /*max_sequence_number=*/10));
+    ASSERT_OK(manager->TriggerCompaction(/*full_compaction=*/false));
+    // two sorted runs do not reach the trigger
+    ASSERT_FALSE(manager->CompactNotCompleted());
+    ASSERT_FALSE(manager->ShouldWaitForLatestCompaction());
+
+    manager->AddNewFile(CreateDataFileMeta("f2", /*level=*/0, 20, 30, /*file_size=*/100,
+                                           /*max_sequence_number=*/20));
+    ASSERT_TRUE(manager->ShouldWaitForLatestCompaction());
+    ASSERT_OK(manager->TriggerCompaction(/*full_compaction=*/false));
+    ASSERT_TRUE(manager->CompactNotCompleted());
+    ASSERT_OK_AND_ASSIGN(std::optional<CompactResult> result,
+                         manager->GetCompactionResult(/*blocking=*/true));
+    ASSERT_TRUE(result);
+    ASSERT_FALSE(manager->CompactNotCompleted());
+
+    // the level 0 files are picked by size ratio, the large file is not, so they are output to the
+    // level below the large file
+    ASSERT_EQ(FileNames(result->Before()), std::vector<std::string>({"f1", "f2"}));
+    ASSERT_EQ(FileNames(result->After()), std::vector<std::string>({"f1", "f2"}));
+    for (const auto& file : result->After()) {
+        ASSERT_EQ(2, file->level);
+    }
+    const Levels& levels = manager->GetLevels();
+    ASSERT_TRUE(levels.Level0().empty());
+    ASSERT_EQ(FileNames(levels.RunOfLevel(2).Files()), std::vector<std::string>({"f1", "f2"}));
+    ASSERT_EQ(FileNames(levels.RunOfLevel(3).Files()), std::vector<std::string>({"large"}));
+    ASSERT_EQ(2, levels.NumberOfSortedRuns());
+    ASSERT_FALSE(manager->ShouldWaitForLatestCompaction());
+}
+
+TEST_F(MergeTreeCompactManagerTest, TestFullCompaction) {
+    auto manager = CreateManager(/*num_run_compaction_trigger=*/5,
+                                 /*num_sorted_run_stop_trigger=*/8);
+    manager->AddNewFile(CreateDataFileMeta("f1", /*level=*/0, 1, 10, /*file_size=*/100,
+                                           /*max_sequence_number=*/10));
+    manager->AddNewFile(CreateDataFileMeta("f2", /*level=*/0, 20, 30, /*file_size=*/100,
+                                           /*max_sequence_number=*/20));
+    ASSERT_OK(manager->TriggerCompaction(/*full_compaction=*/true));
+    ASSERT_NOK_WITH_MSG(manager->TriggerCompaction(/*full_compaction=*/true),
+                        "A compaction task is still running");
+    ASSERT_OK_AND_ASSIGN(std::optional<CompactResult> result,
+                         manager->GetCompactionResult(/*blocking=*/true));
+    ASSERT_TRUE(result);
+    // the large file is already in the max level
+    ASSERT_EQ(FileNames(result->Before()), std::vector<std::string>({"f1", "f2"}));
+    const Levels& levels = manager->GetLevels();
+    ASSERT_TRUE(levels.Level0().empty());
+    ASSERT_EQ(FileNames(levels.RunOfLevel(3).Files()),
+              std::vector<std::string>({"f1", "f2", "large"}));
+    ASSERT_EQ(1, levels.NumberOfSortedRuns());
+
+    // a single run in the max level is not compacted again
+    ASSERT_OK(manager->TriggerCompaction(/*full_compaction=*/true));
+    ASSERT_FALSE(manager->CompactNotCompleted());
+}
+
+}  // namespace paimon::test
@@ -0,0 +1,229 @@
+/*
+ * Copyright 2024-present Alibaba Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "paimon/core/mergetree/compact/merge_tree_compact_rewriter.h"
+
+#include <algorithm>
+#include <utility>
+
+#include "arrow/api.h"
+#include "arrow/c/abi.h"
+#include "arrow/c/bridge.h"
+#include "arrow/c/helpers.h"
+#include "arrow/util/checked_cast.h"
+#include "fmt/format.h"
+#include "paimon/common/table/special_fields.h"
+#include "paimon/common/types/data_field.h"
+#include "paimon/common/utils/arrow/status_utils.h"
+#include "paimon/common/utils/scope_guard.h"
+#include "paimon/core/io/async_key_value_producer_and_consumer.h"
+#include "paimon/core/io/data_file_index_writer.h"
+#include "paimon/core/io/data_file_path_factory.h"
+#include "paimon/core/io/key_value_data_file_writer.h"
+#include "paimon/core/io/key_value_meta_projection_consumer.h"
+#include "paimon/core/io/single_file_writer.h"
+#include "paimon/core/manifest/file_source.h"
+#include "paimon/core/mergetree/compact/sort_merge_reader.h"
+#include "paimon/core/operation/merge_file_split_read.h"
+#include "paimon/core/stats/batch_stats_collector.h"
+#include "paimon/format/file_format.h"
+#include "paimon/format/writer_builder.h"
+
+namespace paimon {
+class FormatStatsExtractor;
+
+namespace {
+std::shared_ptr<arrow::Schema> AddSpecialFields(const std::shared_ptr<arrow::Schema>& schema) {
+    arrow::FieldVector fields;
+    fields.push_back(DataField::ConvertDataFieldToArrowField(SpecialFields::SequenceNumber()));
+    fields.push_back(DataField::ConvertDataFieldToArrowField(SpecialFields::ValueKind()));
+    fields.insert(fields.end(), schema->fields().begin(), schema->fields().end());
+    return arrow::schema(fields);
+}
+}  // namespace
+
+Result<std::unique_ptr<MergeTreeCompactRewriter>> MergeTreeCompactRewriter::Create(
+    const BinaryRow& partition, int64_t schema_id,
+    const std::vector<std::string>& trimmed_primary_keys,
+    const std::shared_ptr<arrow::Schema>& value_schema,
+    const std::shared_ptr<DataFilePathFactory>& data_file_path_factory,
+    std::unique_ptr<MergeFileSplitRead>&& merge_read, const CoreOptions& options,
+    const std::shared_ptr<MemoryPool>& pool) {
+    auto write_schema = AddSpecialFields(value_schema);
+    auto merge_read_schema = AddSpecialFields(merge_read->GetValueSchema());
+    if (write_schema->num_fields() != merge_read_schema->num_fields()) {
+        return Status::Invalid(
+            fmt::format("merge read schema {} does not match write schema {} in compaction",
+                        merge_read_schema->ToString(), write_schema->ToString()));
+    }
+    std::vector<int32_t> write_to_read_mapping;
+    bool identical = true;
+    for (const auto& field : write_schema->fields()) {
+        int32_t read_idx = merge_read_schema->GetFieldIndex(field->name());
+        if (read_idx < 0) {
+            return Status::Invalid(
+                fmt::format("field {} does not exist in merge read schema of compaction",
+                            field->name()));
+        }
+        identical = identical && read_idx == static_cast<int32_t>(write_to_read_mapping.size());
+        write_to_read_mapping.push_back(read_idx);
+    }
+    if (identical) {
+        write_to_read_mapping.clear();
+    }
+    return std::unique_ptr<MergeTreeCompactRewriter>(new MergeTreeCompactRewriter(
+        partition, schema_id, trimmed_primary_keys, write_schema, merge_read_schema,
+        std::move(write_to_read_mapping), data_file_path_factory, std::move(merge_read), options,
+        pool));
+}
+
+MergeTreeCompactRewriter::MergeTreeCompactRewriter(
+    const BinaryRow& partition, int64_t schema_id,
+    const std::vector<std::string>& trimmed_primary_keys,
+    const std::shared_ptr<arrow::Schema>& write_schema,
+    const std::shared_ptr<arrow::Schema>& merge_read_schema,
+    std::vector<int32_t>&& write_to_read_mapping,
+    const std::shared_ptr<DataFilePathFactory>& data_file_path_factory,
+    std::unique_ptr<MergeFileSplitRead>&& merge_read, const CoreOptions& options,
+    const std::shared_ptr<MemoryPool>& pool)
+    : partition_(partition),
+      schema_id_(schema_id),
+      trimmed_primary_keys_(trimmed_primary_keys),
+      write_schema_(write_schema),
+      merge_read_schema_(merge_read_schema),
+      write_to_read_mapping_(std::move(write_to_read_mapping)),
+      data_file_path_factory_(data_file_path_factory),
+      merge_read_(std::move(merge_read)),
+      options_(options),
+      pool_(pool) {}
+
+MergeTreeCompactRewriter::~MergeTreeCompactRewriter() = default;
+
+Result<CompactResult> MergeTreeCompactRewriter::Rewrite(
+    int32_t output_level, bool drop_delete, const std::vector<std::vector<SortedRun>>& sections) {
+    if (sections.empty()) {
+        return CompactResult();
+    }
+    auto rolling_writer = CreateRollingWriter(output_level);
+    // delete written files if any section fails
+    ScopeGuard guard([&rolling_writer]() { rolling_writer->Abort(); });
+    std::vector<std::shared_ptr<DataFileMeta>> before;
+    auto create_consumer = [target_schema = merge_read_schema_, pool = pool_]()
+        -> Result<std::unique_ptr<RowToArrowArrayConverter<KeyValue, KeyValueBatch>>> {
+        return KeyValueMetaProjectionConsumer::Create(target_schema, pool);
+    };
+    int32_t batch_size = std::min(options_.GetWriteBatchSize(), MAX_PROJECTION_BATCH_SIZE);
+    for (const auto& section : sections) {
+        for (const auto& run : section) {
+            before.insert(before.end(), run.Files().begin(), run.Files().end());
+        }
+        PAIMON_ASSIGN_OR_RAISE(
+            std::unique_ptr<SortMergeReader> reader,
+            merge_read_->CreateCompactReader(partition_, section, drop_delete,
+                                             data_file_path_factory_));
+        AsyncKeyValueProducerAndConsumer<KeyValue, KeyValueBatch> producer_and_consumer(
+            std::move(reader), create_consumer, batch_size,
+            options_.GetWriteRowToBatchThreadNumber(), pool_);
+        while (true) {
+            PAIMON_ASSIGN_OR_RAISE(KeyValueBatch key_value_batch,
+                                   producer_and_consumer.NextBatch());
+            if (key_value_batch.batch == nullptr) {
+                break;
+            }
+            PAIMON_RETURN_NOT_OK(ToWriteSchema(&key_value_batch));
+            PAIMON_RETURN_NOT_OK(rolling_writer->Write(std::move(key_value_batch)));
+        }
+        producer_and_consumer.Close();
+    }
+    PAIMON_RETURN_NOT_OK(rolling_writer->Close());
+    PAIMON_ASSIGN_OR_RAISE(std::vector<std::shared_ptr<DataFileMeta>> after,
+                           rolling_writer->GetResult());
+    guard.Release();
+    return CompactResult(before, after);
+}
+
+CompactResult MergeTreeCompactRewriter::Upgrade(int32_t output_level,
+                                                const std::shared_ptr<DataFileMeta>& file) {
+    auto upgraded = std::make_shared<DataFileMeta>(*file);
+    upgraded->level = output_level;
+    return CompactResult({file}, {upgraded});
+}
+
+Status MergeTreeCompactRewriter::ToWriteSchema(KeyValueBatch* key_value_batch) const {
+    if (write_to_read_mapping_.empty()) {
+        return Status::OK();
+    }
+    auto read_type = arrow::struct_(merge_read_schema_->fields());
+    PAIMON_ASSIGN_OR_RAISE_FROM_ARROW(std::shared_ptr<arrow::Array> array,
+                                      arrow::ImportArray(key_value_batch->batch.get(), read_type));
+    auto struct_array = arrow::internal::checked_pointer_cast<arrow::StructArray>(array);
+    arrow::ArrayVector fields;
+    fields.reserve(write_to_read_mapping_.size());
+    for (int32_t read_idx : write_to_read_mapping_) {
+        fields.push_back(struct_array->field(read_idx));
+    }
+    PAIMON_ASSIGN_OR_RAISE_FROM_ARROW(
+        std::shared_ptr<arrow::StructArray> reordered,
+        arrow::StructArray::Make(fields, write_schema_->fields(), struct_array->null_bitmap(),
+                                 struct_array->null_count(), struct_array->offset()));
+    PAIMON_RETURN_NOT_OK_FROM_ARROW(arrow::ExportArray(*reordered, key_value_batch->batch.get()));
+    return Status::OK();
+}
+
+std::unique_ptr<RollingFileWriter<KeyValueBatch, std::shared_ptr<DataFileMeta>>>
+MergeTreeCompactRewriter::CreateRollingWriter(int32_t output_level) const {
+    auto create_file_writer = [this, output_level]()
+        -> Result<std::unique_ptr<SingleFileWriter<KeyValueBatch, std::shared_ptr<DataFileMeta>>>> {
+        ::ArrowSchema arrow_schema;
+        ScopeGuard guard([&arrow_schema]() { ArrowSchemaRelease(&arrow_schema); });
+        PAIMON_RETURN_NOT_OK_FROM_ARROW(arrow::ExportSchema(*write_schema_, &arrow_schema));
+        auto format = options_.GetWriteFileFormat();
+        PAIMON_ASSIGN_OR_RAISE(
+            std::shared_ptr<WriterBuilder> writer_builder,
+            format->CreateWriterBuilder(&arrow_schema, options_.GetWriteBatchSize()));
+        writer_builder->WithMemoryPool(pool_);
+        PAIMON_RETURN_NOT_OK_FROM_ARROW(arrow::ExportSchema(*write_schema_, &arrow_schema));
+        PAIMON_ASSIGN_OR_RAISE(std::shared_ptr<FormatStatsExtractor> stats_extractor,
+                               format->CreateStatsExtractor(&arrow_schema));
+        auto converter = [](KeyValueBatch key_value_batch, ArrowArray* array) -> Status {
+            ArrowArrayMove(key_value_batch.batch.get(), array);
+            return Status::OK();
+        };
+        auto writer = std::make_unique<KeyValueDataFileWriter>(
+            options_.GetFileCompression(), converter, schema_id_, output_level,
+            FileSource::Compact(), trimmed_primary_keys_, stats_extractor, write_schema_,
+            data_file_path_factory_->IsExternalPath(), pool_);
+        if (options_.WriteStatsInFlightEnabled()) {
+            PAIMON_ASSIGN_OR_RAISE(std::unique_ptr<BatchStatsCollector> stats_collector,
+                                   BatchStatsCollector::Create(write_schema_));
+            writer->WithStatsCollector(std::move(stats_collector));
+        }
+        PAIMON_ASSIGN_OR_RAISE(
+            std::unique_ptr<DataFileIndexWriter> file_index_writer,
+            DataFileIndexWriter::Create(write_schema_, options_.ToMap(),
+                                        options_.GetFileIndexInManifestThreshold(), pool_));
+        if (file_index_writer) {
+            writer->WithFileIndexWriter(std::move(file_index_writer));
+        }
+        PAIMON_RETURN_NOT_OK(writer->Init(options_.GetFileSystem(),
+                                          data_file_path_factory_->NewPath(), writer_builder));
+        return writer;
+    };
+    return std::make_unique<RollingFileWriter<KeyValueBatch, std::shared_ptr<DataFileMeta>>>(
+        options_.GetTargetFileSize(), create_file_writer);
+}
+
+}  // namespace paimon
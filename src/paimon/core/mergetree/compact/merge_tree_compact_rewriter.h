@@ -0,0 +1,102 @@
+/*
+ * Copyright 2024-present Alibaba Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "paimon/common/data/binary_row.h"
+#include "paimon/core/compact/compact_result.h"
+#include "paimon/core/core_options.h"
+#include "paimon/core/io/data_file_meta.h"
+#include "paimon/core/io/rolling_file_writer.h"
+#include "paimon/core/key_value.h"
+#include "paimon/core/mergetree/sorted_run.h"
+#include "paimon/result.h"
+#include "paimon/status.h"
+
+namespace arrow {
+class Schema;
+}  // namespace arrow
+
+namespace paimon {
+class DataFilePathFactory;
+class MemoryPool;
+class MergeFileSplitRead;
+
+/// Rewrites sorted runs of a bucket into files of the output level, records of the same key are
+/// merged by the merge function of the table.
+class MergeTreeCompactRewriter {
+ public:
+    /// @param value_schema Value schema of the writer, files are written in the same layout as
+    /// flushed files (sequence number, value kind, value fields).
+    /// @param merge_read Split read of all table fields, used to sort-merge the input runs.
+    static Result<std::unique_ptr<MergeTreeCompactRewriter>> Create(
+        const BinaryRow& partition, int64_t schema_id,
+        const std::vector<std::string>& trimmed_primary_keys,
+        const std::shared_ptr<arrow::Schema>& value_schema,
+        const std::shared_ptr<DataFilePathFactory>& data_file_path_factory,
+        std::unique_ptr<MergeFileSplitRead>&& merge_read, const CoreOptions& options,
+        const std::shared_ptr<MemoryPool>& pool);
+
+    ~MergeTreeCompactRewriter();
+
+    /// Merges all runs of `sections` into new files of `output_level`, key intervals of different
+    /// sections do not overlap. Retract records are dropped if `drop_delete` is true.
+    Result<CompactResult> Rewrite(int32_t output_level, bool drop_delete,
+                                  const std::vector<std::vector<SortedRun>>& sections);
+
+    /// Moves `file` to `output_level` without rewriting it.
+    static CompactResult Upgrade(int32_t output_level, const std::shared_ptr<DataFileMeta>& file);
+
+ private:
+    MergeTreeCompactRewriter(const BinaryRow& partition, int64_t schema_id,
+                             const std::vector<std::string>& trimmed_primary_keys,
+                             const std::shared_ptr<arrow::Schema>& write_schema,
+                             const std::shared_ptr<arrow::Schema>& merge_read_schema,
+                             std::vector<int32_t>&& write_to_read_mapping,
+                             const std::shared_ptr<DataFilePathFactory>& data_file_path_factory,
+                             std::unique_ptr<MergeFileSplitRead>&& merge_read,
+                             const CoreOptions& options, const std::shared_ptr<MemoryPool>& pool);
+
+    std::unique_ptr<RollingFileWriter<KeyValueBatch, std::shared_ptr<DataFileMeta>>>
+    CreateRollingWriter(int32_t output_level) const;
+
+    /// Reorders fields of `key_value_batch` from merge read schema to write schema.
+    Status ToWriteSchema(KeyValueBatch* key_value_batch) const;
+
+    // in case write batch size is too large and overflow arrow array
+    static constexpr int32_t MAX_PROJECTION_BATCH_SIZE = 100000;
+
+ private:
+    BinaryRow partition_;
+    int64_t schema_id_;
+    std::vector<std::string> trimmed_primary_keys_;
+    // sequence number, value kind and value fields of writer
+    std::shared_ptr<arrow::Schema> write_schema_;
+    // sequence number, value kind and value fields of merge read, key fields come first
+    std::shared_ptr<arrow::Schema> merge_read_schema_;
+    // empty if merge read schema is identical to write schema
+    std::vector<int32_t> write_to_read_mapping_;
+    std::shared_ptr<DataFilePathFactory> data_file_path_factory_;
+    std::unique_ptr<MergeFileSplitRead> merge_read_;
+    CoreOptions options_;
+    std::shared_ptr<MemoryPool> pool_;
+};
+}  // namespace paimon
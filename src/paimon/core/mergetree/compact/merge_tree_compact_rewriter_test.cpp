@@ -0,0 +1,218 @@
+/*
+ * Copyright 2024-present Alibaba Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "paimon/core/mergetree/compact/merge_tree_compact_rewriter.h"
+
+#include <map>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "arrow/api.h"
+#include "arrow/c/abi.h"
+#include "arrow/c/bridge.h"
+#include "arrow/ipc/json_simple.h"
+#include "gtest/gtest.h"
+#include "paimon/catalog/catalog.h"
+#include "paimon/catalog/identifier.h"
+#include "paimon/common/data/binary_row.h"
+#include "paimon/common/table/special_fields.h"
+#include "paimon/common/types/data_field.h"
+#include "paimon/common/utils/path_util.h"
+#include "paimon/core/io/data_file_meta.h"
+#include "paimon/core/io/data_file_path_factory.h"
+#include "paimon/core/io/data_increment.h"
+#include "paimon/core/manifest/file_source.h"
+#include "paimon/core/mergetree/compact/compact_unit.h"
+#include "paimon/core/mergetree/compact/merge_tree_compact_manager.h"
+#include "paimon/core/mergetree/compact/merge_tree_compact_task.h"
+#include "paimon/core/mergetree/merge_tree_writer.h"
+#include "paimon/core/mergetree/sorted_run.h"
+#include "paimon/core/operation/key_value_file_store_write.h"
+#include "paimon/core/utils/commit_increment.h"
+#include "paimon/defs.h"
+#include "paimon/file_store_write.h"
+#include "paimon/format/file_format.h"
+#include "paimon/format/file_format_factory.h"
+#include "paimon/format/reader_builder.h"
+#include "paimon/fs/file_system.h"
+#include "paimon/fs/local/local_file_system.h"
+#include "paimon/record_batch.h"
+#include "paimon/testing/utils/read_result_collector.h"
+#include "paimon/testing/utils/testharness.h"
+#include "paimon/write_context.h"
+
+namespace paimon::test {
+// rewrites the flushed files of a primary key table with a real rewriter of the table write
+class MergeTreeCompactRewriterTest : public ::testing::Test {
+ public:
+    void SetUp() override {
+        file_system_ = std::make_shared<LocalFileSystem>();
+        std::vector<DataField> value_fields = {DataField(0, arrow::field("f0", arrow::int32())),
+                                               DataField(1, arrow::field("f1", arrow::utf8()))};
+        value_type_ = DataField::ConvertDataFieldsToArrowStructType(value_fields);
+        std::vector<DataField> write_fields = {SpecialFields::SequenceNumber(),
+                                               SpecialFields::ValueKind()};
+        write_fields.insert(write_fields.end(), value_fields.begin(), value_fields.end());
+        write_type_ = DataField::ConvertDataFieldsToArrowStructType(write_fields);
+
+        arrow::Schema typed_schema(value_type_->fields());
+        ::ArrowSchema schema;
+        ASSERT_TRUE(arrow::ExportSchema(typed_schema, &schema).ok());
+        dir_ = UniqueTestDirectory::Create();
+        ASSERT_TRUE(dir_);
+        ASSERT_OK_AND_ASSIGN(auto catalog, Catalog::Create(dir_->Str(), {}));
+        ASSERT_OK(catalog->CreateDatabase("foo", {}, /*ignore_if_exists=*/false));
+        // flushed files are never compacted by the writer itself
+        ASSERT_OK(catalog->CreateTable(Identifier("foo", "bar"), &schema, /*partition_keys=*/{},
+                                       /*primary_keys=*/{"f0"},
+                                       /*options=*/
+                                       {{"bucket", "1"},
+                                        {Options::FILE_FORMAT, "orc"},
+                                        {Options::NUM_SORTED_RUNS_COMPACTION_TRIGGER, "10"}},
+                                       /*ignore_if_exists=*/false));
+
+        WriteContextBuilder builder(PathUtil::JoinPath(dir_->Str(), "foo.db/bar"), "test");
+        ASSERT_OK_AND_ASSIGN(std::unique_ptr<WriteContext> write_context, builder.Finish());
+        ASSERT_OK_AND_ASSIGN(file_store_write_, FileStoreWrite::Create(std::move(write_context)));
+        auto key_value_write = dynamic_cast<KeyValueFileStoreWrite*>(file_store_write_.get());
+        ASSERT_TRUE(key_value_write);
+        ASSERT_OK_AND_ASSIGN(auto bucket_and_writer,
+                             key_value_write->CreateWriter(BinaryRow::EmptyRow(), /*bucket=*/0,
+                                                           /*ignore_previous_files=*/true));
+        writer_ = std::dynamic_pointer_cast<MergeTreeWriter>(bucket_and_writer.second);
+        ASSERT_TRUE(writer_);
+        compact_manager_ =
+            std::dynamic_pointer_cast<MergeTreeCompactManager>(writer_->compact_manager_);
+        ASSERT_TRUE(compact_manager_);
+        ASSERT_TRUE(compact_manager_->rewriter_);
+    }
+
+    void TearDown() override {
+        if (writer_) {
+            ASSERT_OK(writer_->Close());
+        }
+    }
+
+    /// Writes `json` and flushes it into a single level 0 file.
+    void WriteFile(const std::string& json, std::shared_ptr<DataFileMeta>* file) const {
+        std::shared_ptr<arrow::Array> array =
+            arrow::ipc::internal::json::ArrayFromJSON(value_type_, json).ValueOrDie();
+        ::ArrowArray c_array;
+        ASSERT_TRUE(arrow::ExportArray(*array, &c_array).ok());
+        RecordBatchBuilder batch_builder(&c_array);
+        ASSERT_OK_AND_ASSIGN(std::unique_ptr<RecordBatch> batch, batch_builder.Finish());
+        ASSERT_OK(writer_->Write(std::move(batch)));
+        ASSERT_OK_AND_ASSIGN(CommitIncrement commit_increment,
+                             writer_->PrepareCommit(/*wait_compaction=*/false));
+        const auto& new_files = commit_increment.GetNewFilesIncrement().NewFiles();
+        ASSERT_EQ(1, new_files.size());
+        *file = new_files[0];
+    }
+
+    void CheckFileContent(const std::shared_ptr<DataFileMeta>& file,
+                          const std::string& expected_json) const {
+        std::shared_ptr<arrow::ChunkedArray> expected_array;
+        ASSERT_TRUE(arrow::ipc::internal::json::ChunkedArrayFromJSON(write_type_, {expected_json},
+                                                                     &expected_array)
+                        .ok());
+        ASSERT_OK_AND_ASSIGN(std::shared_ptr<InputStream> input_stream,
+                             file_system_->Open(writer_->path_factory_->ToPath(file)));
+        ASSERT_OK_AND_ASSIGN(auto file_format, FileFormatFactory::Get("orc", /*options=*/{}));
+        ASSERT_OK_AND_ASSIGN(auto reader_builder,
+                             file_format->CreateReaderBuilder(/*batch_size=*/10));
+        ASSERT_OK_AND_ASSIGN(auto batch_reader, reader_builder->Build(input_stream));
+        ASSERT_OK_AND_ASSIGN(std::shared_ptr<arrow::ChunkedArray> result_array,
+                             ReadResultCollector::CollectResult(batch_reader.get()));
+        ASSERT_TRUE(expected_array->Equals(result_array)) << result_array->ToString();
+    }
+
+ protected:
+    std::shared_ptr<FileSystem> file_system_;
+    std::shared_ptr<arrow::DataType> value_type_;
+    std::shared_ptr<arrow::DataType> write_type_;
+    std::unique_ptr<UniqueTestDirectory> dir_;
+    std::unique_ptr<FileStoreWrite> file_store_write_;
+    std::shared_ptr<MergeTreeWriter> writer_;
+    std::shared_ptr<MergeTreeCompactManager> compact_manager_;
+};
+
+TEST_F(MergeTreeCompactRewriterTest, TestRewriteOverlappedRuns) {
+    std::shared_ptr<DataFileMeta> old_file;
+    std::shared_ptr<DataFileMeta> new_file;
+    WriteFile(R"([[1, "a"], [2, "b"], [3, "c"]])", &old_file);
+    WriteFile(R"([[2, "bb"], [3, "cc"], [4, "d"]])", &new_file);
+    ASSERT_TRUE(old_file && new_file);
+    ASSERT_EQ(3, new_file->min_sequence_number);
+
+    // runs of level 0 are ordered from new to old, records of a key are merged by sequence number
+    int32_t max_level = compact_manager_->GetLevels().MaxLevel();
+    ASSERT_OK_AND_ASSIGN(
+        CompactResult result,
+        compact_manager_->rewriter_->Rewrite(
+            max_level, /*drop_delete=*/true,
+            {{SortedRun::FromSingle(new_file), SortedRun::FromSingle(old_file)}}));
+    ASSERT_EQ(2, result.Before().size());
+    ASSERT_EQ(1, result.After().size());
+    const auto& output = result.After()[0];
+    ASSERT_EQ(max_level, output->level);
+    ASSERT_EQ(4, output->row_count);
+    ASSERT_EQ(0, output->min_sequence_number);
+    ASSERT_EQ(5, output->max_sequence_number);
+    ASSERT_EQ(FileSource::Compact(), output->file_source);
+    CheckFileContent(output, R"([
+      [0, 0, 1, "a"],
+      [3, 0, 2, "bb"],
+      [4, 0, 3, "cc"],
+      [5, 0, 4, "d"]
+    ])");
+}
+
+TEST_F(MergeTreeCompactRewriterTest, TestRewriteAndUpgrade) {
+    std::shared_ptr<DataFileMeta> old_file;
+    std::shared_ptr<DataFileMeta> new_file;
+    std::shared_ptr<DataFileMeta> separate_file;
+    WriteFile(R"([[1, "a"], [3, "c"]])", &old_file);
+    WriteFile(R"([[2, "bb"], [3, "cc"]])", &new_file);
+    WriteFile(R"([[10, "x"], [20, "y"]])", &separate_file);
+    ASSERT_TRUE(old_file && new_file && separate_file);
+
+    // the overlapped files are rewritten, the separate file is upgraded without rewriting
+    int32_t max_level = compact_manager_->GetLevels().MaxLevel();
+    CompactUnit unit = CompactUnit::FromFiles(max_level, {new_file, old_file, separate_file});
+    MergeTreeCompactTask task(compact_manager_->key_comparator_, /*min_file_size=*/1,
+                              compact_manager_->rewriter_, unit, max_level,
+                              /*drop_delete=*/true);
+    ASSERT_OK_AND_ASSIGN(CompactResult result, task.Run());
+    ASSERT_EQ(3, result.Before().size());
+    ASSERT_EQ(2, result.After().size());
+    const auto& rewritten = result.After()[0];
+    ASSERT_NE(old_file->file_name, rewritten->file_name);
+    ASSERT_NE(new_file->file_name, rewritten->file_name);
+    ASSERT_EQ(max_level, rewritten->level);
+    CheckFileContent(rewritten, R"([
+      [0, 0, 1, "a"],
+      [2, 0, 2, "bb"],
+      [3, 0, 3, "cc"]
+    ])");
+    const auto& upgraded = result.After()[1];
+    ASSERT_EQ(separate_file->file_name, upgraded->file_name);
+    ASSERT_EQ(max_level, upgraded->level);
+    ASSERT_EQ(0, separate_file->level);
+}
+
+}  // namespace paimon::test
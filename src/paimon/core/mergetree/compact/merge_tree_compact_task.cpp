@@ -0,0 +1,110 @@
+/*
+ * Copyright 2024-present Alibaba Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "paimon/core/mergetree/compact/merge_tree_compact_task.h"
+
+#include <utility>
+
+#include "paimon/core/mergetree/compact/interval_partition.h"
+#include "paimon/core/mergetree/compact/merge_tree_compact_rewriter.h"
+#include "paimon/core/utils/fields_comparator.h"
+
+namespace paimon {
+
+MergeTreeCompactTask::MergeTreeCompactTask(
+    const std::shared_ptr<FieldsComparator>& key_comparator, int64_t min_file_size,
+    const std::shared_ptr<MergeTreeCompactRewriter>& rewriter, const CompactUnit& unit,
+    int32_t max_level, bool drop_delete)
+    : key_comparator_(key_comparator),
+      min_file_size_(min_file_size),
+      rewriter_(rewriter),
+      output_level_(unit.OutputLevel()),
+      input_files_(unit.Files()),
+      max_level_(max_level),
+      drop_delete_(drop_delete) {}
+
+Result<CompactResult> MergeTreeCompactTask::Run() {
+    std::vector<std::vector<SortedRun>> partitioned =
+        IntervalPartition(input_files_, key_comparator_).Partition();
+    std::vector<std::vector<SortedRun>> candidate;
+    CompactResult result;
+    for (auto& section : partitioned) {
+        if (section.size() > 1) {
+            candidate.push_back(std::move(section));
+            continue;
+        }
+        // Small files are rewritten along with the overlapped sections, large files are
+        // upgraded directly, the adjacent candidates are rewritten before upgrading to keep the
+        // output files of a level ordered.
+        for (const auto& file : section[0].Files()) {
+            if (file->file_size < min_file_size_) {
+                candidate.push_back({SortedRun::FromSingle(file)});
+            } else {
+                PAIMON_RETURN_NOT_OK(Rewrite(&candidate, &result));
+                PAIMON_RETURN_NOT_OK(Upgrade(file, &result));
+            }
+        }
+    }
+    PAIMON_RETURN_NOT_OK(Rewrite(&candidate, &result));
+    return result;
+}
+
+Status MergeTreeCompactTask::Upgrade(const std::shared_ptr<DataFileMeta>& file,
+                                     CompactResult* result) {
+    if (file->level == output_level_) {
+        return Status::OK();
+    }
+    // files with delete records should not be upgraded directly to max level
+    bool contains_delete_records = file->delete_row_count.value_or(1) > 0;
+    if (output_level_ != max_level_ || !contains_delete_records) {
+        result->Merge(MergeTreeCompactRewriter::Upgrade(output_level_, file));
+        return Status::OK();
+    }
+    std::vector<std::vector<SortedRun>> candidate = {{SortedRun::FromSingle(file)}};
+    PAIMON_ASSIGN_OR_RAISE(CompactResult rewrite_result,
+                           rewriter_->Rewrite(output_level_, drop_delete_, candidate));
+    result->Merge(rewrite_result);
+    return Status::OK();
+}
+
+Status MergeTreeCompactTask::Rewrite(std::vector<std::vector<SortedRun>>* candidate,
+                                     CompactResult* result) {
+    if (candidate->empty()) {
+        return Status::OK();
+    }
+    if (candidate->size() == 1) {
+        const std::vector<SortedRun>& section = (*candidate)[0];
+        if (section.empty()) {
+            candidate->clear();
+            return Status::OK();
+        }
+        if (section.size() == 1) {
+            // a single run does not need merge
+            for (const auto& file : section[0].Files()) {
+                PAIMON_RETURN_NOT_OK(Upgrade(file, result));
+            }
+            candidate->clear();
+            return Status::OK();
+        }
+    }
+    PAIMON_ASSIGN_OR_RAISE(CompactResult rewrite_result,
+                           rewriter_->Rewrite(output_level_, drop_delete_, *candidate));
+    result->Merge(rewrite_result);
+    candidate->clear();
+    return Status::OK();
+}
+
+}  // namespace paimon
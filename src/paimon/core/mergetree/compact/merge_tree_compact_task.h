@@ -0,0 +1,59 @@
+/*
+ * Copyright 2024-present Alibaba Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "paimon/core/compact/compact_result.h"
+#include "paimon/core/mergetree/compact/compact_unit.h"
+#include "paimon/core/mergetree/sorted_run.h"
+#include "paimon/result.h"
+#include "paimon/status.h"
+
+namespace paimon {
+class FieldsComparator;
+class MergeTreeCompactRewriter;
+
+/// Compaction task of a `CompactUnit`. Large files which do not overlap with others are upgraded
+/// to the output level without rewriting, other files are rewritten by
+/// `MergeTreeCompactRewriter`.
+class MergeTreeCompactTask {
+ public:
+    MergeTreeCompactTask(const std::shared_ptr<FieldsComparator>& key_comparator,
+                         int64_t min_file_size,
+                         const std::shared_ptr<MergeTreeCompactRewriter>& rewriter,
+                         const CompactUnit& unit, int32_t max_level, bool drop_delete);
+
+    Result<CompactResult> Run();
+
+ private:
+    Status Upgrade(const std::shared_ptr<DataFileMeta>& file, CompactResult* result);
+
+    Status Rewrite(std::vector<std::vector<SortedRun>>* candidate, CompactResult* result);
+
+ private:
+    std::shared_ptr<FieldsComparator> key_comparator_;
+    int64_t min_file_size_;
+    std::shared_ptr<MergeTreeCompactRewriter> rewriter_;
+    int32_t output_level_;
+    std::vector<std::shared_ptr<DataFileMeta>> input_files_;
+    int32_t max_level_;
+    bool drop_delete_;
+};
+}  // namespace paimon
@@ -0,0 +1,125 @@
+/*
+ * Copyright 2024-present Alibaba Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "paimon/core/mergetree/compact/merge_tree_compact_task.h"
+
+#include <optional>
+#include <string>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "paimon/common/types/data_field.h"
+#include "paimon/core/manifest/file_source.h"
+#include "paimon/core/stats/simple_stats.h"
+#include "paimon/core/utils/fields_comparator.h"
+#include "paimon/data/timestamp.h"
+#include "paimon/memory/memory_pool.h"
+#include "paimon/testing/utils/binary_row_generator.h"
+#include "paimon/testing/utils/testharness.h"
+
+namespace paimon::test {
+// files in these tests do not overlap, they are upgraded without a rewriter
+class MergeTreeCompactTaskTest : public testing::Test {
+ public:
+    void SetUp() override {
+        ASSERT_OK_AND_ASSIGN(
+            comparator_,
+            FieldsComparator::Create({DataField(0, arrow::field("test", arrow::int32()))},
+                                     /*is_ascending_order=*/true, /*use_view=*/false));
+    }
+
+    std::shared_ptr<DataFileMeta> CreateDataFileMeta(
+        const std::string& file_name, int32_t level, int32_t min_key, int32_t max_key,
+        int64_t file_size, std::optional<int64_t> delete_row_count = 0) {
+        auto pool = GetDefaultPool();
+        return std::make_shared<DataFileMeta>(
+            file_name, file_size, /*row_count=*/1,
+            /*min_key=*/BinaryRowGenerator::GenerateRow({min_key}, pool.get()), /*max_key=*/
+            BinaryRowGenerator::GenerateRow({max_key}, pool.get()),
+            /*key_stats=*/
+            SimpleStats::EmptyStats(),
+            /*value_stats=*/
+            SimpleStats::EmptyStats(),
+            /*min_sequence_number=*/0, /*max_sequence_number=*/0, /*schema_id=*/0, level,
+            /*extra_files=*/std::vector<std::optional<std::string>>(),
+            /*creation_time=*/Timestamp(0ll, 0), delete_row_count, /*embedded_index=*/nullptr,
+            FileSource::Append(),
+            /*value_stats_cols=*/std::nullopt, /*external_path=*/std::nullopt,
+            /*first_row_id=*/std::nullopt,
+            /*write_cols=*/std::nullopt);
+    }
+
+    static std::vector<std::string> FileNames(
+        const std::vector<std::shared_ptr<DataFileMeta>>& files) {
+        std::vector<std::string> names;
+        for (const auto& file : files) {
+            names.push_back(file->file_name);
+        }
+        return names;
+    }
+
+ protected:
+    std::shared_ptr<FieldsComparator> comparator_;
+};
+
+TEST_F(MergeTreeCompactTaskTest, TestUpgradeWithoutRewrite) {
+    auto f1 = CreateDataFileMeta("f1", /*level=*/0, 1, 10, /*file_size=*/100);
+    auto f2 = CreateDataFileMeta("f2", /*level=*/0, 20, 30, /*file_size=*/100);
+    // already in the output level, nothing to do
+    auto f3 = CreateDataFileMeta("f3", /*level=*/3, 40, 50, /*file_size=*/100);
+    MergeTreeCompactTask task(comparator_, /*min_file_size=*/50, /*rewriter=*/nullptr,
+                              CompactUnit::FromFiles(/*output_level=*/3, {f1, f2, f3}),
+                              /*max_level=*/3, /*drop_delete=*/true);
+    ASSERT_OK_AND_ASSIGN(CompactResult result, task.Run());
+    ASSERT_EQ(FileNames(result.Before()), std::vector<std::string>({"f1", "f2"}));
+    ASSERT_EQ(FileNames(result.After()), std::vector<std::string>({"f1", "f2"}));
+    for (const auto& file : result.After()) {
+        ASSERT_EQ(3, file->level);
+    }
+    // input metas are not modified
+    ASSERT_EQ(0, f1->level);
+    ASSERT_EQ(0, f2->level);
+}
+
+TEST_F(MergeTreeCompactTaskTest, TestUpgradeSingleSmallFile) {
+    // a small file is rewritten along with others, but a single run does not need merge
+    auto f1 = CreateDataFileMeta("f1", /*level=*/0, 1, 10, /*file_size=*/10);
+    MergeTreeCompactTask task(comparator_, /*min_file_size=*/50, /*rewriter=*/nullptr,
+                              CompactUnit::FromFiles(/*output_level=*/2, {f1}),
+                              /*max_level=*/3, /*drop_delete=*/false);
+    ASSERT_OK_AND_ASSIGN(CompactResult result, task.Run());
+    ASSERT_EQ(FileNames(result.Before()), std::vector<std::string>({"f1"}));
+    ASSERT_EQ(FileNames(result.After()), std::vector<std::string>({"f1"}));
+    ASSERT_EQ(2, result.After()[0]->level);
+}
+
+TEST_F(MergeTreeCompactTaskTest, TestUpgradeDeleteRecordsBelowMaxLevel) {
+    // files with unknown delete records are only rewritten when they reach the max level
+    auto f1 = CreateDataFileMeta("f1", /*level=*/0, 1, 10, /*file_size=*/100,
+                                 /*delete_row_count=*/std::nullopt);
+    auto f2 = CreateDataFileMeta("f2", /*level=*/0, 20, 30, /*file_size=*/100,
+                                 /*delete_row_count=*/1);
+    MergeTreeCompactTask task(comparator_, /*min_file_size=*/50, /*rewriter=*/nullptr,
+                              CompactUnit::FromFiles(/*output_level=*/2, {f1, f2}),
+                              /*max_level=*/3, /*drop_delete=*/false);
+    ASSERT_OK_AND_ASSIGN(CompactResult result, task.Run());
+    ASSERT_EQ(FileNames(result.After()), std::vector<std::string>({"f1", "f2"}));
+    for (const auto& file : result.After()) {
+        ASSERT_EQ(2, file->level);
+    }
+}
+
+}  // namespace paimon::test
@@ -82,7 +82,8 @@ class SortMergeReaderTest : public testing::Test {
         const std::vector<std::shared_ptr<arrow::StructArray>>& src_array_vec,
         const std::shared_ptr<FieldsComparator>& user_key_comparator,
         const std::shared_ptr<FieldsComparator>& user_defined_seq_comparator, int32_t key_arity,
-        const std::shared_ptr<arrow::Schema>& value_schema, int32_t batch_size) const {
+        const std::shared_ptr<arrow::Schema>& value_schema, int32_t batch_size,
+        bool use_normalized_key) const {
         auto mfunc = std::make_unique<DeduplicateMergeFunction>(/*ignore_delete=*/false);
         auto merge_function_wrapper =
             std::make_shared<ReducerMergeFunctionWrapper>(std::move(mfunc));
@@ -100,7 +101,7 @@ class SortMergeReaderTest : public testing::Test {
 
         return std::make_unique<SortMergeReaderType>(std::move(concat_readers), user_key_comparator,
                                                      user_defined_seq_comparator,
-                                                     merge_function_wrapper);
+                                                     merge_function_wrapper, use_normalized_key);
     }
 
     template <typename SortMergeReaderType>
@@ -109,15 +110,18 @@ class SortMergeReaderTest : public testing::Test {
                               const std::shared_ptr<FieldsComparator>& user_defined_seq_comparator,
                               int32_t key_arity, const std::shared_ptr<arrow::Schema>& value_schema,
                               const std::vector<KeyValue>& expected) const {
-        for (auto batch_size : {1, 2, 3, 4, 100}) {
-            auto sort_merge_reader = CreateSortMergeReader<SortMergeReaderType>(
-                src_array_vec, user_key_comparator, user_defined_seq_comparator, key_arity,
-                value_schema, batch_size);
-            ASSERT_OK_AND_ASSIGN(
-                std::vector<KeyValue> results,
-                (ReadResultCollector::CollectKeyValueResult<
-                    SortMergeReader, SortMergeReader::Iterator>(sort_merge_reader.get())));
-            KeyValueChecker::CheckResult(expected, results, key_arity, value_schema->num_fields());
+        for (bool use_normalized_key : {false, true}) {
+            for (auto batch_size : {1, 2, 3, 4, 100}) {
+                auto sort_merge_reader = CreateSortMergeReader<SortMergeReaderType>(
+                    src_array_vec, user_key_comparator, user_defined_seq_comparator, key_arity,
+                    value_schema, batch_size, use_normalized_key);
+                ASSERT_OK_AND_ASSIGN(
+                    std::vector<KeyValue> results,
+                    (ReadResultCollector::CollectKeyValueResult<
+                        SortMergeReader, SortMergeReader::Iterator>(sort_merge_reader.get())));
+                KeyValueChecker::CheckResult(expected, results, key_arity,
+                                             value_schema->num_fields());
+            }
         }
     }
 
@@ -27,7 +27,8 @@ SortMergeReaderWithLoserTree::SortMergeReaderWithLoserTree(
     std::vector<std::unique_ptr<KeyValueRecordReader>>&& readers,
     const std::shared_ptr<FieldsComparator>& user_key_comparator,
     const std::shared_ptr<FieldsComparator>& user_defined_seq_comparator,
-    const std::shared_ptr<MergeFunctionWrapper<KeyValue>>& merge_function_wrapper)
+    const std::shared_ptr<MergeFunctionWrapper<KeyValue>>& merge_function_wrapper,
+    bool use_normalized_key)
     : merge_function_wrapper_(merge_function_wrapper) {
     // if lhs and rhs are both null, it doesn't matter who becomes the new winner. But if
     // first_comparator returns 0, it means that second_comparator must be used to compare
@@ -62,8 +63,10 @@ SortMergeReaderWithLoserTree::SortMergeReaderWithLoserTree(
         assert(lhs.value().sequence_number != rhs.value().sequence_number);
         return rhs.value().sequence_number < lhs.value().sequence_number ? -1 : 1;
     };
-    loser_tree_ =
-        std::make_unique<LoserTree>(std::move(readers), first_comparator, second_comparator);
+    loser_tree_ = std::make_unique<LoserTree>(
+        std::move(readers), first_comparator, second_comparator,
+        use_normalized_key && user_key_comparator->HasNormalizedKey() ? user_key_comparator
+                                                                      : nullptr);
 }
 
 Result<bool> SortMergeReaderWithLoserTree::Iterator::HasNext() {
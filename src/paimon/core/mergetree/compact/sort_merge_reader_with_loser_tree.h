@@ -40,11 +40,14 @@ class Metrics;
 /// KeyValueDataFileRecordReader and return the iterator of KeyValue
 class SortMergeReaderWithLoserTree : public SortMergeReader {
  public:
+    /// @param use_normalized_key whether keys are compared by their normalized keys first if
+    /// `user_key_comparator` supports it, see `FieldsComparator::NormalizedKey`.
     SortMergeReaderWithLoserTree(
         std::vector<std::unique_ptr<KeyValueRecordReader>>&& readers,
         const std::shared_ptr<FieldsComparator>& user_key_comparator,
         const std::shared_ptr<FieldsComparator>& user_defined_seq_comparator,
-        const std::shared_ptr<MergeFunctionWrapper<KeyValue>>& merge_function_wrapper);
+        const std::shared_ptr<MergeFunctionWrapper<KeyValue>>& merge_function_wrapper,
+        bool use_normalized_key);
 
     std::shared_ptr<Metrics> GetReaderMetrics() const override {
         return loser_tree_->GetReaderMetrics();
@@ -26,11 +26,16 @@ SortMergeReaderWithMinHeap::SortMergeReaderWithMinHeap(
     std::vector<std::unique_ptr<KeyValueRecordReader>>&& readers,
     const std::shared_ptr<FieldsComparator>& user_key_comparator,
     const std::shared_ptr<FieldsComparator>& user_defined_seq_comparator,
-    const std::shared_ptr<MergeFunctionWrapper<KeyValue>>& merge_function_wrapper)
+    const std::shared_ptr<MergeFunctionWrapper<KeyValue>>& merge_function_wrapper,
+    bool use_normalized_key)
     : readers_holder_(std::move(readers)),
       user_key_comparator_(user_key_comparator),
+      normalized_key_comparator_(use_normalized_key && user_key_comparator->HasNormalizedKey()
+                                     ? user_key_comparator
+                                     : nullptr),
       merge_function_wrapper_(merge_function_wrapper),
-      min_heap_(HeapSorter(user_key_comparator, user_defined_seq_comparator)) {
+      min_heap_(HeapSorter(user_key_comparator, user_defined_seq_comparator,
+                           normalized_key_comparator_ != nullptr)) {
     next_batch_readers_.reserve(readers_holder_.size());
     for (auto& reader : readers_holder_) {
         next_batch_readers_.push_back(reader.get());
@@ -49,7 +54,10 @@ Result<std::unique_ptr<SortMergeReader::Iterator>> SortMergeReaderWithMinHeap::N
             }
             if (iterator->HasNext()) {
                 PAIMON_ASSIGN_OR_RAISE(KeyValue kv, iterator->Next());
-                min_heap_.emplace(std::move(kv), std::move(iterator), reader);
+                uint64_t normalized_key =
+                    normalized_key_comparator_ ? normalized_key_comparator_->NormalizedKey(*kv.key)
+                                               : 0;
+                min_heap_.emplace(std::move(kv), std::move(iterator), reader, normalized_key);
                 break;
             }
         }
@@ -80,7 +88,8 @@ Result<bool> SortMergeReaderWithMinHeap::Iterator::NextImpl() {
     assert(reader_->next_batch_readers_.empty());
     // add previously polled elements back to priority queue
     for (auto& element : reader_->polled_) {
-        PAIMON_ASSIGN_OR_RAISE(bool updated, element.Update());
+        PAIMON_ASSIGN_OR_RAISE(bool updated,
+                               element.Update(reader_->normalized_key_comparator_.get()));
         if (updated) {
             // still kvs left, add back to priority queue
             reader_->min_heap_.push(std::move(element));
@@ -99,14 +108,24 @@ Result<bool> SortMergeReaderWithMinHeap::Iterator::NextImpl() {
     }
     reader_->merge_function_wrapper_->Reset();
     std::shared_ptr<InternalRow> key = reader_->min_heap_.top().kv.key;
+    uint64_t normalized_key = reader_->min_heap_.top().normalized_key;
+    const auto& normalized_key_comparator = reader_->normalized_key_comparator_;
     bool is_first = true;
 
     // fetch all elements with the same key
     // note that the same iterator should not produce the same keys, so this code is correct
     while (!reader_->min_heap_.empty()) {
         auto& element = const_cast<Element&>(reader_->min_heap_.top());
-        if (!is_first && reader_->user_key_comparator_->CompareTo(*key, *(element.kv.key)) != 0) {
-            break;
+        if (!is_first) {
+            const auto& element_key = *(element.kv.key);
+            int32_t result =
+                normalized_key_comparator
+                    ? normalized_key_comparator->CompareTo(normalized_key, *key,
+                                                           element.normalized_key, element_key)
+                    : reader_->user_key_comparator_->CompareTo(*key, element_key);
+            if (result != 0) {
+                break;
+            }
         }
         PAIMON_RETURN_NOT_OK(reader_->merge_function_wrapper_->Add(std::move(element.kv)));
         reader_->polled_.push_back(std::move(element));
@@ -42,11 +42,14 @@ class MergeFunctionWrapper;
 /// KeyValueDataFileRecordReader and return the iterator of KeyValue
 class SortMergeReaderWithMinHeap : public SortMergeReader {
  public:
+    /// @param use_normalized_key whether keys are compared by their normalized keys first if
+    /// `user_key_comparator` supports it, see `FieldsComparator::NormalizedKey`.
     SortMergeReaderWithMinHeap(
         std::vector<std::unique_ptr<KeyValueRecordReader>>&& readers,
         const std::shared_ptr<FieldsComparator>& user_key_comparator,
         const std::shared_ptr<FieldsComparator>& user_defined_seq_comparator,
-        const std::shared_ptr<MergeFunctionWrapper<KeyValue>>& merge_function_wrapper);
+        const std::shared_ptr<MergeFunctionWrapper<KeyValue>>& merge_function_wrapper,
+        bool use_normalized_key);
 
     class Iterator : public SortMergeReader::Iterator {
      public:
@@ -79,8 +82,11 @@ class SortMergeReaderWithMinHeap : public SortMergeReader {
  private:
     struct Element {
         Element(KeyValue&& _kv, std::unique_ptr<KeyValueRecordReader::Iterator>&& _iterator,
-                KeyValueRecordReader* _reader)
-            : kv(std::move(_kv)), reader(_reader), iterator(std::move(_iterator)) {
+                KeyValueRecordReader* _reader, uint64_t _normalized_key)
+            : kv(std::move(_kv)),
+              reader(_reader),
+              iterator(std::move(_iterator)),
+              normalized_key(_normalized_key) {
             assert(iterator);
             assert(reader);
         }
@@ -88,6 +94,7 @@ class SortMergeReaderWithMinHeap : public SortMergeReader {
         Element(Element&& other) noexcept : kv(std::move(other.kv)) {
             iterator = std::move(other.iterator);
             reader = other.reader;
+            normalized_key = other.normalized_key;
         }
 
         Element& operator=(Element&& other) noexcept {
@@ -97,15 +104,21 @@ class SortMergeReaderWithMinHeap : public SortMergeReader {
             kv = std::move(other.kv);
             iterator = std::move(other.iterator);
             reader = other.reader;
+            normalized_key = other.normalized_key;
             return *this;
         }
 
-        Result<bool> Update() {
+        /// Reads the next kv and encodes its normalized key with `normalized_key_comparator` if
+        /// it is not nullptr.
+        Result<bool> Update(const FieldsComparator* normalized_key_comparator) {
             if (!iterator->HasNext()) {
                 return false;
             }
             PAIMON_ASSIGN_OR_RAISE(KeyValue tmp_kv, iterator->Next());
             kv = std::move(tmp_kv);
+            if (normalized_key_comparator != nullptr) {
+                normalized_key = normalized_key_comparator->NormalizedKey(*(kv.key));
+            }
             return true;
         }
 
@@ -113,17 +126,25 @@ class SortMergeReaderWithMinHeap : public SortMergeReader {
         KeyValue kv;
         KeyValueRecordReader* reader;
         std::unique_ptr<KeyValueRecordReader::Iterator> iterator;
+        uint64_t normalized_key = 0;
     };
 
     class HeapSorter {
      public:
         HeapSorter(const std::shared_ptr<FieldsComparator>& key_comparator,
-                   const std::shared_ptr<FieldsComparator>& seq_comparator)
-            : key_comparator_(key_comparator), seq_comparator_(seq_comparator) {
+                   const std::shared_ptr<FieldsComparator>& seq_comparator,
+                   bool use_normalized_key)
+            : key_comparator_(key_comparator),
+              seq_comparator_(seq_comparator),
+              use_normalized_key_(use_normalized_key) {
             assert(key_comparator_);
         }
         bool operator()(const Element& lhs, const Element& rhs) const {
-            int32_t result = key_comparator_->CompareTo(*(lhs.kv.key), *(rhs.kv.key));
+            int32_t result =
+                use_normalized_key_
+                    ? key_comparator_->CompareTo(lhs.normalized_key, *(lhs.kv.key),
+                                                 rhs.normalized_key, *(rhs.kv.key))
+                    : key_comparator_->CompareTo(*(lhs.kv.key), *(rhs.kv.key));
             if (result != 0) {
                 return result > 0;
             }
@@ -139,6 +160,7 @@ class SortMergeReaderWithMinHeap : public SortMergeReader {
      private:
         std::shared_ptr<FieldsComparator> key_comparator_;
         std::shared_ptr<FieldsComparator> seq_comparator_;
+        bool use_normalized_key_;
     };
 
  private:
@@ -146,6 +168,8 @@ class SortMergeReaderWithMinHeap : public SortMergeReader {
     std::vector<std::unique_ptr<KeyValueRecordReader>> readers_holder_;
     std::vector<KeyValueRecordReader*> next_batch_readers_;
     std::shared_ptr<FieldsComparator> user_key_comparator_;
+    // user_key_comparator_ if keys are compared by normalized keys first, otherwise nullptr
+    std::shared_ptr<FieldsComparator> normalized_key_comparator_;
     std::shared_ptr<MergeFunctionWrapper<KeyValue>> merge_function_wrapper_;
     std::priority_queue<Element, std::vector<Element>, HeapSorter> min_heap_;
     std::vector<Element> polled_;
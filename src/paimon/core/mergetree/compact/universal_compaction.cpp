@@ -0,0 +1,132 @@
+/*
+ * Copyright 2024-present Alibaba Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "paimon/core/mergetree/compact/universal_compaction.h"
+
+#include <algorithm>
+
+namespace paimon {
+
+std::optional<CompactUnit> UniversalCompaction::Pick(
+    int32_t num_levels, const std::vector<LevelSortedRun>& runs) const {
+    int32_t max_level = num_levels - 1;
+    // 1. checking for reducing size amplification
+    std::optional<CompactUnit> unit = PickForSizeAmp(max_level, runs);
+    if (unit) {
+        return unit;
+    }
+    // 2. checking for size ratio
+    unit = PickForSizeRatio(max_level, runs);
+    if (unit) {
+        return unit;
+    }
+    // 3. checking for file num
+    int32_t run_num = static_cast<int32_t>(runs.size());
+    if (run_num > num_run_compaction_trigger_) {
+        // compacting for file num
+        int32_t candidate_count = run_num - num_run_compaction_trigger_ + 1;
+        return PickForSizeRatio(max_level, runs, candidate_count);
+    }
+    return std::nullopt;
+}
+
+std::optional<CompactUnit> UniversalCompaction::PickFullCompaction(
+    int32_t num_levels, const std::vector<LevelSortedRun>& runs) {
+    int32_t max_level = num_levels - 1;
+    if (runs.empty()) {
+        return std::nullopt;
+    }
+    if (runs.size() == 1 && runs[0].Level() == max_level) {
+        // only 1 sorted run on the max level, nothing to compact
+        return std::nullopt;
+    }
+    return CompactUnit::FromLevelRuns(max_level, runs);
+}
+
+std::optional<CompactUnit> UniversalCompaction::PickForSizeAmp(
+    int32_t max_level, const std::vector<LevelSortedRun>& runs) const {
+    if (static_cast<int32_t>(runs.size()) < num_run_compaction_trigger_) {
+        return std::nullopt;
+    }
+    int64_t candidate_size = 0;
+    for (size_t i = 0; i + 1 < runs.size(); ++i) {
+        candidate_size += runs[i].Run().TotalSize();
+    }
+    int64_t earliest_run_size = runs.back().Run().TotalSize();
+    // size amplification = percentage of additional size
+    if (candidate_size * 100 > max_size_amp_ * earliest_run_size) {
+        return CompactUnit::FromLevelRuns(max_level, runs);
+    }
+    return std::nullopt;
+}
+
+std::optional<CompactUnit> UniversalCompaction::PickForSizeRatio(
+    int32_t max_level, const std::vector<LevelSortedRun>& runs) const {
+    if (static_cast<int32_t>(runs.size()) < num_run_compaction_trigger_) {
+        return std::nullopt;
+    }
+    return PickForSizeRatio(max_level, runs, /*candidate_count=*/1);
+}
+
+std::optional<CompactUnit> UniversalCompaction::PickForSizeRatio(
+    int32_t max_level, const std::vector<LevelSortedRun>& runs, int32_t candidate_count) const {
+    int64_t candidate_size = 0;
+    for (int32_t i = 0; i < candidate_count; ++i) {
+        candidate_size += runs[i].Run().TotalSize();
+    }
+    for (size_t i = candidate_count; i < runs.size(); ++i) {
+        const LevelSortedRun& next = runs[i];
+        if (candidate_size * (100.0 + size_ratio_) / 100.0 < next.Run().TotalSize()) {
+            break;
+        }
+        candidate_size += next.Run().TotalSize();
+        candidate_count++;
+    }
+    if (candidate_count > 1) {
+        return CreateUnit(runs, max_level, candidate_count);
+    }
+    return std::nullopt;
+}
+
+CompactUnit UniversalCompaction::CreateUnit(const std::vector<LevelSortedRun>& runs,
+                                            int32_t max_level, int32_t run_count) {
+    int32_t run_num = static_cast<int32_t>(runs.size());
+    int32_t output_level;
+    if (run_count == run_num) {
+        output_level = max_level;
+    } else {
+        // level of next run - 1
+        output_level = std::max(0, runs[run_count].Level() - 1);
+    }
+    if (output_level == 0) {
+        // do not output level 0
+        for (int32_t i = run_count; i < run_num; ++i) {
+            const LevelSortedRun& next = runs[i];
+            run_count++;
+            if (next.Level() != 0) {
+                output_level = next.Level();
+                break;
+            }
+        }
+    }
+    if (run_count == run_num) {
+        output_level = max_level;
+    }
+    std::vector<LevelSortedRun> picked(runs.begin(), runs.begin() + run_count);
+    return CompactUnit::FromLevelRuns(output_level, picked);
+}
+
+}  // namespace paimon
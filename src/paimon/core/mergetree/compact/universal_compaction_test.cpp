@@ -0,0 +1,124 @@
+/*
+ * Copyright 2024-present Alibaba Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "paimon/core/mergetree/compact/universal_compaction.h"
+
+#include <optional>
+#include <string>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "paimon/core/manifest/file_source.h"
+#include "paimon/core/stats/simple_stats.h"
+#include "paimon/data/timestamp.h"
+#include "paimon/memory/memory_pool.h"
+#include "paimon/testing/utils/binary_row_generator.h"
+#include "paimon/testing/utils/testharness.h"
+
+namespace paimon::test {
+class UniversalCompactionTest : public testing::Test {
+ public:
+    // each run contains a single file with `size`
+    std::vector<LevelSortedRun> CreateRuns(const std::vector<int32_t>& levels,
+                                           const std::vector<int64_t>& sizes) {
+        auto pool = GetDefaultPool();
+        std::vector<LevelSortedRun> runs;
+        for (size_t i = 0; i < levels.size(); ++i) {
+            auto file = std::make_shared<DataFileMeta>(
+                "file" + std::to_string(i), sizes[i], /*row_count=*/1,
+                /*min_key=*/BinaryRowGenerator::GenerateRow({0}, pool.get()), /*max_key=*/
+                BinaryRowGenerator::GenerateRow({100}, pool.get()),
+                /*key_stats=*/
+                SimpleStats::EmptyStats(),
+                /*value_stats=*/
+                SimpleStats::EmptyStats(),
+                /*min_sequence_number=*/0, /*max_sequence_number=*/0, /*schema_id=*/0,
+                levels[i], /*extra_files=*/std::vector<std::optional<std::string>>(),
+                /*creation_time=*/Timestamp(0ll, 0),
+                /*delete_row_count=*/0, /*embedded_index=*/nullptr, FileSource::Append(),
+                /*value_stats_cols=*/std::nullopt, /*external_path=*/std::nullopt,
+                /*first_row_id=*/std::nullopt,
+                /*write_cols=*/std::nullopt);
+            runs.emplace_back(levels[i], SortedRun::FromSingle(file));
+        }
+        return runs;
+    }
+
+    static std::vector<int64_t> FileSizes(const CompactUnit& unit) {
+        std::vector<int64_t> sizes;
+        for (const auto& file : unit.Files()) {
+            sizes.push_back(file->file_size);
+        }
+        return sizes;
+    }
+};
+
+TEST_F(UniversalCompactionTest, TestNoCompaction) {
+    UniversalCompaction compaction(/*max_size_amp=*/200, /*size_ratio=*/1,
+                                   /*num_run_compaction_trigger=*/5);
+    ASSERT_FALSE(compaction.Pick(/*num_levels=*/3, {}));
+    ASSERT_FALSE(compaction.Pick(/*num_levels=*/3, CreateRuns({0, 0}, {1, 1})));
+    ASSERT_FALSE(compaction.Pick(/*num_levels=*/3, CreateRuns({0, 0, 0, 0, 2}, {1, 3, 9, 27, 81})));
+}
+
+TEST_F(UniversalCompactionTest, TestSizeAmplification) {
+    UniversalCompaction compaction(/*max_size_amp=*/25, /*size_ratio=*/1,
+                                   /*num_run_compaction_trigger=*/3);
+    // (1 + 1) / 5 > 25%
+    std::optional<CompactUnit> unit =
+        compaction.Pick(/*num_levels=*/3, CreateRuns({0, 0, 2}, {1, 1, 5}));
+    ASSERT_TRUE(unit);
+    ASSERT_EQ(2, unit->OutputLevel());
+    ASSERT_EQ(std::vector<int64_t>({1, 1, 5}), FileSizes(unit.value()));
+}
+
+TEST_F(UniversalCompactionTest, TestSizeRatio) {
+    UniversalCompaction compaction(/*max_size_amp=*/200, /*size_ratio=*/1,
+                                   /*num_run_compaction_trigger=*/3);
+    std::optional<CompactUnit> unit =
+        compaction.Pick(/*num_levels=*/4, CreateRuns({0, 0, 3}, {1, 1, 10}));
+    ASSERT_TRUE(unit);
+    // level of next run - 1
+    ASSERT_EQ(2, unit->OutputLevel());
+    ASSERT_EQ(std::vector<int64_t>({1, 1}), FileSizes(unit.value()));
+}
+
+TEST_F(UniversalCompactionTest, TestFileNum) {
+    UniversalCompaction compaction(/*max_size_amp=*/200, /*size_ratio=*/1,
+                                   /*num_run_compaction_trigger=*/3);
+    // size ratio does not pick any run, 4 runs exceed the trigger
+    std::optional<CompactUnit> unit =
+        compaction.Pick(/*num_levels=*/4, CreateRuns({0, 0, 1, 3}, {1, 3, 9, 100}));
+    ASSERT_TRUE(unit);
+    // do not output level 0, the level 1 run is picked as well
+    ASSERT_EQ(1, unit->OutputLevel());
+    ASSERT_EQ(std::vector<int64_t>({1, 3, 9}), FileSizes(unit.value()));
+}
+
+TEST_F(UniversalCompactionTest, TestPickFullCompaction) {
+    ASSERT_FALSE(UniversalCompaction::PickFullCompaction(/*num_levels=*/3, {}));
+    ASSERT_FALSE(UniversalCompaction::PickFullCompaction(/*num_levels=*/3, CreateRuns({2}, {5})));
+    std::optional<CompactUnit> unit =
+        UniversalCompaction::PickFullCompaction(/*num_levels=*/3, CreateRuns({1}, {5}));
+    ASSERT_TRUE(unit);
+    ASSERT_EQ(2, unit->OutputLevel());
+    unit = UniversalCompaction::PickFullCompaction(/*num_levels=*/3, CreateRuns({0, 2}, {1, 5}));
+    ASSERT_TRUE(unit);
+    ASSERT_EQ(2, unit->OutputLevel());
+    ASSERT_EQ(std::vector<int64_t>({1, 5}), FileSizes(unit.value()));
+}
+
+}  // namespace paimon::test
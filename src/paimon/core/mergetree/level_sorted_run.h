@@ -0,0 +1,42 @@
+/*
+ * Copyright 2024-present Alibaba Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <utility>
+
+#include "paimon/core/mergetree/sorted_run.h"
+
+namespace paimon {
+/// `SortedRun` with level.
+class LevelSortedRun {
+ public:
+    LevelSortedRun(int32_t level, SortedRun run) : level_(level), run_(std::move(run)) {}
+
+    int32_t Level() const {
+        return level_;
+    }
+
+    const SortedRun& Run() const {
+        return run_;
+    }
+
+ private:
+    int32_t level_;
+    SortedRun run_;
+};
+}  // namespace paimon
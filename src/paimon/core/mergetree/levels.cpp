@@ -0,0 +1,198 @@
+/*
+ * Copyright 2024-present Alibaba Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "paimon/core/mergetree/levels.h"
+
+#include <algorithm>
+#include <map>
+#include <utility>
+
+#include "fmt/format.h"
+#include "paimon/core/utils/fields_comparator.h"
+
+namespace paimon {
+
+Levels::Levels(const std::shared_ptr<FieldsComparator>& key_comparator, int32_t num_levels)
+    : key_comparator_(key_comparator) {
+    levels_.reserve(num_levels - 1);
+    for (int32_t i = 1; i < num_levels; ++i) {
+        levels_.push_back(SortedRun::FromSorted({}));
+    }
+}
+
+Result<std::unique_ptr<Levels>> Levels::Create(
+    const std::shared_ptr<FieldsComparator>& key_comparator,
+    const std::vector<std::shared_ptr<DataFileMeta>>& input_files, int32_t num_levels) {
+    // in case the num of levels is modified when restarting
+    int32_t restored_num_levels = num_levels;
+    for (const auto& file : input_files) {
+        restored_num_levels = std::max(restored_num_levels, file->level + 1);
+    }
+    if (restored_num_levels <= 1) {
+        return Status::Invalid(
+            fmt::format("Number of levels must be at least 2, but is {}", restored_num_levels));
+    }
+    std::unique_ptr<Levels> levels(new Levels(key_comparator, restored_num_levels));
+    std::map<int32_t, std::vector<std::shared_ptr<DataFileMeta>>> level_to_files;
+    for (const auto& file : input_files) {
+        level_to_files[file->level].push_back(file);
+    }
+    for (const auto& [level, files] : level_to_files) {
+        PAIMON_RETURN_NOT_OK(levels->UpdateLevel(level, /*before=*/{}, /*after=*/files));
+    }
+    for (int32_t level = 1; level < levels->NumberOfLevels(); ++level) {
+        if (!levels->RunOfLevel(level).IsValid(key_comparator)) {
+            return Status::Invalid(
+                fmt::format("Files of level {} overlap with each other, the merge tree is broken",
+                            level));
+        }
+    }
+    return levels;
+}
+
+void Levels::AddLevel0File(const std::shared_ptr<DataFileMeta>& file) {
+    level0_.push_back(file);
+    SortLevel0();
+}
+
+void Levels::SortLevel0() {
+    auto compare = [](const std::shared_ptr<DataFileMeta>& lhs,
+                      const std::shared_ptr<DataFileMeta>& rhs) {
+        if (lhs->max_sequence_number != rhs->max_sequence_number) {
+            // file with larger sequence number should be in front
+            return lhs->max_sequence_number > rhs->max_sequence_number;
+        }
+        // When two or more jobs are writing the same merge tree, it is possible that multiple
+        // files have the same max sequence number. So we have to compare their min sequence
+        // numbers and file names.
+        if (lhs->min_sequence_number != rhs->min_sequence_number) {
+            return lhs->min_sequence_number < rhs->min_sequence_number;
+        }
+        return lhs->file_name < rhs->file_name;
+    };
+    std::sort(level0_.begin(), level0_.end(), compare);
+}
+
+int32_t Levels::NumberOfSortedRuns() const {
+    int32_t number_of_sorted_runs = static_cast<int32_t>(level0_.size());
+    for (const auto& run : levels_) {
+        if (!run.IsEmpty()) {
+            number_of_sorted_runs++;
+        }
+    }
+    return number_of_sorted_runs;
+}
+
+int32_t Levels::NonEmptyHighestLevel() const {
+    for (int32_t i = static_cast<int32_t>(levels_.size()) - 1; i >= 0; --i) {
+        if (!levels_[i].IsEmpty()) {
+            return i + 1;
+        }
+    }
+    return level0_.empty() ? -1 : 0;
+}
+
+int64_t Levels::TotalFileSize() const {
+    int64_t total_size = 0;
+    for (const auto& file : level0_) {
+        total_size += file->file_size;
+    }
+    for (const auto& run : levels_) {
+        total_size += run.TotalSize();
+    }
+    return total_size;
+}
+
+std::vector<std::shared_ptr<DataFileMeta>> Levels::AllFiles() const {
+    std::vector<std::shared_ptr<DataFileMeta>> files;
+    for (const auto& run : LevelSortedRuns()) {
+        const auto& run_files = run.Run().Files();
+        files.insert(files.end(), run_files.begin(), run_files.end());
+    }
+    return files;
+}
+
+std::vector<LevelSortedRun> Levels::LevelSortedRuns() const {
+    std::vector<LevelSortedRun> runs;
+    runs.reserve(NumberOfSortedRuns());
+    for (const auto& file : level0_) {
+        runs.emplace_back(/*level=*/0, SortedRun::FromSingle(file));
+    }
+    for (size_t i = 0; i < levels_.size(); ++i) {
+        if (!levels_[i].IsEmpty()) {
+            runs.emplace_back(static_cast<int32_t>(i) + 1, levels_[i]);
+        }
+    }
+    return runs;
+}
+
+Status Levels::Update(const std::vector<std::shared_ptr<DataFileMeta>>& before,
+                      const std::vector<std::shared_ptr<DataFileMeta>>& after) {
+    std::map<int32_t, std::vector<std::shared_ptr<DataFileMeta>>> grouped_before;
+    std::map<int32_t, std::vector<std::shared_ptr<DataFileMeta>>> grouped_after;
+    for (const auto& file : before) {
+        grouped_before[file->level].push_back(file);
+    }
+    for (const auto& file : after) {
+        grouped_after[file->level].push_back(file);
+    }
+    std::vector<std::shared_ptr<DataFileMeta>> empty_files;
+    for (int32_t level = 0; level < NumberOfLevels(); ++level) {
+        auto before_iter = grouped_before.find(level);
+        auto after_iter = grouped_after.find(level);
+        if (before_iter == grouped_before.end() && after_iter == grouped_after.end()) {
+            continue;
+        }
+        PAIMON_RETURN_NOT_OK(
+            UpdateLevel(level,
+                        before_iter == grouped_before.end() ? empty_files : before_iter->second,
+                        after_iter == grouped_after.end() ? empty_files : after_iter->second));
+    }
+    return Status::OK();
+}
+
+Status Levels::UpdateLevel(int32_t level, const std::vector<std::shared_ptr<DataFileMeta>>& before,
+                           const std::vector<std::shared_ptr<DataFileMeta>>& after) {
+    if (level < 0 || level >= NumberOfLevels()) {
+        return Status::Invalid(
+            fmt::format("level {} is out of range [0, {})", level, NumberOfLevels()));
+    }
+    auto remove_before = [&before](std::vector<std::shared_ptr<DataFileMeta>>* files) {
+        files->erase(std::remove_if(files->begin(), files->end(),
+                                    [&before](const std::shared_ptr<DataFileMeta>& file) {
+                                        for (const auto& removed : before) {
+                                            if (*removed == *file) {
+                                                return true;
+                                            }
+                                        }
+                                        return false;
+                                    }),
+                     files->end());
+    };
+    if (level == 0) {
+        remove_before(&level0_);
+        level0_.insert(level0_.end(), after.begin(), after.end());
+        SortLevel0();
+    } else {
+        std::vector<std::shared_ptr<DataFileMeta>> files = levels_[level - 1].Files();
+        remove_before(&files);
+        files.insert(files.end(), after.begin(), after.end());
+        levels_[level - 1] = SortedRun::FromUnsorted(std::move(files), key_comparator_);
+    }
+    return Status::OK();
+}
+
+}  // namespace paimon
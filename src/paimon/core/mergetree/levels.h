@@ -0,0 +1,94 @@
+/*
+ * Copyright 2024-present Alibaba Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "paimon/core/io/data_file_meta.h"
+#include "paimon/core/mergetree/level_sorted_run.h"
+#include "paimon/core/mergetree/sorted_run.h"
+#include "paimon/result.h"
+#include "paimon/status.h"
+
+namespace paimon {
+class FieldsComparator;
+
+/// A class which stores all level files of merge tree. Files in level 0 may overlap with each
+/// other and each of them is a sorted run, files in a higher level form one sorted run.
+class Levels {
+ public:
+    /// @param key_comparator Ascending comparator of min/max keys of data files.
+    /// @param input_files Restored files, the number of levels is extended if any input file is
+    /// in a level higher than `num_levels - 1`.
+    static Result<std::unique_ptr<Levels>> Create(
+        const std::shared_ptr<FieldsComparator>& key_comparator,
+        const std::vector<std::shared_ptr<DataFileMeta>>& input_files, int32_t num_levels);
+
+    void AddLevel0File(const std::shared_ptr<DataFileMeta>& file);
+
+    /// Files in level 0, newer files (with larger max sequence number) come first.
+    const std::vector<std::shared_ptr<DataFileMeta>>& Level0() const {
+        return level0_;
+    }
+
+    /// @pre level >= 1
+    const SortedRun& RunOfLevel(int32_t level) const {
+        return levels_[level - 1];
+    }
+
+    int32_t NumberOfLevels() const {
+        return static_cast<int32_t>(levels_.size()) + 1;
+    }
+
+    int32_t MaxLevel() const {
+        return static_cast<int32_t>(levels_.size());
+    }
+
+    int32_t NumberOfSortedRuns() const;
+
+    /// @return the highest level which is not empty, -1 if there is no file at all.
+    int32_t NonEmptyHighestLevel() const;
+
+    int64_t TotalFileSize() const;
+
+    std::vector<std::shared_ptr<DataFileMeta>> AllFiles() const;
+
+    /// Sorted runs from the newest to the oldest: each level 0 file is a run, followed by one run
+    /// for each non-empty higher level.
+    std::vector<LevelSortedRun> LevelSortedRuns() const;
+
+    /// Replaces `before` files with `after` files, files are located by their levels.
+    Status Update(const std::vector<std::shared_ptr<DataFileMeta>>& before,
+                  const std::vector<std::shared_ptr<DataFileMeta>>& after);
+
+ private:
+    Levels(const std::shared_ptr<FieldsComparator>& key_comparator, int32_t num_levels);
+
+    Status UpdateLevel(int32_t level, const std::vector<std::shared_ptr<DataFileMeta>>& before,
+                       const std::vector<std::shared_ptr<DataFileMeta>>& after);
+
+    void SortLevel0();
+
+ private:
+    std::shared_ptr<FieldsComparator> key_comparator_;
+    std::vector<std::shared_ptr<DataFileMeta>> level0_;
+    // runs of level 1 to max level
+    std::vector<SortedRun> levels_;
+};
+}  // namespace paimon
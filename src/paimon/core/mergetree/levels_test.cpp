@@ -0,0 +1,143 @@
+/*
+ * Copyright 2024-present Alibaba Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "paimon/core/mergetree/levels.h"
+
+#include <optional>
+#include <string>
+#include <vector>
+
+#include "arrow/type_fwd.h"
+#include "gtest/gtest.h"
+#include "paimon/common/types/data_field.h"
+#include "paimon/core/manifest/file_source.h"
+#include "paimon/core/stats/simple_stats.h"
+#include "paimon/core/utils/fields_comparator.h"
+#include "paimon/data/timestamp.h"
+#include "paimon/memory/memory_pool.h"
+#include "paimon/result.h"
+#include "paimon/status.h"
+#include "paimon/testing/utils/binary_row_generator.h"
+#include "paimon/testing/utils/testharness.h"
+
+namespace paimon::test {
+class LevelsTest : public testing::Test {
+ public:
+    void SetUp() override {
+        ASSERT_OK_AND_ASSIGN(
+            comparator_,
+            FieldsComparator::Create({DataField(0, arrow::field("test", arrow::int32()))},
+                                     /*is_ascending_order=*/true, /*use_view=*/false));
+    }
+
+    std::shared_ptr<DataFileMeta> CreateDataFileMeta(const std::string& file_name, int32_t level,
+                                                     int32_t min_key, int32_t max_key,
+                                                     int64_t max_sequence_number) {
+        auto pool = GetDefaultPool();
+        return std::make_shared<DataFileMeta>(
+            file_name, /*file_size=*/100, /*row_count=*/1,
+            /*min_key=*/BinaryRowGenerator::GenerateRow({min_key}, pool.get()), /*max_key=*/
+            BinaryRowGenerator::GenerateRow({max_key}, pool.get()),
+            /*key_stats=*/
+            SimpleStats::EmptyStats(),
+            /*value_stats=*/
+            SimpleStats::EmptyStats(),
+            /*min_sequence_number=*/0, max_sequence_number, /*schema_id=*/0, level,
+            /*extra_files=*/std::vector<std::optional<std::string>>(),
+            /*creation_time=*/Timestamp(0ll, 0),
+            /*delete_row_count=*/0, /*embedded_index=*/nullptr, FileSource::Append(),
+            /*value_stats_cols=*/std::nullopt, /*external_path=*/std::nullopt,
+            /*first_row_id=*/std::nullopt,
+            /*write_cols=*/std::nullopt);
+    }
+
+ protected:
+    std::shared_ptr<FieldsComparator> comparator_;
+};
+
+TEST_F(LevelsTest, TestCreateAndSortedRuns) {
+    auto l0_old = CreateDataFileMeta("l0_old", /*level=*/0, 1, 100, /*max_seq=*/5);
+    auto l0_new = CreateDataFileMeta("l0_new", /*level=*/0, 1, 100, /*max_seq=*/9);
+    auto l2_a = CreateDataFileMeta("l2_a", /*level=*/2, 30, 40, /*max_seq=*/3);
+    auto l2_b = CreateDataFileMeta("l2_b", /*level=*/2, 10, 20, /*max_seq=*/2);
+    ASSERT_OK_AND_ASSIGN(std::unique_ptr<Levels> levels,
+                         Levels::Create(comparator_, {l0_old, l2_a, l0_new, l2_b},
+                                        /*num_levels=*/4));
+    ASSERT_EQ(4, levels->NumberOfLevels());
+    ASSERT_EQ(3, levels->MaxLevel());
+    ASSERT_EQ(3, levels->NumberOfSortedRuns());
+    ASSERT_EQ(2, levels->NonEmptyHighestLevel());
+    ASSERT_EQ(400, levels->TotalFileSize());
+    // newer level 0 file comes first
+    ASSERT_EQ(std::vector<std::shared_ptr<DataFileMeta>>({l0_new, l0_old}), levels->Level0());
+    // files of a level are sorted by min key
+    ASSERT_EQ(std::vector<std::shared_ptr<DataFileMeta>>({l2_b, l2_a}),
+              levels->RunOfLevel(2).Files());
+    ASSERT_TRUE(levels->RunOfLevel(1).IsEmpty());
+
+    auto runs = levels->LevelSortedRuns();
+    ASSERT_EQ(3, runs.size());
+    ASSERT_EQ(0, runs[0].Level());
+    ASSERT_EQ(l0_new, runs[0].Run().Files()[0]);
+    ASSERT_EQ(0, runs[1].Level());
+    ASSERT_EQ(l0_old, runs[1].Run().Files()[0]);
+    ASSERT_EQ(2, runs[2].Level());
+    ASSERT_EQ(200, runs[2].Run().TotalSize());
+
+    auto l0_newest = CreateDataFileMeta("l0_newest", /*level=*/0, 1, 100, /*max_seq=*/10);
+    levels->AddLevel0File(l0_newest);
+    ASSERT_EQ(l0_newest, levels->Level0()[0]);
+    ASSERT_EQ(4, levels->NumberOfSortedRuns());
+}
+
+TEST_F(LevelsTest, TestRestoreMoreLevels) {
+    auto file = CreateDataFileMeta("l5", /*level=*/5, 1, 10, /*max_seq=*/1);
+    ASSERT_OK_AND_ASSIGN(std::unique_ptr<Levels> levels,
+                         Levels::Create(comparator_, {file}, /*num_levels=*/3));
+    ASSERT_EQ(6, levels->NumberOfLevels());
+    ASSERT_EQ(5, levels->NonEmptyHighestLevel());
+
+    ASSERT_OK_AND_ASSIGN(levels, Levels::Create(comparator_, {}, /*num_levels=*/3));
+    ASSERT_EQ(-1, levels->NonEmptyHighestLevel());
+    ASSERT_EQ(0, levels->NumberOfSortedRuns());
+    ASSERT_NOK(Levels::Create(comparator_, {}, /*num_levels=*/1));
+}
+
+TEST_F(LevelsTest, TestOverlappedLevel) {
+    auto file1 = CreateDataFileMeta("f1", /*level=*/1, 1, 20, /*max_seq=*/1);
+    auto file2 = CreateDataFileMeta("f2", /*level=*/1, 10, 30, /*max_seq=*/2);
+    ASSERT_NOK_WITH_MSG(Levels::Create(comparator_, {file1, file2}, /*num_levels=*/3),
+                        "Files of level 1 overlap with each other");
+}
+
+TEST_F(LevelsTest, TestUpdate) {
+    auto l0_a = CreateDataFileMeta("l0_a", /*level=*/0, 1, 50, /*max_seq=*/5);
+    auto l0_b = CreateDataFileMeta("l0_b", /*level=*/0, 20, 80, /*max_seq=*/6);
+    auto l2 = CreateDataFileMeta("l2", /*level=*/2, 60, 90, /*max_seq=*/1);
+    ASSERT_OK_AND_ASSIGN(std::unique_ptr<Levels> levels,
+                         Levels::Create(comparator_, {l0_a, l0_b, l2}, /*num_levels=*/3));
+    auto compacted1 = CreateDataFileMeta("compacted1", /*level=*/2, 1, 40, /*max_seq=*/6);
+    auto compacted2 = CreateDataFileMeta("compacted2", /*level=*/2, 41, 90, /*max_seq=*/6);
+    ASSERT_OK(levels->Update({l0_a, l0_b, l2}, {compacted2, compacted1}));
+    ASSERT_TRUE(levels->Level0().empty());
+    ASSERT_EQ(std::vector<std::shared_ptr<DataFileMeta>>({compacted1, compacted2}),
+              levels->RunOfLevel(2).Files());
+    ASSERT_EQ(1, levels->NumberOfSortedRuns());
+    ASSERT_EQ(std::vector<std::shared_ptr<DataFileMeta>>({compacted1, compacted2}),
+              levels->AllFiles());
+}
+
+}  // namespace paimon::test
@@ -17,28 +17,37 @@
 #include "paimon/core/mergetree/merge_tree_writer.h"
 
 #include <algorithm>
-#include <cassert>
 #include <cstddef>
+#include <filesystem>
+#include <optional>
+#include <set>
+#include <string>
+#include <system_error>
 #include <utility>
 
 #include "arrow/api.h"
 #include "arrow/array/array_base.h"
-#include "arrow/array/array_binary.h"
 #include "arrow/array/array_nested.h"
 #include "arrow/c/abi.h"
 #include "arrow/c/bridge.h"
 #include "arrow/c/helpers.h"
+#include "arrow/util/byte_size.h"
 #include "arrow/util/checked_cast.h"
 #include "fmt/format.h"
+#include "paimon/common/executor/future.h"
 #include "paimon/common/metrics/metrics_impl.h"
 #include "paimon/common/table/special_fields.h"
 #include "paimon/common/types/data_field.h"
 #include "paimon/common/utils/arrow/status_utils.h"
+#include "paimon/common/utils/path_util.h"
 #include "paimon/common/utils/scope_guard.h"
+#include "paimon/common/utils/uuid.h"
 #include "paimon/core/io/async_key_value_producer_and_consumer.h"
 #include "paimon/core/io/compact_increment.h"
+#include "paimon/core/io/data_file_index_writer.h"
 #include "paimon/core/io/data_file_path_factory.h"
 #include "paimon/core/io/data_increment.h"
+#include "paimon/core/io/key_value_data_file_record_reader.h"
 #include "paimon/core/io/key_value_data_file_writer.h"
 #include "paimon/core/io/key_value_in_memory_record_reader.h"
 #include "paimon/core/io/key_value_meta_projection_consumer.h"
@@ -46,9 +55,10 @@
 #include "paimon/core/io/row_to_arrow_array_converter.h"
 #include "paimon/core/io/single_file_writer.h"
 #include "paimon/core/manifest/file_source.h"
+#include "paimon/core/mergetree/compact/columnar_key_value_merger.h"
 #include "paimon/core/mergetree/compact/sort_merge_reader_with_loser_tree.h"
+#include "paimon/core/stats/batch_stats_collector.h"
 #include "paimon/core/utils/commit_increment.h"
-#include "paimon/data/decimal.h"
 #include "paimon/format/file_format.h"
 #include "paimon/format/writer_builder.h"
 #include "paimon/metrics.h"
@@ -67,7 +77,9 @@ MergeTreeWriter::MergeTreeWriter(
     const std::shared_ptr<FieldsComparator>& user_defined_seq_comparator,
     const std::shared_ptr<MergeFunctionWrapper<KeyValue>>& merge_function_wrapper,
     int64_t schema_id, const std::shared_ptr<arrow::Schema>& value_schema,
-    const CoreOptions& options, const std::shared_ptr<MemoryPool>& pool)
+    const CoreOptions& options, const std::shared_ptr<MemoryPool>& pool,
+    const std::shared_ptr<CompactManager>& compact_manager,
+    const std::shared_ptr<Executor>& executor)
     : last_sequence_number_(last_sequence_number + 1),
       current_memory_in_bytes_(0),
       pool_(pool),
@@ -79,6 +91,8 @@ MergeTreeWriter::MergeTreeWriter(
       merge_function_wrapper_(merge_function_wrapper),
       schema_id_(schema_id),
       value_type_(arrow::struct_(value_schema->fields())),
+      compact_manager_(compact_manager),
+      executor_(executor),
       metrics_(std::make_shared<MetricsImpl>()) {
     arrow::FieldVector target_fields;
     target_fields.push_back(
@@ -87,6 +101,9 @@ MergeTreeWriter::MergeTreeWriter(
     target_fields.insert(target_fields.end(), value_schema->fields().begin(),
                          value_schema->fields().end());
     write_schema_ = arrow::schema(target_fields);
+    columnar_merger_ =
+        ColumnarKeyValueMerger::Create(value_schema, write_schema_, trimmed_primary_keys_,
+                                       options_, merge_function_wrapper_, pool_);
 }
 
 Status MergeTreeWriter::Write(std::unique_ptr<RecordBatch>&& moved_batch) {
@@ -101,45 +118,266 @@ Status MergeTreeWriter::Write(std::unique_ptr<RecordBatch>&& moved_batch) {
     if (value_struct_array == nullptr) {
         return Status::Invalid("invalid RecordBatch: cannot cast to StructArray");
     }
-    PAIMON_ASSIGN_OR_RAISE(int64_t memory_in_bytes, EstimateMemoryUse(value_struct_array));
-    current_memory_in_bytes_ += memory_in_bytes;
-
     batch_vec_.push_back(std::move(value_struct_array));
     row_kinds_vec_.push_back(batch->GetRowKind());
+    int64_t memory_in_bytes = EstimateMemoryUse(*batch_vec_.back(), row_kinds_vec_.back());
+    current_memory_in_bytes_ += memory_in_bytes;
     if (current_memory_in_bytes_ >= options_.GetWriteBufferSize()) {
-        return Flush();
+        return ShouldSpill() ? Spill() : Flush(/*wait_for_flush=*/false);
+    }
+    if (memory_manager_) {
+        return memory_manager_->Acquire(this, memory_in_bytes);
     }
     return Status::OK();
 }
 
 Result<CommitIncrement> MergeTreeWriter::PrepareCommit(bool wait_compaction) {
-    // TODO(xinyu.lxy): support wait_compaction
-    PAIMON_RETURN_NOT_OK(Flush());
+    PAIMON_RETURN_NOT_OK(Flush(/*wait_for_flush=*/true));
+    if (compact_manager_) {
+        PAIMON_RETURN_NOT_OK(compact_manager_->TriggerCompaction(/*full_compaction=*/false));
+        if (compact_manager_->ShouldWaitForPreparingCheckpoint()) {
+            wait_compaction = true;
+        }
+        PAIMON_RETURN_NOT_OK(TrySyncLatestCompaction(wait_compaction));
+    }
     return DrainIncrement();
 }
 
-Status MergeTreeWriter::Flush() {
-    if (batch_vec_.empty()) {
+Status MergeTreeWriter::DoClose() {
+    // the in-flight flush refers to this writer, it must finish before members are destroyed
+    Status flush_status = Status::OK();
+    if (flush_future_.valid()) {
+        Result<std::unique_ptr<KeyValueRollingFileWriter>> flushed = flush_future_.get();
+        if (flushed.ok()) {
+            flushed.value()->Abort();
+        } else {
+            flush_status = flushed.status();
+        }
+    }
+    batch_vec_.clear();
+    row_kinds_vec_.clear();
+    current_memory_in_bytes_ = 0;
+    if (memory_manager_) {
+        memory_manager_->Release(this);
+    }
+    spilled_runs_.clear();
+    spilled_bytes_ = 0;
+    if (compact_manager_) {
+        // collect the output of the in-flight compaction, a failed compaction has no output
+        Result<std::optional<CompactResult>> compact_result =
+            compact_manager_->GetCompactionResult(/*blocking=*/true);
+        if (compact_result.ok() && compact_result.value()) {
+            PAIMON_RETURN_NOT_OK(UpdateCompactResult(compact_result.value().value()));
+        }
+        PAIMON_RETURN_NOT_OK(compact_manager_->Close());
+    }
+    // compaction output is not committed, delete it unless it is upgraded from a committed file
+    for (const auto& file : compact_after_) {
+        bool upgraded = std::any_of(
+            compact_before_.begin(), compact_before_.end(),
+            [&file](const auto& before) { return before->file_name == file->file_name; });
+        if (upgraded) {
+            continue;
+        }
+        for (const auto& path : path_factory_->CollectFiles(file)) {
+            // delete quietly, a leftover file is cleaned by orphan files cleaning
+            [[maybe_unused]] auto status = options_.GetFileSystem()->Delete(path, false);
+        }
+    }
+    compact_before_.clear();
+    compact_after_.clear();
+    return flush_status;
+}
+
+MergeTreeWriter::WriteBuffer MergeTreeWriter::TakeWriteBuffer() {
+    WriteBuffer buffer{std::move(batch_vec_), std::move(row_kinds_vec_), last_sequence_number_};
+    for (const auto& batch : buffer.batch_vec) {
+        last_sequence_number_ += batch->length();
+    }
+    batch_vec_.clear();
+    row_kinds_vec_.clear();
+    current_memory_in_bytes_ = 0;
+    if (memory_manager_) {
+        // the buffer is alive until the flush or spill completes
+        memory_manager_->MarkFlushing(this);
+    }
+    return buffer;
+}
+
+void MergeTreeWriter::ReleaseFlushedMemory() {
+    if (memory_manager_) {
+        memory_manager_->ReleaseFlushing(this);
+    }
+}
+
+Status MergeTreeWriter::Flush(bool wait_for_flush) {
+    // at most one flush is in flight, which also keeps level 0 files in sequence order
+    PAIMON_RETURN_NOT_OK(WaitFlush());
+    if (!batch_vec_.empty() || !spilled_runs_.empty()) {
+        WriteBuffer buffer = TakeWriteBuffer();
+        std::vector<std::shared_ptr<SpilledSortedRun>> spilled_runs = std::move(spilled_runs_);
+        spilled_runs_.clear();
+        spilled_bytes_ = 0;
+        if (executor_) {
+            flush_future_ =
+                Via(executor_.get(), [this, buffer = std::move(buffer),
+                                      spilled_runs = std::move(spilled_runs)]() mutable {
+                    return FlushBatches(std::move(buffer), std::move(spilled_runs));
+                });
+        } else {
+            Result<std::unique_ptr<KeyValueRollingFileWriter>> flushed =
+                FlushBatches(std::move(buffer), std::move(spilled_runs));
+            ReleaseFlushedMemory();
+            PAIMON_RETURN_NOT_OK(flushed.status());
+            PAIMON_RETURN_NOT_OK(CollectFlushedFiles(flushed.value().get()));
+        }
+    }
+    if (wait_for_flush) {
+        PAIMON_RETURN_NOT_OK(WaitFlush());
+    }
+    return Status::OK();
+}
+
+Status MergeTreeWriter::WaitFlush() {
+    if (!flush_future_.valid()) {
         return Status::OK();
     }
-    // 1. create key value iter for each record batch
+    Result<std::unique_ptr<KeyValueRollingFileWriter>> flushed = flush_future_.get();
+    ReleaseFlushedMemory();
+    PAIMON_RETURN_NOT_OK(flushed.status());
+    return CollectFlushedFiles(flushed.value().get());
+}
+
+bool MergeTreeWriter::ShouldSpill() const {
+    return options_.WriteBufferSpillable() && !batch_vec_.empty() &&
+           static_cast<int64_t>(spilled_runs_.size()) < options_.GetLocalSortMaxNumFileHandles() &&
+           spilled_bytes_ < options_.GetWriteBufferSpillMaxDiskSize();
+}
+
+Status MergeTreeWriter::Spill() {
+    // the merge function is shared with the in-flight flush, so spills never overlap with it
+    PAIMON_RETURN_NOT_OK(WaitFlush());
+    if (spill_path_prefix_.empty()) {
+        std::string spill_dir = options_.GetWriteBufferSpillDir();
+        if (spill_dir.empty()) {
+            std::error_code ec;
+            spill_dir = std::filesystem::temp_directory_path(ec).string();
+            if (ec) {
+                return Status::IOError(
+                    fmt::format("cannot get temporary directory to spill: {}", ec.message()));
+            }
+        }
+        std::string uuid;
+        if (!UUID::Generate(&uuid)) {
+            return Status::Invalid("generate uuid for spill file failed");
+        }
+        spill_path_prefix_ = PathUtil::JoinPath(spill_dir, "paimon-write-spill-" + uuid + "-");
+    }
+    WriteBuffer buffer = TakeWriteBuffer();
+    ScopeGuard release_guard([this]() { ReleaseFlushedMemory(); });
+    std::string path = spill_path_prefix_ + std::to_string(spill_file_count_++) + ".arrow";
+    PAIMON_ASSIGN_OR_RAISE(
+        std::unique_ptr<SpilledSortedRun::Writer> run_writer,
+        SpilledSortedRun::Writer::Create(path, write_schema_, trimmed_primary_keys_,
+                                         options_.GetSpillCompression(), pool_));
+    PAIMON_RETURN_NOT_OK(SortAndMerge(std::move(buffer), /*spilled_runs=*/{},
+                                      [&run_writer](KeyValueBatch&& key_value_batch) {
+                                          return run_writer->Write(std::move(key_value_batch));
+                                      }));
+    PAIMON_ASSIGN_OR_RAISE(std::unique_ptr<SpilledSortedRun> run, run_writer->Finish());
+    if (run->RowCount() > 0) {
+        spilled_bytes_ += run->FileSize();
+        spilled_runs_.push_back(std::move(run));
+    }
+    return Status::OK();
+}
+
+Result<std::unique_ptr<MergeTreeWriter::KeyValueRollingFileWriter>> MergeTreeWriter::FlushBatches(
+    WriteBuffer&& buffer, std::vector<std::shared_ptr<SpilledSortedRun>>&& spilled_runs) const {
+    auto rolling_writer = CreateRollingRowWriter();
+    ScopeGuard guard([&rolling_writer]() { rolling_writer->Abort(); });
+    PAIMON_RETURN_NOT_OK(SortAndMerge(std::move(buffer), std::move(spilled_runs),
+                                      [&rolling_writer](KeyValueBatch&& key_value_batch) {
+                                          return rolling_writer->Write(std::move(key_value_batch));
+                                      }));
+    PAIMON_RETURN_NOT_OK(rolling_writer->Close());
+    guard.Release();
+    return rolling_writer;
+}
+
+Status MergeTreeWriter::SortAndMerge(WriteBuffer&& buffer,
+                                     std::vector<std::shared_ptr<SpilledSortedRun>>&& spilled_runs,
+                                     const KeyValueBatchConsumer& consumer) const {
+    if (columnar_merger_ && spilled_runs.empty()) {
+        return FlushColumnar(buffer, consumer);
+    }
+    return FlushWithSortMergeReader(std::move(buffer), std::move(spilled_runs), consumer);
+}
+
+Status MergeTreeWriter::CollectFlushedFiles(KeyValueRollingFileWriter* writer) {
+    PAIMON_ASSIGN_OR_RAISE(std::vector<std::shared_ptr<DataFileMeta>> flushed_files,
+                           writer->GetResult());
+    metrics_->Merge(writer->GetMetrics());
+    new_files_.insert(new_files_.end(), flushed_files.begin(), flushed_files.end());
+    if (!compact_manager_) {
+        return Status::OK();
+    }
+    for (const auto& file : flushed_files) {
+        compact_manager_->AddNewFile(file);
+    }
+    PAIMON_RETURN_NOT_OK(
+        TrySyncLatestCompaction(compact_manager_->ShouldWaitForLatestCompaction()));
+    return compact_manager_->TriggerCompaction(/*full_compaction=*/false);
+}
+
+Status MergeTreeWriter::FlushColumnar(const WriteBuffer& buffer,
+                                      const KeyValueBatchConsumer& consumer) const {
+    PAIMON_ASSIGN_OR_RAISE(std::shared_ptr<arrow::StructArray> merged,
+                           columnar_merger_->Merge(buffer.batch_vec, buffer.row_kinds_vec,
+                                                   buffer.first_sequence_number));
+    int64_t batch_size = std::min(options_.GetWriteBatchSize(), MAX_PROJECTION_BATCH_SIZE);
+    for (int64_t offset = 0; offset < merged->length(); offset += batch_size) {
+        int64_t length = std::min(batch_size, merged->length() - offset);
+        PAIMON_ASSIGN_OR_RAISE(KeyValueBatch key_value_batch,
+                               columnar_merger_->ToKeyValueBatch(merged, offset, length));
+        PAIMON_RETURN_NOT_OK(consumer(std::move(key_value_batch)));
+    }
+    return Status::OK();
+}
+
+Status MergeTreeWriter::FlushWithSortMergeReader(
+    WriteBuffer&& buffer, std::vector<std::shared_ptr<SpilledSortedRun>>&& spilled_runs,
+    const KeyValueBatchConsumer& consumer) const {
+    // 1. create key value iter for each spilled run and record batch, spilled runs hold the
+    // smaller sequence numbers
     std::vector<std::unique_ptr<KeyValueRecordReader>> readers;
-    readers.reserve(batch_vec_.size());
-    for (size_t i = 0; i < batch_vec_.size(); ++i) {
-        int64_t sequence_number = last_sequence_number_;
-        last_sequence_number_ += batch_vec_[i]->length();
+    readers.reserve(spilled_runs.size() + buffer.batch_vec.size());
+    if (!spilled_runs.empty()) {
+        auto value_schema = arrow::schema(value_type_->fields());
+        for (const auto& run : spilled_runs) {
+            PAIMON_ASSIGN_OR_RAISE(std::unique_ptr<BatchReader> run_reader,
+                                   run->CreateReader(pool_));
+            readers.push_back(std::make_unique<KeyValueDataFileRecordReader>(
+                std::move(run_reader), static_cast<int32_t>(trimmed_primary_keys_.size()),
+                value_schema, /*level=*/0, pool_));
+        }
+    }
+    int64_t sequence_number = buffer.first_sequence_number;
+    for (size_t i = 0; i < buffer.batch_vec.size(); ++i) {
+        int64_t batch_length = buffer.batch_vec[i]->length();
         auto in_memory_reader = std::make_unique<KeyValueInMemoryRecordReader>(
-            sequence_number, std::move(batch_vec_[i]), std::move(row_kinds_vec_[i]),
+            sequence_number, std::move(buffer.batch_vec[i]), std::move(buffer.row_kinds_vec[i]),
             trimmed_primary_keys_, options_.GetSequenceField(), key_comparator_,
             merge_function_wrapper_, pool_);
         readers.push_back(std::move(in_memory_reader));
+        sequence_number += batch_length;
     }
-    batch_vec_.clear();
-    row_kinds_vec_.clear();
-    current_memory_in_bytes_ = 0;
+    buffer.batch_vec.clear();
+    buffer.row_kinds_vec.clear();
     // 2. prepare loser tree sort merge reader
     auto sort_merge_reader = std::make_unique<SortMergeReaderWithLoserTree>(
-        std::move(readers), key_comparator_, user_defined_seq_comparator_, merge_function_wrapper_);
+        std::move(readers), key_comparator_, user_defined_seq_comparator_, merge_function_wrapper_,
+        options_.SortNormalizedKeyEnabled());
     // 3. project key value to arrow array
     auto create_consumer = [target_schema = write_schema_, pool = pool_]()
         -> Result<std::unique_ptr<RowToArrowArrayConverter<KeyValue, KeyValueBatch>>> {
@@ -150,33 +388,70 @@ Status MergeTreeWriter::Flush() {
         std::make_unique<AsyncKeyValueProducerAndConsumer<KeyValue, KeyValueBatch>>(
             std::move(sort_merge_reader), create_consumer,
             std::min(options_.GetWriteBatchSize(), MAX_PROJECTION_BATCH_SIZE),
-            /*projection_thread_num=*/1, pool_);
-    auto rolling_writer = CreateRollingRowWriter();
+            options_.GetWriteRowToBatchThreadNumber(), pool_);
     while (true) {
         PAIMON_ASSIGN_OR_RAISE(KeyValueBatch key_value_batch,
                                async_key_value_producer_consumer->NextBatch());
         if (key_value_batch.batch == nullptr) {
             break;
         }
-        PAIMON_RETURN_NOT_OK(rolling_writer->Write(std::move(key_value_batch)));
+        PAIMON_RETURN_NOT_OK(consumer(std::move(key_value_batch)));
     }
-    PAIMON_RETURN_NOT_OK(rolling_writer->Close());
-    PAIMON_ASSIGN_OR_RAISE(std::vector<std::shared_ptr<DataFileMeta>> flushed_files,
-                           rolling_writer->GetResult());
-    new_files_.insert(new_files_.end(), flushed_files.begin(), flushed_files.end());
-    metrics_->Merge(rolling_writer->GetMetrics());
+    return Status::OK();
+}
+
+Status MergeTreeWriter::TrySyncLatestCompaction(bool blocking) {
+    PAIMON_ASSIGN_OR_RAISE(std::optional<CompactResult> result,
+                           compact_manager_->GetCompactionResult(blocking));
+    if (result) {
+        PAIMON_RETURN_NOT_OK(UpdateCompactResult(result.value()));
+    }
+    return Status::OK();
+}
+
+Status MergeTreeWriter::UpdateCompactResult(const CompactResult& result) {
+    std::set<std::string> after_files;
+    for (const auto& file : result.After()) {
+        after_files.insert(file->file_name);
+    }
+    auto find_file = [](const std::vector<std::shared_ptr<DataFileMeta>>& files,
+                        const std::string& file_name) {
+        return std::find_if(files.begin(), files.end(), [&file_name](const auto& file) {
+            return file->file_name == file_name;
+        });
+    };
+    for (const auto& file : result.Before()) {
+        auto iter = find_file(compact_after_, file->file_name);
+        if (iter == compact_after_.end()) {
+            compact_before_.push_back(file);
+            continue;
+        }
+        compact_after_.erase(iter);
+        // an intermediate file produced and consumed by compactions within one commit is never
+        // visible to readers, delete it with its extra files unless it is upgraded (the same file
+        // name is kept) or it is also a committed file to be removed
+        if (find_file(compact_before_, file->file_name) == compact_before_.end() &&
+            after_files.find(file->file_name) == after_files.end()) {
+            for (const auto& path : path_factory_->CollectFiles(file)) {
+                PAIMON_RETURN_NOT_OK(options_.GetFileSystem()->Delete(path, false));
+            }
+        }
+    }
+    compact_after_.insert(compact_after_.end(), result.After().begin(), result.After().end());
     return Status::OK();
 }
 
 Result<CommitIncrement> MergeTreeWriter::DrainIncrement() {
     DataIncrement data_increment(std::move(new_files_), std::move(deleted_files_), {});
-    CompactIncrement compact_increment({}, {}, {});
+    CompactIncrement compact_increment(std::move(compact_before_), std::move(compact_after_), {});
     new_files_.clear();
     deleted_files_.clear();
+    compact_before_.clear();
+    compact_after_.clear();
     return CommitIncrement(data_increment, compact_increment);
 }
 
-std::unique_ptr<RollingFileWriter<KeyValueBatch, std::shared_ptr<DataFileMeta>>>
+std::unique_ptr<MergeTreeWriter::KeyValueRollingFileWriter>
 MergeTreeWriter::CreateRollingRowWriter() const {
     auto create_file_writer = [&]()
         -> Result<std::unique_ptr<SingleFileWriter<KeyValueBatch, std::shared_ptr<DataFileMeta>>>> {
@@ -196,79 +471,35 @@ MergeTreeWriter::CreateRollingRowWriter() const {
             return Status::OK();
         };
         auto writer = std::make_unique<KeyValueDataFileWriter>(
-            options_.GetFileCompression(), converter, schema_id_, FileSource::Append(),
-            trimmed_primary_keys_, stats_extractor, write_schema_, path_factory_->IsExternalPath(),
-            pool_);
+            options_.GetFileCompression(), converter, schema_id_, /*level=*/0,
+            FileSource::Append(), trimmed_primary_keys_, stats_extractor, write_schema_,
+            path_factory_->IsExternalPath(), pool_);
+        if (options_.WriteStatsInFlightEnabled()) {
+            PAIMON_ASSIGN_OR_RAISE(std::unique_ptr<BatchStatsCollector> stats_collector,
+                                   BatchStatsCollector::Create(write_schema_));
+            writer->WithStatsCollector(std::move(stats_collector));
+        }
+        PAIMON_ASSIGN_OR_RAISE(
+            std::unique_ptr<DataFileIndexWriter> file_index_writer,
+            DataFileIndexWriter::Create(write_schema_, options_.ToMap(),
+                                        options_.GetFileIndexInManifestThreshold(), pool_));
+        if (file_index_writer) {
+            writer->WithFileIndexWriter(std::move(file_index_writer));
+        }
         PAIMON_RETURN_NOT_OK(
             writer->Init(options_.GetFileSystem(), path_factory_->NewPath(), writer_builder));
         return writer;
     };
-    return std::make_unique<RollingFileWriter<KeyValueBatch, std::shared_ptr<DataFileMeta>>>(
-        options_.GetTargetFileSize(), create_file_writer);
+    return std::make_unique<KeyValueRollingFileWriter>(options_.GetTargetFileSize(),
+                                                       create_file_writer);
 }
 
-Result<int64_t> MergeTreeWriter::EstimateMemoryUse(const std::shared_ptr<arrow::Array>& array) {
-    arrow::Type::type type = array->type()->id();
-    int64_t null_bits_size_in_bytes = (array->length() + 7) / 8;
-    switch (type) {
-        case arrow::Type::type::BOOL:
-            return null_bits_size_in_bytes + array->length() * sizeof(bool);
-        case arrow::Type::type::INT8:
-            return null_bits_size_in_bytes + array->length() * sizeof(int8_t);
-        case arrow::Type::type::INT16:
-            return null_bits_size_in_bytes + array->length() * sizeof(int16_t);
-        case arrow::Type::type::INT32:
-            return null_bits_size_in_bytes + array->length() * sizeof(int32_t);
-        case arrow::Type::type::DATE32:
-            return null_bits_size_in_bytes + array->length() * sizeof(int32_t);
-        case arrow::Type::type::INT64:
-            return null_bits_size_in_bytes + array->length() * sizeof(int64_t);
-        case arrow::Type::type::FLOAT:
-            return null_bits_size_in_bytes + array->length() * sizeof(float);
-        case arrow::Type::type::DOUBLE:
-            return null_bits_size_in_bytes + array->length() * sizeof(double);
-        case arrow::Type::type::TIMESTAMP:
-            return null_bits_size_in_bytes + array->length() * sizeof(int64_t);
-        case arrow::Type::type::DECIMAL:
-            return null_bits_size_in_bytes + array->length() * sizeof(Decimal::int128_t);
-        case arrow::Type::type::STRING:
-        case arrow::Type::type::BINARY: {
-            auto binary_array =
-                arrow::internal::checked_cast<const arrow::BinaryArray*>(array.get());
-            assert(binary_array);
-            int64_t value_length = binary_array->total_values_length();
-            int64_t offset_length = array->length() * sizeof(int32_t);
-            return null_bits_size_in_bytes + value_length + offset_length;
-        }
-        case arrow::Type::type::LIST: {
-            auto list_array = arrow::internal::checked_cast<const arrow::ListArray*>(array.get());
-            assert(list_array);
-            PAIMON_ASSIGN_OR_RAISE(int64_t value_mem, EstimateMemoryUse(list_array->values()));
-            return null_bits_size_in_bytes + value_mem;
-        }
-        case arrow::Type::type::MAP: {
-            auto map_array = arrow::internal::checked_cast<const arrow::MapArray*>(array.get());
-            assert(map_array);
-            PAIMON_ASSIGN_OR_RAISE(int64_t key_mem, EstimateMemoryUse(map_array->keys()));
-            PAIMON_ASSIGN_OR_RAISE(int64_t item_mem, EstimateMemoryUse(map_array->items()));
-            return null_bits_size_in_bytes + key_mem + item_mem;
-        }
-        case arrow::Type::type::STRUCT: {
-            auto struct_array =
-                arrow::internal::checked_cast<const arrow::StructArray*>(array.get());
-            assert(struct_array);
-            int64_t struct_mem = 0;
-            for (const auto& field : struct_array->fields()) {
-                PAIMON_ASSIGN_OR_RAISE(int64_t field_mem, EstimateMemoryUse(field));
-                struct_mem += field_mem;
-            }
-            return null_bits_size_in_bytes + struct_mem;
-        }
-        default:
-            assert(false);
-            return Status::Invalid(fmt::format("Do not support type {} in EstimateMemoryUse",
-                                               array->type()->ToString()));
-    }
+int64_t MergeTreeWriter::EstimateMemoryUse(const arrow::Array& array,
+                                           const std::vector<RecordBatch::RowKind>& row_kinds) {
+    // buffers shared by several fields (or by a parent array of a slice) are only counted once,
+    // and variable-length types are covered without walking the type tree
+    return arrow::util::TotalBufferSize(*array.data()) +
+           static_cast<int64_t>(row_kinds.capacity() * sizeof(RecordBatch::RowKind));
 }
 
 }  // namespace paimon
@@ -16,21 +16,28 @@
 
 #pragma once
 #include <cstdint>
+#include <functional>
+#include <future>
 #include <memory>
 #include <string>
 #include <vector>
 
 #include "arrow/api.h"
+#include "paimon/core/compact/compact_manager.h"
+#include "paimon/core/compact/compact_result.h"
 #include "paimon/core/core_options.h"
 #include "paimon/core/io/data_file_meta.h"
 #include "paimon/core/io/data_file_path_factory.h"
 #include "paimon/core/io/rolling_file_writer.h"
 #include "paimon/core/key_value.h"
+#include "paimon/core/mergetree/compact/columnar_key_value_merger.h"
 #include "paimon/core/mergetree/compact/merge_function_wrapper.h"
+#include "paimon/core/mergetree/spilled_sorted_run.h"
 #include "paimon/core/utils/batch_writer.h"
 #include "paimon/core/utils/commit_increment.h"
 #include "paimon/core/utils/fields_comparator.h"
 #include "paimon/core/utils/path_factory.h"
+#include "paimon/core/utils/write_memory_manager.h"
 #include "paimon/record_batch.h"
 #include "paimon/result.h"
 #include "paimon/status.h"
@@ -44,14 +51,33 @@ class StructArray;
 
 namespace paimon {
 class DataFilePathFactory;
+class Executor;
 class FieldsComparator;
 class MemoryPool;
 class Metrics;
 template <typename T>
 class MergeFunctionWrapper;
 
-class MergeTreeWriter : public BatchWriter {
+/// Writer of a bucket of primary key table. Records are buffered in memory and flushed to level 0
+/// files once the write buffer is full.
+///
+/// The writer is double-buffered if an executor is given: the full buffer is sorted, merged and
+/// written on the executor while a new buffer keeps accepting writes, at most one flush is in
+/// flight. Flushed files are handed to the compact manager (if any), whose compaction runs in
+/// background and is collected into `CompactIncrement`.
+///
+/// With a `WriteMemoryManager`, the write buffer is also flushed when the memory manager picks it
+/// as one of the largest buffers of all writers. A buffer handed to a flush stays accounted until
+/// the flush completes.
+///
+/// If "write-buffer-spillable" is set, a full write buffer is sorted, merged and spilled to a
+/// local file as a sorted run instead. Spilled runs and the last write buffer are merged into one
+/// level 0 file when the buffer is flushed, which happens on commit, or once the spilled runs
+/// reach "local-sort.max-num-file-handles" or "write-buffer-spill.max-disk-size".
+class MergeTreeWriter : public BatchWriter, public MemoryOwner {
  public:
+    /// @param compact_manager nullptr indicates no compaction (e.g., write-only).
+    /// @param executor nullptr indicates the write buffer is flushed in the caller thread.
     MergeTreeWriter(int64_t last_sequence_number,
                     const std::vector<std::string>& trimmed_primary_keys,
                     const std::shared_ptr<DataFilePathFactory>& path_factory,
@@ -59,7 +85,9 @@ class MergeTreeWriter : public BatchWriter {
                     const std::shared_ptr<FieldsComparator>& user_defined_seq_comparator,
                     const std::shared_ptr<MergeFunctionWrapper<KeyValue>>& merge_function_wrapper,
                     int64_t schema_id, const std::shared_ptr<arrow::Schema>& value_schema,
-                    const CoreOptions& options, const std::shared_ptr<MemoryPool>& pool);
+                    const CoreOptions& options, const std::shared_ptr<MemoryPool>& pool,
+                    const std::shared_ptr<CompactManager>& compact_manager = nullptr,
+                    const std::shared_ptr<Executor>& executor = nullptr);
 
     ~MergeTreeWriter() override {
         [[maybe_unused]] auto status = DoClose();
@@ -68,7 +96,7 @@ class MergeTreeWriter : public BatchWriter {
     Result<CommitIncrement> PrepareCommit(bool wait_compaction) override;
 
     bool IsCompacting() const override {
-        return false;
+        return compact_manager_ && compact_manager_->CompactNotCompleted();
     }
 
     Status Close() override {
@@ -79,19 +107,71 @@ class MergeTreeWriter : public BatchWriter {
         return metrics_;
     }
 
- private:
-    Status DoClose() {
-        batch_vec_.clear();
-        row_kinds_vec_.clear();
-        return Status::OK();
+    Status FlushMemory() override {
+        return ShouldSpill() ? Spill() : Flush(/*wait_for_flush=*/false);
+    }
+
+    /// Share the write memory budget with other writers, see `WriteMemoryManager`.
+    void WithMemoryManager(const std::shared_ptr<WriteMemoryManager>& memory_manager) {
+        memory_manager_ = memory_manager;
+    }
+
+    /// Estimated memory of the active write buffer.
+    int64_t MemoryOccupancy() const {
+        return current_memory_in_bytes_;
     }
 
-    Status Flush();
+ private:
+    using KeyValueRollingFileWriter =
+        RollingFileWriter<KeyValueBatch, std::shared_ptr<DataFileMeta>>;
+    using KeyValueBatchConsumer = std::function<Status(KeyValueBatch&&)>;
+
+    Status DoClose();
+
+    // the active write buffer with the first sequence number of its rows, the sequence numbers
+    // are assigned when the buffer is taken
+    struct WriteBuffer {
+        std::vector<std::shared_ptr<arrow::StructArray>> batch_vec;
+        std::vector<std::vector<RecordBatch::RowKind>> row_kinds_vec;
+        int64_t first_sequence_number;
+    };
+    WriteBuffer TakeWriteBuffer();
+    // releases the memory of the taken write buffer once its flush or spill completes
+    void ReleaseFlushedMemory();
+
+    // hands the active write buffer and spilled runs to a flush, waits for it if
+    // `wait_for_flush` is true
+    Status Flush(bool wait_for_flush);
+    // waits for the in-flight flush (if any) and collects its files
+    Status WaitFlush();
+    // true if the active write buffer can be spilled instead of flushed
+    bool ShouldSpill() const;
+    // sorts, merges and spills the active write buffer to a local file
+    Status Spill();
+    // sorts, merges and writes buffered batches with spilled runs, may run on the executor
+    Result<std::unique_ptr<KeyValueRollingFileWriter>> FlushBatches(
+        WriteBuffer&& buffer, std::vector<std::shared_ptr<SpilledSortedRun>>&& spilled_runs) const;
+    // sorts and merges buffered batches with spilled runs, hands merged batches to `consumer`
+    Status SortAndMerge(WriteBuffer&& buffer,
+                        std::vector<std::shared_ptr<SpilledSortedRun>>&& spilled_runs,
+                        const KeyValueBatchConsumer& consumer) const;
+    // sort and merge buffered batches in columnar form, see ColumnarKeyValueMerger
+    Status FlushColumnar(const WriteBuffer& buffer, const KeyValueBatchConsumer& consumer) const;
+    // fallback for key types not supported by ColumnarKeyValueMerger, also merges spilled runs
+    Status FlushWithSortMergeReader(WriteBuffer&& buffer,
+                                    std::vector<std::shared_ptr<SpilledSortedRun>>&& spilled_runs,
+                                    const KeyValueBatchConsumer& consumer) const;
+    Status CollectFlushedFiles(KeyValueRollingFileWriter* writer);
+
+    Status TrySyncLatestCompaction(bool blocking);
+    Status UpdateCompactResult(const CompactResult& result);
     Result<CommitIncrement> DrainIncrement();
 
-    std::unique_ptr<RollingFileWriter<KeyValueBatch, std::shared_ptr<DataFileMeta>>>
-    CreateRollingRowWriter() const;
-    static Result<int64_t> EstimateMemoryUse(const std::shared_ptr<arrow::Array>& array);
+    std::unique_ptr<KeyValueRollingFileWriter> CreateRollingRowWriter() const;
+    // memory retained by a buffered batch, i.e. all (deduplicated) buffers referenced by `array`
+    // and its row kinds
+    static int64_t EstimateMemoryUse(const arrow::Array& array,
+                                     const std::vector<RecordBatch::RowKind>& row_kinds);
 
     // in case write batch size is too large and overflow arrow array
     static constexpr int32_t MAX_PROJECTION_BATCH_SIZE = 100000;
@@ -110,12 +190,30 @@ class MergeTreeWriter : public BatchWriter {
     // write_schema = value_schema + special fields
     std::shared_ptr<arrow::DataType> value_type_;
     std::shared_ptr<arrow::Schema> write_schema_;
+    // nullptr if primary key types are not supported by columnar merge
+    std::unique_ptr<ColumnarKeyValueMerger> columnar_merger_;
+
+    std::shared_ptr<CompactManager> compact_manager_;
+    std::shared_ptr<Executor> executor_;
+    // nullptr if the write buffer is only bounded by write-buffer-size
+    std::shared_ptr<WriteMemoryManager> memory_manager_;
+
+    // sorted runs spilled since the last flush, see "write-buffer-spillable"
+    std::vector<std::shared_ptr<SpilledSortedRun>> spilled_runs_;
+    int64_t spilled_bytes_ = 0;
+    std::string spill_path_prefix_;
+    int64_t spill_file_count_ = 0;
 
+    // active write buffer
     std::vector<std::shared_ptr<arrow::StructArray>> batch_vec_;
     std::vector<std::vector<RecordBatch::RowKind>> row_kinds_vec_;
+    // in-flight flush of the previous write buffer
+    std::future<Result<std::unique_ptr<KeyValueRollingFileWriter>>> flush_future_;
 
     std::shared_ptr<Metrics> metrics_;
     std::vector<std::shared_ptr<DataFileMeta>> new_files_;
     std::vector<std::shared_ptr<DataFileMeta>> deleted_files_;
+    std::vector<std::shared_ptr<DataFileMeta>> compact_before_;
+    std::vector<std::shared_ptr<DataFileMeta>> compact_after_;
 };
 }  // namespace paimon
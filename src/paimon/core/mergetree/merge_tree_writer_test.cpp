@@ -18,10 +18,15 @@
 
 #include <cassert>
 #include <cstddef>
+#include <filesystem>
+#include <functional>
+#include <future>
+#include <iterator>
 #include <map>
 #include <optional>
 #include <utility>
 #include <variant>
+#include <vector>
 
 #include "arrow/api.h"
 #include "arrow/array/array_base.h"
@@ -35,15 +40,24 @@
 #include "paimon/common/table/special_fields.h"
 #include "paimon/common/types/data_field.h"
 #include "paimon/common/utils/scope_guard.h"
+#include "paimon/core/compact/compact_future_manager.h"
+#include "paimon/core/compact/compact_result.h"
 #include "paimon/core/io/compact_increment.h"
+#include "paimon/core/io/data_file_meta.h"
 #include "paimon/core/io/data_file_path_factory.h"
 #include "paimon/core/io/data_increment.h"
 #include "paimon/core/manifest/file_source.h"
 #include "paimon/core/mergetree/compact/deduplicate_merge_function.h"
+#include "paimon/core/mergetree/compact/merge_tree_compact_manager.h"
 #include "paimon/core/mergetree/compact/reducer_merge_function_wrapper.h"
+#include "paimon/core/mergetree/compact/universal_compaction.h"
+#include "paimon/core/mergetree/levels.h"
+#include "paimon/core/stats/simple_stats.h"
 #include "paimon/core/utils/commit_increment.h"
 #include "paimon/core/utils/fields_comparator.h"
+#include "paimon/core/utils/write_memory_manager.h"
 #include "paimon/defs.h"
+#include "paimon/executor.h"
 #include "paimon/format/file_format.h"
 #include "paimon/format/file_format_factory.h"
 #include "paimon/fs/file_system.h"
@@ -123,6 +137,51 @@ class MergeTreeWriterTest : public ::testing::Test {
     std::shared_ptr<MergeFunctionWrapper<KeyValue>> merge_function_wrapper_;
 };
 
+/// Compacts the added files into `after_files`, the compaction only finishes after `Finish()`.
+class BlockingCompactManager : public CompactFutureManager {
+ public:
+    explicit BlockingCompactManager(const std::vector<std::shared_ptr<DataFileMeta>>& after_files)
+        : after_files_(after_files), finished_(finish_.get_future().share()) {}
+
+    bool ShouldWaitForLatestCompaction() const override {
+        return false;
+    }
+    bool ShouldWaitForPreparingCheckpoint() const override {
+        return false;
+    }
+    void AddNewFile(const std::shared_ptr<DataFileMeta>& file) override {
+        files_.push_back(file);
+    }
+    std::vector<std::shared_ptr<DataFileMeta>> AllFiles() const override {
+        return files_;
+    }
+    Status TriggerCompaction(bool full_compaction) override {
+        if (task_future_.valid() || files_.empty()) {
+            return Status::OK();
+        }
+        task_future_ = std::async(std::launch::async, [before = std::move(files_),
+                                                       after = after_files_,
+                                                       finished = finished_]() {
+            finished.wait();
+            return Result<CompactResult>(CompactResult(before, after));
+        });
+        files_.clear();
+        return Status::OK();
+    }
+    Result<std::optional<CompactResult>> GetCompactionResult(bool blocking) override {
+        return ObtainCompactResult(blocking);
+    }
+    void Finish() {
+        finish_.set_value();
+    }
+
+ private:
+    std::vector<std::shared_ptr<DataFileMeta>> after_files_;
+    std::vector<std::shared_ptr<DataFileMeta>> files_;
+    std::promise<void> finish_;
+    std::shared_future<void> finished_;
+};
+
 TEST_F(MergeTreeWriterTest, TestSimple) {
     ASSERT_OK_AND_ASSIGN(CoreOptions options,
                          CoreOptions::FromMap({{Options::FILE_FORMAT, "orc"}}));
@@ -681,6 +740,125 @@ TEST_F(MergeTreeWriterTest, TestAutoFlush) {
     ASSERT_EQ(expected_data_increment, commit_increment.GetNewFilesIncrement());
 }
 
+TEST_F(MergeTreeWriterTest, TestSpillWriteBuffer) {
+    // each batch is spilled due to WRITE_BUFFER_SIZE, spilled runs are merged into one file
+    auto spill_dir = UniqueTestDirectory::Create();
+    ASSERT_TRUE(spill_dir);
+    ASSERT_OK_AND_ASSIGN(CoreOptions options,
+                         CoreOptions::FromMap({{Options::FILE_FORMAT, "orc"},
+                                               {Options::WRITE_BUFFER_SIZE, "1"},
+                                               {Options::WRITE_BUFFER_SPILLABLE, "true"},
+                                               {Options::WRITE_BUFFER_SPILL_DIR, spill_dir->Str()},
+                                               {Options::SPILL_COMPRESSION, "lz4"}}));
+
+    auto dir = UniqueTestDirectory::Create();
+    ASSERT_TRUE(dir);
+    auto path_factory = std::make_shared<DataFilePathFactory>();
+    ASSERT_OK(path_factory->Init(dir->Str(), "orc", options.DataFilePrefix(), nullptr));
+    std::string uuid = path_factory->uuid_;
+
+    auto merge_writer = std::make_shared<MergeTreeWriter>(
+        /*last_sequence_number=*/9, primary_keys_, path_factory, key_comparator_,
+        /*user_defined_seq_comparator=*/nullptr, merge_function_wrapper_, /*schema_id=*/0,
+        value_schema_, options, pool_);
+    auto count_spill_files = [&spill_dir]() {
+        return std::distance(std::filesystem::directory_iterator(spill_dir->Str()),
+                             std::filesystem::directory_iterator());
+    };
+    std::shared_ptr<arrow::Array> array1 =
+        arrow::ipc::internal::json::ArrayFromJSON(value_type_, R"([
+      ["Lucy", 20, 1, 14.1],
+      ["Paul", 20, 1, null],
+      ["Alice", 10, 0, 13.1],
+      ["Paul", 20, 1, 15.1]
+    ])")
+            .ValueOrDie();
+    WriteBatch(array1, /*row_kinds=*/{}, merge_writer.get());
+    ASSERT_EQ(1, merge_writer->spilled_runs_.size());
+    ASSERT_EQ(1, count_spill_files());
+
+    std::shared_ptr<arrow::Array> array2 =
+        arrow::ipc::internal::json::ArrayFromJSON(value_type_, R"([
+      ["Lucy", 20, 1, 114.1],
+      ["Skye", 10, 0, 118.1],
+      ["Alice", 10, 0, 113.1]
+    ])")
+            .ValueOrDie();
+    WriteBatch(array2, /*row_kinds=*/{}, merge_writer.get());
+    ASSERT_EQ(2, merge_writer->spilled_runs_.size());
+    ASSERT_EQ(2, count_spill_files());
+    ASSERT_EQ(0, merge_writer->MemoryOccupancy());
+
+    ASSERT_OK_AND_ASSIGN(CommitIncrement commit_increment,
+                         merge_writer->PrepareCommit(/*wait_compaction=*/false));
+    ASSERT_OK(merge_writer->Close());
+    ASSERT_TRUE(merge_writer->spilled_runs_.empty());
+    ASSERT_EQ(0, count_spill_files());
+
+    ASSERT_EQ(1, commit_increment.GetNewFilesIncrement().NewFiles().size());
+    const auto& file_meta = commit_increment.GetNewFilesIncrement().NewFiles()[0];
+    ASSERT_EQ("data-" + uuid + "-0.orc", file_meta->file_name);
+    ASSERT_EQ(4, file_meta->row_count);
+    ASSERT_EQ(10, file_meta->min_sequence_number);
+    ASSERT_EQ(16, file_meta->max_sequence_number);
+    ASSERT_EQ(0, file_meta->level);
+
+    std::shared_ptr<arrow::ChunkedArray> expected_array;
+    auto array_status = arrow::ipc::internal::json::ChunkedArrayFromJSON(write_type_, {R"([
+      [16, 0, "Alice", 10, 0, 113.1],
+      [14, 0, "Lucy", 20, 1, 114.1],
+      [13, 0, "Paul", 20, 1, 15.1],
+      [15, 0, "Skye", 10, 0, 118.1]
+    ])"},
+                                                                        &expected_array);
+    ASSERT_TRUE(array_status.ok());
+    CheckFileContent(dir->Str() + "/" + file_meta->file_name, expected_array);
+}
+
+TEST_F(MergeTreeWriterTest, TestSpillLimitedByFileHandles) {
+    // the third batch is flushed together with two spilled runs as no more file handle is allowed
+    auto spill_dir = UniqueTestDirectory::Create();
+    ASSERT_TRUE(spill_dir);
+    ASSERT_OK_AND_ASSIGN(
+        CoreOptions options,
+        CoreOptions::FromMap({{Options::FILE_FORMAT, "orc"},
+                              {Options::WRITE_BUFFER_SIZE, "1"},
+                              {Options::WRITE_BUFFER_SPILLABLE, "true"},
+                              {Options::WRITE_BUFFER_SPILL_DIR, spill_dir->Str()},
+                              {Options::LOCAL_SORT_MAX_NUM_FILE_HANDLES, "2"}}));
+
+    auto dir = UniqueTestDirectory::Create();
+    ASSERT_TRUE(dir);
+    auto path_factory = std::make_shared<DataFilePathFactory>();
+    ASSERT_OK(path_factory->Init(dir->Str(), "orc", options.DataFilePrefix(), nullptr));
+
+    auto merge_writer = std::make_shared<MergeTreeWriter>(
+        /*last_sequence_number=*/-1, primary_keys_, path_factory, key_comparator_,
+        /*user_defined_seq_comparator=*/nullptr, merge_function_wrapper_, /*schema_id=*/0,
+        value_schema_, options, pool_);
+    for (const auto& json : {R"([["Lucy", 20, 1, 14.1]])", R"([["Alice", 10, 0, 13.1]])",
+                             R"([["Lucy", 21, 1, 15.1]])"}) {
+        WriteBatch(arrow::ipc::internal::json::ArrayFromJSON(value_type_, json).ValueOrDie(),
+                   /*row_kinds=*/{}, merge_writer.get());
+    }
+    ASSERT_TRUE(merge_writer->spilled_runs_.empty());
+    ASSERT_OK_AND_ASSIGN(CommitIncrement commit_increment,
+                         merge_writer->PrepareCommit(/*wait_compaction=*/false));
+    ASSERT_OK(merge_writer->Close());
+
+    ASSERT_EQ(1, commit_increment.GetNewFilesIncrement().NewFiles().size());
+    std::shared_ptr<arrow::ChunkedArray> expected_array;
+    auto array_status = arrow::ipc::internal::json::ChunkedArrayFromJSON(write_type_, {R"([
+      [1, 0, "Alice", 10, 0, 13.1],
+      [2, 0, "Lucy", 21, 1, 15.1]
+    ])"},
+                                                                        &expected_array);
+    ASSERT_TRUE(array_status.ok());
+    CheckFileContent(
+        dir->Str() + "/" + commit_increment.GetNewFilesIncrement().NewFiles()[0]->file_name,
+        expected_array);
+}
+
 TEST_F(MergeTreeWriterTest, TestIOException) {
     ASSERT_OK_AND_ASSIGN(CoreOptions options,
                          CoreOptions::FromMap({{Options::FILE_FORMAT, "orc"}}));
@@ -726,73 +904,247 @@ TEST_F(MergeTreeWriterTest, TestIOException) {
 }
 
 TEST_F(MergeTreeWriterTest, TestEstimateMemoryUse) {
-    {
-        // test simple
-        std::shared_ptr<arrow::Array> array =
-            arrow::ipc::internal::json::ArrayFromJSON(value_type_, R"([
+    auto array = arrow::ipc::internal::json::ArrayFromJSON(value_type_, R"([
           ["Lucy", 20, 1, 14.1],
           ["Paul", 20, 1, null],
           ["Alice", 10, 0, 13.1]
         ])")
-                .ValueOrDie();
-        ASSERT_OK_AND_ASSIGN(int64_t memory_use, MergeTreeWriter::EstimateMemoryUse(array));
-        int64_t expected_memory_use =
-            1 + (13 + 3 * 4 + 1) + (3 * 4 + 1) + (3 * 4 + 1) + (3 * 8 + 1);
-        ASSERT_EQ(memory_use, expected_memory_use);
+                     .ValueOrDie();
+    std::vector<RecordBatch::RowKind> row_kinds(3, RecordBatch::RowKind::INSERT);
+    int64_t memory_use = MergeTreeWriter::EstimateMemoryUse(*array, row_kinds);
+    {
+        // string values and offsets, fixed-width values and row kinds, plus at most one byte of
+        // validity bitmap for the struct and each of its 4 fields
+        int64_t data_memory_use = 13 + 4 * 4 + 3 * 4 + 3 * 4 + 3 * 8 + 3;
+        ASSERT_GE(memory_use, data_memory_use);
+        ASSERT_LE(memory_use, data_memory_use + 5);
+        ASSERT_EQ(memory_use - static_cast<int64_t>(row_kinds.capacity()),
+                  MergeTreeWriter::EstimateMemoryUse(*array, /*row_kinds=*/{}));
+    }
+    {
+        // arrays without validity bitmaps are estimated exactly
+        auto int_array = std::make_shared<arrow::Int32Array>(
+            4, arrow::Buffer::FromVector(std::vector<int32_t>({1, 2, 3, 4})));
+        auto long_array = std::make_shared<arrow::Int64Array>(
+            4, arrow::Buffer::FromVector(std::vector<int64_t>({1, 2, 3, 4})));
+        auto struct_array = arrow::StructArray::Make({int_array, long_array}, {"f0", "f1"});
+        ASSERT_TRUE(struct_array.ok());
+        std::vector<RecordBatch::RowKind> kinds(4, RecordBatch::RowKind::INSERT);
+        ASSERT_EQ(4 * 4 + 4 * 8 + 4,
+                  MergeTreeWriter::EstimateMemoryUse(*struct_array.ValueOrDie(), kinds));
     }
     {
-        // test primitive type
-        arrow::FieldVector fields = {arrow::field("v0", arrow::boolean()),
-                                     arrow::field("v1", arrow::int8()),
-                                     arrow::field("v2", arrow::int16()),
-                                     arrow::field("v3", arrow::int32()),
-                                     arrow::field("v4", arrow::int64()),
-                                     arrow::field("v5", arrow::float32()),
-                                     arrow::field("v6", arrow::float64()),
-                                     arrow::field("v7", arrow::date32()),
-                                     arrow::field("v8", arrow::timestamp(arrow::TimeUnit::NANO)),
-                                     arrow::field("v9", arrow::decimal128(30, 20)),
-                                     arrow::field("v10", arrow::utf8()),
-                                     arrow::field("v11", arrow::binary())};
-
-        auto array = std::dynamic_pointer_cast<arrow::StructArray>(
-            arrow::ipc::internal::json::ArrayFromJSON(arrow::struct_(fields), R"([
-        [true, 10, 200, 65536, 123456789, 0.0, 0.0, 2000, -86399999999500, "2134.48690000000000000009", "difference", "Alice"],
-        [false, -128, -32768, -2147483648, -9223372036854775808, -3.4028235E38, -1.7976931348623157E308, -719528, -9223372036854775808, "-999999999999999999.99999999999999999999", "Alice", "Two"],
-        [true, 127, 32767, 2147483647, 9223372036854775807, 3.4028235E38, 1.7976931348623157E308, 2932896, 9223372036854775807, "999999999999999999.99999999999999999999", "Alice", "made"],
-        [true, 0, 0, 0, 0, 1.4E-45, 4.9E-324, 0, 0, "0.00000000000000000000", "Alice", "wood"]
-])")
-                .ValueOrDie());
-        ASSERT_OK_AND_ASSIGN(int64_t memory_use, MergeTreeWriter::EstimateMemoryUse(array));
-        int64_t expected_memory_use = 1 + (4 + 1) + (4 + 1) + (2 * 4 + 1) + (4 * 4 + 1) +
-                                      (8 * 4 + 1) + (4 * 4 + 1) + (8 * 4 + 1) + (4 * 4 + 1) +
-                                      (8 * 4 + 1) + (4 * 16 + 1) + (25 + 4 * 4 + 1) +
-                                      (16 + 4 * 4 + 1);
-        ASSERT_EQ(memory_use, expected_memory_use);
+        // longer strings only grow the value buffer
+        auto long_array = arrow::ipc::internal::json::ArrayFromJSON(value_type_, R"([
+          ["Lucy-Lucy", 20, 1, 14.1],
+          ["Paul", 20, 1, null],
+          ["Alice-Alice", 10, 0, 13.1]
+        ])")
+                              .ValueOrDie();
+        ASSERT_EQ(memory_use + 11, MergeTreeWriter::EstimateMemoryUse(*long_array, row_kinds));
     }
     {
-        // test nested type
+        // a slice retains all buffers of its parent
+        ASSERT_EQ(memory_use, MergeTreeWriter::EstimateMemoryUse(*array->Slice(1, 2), row_kinds));
+    }
+    {
+        // nested types and types without a fixed-width layout in paimon
         arrow::FieldVector fields = {
             arrow::field("f0", arrow::list(arrow::int32())),
             arrow::field("f1", arrow::map(arrow::utf8(), arrow::int64())),
             arrow::field("f2", arrow::struct_({arrow::field("sub1", arrow::int64()),
-                                               arrow::field("sub2", arrow::float64()),
-                                               arrow::field("sub3", arrow::boolean())})),
-        };
-        auto array = std::dynamic_pointer_cast<arrow::StructArray>(
-            arrow::ipc::internal::json::ArrayFromJSON(arrow::struct_({fields}), R"([
-        [[1, 2, 3],    [["apple", 3], ["banana", 4]],          [10, 10.1, false]],
-        [[4, 5],       [["cat", 5], ["dog", 6], ["mouse", 7]], [20, 20.1, true]],
-        [[6],          [["elephant", 7], ["fox", 8]],          [null, 30.1, true]]
+                                               arrow::field("sub2", arrow::float64())})),
+            arrow::field("f3", arrow::large_utf8()),
+            arrow::field("f4", arrow::fixed_size_binary(4))};
+        auto nested_array = arrow::ipc::internal::json::ArrayFromJSON(arrow::struct_(fields), R"([
+        [[1, 2, 3], [["apple", 3], ["banana", 4]],          [10, 10.1],   "Alice", "abcd"],
+        [[4, 5],    [["cat", 5], ["dog", 6], ["mouse", 7]], [20, 20.1],   "Bob",   "efgh"],
+        [[6],       [["elephant", 7], ["fox", 8]],          [null, 30.1], null,    null]
     ])")
-                .ValueOrDie());
-        ASSERT_OK_AND_ASSIGN(int64_t memory_use, MergeTreeWriter::EstimateMemoryUse(array));
-        int64_t list_mem = 1 + (4 * 6 + 1);
-        int64_t map_mem = 1 + (33 + 4 * 7 + 1) + (8 * 7 + 1);
-        int64_t struct_mem = 1 + (8 * 3 + 1) + (8 * 3 + 1) + (1 * 3 + 1);
-        int64_t expected_memory_use = 1 + list_mem + map_mem + struct_mem;
-        ASSERT_EQ(memory_use, expected_memory_use);
+                                .ValueOrDie();
+        // list offsets and values, map offsets, key offsets and values and items, struct fields,
+        // large string offsets and values, fixed-size binary values
+        int64_t data_memory_use = (4 * 4 + 4 * 6) + (4 * 4 + 4 * 8 + 33 + 8 * 7) +
+                                  (8 * 3 + 8 * 3) + (8 * 4 + 8) + 4 * 3;
+        // at most one byte of validity bitmap for each of the 12 arrays in the tree
+        int64_t nested_memory_use =
+            MergeTreeWriter::EstimateMemoryUse(*nested_array, /*row_kinds=*/{});
+        ASSERT_GE(nested_memory_use, data_memory_use);
+        ASSERT_LE(nested_memory_use, data_memory_use + 12);
+    }
+}
+
+TEST_F(MergeTreeWriterTest, TestSharedWriteMemory) {
+    ASSERT_OK_AND_ASSIGN(CoreOptions options,
+                         CoreOptions::FromMap({{Options::FILE_FORMAT, "orc"}}));
+    auto dir = UniqueTestDirectory::Create();
+    ASSERT_TRUE(dir);
+    auto create_writer = [&]() -> std::shared_ptr<MergeTreeWriter> {
+        auto path_factory = std::make_shared<DataFilePathFactory>();
+        EXPECT_OK(path_factory->Init(dir->Str(), "orc", options.DataFilePrefix(), nullptr));
+        return std::make_shared<MergeTreeWriter>(
+            /*last_sequence_number=*/-1, primary_keys_, path_factory, key_comparator_,
+            /*user_defined_seq_comparator=*/nullptr, merge_function_wrapper_, /*schema_id=*/0,
+            value_schema_, options, pool_);
+    };
+    auto large_array = arrow::ipc::internal::json::ArrayFromJSON(value_type_, R"([
+          ["Lucy", 20, 1, 14.1],
+          ["Paul", 20, 1, null],
+          ["Alice", 10, 0, 13.1],
+          ["Skye", 10, 0, 12.1],
+          ["Emily", 30, 1, 11.1],
+          ["Tony", 30, 1, 10.1],
+          ["Lily", 40, 0, 9.1],
+          ["Marco", 40, 0, 8.1]
+        ])")
+                           .ValueOrDie();
+    auto small_array = arrow::ipc::internal::json::ArrayFromJSON(value_type_, R"([
+          ["Bob", 30, 1, 11.1]
+        ])")
+                           .ValueOrDie();
+    std::vector<RecordBatch::RowKind> large_row_kinds(8, RecordBatch::RowKind::INSERT);
+    std::vector<RecordBatch::RowKind> small_row_kinds(1, RecordBatch::RowKind::INSERT);
+    int64_t large_memory = MergeTreeWriter::EstimateMemoryUse(*large_array, large_row_kinds);
+    int64_t small_memory = MergeTreeWriter::EstimateMemoryUse(*small_array, small_row_kinds);
+    ASSERT_GT(large_memory, 2 * small_memory);
+
+    // the budget holds the large buffer and one small buffer, but not another small one
+    auto memory_manager =
+        std::make_shared<WriteMemoryManager>(large_memory + small_memory + small_memory / 2);
+    auto large_writer = create_writer();
+    auto small_writer = create_writer();
+    large_writer->WithMemoryManager(memory_manager);
+    small_writer->WithMemoryManager(memory_manager);
+
+    WriteBatch(large_array, large_row_kinds, large_writer.get());
+    WriteBatch(small_array, small_row_kinds, small_writer.get());
+    ASSERT_EQ(large_memory, large_writer->MemoryOccupancy());
+    ASSERT_EQ(small_memory, small_writer->MemoryOccupancy());
+    ASSERT_EQ(large_memory + small_memory, memory_manager->TotalMemory());
+    ASSERT_TRUE(large_writer->new_files_.empty());
+
+    // the small writer exceeds the budget, the largest buffer is flushed
+    WriteBatch(small_array, small_row_kinds, small_writer.get());
+    ASSERT_EQ(0, large_writer->MemoryOccupancy());
+    ASSERT_EQ(1, large_writer->new_files_.size());
+    ASSERT_EQ(2 * small_memory, small_writer->MemoryOccupancy());
+    ASSERT_EQ(2 * small_memory, memory_manager->TotalMemory());
+    ASSERT_TRUE(small_writer->new_files_.empty());
+
+    ASSERT_OK_AND_ASSIGN(CommitIncrement large_increment,
+                         large_writer->PrepareCommit(/*wait_compaction=*/false));
+    ASSERT_EQ(1, large_increment.GetNewFilesIncrement().NewFiles().size());
+    ASSERT_EQ(8, large_increment.GetNewFilesIncrement().NewFiles()[0]->row_count);
+    ASSERT_OK_AND_ASSIGN(CommitIncrement small_increment,
+                         small_writer->PrepareCommit(/*wait_compaction=*/false));
+    ASSERT_EQ(1, small_increment.GetNewFilesIncrement().NewFiles().size());
+    ASSERT_EQ(0, memory_manager->TotalMemory());
+
+    ASSERT_OK(large_writer->Close());
+    ASSERT_OK(small_writer->Close());
+}
+
+// Runs the added tasks only when asked to, so that a flush stays in flight.
+class DeferredExecutor : public Executor {
+ public:
+    void Add(std::function<void()> func) override {
+        tasks_.push_back(std::move(func));
     }
+
+    void RunAll() {
+        std::vector<std::function<void()>> tasks = std::move(tasks_);
+        tasks_.clear();
+        for (auto& task : tasks) {
+            task();
+        }
+    }
+
+ private:
+    std::vector<std::function<void()>> tasks_;
+};
+
+TEST_F(MergeTreeWriterTest, TestFlushingMemoryAccountedUntilCompleted) {
+    ASSERT_OK_AND_ASSIGN(CoreOptions options,
+                         CoreOptions::FromMap({{Options::FILE_FORMAT, "orc"}}));
+    auto dir = UniqueTestDirectory::Create();
+    ASSERT_TRUE(dir);
+    auto path_factory = std::make_shared<DataFilePathFactory>();
+    ASSERT_OK(path_factory->Init(dir->Str(), "orc", options.DataFilePrefix(), nullptr));
+    auto executor = std::make_shared<DeferredExecutor>();
+    auto merge_writer = std::make_shared<MergeTreeWriter>(
+        /*last_sequence_number=*/-1, primary_keys_, path_factory, key_comparator_,
+        /*user_defined_seq_comparator=*/nullptr, merge_function_wrapper_, /*schema_id=*/0,
+        value_schema_, options, pool_, /*compact_manager=*/nullptr, executor);
+    auto memory_manager = std::make_shared<WriteMemoryManager>(/*budget=*/1024 * 1024);
+    merge_writer->WithMemoryManager(memory_manager);
+
+    auto array = arrow::ipc::internal::json::ArrayFromJSON(value_type_, R"([
+          ["Lucy", 20, 1, 14.1],
+          ["Paul", 20, 1, null]
+        ])")
+                     .ValueOrDie();
+    WriteBatch(array, /*row_kinds=*/{}, merge_writer.get());
+    int64_t memory = merge_writer->MemoryOccupancy();
+    ASSERT_GT(memory, 0);
+    ASSERT_EQ(memory, memory_manager->MemoryOf(merge_writer.get()));
+
+    // the buffer is handed to a flush, it is not flushed again but still accounted
+    ASSERT_OK(merge_writer->FlushMemory());
+    ASSERT_TRUE(merge_writer->flush_future_.valid());
+    ASSERT_EQ(0, merge_writer->MemoryOccupancy());
+    ASSERT_EQ(0, memory_manager->MemoryOf(merge_writer.get()));
+    ASSERT_EQ(memory, memory_manager->FlushingMemoryOf(merge_writer.get()));
+    ASSERT_EQ(memory, memory_manager->TotalMemory());
+
+    // released once the completed flush is collected
+    executor->RunAll();
+    ASSERT_EQ(memory, memory_manager->TotalMemory());
+    ASSERT_OK(merge_writer->WaitFlush());
+    ASSERT_EQ(0, memory_manager->FlushingMemoryOf(merge_writer.get()));
+    ASSERT_EQ(0, memory_manager->TotalMemory());
+    ASSERT_EQ(1, merge_writer->new_files_.size());
+    ASSERT_OK(merge_writer->Close());
+}
+
+TEST_F(MergeTreeWriterTest, TestFlushMemorySpills) {
+    auto spill_dir = UniqueTestDirectory::Create();
+    ASSERT_TRUE(spill_dir);
+    ASSERT_OK_AND_ASSIGN(
+        CoreOptions options,
+        CoreOptions::FromMap({{Options::FILE_FORMAT, "orc"},
+                              {Options::WRITE_BUFFER_SPILLABLE, "true"},
+                              {Options::WRITE_BUFFER_SPILL_DIR, spill_dir->Str()}}));
+    auto dir = UniqueTestDirectory::Create();
+    ASSERT_TRUE(dir);
+    auto path_factory = std::make_shared<DataFilePathFactory>();
+    ASSERT_OK(path_factory->Init(dir->Str(), "orc", options.DataFilePrefix(), nullptr));
+    auto merge_writer = std::make_shared<MergeTreeWriter>(
+        /*last_sequence_number=*/-1, primary_keys_, path_factory, key_comparator_,
+        /*user_defined_seq_comparator=*/nullptr, merge_function_wrapper_, /*schema_id=*/0,
+        value_schema_, options, pool_);
+    auto memory_manager = std::make_shared<WriteMemoryManager>(/*budget=*/1024 * 1024);
+    merge_writer->WithMemoryManager(memory_manager);
+
+    auto array = arrow::ipc::internal::json::ArrayFromJSON(value_type_, R"([
+          ["Lucy", 20, 1, 14.1],
+          ["Paul", 20, 1, null]
+        ])")
+                     .ValueOrDie();
+    WriteBatch(array, /*row_kinds=*/{}, merge_writer.get());
+    ASSERT_GT(memory_manager->TotalMemory(), 0);
+
+    // the memory manager picks a spillable writer, its buffer is spilled instead of flushed
+    ASSERT_OK(merge_writer->FlushMemory());
+    ASSERT_EQ(1, merge_writer->spilled_runs_.size());
+    ASSERT_TRUE(merge_writer->new_files_.empty());
+    ASSERT_EQ(0, merge_writer->MemoryOccupancy());
+    ASSERT_EQ(0, memory_manager->TotalMemory());
+
+    ASSERT_OK_AND_ASSIGN(CommitIncrement commit_increment,
+                         merge_writer->PrepareCommit(/*wait_compaction=*/false));
+    ASSERT_EQ(1, commit_increment.GetNewFilesIncrement().NewFiles().size());
+    ASSERT_EQ(2, commit_increment.GetNewFilesIncrement().NewFiles()[0]->row_count);
+    ASSERT_OK(merge_writer->Close());
 }
 
 TEST_F(MergeTreeWriterTest, TestBulkData) {
@@ -863,4 +1215,137 @@ TEST_F(MergeTreeWriterTest, TestBulkData) {
     }
 }
 
+TEST_F(MergeTreeWriterTest, TestCloseWithUncommittedCompaction) {
+    ASSERT_OK_AND_ASSIGN(CoreOptions options,
+                         CoreOptions::FromMap({{Options::FILE_FORMAT, "orc"}}));
+    auto dir = UniqueTestDirectory::Create();
+    ASSERT_TRUE(dir);
+    auto path_factory = std::make_shared<DataFilePathFactory>();
+    ASSERT_OK(path_factory->Init(dir->Str(), "orc", options.DataFilePrefix(), nullptr));
+
+    // the compaction output and its index file
+    ASSERT_OK_AND_ASSIGN(
+        std::shared_ptr<DataFileMeta> compacted,
+        DataFileMeta::ForAppend("compacted.orc", /*file_size=*/10, /*row_count=*/3,
+                                SimpleStats::EmptyStats(), /*min_sequence_number=*/0,
+                                /*max_sequence_number=*/2, /*schema_id=*/0,
+                                /*extra_files=*/{"compacted.orc.index"},
+                                /*embedded_index=*/nullptr, FileSource::Compact(), std::nullopt,
+                                std::nullopt, std::nullopt, std::nullopt));
+    std::vector<std::string> compacted_paths = path_factory->CollectFiles(compacted);
+    for (const auto& path : compacted_paths) {
+        ASSERT_OK(file_system_->WriteFile(path, "data", /*overwrite=*/false));
+    }
+    auto compact_manager = std::make_shared<BlockingCompactManager>(
+        std::vector<std::shared_ptr<DataFileMeta>>({compacted}));
+    auto merge_writer = std::make_shared<MergeTreeWriter>(
+        /*last_sequence_number=*/-1, primary_keys_, path_factory, key_comparator_,
+        /*user_defined_seq_comparator=*/nullptr, merge_function_wrapper_, /*schema_id=*/0,
+        value_schema_, options, pool_, compact_manager);
+
+    std::shared_ptr<arrow::Array> array =
+        arrow::ipc::internal::json::ArrayFromJSON(value_type_, R"([
+      ["Lucy", 20, 1, 14.1],
+      ["Alice", 10, 0, 13.1]
+    ])")
+            .ValueOrDie();
+    WriteBatch(array, /*row_kinds=*/{}, merge_writer.get());
+    ASSERT_OK_AND_ASSIGN(CommitIncrement commit_increment,
+                         merge_writer->PrepareCommit(/*wait_compaction=*/false));
+    ASSERT_EQ(1, commit_increment.GetNewFilesIncrement().NewFiles().size());
+    ASSERT_TRUE(commit_increment.GetCompactIncrement().IsEmpty());
+    ASSERT_TRUE(merge_writer->IsCompacting());
+
+    // the compaction finishes, but its result is never committed
+    compact_manager->Finish();
+    ASSERT_OK(merge_writer->Close());
+    for (const auto& path : compacted_paths) {
+        ASSERT_OK_AND_ASSIGN(bool exists, file_system_->Exists(path));
+        ASSERT_FALSE(exists) << path;
+    }
+    // the flushed file is committed, it is kept
+    ASSERT_OK_AND_ASSIGN(bool exists,
+                         file_system_->Exists(path_factory->ToPath(
+                             commit_increment.GetNewFilesIncrement().NewFiles()[0])));
+    ASSERT_TRUE(exists);
+}
+
+
+TEST_F(MergeTreeWriterTest, TestBackgroundFlushAndCompaction) {
+    ASSERT_OK_AND_ASSIGN(CoreOptions options,
+                         CoreOptions::FromMap({{Options::FILE_FORMAT, "orc"}}));
+    auto dir = UniqueTestDirectory::Create();
+    ASSERT_TRUE(dir);
+    auto path_factory = std::make_shared<DataFilePathFactory>();
+    ASSERT_OK(path_factory->Init(dir->Str(), "orc", options.DataFilePrefix(), nullptr));
+
+    // any two sorted runs are compacted to the max level, flushed files do not overlap so they
+    // are upgraded without a rewriter
+    ASSERT_OK_AND_ASSIGN(std::shared_ptr<FieldsComparator> file_key_comparator,
+                         FieldsComparator::Create({value_fields_[0]}, /*is_ascending_order=*/true,
+                                                  /*use_view=*/false));
+    ASSERT_OK_AND_ASSIGN(std::unique_ptr<Levels> levels,
+                         Levels::Create(file_key_comparator, /*input_files=*/{},
+                                        /*num_levels=*/3));
+    std::shared_ptr<Executor> executor = CreateDefaultExecutor(/*thread_count=*/2);
+    auto compact_manager = std::make_shared<MergeTreeCompactManager>(
+        executor, std::move(levels),
+        UniversalCompaction(/*max_size_amp=*/0, /*size_ratio=*/1, /*num_run_compaction_trigger=*/2),
+        file_key_comparator, /*compaction_file_size=*/1, /*num_sorted_run_stop_trigger=*/5,
+        /*rewriter=*/nullptr);
+    auto merge_writer = std::make_shared<MergeTreeWriter>(
+        /*last_sequence_number=*/-1, primary_keys_, path_factory, key_comparator_,
+        /*user_defined_seq_comparator=*/nullptr, merge_function_wrapper_, /*schema_id=*/0,
+        value_schema_, options, pool_, compact_manager, executor);
+
+    std::shared_ptr<arrow::Array> array1 =
+        arrow::ipc::internal::json::ArrayFromJSON(value_type_, R"([
+      ["Bob", 20, 1, 14.1],
+      ["Alice", 10, 0, 13.1]
+    ])")
+            .ValueOrDie();
+    WriteBatch(array1, /*row_kinds=*/{}, merge_writer.get());
+    ASSERT_OK_AND_ASSIGN(CommitIncrement commit_increment1,
+                         merge_writer->PrepareCommit(/*wait_compaction=*/false));
+    ASSERT_EQ(1, commit_increment1.GetNewFilesIncrement().NewFiles().size());
+    ASSERT_TRUE(commit_increment1.GetCompactIncrement().IsEmpty());
+    auto file1 = commit_increment1.GetNewFilesIncrement().NewFiles()[0];
+
+    std::shared_ptr<arrow::Array> array2 =
+        arrow::ipc::internal::json::ArrayFromJSON(value_type_, R"([
+      ["Paul", 20, 1, null],
+      ["Lucy", 30, 3, 15.1]
+    ])")
+            .ValueOrDie();
+    WriteBatch(array2, /*row_kinds=*/{}, merge_writer.get());
+    ASSERT_OK_AND_ASSIGN(CommitIncrement commit_increment2,
+                         merge_writer->PrepareCommit(/*wait_compaction=*/true));
+    ASSERT_EQ(1, commit_increment2.GetNewFilesIncrement().NewFiles().size());
+    auto file2 = commit_increment2.GetNewFilesIncrement().NewFiles()[0];
+    ASSERT_EQ(2, file2->min_sequence_number);
+    ASSERT_FALSE(merge_writer->IsCompacting());
+
+    // both flushed files are upgraded to the max level
+    const CompactIncrement& compact_increment = commit_increment2.GetCompactIncrement();
+    ASSERT_EQ(2, compact_increment.CompactBefore().size());
+    ASSERT_EQ(file1->file_name, compact_increment.CompactBefore()[0]->file_name);
+    ASSERT_EQ(file2->file_name, compact_increment.CompactBefore()[1]->file_name);
+    ASSERT_EQ(2, compact_increment.CompactAfter().size());
+    ASSERT_EQ(file1->file_name, compact_increment.CompactAfter()[0]->file_name);
+    ASSERT_EQ(file2->file_name, compact_increment.CompactAfter()[1]->file_name);
+    for (const auto& file : compact_increment.CompactAfter()) {
+        ASSERT_EQ(2, file->level);
+    }
+    const Levels& compacted_levels = compact_manager->GetLevels();
+    ASSERT_TRUE(compacted_levels.Level0().empty());
+    ASSERT_EQ(2, compacted_levels.RunOfLevel(2).Files().size());
+
+    // upgraded files are committed files, closing the writer keeps them
+    ASSERT_OK(merge_writer->Close());
+    for (const auto& file : {file1, file2}) {
+        ASSERT_OK_AND_ASSIGN(bool exists, file_system_->Exists(path_factory->ToPath(file)));
+        ASSERT_TRUE(exists) << file->file_name;
+    }
+}
+
 }  // namespace paimon::test
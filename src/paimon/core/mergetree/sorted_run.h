@@ -16,6 +16,7 @@
 
 #pragma once
 
+#include <algorithm>
 #include <cstddef>
 #include <cstdint>
 #include <memory>
@@ -37,6 +38,18 @@ class SortedRun {
     static SortedRun FromSorted(const std::vector<std::shared_ptr<DataFileMeta>>& meta) {
         return SortedRun(meta);
     }
+    static SortedRun FromUnsorted(std::vector<std::shared_ptr<DataFileMeta>> unsorted_files,
+                                  const std::shared_ptr<FieldsComparator>& key_comparator) {
+        std::sort(unsorted_files.begin(), unsorted_files.end(),
+                  [&key_comparator](const std::shared_ptr<DataFileMeta>& lhs,
+                                    const std::shared_ptr<DataFileMeta>& rhs) {
+                      return key_comparator->CompareTo(lhs->min_key, rhs->min_key) < 0;
+                  });
+        return SortedRun(unsorted_files);
+    }
+    bool IsEmpty() const {
+        return files_.empty();
+    }
     const std::vector<std::shared_ptr<DataFileMeta>>& Files() const& {
         return files_;
     }
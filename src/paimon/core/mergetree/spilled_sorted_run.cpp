@@ -0,0 +1,207 @@
+/*
+ * Copyright 2024-present Alibaba Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "paimon/core/mergetree/spilled_sorted_run.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <utility>
+
+#include "arrow/api.h"
+#include "arrow/c/abi.h"
+#include "arrow/c/bridge.h"
+#include "arrow/io/file.h"
+#include "arrow/ipc/reader.h"
+#include "arrow/ipc/writer.h"
+#include "arrow/util/checked_cast.h"
+#include "arrow/util/compression.h"
+#include "fmt/format.h"
+#include "paimon/common/metrics/metrics_impl.h"
+#include "paimon/common/table/special_fields.h"
+#include "paimon/common/utils/arrow/mem_utils.h"
+#include "paimon/common/utils/arrow/status_utils.h"
+
+namespace paimon {
+namespace {
+
+class SpilledSortedRunReader : public BatchReader {
+ public:
+    SpilledSortedRunReader(std::unique_ptr<arrow::MemoryPool>&& arrow_pool,
+                           const std::shared_ptr<arrow::io::ReadableFile>& file,
+                           const std::shared_ptr<arrow::ipc::RecordBatchFileReader>& reader)
+        : arrow_pool_(std::move(arrow_pool)),
+          file_(file),
+          reader_(reader),
+          metrics_(std::make_shared<MetricsImpl>()) {}
+
+    Result<ReadBatch> NextBatch() override {
+        if (reader_ == nullptr || next_batch_ >= reader_->num_record_batches()) {
+            return BatchReader::MakeEofBatch();
+        }
+        PAIMON_ASSIGN_OR_RAISE_FROM_ARROW(std::shared_ptr<arrow::RecordBatch> batch,
+                                          reader_->ReadRecordBatch(next_batch_++));
+        PAIMON_ASSIGN_OR_RAISE_FROM_ARROW(std::shared_ptr<arrow::StructArray> array,
+                                          batch->ToStructArray());
+        auto c_array = std::make_unique<::ArrowArray>();
+        auto c_schema = std::make_unique<::ArrowSchema>();
+        PAIMON_RETURN_NOT_OK_FROM_ARROW(arrow::ExportArray(*array, c_array.get(), c_schema.get()));
+        return std::make_pair(std::move(c_array), std::move(c_schema));
+    }
+
+    std::shared_ptr<Metrics> GetReaderMetrics() const override {
+        return metrics_;
+    }
+
+    void Close() override {
+        reader_.reset();
+        if (file_) {
+            [[maybe_unused]] auto status = file_->Close();
+            file_.reset();
+        }
+    }
+
+ private:
+    // must outlive all batches read from the file
+    std::unique_ptr<arrow::MemoryPool> arrow_pool_;
+    std::shared_ptr<arrow::io::ReadableFile> file_;
+    std::shared_ptr<arrow::ipc::RecordBatchFileReader> reader_;
+    std::shared_ptr<Metrics> metrics_;
+    int32_t next_batch_ = 0;
+};
+
+}  // namespace
+
+Result<std::unique_ptr<SpilledSortedRun::Writer>> SpilledSortedRun::Writer::Create(
+    const std::string& path, const std::shared_ptr<arrow::Schema>& write_schema,
+    const std::vector<std::string>& trimmed_primary_keys, const std::string& compression,
+    const std::shared_ptr<MemoryPool>& pool) {
+    // sequence number and value kind, then primary keys and other value fields
+    std::vector<int32_t> column_indices;
+    for (int32_t i = 0; i < SpecialFields::KEY_VALUE_SPECIAL_FIELD_COUNT; ++i) {
+        column_indices.push_back(i);
+    }
+    for (const auto& key : trimmed_primary_keys) {
+        int32_t index = write_schema->GetFieldIndex(key);
+        if (index < SpecialFields::KEY_VALUE_SPECIAL_FIELD_COUNT) {
+            return Status::Invalid(
+                fmt::format("primary key {} not found in write schema of spilled run", key));
+        }
+        column_indices.push_back(index);
+    }
+    for (int32_t i = SpecialFields::KEY_VALUE_SPECIAL_FIELD_COUNT; i < write_schema->num_fields();
+         ++i) {
+        if (std::find(column_indices.begin(), column_indices.end(), i) == column_indices.end()) {
+            column_indices.push_back(i);
+        }
+    }
+    arrow::FieldVector file_fields;
+    file_fields.reserve(column_indices.size());
+    for (int32_t index : column_indices) {
+        file_fields.push_back(write_schema->field(index));
+    }
+
+    auto arrow_pool = GetArrowPool(pool);
+    arrow::ipc::IpcWriteOptions write_options = arrow::ipc::IpcWriteOptions::Defaults();
+    write_options.memory_pool = arrow_pool.get();
+    arrow::Compression::type codec_type = arrow::Compression::UNCOMPRESSED;
+    if (compression == "lz4") {
+        codec_type = arrow::Compression::LZ4_FRAME;
+    } else if (compression == "zstd") {
+        codec_type = arrow::Compression::ZSTD;
+    } else if (compression != "none") {
+        return Status::Invalid(fmt::format("unsupported spill compression {}", compression));
+    }
+    if (codec_type != arrow::Compression::UNCOMPRESSED) {
+        PAIMON_ASSIGN_OR_RAISE_FROM_ARROW(write_options.codec,
+                                          arrow::util::Codec::Create(codec_type));
+    }
+
+    auto file_schema = arrow::schema(file_fields);
+    std::unique_ptr<Writer> writer(new Writer(path, arrow::struct_(write_schema->fields()),
+                                              file_schema, std::move(column_indices),
+                                              std::move(arrow_pool)));
+    PAIMON_ASSIGN_OR_RAISE_FROM_ARROW(writer->out_, arrow::io::FileOutputStream::Open(path));
+    PAIMON_ASSIGN_OR_RAISE_FROM_ARROW(
+        writer->ipc_writer_, arrow::ipc::MakeFileWriter(writer->out_, file_schema, write_options));
+    return writer;
+}
+
+SpilledSortedRun::Writer::Writer(const std::string& path,
+                                 const std::shared_ptr<arrow::DataType>& write_type,
+                                 const std::shared_ptr<arrow::Schema>& file_schema,
+                                 std::vector<int32_t>&& column_indices,
+                                 std::unique_ptr<arrow::MemoryPool>&& arrow_pool)
+    : path_(path),
+      write_type_(write_type),
+      file_schema_(file_schema),
+      column_indices_(std::move(column_indices)),
+      arrow_pool_(std::move(arrow_pool)) {}
+
+SpilledSortedRun::Writer::~Writer() {
+    if (!finished_) {
+        ipc_writer_.reset();
+        if (out_) {
+            [[maybe_unused]] auto status = out_->Close();
+            out_.reset();
+        }
+        std::remove(path_.c_str());
+    }
+}
+
+Status SpilledSortedRun::Writer::Write(KeyValueBatch&& batch) {
+    PAIMON_ASSIGN_OR_RAISE_FROM_ARROW(std::shared_ptr<arrow::Array> array,
+                                      arrow::ImportArray(batch.batch.get(), write_type_));
+    const auto& struct_array = arrow::internal::checked_cast<const arrow::StructArray&>(*array);
+    if (struct_array.length() == 0) {
+        return Status::OK();
+    }
+    arrow::ArrayVector columns;
+    columns.reserve(column_indices_.size());
+    for (int32_t index : column_indices_) {
+        columns.push_back(struct_array.field(index));
+    }
+    auto record_batch =
+        arrow::RecordBatch::Make(file_schema_, struct_array.length(), std::move(columns));
+    PAIMON_RETURN_NOT_OK_FROM_ARROW(ipc_writer_->WriteRecordBatch(*record_batch));
+    row_count_ += struct_array.length();
+    return Status::OK();
+}
+
+Result<std::unique_ptr<SpilledSortedRun>> SpilledSortedRun::Writer::Finish() {
+    PAIMON_RETURN_NOT_OK_FROM_ARROW(ipc_writer_->Close());
+    PAIMON_ASSIGN_OR_RAISE_FROM_ARROW(int64_t file_size, out_->Tell());
+    PAIMON_RETURN_NOT_OK_FROM_ARROW(out_->Close());
+    finished_ = true;
+    return std::unique_ptr<SpilledSortedRun>(new SpilledSortedRun(path_, file_size, row_count_));
+}
+
+SpilledSortedRun::~SpilledSortedRun() {
+    std::remove(path_.c_str());
+}
+
+Result<std::unique_ptr<BatchReader>> SpilledSortedRun::CreateReader(
+    const std::shared_ptr<MemoryPool>& pool) const {
+    auto arrow_pool = GetArrowPool(pool);
+    PAIMON_ASSIGN_OR_RAISE_FROM_ARROW(std::shared_ptr<arrow::io::ReadableFile> file,
+                                      arrow::io::ReadableFile::Open(path_, arrow_pool.get()));
+    arrow::ipc::IpcReadOptions read_options = arrow::ipc::IpcReadOptions::Defaults();
+    read_options.memory_pool = arrow_pool.get();
+    PAIMON_ASSIGN_OR_RAISE_FROM_ARROW(std::shared_ptr<arrow::ipc::RecordBatchFileReader> reader,
+                                      arrow::ipc::RecordBatchFileReader::Open(file, read_options));
+    return std::make_unique<SpilledSortedRunReader>(std::move(arrow_pool), file, reader);
+}
+
+}  // namespace paimon
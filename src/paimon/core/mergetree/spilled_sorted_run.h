@@ -0,0 +1,116 @@
+/*
+ * Copyright 2024-present Alibaba Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "paimon/core/key_value.h"
+#include "paimon/reader/batch_reader.h"
+#include "paimon/result.h"
+#include "paimon/status.h"
+
+namespace arrow {
+class DataType;
+class MemoryPool;
+class Schema;
+namespace io {
+class FileOutputStream;
+}  // namespace io
+namespace ipc {
+class RecordBatchWriter;
+}  // namespace ipc
+}  // namespace arrow
+
+namespace paimon {
+class MemoryPool;
+
+/// A sorted run of a write buffer spilled to a local file in Arrow IPC file format. Spilling lets
+/// a write buffer grow beyond memory, spilled runs are merged into one level 0 file at flush time.
+///
+/// Columns of the file are ordered as (sequence number, value kind, primary keys, other value
+/// fields), which is the layout `KeyValueDataFileRecordReader` expects. The file is deleted when
+/// the run is destroyed.
+class SpilledSortedRun {
+ public:
+    /// Writes merged `KeyValueBatch`es (in write schema) of one sorted run.
+    class Writer {
+     public:
+        /// @param write_schema sequence number, value kind and value fields.
+        /// @param compression "none", "lz4" or "zstd".
+        static Result<std::unique_ptr<Writer>> Create(
+            const std::string& path, const std::shared_ptr<arrow::Schema>& write_schema,
+            const std::vector<std::string>& trimmed_primary_keys, const std::string& compression,
+            const std::shared_ptr<MemoryPool>& pool);
+
+        ~Writer();
+
+        Status Write(KeyValueBatch&& batch);
+
+        /// Closes the file, the writer must not be used afterwards.
+        Result<std::unique_ptr<SpilledSortedRun>> Finish();
+
+     private:
+        Writer(const std::string& path, const std::shared_ptr<arrow::DataType>& write_type,
+               const std::shared_ptr<arrow::Schema>& file_schema,
+               std::vector<int32_t>&& column_indices,
+               std::unique_ptr<arrow::MemoryPool>&& arrow_pool);
+
+        std::string path_;
+        std::shared_ptr<arrow::DataType> write_type_;
+        std::shared_ptr<arrow::Schema> file_schema_;
+        // the index in write schema of each file column
+        std::vector<int32_t> column_indices_;
+        std::unique_ptr<arrow::MemoryPool> arrow_pool_;
+        std::shared_ptr<arrow::io::FileOutputStream> out_;
+        std::shared_ptr<arrow::ipc::RecordBatchWriter> ipc_writer_;
+        int64_t row_count_ = 0;
+        bool finished_ = false;
+    };
+
+    ~SpilledSortedRun();
+
+    SpilledSortedRun(const SpilledSortedRun&) = delete;
+    SpilledSortedRun& operator=(const SpilledSortedRun&) = delete;
+
+    /// Reads the run batch by batch, each batch is exported as a struct array in file column
+    /// order.
+    Result<std::unique_ptr<BatchReader>> CreateReader(
+        const std::shared_ptr<MemoryPool>& pool) const;
+
+    const std::string& Path() const {
+        return path_;
+    }
+    int64_t FileSize() const {
+        return file_size_;
+    }
+    int64_t RowCount() const {
+        return row_count_;
+    }
+
+ private:
+    SpilledSortedRun(const std::string& path, int64_t file_size, int64_t row_count)
+        : path_(path), file_size_(file_size), row_count_(row_count) {}
+
+    std::string path_;
+    int64_t file_size_;
+    int64_t row_count_;
+};
+
+}  // namespace paimon
@@ -0,0 +1,123 @@
+/*
+ * Copyright 2024-present Alibaba Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "paimon/core/mergetree/spilled_sorted_run.h"
+
+#include <filesystem>
+#include <utility>
+
+#include "arrow/api.h"
+#include "arrow/c/abi.h"
+#include "arrow/c/bridge.h"
+#include "arrow/ipc/json_simple.h"
+#include "gtest/gtest.h"
+#include "paimon/common/table/special_fields.h"
+#include "paimon/common/types/data_field.h"
+#include "paimon/memory/memory_pool.h"
+#include "paimon/testing/utils/read_result_collector.h"
+#include "paimon/testing/utils/testharness.h"
+
+namespace paimon::test {
+class SpilledSortedRunTest : public ::testing::TestWithParam<std::string> {
+ public:
+    void SetUp() override {
+        pool_ = GetDefaultPool();
+        std::vector<DataField> write_fields = {SpecialFields::SequenceNumber(),
+                                               SpecialFields::ValueKind(),
+                                               DataField(0, arrow::field("f0", arrow::utf8())),
+                                               DataField(1, arrow::field("f1", arrow::int32()))};
+        write_schema_ = DataField::ConvertDataFieldsToArrowSchema(write_fields);
+    }
+
+    KeyValueBatch MakeBatch(const std::string& json) const {
+        auto array =
+            arrow::ipc::internal::json::ArrayFromJSON(arrow::struct_(write_schema_->fields()), json)
+                .ValueOrDie();
+        KeyValueBatch key_value_batch;
+        key_value_batch.batch = std::make_unique<::ArrowArray>();
+        EXPECT_TRUE(arrow::ExportArray(*array, key_value_batch.batch.get()).ok());
+        return key_value_batch;
+    }
+
+ private:
+    std::shared_ptr<MemoryPool> pool_;
+    std::shared_ptr<arrow::Schema> write_schema_;
+};
+
+TEST_P(SpilledSortedRunTest, TestWriteAndRead) {
+    auto dir = UniqueTestDirectory::Create();
+    ASSERT_TRUE(dir);
+    std::string path = dir->Str() + "/run-0.arrow";
+    // primary key f1 is moved before other value fields
+    ASSERT_OK_AND_ASSIGN(std::unique_ptr<SpilledSortedRun::Writer> writer,
+                         SpilledSortedRun::Writer::Create(path, write_schema_, {"f1"}, GetParam(),
+                                                          pool_));
+    ASSERT_OK(writer->Write(MakeBatch(R"([[3, 0, "Alice", 1], [1, 0, "Bob", 2]])")));
+    ASSERT_OK(writer->Write(MakeBatch(R"([])")));
+    ASSERT_OK(writer->Write(MakeBatch(R"([[2, 3, "Lucy", 5]])")));
+    ASSERT_OK_AND_ASSIGN(std::unique_ptr<SpilledSortedRun> run, writer->Finish());
+    writer.reset();
+    ASSERT_TRUE(std::filesystem::exists(path));
+    ASSERT_EQ(path, run->Path());
+    ASSERT_EQ(3, run->RowCount());
+    ASSERT_EQ(std::filesystem::file_size(path), run->FileSize());
+
+    ASSERT_OK_AND_ASSIGN(std::unique_ptr<BatchReader> reader, run->CreateReader(pool_));
+    ASSERT_OK_AND_ASSIGN(std::shared_ptr<arrow::ChunkedArray> result,
+                         ReadResultCollector::CollectResult(reader.get()));
+    reader->Close();
+    auto file_type = arrow::struct_({write_schema_->field(0), write_schema_->field(1),
+                                     write_schema_->field(3), write_schema_->field(2)});
+    std::shared_ptr<arrow::ChunkedArray> expected;
+    ASSERT_TRUE(arrow::ipc::internal::json::ChunkedArrayFromJSON(
+                    file_type, {R"([[3, 0, 1, "Alice"], [1, 0, 2, "Bob"], [2, 3, 5, "Lucy"]])"},
+                    &expected)
+                    .ok());
+    ASSERT_TRUE(expected->Equals(result)) << result->ToString();
+
+    run.reset();
+    ASSERT_FALSE(std::filesystem::exists(path));
+}
+
+TEST_P(SpilledSortedRunTest, TestAbandonedWriterRemovesFile) {
+    auto dir = UniqueTestDirectory::Create();
+    ASSERT_TRUE(dir);
+    std::string path = dir->Str() + "/run-0.arrow";
+    ASSERT_OK_AND_ASSIGN(std::unique_ptr<SpilledSortedRun::Writer> writer,
+                         SpilledSortedRun::Writer::Create(path, write_schema_, {"f0"}, GetParam(),
+                                                          pool_));
+    ASSERT_OK(writer->Write(MakeBatch(R"([[0, 0, "Alice", 1]])")));
+    ASSERT_TRUE(std::filesystem::exists(path));
+    writer.reset();
+    ASSERT_FALSE(std::filesystem::exists(path));
+}
+
+TEST_P(SpilledSortedRunTest, TestInvalidArguments) {
+    auto dir = UniqueTestDirectory::Create();
+    ASSERT_TRUE(dir);
+    std::string path = dir->Str() + "/run-0.arrow";
+    ASSERT_NOK_WITH_MSG(
+        SpilledSortedRun::Writer::Create(path, write_schema_, {"f0"}, "snappy", pool_),
+        "unsupported spill compression snappy");
+    ASSERT_NOK_WITH_MSG(
+        SpilledSortedRun::Writer::Create(path, write_schema_, {"f2"}, GetParam(), pool_),
+        "primary key f2 not found in write schema of spilled run");
+}
+
+INSTANTIATE_TEST_SUITE_P(Compression, SpilledSortedRunTest,
+                         ::testing::Values("none", "lz4", "zstd"));
+
+}  // namespace paimon::test
@@ -34,6 +34,7 @@
 #include "paimon/core/utils/commit_increment.h"
 #include "paimon/core/utils/file_store_path_factory.h"
 #include "paimon/core/utils/snapshot_manager.h"
+#include "paimon/core/utils/write_memory_manager.h"
 #include "paimon/macros.h"
 #include "paimon/record_batch.h"
 #include "paimon/scan_context.h"
@@ -72,7 +73,12 @@ AbstractFileStoreWrite::AbstractFileStoreWrite(
       is_streaming_mode_(is_streaming_mode),
       ignore_num_bucket_check_(ignore_num_bucket_check),
       metrics_(std::make_shared<MetricsImpl>()),
-      logger_(Logger::GetLogger("AbstractFileStoreWrite")) {}
+      logger_(Logger::GetLogger("AbstractFileStoreWrite")) {
+    if (options_.GetWriteBufferTotalSize() > 0) {
+        write_memory_manager_ =
+            std::make_shared<WriteMemoryManager>(options_.GetWriteBufferTotalSize());
+    }
+}
 
 Status AbstractFileStoreWrite::Write(std::unique_ptr<RecordBatch>&& batch) {
     if (PAIMON_UNLIKELY(batch == nullptr)) {
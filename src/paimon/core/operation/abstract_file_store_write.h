@@ -57,6 +57,7 @@ class BinaryRow;
 class Executor;
 class MemoryPool;
 class RecordBatch;
+class WriteMemoryManager;
 
 class AbstractFileStoreWrite : public FileStoreWrite {
  public:
@@ -122,6 +123,8 @@ class AbstractFileStoreWrite : public FileStoreWrite {
     std::shared_ptr<TableSchema> table_schema_;
     std::shared_ptr<arrow::Schema> partition_schema_;
     CoreOptions options_;
+    // shared by the write buffers of all writers, nullptr if write-buffer-total-size is not set
+    std::shared_ptr<WriteMemoryManager> write_memory_manager_;
 
  private:
     Result<std::shared_ptr<BatchWriter>> GetWriter(const BinaryRow& partition, int32_t bucket);
@@ -21,7 +21,9 @@
 #include <utility>
 
 #include "arrow/type.h"
+#include "paimon/common/reader/concat_batch_reader.h"
 #include "paimon/common/reader/delegating_prefetch_reader.h"
+#include "paimon/common/reader/lookahead_concat_batch_reader.h"
 #include "paimon/common/reader/predicate_batch_reader.h"
 #include "paimon/common/reader/prefetch_file_batch_reader_impl.h"
 #include "paimon/common/table/special_fields.h"
@@ -64,8 +66,7 @@ AbstractSplitRead::AbstractSplitRead(const std::shared_ptr<FileStorePathFactory>
 Result<std::vector<std::unique_ptr<BatchReader>>> AbstractSplitRead::CreateRawFileReaders(
     const BinaryRow& partition, const std::vector<std::shared_ptr<DataFileMeta>>& data_files,
     const std::shared_ptr<arrow::Schema>& read_schema, const std::shared_ptr<Predicate>& predicate,
-    const std::unordered_map<std::string, DeletionFile>& deletion_file_map,
-    const std::optional<std::vector<Range>>& row_ranges,
+    const DeletionVectorMap& deletion_vectors, const std::optional<std::vector<Range>>& row_ranges,
     const std::shared_ptr<DataFilePathFactory>& data_file_path_factory) const {
     if (data_files.empty()) {
         return std::vector<std::unique_ptr<BatchReader>>();
@@ -77,15 +78,10 @@ Result<std::vector<std::unique_ptr<BatchReader>>> AbstractSplitRead::CreateRawFi
     std::vector<std::unique_ptr<BatchReader>> raw_file_readers;
     raw_file_readers.reserve(data_files.size());
     for (const auto& file : data_files) {
-        auto data_file_path = data_file_path_factory->ToPath(file);
-        PAIMON_ASSIGN_OR_RAISE(std::string data_file_identifier, file->FileFormat());
-        PAIMON_ASSIGN_OR_RAISE(std::unique_ptr<ReaderBuilder> reader_builder,
-                               PrepareReaderBuilder(data_file_identifier));
         PAIMON_ASSIGN_OR_RAISE(
             std::unique_ptr<BatchReader> file_reader,
-            CreateFieldMappingReader(data_file_path, file, partition, reader_builder.get(),
-                                     field_mapping_builder.get(), deletion_file_map, row_ranges,
-                                     data_file_path_factory));
+            CreateRawFileReader(partition, file, field_mapping_builder.get(), deletion_vectors,
+                                row_ranges, data_file_path_factory));
         if (file_reader) {
             raw_file_readers.push_back(std::move(file_reader));
         }
@@ -93,6 +89,57 @@ Result<std::vector<std::unique_ptr<BatchReader>>> AbstractSplitRead::CreateRawFi
     return std::move(raw_file_readers);
 }
 
+Result<std::unique_ptr<BatchReader>> AbstractSplitRead::CreateConcatRawFileReader(
+    const BinaryRow& partition, const std::vector<std::shared_ptr<DataFileMeta>>& data_files,
+    const std::shared_ptr<arrow::Schema>& read_schema, const std::shared_ptr<Predicate>& predicate,
+    const DeletionVectorMap& deletion_vectors, const std::optional<std::vector<Range>>& row_ranges,
+    const std::shared_ptr<DataFilePathFactory>& data_file_path_factory) const {
+    std::shared_ptr<const AbstractSplitRead> self = weak_from_this().lock();
+    // prefetch readers wait for tasks of the same executor, opening them on the executor may
+    // deadlock when all threads are waiting
+    bool lookahead = options_.GetReadFileLookahead() > 0 && data_files.size() > 1 && self &&
+                     executor_ != nullptr && !context_->EnablePrefetch();
+    if (!lookahead) {
+        PAIMON_ASSIGN_OR_RAISE(
+            std::vector<std::unique_ptr<BatchReader>> raw_file_readers,
+            CreateRawFileReaders(partition, data_files, read_schema, predicate, deletion_vectors,
+                                 row_ranges, data_file_path_factory));
+        return std::make_unique<ConcatBatchReader>(std::move(raw_file_readers), pool_);
+    }
+    PAIMON_ASSIGN_OR_RAISE(
+        std::shared_ptr<FieldMappingBuilder> field_mapping_builder,
+        FieldMappingBuilder::Create(read_schema, context_->GetPartitionKeys(), predicate));
+    auto shared_deletion_vectors = std::make_shared<const DeletionVectorMap>(deletion_vectors);
+    std::vector<LookaheadConcatBatchReader::DeferredReader> deferred_readers;
+    deferred_readers.reserve(data_files.size());
+    for (const auto& file : data_files) {
+        auto supplier = [self, partition, file, field_mapping_builder, shared_deletion_vectors,
+                         row_ranges, data_file_path_factory]() {
+            return self->CreateRawFileReader(partition, file, field_mapping_builder.get(),
+                                             *shared_deletion_vectors, row_ranges,
+                                             data_file_path_factory);
+        };
+        deferred_readers.push_back({std::move(supplier), file->file_size});
+    }
+    return std::make_unique<LookaheadConcatBatchReader>(
+        std::move(deferred_readers), options_.GetReadFileLookahead(),
+        options_.GetReadFileLookaheadMemoryBudget(), executor_, pool_);
+}
+
+Result<std::unique_ptr<BatchReader>> AbstractSplitRead::CreateRawFileReader(
+    const BinaryRow& partition, const std::shared_ptr<DataFileMeta>& file,
+    const FieldMappingBuilder* field_mapping_builder, const DeletionVectorMap& deletion_vectors,
+    const std::optional<std::vector<Range>>& row_ranges,
+    const std::shared_ptr<DataFilePathFactory>& data_file_path_factory) const {
+    auto data_file_path = data_file_path_factory->ToPath(file);
+    PAIMON_ASSIGN_OR_RAISE(std::string data_file_identifier, file->FileFormat());
+    PAIMON_ASSIGN_OR_RAISE(std::unique_ptr<ReaderBuilder> reader_builder,
+                           PrepareReaderBuilder(data_file_identifier));
+    return CreateFieldMappingReader(data_file_path, file, partition, reader_builder.get(),
+                                    field_mapping_builder, deletion_vectors, row_ranges,
+                                    data_file_path_factory);
+}
+
 bool AbstractSplitRead::NeedCompleteRowTrackingFields(
     bool row_tracking_enabled, const std::shared_ptr<arrow::Schema>& read_schema) {
     if (row_tracking_enabled &&
@@ -121,6 +168,20 @@ std::unordered_map<std::string, DeletionFile> AbstractSplitRead::CreateDeletionF
     return deletion_file_map;
 }
 
+Result<DeletionVectorMap> AbstractSplitRead::LoadDeletionVectors(
+    const DataSplitImpl& data_split) const {
+    std::unordered_map<std::string, DeletionFile> deletion_file_map =
+        CreateDeletionFileMap(data_split);
+    if (deletion_file_map.empty()) {
+        return DeletionVectorMap();
+    }
+    DeletionVectorLoader loader(
+        options_.GetFileSystem(),
+        DeletionVectorLoader::GetGlobalCache(options_.GetDeletionVectorsCacheMaxMemorySize()),
+        pool_);
+    return loader.Load(deletion_file_map);
+}
+
 Result<std::unique_ptr<BatchReader>> AbstractSplitRead::ApplyPredicateFilterIfNeeded(
     std::unique_ptr<BatchReader>&& reader, const std::shared_ptr<Predicate>& predicate) const {
     if (!context_->EnablePredicateFilter()) {
@@ -168,8 +229,7 @@ Result<std::unique_ptr<FileBatchReader>> AbstractSplitRead::CreateFileBatchReade
 Result<std::unique_ptr<BatchReader>> AbstractSplitRead::CreateFieldMappingReader(
     const std::string& data_file_path, const std::shared_ptr<DataFileMeta>& file_meta,
     const BinaryRow& partition, const ReaderBuilder* reader_builder,
-    const FieldMappingBuilder* field_mapping_builder,
-    const std::unordered_map<std::string, DeletionFile>& deletion_file_map,
+    const FieldMappingBuilder* field_mapping_builder, const DeletionVectorMap& deletion_vectors,
     const std::optional<std::vector<Range>>& row_ranges,
     const std::shared_ptr<DataFilePathFactory>& data_file_path_factory) const {
     std::shared_ptr<TableSchema> data_schema;
@@ -211,7 +271,7 @@ Result<std::unique_ptr<BatchReader>> AbstractSplitRead::CreateFieldMappingReader
     PAIMON_ASSIGN_OR_RAISE(std::unique_ptr<BatchReader> final_reader,
                            ApplyIndexAndDvReaderIfNeeded(
                                std::move(file_reader), file_meta, all_data_schema, read_schema,
-                               predicate, deletion_file_map, row_ranges, data_file_path_factory));
+                               predicate, deletion_vectors, row_ranges, data_file_path_factory));
     if (!final_reader) {
         // file is skipped by index or dv
         return std::unique_ptr<BatchReader>();
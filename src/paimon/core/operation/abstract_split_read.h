@@ -24,6 +24,7 @@
 
 #include "arrow/type_fwd.h"
 #include "paimon/core/core_options.h"
+#include "paimon/core/deletionvectors/deletion_vector_loader.h"
 #include "paimon/core/io/field_mapping_reader.h"
 #include "paimon/core/operation/internal_read_context.h"
 #include "paimon/core/operation/split_read.h"
@@ -55,7 +56,8 @@ class Predicate;
 struct DataFileMeta;
 class TableSchema;
 
-class AbstractSplitRead : public SplitRead {
+class AbstractSplitRead : public SplitRead,
+                          public std::enable_shared_from_this<AbstractSplitRead> {
  public:
     ~AbstractSplitRead() override = default;
 
@@ -69,14 +71,28 @@ class AbstractSplitRead : public SplitRead {
     Result<std::vector<std::unique_ptr<BatchReader>>> CreateRawFileReaders(
         const BinaryRow& partition, const std::vector<std::shared_ptr<DataFileMeta>>& data_files,
         const std::shared_ptr<arrow::Schema>& read_schema,
-        const std::shared_ptr<Predicate>& predicate,
-        const std::unordered_map<std::string, DeletionFile>& deletion_file_map,
+        const std::shared_ptr<Predicate>& predicate, const DeletionVectorMap& deletion_vectors,
+        const std::optional<std::vector<Range>>& row_ranges,
+        const std::shared_ptr<DataFilePathFactory>& data_file_path_factory) const;
+
+    /// Concatenates the readers of `data_files`. If "read.file-lookahead" is enabled, files are
+    /// opened lazily, the next files being opened on the executor while the current one is read.
+    /// Lookahead readers keep this split read alive, so it is only used when this split read is
+    /// owned by a shared_ptr.
+    Result<std::unique_ptr<BatchReader>> CreateConcatRawFileReader(
+        const BinaryRow& partition, const std::vector<std::shared_ptr<DataFileMeta>>& data_files,
+        const std::shared_ptr<arrow::Schema>& read_schema,
+        const std::shared_ptr<Predicate>& predicate, const DeletionVectorMap& deletion_vectors,
         const std::optional<std::vector<Range>>& row_ranges,
         const std::shared_ptr<DataFilePathFactory>& data_file_path_factory) const;
 
     static std::unordered_map<std::string, DeletionFile> CreateDeletionFileMap(
         const DataSplitImpl& data_split);
 
+    /// Loads the deletion vectors of `data_split` keyed by data file name, through the shared
+    /// cache if "deletion-vectors.cache.max-memory-size" is set.
+    Result<DeletionVectorMap> LoadDeletionVectors(const DataSplitImpl& data_split) const;
+
     Result<std::unique_ptr<BatchReader>> ApplyPredicateFilterIfNeeded(
         std::unique_ptr<BatchReader>&& reader, const std::shared_ptr<Predicate>& predicate) const;
 
@@ -86,8 +102,7 @@ class AbstractSplitRead : public SplitRead {
         std::unique_ptr<FileBatchReader>&& file_reader, const std::shared_ptr<DataFileMeta>& file,
         const std::shared_ptr<arrow::Schema>& data_schema,
         const std::shared_ptr<arrow::Schema>& read_schema,
-        const std::shared_ptr<Predicate>& predicate,
-        const std::unordered_map<std::string, DeletionFile>& deletion_file_map,
+        const std::shared_ptr<Predicate>& predicate, const DeletionVectorMap& deletion_vectors,
         const std::optional<std::vector<Range>>& row_ranges,
         const std::shared_ptr<DataFilePathFactory>& data_file_path_factory) const = 0;
 
@@ -102,6 +117,13 @@ class AbstractSplitRead : public SplitRead {
     Result<std::unique_ptr<ReaderBuilder>> PrepareReaderBuilder(
         const std::string& format_identifier) const;
 
+    // return nullptr if data file is skipped by index or dv
+    Result<std::unique_ptr<BatchReader>> CreateRawFileReader(
+        const BinaryRow& partition, const std::shared_ptr<DataFileMeta>& file,
+        const FieldMappingBuilder* field_mapping_builder, const DeletionVectorMap& deletion_vectors,
+        const std::optional<std::vector<Range>>& row_ranges,
+        const std::shared_ptr<DataFilePathFactory>& data_file_path_factory) const;
+
     Result<std::unique_ptr<FileBatchReader>> CreateFileBatchReader(
         const std::shared_ptr<DataFileMeta>& file_meta, const std::string& data_file_path,
         const ReaderBuilder* reader_builder) const;
@@ -110,8 +132,7 @@ class AbstractSplitRead : public SplitRead {
     Result<std::unique_ptr<BatchReader>> CreateFieldMappingReader(
         const std::string& data_file_path, const std::shared_ptr<DataFileMeta>& file_meta,
         const BinaryRow& partition, const ReaderBuilder* reader_builder,
-        const FieldMappingBuilder* field_mapping_builder,
-        const std::unordered_map<std::string, DeletionFile>& deletion_file_map,
+        const FieldMappingBuilder* field_mapping_builder, const DeletionVectorMap& deletion_vectors,
         const std::optional<std::vector<Range>>& row_ranges,
         const std::shared_ptr<DataFilePathFactory>& data_file_path_factory) const;
 
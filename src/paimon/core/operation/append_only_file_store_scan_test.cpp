@@ -18,16 +18,21 @@
 
 #include <algorithm>
 #include <cstdint>
+#include <optional>
 #include <string>
 #include <utility>
 #include <vector>
 
+#include "arrow/array/array_nested.h"
 #include "gtest/gtest.h"
 #include "paimon/common/data/binary_row.h"
 #include "paimon/common/data/binary_row_writer.h"
+#include "paimon/core/manifest/manifest_file.h"
+#include "paimon/core/manifest/manifest_file_meta.h"
 #include "paimon/core/manifest/partition_entry.h"
 #include "paimon/core/schema/schema_manager.h"
 #include "paimon/core/schema/table_schema.h"
+#include "paimon/core/snapshot.h"
 #include "paimon/core/stats/simple_stats_evolution.h"
 #include "paimon/core/table/source/abstract_table_scan.h"
 #include "paimon/core/table/source/snapshot/snapshot_reader.h"
@@ -126,4 +131,60 @@ TEST(AppendOnlyFileStoreScanTest, TestReadPartitionEntries) {
 
     ASSERT_EQ(result_partition_entries, expected_partition_entries);
 }
+
+TEST(AppendOnlyFileStoreScanTest, TestPlanWithPartitionFilter) {
+    std::string table_path = paimon::test::GetDataDir() + "/orc/append_09.db/append_09/";
+    ScanContextBuilder context_builder(table_path);
+    context_builder.AddOption(Options::FILE_FORMAT, "orc")
+        .AddOption(Options::MANIFEST_FORMAT, "orc")
+        .AddOption(Options::SCAN_SNAPSHOT_ID, "5")
+        .SetPartitionFilter({{{"f1", "10"}}});
+    ASSERT_OK_AND_ASSIGN(auto scan_context, context_builder.Finish());
+    ASSERT_OK_AND_ASSIGN(auto table_scan, TableScan::Create(std::move(scan_context)));
+    auto typed_table_scan = dynamic_cast<AbstractTableScan*>(table_scan.get());
+    ASSERT_TRUE(typed_table_scan);
+    auto file_store_scan = typed_table_scan->snapshot_reader_->scan_;
+    ASSERT_TRUE(file_store_scan);
+
+    // entries of other partitions are rejected on the decoded batch of the manifest, the per-entry
+    // filter only applies to cached manifests
+    std::optional<Snapshot> snapshot;
+    std::vector<ManifestFileMeta> manifests;
+    ASSERT_OK(file_store_scan->ReadManifests(&snapshot, &manifests));
+    ASSERT_FALSE(manifests.empty());
+    int64_t batch_rows = 0;
+    int64_t selected_rows = 0;
+    auto batch_filter = [&](const arrow::StructArray& batch) -> Result<std::vector<char>> {
+        PAIMON_ASSIGN_OR_RAISE(std::vector<char> selected,
+                               file_store_scan->FilterManifestEntryBatch(batch));
+        batch_rows += batch.length();
+        selected_rows += std::count(selected.begin(), selected.end(), 1);
+        return selected;
+    };
+    int64_t entry_filter_calls = 0;
+    auto filter = [&](const ManifestEntry&) -> Result<bool> {
+        ++entry_filter_calls;
+        return true;
+    };
+    std::vector<ManifestEntry> selected_entries;
+    for (const auto& manifest : manifests) {
+        ASSERT_OK(file_store_scan->manifest_file_->Read(manifest.FileName(), batch_filter, filter,
+                                                        &selected_entries));
+    }
+    ASSERT_EQ(0, entry_filter_calls);
+    ASSERT_GT(batch_rows, selected_rows);
+    ASSERT_EQ(selected_rows, static_cast<int64_t>(selected_entries.size()));
+    for (const auto& entry : selected_entries) {
+        ASSERT_EQ(10, entry.Partition().GetInt(0));
+    }
+
+    ASSERT_OK_AND_ASSIGN(std::shared_ptr<FileStoreScan::RawPlan> plan,
+                         file_store_scan->CreatePlan());
+    std::vector<ManifestEntry> entries = plan->Files();
+    ASSERT_EQ(2, entries.size());
+    for (const auto& entry : entries) {
+        ASSERT_EQ(10, entry.Partition().GetInt(0));
+    }
+}
+
 }  // namespace paimon::test
@@ -19,18 +19,25 @@
 #include <vector>
 
 #include "paimon/common/data/binary_row.h"
+#include "paimon/common/data/blob_utils.h"
+#include "paimon/core/append/append_compact_rewriter.h"
 #include "paimon/core/append/append_only_writer.h"
+#include "paimon/core/append/bucketed_append_compact_manager.h"
+#include "paimon/core/compact/compact_task_limiter.h"
 #include "paimon/core/core_options.h"
 #include "paimon/core/io/data_file_meta.h"
 #include "paimon/core/manifest/manifest_file.h"
 #include "paimon/core/manifest/manifest_list.h"
 #include "paimon/core/operation/append_only_file_store_scan.h"
 #include "paimon/core/operation/file_store_scan.h"
+#include "paimon/core/operation/internal_read_context.h"
+#include "paimon/core/operation/raw_file_split_read.h"
 #include "paimon/core/schema/table_schema.h"
 #include "paimon/core/snapshot.h"
 #include "paimon/core/utils/file_store_path_factory.h"
 #include "paimon/core/utils/snapshot_manager.h"
 #include "paimon/logging.h"
+#include "paimon/read_context.h"
 #include "paimon/result.h"
 
 namespace arrow {
@@ -57,6 +64,8 @@ AppendOnlyFileStoreWrite::AppendOnlyFileStoreWrite(
                              root_path, table_schema, schema, write_schema, partition_schema,
                              options, ignore_previous_files, is_streaming_mode,
                              ignore_num_bucket_check, executor, pool),
+      compact_task_limiter_(
+          std::make_shared<CompactTaskLimiter>(options.GetCompactionMaxConcurrentTasks())),
       logger_(Logger::GetLogger("AppendOnlyFileStoreWrite")) {
     write_cols_ = write_schema->field_names();
     // optimize write_cols to null in following cases:
@@ -106,10 +115,60 @@ Result<std::pair<int32_t, std::shared_ptr<BatchWriter>>> AppendOnlyFileStoreWrit
     PAIMON_ASSIGN_OR_RAISE(std::shared_ptr<DataFilePathFactory> data_file_path_factory,
                            file_store_path_factory_->CreateDataFilePathFactory(partition, bucket));
 
+    std::shared_ptr<CompactManager> compact_manager;
+    if (NeedCompaction()) {
+        PAIMON_ASSIGN_OR_RAISE(compact_manager, CreateCompactManager(partition, restore_files,
+                                                                     data_file_path_factory));
+    }
     auto writer = std::make_shared<AppendOnlyWriter>(options_, table_schema_->Id(), write_schema_,
                                                      write_cols_, max_sequence_number,
-                                                     data_file_path_factory, pool_);
+                                                     data_file_path_factory, pool_,
+                                                     compact_manager);
     return std::pair<int32_t, std::shared_ptr<BatchWriter>>(total_buckets, writer);
 }
 
+bool AppendOnlyFileStoreWrite::NeedCompaction() const {
+    // bucket-unaware tables, deletion vectors, row tracking and blob files are not compacted yet
+    if (options_.WriteOnly() || options_.GetBucket() <= 0 || options_.DeletionVectorsEnabled() ||
+        options_.RowTrackingEnabled() || options_.DataEvolutionEnabled() || write_cols_) {
+        return false;
+    }
+    for (const auto& field : schema_->fields()) {
+        if (BlobUtils::IsBlobField(field)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+Result<std::shared_ptr<CompactManager>> AppendOnlyFileStoreWrite::CreateCompactManager(
+    const BinaryRow& partition, const std::vector<std::shared_ptr<DataFileMeta>>& restore_files,
+    const std::shared_ptr<DataFilePathFactory>& data_file_path_factory) const {
+    // compaction runs on the executor, prefetch (which also submits to the executor) is disabled
+    ReadContextBuilder read_context_builder(root_path_);
+    read_context_builder.SetOptions(options_.ToMap())
+        .EnablePrefetch(false)
+        .WithMemoryPool(pool_)
+        .WithExecutor(executor_)
+        .WithFileSystem(options_.GetFileSystem());
+    PAIMON_ASSIGN_OR_RAISE(std::shared_ptr<ReadContext> read_context,
+                           read_context_builder.Finish());
+    PAIMON_ASSIGN_OR_RAISE(
+        std::shared_ptr<InternalReadContext> internal_read_context,
+        InternalReadContext::Create(read_context, table_schema_, options_.ToMap()));
+    auto raw_read = std::make_unique<RawFileSplitRead>(file_store_path_factory_,
+                                                       internal_read_context, pool_, executor_);
+    auto rewriter = std::make_shared<AppendCompactRewriter>(partition, table_schema_->Id(), schema_,
+                                                            data_file_path_factory,
+                                                            std::move(raw_read), options_, pool_);
+    return std::make_shared<BucketedAppendCompactManager>(
+        executor_, restore_files, options_.GetCompactionMinFileNum(),
+        options_.GetCompactionMaxFileNum(), options_.GetTargetFileSize(),
+        options_.GetCompactionFileSize(),
+        [rewriter](const std::vector<std::shared_ptr<DataFileMeta>>& files) {
+            return rewriter->Rewrite(files);
+        },
+        compact_task_limiter_);
+}
+
 }  // namespace paimon
@@ -44,6 +44,9 @@ class Schema;
 namespace paimon {
 
 class BatchWriter;
+class CompactManager;
+class CompactTaskLimiter;
+class DataFilePathFactory;
 class FileStorePathFactory;
 class FileStoreScan;
 class SnapshotManager;
@@ -56,6 +59,7 @@ class Logger;
 class MemoryPool;
 class SchemaManager;
 class TableSchema;
+struct DataFileMeta;
 
 class AppendOnlyFileStoreWrite : public AbstractFileStoreWrite {
  public:
@@ -80,8 +84,16 @@ class AppendOnlyFileStoreWrite : public AbstractFileStoreWrite {
     Result<std::unique_ptr<FileStoreScan>> CreateFileStoreScan(
         const std::shared_ptr<ScanFilter>& filter) const override;
 
+    bool NeedCompaction() const;
+
+    Result<std::shared_ptr<CompactManager>> CreateCompactManager(
+        const BinaryRow& partition, const std::vector<std::shared_ptr<DataFileMeta>>& restore_files,
+        const std::shared_ptr<DataFilePathFactory>& data_file_path_factory) const;
+
  private:
     std::optional<std::vector<std::string>> write_cols_;
+    // caps concurrent compactions of all buckets
+    std::shared_ptr<CompactTaskLimiter> compact_task_limiter_;
     std::unique_ptr<Logger> logger_;
 };
 
@@ -24,6 +24,7 @@
 #include <vector>
 
 #include "paimon/common/reader/data_evolution_file_reader.h"
+#include "paimon/core/deletionvectors/deletion_vector_loader.h"
 #include "paimon/core/io/data_file_meta.h"
 #include "paimon/core/operation/abstract_split_read.h"
 #include "paimon/read_context.h"
@@ -45,7 +46,6 @@ class InternalReadContext;
 class MemoryPool;
 class Predicate;
 class BinaryRow;
-struct DeletionFile;
 
 /// If the class name below is enclosed in parentheses, it might be present in the read path;
 /// otherwise, it must be present in the read path.
@@ -75,8 +75,7 @@ class DataEvolutionSplitRead : public AbstractSplitRead {
         std::unique_ptr<FileBatchReader>&& file_reader, const std::shared_ptr<DataFileMeta>& file,
         const std::shared_ptr<arrow::Schema>& data_schema,
         const std::shared_ptr<arrow::Schema>& read_schema,
-        const std::shared_ptr<Predicate>& predicate,
-        const std::unordered_map<std::string, DeletionFile>& deletion_file_map,
+        const std::shared_ptr<Predicate>& predicate, const DeletionVectorMap& deletion_vectors,
         const std::optional<std::vector<Range>>& row_ranges,
         const std::shared_ptr<DataFilePathFactory>& data_file_path_factory) const override;
 
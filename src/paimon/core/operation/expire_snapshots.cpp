@@ -240,7 +240,7 @@ bool ExpireSnapshots::TryDeleteEmptyDirectory(const std::string& path) const {
 Status ExpireSnapshots::CleanUnusedManifests(const std::string& manifest_list_name,
                                              const std::set<std::string>& skipping_sets) {
     std::vector<ManifestFileMeta> manifest_file_metas;
-    auto status = manifest_list_->Read(manifest_list_name, nullptr, &manifest_file_metas);
+    auto status = manifest_list_->ReadWithoutStats(manifest_list_name, &manifest_file_metas);
     if (status.ok()) {
         std::vector<std::string> to_delete_manifests;
         // TODO(jinli.zjw): optimize for async
@@ -258,13 +258,14 @@ Status ExpireSnapshots::CleanUnusedManifests(const std::string& manifest_list_na
 
 Status ExpireSnapshots::CleanUnusedDataFiles(const std::string& manifest_list_name) {
     std::vector<ManifestFileMeta> manifest_file_metas;
-    auto status = manifest_list_->Read(manifest_list_name, nullptr, &manifest_file_metas);
+    auto status = manifest_list_->ReadWithoutStats(manifest_list_name, &manifest_file_metas);
     if (status.ok()) {
         std::map<std::string, ManifestEntry> data_files_to_delete;
         for (const auto& manifest_file_meta : manifest_file_metas) {
             std::vector<ManifestEntry> manifest_entries;
-            auto status =
-                manifest_file_->Read(manifest_file_meta.FileName(), nullptr, &manifest_entries);
+            // only the files of the entries are deleted, their stats are not needed
+            auto status = manifest_file_->ReadWithoutStats(manifest_file_meta.FileName(), nullptr,
+                                                           &manifest_entries);
             if (!status.ok()) {
                 // cancel deletion if any exception occurs
                 PAIMON_LOG_WARN(logger_, "Failed to read some manifest files. Cancel deletion. %s",
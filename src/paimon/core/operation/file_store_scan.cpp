@@ -17,11 +17,16 @@
 #include "paimon/core/operation/file_store_scan.h"
 
 #include <cstddef>
+#include <cstring>
 #include <future>
 #include <list>
+#include <string_view>
 #include <unordered_map>
 #include <unordered_set>
 
+#include "arrow/array/array_binary.h"
+#include "arrow/array/array_nested.h"
+#include "arrow/array/array_primitive.h"
 #include "arrow/type.h"
 #include "fmt/format.h"
 #include "paimon/common/data/binary_array.h"
@@ -29,6 +34,7 @@
 #include "paimon/common/predicate/literal_converter.h"
 #include "paimon/common/types/data_field.h"
 #include "paimon/common/utils/field_type_utils.h"
+#include "paimon/common/utils/serialization_utils.h"
 #include "paimon/core/io/data_file_meta.h"
 #include "paimon/core/manifest/file_entry.h"
 #include "paimon/core/manifest/file_kind.h"
@@ -247,6 +253,7 @@ Result<bool> FileStoreScan::FilterManifestFileMeta(const ManifestFileMeta& manif
 
 Status FileStoreScan::ReadManifestFileMeta(const ManifestFileMeta& manifest,
                                            std::vector<ManifestEntry>* entries) const {
+    // same selection as `batch_filter`, only applied to cached entries of the manifest
     auto filter = [&](const ManifestEntry& entry) -> Result<bool> {
         if (partition_filter_) {
             PAIMON_ASSIGN_OR_RAISE(bool res,
@@ -266,8 +273,12 @@ Status FileStoreScan::ReadManifestFileMeta(const ManifestFileMeta& manifest,
         }
         return true;
     };
+    auto batch_filter = [this](const arrow::StructArray& batch) -> Result<std::vector<char>> {
+        return FilterManifestEntryBatch(batch);
+    };
     std::vector<ManifestEntry> unfiltered_entries;
-    PAIMON_RETURN_NOT_OK(manifest_file_->Read(manifest.FileName(), filter, &unfiltered_entries));
+    PAIMON_RETURN_NOT_OK(
+        manifest_file_->Read(manifest.FileName(), batch_filter, filter, &unfiltered_entries));
     entries->reserve(entries->size() + unfiltered_entries.size());
     for (auto& entry : unfiltered_entries) {
         PAIMON_ASSIGN_OR_RAISE(bool res, FilterByStats(entry));
@@ -278,6 +289,55 @@ Status FileStoreScan::ReadManifestFileMeta(const ManifestFileMeta& manifest,
     return Status::OK();
 }
 
+Result<std::vector<char>> FileStoreScan::FilterManifestEntryBatch(
+    const arrow::StructArray& batch) const {
+    std::vector<char> selected(batch.length(), 1);
+    if (!partition_filter_ && !only_read_real_buckets_ && bucket_filter_ == std::nullopt &&
+        level_filter_ == nullptr) {
+        return selected;
+    }
+    auto partition_array =
+        std::dynamic_pointer_cast<arrow::BinaryArray>(batch.GetFieldByName("_PARTITION"));
+    auto bucket_array =
+        std::dynamic_pointer_cast<arrow::Int32Array>(batch.GetFieldByName("_BUCKET"));
+    auto file_array = std::dynamic_pointer_cast<arrow::StructArray>(batch.GetFieldByName("_FILE"));
+    auto level_array = file_array ? std::dynamic_pointer_cast<arrow::Int32Array>(
+                                        file_array->GetFieldByName("_LEVEL"))
+                                  : nullptr;
+    if (!partition_array || !bucket_array || !level_array) {
+        return Status::Invalid(
+            fmt::format("unexpected manifest entry batch type {}", batch.type()->ToString()));
+    }
+    // entries of one partition are usually adjacent, only test the partition when it changes
+    std::optional<std::string_view> last_partition;
+    bool last_partition_selected = true;
+    for (int64_t i = 0; i < batch.length(); ++i) {
+        int32_t bucket = bucket_array->Value(i);
+        if ((only_read_real_buckets_ && bucket < 0) ||
+            (bucket_filter_ != std::nullopt && bucket != bucket_filter_.value()) ||
+            (level_filter_ != nullptr && !level_filter_(level_array->Value(i)))) {
+            selected[i] = 0;
+            continue;
+        }
+        if (!partition_filter_) {
+            continue;
+        }
+        std::string_view partition = partition_array->GetView(i);
+        if (last_partition != partition) {
+            auto partition_bytes = Bytes::AllocateBytes(partition.size(), pool_.get());
+            memcpy(partition_bytes->data(), partition.data(), partition.size());
+            PAIMON_ASSIGN_OR_RAISE(BinaryRow partition_row,
+                                   SerializationUtils::DeserializeBinaryRow(
+                                       std::shared_ptr<Bytes>(std::move(partition_bytes))));
+            PAIMON_ASSIGN_OR_RAISE(last_partition_selected,
+                                   partition_filter_->Test(partition_schema_, partition_row));
+            last_partition = partition;
+        }
+        selected[i] = last_partition_selected ? 1 : 0;
+    }
+    return selected;
+}
+
 Status FileStoreScan::SplitAndSetFilter(const std::vector<std::string>& partition_keys,
                                         const std::shared_ptr<arrow::Schema>& arrow_schema,
                                         const std::shared_ptr<ScanFilter>& scan_filters) {
@@ -52,6 +52,7 @@
 
 namespace arrow {
 class Schema;
+class StructArray;
 }  // namespace arrow
 
 namespace paimon {
@@ -232,6 +233,10 @@ class FileStoreScan {
     Status ReadManifestFileMeta(const ManifestFileMeta& manifest,
                                 std::vector<ManifestEntry>* entries) const;
 
+    /// Evaluates the partition, bucket and level filters on a decoded batch of manifest entries,
+    /// so that only the selected rows are converted to `ManifestEntry`.
+    Result<std::vector<char>> FilterManifestEntryBatch(const arrow::StructArray& batch) const;
+
  protected:
     std::shared_ptr<MemoryPool> pool_;
     std::shared_ptr<SchemaManager> schema_manager_;
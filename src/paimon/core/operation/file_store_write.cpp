@@ -150,25 +150,29 @@ Result<std::unique_ptr<FileStoreWrite>> FileStoreWrite::Create(std::unique_ptr<W
                                FieldsComparator::Create(trimmed_primary_key_fields,
                                                         options.SequenceFieldSortOrderIsAscending(),
                                                         /*use_view=*/true));
-        auto primary_keys = schema->PrimaryKeys();
-        PAIMON_ASSIGN_OR_RAISE(
-            std::unique_ptr<MergeFunction> merge_function,
-            PrimaryKeyTableUtils::CreateMergeFunction(arrow_schema, primary_keys, options));
-        if (options.NeedLookup() && options.GetMergeEngine() != MergeEngine::FIRST_ROW) {
-            // don't wrap first row, it is already OK
-            merge_function = std::make_unique<LookupMergeFunction>(std::move(merge_function));
-        }
-        std::shared_ptr<MergeFunctionWrapper<KeyValue>> merge_function_wrapper =
-            std::make_shared<ReducerMergeFunctionWrapper>(std::move(merge_function));
+        auto merge_function_wrapper_factory =
+            [arrow_schema, primary_keys = schema->PrimaryKeys(),
+             options]() -> Result<std::shared_ptr<MergeFunctionWrapper<KeyValue>>> {
+            PAIMON_ASSIGN_OR_RAISE(
+                std::unique_ptr<MergeFunction> merge_function,
+                PrimaryKeyTableUtils::CreateMergeFunction(arrow_schema, primary_keys, options));
+            if (options.NeedLookup() && options.GetMergeEngine() != MergeEngine::FIRST_ROW) {
+                // don't wrap first row, it is already OK
+                merge_function = std::make_unique<LookupMergeFunction>(std::move(merge_function));
+            }
+            return std::make_shared<ReducerMergeFunctionWrapper>(std::move(merge_function));
+        };
+        // validate merge function eagerly, instead of failing on the first write
+        PAIMON_RETURN_NOT_OK(merge_function_wrapper_factory().status());
         PAIMON_ASSIGN_OR_RAISE(
             std::shared_ptr<FieldsComparator> sequence_fields_comparator,
             PrimaryKeyTableUtils::CreateSequenceFieldsComparator(schema->Fields(), options));
         return std::make_unique<KeyValueFileStoreWrite>(
             file_store_path_factory, snapshot_manager, schema_manager, ctx->GetCommitUser(),
             ctx->GetRootPath(), schema, arrow_schema, partition_schema, key_comparator,
-            sequence_fields_comparator, merge_function_wrapper, options, ignore_previous_files,
-            ctx->IsStreamingMode(), ctx->IgnoreNumBucketCheck(), ctx->GetExecutor(),
-            ctx->GetMemoryPool());
+            sequence_fields_comparator, merge_function_wrapper_factory, options,
+            ignore_previous_files, ctx->IsStreamingMode(), ctx->IgnoreNumBucketCheck(),
+            ctx->GetExecutor(), ctx->GetMemoryPool());
     }
 }
 
@@ -20,17 +20,27 @@
 #include <vector>
 
 #include "paimon/common/data/binary_row.h"
+#include "paimon/common/types/data_field.h"
+#include "paimon/core/compact/compact_manager.h"
 #include "paimon/core/core_options.h"
 #include "paimon/core/io/data_file_meta.h"
 #include "paimon/core/manifest/manifest_file.h"
 #include "paimon/core/manifest/manifest_list.h"
+#include "paimon/core/mergetree/compact/merge_tree_compact_manager.h"
+#include "paimon/core/mergetree/compact/merge_tree_compact_rewriter.h"
+#include "paimon/core/mergetree/compact/universal_compaction.h"
+#include "paimon/core/mergetree/levels.h"
 #include "paimon/core/mergetree/merge_tree_writer.h"
 #include "paimon/core/operation/file_store_scan.h"
+#include "paimon/core/operation/internal_read_context.h"
 #include "paimon/core/operation/key_value_file_store_scan.h"
+#include "paimon/core/operation/merge_file_split_read.h"
+#include "paimon/core/options/changelog_producer.h"
 #include "paimon/core/schema/table_schema.h"
 #include "paimon/core/snapshot.h"
 #include "paimon/core/utils/file_store_path_factory.h"
 #include "paimon/core/utils/snapshot_manager.h"
+#include "paimon/read_context.h"
 
 namespace arrow {
 class Schema;
@@ -54,7 +64,7 @@ KeyValueFileStoreWrite::KeyValueFileStoreWrite(
     const std::shared_ptr<arrow::Schema>& partition_schema,
     const std::shared_ptr<FieldsComparator>& key_comparator,
     const std::shared_ptr<FieldsComparator>& user_defined_seq_comparator,
-    const std::shared_ptr<MergeFunctionWrapper<KeyValue>>& merge_function_wrapper,
+    const MergeFunctionWrapperFactory& merge_function_wrapper_factory,
     const CoreOptions& options, bool ignore_previous_files, bool is_streaming_mode,
     bool ignore_num_bucket_check, const std::shared_ptr<Executor>& executor,
     const std::shared_ptr<MemoryPool>& pool)
@@ -64,7 +74,7 @@ KeyValueFileStoreWrite::KeyValueFileStoreWrite(
                              ignore_num_bucket_check, executor, pool),
       key_comparator_(key_comparator),
       user_defined_seq_comparator_(user_defined_seq_comparator),
-      merge_function_wrapper_(merge_function_wrapper),
+      merge_function_wrapper_factory_(merge_function_wrapper_factory),
       logger_(Logger::GetLogger("KeyValueFileStoreWrite")) {}
 
 Result<std::unique_ptr<FileStoreScan>> KeyValueFileStoreWrite::CreateFileStoreScan(
@@ -104,11 +114,77 @@ Result<std::pair<int32_t, std::shared_ptr<BatchWriter>>> KeyValueFileStoreWrite:
                            file_store_path_factory_->CreateDataFilePathFactory(partition, bucket));
     PAIMON_ASSIGN_OR_RAISE(std::vector<std::string> trimmed_primary_keys,
                            table_schema_->TrimmedPrimaryKeys());
+    PAIMON_ASSIGN_OR_RAISE(std::shared_ptr<MergeFunctionWrapper<KeyValue>> merge_function_wrapper,
+                           merge_function_wrapper_factory_());
+    std::shared_ptr<CompactManager> compact_manager;
+    if (NeedCompaction()) {
+        PAIMON_ASSIGN_OR_RAISE(compact_manager,
+                               CreateCompactManager(partition, trimmed_primary_keys,
+                                                    data_file_path_factory, restore_files));
+    }
     auto writer = std::make_shared<MergeTreeWriter>(
         max_sequence_number, trimmed_primary_keys, data_file_path_factory, key_comparator_,
-        user_defined_seq_comparator_, merge_function_wrapper_, table_schema_->Id(), schema_,
-        options_, pool_);
+        user_defined_seq_comparator_, merge_function_wrapper, table_schema_->Id(), schema_,
+        options_, pool_, compact_manager, executor_);
+    if (write_memory_manager_) {
+        writer->WithMemoryManager(write_memory_manager_);
+    }
     return std::pair<int32_t, std::shared_ptr<BatchWriter>>(total_buckets, writer);
 }
 
+bool KeyValueFileStoreWrite::NeedCompaction() const {
+    if (options_.WriteOnly()) {
+        return false;
+    }
+    // compaction does not maintain deletion vectors, nor produce the changelog of lookup and
+    // full-compaction changelog producers yet, leave the files to a compaction job
+    ChangelogProducer changelog_producer = options_.GetChangelogProducer();
+    return !options_.DeletionVectorsEnabled() && changelog_producer != ChangelogProducer::LOOKUP &&
+           changelog_producer != ChangelogProducer::FULL_COMPACTION;
+}
+
+Result<std::shared_ptr<CompactManager>> KeyValueFileStoreWrite::CreateCompactManager(
+    const BinaryRow& partition, const std::vector<std::string>& trimmed_primary_keys,
+    const std::shared_ptr<DataFilePathFactory>& data_file_path_factory,
+    const std::vector<std::shared_ptr<DataFileMeta>>& restore_files) const {
+    // min/max keys of file metas are compared, key fields are always in ascending order
+    PAIMON_ASSIGN_OR_RAISE(std::vector<DataField> trimmed_primary_key_fields,
+                           table_schema_->GetFields(trimmed_primary_keys));
+    PAIMON_ASSIGN_OR_RAISE(std::shared_ptr<FieldsComparator> file_key_comparator,
+                           FieldsComparator::Create(trimmed_primary_key_fields,
+                                                    /*is_ascending_order=*/true,
+                                                    /*use_view=*/false));
+    PAIMON_ASSIGN_OR_RAISE(
+        std::unique_ptr<Levels> levels,
+        Levels::Create(file_key_comparator, restore_files, options_.GetNumLevels()));
+
+    // compaction reads all table fields with the same merge function as the writer, it runs on
+    // the executor so prefetch (which also submits to the executor) is disabled
+    ReadContextBuilder read_context_builder(root_path_);
+    read_context_builder.SetOptions(options_.ToMap())
+        .EnablePrefetch(false)
+        .WithMemoryPool(pool_)
+        .WithExecutor(executor_)
+        .WithFileSystem(options_.GetFileSystem());
+    PAIMON_ASSIGN_OR_RAISE(std::shared_ptr<ReadContext> read_context,
+                           read_context_builder.Finish());
+    PAIMON_ASSIGN_OR_RAISE(
+        std::shared_ptr<InternalReadContext> internal_read_context,
+        InternalReadContext::Create(read_context, table_schema_, options_.ToMap()));
+    PAIMON_ASSIGN_OR_RAISE(std::unique_ptr<MergeFileSplitRead> merge_read,
+                           MergeFileSplitRead::Create(file_store_path_factory_,
+                                                      internal_read_context, pool_, executor_));
+    PAIMON_ASSIGN_OR_RAISE(
+        std::shared_ptr<MergeTreeCompactRewriter> rewriter,
+        MergeTreeCompactRewriter::Create(partition, table_schema_->Id(), trimmed_primary_keys,
+                                         schema_, data_file_path_factory, std::move(merge_read),
+                                         options_, pool_));
+    UniversalCompaction strategy(options_.GetCompactionMaxSizeAmplificationPercent(),
+                                 options_.GetCompactionSizeRatio(),
+                                 options_.GetNumSortedRunsCompactionTrigger());
+    return std::make_shared<MergeTreeCompactManager>(
+        executor_, std::move(levels), strategy, file_key_comparator,
+        options_.GetCompactionFileSize(), options_.GetNumSortedRunsStopTrigger(), rewriter);
+}
+
 }  // namespace paimon
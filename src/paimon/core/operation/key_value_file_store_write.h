@@ -17,9 +17,11 @@
 #pragma once
 
 #include <cstdint>
+#include <functional>
 #include <memory>
 #include <string>
 #include <utility>
+#include <vector>
 
 #include "paimon/core/mergetree/compact/merge_function_wrapper.h"
 #include "paimon/core/operation/abstract_file_store_write.h"
@@ -37,19 +39,27 @@ class FieldsComparator;
 class FileStoreScan;
 class ScanFilter;
 class BinaryRow;
+class CompactManager;
 class CoreOptions;
+class DataFilePathFactory;
 class Executor;
 class FileStorePathFactory;
 class MemoryPool;
 class SchemaManager;
 class SnapshotManager;
 class TableSchema;
+struct DataFileMeta;
 struct KeyValue;
 template <typename T>
 class MergeFunctionWrapper;
 
 class KeyValueFileStoreWrite : public AbstractFileStoreWrite {
  public:
+    // merge function wrapper is stateful, each writer (and its compaction) creates its own one as
+    // writers of different buckets flush and compact concurrently
+    using MergeFunctionWrapperFactory =
+        std::function<Result<std::shared_ptr<MergeFunctionWrapper<KeyValue>>>()>;
+
     KeyValueFileStoreWrite(
         const std::shared_ptr<FileStorePathFactory>& file_store_path_factory,
         const std::shared_ptr<SnapshotManager>& snapshot_manager,
@@ -59,7 +69,7 @@ class KeyValueFileStoreWrite : public AbstractFileStoreWrite {
         const std::shared_ptr<arrow::Schema>& partition_schema,
         const std::shared_ptr<FieldsComparator>& key_comparator,
         const std::shared_ptr<FieldsComparator>& user_defined_seq_comparator,
-        const std::shared_ptr<MergeFunctionWrapper<KeyValue>>& merge_function_wrapper,
+        const MergeFunctionWrapperFactory& merge_function_wrapper_factory,
         const CoreOptions& options, bool ignore_previous_files, bool is_streaming_mode,
         bool ignore_num_bucket_check, const std::shared_ptr<Executor>& executor,
         const std::shared_ptr<MemoryPool>& pool);
@@ -68,13 +78,20 @@ class KeyValueFileStoreWrite : public AbstractFileStoreWrite {
     Result<std::pair<int32_t, std::shared_ptr<BatchWriter>>> CreateWriter(
         const BinaryRow& partition, int32_t bucket, bool ignore_previous_files) override;
 
+    bool NeedCompaction() const;
+
+    Result<std::shared_ptr<CompactManager>> CreateCompactManager(
+        const BinaryRow& partition, const std::vector<std::string>& trimmed_primary_keys,
+        const std::shared_ptr<DataFilePathFactory>& data_file_path_factory,
+        const std::vector<std::shared_ptr<DataFileMeta>>& restore_files) const;
+
     Result<std::unique_ptr<FileStoreScan>> CreateFileStoreScan(
         const std::shared_ptr<ScanFilter>& filter) const override;
 
  private:
     std::shared_ptr<FieldsComparator> key_comparator_;
     std::shared_ptr<FieldsComparator> user_defined_seq_comparator_;
-    std::shared_ptr<MergeFunctionWrapper<KeyValue>> merge_function_wrapper_;
+    MergeFunctionWrapperFactory merge_function_wrapper_factory_;
     std::unique_ptr<Logger> logger_;
 };
 
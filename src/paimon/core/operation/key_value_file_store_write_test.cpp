@@ -18,6 +18,8 @@
 
 #include <cstddef>
 #include <map>
+#include <memory>
+#include <string>
 #include <vector>
 
 #include "arrow/array/array_base.h"
@@ -30,7 +32,11 @@
 #include "gtest/gtest.h"
 #include "paimon/catalog/catalog.h"
 #include "paimon/catalog/identifier.h"
+#include "paimon/common/data/binary_row.h"
 #include "paimon/common/utils/path_util.h"
+#include "paimon/core/mergetree/merge_tree_writer.h"
+#include "paimon/core/utils/write_memory_manager.h"
+#include "paimon/defs.h"
 #include "paimon/file_store_write.h"
 #include "paimon/record_batch.h"
 #include "paimon/status.h"
@@ -133,4 +139,70 @@ TEST(KeyValueFileStoreWriteTest, TestWriteWithInvalidBatch) {
         ArrowArrayRelease(&arrow_array);
     }
 }
+
+TEST(KeyValueFileStoreWriteTest, TestWriteBufferTotalSize) {
+    arrow::Schema typed_schema(
+        {arrow::field("f0", arrow::int32()), arrow::field("f1", arrow::utf8())});
+    std::string commit_user = "test";
+    for (const auto& total_size : {std::string("0"), std::string("64mb")}) {
+        ::ArrowSchema schema;
+        ASSERT_TRUE(arrow::ExportSchema(typed_schema, &schema).ok());
+        auto dir = UniqueTestDirectory::Create();
+        ASSERT_TRUE(dir);
+        ASSERT_OK_AND_ASSIGN(auto catalog, Catalog::Create(dir->Str(), {}));
+        ASSERT_OK(catalog->CreateDatabase("foo", {}, /*ignore_if_exists=*/false));
+        ASSERT_OK(catalog->CreateTable(
+            Identifier("foo", "bar"), &schema, /*partition_keys=*/{}, /*primary_keys=*/{"f0"},
+            /*options=*/{{"bucket", "2"}, {Options::WRITE_BUFFER_TOTAL_SIZE, total_size}},
+            /*ignore_if_exists=*/false));
+
+        WriteContextBuilder builder(PathUtil::JoinPath(dir->Str(), "foo.db/bar"), commit_user);
+        ASSERT_OK_AND_ASSIGN(std::unique_ptr<WriteContext> write_context, builder.Finish());
+        ASSERT_OK_AND_ASSIGN(auto file_store_write,
+                             FileStoreWrite::Create(std::move(write_context)));
+        auto key_value_write = dynamic_cast<KeyValueFileStoreWrite*>(file_store_write.get());
+        ASSERT_TRUE(key_value_write);
+        if (total_size == "0") {
+            ASSERT_FALSE(key_value_write->write_memory_manager_);
+        } else {
+            ASSERT_TRUE(key_value_write->write_memory_manager_);
+            ASSERT_EQ(64 * 1024 * 1024, key_value_write->write_memory_manager_->Budget());
+        }
+    }
+}
+
+TEST(KeyValueFileStoreWriteTest, TestCompactionWithChangelogProducer) {
+    arrow::Schema typed_schema(
+        {arrow::field("f0", arrow::int32()), arrow::field("f1", arrow::utf8())});
+    // compaction does not produce the changelog of lookup and full-compaction producers yet
+    std::map<std::string, bool> expected = {
+        {"none", true}, {"input", true}, {"lookup", false}, {"full-compaction", false}};
+    for (const auto& [changelog_producer, need_compaction] : expected) {
+        ::ArrowSchema schema;
+        ASSERT_TRUE(arrow::ExportSchema(typed_schema, &schema).ok());
+        auto dir = UniqueTestDirectory::Create();
+        ASSERT_TRUE(dir);
+        ASSERT_OK_AND_ASSIGN(auto catalog, Catalog::Create(dir->Str(), {}));
+        ASSERT_OK(catalog->CreateDatabase("foo", {}, /*ignore_if_exists=*/false));
+        ASSERT_OK(catalog->CreateTable(
+            Identifier("foo", "bar"), &schema, /*partition_keys=*/{}, /*primary_keys=*/{"f0"},
+            /*options=*/{{"bucket", "1"}, {Options::CHANGELOG_PRODUCER, changelog_producer}},
+            /*ignore_if_exists=*/false));
+
+        WriteContextBuilder builder(PathUtil::JoinPath(dir->Str(), "foo.db/bar"), "test");
+        ASSERT_OK_AND_ASSIGN(std::unique_ptr<WriteContext> write_context, builder.Finish());
+        ASSERT_OK_AND_ASSIGN(auto file_store_write,
+                             FileStoreWrite::Create(std::move(write_context)));
+        auto key_value_write = dynamic_cast<KeyValueFileStoreWrite*>(file_store_write.get());
+        ASSERT_TRUE(key_value_write);
+        ASSERT_OK_AND_ASSIGN(auto bucket_and_writer,
+                             key_value_write->CreateWriter(BinaryRow::EmptyRow(), /*bucket=*/0,
+                                                           /*ignore_previous_files=*/true));
+        auto writer = std::dynamic_pointer_cast<MergeTreeWriter>(bucket_and_writer.second);
+        ASSERT_TRUE(writer);
+        ASSERT_EQ(need_compaction, writer->compact_manager_ != nullptr) << changelog_producer;
+        ASSERT_OK(writer->Close());
+    }
+}
+
 }  // namespace paimon::test
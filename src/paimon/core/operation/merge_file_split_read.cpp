@@ -30,6 +30,7 @@
 #include "paimon/common/predicate/predicate_utils.h"
 #include "paimon/common/reader/complete_row_kind_batch_reader.h"
 #include "paimon/common/reader/concat_batch_reader.h"
+#include "paimon/common/reader/parallel_concat_batch_reader.h"
 #include "paimon/common/table/special_fields.h"
 #include "paimon/common/types/data_field.h"
 #include "paimon/common/utils/arrow/status_utils.h"
@@ -39,6 +40,8 @@
 #include "paimon/core/io/async_key_value_projection_reader.h"
 #include "paimon/core/io/concat_key_value_record_reader.h"
 #include "paimon/core/io/data_file_meta.h"
+#include "paimon/core/io/data_file_path_factory.h"
+#include "paimon/core/io/key_value_columnar_projection_reader.h"
 #include "paimon/core/io/key_value_data_file_record_reader.h"
 #include "paimon/core/io/key_value_projection_reader.h"
 #include "paimon/core/mergetree/compact/interval_partition.h"
@@ -69,7 +72,6 @@ namespace paimon {
 class BinaryRow;
 class DataFilePathFactory;
 class Executor;
-struct DeletionFile;
 struct KeyValue;
 template <typename T>
 class MergeFunctionWrapper;
@@ -167,15 +169,13 @@ Result<std::unique_ptr<BatchReader>> MergeFileSplitRead::ApplyIndexAndDvReaderIf
     std::unique_ptr<FileBatchReader>&& file_reader, const std::shared_ptr<DataFileMeta>& file,
     const std::shared_ptr<arrow::Schema>& data_schema,
     const std::shared_ptr<arrow::Schema>& read_schema, const std::shared_ptr<Predicate>& predicate,
-    const std::unordered_map<std::string, DeletionFile>& deletion_file_map,
-    const std::optional<std::vector<Range>>& ranges,
+    const DeletionVectorMap& deletion_vectors, const std::optional<std::vector<Range>>& ranges,
     const std::shared_ptr<DataFilePathFactory>& data_file_path_factory) const {
     // merge read does not use index
-    PAIMON_UNIQUE_PTR<DeletionVector> deletion_vector;
-    auto dv_iter = deletion_file_map.find(file->file_name);
-    if (dv_iter != deletion_file_map.end()) {
-        PAIMON_ASSIGN_OR_RAISE(deletion_vector, DeletionVector::Read(options_.GetFileSystem().get(),
-                                                                     dv_iter->second, pool_.get()));
+    std::shared_ptr<const DeletionVector> deletion_vector;
+    auto dv_iter = deletion_vectors.find(file->file_name);
+    if (dv_iter != deletion_vectors.end()) {
+        deletion_vector = dv_iter->second;
     }
     ::ArrowSchema c_read_schema;
     PAIMON_RETURN_NOT_OK_FROM_ARROW(arrow::ExportSchema(*read_schema, &c_read_schema));
@@ -192,20 +192,41 @@ Result<std::unique_ptr<BatchReader>> MergeFileSplitRead::ApplyIndexAndDvReaderIf
 Result<std::unique_ptr<BatchReader>> MergeFileSplitRead::CreateMergeReader(
     const std::shared_ptr<DataSplitImpl>& data_split,
     const std::shared_ptr<DataFilePathFactory>& data_file_path_factory) const {
-    auto deletion_file_map = AbstractSplitRead::CreateDeletionFileMap(*data_split);
+    PAIMON_ASSIGN_OR_RAISE(DeletionVectorMap deletion_vectors, LoadDeletionVectors(*data_split));
     std::vector<std::vector<SortedRun>> sections =
         IntervalPartition(data_split->DataFiles(), interval_partition_comparator_).Partition();
+    // Sections are merged concurrently on the executor. Prefetch readers wait for tasks of the
+    // same executor, merging sections on it as well may occupy all threads, so sections are
+    // merged one after another when prefetch is enabled.
+    bool parallel = options_.GetReadMergeSectionParallelism() > 1 && sections.size() > 1 &&
+                    executor_ != nullptr && !context_->EnablePrefetch();
     std::vector<std::unique_ptr<BatchReader>> batch_readers;
     batch_readers.reserve(sections.size());
     // no overlap through multiple sections
     for (const auto& section : sections) {
+        // merge function is stateful, sections merged concurrently can not share it
+        std::shared_ptr<MergeFunctionWrapper<KeyValue>> merge_function_wrapper =
+            merge_function_wrapper_;
+        if (parallel && section.size() > 1) {
+            PAIMON_ASSIGN_OR_RAISE(
+                merge_function_wrapper,
+                CreateMergeFunctionWrapper(options_, context_->GetTableSchema(), value_schema_));
+        }
         PAIMON_ASSIGN_OR_RAISE(
             std::unique_ptr<BatchReader> projection_reader,
             CreateReaderForSection(section, data_split->BucketPath(), data_split->Partition(),
-                                   deletion_file_map, data_file_path_factory));
+                                   deletion_vectors, merge_function_wrapper,
+                                   data_file_path_factory));
         batch_readers.push_back(std::move(projection_reader));
     }
-    auto concat_batch_reader = std::make_unique<ConcatBatchReader>(std::move(batch_readers), pool_);
+    std::unique_ptr<BatchReader> concat_batch_reader;
+    if (parallel) {
+        concat_batch_reader = std::make_unique<ParallelConcatBatchReader>(
+            std::move(batch_readers), options_.GetReadMergeSectionParallelism(),
+            ParallelConcatBatchReader::DEFAULT_MAX_BUFFERED_BATCHES, executor_, pool_);
+    } else {
+        concat_batch_reader = std::make_unique<ConcatBatchReader>(std::move(batch_readers), pool_);
+    }
     return AbstractSplitRead::ApplyPredicateFilterIfNeeded(std::move(concat_batch_reader),
                                                            context_->GetPredicate());
 }
@@ -213,20 +234,17 @@ Result<std::unique_ptr<BatchReader>> MergeFileSplitRead::CreateMergeReader(
 Result<std::unique_ptr<BatchReader>> MergeFileSplitRead::CreateNoMergeReader(
     const std::shared_ptr<DataSplitImpl>& data_split, bool only_filter_key,
     const std::shared_ptr<DataFilePathFactory>& data_file_path_factory) const {
-    auto deletion_file_map = AbstractSplitRead::CreateDeletionFileMap(*data_split);
+    PAIMON_ASSIGN_OR_RAISE(DeletionVectorMap deletion_vectors, LoadDeletionVectors(*data_split));
     // create read schema without extra fields (e.g., completed key, sequence fields)
     auto row_kind_field = DataField::ConvertDataFieldToArrowField(SpecialFields::ValueKind());
 
     PAIMON_ASSIGN_OR_RAISE_FROM_ARROW(std::shared_ptr<arrow::Schema> read_schema,
                                       raw_read_schema_->AddField(0, row_kind_field));
     PAIMON_ASSIGN_OR_RAISE(
-        std::vector<std::unique_ptr<BatchReader>> raw_file_readers,
-        CreateRawFileReaders(data_split->Partition(), data_split->DataFiles(), read_schema,
-                             only_filter_key ? predicate_for_keys_ : context_->GetPredicate(),
-                             deletion_file_map, /*row_ranges=*/{}, data_file_path_factory));
-
-    auto concat_batch_reader =
-        std::make_unique<ConcatBatchReader>(std::move(raw_file_readers), pool_);
+        std::unique_ptr<BatchReader> concat_batch_reader,
+        CreateConcatRawFileReader(data_split->Partition(), data_split->DataFiles(), read_schema,
+                                  only_filter_key ? predicate_for_keys_ : context_->GetPredicate(),
+                                  deletion_vectors, /*row_ranges=*/{}, data_file_path_factory));
     return AbstractSplitRead::ApplyPredicateFilterIfNeeded(std::move(concat_batch_reader),
                                                            context_->GetPredicate());
 }
@@ -383,27 +401,37 @@ std::vector<int32_t> MergeFileSplitRead::CreateProjection(
 
 Result<std::unique_ptr<BatchReader>> MergeFileSplitRead::CreateReaderForSection(
     const std::vector<SortedRun>& section, const std::string& bucket_path,
-    const BinaryRow& partition,
-    const std::unordered_map<std::string, DeletionFile>& deletion_file_map,
+    const BinaryRow& partition, const DeletionVectorMap& deletion_vectors,
+    const std::shared_ptr<MergeFunctionWrapper<KeyValue>>& merge_function_wrapper,
     const std::shared_ptr<DataFilePathFactory>& data_file_path_factory) const {
+    if (section.size() == 1) {
+        // keys in a single sorted run are unique, merge function is not needed, project key value
+        // batches to raw read schema in columnar form
+        PAIMON_ASSIGN_OR_RAISE(
+            std::vector<std::unique_ptr<BatchReader>> raw_file_readers,
+            CreateRawFileReaders(partition, section[0].Files(), read_schema_,
+                                 context_->GetPredicate(), deletion_vectors,
+                                 /*row_ranges=*/{}, data_file_path_factory));
+        auto concat_batch_reader =
+            std::make_unique<ConcatBatchReader>(std::move(raw_file_readers), pool_);
+        return KeyValueColumnarProjectionReader::Create(std::move(concat_batch_reader),
+                                                        read_schema_, raw_read_schema_, pool_);
+    }
     // with overlap in one section
     std::vector<std::unique_ptr<KeyValueRecordReader>> record_readers;
     record_readers.reserve(section.size());
-    std::shared_ptr<Predicate> predicate;
-    if (section.size() > 1) {
-        predicate = predicate_for_keys_;
-    } else {
-        predicate = context_->GetPredicate();
-    }
+    // only key predicates can be pushed down to overlapped runs
+    std::shared_ptr<Predicate> predicate = predicate_for_keys_;
     for (const auto& run : section) {
         // no overlap in a run
         PAIMON_ASSIGN_OR_RAISE(std::unique_ptr<KeyValueRecordReader> run_reader,
-                               CreateReaderForRun(bucket_path, partition, run, deletion_file_map,
+                               CreateReaderForRun(bucket_path, partition, run, deletion_vectors,
                                                   predicate, data_file_path_factory));
         record_readers.emplace_back(std::move(run_reader));
     }
-    PAIMON_ASSIGN_OR_RAISE(std::unique_ptr<SortMergeReader> sort_merge_reader,
-                           CreateSortMergeReader(std::move(record_readers)));
+    PAIMON_ASSIGN_OR_RAISE(
+        std::unique_ptr<SortMergeReader> sort_merge_reader,
+        CreateSortMergeReader(std::move(record_readers), merge_function_wrapper));
 
     auto drop_delete_reader = std::make_unique<DropDeleteReader>(std::move(sort_merge_reader));
     // KeyValueProjectionReader converts KeyValue objects to arrow array according to projection
@@ -418,16 +446,43 @@ Result<std::unique_ptr<BatchReader>> MergeFileSplitRead::CreateReaderForSection(
         thread_number, pool_);
 }
 
+Result<std::unique_ptr<SortMergeReader>> MergeFileSplitRead::CreateCompactReader(
+    const BinaryRow& partition, const std::vector<SortedRun>& section, bool drop_delete,
+    const std::shared_ptr<DataFilePathFactory>& data_file_path_factory) {
+    if (!merge_function_wrapper_) {
+        PAIMON_ASSIGN_OR_RAISE(
+            merge_function_wrapper_,
+            CreateMergeFunctionWrapper(options_, context_->GetTableSchema(), value_schema_));
+    }
+    // compaction reads all records, no predicate and no deletion vector
+    DeletionVectorMap deletion_vectors;
+    std::vector<std::unique_ptr<KeyValueRecordReader>> record_readers;
+    record_readers.reserve(section.size());
+    for (const auto& run : section) {
+        PAIMON_ASSIGN_OR_RAISE(
+            std::unique_ptr<KeyValueRecordReader> run_reader,
+            CreateReaderForRun(data_file_path_factory->Parent(), partition, run, deletion_vectors,
+                               /*predicate=*/nullptr, data_file_path_factory));
+        record_readers.emplace_back(std::move(run_reader));
+    }
+    PAIMON_ASSIGN_OR_RAISE(
+        std::unique_ptr<SortMergeReader> sort_merge_reader,
+        CreateSortMergeReader(std::move(record_readers), merge_function_wrapper_));
+    if (drop_delete) {
+        return std::make_unique<DropDeleteReader>(std::move(sort_merge_reader));
+    }
+    return sort_merge_reader;
+}
+
 Result<std::unique_ptr<KeyValueRecordReader>> MergeFileSplitRead::CreateReaderForRun(
     const std::string& bucket_path, const BinaryRow& partition, const SortedRun& sorted_run,
-    const std::unordered_map<std::string, DeletionFile>& deletion_file_map,
-    const std::shared_ptr<Predicate>& predicate,
+    const DeletionVectorMap& deletion_vectors, const std::shared_ptr<Predicate>& predicate,
     const std::shared_ptr<DataFilePathFactory>& data_file_path_factory) const {
     // no overlap in a run
     const auto& data_files = sorted_run.Files();
     PAIMON_ASSIGN_OR_RAISE(
         std::vector<std::unique_ptr<BatchReader>> raw_file_readers,
-        CreateRawFileReaders(partition, data_files, read_schema_, predicate, deletion_file_map,
+        CreateRawFileReaders(partition, data_files, read_schema_, predicate, deletion_vectors,
                              /*row_ranges=*/{}, data_file_path_factory));
 
     assert(data_files.size() == raw_file_readers.size());
@@ -443,16 +498,17 @@ Result<std::unique_ptr<KeyValueRecordReader>> MergeFileSplitRead::CreateReaderFo
 }
 
 Result<std::unique_ptr<SortMergeReader>> MergeFileSplitRead::CreateSortMergeReader(
-    std::vector<std::unique_ptr<KeyValueRecordReader>>&& record_readers) const {
+    std::vector<std::unique_ptr<KeyValueRecordReader>>&& record_readers,
+    const std::shared_ptr<MergeFunctionWrapper<KeyValue>>& merge_function_wrapper) const {
     auto sort_engine = options_.GetSortEngine();
     if (sort_engine == SortEngine::MIN_HEAP) {
         return std::make_unique<SortMergeReaderWithMinHeap>(
             std::move(record_readers), key_comparator_, user_defined_seq_comparator_,
-            merge_function_wrapper_);
+            merge_function_wrapper, options_.SortNormalizedKeyEnabled());
     } else if (sort_engine == SortEngine::LOSER_TREE) {
         return std::make_unique<SortMergeReaderWithLoserTree>(
             std::move(record_readers), key_comparator_, user_defined_seq_comparator_,
-            merge_function_wrapper_);
+            merge_function_wrapper, options_.SortNormalizedKeyEnabled());
     }
     return Status::Invalid("only support loser-tree or min-heap sort engine");
 }
@@ -22,6 +22,7 @@
 #include <unordered_map>
 #include <vector>
 
+#include "paimon/core/deletionvectors/deletion_vector_loader.h"
 #include "paimon/core/io/concat_key_value_record_reader.h"
 #include "paimon/core/io/data_file_meta.h"
 #include "paimon/core/io/key_value_record_reader.h"
@@ -30,7 +31,6 @@
 #include "paimon/core/mergetree/compact/sort_merge_reader.h"
 #include "paimon/core/mergetree/sorted_run.h"
 #include "paimon/core/operation/abstract_split_read.h"
-#include "paimon/core/table/source/deletion_file.h"
 #include "paimon/core/utils/fields_comparator.h"
 #include "paimon/predicate/predicate.h"
 #include "paimon/reader/batch_reader.h"
@@ -58,7 +58,6 @@ class SchemaManager;
 class SortedRun;
 class TableSchema;
 struct DataFileMeta;
-struct DeletionFile;
 struct KeyValue;
 template <typename T>
 class MergeFunctionWrapper;
@@ -68,11 +67,14 @@ class MergeFunctionWrapper;
 ///
 /// Readers Overview: (ConcatBatchReader across
 /// splits)->CompleteRowKindBatchReader->(PredicateBatchReader)
-/// ->ConcatBatchReader across no overlapped
-/// files->KeyValueProjectionReader/AsyncKeyValueProjectionReader
+/// ->ConcatBatchReader/ParallelConcatBatchReader across no overlapped
+/// sections->KeyValueProjectionReader/AsyncKeyValueProjectionReader
 /// ->DropDeleteReader->SortMergeReader->ConcatKeyValueRecordReader->KeyValueDataFileRecordReader
 /// ->FieldMappingReader->(ApplyDeletionVectorBatchReader)->(DelegatingPrefetchReader)
 /// ->(PrefetchFileBatchReader)->FormatReader
+///
+/// A section with a single sorted run does not need merge, it is read by
+/// KeyValueColumnarProjectionReader->ConcatBatchReader->FieldMappingReader->... instead.
 class MergeFileSplitRead : public AbstractSplitRead {
  public:
     static Result<std::unique_ptr<MergeFileSplitRead>> Create(
@@ -88,11 +90,21 @@ class MergeFileSplitRead : public AbstractSplitRead {
         std::unique_ptr<FileBatchReader>&& file_reader, const std::shared_ptr<DataFileMeta>& file,
         const std::shared_ptr<arrow::Schema>& data_schema,
         const std::shared_ptr<arrow::Schema>& read_schema,
-        const std::shared_ptr<Predicate>& predicate,
-        const std::unordered_map<std::string, DeletionFile>& deletion_file_map,
+        const std::shared_ptr<Predicate>& predicate, const DeletionVectorMap& deletion_vectors,
         const std::optional<std::vector<Range>>& ranges,
         const std::shared_ptr<DataFilePathFactory>& data_file_path_factory) const override;
 
+    /// Creates a reader which sort-merges the overlapped runs of `section` for compaction, the
+    /// output keys are unique and ordered. Retract records are kept unless `drop_delete` is true.
+    /// The value of output `KeyValue` follows `GetValueSchema()`.
+    Result<std::unique_ptr<SortMergeReader>> CreateCompactReader(
+        const BinaryRow& partition, const std::vector<SortedRun>& section, bool drop_delete,
+        const std::shared_ptr<DataFilePathFactory>& data_file_path_factory);
+
+    const std::shared_ptr<arrow::Schema>& GetValueSchema() const {
+        return value_schema_;
+    }
+
  private:
     Result<std::unique_ptr<BatchReader>> CreateMergeReader(
         const std::shared_ptr<DataSplitImpl>& data_split,
@@ -104,18 +116,18 @@ class MergeFileSplitRead : public AbstractSplitRead {
 
     Result<std::unique_ptr<BatchReader>> CreateReaderForSection(
         const std::vector<SortedRun>& section, const std::string& bucket_path,
-        const BinaryRow& partition,
-        const std::unordered_map<std::string, DeletionFile>& deletion_file_map,
+        const BinaryRow& partition, const DeletionVectorMap& deletion_vectors,
+        const std::shared_ptr<MergeFunctionWrapper<KeyValue>>& merge_function_wrapper,
         const std::shared_ptr<DataFilePathFactory>& data_file_path_factory) const;
 
     Result<std::unique_ptr<KeyValueRecordReader>> CreateReaderForRun(
         const std::string& bucket_path, const BinaryRow& partition, const SortedRun& sorted_run,
-        const std::unordered_map<std::string, DeletionFile>& deletion_file_map,
-        const std::shared_ptr<Predicate>& predicate,
+        const DeletionVectorMap& deletion_vectors, const std::shared_ptr<Predicate>& predicate,
         const std::shared_ptr<DataFilePathFactory>& data_file_path_factory) const;
 
     Result<std::unique_ptr<SortMergeReader>> CreateSortMergeReader(
-        std::vector<std::unique_ptr<KeyValueRecordReader>>&& record_readers) const;
+        std::vector<std::unique_ptr<KeyValueRecordReader>>&& record_readers,
+        const std::shared_ptr<MergeFunctionWrapper<KeyValue>>& merge_function_wrapper) const;
 
     MergeFileSplitRead(const std::shared_ptr<FileStorePathFactory>& path_factory,
                        const std::shared_ptr<InternalReadContext>& context,
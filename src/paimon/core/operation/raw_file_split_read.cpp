@@ -48,7 +48,6 @@ namespace paimon {
 class DataFilePathFactory;
 class Executor;
 class Predicate;
-struct DeletionFile;
 
 RawFileSplitRead::RawFileSplitRead(const std::shared_ptr<FileStorePathFactory>& path_factory,
                                    const std::shared_ptr<InternalReadContext>& context,
@@ -66,22 +65,31 @@ Result<std::unique_ptr<BatchReader>> RawFileSplitRead::CreateReader(
     if (!data_split) {
         return Status::Invalid("cannot cast split to data_split in RawFileSplitRead");
     }
-    auto deletion_file_map = CreateDeletionFileMap(*data_split);
+    PAIMON_ASSIGN_OR_RAISE(DeletionVectorMap deletion_vectors, LoadDeletionVectors(*data_split));
     const auto& predicate = context_->GetPredicate();
     PAIMON_ASSIGN_OR_RAISE(
         std::shared_ptr<DataFilePathFactory> data_file_path_factory,
         path_factory_->CreateDataFilePathFactory(data_split->Partition(), data_split->Bucket()));
-    PAIMON_ASSIGN_OR_RAISE(std::vector<std::unique_ptr<BatchReader>> raw_file_readers,
-                           CreateRawFileReaders(data_split->Partition(), data_split->DataFiles(),
-                                                raw_read_schema_, predicate, deletion_file_map,
-                                                /*row_ranges=*/{}, data_file_path_factory));
-    auto concat_batch_reader =
-        std::make_unique<ConcatBatchReader>(std::move(raw_file_readers), pool_);
+    PAIMON_ASSIGN_OR_RAISE(
+        std::unique_ptr<BatchReader> concat_batch_reader,
+        CreateConcatRawFileReader(data_split->Partition(), data_split->DataFiles(),
+                                  raw_read_schema_, predicate, deletion_vectors,
+                                  /*row_ranges=*/{}, data_file_path_factory));
     PAIMON_ASSIGN_OR_RAISE(std::unique_ptr<BatchReader> batch_reader,
                            ApplyPredicateFilterIfNeeded(std::move(concat_batch_reader), predicate));
     return std::make_unique<CompleteRowKindBatchReader>(std::move(batch_reader), pool_);
 }
 
+Result<std::unique_ptr<BatchReader>> RawFileSplitRead::CreateCompactReader(
+    const BinaryRow& partition, const std::vector<std::shared_ptr<DataFileMeta>>& files,
+    const std::shared_ptr<DataFilePathFactory>& data_file_path_factory) const {
+    PAIMON_ASSIGN_OR_RAISE(std::vector<std::unique_ptr<BatchReader>> raw_file_readers,
+                           CreateRawFileReaders(partition, files, raw_read_schema_,
+                                                /*predicate=*/nullptr, /*deletion_vectors=*/{},
+                                                /*row_ranges=*/{}, data_file_path_factory));
+    return std::make_unique<ConcatBatchReader>(std::move(raw_file_readers), pool_);
+}
+
 Result<bool> RawFileSplitRead::Match(const std::shared_ptr<Split>& split,
                                      bool force_keep_delete) const {
     auto split_impl = dynamic_cast<DataSplitImpl*>(split.get());
@@ -111,8 +119,7 @@ Result<std::unique_ptr<BatchReader>> RawFileSplitRead::ApplyIndexAndDvReaderIfNe
     std::unique_ptr<FileBatchReader>&& file_reader, const std::shared_ptr<DataFileMeta>& file,
     const std::shared_ptr<arrow::Schema>& data_schema,
     const std::shared_ptr<arrow::Schema>& read_schema, const std::shared_ptr<Predicate>& predicate,
-    const std::unordered_map<std::string, DeletionFile>& deletion_file_map,
-    const std::optional<std::vector<Range>>& ranges,
+    const DeletionVectorMap& deletion_vectors, const std::optional<std::vector<Range>>& ranges,
     const std::shared_ptr<DataFilePathFactory>& data_file_path_factory) const {
     std::shared_ptr<FileIndexResult> file_index_result;
     if (options_.FileIndexReadEnabled()) {
@@ -132,14 +139,13 @@ Result<std::unique_ptr<BatchReader>> RawFileSplitRead::ApplyIndexAndDvReaderIfNe
     }
 
     // prepare deletion bitmap for deletion vector
-    PAIMON_UNIQUE_PTR<DeletionVector> deletion_vector;
-    auto dv_iter = deletion_file_map.find(file->file_name);
-    if (dv_iter != deletion_file_map.end()) {
-        PAIMON_ASSIGN_OR_RAISE(deletion_vector, DeletionVector::Read(options_.GetFileSystem().get(),
-                                                                     dv_iter->second, pool_.get()));
+    std::shared_ptr<const DeletionVector> deletion_vector;
+    auto dv_iter = deletion_vectors.find(file->file_name);
+    if (dv_iter != deletion_vectors.end()) {
+        deletion_vector = dv_iter->second;
     }
     const RoaringBitmap32* deletion = nullptr;
-    if (auto* bitmap_dv = dynamic_cast<BitmapDeletionVector*>(deletion_vector.get())) {
+    if (auto* bitmap_dv = dynamic_cast<const BitmapDeletionVector*>(deletion_vector.get())) {
         deletion = bitmap_dv->GetBitmap();
     }
 
@@ -22,6 +22,7 @@
 #include <vector>
 
 #include "paimon/core/core_options.h"
+#include "paimon/core/deletionvectors/deletion_vector_loader.h"
 #include "paimon/core/io/data_file_meta.h"
 #include "paimon/core/operation/abstract_split_read.h"
 #include "paimon/core/schema/schema_manager.h"
@@ -34,6 +35,7 @@ class Schema;
 }
 
 namespace paimon {
+class BinaryRow;
 class DataFilePathFactory;
 class DataSplit;
 class Executor;
@@ -43,7 +45,6 @@ class InternalReadContext;
 class MemoryPool;
 class Predicate;
 struct DataFileMeta;
-struct DeletionFile;
 
 /// If the class name below is enclosed in parentheses, it might be present in the read path;
 /// otherwise, it must be present in the read path.
@@ -69,10 +70,15 @@ class RawFileSplitRead : public AbstractSplitRead {
         std::unique_ptr<FileBatchReader>&& file_reader, const std::shared_ptr<DataFileMeta>& file,
         const std::shared_ptr<arrow::Schema>& data_schema,
         const std::shared_ptr<arrow::Schema>& read_schema,
-        const std::shared_ptr<Predicate>& predicate,
-        const std::unordered_map<std::string, DeletionFile>& deletion_file_map,
+        const std::shared_ptr<Predicate>& predicate, const DeletionVectorMap& deletion_vectors,
         const std::optional<std::vector<Range>>& ranges,
         const std::shared_ptr<DataFilePathFactory>& data_file_path_factory) const override;
+
+    /// Creates a reader which reads `files` one by one for compaction, neither predicates nor
+    /// deletion vectors are applied. The output follows the read schema of the context.
+    Result<std::unique_ptr<BatchReader>> CreateCompactReader(
+        const BinaryRow& partition, const std::vector<std::shared_ptr<DataFileMeta>>& files,
+        const std::shared_ptr<DataFilePathFactory>& data_file_path_factory) const;
 };
 
 }  // namespace paimon
@@ -180,6 +180,11 @@ ReadContextBuilder& ReadContextBuilder::WithMemoryPool(
     return *this;
 }
 
+ReadContextBuilder& ReadContextBuilder::WithMemoryPoolType(MemoryPoolType type) {
+    impl_->memory_pool_ = GetMemoryPool(type);
+    return *this;
+}
+
 ReadContextBuilder& ReadContextBuilder::WithExecutor(const std::shared_ptr<Executor>& executor) {
     impl_->executor_ = executor;
     return *this;
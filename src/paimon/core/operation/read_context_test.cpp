@@ -19,7 +19,9 @@
 #include <utility>
 
 #include "gtest/gtest.h"
+#include "paimon/common/memory/slab_memory_pool.h"
 #include "paimon/defs.h"
+#include "paimon/memory/memory_pool.h"
 #include "paimon/predicate/predicate_builder.h"
 #include "paimon/status.h"
 #include "paimon/testing/mock/mock_file_system.h"
@@ -88,4 +90,16 @@ TEST(ReadContextTest, TestSetContent) {
     ASSERT_EQ(ctx->GetSpecificFileSystem(), fs);
 }
 
+TEST(ReadContextTest, TestMemoryPoolType) {
+    ReadContextBuilder builder("table_root_path");
+    builder.WithMemoryPoolType(MemoryPoolType::SLAB);
+    ASSERT_OK_AND_ASSIGN(auto ctx, builder.Finish());
+    ASSERT_TRUE(std::dynamic_pointer_cast<SlabMemoryPool>(ctx->GetMemoryPool()));
+
+    builder.WithMemoryPoolType(MemoryPoolType::SYSTEM);
+    ASSERT_OK_AND_ASSIGN(ctx, builder.Finish());
+    ASSERT_TRUE(ctx->GetMemoryPool());
+    ASSERT_FALSE(std::dynamic_pointer_cast<SlabMemoryPool>(ctx->GetMemoryPool()));
+}
+
 }  // namespace paimon::test
@@ -119,6 +119,11 @@ WriteContextBuilder& WriteContextBuilder::WithMemoryPool(
     return *this;
 }
 
+WriteContextBuilder& WriteContextBuilder::WithMemoryPoolType(MemoryPoolType type) {
+    impl_->memory_pool_ = GetMemoryPool(type);
+    return *this;
+}
+
 WriteContextBuilder& WriteContextBuilder::WithIgnorePreviousFiles(bool ignore_previous_files) {
     impl_->ignore_previous_files_ = ignore_previous_files;
     return *this;
@@ -17,6 +17,8 @@
 #include "paimon/write_context.h"
 
 #include "gtest/gtest.h"
+#include "paimon/common/memory/slab_memory_pool.h"
+#include "paimon/memory/memory_pool.h"
 #include "paimon/result.h"
 #include "paimon/status.h"
 #include "paimon/testing/utils/testharness.h"
@@ -40,4 +42,16 @@ TEST(WriteContextTest, TestSimple) {
     ASSERT_TRUE(ctx->GetFileSystemSchemeToIdentifierMap().empty());
 }
 
+TEST(WriteContextTest, TestMemoryPoolType) {
+    WriteContextBuilder builder("table_root_path", "commit_user_1");
+    builder.WithMemoryPoolType(MemoryPoolType::SLAB);
+    ASSERT_OK_AND_ASSIGN(auto ctx, builder.Finish());
+    ASSERT_TRUE(std::dynamic_pointer_cast<SlabMemoryPool>(ctx->GetMemoryPool()));
+
+    builder.WithMemoryPoolType(MemoryPoolType::SYSTEM);
+    ASSERT_OK_AND_ASSIGN(ctx, builder.Finish());
+    ASSERT_TRUE(ctx->GetMemoryPool());
+    ASSERT_FALSE(std::dynamic_pointer_cast<SlabMemoryPool>(ctx->GetMemoryPool()));
+}
+
 }  // namespace paimon::test
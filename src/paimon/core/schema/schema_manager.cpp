@@ -17,6 +17,7 @@
 #include "paimon/core/schema/schema_manager.h"
 
 #include <algorithm>
+#include <mutex>
 #include <utility>
 
 #include "paimon/common/utils/path_util.h"
@@ -66,17 +67,21 @@ Result<std::optional<std::shared_ptr<TableSchema>>> SchemaManager::Latest() cons
 }
 
 Result<std::shared_ptr<TableSchema>> SchemaManager::ReadSchema(int64_t schema_id) const {
-    auto iter = schema_cache_.find(schema_id);
-    if (iter != schema_cache_.end()) {
-        return iter->second;
+    {
+        std::lock_guard<std::mutex> lock(cache_mutex_);
+        auto iter = schema_cache_.find(schema_id);
+        if (iter != schema_cache_.end()) {
+            return iter->second;
+        }
     }
+    // schema files are immutable, concurrent loads of the same id are harmless
     auto path = ToSchemaPath(schema_id);
     std::string content;
     PAIMON_RETURN_NOT_OK(file_system_->ReadFile(path, &content));
     PAIMON_ASSIGN_OR_RAISE(std::shared_ptr<TableSchema> schema,
                            TableSchema::CreateFromJson(content));
-    schema_cache_[schema_id] = schema;
-    return schema;
+    std::lock_guard<std::mutex> lock(cache_mutex_);
+    return schema_cache_.emplace(schema_id, schema).first->second;
 }
 
 std::string SchemaManager::SchemaDirectory() const {
@@ -19,6 +19,7 @@
 #include <cstdint>
 #include <map>
 #include <memory>
+#include <mutex>
 #include <optional>
 #include <string>
 #include <vector>
@@ -42,7 +43,7 @@ class SchemaManager {
     SchemaManager(const std::shared_ptr<FileSystem>& file_system, const std::string& table_root,
                   const std::string& branch);
 
-    /// Read schema for schema id. Find schema in cache first.
+    /// Read schema for schema id. Find schema in cache first. Thread-safe.
     Result<std::shared_ptr<TableSchema>> ReadSchema(int64_t schema_id) const;
     Result<std::optional<std::shared_ptr<TableSchema>>> Latest() const;
     Result<std::unique_ptr<TableSchema>> CreateTable(
@@ -66,6 +67,7 @@ class SchemaManager {
     std::shared_ptr<FileSystem> file_system_;
     std::string table_root_;
     const std::string branch_;
+    mutable std::mutex cache_mutex_;
     mutable std::map<int64_t, std::shared_ptr<TableSchema>> schema_cache_;
 };
 
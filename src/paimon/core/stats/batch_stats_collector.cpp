@@ -0,0 +1,335 @@
+/*
+ * Copyright 2024-present Alibaba Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "paimon/core/stats/batch_stats_collector.h"
+
+#include <cassert>
+#include <cmath>
+#include <optional>
+#include <string>
+#include <utility>
+
+#include "arrow/api.h"
+#include "arrow/c/bridge.h"
+#include "arrow/compute/api_aggregate.h"
+#include "arrow/util/checked_cast.h"
+#include "fmt/format.h"
+#include "paimon/common/utils/arrow/status_utils.h"
+#include "paimon/common/utils/date_time_utils.h"
+#include "paimon/data/decimal.h"
+#include "paimon/data/timestamp.h"
+#include "paimon/defs.h"
+#include "paimon/format/column_stats.h"
+
+namespace paimon {
+
+namespace {
+
+Result<std::unique_ptr<ColumnStats>> CreateEmptyStats(
+    const std::shared_ptr<arrow::DataType>& type) {
+    switch (type->id()) {
+        case arrow::Type::BOOL:
+            return ColumnStats::CreateBooleanColumnStats(std::nullopt, std::nullopt, std::nullopt);
+        case arrow::Type::INT8:
+            return ColumnStats::CreateTinyIntColumnStats(std::nullopt, std::nullopt, std::nullopt);
+        case arrow::Type::INT16:
+            return ColumnStats::CreateSmallIntColumnStats(std::nullopt, std::nullopt, std::nullopt);
+        case arrow::Type::INT32:
+            return ColumnStats::CreateIntColumnStats(std::nullopt, std::nullopt, std::nullopt);
+        case arrow::Type::INT64:
+            return ColumnStats::CreateBigIntColumnStats(std::nullopt, std::nullopt, std::nullopt);
+        case arrow::Type::FLOAT:
+            return ColumnStats::CreateFloatColumnStats(std::nullopt, std::nullopt, std::nullopt);
+        case arrow::Type::DOUBLE:
+            return ColumnStats::CreateDoubleColumnStats(std::nullopt, std::nullopt, std::nullopt);
+        case arrow::Type::STRING:
+        case arrow::Type::BINARY:
+            return ColumnStats::CreateStringColumnStats(std::nullopt, std::nullopt, std::nullopt);
+        case arrow::Type::DATE32:
+            return ColumnStats::CreateDateColumnStats(std::nullopt, std::nullopt, std::nullopt);
+        case arrow::Type::TIMESTAMP: {
+            int32_t precision = DateTimeUtils::GetPrecisionFromType(
+                arrow::internal::checked_pointer_cast<arrow::TimestampType>(type));
+            return ColumnStats::CreateTimestampColumnStats(std::nullopt, std::nullopt,
+                                                           std::nullopt, precision);
+        }
+        case arrow::Type::DECIMAL128: {
+            const auto& decimal_type =
+                arrow::internal::checked_cast<const arrow::Decimal128Type&>(*type);
+            return ColumnStats::CreateDecimalColumnStats(std::nullopt, std::nullopt, std::nullopt,
+                                                         decimal_type.precision(),
+                                                         decimal_type.scale());
+        }
+        case arrow::Type::LIST:
+            return ColumnStats::CreateNestedColumnStats(FieldType::ARRAY, std::nullopt);
+        case arrow::Type::MAP:
+            return ColumnStats::CreateNestedColumnStats(FieldType::MAP, std::nullopt);
+        case arrow::Type::STRUCT:
+            return ColumnStats::CreateNestedColumnStats(FieldType::STRUCT, std::nullopt);
+        default:
+            return Status::Invalid(
+                fmt::format("cannot collect statistics, invalid type {}", type->ToString()));
+    }
+}
+
+template <typename StatsType, typename T>
+Status MergeMinMax(const T& min, const T& max, ColumnStats* stats) {
+    auto typed_stats = dynamic_cast<StatsType*>(stats);
+    if (typed_stats == nullptr) {
+        assert(false);
+        return Status::Invalid("cast typed stats failed");
+    }
+    typed_stats->Collect(min);
+    typed_stats->Collect(max);
+    return Status::OK();
+}
+
+template <typename StatsType, typename ScalarType>
+Status MergeScalarMinMax(const arrow::Scalar& min, const arrow::Scalar& max, ColumnStats* stats) {
+    return MergeMinMax<StatsType>(arrow::internal::checked_cast<const ScalarType&>(min).value,
+                                  arrow::internal::checked_cast<const ScalarType&>(max).value,
+                                  stats);
+}
+
+template <typename StatsType, typename ScalarType>
+Status MergeFloatingMinMax(const arrow::Scalar& min, const arrow::Scalar& max,
+                           ColumnStats* stats) {
+    auto min_value = arrow::internal::checked_cast<const ScalarType&>(min).value;
+    auto max_value = arrow::internal::checked_cast<const ScalarType&>(max).value;
+    // the kernel skips NaN, a batch of only NaN leaves min/max at +inf/-inf
+    if (std::isnan(min_value) || std::isnan(max_value) || min_value > max_value) {
+        return Status::OK();
+    }
+    return MergeMinMax<StatsType>(min_value, max_value, stats);
+}
+
+Status MergeBatchMinMax(const arrow::DataType& type, const arrow::Scalar& min,
+                        const arrow::Scalar& max, ColumnStats* stats) {
+    switch (type.id()) {
+        case arrow::Type::BOOL:
+            return MergeScalarMinMax<BooleanColumnStats, arrow::BooleanScalar>(min, max, stats);
+        case arrow::Type::INT8:
+            return MergeScalarMinMax<TinyIntColumnStats, arrow::Int8Scalar>(min, max, stats);
+        case arrow::Type::INT16:
+            return MergeScalarMinMax<SmallIntColumnStats, arrow::Int16Scalar>(min, max, stats);
+        case arrow::Type::INT32:
+            return MergeScalarMinMax<IntColumnStats, arrow::Int32Scalar>(min, max, stats);
+        case arrow::Type::INT64:
+            return MergeScalarMinMax<BigIntColumnStats, arrow::Int64Scalar>(min, max, stats);
+        case arrow::Type::FLOAT:
+            return MergeFloatingMinMax<FloatColumnStats, arrow::FloatScalar>(min, max, stats);
+        case arrow::Type::DOUBLE:
+            return MergeFloatingMinMax<DoubleColumnStats, arrow::DoubleScalar>(min, max, stats);
+        case arrow::Type::DATE32:
+            return MergeScalarMinMax<DateColumnStats, arrow::Date32Scalar>(min, max, stats);
+        case arrow::Type::STRING: {
+            const auto& min_scalar = arrow::internal::checked_cast<const arrow::StringScalar&>(min);
+            const auto& max_scalar = arrow::internal::checked_cast<const arrow::StringScalar&>(max);
+            return MergeMinMax<StringColumnStats>(
+                std::optional<std::string>(min_scalar.value->ToString()),
+                std::optional<std::string>(max_scalar.value->ToString()), stats);
+        }
+        case arrow::Type::TIMESTAMP: {
+            auto src_time_type = DateTimeUtils::GetTimeTypeFromArrowType(
+                arrow::internal::checked_pointer_cast<arrow::TimestampType>(min.type));
+            auto [milli_min, nano_min] = DateTimeUtils::TimestampConverter(
+                arrow::internal::checked_cast<const arrow::TimestampScalar&>(min).value,
+                src_time_type, DateTimeUtils::TimeType::MILLISECOND,
+                DateTimeUtils::TimeType::NANOSECOND);
+            auto [milli_max, nano_max] = DateTimeUtils::TimestampConverter(
+                arrow::internal::checked_cast<const arrow::TimestampScalar&>(max).value,
+                src_time_type, DateTimeUtils::TimeType::MILLISECOND,
+                DateTimeUtils::TimeType::NANOSECOND);
+            return MergeMinMax<TimestampColumnStats>(
+                std::optional<Timestamp>(Timestamp(milli_min, nano_min)),
+                std::optional<Timestamp>(Timestamp(milli_max, nano_max)), stats);
+        }
+        case arrow::Type::DECIMAL128: {
+            const auto& decimal_type =
+                arrow::internal::checked_cast<const arrow::Decimal128Type&>(type);
+            auto to_decimal = [&decimal_type](const arrow::Scalar& scalar) {
+                const auto& value =
+                    arrow::internal::checked_cast<const arrow::Decimal128Scalar&>(scalar).value;
+                return std::optional<Decimal>(Decimal(
+                    decimal_type.precision(), decimal_type.scale(),
+                    static_cast<Decimal::int128_t>(value.high_bits()) << 64 | value.low_bits()));
+            };
+            return MergeMinMax<DecimalColumnStats>(to_decimal(min), to_decimal(max), stats);
+        }
+        default:
+            return Status::Invalid(
+                fmt::format("cannot collect statistics, invalid type {}", type.ToString()));
+    }
+}
+
+bool HasMinMax(arrow::Type::type type) {
+    switch (type) {
+        case arrow::Type::BINARY:
+        case arrow::Type::LIST:
+        case arrow::Type::MAP:
+        case arrow::Type::STRUCT:
+            return false;
+        default:
+            return true;
+    }
+}
+
+template <typename StatsType>
+Result<const StatsType*> CastStats(const std::shared_ptr<ColumnStats>& stats) {
+    auto typed_stats = dynamic_cast<const StatsType*>(stats.get());
+    if (typed_stats == nullptr) {
+        assert(false);
+        return Status::Invalid("cast typed stats failed");
+    }
+    return typed_stats;
+}
+
+template <typename StatsType, typename Creator>
+Result<std::unique_ptr<ColumnStats>> RebuildStats(const std::shared_ptr<ColumnStats>& stats,
+                                                  int64_t null_count, Creator&& creator) {
+    PAIMON_ASSIGN_OR_RAISE(const StatsType* typed_stats, CastStats<StatsType>(stats));
+    return creator(typed_stats->Min(), typed_stats->Max(), null_count);
+}
+
+Result<std::unique_ptr<ColumnStats>> BuildResultStats(const arrow::DataType& type,
+                                                      const std::shared_ptr<ColumnStats>& stats,
+                                                      int64_t null_count) {
+    switch (type.id()) {
+        case arrow::Type::BOOL:
+            return RebuildStats<BooleanColumnStats>(stats, null_count,
+                                                    ColumnStats::CreateBooleanColumnStats);
+        case arrow::Type::INT8:
+            return RebuildStats<TinyIntColumnStats>(stats, null_count,
+                                                    ColumnStats::CreateTinyIntColumnStats);
+        case arrow::Type::INT16:
+            return RebuildStats<SmallIntColumnStats>(stats, null_count,
+                                                     ColumnStats::CreateSmallIntColumnStats);
+        case arrow::Type::INT32:
+            return RebuildStats<IntColumnStats>(stats, null_count,
+                                                ColumnStats::CreateIntColumnStats);
+        case arrow::Type::INT64:
+            return RebuildStats<BigIntColumnStats>(stats, null_count,
+                                                   ColumnStats::CreateBigIntColumnStats);
+        case arrow::Type::FLOAT:
+            return RebuildStats<FloatColumnStats>(stats, null_count,
+                                                  ColumnStats::CreateFloatColumnStats);
+        case arrow::Type::DOUBLE:
+            return RebuildStats<DoubleColumnStats>(stats, null_count,
+                                                   ColumnStats::CreateDoubleColumnStats);
+        case arrow::Type::STRING:
+        case arrow::Type::BINARY:
+            return RebuildStats<StringColumnStats>(stats, null_count,
+                                                   ColumnStats::CreateStringColumnStats);
+        case arrow::Type::DATE32:
+            return RebuildStats<DateColumnStats>(stats, null_count,
+                                                 ColumnStats::CreateDateColumnStats);
+        case arrow::Type::TIMESTAMP: {
+            PAIMON_ASSIGN_OR_RAISE(const TimestampColumnStats* typed_stats,
+                                   CastStats<TimestampColumnStats>(stats));
+            return ColumnStats::CreateTimestampColumnStats(typed_stats->Min(), typed_stats->Max(),
+                                                           null_count,
+                                                           typed_stats->GetPrecision());
+        }
+        case arrow::Type::DECIMAL128: {
+            PAIMON_ASSIGN_OR_RAISE(const DecimalColumnStats* typed_stats,
+                                   CastStats<DecimalColumnStats>(stats));
+            return ColumnStats::CreateDecimalColumnStats(typed_stats->Min(), typed_stats->Max(),
+                                                         null_count, typed_stats->GetPrecision(),
+                                                         typed_stats->GetScale());
+        }
+        case arrow::Type::LIST:
+        case arrow::Type::MAP:
+        case arrow::Type::STRUCT:
+            return ColumnStats::CreateNestedColumnStats(stats->GetFieldType(), null_count);
+        default:
+            return Status::Invalid(
+                fmt::format("cannot collect statistics, invalid type {}", type.ToString()));
+    }
+}
+
+}  // namespace
+
+BatchStatsCollector::BatchStatsCollector(const std::shared_ptr<arrow::Schema>& schema,
+                                         std::vector<std::shared_ptr<ColumnStats>>&& column_stats)
+    : schema_(schema),
+      struct_type_(arrow::struct_(schema->fields())),
+      column_stats_(std::move(column_stats)),
+      null_counts_(column_stats_.size(), 0) {}
+
+Result<std::unique_ptr<BatchStatsCollector>> BatchStatsCollector::Create(
+    const std::shared_ptr<arrow::Schema>& schema) {
+    if (schema == nullptr) {
+        return Status::Invalid("schema of batch stats collector is null pointer");
+    }
+    std::vector<std::shared_ptr<ColumnStats>> column_stats;
+    column_stats.reserve(schema->num_fields());
+    for (const auto& field : schema->fields()) {
+        PAIMON_ASSIGN_OR_RAISE(std::shared_ptr<ColumnStats> stats,
+                               CreateEmptyStats(field->type()));
+        column_stats.push_back(std::move(stats));
+    }
+    return std::unique_ptr<BatchStatsCollector>(
+        new BatchStatsCollector(schema, std::move(column_stats)));
+}
+
+Status BatchStatsCollector::Collect(::ArrowArray* batch) {
+    PAIMON_ASSIGN_OR_RAISE_FROM_ARROW(std::shared_ptr<arrow::Array> array,
+                                      arrow::ImportArray(batch, struct_type_));
+    Status status = Collect(arrow::internal::checked_cast<const arrow::StructArray&>(*array));
+    PAIMON_RETURN_NOT_OK_FROM_ARROW(arrow::ExportArray(*array, batch));
+    return status;
+}
+
+Status BatchStatsCollector::Collect(const arrow::StructArray& batch) {
+    if (batch.num_fields() != static_cast<int32_t>(column_stats_.size())) {
+        return Status::Invalid(fmt::format("fields count {} in batch not equal to {} in schema",
+                                           batch.num_fields(), column_stats_.size()));
+    }
+    arrow::compute::ScalarAggregateOptions min_max_options(/*skip_nulls=*/true, /*min_count=*/1);
+    for (int32_t i = 0; i < batch.num_fields(); ++i) {
+        const std::shared_ptr<arrow::Array>& column = batch.field(i);
+        int64_t null_count = column->null_count();
+        null_counts_[i] += null_count;
+        if (null_count == column->length() || !HasMinMax(column->type_id())) {
+            continue;
+        }
+        PAIMON_ASSIGN_OR_RAISE_FROM_ARROW(arrow::Datum min_max,
+                                          arrow::compute::MinMax(column, min_max_options));
+        const auto& min_max_scalar =
+            arrow::internal::checked_cast<const arrow::StructScalar&>(*min_max.scalar());
+        const std::shared_ptr<arrow::Scalar>& min = min_max_scalar.value[0];
+        const std::shared_ptr<arrow::Scalar>& max = min_max_scalar.value[1];
+        if (!min->is_valid || !max->is_valid) {
+            continue;
+        }
+        PAIMON_RETURN_NOT_OK(MergeBatchMinMax(*column->type(), *min, *max, column_stats_[i].get()));
+    }
+    return Status::OK();
+}
+
+Result<ColumnStatsVector> BatchStatsCollector::GetResult() const {
+    ColumnStatsVector result;
+    result.reserve(column_stats_.size());
+    for (size_t i = 0; i < column_stats_.size(); ++i) {
+        PAIMON_ASSIGN_OR_RAISE(
+            std::shared_ptr<ColumnStats> stats,
+            BuildResultStats(*schema_->field(i)->type(), column_stats_[i], null_counts_[i]));
+        result.push_back(std::move(stats));
+    }
+    return result;
+}
+
+}  // namespace paimon
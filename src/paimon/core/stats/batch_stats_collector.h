@@ -0,0 +1,69 @@
+/*
+ * Copyright 2024-present Alibaba Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "arrow/c/abi.h"
+#include "paimon/result.h"
+#include "paimon/status.h"
+#include "paimon/type_fwd.h"
+
+namespace arrow {
+class DataType;
+class Schema;
+class StructArray;
+}  // namespace arrow
+
+namespace paimon {
+
+class ColumnStats;
+
+/// Collects min/max/null count of every column from the batches passing through a data file
+/// writer, so that the stats of a file are known as soon as it is closed and the file does not
+/// need to be opened again.
+///
+/// Min/max of a batch are computed with the arrow `min_max` kernel and merged into the stats of
+/// previous batches. The result follows `ParquetStatsExtractor`: binary columns only track null
+/// count and nested columns track nothing.
+class BatchStatsCollector {
+ public:
+    static Result<std::unique_ptr<BatchStatsCollector>> Create(
+        const std::shared_ptr<arrow::Schema>& schema);
+
+    /// Collects `batch`, a struct array of the schema. The batch is imported and exported back in
+    /// place, so the caller still owns it afterwards.
+    Status Collect(::ArrowArray* batch);
+    Status Collect(const arrow::StructArray& batch);
+
+    Result<ColumnStatsVector> GetResult() const;
+
+ private:
+    BatchStatsCollector(const std::shared_ptr<arrow::Schema>& schema,
+                        std::vector<std::shared_ptr<ColumnStats>>&& column_stats);
+
+ private:
+    std::shared_ptr<arrow::Schema> schema_;
+    std::shared_ptr<arrow::DataType> struct_type_;
+    // holds the merged min/max of each column, null counts are tracked separately
+    std::vector<std::shared_ptr<ColumnStats>> column_stats_;
+    std::vector<int64_t> null_counts_;
+};
+
+}  // namespace paimon
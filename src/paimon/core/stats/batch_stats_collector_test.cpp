@@ -0,0 +1,188 @@
+/*
+ * Copyright 2024-present Alibaba Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "paimon/core/stats/batch_stats_collector.h"
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "arrow/api.h"
+#include "arrow/c/abi.h"
+#include "arrow/c/bridge.h"
+#include "arrow/c/helpers.h"
+#include "arrow/ipc/api.h"
+#include "arrow/util/checked_cast.h"
+#include "gtest/gtest.h"
+#include "paimon/data/timestamp.h"
+#include "paimon/format/column_stats.h"
+#include "paimon/testing/utils/testharness.h"
+
+namespace paimon::test {
+
+class BatchStatsCollectorTest : public ::testing::Test {
+ public:
+    void CollectBatches(BatchStatsCollector* collector, const arrow::FieldVector& fields,
+                        const std::vector<std::string>& batches) const {
+        auto struct_type = arrow::struct_(fields);
+        for (const auto& batch : batches) {
+            auto array = arrow::ipc::internal::json::ArrayFromJSON(struct_type, batch).ValueOrDie();
+            ASSERT_OK(collector->Collect(arrow::internal::checked_cast<const arrow::StructArray&>(
+                *array)));
+        }
+    }
+
+    void CheckStats(const arrow::FieldVector& fields, const std::vector<std::string>& batches,
+                    const std::vector<std::string>& expected_stats) const {
+        ASSERT_OK_AND_ASSIGN(std::unique_ptr<BatchStatsCollector> collector,
+                             BatchStatsCollector::Create(arrow::schema(fields)));
+        CollectBatches(collector.get(), fields, batches);
+        ASSERT_OK_AND_ASSIGN(ColumnStatsVector col_stats_vec, collector->GetResult());
+        ASSERT_EQ(expected_stats.size(), col_stats_vec.size());
+        for (size_t i = 0; i < expected_stats.size(); i++) {
+            ASSERT_EQ(expected_stats[i], col_stats_vec[i]->ToString()) << "column " << i;
+        }
+    }
+};
+
+TEST_F(BatchStatsCollectorTest, TestSimpleType) {
+    arrow::FieldVector fields = {
+        arrow::field("f0", arrow::boolean()),       arrow::field("f1", arrow::int8()),
+        arrow::field("f2", arrow::int16()),         arrow::field("f3", arrow::int32()),
+        arrow::field("field_null", arrow::int32()), arrow::field("f4", arrow::int64()),
+        arrow::field("f5", arrow::float32()),       arrow::field("f6", arrow::float64()),
+        arrow::field("f7", arrow::utf8()),          arrow::field("f8", arrow::binary()),
+        arrow::field("f9", arrow::date32())};
+    std::vector<std::string> batches = {
+        R"([
+        [true, 0, 32767, 2147483647, null, 4294967295, 0.5, 1.141592659, "20250327", "banana", 1],
+        [false, 1, 32767, null, null, 4294967296, 1.0, 2.141592658, "20250327", "dog", 20]
+    ])",
+        R"([
+        [null, 1, 32767, 2147483647, null, null, 2.1, 3.141592657, null, "lucy", null],
+        [true, -2, -32768, -2147483648, null, -4294967298, 2.0, 3.141592657, "20250326", null, 5]
+    ])"};
+    std::vector<std::string> expected_stats = {
+        "min false, max true, null count 1",
+        "min -2, max 1, null count 0",
+        "min -32768, max 32767, null count 0",
+        "min -2147483648, max 2147483647, null count 1",
+        "min null, max null, null count 4",
+        "min -4294967298, max 4294967296, null count 1",
+        "min 0.5, max 2.1, null count 0",
+        "min 1.141592659, max 3.141592657, null count 0",
+        "min 20250326, max 20250327, null count 1",
+        "min null, max null, null count 1",
+        "min 1, max 20, null count 1",
+    };
+    CheckStats(fields, batches, expected_stats);
+}
+
+TEST_F(BatchStatsCollectorTest, TestNaNAndAllNullBatch) {
+    arrow::FieldVector fields = {arrow::field("f0", arrow::float64()),
+                                 arrow::field("f1", arrow::int32())};
+    std::vector<std::string> batches = {R"([[NaN, null], [NaN, null]])", R"([[1.5, 3], [null, 2]])",
+                                        R"([[NaN, null]])"};
+    std::vector<std::string> expected_stats = {
+        "min 1.5, max 1.5, null count 1",
+        "min 2, max 3, null count 3",
+    };
+    CheckStats(fields, batches, expected_stats);
+}
+
+TEST_F(BatchStatsCollectorTest, TestNestedAndDecimal) {
+    arrow::FieldVector fields = {
+        arrow::field("col0", arrow::struct_({arrow::field("col2", arrow::boolean()),
+                                             arrow::field("col3", arrow::int64())})),
+        arrow::field("col1", arrow::list(arrow::int32())),
+        arrow::field("col2", arrow::decimal128(23, 2)),
+    };
+    std::vector<std::string> batches = {
+        R"([[[true, 0], [1, 2], "0.28"], [null, null, "1234567890123456.00"]])",
+        R"([[[false, 2], [3], "0.22"]])"};
+    std::vector<std::string> expected_stats = {
+        "min null, max null, null count 1",
+        "min null, max null, null count 1",
+        "min 0.22, max 1234567890123456.00, null count 0",
+    };
+    CheckStats(fields, batches, expected_stats);
+}
+
+TEST_F(BatchStatsCollectorTest, TestTimestamp) {
+    arrow::FieldVector fields = {arrow::field("f0", arrow::timestamp(arrow::TimeUnit::NANO)),
+                                 arrow::field("f1", arrow::timestamp(arrow::TimeUnit::SECOND))};
+    ASSERT_OK_AND_ASSIGN(std::unique_ptr<BatchStatsCollector> collector,
+                         BatchStatsCollector::Create(arrow::schema(fields)));
+    CollectBatches(collector.get(), fields,
+                   {R"([["1970-01-01 00:00:00.001000001", "1970-01-01 00:00:02"]])",
+                    R"([["1970-01-01 00:00:00.000000005", null]])"});
+    ASSERT_OK_AND_ASSIGN(ColumnStatsVector col_stats_vec, collector->GetResult());
+    ASSERT_EQ(2, col_stats_vec.size());
+
+    auto nano_stats = dynamic_cast<TimestampColumnStats*>(col_stats_vec[0].get());
+    ASSERT_TRUE(nano_stats);
+    ASSERT_EQ(Timestamp::MAX_PRECISION, nano_stats->GetPrecision());
+    ASSERT_EQ(Timestamp(0, 5), nano_stats->Min().value());
+    ASSERT_EQ(Timestamp(1, 1), nano_stats->Max().value());
+    ASSERT_EQ(0, nano_stats->NullCount().value());
+
+    auto second_stats = dynamic_cast<TimestampColumnStats*>(col_stats_vec[1].get());
+    ASSERT_TRUE(second_stats);
+    ASSERT_EQ(Timestamp::MIN_PRECISION, second_stats->GetPrecision());
+    ASSERT_EQ(Timestamp(2000, 0), second_stats->Min().value());
+    ASSERT_EQ(Timestamp(2000, 0), second_stats->Max().value());
+    ASSERT_EQ(1, second_stats->NullCount().value());
+}
+
+TEST_F(BatchStatsCollectorTest, TestCollectKeepsArrowArray) {
+    arrow::FieldVector fields = {arrow::field("f0", arrow::int32()),
+                                 arrow::field("f1", arrow::utf8())};
+    auto struct_type = arrow::struct_(fields);
+    auto array = arrow::ipc::internal::json::ArrayFromJSON(struct_type,
+                                                           R"([[3, "b"], [1, "a"], [null, "c"]])")
+                     .ValueOrDie();
+    ::ArrowArray c_array;
+    ASSERT_TRUE(arrow::ExportArray(*array, &c_array).ok());
+
+    ASSERT_OK_AND_ASSIGN(std::unique_ptr<BatchStatsCollector> collector,
+                         BatchStatsCollector::Create(arrow::schema(fields)));
+    ASSERT_OK(collector->Collect(&c_array));
+    // the batch is still owned by caller and readable after collecting
+    ASSERT_FALSE(ArrowArrayIsReleased(&c_array));
+    auto imported = arrow::ImportArray(&c_array, struct_type).ValueOrDie();
+    ASSERT_TRUE(imported->Equals(*array));
+
+    ASSERT_OK_AND_ASSIGN(ColumnStatsVector col_stats_vec, collector->GetResult());
+    ASSERT_EQ("min 1, max 3, null count 1", col_stats_vec[0]->ToString());
+    ASSERT_EQ("min a, max c, null count 0", col_stats_vec[1]->ToString());
+}
+
+TEST_F(BatchStatsCollectorTest, TestInvalid) {
+    ASSERT_NOK(BatchStatsCollector::Create(arrow::schema({arrow::field("f0", arrow::uint32())})));
+
+    arrow::FieldVector fields = {arrow::field("f0", arrow::int32())};
+    ASSERT_OK_AND_ASSIGN(std::unique_ptr<BatchStatsCollector> collector,
+                         BatchStatsCollector::Create(arrow::schema(fields)));
+    auto array = arrow::ipc::internal::json::ArrayFromJSON(
+                     arrow::struct_({arrow::field("f0", arrow::int32()),
+                                     arrow::field("f1", arrow::int32())}),
+                     R"([[1, 2]])")
+                     .ValueOrDie();
+    ASSERT_NOK(
+        collector->Collect(arrow::internal::checked_cast<const arrow::StructArray&>(*array)));
+}
+
+}  // namespace paimon::test
@@ -37,10 +37,10 @@ AppendOnlyTableRead::AppendOnlyTableRead(const std::shared_ptr<FileStorePathFact
     if (core_options.DataEvolutionEnabled()) {
         // add data evolution first
         split_reads_.push_back(
-            std::make_unique<DataEvolutionSplitRead>(path_factory, context, memory_pool, executor));
+            std::make_shared<DataEvolutionSplitRead>(path_factory, context, memory_pool, executor));
     } else {
         split_reads_.push_back(
-            std::make_unique<RawFileSplitRead>(path_factory, context, memory_pool, executor));
+            std::make_shared<RawFileSplitRead>(path_factory, context, memory_pool, executor));
     }
 }
 
@@ -45,7 +45,7 @@ class AppendOnlyTableRead : public TableRead {
         const std::shared_ptr<Split>& data_split) override;
 
  private:
-    std::vector<std::unique_ptr<SplitRead>> split_reads_;
+    std::vector<std::shared_ptr<SplitRead>> split_reads_;
 };
 
 }  // namespace paimon
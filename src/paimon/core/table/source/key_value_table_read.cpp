@@ -29,7 +29,7 @@ class FileStorePathFactory;
 class InternalReadContext;
 class MemoryPool;
 
-KeyValueTableRead::KeyValueTableRead(std::vector<std::unique_ptr<SplitRead>>&& split_reads,
+KeyValueTableRead::KeyValueTableRead(std::vector<std::shared_ptr<SplitRead>>&& split_reads,
                                      const std::shared_ptr<MemoryPool>& memory_pool)
     : TableRead(memory_pool), split_reads_(std::move(split_reads)) {}
 
@@ -38,8 +38,8 @@ Result<std::unique_ptr<TableRead>> KeyValueTableRead::Create(
     const std::shared_ptr<InternalReadContext>& context,
     const std::shared_ptr<MemoryPool>& memory_pool, const std::shared_ptr<Executor>& executor) {
     auto raw_file_split_read =
-        std::make_unique<RawFileSplitRead>(path_factory, context, memory_pool, executor);
-    std::vector<std::unique_ptr<SplitRead>> split_reads;
+        std::make_shared<RawFileSplitRead>(path_factory, context, memory_pool, executor);
+    std::vector<std::shared_ptr<SplitRead>> split_reads;
     split_reads.emplace_back(std::move(raw_file_split_read));
     PAIMON_ASSIGN_OR_RAISE(
         std::unique_ptr<MergeFileSplitRead> merge_file_split_read,
@@ -43,10 +43,10 @@ class KeyValueTableRead : public TableRead {
     Result<std::unique_ptr<BatchReader>> CreateReader(const std::shared_ptr<Split>& split) override;
 
  private:
-    KeyValueTableRead(std::vector<std::unique_ptr<SplitRead>>&& split_reads,
+    KeyValueTableRead(std::vector<std::shared_ptr<SplitRead>>&& split_reads,
                       const std::shared_ptr<MemoryPool>& memory_pool);
 
-    std::vector<std::unique_ptr<SplitRead>> split_reads_;
+    std::vector<std::shared_ptr<SplitRead>> split_reads_;
     bool force_keep_delete_ = false;
 };
 
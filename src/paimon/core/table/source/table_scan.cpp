@@ -51,6 +51,7 @@
 #include "paimon/core/utils/fields_comparator.h"
 #include "paimon/core/utils/file_store_path_factory.h"
 #include "paimon/core/utils/index_file_path_factories.h"
+#include "paimon/core/utils/objects_cache.h"
 #include "paimon/core/utils/snapshot_manager.h"
 #include "paimon/format/file_format.h"
 #include "paimon/result.h"
@@ -78,10 +79,14 @@ class TableScanImpl {
         auto snapshot_manager = std::make_shared<SnapshotManager>(fs, context->GetPath());
         // TODO(liancheng.lsz): support fallback branch in scan
         auto schema_manager = std::make_shared<SchemaManager>(fs, context->GetPath());
+        auto manifest_cache = ObjectsCache::GetGlobal(core_options.GetManifestCacheMaxMemorySize());
+        // cached manifests outlive this scan, decode them with the pool of the cache
+        auto manifest_pool = manifest_cache ? ObjectsCache::GetPool() : memory_pool;
         PAIMON_ASSIGN_OR_RAISE(
             std::shared_ptr<ManifestList> manifest_list,
             ManifestList::Create(fs, manifest_file_format, core_options.GetManifestCompression(),
-                                 path_factory, memory_pool));
+                                 path_factory, manifest_pool));
+        manifest_list->SetCache(manifest_cache);
         PAIMON_ASSIGN_OR_RAISE(
             std::shared_ptr<arrow::Schema> partition_schema,
             FieldMapping::GetPartitionSchema(arrow_schema, table_schema->PartitionKeys()));
@@ -89,7 +94,8 @@ class TableScanImpl {
             std::shared_ptr<ManifestFile> manifest_file,
             ManifestFile::Create(fs, manifest_file_format, core_options.GetManifestCompression(),
                                  path_factory, core_options.GetManifestTargetFileSize(),
-                                 memory_pool, core_options, partition_schema));
+                                 manifest_pool, core_options, partition_schema));
+        manifest_file->SetCache(manifest_cache);
         if (table_schema->PrimaryKeys().empty()) {
             if (core_options.DataEvolutionEnabled()) {
                 return DataEvolutionFileStoreScan::Create(
@@ -139,11 +145,15 @@ class TableScanImpl {
     static Result<std::unique_ptr<IndexFileHandler>> CreateIndexFileHandler(
         const CoreOptions& core_options, const std::shared_ptr<FileStorePathFactory>& path_factory,
         const std::shared_ptr<MemoryPool>& memory_pool) {
-        PAIMON_ASSIGN_OR_RAISE(std::unique_ptr<IndexManifestFile> index_manifest_file,
-                               IndexManifestFile::Create(core_options.GetFileSystem(),
-                                                         core_options.GetManifestFormat(),
-                                                         core_options.GetManifestCompression(),
-                                                         path_factory, memory_pool, core_options));
+        auto manifest_cache = ObjectsCache::GetGlobal(core_options.GetManifestCacheMaxMemorySize());
+        auto manifest_pool = manifest_cache ? ObjectsCache::GetPool() : memory_pool;
+        PAIMON_ASSIGN_OR_RAISE(
+            std::unique_ptr<IndexManifestFile> index_manifest_file,
+            IndexManifestFile::Create(core_options.GetFileSystem(),
+                                      core_options.GetManifestFormat(),
+                                      core_options.GetManifestCompression(), path_factory,
+                                      manifest_pool, core_options));
+        index_manifest_file->SetCache(manifest_cache);
         return std::make_unique<IndexFileHandler>(
             std::move(index_manifest_file), std::make_shared<IndexFilePathFactories>(path_factory));
     }
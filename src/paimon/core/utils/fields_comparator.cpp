@@ -16,13 +16,20 @@
 
 #include "paimon/core/utils/fields_comparator.h"
 
+#include <algorithm>
 #include <cstddef>
 #include <string>
+#include <string_view>
+#include <type_traits>
+#include <typeinfo>
 
 #include "arrow/api.h"
 #include "arrow/util/checked_cast.h"
+#include "arrow/util/macros.h"
 #include "fmt/format.h"
 #include "paimon/common/data/binary_string.h"
+#include "paimon/common/data/columnar/columnar_row.h"
+#include "paimon/common/data/columnar/columnar_utils.h"
 #include "paimon/common/types/data_field.h"
 #include "paimon/common/utils/date_time_utils.h"
 #include "paimon/data/decimal.h"
@@ -31,6 +38,50 @@
 #include "paimon/status.h"
 
 namespace paimon {
+namespace {
+template <typename ArrowType>
+auto GetColumnarValue(const arrow::Array* array, int64_t row_id) {
+    if constexpr (std::is_same_v<ArrowType, arrow::StringType>) {
+        if (ARROW_PREDICT_TRUE(array->type_id() == arrow::Type::type::STRING)) {
+            return static_cast<const arrow::StringArray*>(array)->GetView(row_id);
+        }
+        // dictionary encoded strings
+        return ColumnarUtils::GetView(array, row_id);
+    } else {
+        using ArrayType = typename arrow::TypeTraits<ArrowType>::ArrayType;
+        return static_cast<const ArrayType*>(array)->Value(row_id);
+    }
+}
+
+/// Compares the sort fields of `ColumnarRow`s with the same semantics as
+/// `FieldsComparator::CompareTo`: null is first in both ascending and descending order.
+template <typename ArrowType, typename... Rest>
+int32_t CompareColumnarFields(const int32_t* sort_fields, const ColumnarRow& lhs,
+                              const ColumnarRow& rhs, bool is_ascending_order) {
+    const arrow::Array* lhs_array = lhs.GetFieldArray(sort_fields[0]);
+    const arrow::Array* rhs_array = rhs.GetFieldArray(sort_fields[0]);
+    bool lhs_null = lhs_array->IsNull(lhs.GetRowId());
+    bool rhs_null = rhs_array->IsNull(rhs.GetRowId());
+    int32_t cmp = 0;
+    if (lhs_null || rhs_null) {
+        cmp = lhs_null == rhs_null ? 0 : (lhs_null ? -1 : 1);
+    } else {
+        auto lvalue = GetColumnarValue<ArrowType>(lhs_array, lhs.GetRowId());
+        auto rvalue = GetColumnarValue<ArrowType>(rhs_array, rhs.GetRowId());
+        cmp = lvalue == rvalue ? 0 : (lvalue < rvalue ? -1 : 1);
+        cmp = is_ascending_order ? cmp : -cmp;
+    }
+    if constexpr (sizeof...(Rest) == 0) {
+        return cmp;
+    } else {
+        if (cmp != 0) {
+            return cmp;
+        }
+        return CompareColumnarFields<Rest...>(sort_fields + 1, lhs, rhs, is_ascending_order);
+    }
+}
+}  // namespace
+
 Result<std::unique_ptr<FieldsComparator>> FieldsComparator::Create(
     const std::vector<DataField>& input_data_field, bool is_ascending_order, bool use_view) {
     std::vector<int32_t> sort_fields;
@@ -52,11 +103,74 @@ Result<std::unique_ptr<FieldsComparator>> FieldsComparator::Create(
                                CompareField(sort_field_idx, type, use_view));
         comparators.emplace_back(cmp);
     }
-    return std::unique_ptr<FieldsComparator>(
-        new FieldsComparator(is_ascending_order, sort_fields, std::move(comparators)));
+    // the normalized key covers the leading sort fields until the 8 bytes are used up, an
+    // unsupported field is met or a variable-width field is encoded
+    std::vector<NormalizedKeyField> normalized_key_fields;
+    bool normalized_key_is_full = true;
+    int32_t normalized_key_bytes = 0;
+    for (const auto& sort_field_idx : sort_fields) {
+        const auto& field = input_data_field[sort_field_idx];
+        arrow::Type::type type = field.Type()->id();
+        int32_t width = NormalizedKeyWidth(type, use_view);
+        if (width == 0 || normalized_key_bytes >= NORMALIZED_KEY_BYTES) {
+            normalized_key_is_full = false;
+            break;
+        }
+        normalized_key_fields.push_back({sort_field_idx, type, field.Nullable()});
+        if (width < 0) {
+            normalized_key_is_full = false;
+            break;
+        }
+        normalized_key_bytes += (field.Nullable() ? 1 : 0) + width;
+        if (normalized_key_bytes > NORMALIZED_KEY_BYTES) {
+            normalized_key_is_full = false;
+            break;
+        }
+    }
+    normalized_key_is_full = normalized_key_is_full && !normalized_key_fields.empty();
+    auto comparator = std::unique_ptr<FieldsComparator>(new FieldsComparator(
+        is_ascending_order, sort_fields, std::move(comparators), std::move(normalized_key_fields),
+        normalized_key_is_full));
+    comparator->columnar_compare_func_ =
+        SelectColumnarCompareFunc(input_data_field, sort_fields, use_view);
+    return comparator;
+}
+
+FieldsComparator::ColumnarCompareFunc FieldsComparator::SelectColumnarCompareFunc(
+    const std::vector<DataField>& input_data_field, const std::vector<int32_t>& sort_fields,
+    bool use_view) {
+    std::vector<arrow::Type::type> types;
+    types.reserve(sort_fields.size());
+    for (const auto& sort_field_idx : sort_fields) {
+        types.push_back(input_data_field[sort_field_idx].Type()->id());
+    }
+    using Type = arrow::Type::type;
+    if (types == std::vector<Type>({Type::INT32})) {
+        return &CompareColumnar<arrow::Int32Type>;
+    } else if (types == std::vector<Type>({Type::INT64})) {
+        return &CompareColumnar<arrow::Int64Type>;
+    } else if (types == std::vector<Type>({Type::STRING}) && use_view) {
+        return &CompareColumnar<arrow::StringType>;
+    } else if (types == std::vector<Type>({Type::INT32, Type::INT64})) {
+        return &CompareColumnar<arrow::Int32Type, arrow::Int64Type>;
+    }
+    return nullptr;
+}
+
+template <typename... ArrowTypes>
+int32_t FieldsComparator::CompareColumnar(const FieldsComparator& comparator,
+                                          const InternalRow& lhs, const InternalRow& rhs) {
+    if (typeid(lhs) != typeid(ColumnarRow) || typeid(rhs) != typeid(ColumnarRow)) {
+        return comparator.CompareFieldByField(lhs, rhs);
+    }
+    return CompareColumnarFields<ArrowTypes...>(comparator.sort_fields_.data(),
+                                                static_cast<const ColumnarRow&>(lhs),
+                                                static_cast<const ColumnarRow&>(rhs),
+                                                comparator.is_ascending_order_);
 }
 
-int32_t FieldsComparator::CompareTo(const InternalRow& lhs, const InternalRow& rhs) const {
+int32_t FieldsComparator::CompareFieldByField(const InternalRow& lhs,
+                                              const InternalRow& rhs) const {
     // in default comparator, null is first (not smallest)
     int32_t null_is_last_ret = -1;
     for (size_t i = 0; i < sort_fields_.size(); i++) {
@@ -78,6 +192,97 @@ int32_t FieldsComparator::CompareTo(const InternalRow& lhs, const InternalRow& r
     return 0;
 }
 
+uint64_t FieldsComparator::NormalizedKey(const InternalRow& row) const {
+    assert(HasNormalizedKey());
+    uint64_t key = 0;
+    int32_t remaining = NORMALIZED_KEY_BYTES;
+    // appends the highest bytes of the `width` bytes of `bits` that still fit into the key
+    auto append = [&key, &remaining](uint64_t bits, int32_t width) {
+        int32_t num_bytes = std::min(width, remaining);
+        if (num_bytes == 0) {
+            return;
+        }
+        bits >>= 8 * (width - num_bytes);
+        key = num_bytes == NORMALIZED_KEY_BYTES ? bits : (key << (8 * num_bytes)) | bits;
+        remaining -= num_bytes;
+    };
+    for (const auto& field : normalized_key_fields_) {
+        // null is first in both ascending and descending order, see CompareTo
+        bool is_null = field.nullable && row.IsNullAt(field.field_idx);
+        if (field.nullable) {
+            append(is_null ? 0 : 1, /*width=*/1);
+        }
+        if (field.type == arrow::Type::type::STRING || field.type == arrow::Type::type::BINARY) {
+            // strings are compared byte-wise unsigned, missing bytes are padded as 0, so that
+            // a shorter string never compares larger than a longer string with the same prefix
+            if (!is_null) {
+                std::string_view view = row.GetStringView(field.field_idx);
+                for (size_t i = 0; remaining > 0; ++i) {
+                    auto byte = static_cast<uint8_t>(i < view.size() ? view[i] : 0);
+                    append(is_ascending_order_ ? byte : static_cast<uint8_t>(~byte),
+                           /*width=*/1);
+                }
+            }
+            break;
+        }
+        int32_t width = NormalizedKeyWidth(field.type, /*use_view=*/true);
+        uint64_t bits = 0;
+        if (!is_null) {
+            switch (field.type) {
+                case arrow::Type::type::BOOL:
+                    bits = row.GetBoolean(field.field_idx) ? 1 : 0;
+                    break;
+                case arrow::Type::type::INT8:
+                    bits = static_cast<uint8_t>(row.GetByte(field.field_idx)) ^ 0x80u;
+                    break;
+                case arrow::Type::type::INT16:
+                    bits = static_cast<uint16_t>(row.GetShort(field.field_idx)) ^ 0x8000u;
+                    break;
+                case arrow::Type::type::INT32:
+                    bits = static_cast<uint32_t>(row.GetInt(field.field_idx)) ^ 0x80000000u;
+                    break;
+                case arrow::Type::type::DATE32:
+                    bits = static_cast<uint32_t>(row.GetDate(field.field_idx)) ^ 0x80000000u;
+                    break;
+                case arrow::Type::type::INT64:
+                    bits = static_cast<uint64_t>(row.GetLong(field.field_idx)) ^ (1ull << 63);
+                    break;
+                default:
+                    assert(false);
+            }
+            if (!is_ascending_order_) {
+                bits ^= width == NORMALIZED_KEY_BYTES ? ~0ull : (1ull << (8 * width)) - 1;
+            }
+        }
+        append(bits, width);
+        if (remaining == 0) {
+            break;
+        }
+    }
+    return remaining == NORMALIZED_KEY_BYTES ? 0 : key << (8 * remaining);
+}
+
+int32_t FieldsComparator::NormalizedKeyWidth(arrow::Type::type type, bool use_view) {
+    switch (type) {
+        case arrow::Type::type::BOOL:
+        case arrow::Type::type::INT8:
+            return 1;
+        case arrow::Type::type::INT16:
+            return 2;
+        case arrow::Type::type::INT32:
+        case arrow::Type::type::DATE32:
+            return 4;
+        case arrow::Type::type::INT64:
+            return 8;
+        case arrow::Type::type::STRING:
+        case arrow::Type::type::BINARY:
+            // strings are only normalized if they can be accessed without copy
+            return use_view ? -1 : 0;
+        default:
+            return 0;
+    }
+}
+
 Result<FieldsComparator::FieldComparatorFunc> FieldsComparator::CompareField(
     int32_t field_idx, const std::shared_ptr<arrow::DataType>& input_type, bool use_view) {
     arrow::Type::type type = input_type->id();
@@ -45,7 +45,44 @@ class FieldsComparator {
         const std::vector<DataField>& input_data_field, const std::vector<int32_t>& sort_fields,
         bool is_ascending_order, bool use_view);
 
-    int32_t CompareTo(const InternalRow& lhs, const InternalRow& rhs) const;
+    /// Compares rows by the sort fields. For frequent primary key shapes (a single INT, BIGINT or
+    /// STRING field, or an (INT, BIGINT) composite), a specialized comparison is selected on
+    /// creation, which reads the arrow buffers directly if both rows are `ColumnarRow`s.
+    int32_t CompareTo(const InternalRow& lhs, const InternalRow& rhs) const {
+        if (columnar_compare_func_ != nullptr) {
+            return columnar_compare_func_(*this, lhs, rhs);
+        }
+        return CompareFieldByField(lhs, rhs);
+    }
+
+    /// Compares rows by their normalized keys (see `NormalizedKey`) first, the rows are only
+    /// compared field by field if the normalized keys are equal but not full.
+    int32_t CompareTo(uint64_t lhs_normalized_key, const InternalRow& lhs,
+                      uint64_t rhs_normalized_key, const InternalRow& rhs) const {
+        if (lhs_normalized_key != rhs_normalized_key) {
+            return lhs_normalized_key < rhs_normalized_key ? -1 : 1;
+        }
+        return normalized_key_is_full_ ? 0 : CompareTo(lhs, rhs);
+    }
+
+    /// Whether the leading sort fields can be encoded into a normalized key, i.e. the first sort
+    /// field is a boolean, integral, date, string or binary (with view) field.
+    bool HasNormalizedKey() const {
+        return !normalized_key_fields_.empty();
+    }
+
+    /// Whether equal normalized keys imply equal rows, which is the case if all sort fields are
+    /// fixed-width fields encoded into the normalized key without truncation.
+    bool NormalizedKeyIsFull() const {
+        return normalized_key_is_full_;
+    }
+
+    /// Encodes the leading sort fields of `row` into an unsigned integer whose order is consistent
+    /// with `CompareTo`: each field is encoded as a null flag (omitted for non-nullable fields)
+    /// and big-endian value bytes with the sign bit flipped (inverted for descending order),
+    /// fields and strings beyond 8 bytes are truncated. Must only be called if
+    /// `HasNormalizedKey()`.
+    uint64_t NormalizedKey(const InternalRow& row) const;
 
     const std::vector<int32_t>& CompareFields() const {
         return sort_fields_;
@@ -54,20 +91,56 @@ class FieldsComparator {
  private:
     using FieldComparatorFunc =
         std::function<int32_t(const InternalRow& lhs, const InternalRow& rhs)>;
+    using ColumnarCompareFunc = int32_t (*)(const FieldsComparator& comparator,
+                                            const InternalRow& lhs, const InternalRow& rhs);
+
+    struct NormalizedKeyField {
+        int32_t field_idx;
+        arrow::Type::type type;
+        bool nullable;
+    };
+
     FieldsComparator(bool is_ascending_order, const std::vector<int32_t>& sort_fields,
-                     std::vector<FieldComparatorFunc>&& comparators)
+                     std::vector<FieldComparatorFunc>&& comparators,
+                     std::vector<NormalizedKeyField>&& normalized_key_fields,
+                     bool normalized_key_is_full)
         : is_ascending_order_(is_ascending_order),
           sort_fields_(sort_fields),
-          comparators_(std::move(comparators)) {
+          comparators_(std::move(comparators)),
+          normalized_key_fields_(std::move(normalized_key_fields)),
+          normalized_key_is_full_(normalized_key_is_full) {
         assert(comparators_.size() == sort_fields_.size());
     }
 
+    int32_t CompareFieldByField(const InternalRow& lhs, const InternalRow& rhs) const;
+
+    /// Compares `ColumnarRow`s whose sort fields are of `ArrowTypes` by reading the arrow arrays
+    /// directly, other rows are compared field by field.
+    template <typename... ArrowTypes>
+    static int32_t CompareColumnar(const FieldsComparator& comparator, const InternalRow& lhs,
+                                   const InternalRow& rhs);
+
+    /// Returns the specialized comparison of the sort fields, nullptr if the key shape has no
+    /// specialization.
+    static ColumnarCompareFunc SelectColumnarCompareFunc(
+        const std::vector<DataField>& input_data_field, const std::vector<int32_t>& sort_fields,
+        bool use_view);
+
     static Result<FieldComparatorFunc> CompareField(
         int32_t field_idx, const std::shared_ptr<arrow::DataType>& input_type, bool use_view);
 
+    /// number of value bytes of a fixed-width field in normalized key, -1 for variable-width
+    /// fields, 0 for fields not supported by normalized key
+    static int32_t NormalizedKeyWidth(arrow::Type::type type, bool use_view);
+
+    static constexpr int32_t NORMALIZED_KEY_BYTES = sizeof(uint64_t);
+
  private:
     bool is_ascending_order_;
     std::vector<int32_t> sort_fields_;
     std::vector<FieldComparatorFunc> comparators_;
+    std::vector<NormalizedKeyField> normalized_key_fields_;
+    bool normalized_key_is_full_;
+    ColumnarCompareFunc columnar_compare_func_ = nullptr;
 };
 }  // namespace paimon
@@ -17,12 +17,16 @@
 #include "paimon/core/utils/fields_comparator.h"
 
 #include <cstddef>
+#include <limits>
+#include <random>
 #include <string>
 #include <variant>
 
 #include "arrow/api.h"
+#include "arrow/ipc/json_simple.h"
 #include "gtest/gtest.h"
 #include "paimon/common/data/binary_row.h"
+#include "paimon/common/data/columnar/columnar_row.h"
 #include "paimon/common/data/data_define.h"
 #include "paimon/common/types/data_field.h"
 #include "paimon/common/utils/date_time_utils.h"
@@ -50,22 +54,45 @@ class FieldsComparatorTest : public ::testing::Test {
         for (const auto& type : input_types) {
             data_fields.emplace_back(/*id=*/0, arrow::field("fake_name", type));
         }
-        ASSERT_OK_AND_ASSIGN(auto comp1, FieldsComparator::Create(data_fields, sort_fields,
-                                                                  /*is_ascending_order=*/true,
-                                                                  /*use_view=*/false));
-        ASSERT_EQ(-1, comp1->CompareTo(row1, row2));
-        ASSERT_EQ(1, comp1->CompareTo(row2, row1));
-        ASSERT_EQ(0, comp1->CompareTo(row1, row1));
-        ASSERT_EQ(0, comp1->CompareTo(row2, row2));
+        for (bool use_view : {false, true}) {
+            ASSERT_OK_AND_ASSIGN(auto comp1, FieldsComparator::Create(data_fields, sort_fields,
+                                                                      /*is_ascending_order=*/true,
+                                                                      use_view));
+            ASSERT_EQ(-1, comp1->CompareTo(row1, row2));
+            ASSERT_EQ(1, comp1->CompareTo(row2, row1));
+            ASSERT_EQ(0, comp1->CompareTo(row1, row1));
+            ASSERT_EQ(0, comp1->CompareTo(row2, row2));
+            CheckNormalizedKey(*comp1, row1, row2);
 
-        if (!has_null) {
-            ASSERT_OK_AND_ASSIGN(auto comp2, FieldsComparator::Create(data_fields, sort_fields,
-                                                                      /*is_ascending_order=*/false,
-                                                                      /*use_view=*/false));
-            ASSERT_EQ(1, comp2->CompareTo(row1, row2));
-            ASSERT_EQ(-1, comp2->CompareTo(row2, row1));
-            ASSERT_EQ(0, comp2->CompareTo(row1, row1));
-            ASSERT_EQ(0, comp2->CompareTo(row2, row2));
+            if (!has_null) {
+                ASSERT_OK_AND_ASSIGN(
+                    auto comp2, FieldsComparator::Create(data_fields, sort_fields,
+                                                         /*is_ascending_order=*/false, use_view));
+                ASSERT_EQ(1, comp2->CompareTo(row1, row2));
+                ASSERT_EQ(-1, comp2->CompareTo(row2, row1));
+                ASSERT_EQ(0, comp2->CompareTo(row1, row1));
+                ASSERT_EQ(0, comp2->CompareTo(row2, row2));
+                CheckNormalizedKey(*comp2, row1, row2);
+            }
+        }
+    }
+
+    // comparing with normalized keys must be the same as comparing field by field
+    void CheckNormalizedKey(const FieldsComparator& comp, const InternalRow& row1,
+                            const InternalRow& row2) const {
+        if (!comp.HasNormalizedKey()) {
+            return;
+        }
+        uint64_t key1 = comp.NormalizedKey(row1);
+        uint64_t key2 = comp.NormalizedKey(row2);
+        int32_t expected = comp.CompareTo(row1, row2);
+        ASSERT_EQ(expected, comp.CompareTo(key1, row1, key2, row2));
+        ASSERT_EQ(-expected, comp.CompareTo(key2, row2, key1, row1));
+        ASSERT_EQ(0, comp.CompareTo(key1, row1, key1, row1));
+        if (key1 != key2) {
+            ASSERT_EQ(expected, key1 < key2 ? -1 : 1);
+        } else if (comp.NormalizedKeyIsFull()) {
+            ASSERT_EQ(0, expected);
         }
     }
 
@@ -318,6 +345,132 @@ TEST_F(FieldsComparatorTest, TestWithSortFields) {
     }
 }
 
+TEST_F(FieldsComparatorTest, TestNormalizedKeyLayout) {
+    auto check_layout = [](const std::vector<DataField>& fields, bool use_view,
+                           bool has_normalized_key, bool is_full) {
+        ASSERT_OK_AND_ASSIGN(auto comp, FieldsComparator::Create(fields,
+                                                                 /*is_ascending_order=*/true,
+                                                                 use_view));
+        ASSERT_EQ(has_normalized_key, comp->HasNormalizedKey());
+        ASSERT_EQ(is_full, comp->NormalizedKeyIsFull());
+    };
+    DataField int32_field(0, arrow::field("f0", arrow::int32(), /*nullable=*/false));
+    DataField int64_field(1, arrow::field("f1", arrow::int64(), /*nullable=*/false));
+    DataField nullable_int64_field(2, arrow::field("f2", arrow::int64()));
+    DataField string_field(3, arrow::field("f3", arrow::utf8(), /*nullable=*/false));
+    DataField double_field(4, arrow::field("f4", arrow::float64(), /*nullable=*/false));
+    // fixed-width fields within 8 bytes are fully encoded
+    check_layout({int64_field}, /*use_view=*/true, /*has_normalized_key=*/true, /*is_full=*/true);
+    check_layout({int32_field, int32_field}, /*use_view=*/true, /*has_normalized_key=*/true,
+                 /*is_full=*/true);
+    // null flag or second field exceeds 8 bytes
+    check_layout({nullable_int64_field}, /*use_view=*/true, /*has_normalized_key=*/true,
+                 /*is_full=*/false);
+    check_layout({int32_field, int64_field}, /*use_view=*/true, /*has_normalized_key=*/true,
+                 /*is_full=*/false);
+    // strings are truncated, and only normalized with view
+    check_layout({string_field}, /*use_view=*/true, /*has_normalized_key=*/true,
+                 /*is_full=*/false);
+    check_layout({string_field}, /*use_view=*/false, /*has_normalized_key=*/false,
+                 /*is_full=*/false);
+    // unsupported fields end the normalized key
+    check_layout({double_field}, /*use_view=*/true, /*has_normalized_key=*/false,
+                 /*is_full=*/false);
+    check_layout({int32_field, double_field}, /*use_view=*/true, /*has_normalized_key=*/true,
+                 /*is_full=*/false);
+}
+
+TEST_F(FieldsComparatorTest, TestNormalizedKeyConsistency) {
+    auto pool = GetDefaultPool();
+    std::mt19937_64 random(42);
+    std::vector<int64_t> longs = {std::numeric_limits<int64_t>::min(),
+                                  std::numeric_limits<int64_t>::max(), -1, 0, 1, 255, 256};
+    std::vector<std::string> strings = {"",          "a",       std::string("a\0", 2),
+                                        "ab",        "abcdefgh", "abcdefghi",
+                                        "\xff",      "abandon",  "abandon-"};
+    for (int32_t i = 0; i < 50; ++i) {
+        longs.push_back(static_cast<int64_t>(random()) >> (random() % 64));
+        strings.push_back(std::string(random() % 12, static_cast<char>('a' + random() % 3)));
+    }
+    std::vector<BinaryRow> rows;
+    for (size_t i = 0; i < longs.size(); ++i) {
+        BinaryRowGenerator::ValueType values = {
+            longs[i], static_cast<int32_t>(longs[i] % 3), strings[i % strings.size()]};
+        if (i % 7 == 0) {
+            values[i % 3] = NullType();
+        }
+        rows.push_back(BinaryRowGenerator::GenerateRow(values, pool.get()));
+    }
+    std::vector<DataField> fields = {DataField(0, arrow::field("f0", arrow::int64())),
+                                     DataField(1, arrow::field("f1", arrow::int32())),
+                                     DataField(2, arrow::field("f2", arrow::utf8()))};
+    for (const auto& sort_fields : std::vector<std::vector<int32_t>>(
+             {{0}, {1}, {2}, {1, 0}, {1, 2}, {2, 1}, {1, 1, 0}, {0, 1, 2}})) {
+        for (bool is_ascending_order : {true, false}) {
+            ASSERT_OK_AND_ASSIGN(auto comp, FieldsComparator::Create(fields, sort_fields,
+                                                                     is_ascending_order,
+                                                                     /*use_view=*/true));
+            ASSERT_TRUE(comp->HasNormalizedKey());
+            for (const auto& row1 : rows) {
+                for (const auto& row2 : rows) {
+                    CheckNormalizedKey(*comp, row1, row2);
+                }
+            }
+        }
+    }
+}
+
+TEST_F(FieldsComparatorTest, TestColumnarComparator) {
+    auto pool = GetDefaultPool();
+    arrow::ArrayVector arrays = {
+        arrow::ipc::internal::json::ArrayFromJSON(arrow::int32(), "[1, null, -3, 1, 1, null, 7]")
+            .ValueOrDie(),
+        arrow::ipc::internal::json::ArrayFromJSON(arrow::int64(),
+                                                  "[5, 5, null, -9223372036854775808, 5, 2, 0]")
+            .ValueOrDie(),
+        arrow::ipc::internal::json::ArrayFromJSON(arrow::utf8(),
+                                                  R"(["b", "a", null, "", "ab", "ÿ", "b"])")
+            .ValueOrDie()};
+    std::vector<DataField> fields = {DataField(0, arrow::field("f0", arrow::int32())),
+                                     DataField(1, arrow::field("f1", arrow::int64())),
+                                     DataField(2, arrow::field("f2", arrow::utf8()))};
+    std::vector<ColumnarRow> rows;
+    for (int64_t i = 0; i < arrays[0]->length(); ++i) {
+        rows.emplace_back(arrays, pool, i);
+    }
+    for (const auto& sort_fields :
+         std::vector<std::vector<int32_t>>({{0}, {1}, {2}, {0, 1}, {1, 0}, {0, 2}})) {
+        for (bool is_ascending_order : {true, false}) {
+            ASSERT_OK_AND_ASSIGN(auto comp, FieldsComparator::Create(fields, sort_fields,
+                                                                     is_ascending_order,
+                                                                     /*use_view=*/true));
+            bool specialized = sort_fields.size() == 1 || sort_fields == std::vector<int32_t>{0, 1};
+            ASSERT_EQ(comp->columnar_compare_func_ != nullptr, specialized);
+            for (const auto& row1 : rows) {
+                for (const auto& row2 : rows) {
+                    ASSERT_EQ(comp->CompareTo(row1, row2), comp->CompareFieldByField(row1, row2))
+                        << row1.GetRowId() << " vs " << row2.GetRowId();
+                }
+            }
+        }
+    }
+    // strings are not compared by view without use_view
+    ASSERT_OK_AND_ASSIGN(auto comp, FieldsComparator::Create(fields, {2},
+                                                             /*is_ascending_order=*/true,
+                                                             /*use_view=*/false));
+    ASSERT_EQ(comp->columnar_compare_func_, nullptr);
+
+    // rows other than ColumnarRow are compared field by field
+    ASSERT_OK_AND_ASSIGN(comp, FieldsComparator::Create(fields, {0, 1},
+                                                        /*is_ascending_order=*/true,
+                                                        /*use_view=*/true));
+    BinaryRow binary_row = BinaryRowGenerator::GenerateRow(
+        {static_cast<int32_t>(1), static_cast<int64_t>(5), std::string("b")}, pool.get());
+    ASSERT_EQ(comp->CompareTo(binary_row, rows[0]), 0);
+    ASSERT_EQ(comp->CompareTo(rows[3], binary_row), -1);
+    ASSERT_EQ(comp->CompareTo(binary_row, rows[1]), 1);
+}
+
 TEST_F(FieldsComparatorTest, TestInvalidType) {
     auto map_type = arrow::map(arrow::int8(), arrow::int16());
     ASSERT_NOK_WITH_MSG(FieldsComparator::Create({DataField(0, arrow::field("f0", arrow::int32())),
@@ -63,6 +63,27 @@ Result<BatchReader::ReadBatch> ManifestMetaReader::NextBatch() {
     return std::make_pair(std::move(target_c_arrow_array), std::move(target_c_schema));
 }
 
+std::shared_ptr<arrow::DataType> ManifestMetaReader::ProjectFileType(
+    const std::shared_ptr<arrow::DataType>& file_type,
+    const std::shared_ptr<arrow::DataType>& read_type) {
+    if (file_type->id() != arrow::Type::type::STRUCT ||
+        read_type->id() != arrow::Type::type::STRUCT) {
+        return file_type;
+    }
+    const auto& read_struct_type =
+        arrow::internal::checked_cast<const arrow::StructType&>(*read_type);
+    arrow::FieldVector projected_fields;
+    for (const auto& file_field : file_type->fields()) {
+        std::shared_ptr<arrow::Field> read_field =
+            read_struct_type.GetFieldByName(file_field->name());
+        if (read_field) {
+            projected_fields.push_back(
+                file_field->WithType(ProjectFileType(file_field->type(), read_field->type())));
+        }
+    }
+    return arrow::struct_(projected_fields);
+}
+
 Result<std::shared_ptr<arrow::Array>> ManifestMetaReader::AlignArrayWithSchema(
     const std::shared_ptr<arrow::Array>& src_array,
     const std::shared_ptr<arrow::DataType>& target_type, arrow::MemoryPool* pool) {
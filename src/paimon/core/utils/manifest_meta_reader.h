@@ -48,6 +48,13 @@ class PAIMON_EXPORT ManifestMetaReader : public BatchReader {
 
     Result<ReadBatch> NextBatch() override;
 
+    /// Project `file_type` to the fields of `read_type` matched by name, nested structs are
+    /// projected as well. The fields keep the order and types of the file, fields of `read_type`
+    /// missing in the file are left out and filled with nulls by `NextBatch()`.
+    static std::shared_ptr<arrow::DataType> ProjectFileType(
+        const std::shared_ptr<arrow::DataType>& file_type,
+        const std::shared_ptr<arrow::DataType>& read_type);
+
     std::shared_ptr<Metrics> GetReaderMetrics() const override {
         return reader_->GetReaderMetrics();
     }
@@ -176,4 +176,28 @@ TEST(ManifestMetaReaderTest, TestCastInt32Type) {
     ASSERT_TRUE(target_array->Equals(result_array)) << result_array->ToString();
 }
 
+TEST(ManifestMetaReaderTest, TestProjectFileType) {
+    auto file_type = arrow::struct_({
+        arrow::field("f0", arrow::int32()),
+        arrow::field("f1", arrow::struct_({field("sub1", arrow::int64()),
+                                           field("sub2", arrow::utf8()),
+                                           field("sub3", arrow::boolean())})),
+        arrow::field("f2", arrow::utf8()),
+    });
+    // f3 does not exist in the file, sub2 and f2 are not read
+    auto read_type = arrow::struct_({
+        arrow::field("f3", arrow::float64()),
+        arrow::field("f1", arrow::struct_({field("sub3", arrow::boolean()),
+                                           field("sub1", arrow::int64())})),
+        arrow::field("f0", arrow::int32()),
+    });
+    auto expected_type = arrow::struct_({
+        arrow::field("f0", arrow::int32()),
+        arrow::field("f1", arrow::struct_({field("sub1", arrow::int64()),
+                                           field("sub3", arrow::boolean())})),
+    });
+    auto projected_type = ManifestMetaReader::ProjectFileType(file_type, read_type);
+    ASSERT_TRUE(projected_type->Equals(expected_type)) << projected_type->ToString();
+}
+
 }  // namespace paimon::test
@@ -0,0 +1,60 @@
+/*
+ * Copyright 2024-present Alibaba Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "paimon/core/utils/objects_cache.h"
+
+#include <mutex>
+
+#include "paimon/common/io/cache/lru_cache.h"
+#include "paimon/memory/memory_pool.h"
+
+namespace paimon {
+
+namespace {
+struct GlobalObjectsCache {
+    // declared before the cache, so that it is released after the objects allocated from it
+    std::shared_ptr<MemoryPool> pool = GetDefaultPool();
+    std::mutex mutex;
+    // one cache for the whole process, so that the memory of decoded files stays bounded by a
+    // single budget however many tables are scanned
+    std::shared_ptr<Cache> cache;
+};
+
+GlobalObjectsCache& GetGlobalObjectsCache() {
+    static GlobalObjectsCache global_cache;
+    return global_cache;
+}
+}  // namespace
+
+std::shared_ptr<Cache> ObjectsCache::GetGlobal(int64_t max_memory_size) {
+    if (max_memory_size <= 0) {
+        return nullptr;
+    }
+    auto& global_cache = GetGlobalObjectsCache();
+    std::lock_guard<std::mutex> lock(global_cache.mutex);
+    if (!global_cache.cache) {
+        // files are large and looked up a few times per plan, a single shard lets every file use
+        // the whole budget
+        global_cache.cache = std::make_shared<LruCache>(max_memory_size, /*num_shards=*/1);
+    }
+    return global_cache.cache;
+}
+
+std::shared_ptr<MemoryPool> ObjectsCache::GetPool() {
+    return GetGlobalObjectsCache().pool;
+}
+
+}  // namespace paimon
@@ -0,0 +1,62 @@
+/*
+ * Copyright 2024-present Alibaba Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "paimon/common/io/cache/cache.h"
+
+namespace paimon {
+class MemoryPool;
+
+/// The decoded objects of one file, charged to a cache by their estimated memory.
+template <typename T>
+class ObjectsCacheValue : public CacheValue {
+ public:
+    ObjectsCacheValue(std::vector<T>&& objects, int64_t weight)
+        : CacheValue(/*segment=*/nullptr), objects_(std::move(objects)), weight_(weight) {}
+
+    const std::vector<T>& Objects() const {
+        return objects_;
+    }
+
+    int64_t Weight() const override {
+        return weight_;
+    }
+
+ private:
+    std::vector<T> objects_;
+    int64_t weight_;
+};
+
+/// Process-wide cache of decoded objects files (e.g. manifest lists and manifest files). These
+/// files are never modified once written, so they are cached by path and never invalidated.
+class ObjectsCache {
+ public:
+    /// @return the process-wide cache, or nullptr if `max_memory_size` is not positive. The cache
+    /// is shared by all tables and bounded by the `max_memory_size` of the first call creating it,
+    /// later sizes are ignored.
+    static std::shared_ptr<Cache> GetGlobal(int64_t max_memory_size);
+
+    /// @return the pool to decode cached objects with, as they outlive the pool of any scan.
+    static std::shared_ptr<MemoryPool> GetPool();
+};
+
+}  // namespace paimon
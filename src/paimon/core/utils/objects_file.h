@@ -18,12 +18,16 @@
 
 #include <functional>
 #include <memory>
+#include <optional>
 #include <string>
 #include <utility>
 #include <vector>
 
 #include "arrow/c/bridge.h"
 #include "arrow/c/helpers.h"
+#include "arrow/util/byte_size.h"
+#include "paimon/common/io/cache/cache.h"
+#include "paimon/common/io/cache/cache_key.h"
 #include "paimon/common/data/columnar/columnar_row.h"
 #include "paimon/common/utils/arrow/arrow_utils.h"
 #include "paimon/common/utils/arrow/status_utils.h"
@@ -31,6 +35,7 @@
 #include "paimon/common/utils/scope_guard.h"
 #include "paimon/core/io/meta_to_arrow_array_converter.h"
 #include "paimon/core/utils/manifest_meta_reader.h"
+#include "paimon/core/utils/objects_cache.h"
 #include "paimon/core/utils/object_serializer.h"
 #include "paimon/core/utils/path_factory.h"
 #include "paimon/format/format_writer.h"
@@ -45,6 +50,10 @@ class PredicateFilter;
 template <typename T>
 class ObjectsFile {
  public:
+    /// Selects the rows of a decoded batch to convert to `T`, before paying for the conversion.
+    /// The batch is a struct array of the serialized fields of `T`.
+    using BatchFilter = std::function<Result<std::vector<char>>(const arrow::StructArray&)>;
+
     ObjectsFile(const std::shared_ptr<FileSystem>& file_system,
                 const std::shared_ptr<ReaderBuilder>& reader_builder,
                 const std::shared_ptr<WriterBuilder>& writer_builder,
@@ -56,9 +65,22 @@ class ObjectsFile {
 
     Status Read(const std::string& file_name, const std::function<Result<bool>(const T&)>& filter,
                 std::vector<T>* result) const;
+    /// Same as above, but rejects rows on the decoded batch with `batch_filter` before paying for
+    /// the conversion. `filter` must make the same selection on `T`: it is only applied to cached
+    /// objects, which have no batch left to filter.
+    Status Read(const std::string& file_name, const BatchFilter& batch_filter,
+                const std::function<Result<bool>(const T&)>& filter,
+                std::vector<T>* result) const;
     Status ReadIfFileExist(const std::string& file_name,
                            const std::function<Result<bool>(const T&)>& filter,
                            std::vector<T>* result) const;
+    /// Same as `Read()`, but only decodes the fields of `read_type`, a projection of the data type
+    /// of the serializer. The other fields are null when converted to `T`, so the serializer must
+    /// accept them as null. The objects are incomplete and bypass the cache.
+    Status ReadProjected(const std::string& file_name,
+                         const std::shared_ptr<arrow::DataType>& read_type,
+                         const std::function<Result<bool>(const T&)>& filter,
+                         std::vector<T>* result) const;
 
     void DeleteQuietly(const std::string& file_name) {
         std::string path = path_factory_->ToPath(file_name);
@@ -69,6 +91,12 @@ class ObjectsFile {
 
     Result<std::pair<std::string, int64_t>> WriteWithoutRolling(const std::vector<T>& records);
 
+    /// Caches the decoded objects of every read file in `cache`. The objects are kept after this
+    /// file is destroyed, so the pool of this file must outlive the cache.
+    void SetCache(const std::shared_ptr<Cache>& cache) {
+        cache_ = cache;
+    }
+
  protected:
     std::shared_ptr<PathFactory> path_factory_;
     std::shared_ptr<MemoryPool> pool_;
@@ -76,10 +104,19 @@ class ObjectsFile {
     std::shared_ptr<WriterBuilder> writer_builder_;
     std::unique_ptr<MetaToArrowArrayConverter> to_array_converter_;
 
+ private:
+    // `read_type` nullptr indicates all fields of the file are read
+    Status ReadFromFile(const std::string& file_name,
+                        const std::shared_ptr<arrow::DataType>& read_type,
+                        const BatchFilter& batch_filter,
+                        const std::function<Result<bool>(const T&)>& filter, std::vector<T>* result,
+                        int64_t* decoded_bytes) const;
+
  private:
     std::shared_ptr<FileSystem> file_system_;
     std::shared_ptr<ReaderBuilder> reader_builder_;
     std::string compression_;
+    std::shared_ptr<Cache> cache_;
 };
 
 template <typename T>
@@ -96,9 +133,7 @@ ObjectsFile<T>::ObjectsFile(const std::shared_ptr<FileSystem>& file_system,
       writer_builder_(std::move(writer_builder)),
       file_system_(file_system),
       reader_builder_(std::move(reader_builder)),
-      compression_(compression) {
-    // TODO(xinyu.lxy): add cache
-}
+      compression_(compression) {}
 
 template <typename T>
 Status ObjectsFile<T>::ReadIfFileExist(const std::string& file_name,
@@ -116,11 +151,83 @@ template <typename T>
 Status ObjectsFile<T>::Read(const std::string& file_name,
                             const std::function<Result<bool>(const T&)>& filter,
                             std::vector<T>* result) const {
+    return Read(file_name, /*batch_filter=*/nullptr, filter, result);
+}
+
+template <typename T>
+Status ObjectsFile<T>::Read(const std::string& file_name, const BatchFilter& batch_filter,
+                            const std::function<Result<bool>(const T&)>& filter,
+                            std::vector<T>* result) const {
+    if (!cache_) {
+        return ReadFromFile(file_name, /*read_type=*/nullptr, batch_filter,
+                            batch_filter ? nullptr : filter, result, /*decoded_bytes=*/nullptr);
+    }
+    Status read_status;
+    auto value = cache_->Get(
+        CacheKey::ForFile(path_factory_->ToPath(file_name)),
+        [&](const std::shared_ptr<CacheKey>&) -> std::shared_ptr<CacheValue> {
+            std::vector<T> objects;
+            int64_t decoded_bytes = 0;
+            // cache all objects of the file, whatever the current filters are
+            read_status = ReadFromFile(file_name, /*read_type=*/nullptr, /*batch_filter=*/nullptr,
+                                       /*filter=*/nullptr, &objects, &decoded_bytes);
+            if (!read_status.ok()) {
+                return nullptr;
+            }
+            decoded_bytes += static_cast<int64_t>(objects.size() * sizeof(T));
+            return std::make_shared<ObjectsCacheValue<T>>(std::move(objects), decoded_bytes);
+        });
+    PAIMON_RETURN_NOT_OK(read_status);
+    auto cached = std::dynamic_pointer_cast<ObjectsCacheValue<T>>(value);
+    if (!cached) {
+        return Status::Invalid(fmt::format("file {}, unexpected cached value", file_name));
+    }
+    result->reserve(result->size() + cached->Objects().size());
+    for (const auto& obj : cached->Objects()) {
+        if (filter) {
+            PAIMON_ASSIGN_OR_RAISE(bool filter_res, filter(obj));
+            if (!filter_res) {
+                continue;
+            }
+        }
+        result->push_back(obj);
+    }
+    return Status::OK();
+}
+
+template <typename T>
+Status ObjectsFile<T>::ReadProjected(const std::string& file_name,
+                                     const std::shared_ptr<arrow::DataType>& read_type,
+                                     const std::function<Result<bool>(const T&)>& filter,
+                                     std::vector<T>* result) const {
+    return ReadFromFile(file_name, read_type, /*batch_filter=*/nullptr, filter, result,
+                        /*decoded_bytes=*/nullptr);
+}
+
+template <typename T>
+Status ObjectsFile<T>::ReadFromFile(const std::string& file_name,
+                                    const std::shared_ptr<arrow::DataType>& read_type,
+                                    const BatchFilter& batch_filter,
+                                    const std::function<Result<bool>(const T&)>& filter,
+                                    std::vector<T>* result, int64_t* decoded_bytes) const {
     std::string file_path = path_factory_->ToPath(file_name);
     PAIMON_ASSIGN_OR_RAISE(std::shared_ptr<InputStream> file_input_stream,
                            file_system_->Open(file_path));
     PAIMON_ASSIGN_OR_RAISE(std::unique_ptr<FileBatchReader> batch_reader,
                            reader_builder_->Build(file_input_stream));
+    if (read_type) {
+        // files written by older versions may miss some fields of the read type
+        PAIMON_ASSIGN_OR_RAISE(std::unique_ptr<::ArrowSchema> c_file_schema,
+                               batch_reader->GetFileSchema());
+        PAIMON_ASSIGN_OR_RAISE_FROM_ARROW(std::shared_ptr<arrow::DataType> file_type,
+                                          arrow::ImportType(c_file_schema.get()));
+        std::shared_ptr<arrow::DataType> projected_type =
+            ManifestMetaReader::ProjectFileType(file_type, read_type);
+        ::ArrowSchema c_read_schema;
+        PAIMON_RETURN_NOT_OK_FROM_ARROW(arrow::ExportType(*projected_type, &c_read_schema));
+        PAIMON_RETURN_NOT_OK(batch_reader->SetReadSchema(&c_read_schema, /*predicate=*/nullptr,
+                                                         /*selection_bitmap=*/std::nullopt));
+    }
     auto reader = std::make_unique<ManifestMetaReader>(std::move(batch_reader),
                                                        serializer_->GetDataType(), pool_);
     while (true) {
@@ -136,8 +243,24 @@ Status ObjectsFile<T>::Read(const std::string& file_name,
         if (!struct_array) {
             return Status::Invalid(fmt::format("file {}, cannot cast to struct array", file_name));
         }
+        if (decoded_bytes) {
+            // the decoded objects hold about as much memory as the decoded arrow arrays
+            *decoded_bytes += arrow::util::TotalBufferSize(*struct_array);
+        }
+        std::vector<char> selected;
+        if (batch_filter) {
+            PAIMON_ASSIGN_OR_RAISE(selected, batch_filter(*struct_array));
+            if (static_cast<int64_t>(selected.size()) != struct_array->length()) {
+                return Status::Invalid(
+                    fmt::format("file {}, batch filter selects {} rows of a batch of {} rows",
+                                file_name, selected.size(), struct_array->length()));
+            }
+        }
         result->reserve(struct_array->length());
         for (int64_t i = 0; i < struct_array->length(); i++) {
+            if (!selected.empty() && !selected[i]) {
+                continue;
+            }
             ColumnarRow row(struct_array->fields(), pool_, i);
             PAIMON_ASSIGN_OR_RAISE(T obj, serializer_->FromRow(row));
             if (filter) {
@@ -0,0 +1,192 @@
+/*
+ * Copyright 2024-present Alibaba Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "paimon/core/utils/radix_sorter.h"
+
+#include <array>
+#include <cassert>
+#include <cstring>
+
+#include "arrow/buffer.h"
+#include "paimon/common/utils/arrow/status_utils.h"
+
+namespace paimon {
+namespace {
+constexpr int32_t kRadixBits = 8;
+constexpr int32_t kRadixBuckets = 1 << kRadixBits;
+
+template <typename ArrowType>
+void EncodeSigned(const arrow::Array& array, int32_t width, uint64_t invert, uint64_t* encoded) {
+    const auto* values = static_cast<const arrow::NumericArray<ArrowType>&>(array).raw_values();
+    const uint64_t mask = width == 8 ? ~uint64_t{0} : (uint64_t{1} << (width * 8)) - 1;
+    const uint64_t sign = uint64_t{1} << (width * 8 - 1);
+    for (int64_t i = 0; i < array.length(); ++i) {
+        uint64_t value = static_cast<uint64_t>(static_cast<int64_t>(values[i]));
+        encoded[i] = ((value ^ sign) & mask) ^ invert;
+    }
+}
+}  // namespace
+
+bool RadixSorter::IsSupportedType(arrow::Type::type type) {
+    return KeyWidth(type) > 0;
+}
+
+bool RadixSorter::IsSupported(const std::vector<SortKey>& keys) {
+    for (const auto& key : keys) {
+        if (!key.array || !IsSupportedType(key.array->type_id())) {
+            return false;
+        }
+    }
+    return true;
+}
+
+int32_t RadixSorter::KeyWidth(arrow::Type::type type) {
+    switch (type) {
+        case arrow::Type::type::BOOL:
+        case arrow::Type::type::INT8:
+            return 1;
+        case arrow::Type::type::INT16:
+            return 2;
+        case arrow::Type::type::INT32:
+        case arrow::Type::type::DATE32:
+            return 4;
+        case arrow::Type::type::INT64:
+        case arrow::Type::type::TIMESTAMP:
+            return 8;
+        default:
+            return 0;
+    }
+}
+
+void RadixSorter::EncodeKey(const SortKey& key, int32_t width, uint64_t* encoded) {
+    const arrow::Array& array = *key.array;
+    const uint64_t invert =
+        key.ascending ? 0 : (width == 8 ? ~uint64_t{0} : (uint64_t{1} << (width * 8)) - 1);
+    switch (array.type_id()) {
+        case arrow::Type::type::BOOL: {
+            const auto& typed = static_cast<const arrow::BooleanArray&>(array);
+            for (int64_t i = 0; i < array.length(); ++i) {
+                encoded[i] = static_cast<uint64_t>(typed.Value(i)) ^ invert;
+            }
+            break;
+        }
+        case arrow::Type::type::INT8:
+            EncodeSigned<arrow::Int8Type>(array, width, invert, encoded);
+            break;
+        case arrow::Type::type::INT16:
+            EncodeSigned<arrow::Int16Type>(array, width, invert, encoded);
+            break;
+        case arrow::Type::type::INT32:
+            EncodeSigned<arrow::Int32Type>(array, width, invert, encoded);
+            break;
+        case arrow::Type::type::DATE32:
+            EncodeSigned<arrow::Date32Type>(array, width, invert, encoded);
+            break;
+        case arrow::Type::type::INT64:
+            EncodeSigned<arrow::Int64Type>(array, width, invert, encoded);
+            break;
+        case arrow::Type::type::TIMESTAMP:
+            EncodeSigned<arrow::TimestampType>(array, width, invert, encoded);
+            break;
+        default:
+            assert(false);
+            break;
+    }
+    // the data of null slots is arbitrary (e.g. in arrays imported through the C data interface),
+    // equal radix keys keep the rows with nulls in their previous order
+    if (array.null_count() > 0) {
+        for (int64_t i = 0; i < array.length(); ++i) {
+            if (array.IsNull(i)) {
+                encoded[i] = 0;
+            }
+        }
+    }
+}
+
+Result<std::shared_ptr<arrow::UInt64Array>> RadixSorter::SortIndices(
+    const std::vector<SortKey>& keys, int64_t length, arrow::MemoryPool* pool) {
+    assert(IsSupported(keys));
+    PAIMON_ASSIGN_OR_RAISE_FROM_ARROW(
+        std::shared_ptr<arrow::Buffer> indices_buffer,
+        arrow::AllocateBuffer(length * static_cast<int64_t>(sizeof(uint64_t)), pool));
+    auto* indices = reinterpret_cast<uint64_t*>(indices_buffer->mutable_data());
+    for (int64_t i = 0; i < length; ++i) {
+        indices[i] = static_cast<uint64_t>(i);
+    }
+    if (length > 1 && !keys.empty()) {
+        std::vector<uint64_t> scratch(length);
+        std::vector<uint64_t> encoded(length);
+        uint64_t* current = indices;
+        uint64_t* next = scratch.data();
+        std::vector<std::array<int64_t, kRadixBuckets>> counts;
+        // LSD order: the last sort key is sorted first, each following stable pass keeps the
+        // order of the previous passes for equal bytes
+        for (auto it = keys.rbegin(); it != keys.rend(); ++it) {
+            const arrow::Array& array = *it->array;
+            assert(array.length() == length);
+            int32_t width = KeyWidth(array.type_id());
+            EncodeKey(*it, width, encoded.data());
+            // histograms of all bytes are built in a single scan
+            counts.assign(width, std::array<int64_t, kRadixBuckets>{});
+            for (int64_t i = 0; i < length; ++i) {
+                uint64_t value = encoded[i];
+                for (int32_t b = 0; b < width; ++b) {
+                    ++counts[b][(value >> (b * kRadixBits)) & (kRadixBuckets - 1)];
+                }
+            }
+            for (int32_t b = 0; b < width; ++b) {
+                int32_t shift = b * kRadixBits;
+                auto& count = counts[b];
+                if (count[(encoded[0] >> shift) & (kRadixBuckets - 1)] == length) {
+                    // all rows share this byte
+                    continue;
+                }
+                int64_t offset = 0;
+                for (auto& bucket : count) {
+                    int64_t bucket_count = bucket;
+                    bucket = offset;
+                    offset += bucket_count;
+                }
+                for (int64_t i = 0; i < length; ++i) {
+                    uint64_t index = current[i];
+                    next[count[(encoded[index] >> shift) & (kRadixBuckets - 1)]++] = index;
+                }
+                std::swap(current, next);
+            }
+            int64_t null_count = array.null_count();
+            if (null_count > 0 && null_count < length) {
+                // stable partition moves nulls to the front
+                int64_t null_pos = 0;
+                int64_t valid_pos = null_count;
+                for (int64_t i = 0; i < length; ++i) {
+                    uint64_t index = current[i];
+                    if (array.IsNull(static_cast<int64_t>(index))) {
+                        next[null_pos++] = index;
+                    } else {
+                        next[valid_pos++] = index;
+                    }
+                }
+                std::swap(current, next);
+            }
+        }
+        if (current != indices) {
+            std::memcpy(indices, current, length * sizeof(uint64_t));
+        }
+    }
+    return std::make_shared<arrow::UInt64Array>(length, std::move(indices_buffer));
+}
+
+}  // namespace paimon
@@ -0,0 +1,70 @@
+/*
+ * Copyright 2024-present Alibaba Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "arrow/api.h"
+#include "paimon/result.h"
+
+namespace paimon {
+
+/// Sorts rows of fixed-width columns by a stable LSD radix sort and produces the permutation,
+/// which is a faster replacement of `arrow::compute::SortIndices` for write buffer batches.
+///
+/// Columns are sorted from the last sort key to the first, one byte per pass, so that the
+/// permutation of all sort keys (e.g. primary keys followed by user-defined sequence fields) is
+/// produced at once. Passes whose byte is identical in all rows are skipped. Nulls are placed
+/// before all non-null values regardless of the sort order, which is the same as
+/// `arrow::compute::NullPlacement::AtStart`.
+class RadixSorter {
+ public:
+    RadixSorter() = delete;
+    ~RadixSorter() = delete;
+
+    struct SortKey {
+        SortKey(std::shared_ptr<arrow::Array> _array, bool _ascending)
+            : array(std::move(_array)), ascending(_ascending) {}
+
+        std::shared_ptr<arrow::Array> array;
+        bool ascending;
+    };
+
+    /// Whether `type` is a fixed-width type that can be radix sorted.
+    static bool IsSupportedType(arrow::Type::type type);
+
+    /// Whether all `keys` are present and of supported types.
+    static bool IsSupported(const std::vector<SortKey>& keys);
+
+    /// Returns the stable permutation of `length` rows sorted by `keys`, all keys must be
+    /// supported and have `length` rows.
+    static Result<std::shared_ptr<arrow::UInt64Array>> SortIndices(
+        const std::vector<SortKey>& keys, int64_t length, arrow::MemoryPool* pool);
+
+ private:
+    /// The number of bytes of the radix key of `type`.
+    static int32_t KeyWidth(arrow::Type::type type);
+
+    /// Encodes the values of `key` into unsigned radix keys whose byte-wise order is the sort
+    /// order, the radix keys of nulls are 0.
+    static void EncodeKey(const SortKey& key, int32_t width, uint64_t* encoded);
+};
+
+}  // namespace paimon
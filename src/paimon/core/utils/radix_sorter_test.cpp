@@ -0,0 +1,229 @@
+/*
+ * Copyright 2024-present Alibaba Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "paimon/core/utils/radix_sorter.h"
+
+#include <algorithm>
+#include <random>
+#include <string>
+
+#include "arrow/api.h"
+#include "arrow/buffer_builder.h"
+#include "arrow/compute/api.h"
+#include "arrow/compute/ordering.h"
+#include "arrow/ipc/json_simple.h"
+#include "gtest/gtest.h"
+#include "paimon/testing/utils/testharness.h"
+
+namespace paimon::test {
+class RadixSorterTest : public ::testing::Test {
+ public:
+    static std::shared_ptr<arrow::Array> FromJSON(const std::shared_ptr<arrow::DataType>& type,
+                                                  const std::string& json) {
+        return arrow::ipc::internal::json::ArrayFromJSON(type, json).ValueOrDie();
+    }
+
+    template <typename BuilderType>
+    std::shared_ptr<arrow::Array> RandomArray(BuilderType* builder, int64_t length,
+                                              int64_t cardinality, double null_ratio) {
+        for (int64_t i = 0; i < length; ++i) {
+            if (std::uniform_real_distribution<double>(0, 1)(random_) < null_ratio) {
+                EXPECT_TRUE(builder->AppendNull().ok());
+            } else {
+                int64_t value = static_cast<int64_t>(random_() % cardinality) - cardinality / 2;
+                EXPECT_TRUE(
+                    builder->Append(static_cast<typename BuilderType::value_type>(value)).ok());
+            }
+        }
+        std::shared_ptr<arrow::Array> array;
+        EXPECT_TRUE(builder->Finish(&array).ok());
+        return array;
+    }
+
+    std::shared_ptr<arrow::Array> RandomArray(const std::shared_ptr<arrow::DataType>& type,
+                                              int64_t length, int64_t cardinality,
+                                              double null_ratio) {
+        switch (type->id()) {
+            case arrow::Type::type::BOOL: {
+                arrow::BooleanBuilder builder;
+                return RandomArray(&builder, length, 2, null_ratio);
+            }
+            case arrow::Type::type::INT8: {
+                arrow::Int8Builder builder;
+                return RandomArray(&builder, length, std::min<int64_t>(cardinality, 256),
+                                   null_ratio);
+            }
+            case arrow::Type::type::INT16: {
+                arrow::Int16Builder builder;
+                return RandomArray(&builder, length, cardinality, null_ratio);
+            }
+            case arrow::Type::type::INT32: {
+                arrow::Int32Builder builder;
+                return RandomArray(&builder, length, cardinality, null_ratio);
+            }
+            case arrow::Type::type::DATE32: {
+                arrow::Date32Builder builder;
+                return RandomArray(&builder, length, cardinality, null_ratio);
+            }
+            case arrow::Type::type::INT64: {
+                arrow::Int64Builder builder;
+                return RandomArray(&builder, length, cardinality, null_ratio);
+            }
+            case arrow::Type::type::TIMESTAMP: {
+                arrow::TimestampBuilder builder(type, arrow::default_memory_pool());
+                return RandomArray(&builder, length, cardinality, null_ratio);
+            }
+            default:
+                return nullptr;
+        }
+    }
+
+    std::shared_ptr<arrow::UInt64Array> ArrowSortIndices(
+        const std::vector<RadixSorter::SortKey>& keys) const {
+        arrow::FieldVector fields;
+        arrow::ArrayVector arrays;
+        std::vector<arrow::compute::SortKey> sort_keys;
+        for (size_t i = 0; i < keys.size(); ++i) {
+            std::string name = "f" + std::to_string(i);
+            fields.push_back(arrow::field(name, keys[i].array->type()));
+            arrays.push_back(keys[i].array);
+            sort_keys.emplace_back(name, keys[i].ascending ? arrow::compute::SortOrder::Ascending
+                                                           : arrow::compute::SortOrder::Descending);
+        }
+        auto struct_array = arrow::StructArray::Make(arrays, fields).ValueOrDie();
+        arrow::compute::SortOptions sort_options(sort_keys,
+                                                 arrow::compute::NullPlacement::AtStart);
+        auto indices =
+            arrow::compute::SortIndices(arrow::Datum(struct_array), sort_options).ValueOrDie();
+        return std::static_pointer_cast<arrow::UInt64Array>(indices);
+    }
+
+    void CheckResult(const std::vector<RadixSorter::SortKey>& keys, int64_t length) const {
+        ASSERT_TRUE(RadixSorter::IsSupported(keys));
+        ASSERT_OK_AND_ASSIGN(std::shared_ptr<arrow::UInt64Array> result,
+                             RadixSorter::SortIndices(keys, length, arrow::default_memory_pool()));
+        auto expected = ArrowSortIndices(keys);
+        ASSERT_TRUE(result->Equals(*expected))
+            << "result: " << result->ToString() << ", expected: " << expected->ToString();
+    }
+
+ protected:
+    std::mt19937_64 random_{42};
+};
+
+TEST_F(RadixSorterTest, TestIsSupported) {
+    ASSERT_TRUE(RadixSorter::IsSupportedType(arrow::Type::type::INT32));
+    ASSERT_TRUE(RadixSorter::IsSupportedType(arrow::Type::type::TIMESTAMP));
+    ASSERT_FALSE(RadixSorter::IsSupportedType(arrow::Type::type::STRING));
+    ASSERT_FALSE(RadixSorter::IsSupportedType(arrow::Type::type::DOUBLE));
+
+    auto int_array = RandomArray(arrow::int32(), 10, 10, 0.0);
+    auto string_array = FromJSON(arrow::utf8(), R"(["a", "b"])");
+    ASSERT_TRUE(RadixSorter::IsSupported({{int_array, true}}));
+    ASSERT_FALSE(RadixSorter::IsSupported({{int_array, true}, {string_array, true}}));
+    ASSERT_FALSE(RadixSorter::IsSupported({{nullptr, true}}));
+}
+
+TEST_F(RadixSorterTest, TestSimple) {
+    auto keys =
+        FromJSON(arrow::int64(), R"([3, -1, null, 3, -9223372036854775808, 0, null, 7])");
+    auto sequences = FromJSON(arrow::int32(), R"([2, 1, 0, 1, 5, null, 3, 4])");
+    ASSERT_OK_AND_ASSIGN(std::shared_ptr<arrow::UInt64Array> result,
+                         RadixSorter::SortIndices({{keys, true}, {sequences, true}}, 8,
+                                                  arrow::default_memory_pool()));
+    auto expected = FromJSON(arrow::uint64(), R"([2, 6, 4, 1, 5, 3, 0, 7])");
+    ASSERT_TRUE(result->Equals(*expected)) << result->ToString();
+
+    ASSERT_OK_AND_ASSIGN(result, RadixSorter::SortIndices({{keys, true}, {sequences, false}}, 8,
+                                                          arrow::default_memory_pool()));
+    expected = FromJSON(arrow::uint64(), R"([6, 2, 4, 1, 5, 0, 3, 7])");
+    ASSERT_TRUE(result->Equals(*expected)) << result->ToString();
+}
+
+TEST_F(RadixSorterTest, TestEmptyAndSingleRow) {
+    auto empty = FromJSON(arrow::int32(), "[]");
+    ASSERT_OK_AND_ASSIGN(std::shared_ptr<arrow::UInt64Array> result,
+                         RadixSorter::SortIndices({{empty, true}}, /*length=*/0,
+                                                  arrow::default_memory_pool()));
+    ASSERT_EQ(result->length(), 0);
+
+    auto single = FromJSON(arrow::int32(), "[5]");
+    ASSERT_OK_AND_ASSIGN(result, RadixSorter::SortIndices({{single, true}}, /*length=*/1,
+                                                          arrow::default_memory_pool()));
+    ASSERT_EQ(result->length(), 1);
+    ASSERT_EQ(result->Value(0), 0);
+}
+
+TEST_F(RadixSorterTest, TestSlicedArray) {
+    auto keys = FromJSON(arrow::int32(), R"([9, 8, null, 7, 3, 5, null, 1])");
+    auto sliced = keys->Slice(2, 5);
+    CheckResult({{sliced, true}}, sliced->length());
+}
+
+TEST_F(RadixSorterTest, TestNullSlotsWithData) {
+    // builders zero null slots, arrays imported through the C data interface may not
+    auto make_array = [](const std::vector<int32_t>& values, const std::vector<bool>& valid) {
+        arrow::TypedBufferBuilder<int32_t> value_builder;
+        arrow::TypedBufferBuilder<bool> valid_builder;
+        EXPECT_TRUE(value_builder.Append(values.data(), values.size()).ok());
+        int64_t null_count = 0;
+        for (bool is_valid : valid) {
+            EXPECT_TRUE(valid_builder.Append(is_valid).ok());
+            null_count += is_valid ? 0 : 1;
+        }
+        return std::make_shared<arrow::Int32Array>(static_cast<int64_t>(values.size()),
+                                                   value_builder.Finish().ValueOrDie(),
+                                                   valid_builder.Finish().ValueOrDie(),
+                                                   null_count);
+    };
+    auto keys = FromJSON(arrow::int64(), "[1, 1, 1, 1]");
+    auto sequences = make_array({7, 5, 3, 1}, {true, false, false, true});
+    ASSERT_OK_AND_ASSIGN(std::shared_ptr<arrow::UInt64Array> result,
+                         RadixSorter::SortIndices({{keys, true}, {sequences, true}},
+                                                  /*length=*/4, arrow::default_memory_pool()));
+    auto expected = FromJSON(arrow::uint64(), "[1, 2, 3, 0]");
+    ASSERT_TRUE(result->Equals(*expected)) << result->ToString();
+
+    // the null partition is skipped if all rows are null
+    auto all_nulls = make_array({5, 3}, {false, false});
+    ASSERT_OK_AND_ASSIGN(result, RadixSorter::SortIndices({{all_nulls, false}}, /*length=*/2,
+                                                          arrow::default_memory_pool()));
+    expected = FromJSON(arrow::uint64(), "[0, 1]");
+    ASSERT_TRUE(result->Equals(*expected)) << result->ToString();
+}
+
+TEST_F(RadixSorterTest, TestCompareWithArrow) {
+    std::vector<std::shared_ptr<arrow::DataType>> types = {
+        arrow::boolean(), arrow::int8(),  arrow::int16(),
+        arrow::int32(),   arrow::date32(), arrow::int64(),
+        arrow::timestamp(arrow::TimeUnit::MICRO)};
+    const int64_t length = 1000;
+    for (const auto& first_type : types) {
+        for (const auto& second_type : types) {
+            for (double null_ratio : {0.0, 0.1}) {
+                for (bool ascending : {true, false}) {
+                    // low cardinality keys produce runs of equal keys for the second field
+                    auto first = RandomArray(first_type, length, 50, null_ratio);
+                    auto second = RandomArray(second_type, length, 1L << 40, null_ratio);
+                    CheckResult({{first, true}, {second, ascending}}, length);
+                    CheckResult({{first, ascending}}, length);
+                }
+            }
+        }
+    }
+}
+
+}  // namespace paimon::test
@@ -0,0 +1,75 @@
+/*
+ * Copyright 2024-present Alibaba Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "paimon/core/utils/write_memory_manager.h"
+
+#include <algorithm>
+
+namespace paimon {
+
+Status WriteMemoryManager::Acquire(MemoryOwner* owner, int64_t bytes) {
+    owners_[owner] += bytes;
+    total_memory_ += bytes;
+    while (total_memory_ > budget_ && !owners_.empty()) {
+        auto largest = std::max_element(
+            owners_.begin(), owners_.end(),
+            [](const auto& lhs, const auto& rhs) { return lhs.second < rhs.second; });
+        MemoryOwner* victim = largest->first;
+        PAIMON_RETURN_NOT_OK(victim->FlushMemory());
+        if (owners_.find(victim) != owners_.end()) {
+            // otherwise the same owner would be picked again and again
+            return Status::Invalid("write buffer is not released after flushing memory");
+        }
+    }
+    return Status::OK();
+}
+
+void WriteMemoryManager::Release(MemoryOwner* owner) {
+    auto iter = owners_.find(owner);
+    if (iter != owners_.end()) {
+        total_memory_ -= iter->second;
+        owners_.erase(iter);
+    }
+    ReleaseFlushing(owner);
+}
+
+void WriteMemoryManager::MarkFlushing(MemoryOwner* owner) {
+    auto iter = owners_.find(owner);
+    if (iter != owners_.end()) {
+        flushing_[owner] += iter->second;
+        owners_.erase(iter);
+    }
+}
+
+void WriteMemoryManager::ReleaseFlushing(MemoryOwner* owner) {
+    auto iter = flushing_.find(owner);
+    if (iter != flushing_.end()) {
+        total_memory_ -= iter->second;
+        flushing_.erase(iter);
+    }
+}
+
+int64_t WriteMemoryManager::MemoryOf(MemoryOwner* owner) const {
+    auto iter = owners_.find(owner);
+    return iter == owners_.end() ? 0 : iter->second;
+}
+
+int64_t WriteMemoryManager::FlushingMemoryOf(MemoryOwner* owner) const {
+    auto iter = flushing_.find(owner);
+    return iter == flushing_.end() ? 0 : iter->second;
+}
+
+}  // namespace paimon
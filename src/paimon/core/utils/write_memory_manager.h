@@ -0,0 +1,86 @@
+/*
+ * Copyright 2024-present Alibaba Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <unordered_map>
+
+#include "paimon/status.h"
+
+namespace paimon {
+
+/// A writer whose write buffer is accounted by a `WriteMemoryManager`.
+class MemoryOwner {
+ public:
+    virtual ~MemoryOwner() = default;
+
+    /// Hand the write buffer to a flush, the flush may complete in background. The owner must
+    /// call `WriteMemoryManager::MarkFlushing()` or `WriteMemoryManager::Release()` once its
+    /// buffer is handed over.
+    virtual Status FlushMemory() = 0;
+};
+
+/// Shares one memory budget among the write buffers of all writers of a `FileStoreWrite`.
+///
+/// Writers report the memory they buffer through `Acquire()`. Once the total exceeds the budget,
+/// the largest write buffers are flushed first until the total fits into the budget again, so
+/// that a few large files are produced instead of many small ones. A buffer handed to a flush,
+/// which runs on the executor of the writer (if any), is no longer picked for flushing but stays
+/// accounted until the flush completes, as its memory is only freed then.
+///
+/// Not thread-safe, the writers of a `FileStoreWrite` are called from a single thread.
+class WriteMemoryManager {
+ public:
+    explicit WriteMemoryManager(int64_t budget) : budget_(budget) {}
+
+    /// Account `bytes` more buffered memory of `owner`, and flush the largest owners if the budget
+    /// is exceeded. `owner` itself may be flushed.
+    Status Acquire(MemoryOwner* owner, int64_t bytes);
+
+    /// Release all buffered memory of `owner`, including the memory of its flush, and stop
+    /// accounting it.
+    void Release(MemoryOwner* owner);
+
+    /// Move the buffered memory of `owner` to its flush, it is accounted but not flushed again
+    /// until `ReleaseFlushing()`.
+    void MarkFlushing(MemoryOwner* owner);
+
+    /// Release the memory of the completed flush of `owner`.
+    void ReleaseFlushing(MemoryOwner* owner);
+
+    int64_t Budget() const {
+        return budget_;
+    }
+
+    int64_t TotalMemory() const {
+        return total_memory_;
+    }
+
+    /// Buffered memory of `owner` which is not handed to a flush.
+    int64_t MemoryOf(MemoryOwner* owner) const;
+
+    /// Memory of `owner` handed to a flush which is not completed yet.
+    int64_t FlushingMemoryOf(MemoryOwner* owner) const;
+
+ private:
+    int64_t budget_;
+    int64_t total_memory_ = 0;
+    std::unordered_map<MemoryOwner*, int64_t> owners_;
+    std::unordered_map<MemoryOwner*, int64_t> flushing_;
+};
+
+}  // namespace paimon
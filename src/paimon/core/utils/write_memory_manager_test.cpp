@@ -0,0 +1,155 @@
+/*
+ * Copyright 2024-present Alibaba Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "paimon/core/utils/write_memory_manager.h"
+
+#include <cstdint>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "paimon/status.h"
+#include "paimon/testing/utils/testharness.h"
+
+namespace paimon::test {
+
+class FakeMemoryOwner : public MemoryOwner {
+ public:
+    FakeMemoryOwner(WriteMemoryManager* manager, std::vector<FakeMemoryOwner*>* flushed)
+        : manager_(manager), flushed_(flushed) {}
+
+    Status Write(int64_t bytes) {
+        buffered_ += bytes;
+        return manager_->Acquire(this, bytes);
+    }
+
+    Status FlushMemory() override {
+        if (!flush_status_.ok()) {
+            return flush_status_;
+        }
+        flushed_->push_back(this);
+        if (flush_in_background_) {
+            buffered_ = 0;
+            manager_->MarkFlushing(this);
+        } else if (release_on_flush_) {
+            buffered_ = 0;
+            manager_->Release(this);
+        }
+        return Status::OK();
+    }
+
+    WriteMemoryManager* manager_;
+    std::vector<FakeMemoryOwner*>* flushed_;
+    int64_t buffered_ = 0;
+    bool release_on_flush_ = true;
+    bool flush_in_background_ = false;
+    Status flush_status_ = Status::OK();
+};
+
+TEST(WriteMemoryManagerTest, TestWithinBudget) {
+    WriteMemoryManager manager(/*budget=*/100);
+    std::vector<FakeMemoryOwner*> flushed;
+    FakeMemoryOwner owner1(&manager, &flushed);
+    FakeMemoryOwner owner2(&manager, &flushed);
+    ASSERT_OK(owner1.Write(40));
+    ASSERT_OK(owner2.Write(30));
+    ASSERT_OK(owner1.Write(30));
+    ASSERT_TRUE(flushed.empty());
+    ASSERT_EQ(100, manager.TotalMemory());
+    ASSERT_EQ(70, manager.MemoryOf(&owner1));
+    ASSERT_EQ(30, manager.MemoryOf(&owner2));
+
+    manager.Release(&owner1);
+    ASSERT_EQ(30, manager.TotalMemory());
+    ASSERT_EQ(0, manager.MemoryOf(&owner1));
+    // release an owner twice or an unknown owner is a no-op
+    manager.Release(&owner1);
+    ASSERT_EQ(30, manager.TotalMemory());
+}
+
+TEST(WriteMemoryManagerTest, TestFlushLargestFirst) {
+    WriteMemoryManager manager(/*budget=*/100);
+    std::vector<FakeMemoryOwner*> flushed;
+    FakeMemoryOwner owner1(&manager, &flushed);
+    FakeMemoryOwner owner2(&manager, &flushed);
+    FakeMemoryOwner owner3(&manager, &flushed);
+    ASSERT_OK(owner1.Write(20));
+    ASSERT_OK(owner2.Write(50));
+    ASSERT_OK(owner3.Write(25));
+    // owner1 exceeds the budget, but owner2 holds the largest buffer
+    ASSERT_OK(owner1.Write(10));
+    ASSERT_EQ(std::vector<FakeMemoryOwner*>({&owner2}), flushed);
+    ASSERT_EQ(0, owner2.buffered_);
+    ASSERT_EQ(55, manager.TotalMemory());
+
+    // the writer itself is flushed if its buffer is the largest one
+    flushed.clear();
+    ASSERT_OK(owner1.Write(60));
+    ASSERT_EQ(std::vector<FakeMemoryOwner*>({&owner1}), flushed);
+    ASSERT_EQ(25, manager.TotalMemory());
+    ASSERT_EQ(25, manager.MemoryOf(&owner3));
+}
+
+TEST(WriteMemoryManagerTest, TestFlushingMemory) {
+    WriteMemoryManager manager(/*budget=*/100);
+    std::vector<FakeMemoryOwner*> flushed;
+    FakeMemoryOwner owner1(&manager, &flushed);
+    FakeMemoryOwner owner2(&manager, &flushed);
+    owner1.flush_in_background_ = true;
+    ASSERT_OK(owner1.Write(60));
+    ASSERT_OK(owner2.Write(30));
+    // owner1 is flushed in background, its memory is still in use so owner2 is flushed too
+    ASSERT_OK(owner2.Write(20));
+    ASSERT_EQ(std::vector<FakeMemoryOwner*>({&owner1, &owner2}), flushed);
+    ASSERT_EQ(60, manager.TotalMemory());
+    ASSERT_EQ(0, manager.MemoryOf(&owner1));
+    ASSERT_EQ(60, manager.FlushingMemoryOf(&owner1));
+
+    // an owner in flushing is not picked again
+    flushed.clear();
+    ASSERT_OK(owner1.Write(30));
+    ASSERT_TRUE(flushed.empty());
+    ASSERT_EQ(90, manager.TotalMemory());
+
+    manager.ReleaseFlushing(&owner1);
+    ASSERT_EQ(30, manager.TotalMemory());
+    ASSERT_EQ(0, manager.FlushingMemoryOf(&owner1));
+    ASSERT_EQ(30, manager.MemoryOf(&owner1));
+
+    // release stops accounting the flushing memory as well
+    ASSERT_OK(owner1.Write(80));
+    ASSERT_EQ(std::vector<FakeMemoryOwner*>({&owner1}), flushed);
+    ASSERT_EQ(110, manager.TotalMemory());
+    manager.Release(&owner1);
+    ASSERT_EQ(0, manager.TotalMemory());
+}
+
+TEST(WriteMemoryManagerTest, TestFlushFailed) {
+    WriteMemoryManager manager(/*budget=*/100);
+    std::vector<FakeMemoryOwner*> flushed;
+    FakeMemoryOwner owner1(&manager, &flushed);
+    FakeMemoryOwner owner2(&manager, &flushed);
+    ASSERT_OK(owner1.Write(80));
+    owner1.flush_status_ = Status::IOError("mock flush error");
+    ASSERT_NOK_WITH_MSG(owner2.Write(30), "mock flush error");
+    ASSERT_TRUE(flushed.empty());
+    ASSERT_EQ(110, manager.TotalMemory());
+
+    owner1.flush_status_ = Status::OK();
+    owner1.release_on_flush_ = false;
+    ASSERT_NOK_WITH_MSG(owner2.Write(0), "write buffer is not released after flushing memory");
+}
+
+}  // namespace paimon::test
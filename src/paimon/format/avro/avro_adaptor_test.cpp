@@ -23,11 +23,15 @@
 #include "arrow/c/abi.h"
 #include "arrow/c/bridge.h"
 #include "arrow/ipc/json_simple.h"
+#include "avro/Decoder.hh"
+#include "avro/Encoder.hh"
+#include "avro/Generic.hh"
 #include "avro/GenericDatum.hh"
+#include "avro/Stream.hh"
 #include "gtest/gtest.h"
 #include "paimon/common/utils/arrow/mem_utils.h"
 #include "paimon/core/utils/manifest_meta_reader.h"
-#include "paimon/format/avro/avro_record_converter.h"
+#include "paimon/format/avro/avro_direct_decoder.h"
 #include "paimon/format/avro/avro_schema_converter.h"
 #include "paimon/memory/memory_pool.h"
 #include "paimon/status.h"
@@ -62,11 +66,25 @@ TEST(AvroAdaptorTest, Simple) {
     ASSERT_OK_AND_ASSIGN(std::vector<::avro::GenericDatum> datums,
                          adaptor.ConvertArrayToGenericDatums(array, avro_schema));
     ASSERT_EQ(4, datums.size());
-    ASSERT_OK_AND_ASSIGN(auto record_converter,
-                         AvroRecordConverter::Create(data_type, GetDefaultPool()));
-    auto read_batch_result = record_converter->NextBatch(datums);
-    ASSERT_OK(read_batch_result);
-    auto [c_array, c_schema] = std::move(read_batch_result).value();
+
+    // round trip through the avro binary encoding and the decoder of the reader
+    auto out = ::avro::memoryOutputStream();
+    ::avro::EncoderPtr encoder = ::avro::binaryEncoder();
+    encoder->init(*out);
+    for (const auto& datum : datums) {
+        ::avro::GenericWriter::write(*encoder, datum);
+    }
+    encoder->flush();
+    auto in = ::avro::memoryInputStream(*out);
+    ::avro::DecoderPtr decoder = ::avro::binaryDecoder();
+    decoder->init(*in);
+    ASSERT_OK_AND_ASSIGN(auto direct_decoder,
+                         AvroDirectDecoder::Create(avro_schema, data_type, GetDefaultPool()));
+    for (size_t i = 0; i < datums.size(); i++) {
+        ASSERT_OK(direct_decoder->Decode(decoder.get()));
+    }
+    ASSERT_OK_AND_ASSIGN(auto read_batch, direct_decoder->Finish());
+    auto [c_array, c_schema] = std::move(read_batch);
 
     auto arrow_array = arrow::ImportArray(c_array.get(), c_schema.get()).ValueOrDie();
     auto arrow_pool = GetArrowPool(GetDefaultPool());
@@ -0,0 +1,484 @@
+/*
+ * Copyright 2024-present Alibaba Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "paimon/format/avro/avro_direct_decoder.h"
+
+#include <cassert>
+#include <limits>
+#include <utility>
+
+#include "arrow/array/builder_binary.h"
+#include "arrow/array/builder_decimal.h"
+#include "arrow/array/builder_nested.h"
+#include "arrow/array/builder_primitive.h"
+#include "arrow/c/abi.h"
+#include "arrow/c/bridge.h"
+#include "arrow/util/checked_cast.h"
+#include "arrow/util/decimal.h"
+#include "avro/LogicalType.hh"
+#include "avro/NodeImpl.hh"
+#include "avro/Types.hh"
+#include "fmt/format.h"
+#include "paimon/common/utils/arrow/mem_utils.h"
+#include "paimon/common/utils/arrow/status_utils.h"
+#include "paimon/common/utils/date_time_utils.h"
+#include "paimon/data/timestamp.h"
+#include "paimon/format/avro/avro_schema_converter.h"
+#include "paimon/macros.h"
+#include "paimon/memory/memory_pool.h"
+#include "paimon/status.h"
+
+namespace paimon::avro {
+
+namespace {
+
+// avro stores tinyint and smallint as int, narrow them back to the read type
+template <typename BuilderType, typename CType>
+arrow::Status AppendNarrowedInt(BuilderType* builder, int32_t value) {
+    if (PAIMON_UNLIKELY(value < std::numeric_limits<CType>::min() ||
+                        value > std::numeric_limits<CType>::max())) {
+        return arrow::Status::Invalid(
+            fmt::format("avro int value {} overflows {}", value, builder->type()->ToString()));
+    }
+    return builder->Append(static_cast<CType>(value));
+}
+
+}  // namespace
+
+AvroDirectDecoder::AvroDirectDecoder(std::unique_ptr<arrow::MemoryPool>&& arrow_pool,
+                                     std::unique_ptr<arrow::StructBuilder>&& array_builder)
+    : arrow_pool_(std::move(arrow_pool)), array_builder_(std::move(array_builder)) {}
+
+Result<std::unique_ptr<AvroDirectDecoder>> AvroDirectDecoder::Create(
+    const ::avro::ValidSchema& file_schema, const std::shared_ptr<arrow::DataType>& read_type,
+    const std::shared_ptr<MemoryPool>& pool) {
+    if (read_type->id() != arrow::Type::type::STRUCT) {
+        return Status::Invalid(
+            fmt::format("avro read type must be struct, but is {}", read_type->ToString()));
+    }
+    auto arrow_pool = GetArrowPool(pool);
+    std::unique_ptr<arrow::ArrayBuilder> array_builder;
+    PAIMON_RETURN_NOT_OK_FROM_ARROW(
+        arrow::MakeBuilder(arrow_pool.get(), read_type, &array_builder));
+    auto struct_builder =
+        arrow::internal::checked_pointer_cast<arrow::StructBuilder>(std::move(array_builder));
+    assert(struct_builder);
+    auto decoder = std::unique_ptr<AvroDirectDecoder>(
+        new AvroDirectDecoder(std::move(arrow_pool), std::move(struct_builder)));
+    PAIMON_ASSIGN_OR_RAISE(decoder->decode_func_, decoder->CompileRoot(file_schema.root()));
+    return decoder;
+}
+
+Status AvroDirectDecoder::Decode(::avro::Decoder* decoder) {
+    PAIMON_RETURN_NOT_OK_FROM_ARROW(decode_func_(decoder));
+    return Status::OK();
+}
+
+Result<BatchReader::ReadBatch> AvroDirectDecoder::Finish() {
+    std::shared_ptr<arrow::Array> array;
+    PAIMON_RETURN_NOT_OK_FROM_ARROW(array_builder_->Finish(&array));
+    auto c_array = std::make_unique<ArrowArray>();
+    auto c_schema = std::make_unique<ArrowSchema>();
+    PAIMON_RETURN_NOT_OK_FROM_ARROW(arrow::ExportArray(*array, c_array.get(), c_schema.get()));
+    return std::make_pair(std::move(c_array), std::move(c_schema));
+}
+
+Result<AvroDirectDecoder::DecodeFunc> AvroDirectDecoder::CompileRoot(
+    const ::avro::NodePtr& avro_node) {
+    PAIMON_ASSIGN_OR_RAISE(bool is_union, AvroSchemaConverter::CheckUnionType(avro_node));
+    ::avro::NodePtr record_node = is_union ? avro_node->leafAt(1) : avro_node;
+    if (PAIMON_UNLIKELY(record_node->type() != ::avro::AVRO_RECORD)) {
+        return Status::Invalid("Avro schema root node is not a record type");
+    }
+    PAIMON_ASSIGN_OR_RAISE(DecodeFunc record_func,
+                           CompileRecord(record_node, array_builder_.get()));
+    if (!is_union) {
+        return record_func;
+    }
+    return DecodeFunc([record_func](::avro::Decoder* decoder) -> arrow::Status {
+        if (decoder->decodeUnionIndex() == 0) {
+            return arrow::Status::Invalid("invalid datum type: null, root datum must be a record");
+        }
+        return record_func(decoder);
+    });
+}
+
+Result<AvroDirectDecoder::DecodeFunc> AvroDirectDecoder::CompileNode(
+    const ::avro::NodePtr& avro_node, arrow::ArrayBuilder* builder) {
+    PAIMON_ASSIGN_OR_RAISE(bool is_union, AvroSchemaConverter::CheckUnionType(avro_node));
+    if (!is_union) {
+        return CompileValue(avro_node, builder);
+    }
+    PAIMON_ASSIGN_OR_RAISE(DecodeFunc value_func, CompileValue(avro_node->leafAt(1), builder));
+    return DecodeFunc([builder, value_func](::avro::Decoder* decoder) -> arrow::Status {
+        if (decoder->decodeUnionIndex() == 0) {
+            decoder->decodeNull();
+            return builder->AppendNull();
+        }
+        return value_func(decoder);
+    });
+}
+
+Result<AvroDirectDecoder::DecodeFunc> AvroDirectDecoder::CompileValue(
+    const ::avro::NodePtr& avro_node, arrow::ArrayBuilder* builder) {
+    auto type = avro_node->type();
+    arrow::Type::type read_type = builder->type()->id();
+    auto logical_type = avro_node->logicalType();
+    switch (logical_type.type()) {
+        case ::avro::LogicalType::Type::NONE:
+            break;
+        case ::avro::LogicalType::Type::DATE: {
+            if (type != ::avro::AVRO_INT || read_type != arrow::Type::type::DATE32) {
+                return TypeMismatch(avro_node, builder);
+            }
+            auto* field_builder = arrow::internal::checked_cast<arrow::Date32Builder*>(builder);
+            return DecodeFunc([field_builder](::avro::Decoder* decoder) -> arrow::Status {
+                return field_builder->Append(decoder->decodeInt());
+            });
+        }
+        case ::avro::LogicalType::Type::DECIMAL: {
+            if (type != ::avro::AVRO_BYTES || read_type != arrow::Type::type::DECIMAL128) {
+                return TypeMismatch(avro_node, builder);
+            }
+            auto* field_builder =
+                arrow::internal::checked_cast<arrow::Decimal128Builder*>(builder);
+            const auto& decimal_type =
+                arrow::internal::checked_cast<const arrow::Decimal128Type&>(*builder->type());
+            if (decimal_type.precision() != logical_type.precision() ||
+                decimal_type.scale() != logical_type.scale()) {
+                return TypeMismatch(avro_node, builder);
+            }
+            std::vector<uint8_t>* buffer = &bytes_buffer_;
+            return DecodeFunc([field_builder, buffer](::avro::Decoder* decoder) -> arrow::Status {
+                // unscaled value in big-endian two's complement
+                decoder->decodeBytes(*buffer);
+                if (buffer->empty()) {
+                    return field_builder->Append(arrow::Decimal128(0));
+                }
+                ARROW_ASSIGN_OR_RAISE(
+                    arrow::Decimal128 value,
+                    arrow::Decimal128::FromBigEndian(buffer->data(),
+                                                     static_cast<int32_t>(buffer->size())));
+                return field_builder->Append(value);
+            });
+        }
+        case ::avro::LogicalType::Type::TIMESTAMP_MILLIS:
+        case ::avro::LogicalType::Type::TIMESTAMP_MICROS:
+        case ::avro::LogicalType::Type::TIMESTAMP_NANOS:
+        case ::avro::LogicalType::Type::LOCAL_TIMESTAMP_MILLIS:
+        case ::avro::LogicalType::Type::LOCAL_TIMESTAMP_MICROS:
+        case ::avro::LogicalType::Type::LOCAL_TIMESTAMP_NANOS:
+            return CompileTimestamp(avro_node, builder);
+        default:
+            return Status::NotImplemented("not support logical type ",
+                                          std::to_string(logical_type.type()));
+    }
+
+    switch (type) {
+        case ::avro::AVRO_BOOL: {
+            if (read_type != arrow::Type::type::BOOL) {
+                return TypeMismatch(avro_node, builder);
+            }
+            auto* field_builder = arrow::internal::checked_cast<arrow::BooleanBuilder*>(builder);
+            return DecodeFunc([field_builder](::avro::Decoder* decoder) -> arrow::Status {
+                return field_builder->Append(decoder->decodeBool());
+            });
+        }
+        case ::avro::AVRO_INT: {
+            if (read_type == arrow::Type::type::INT8) {
+                auto* field_builder = arrow::internal::checked_cast<arrow::Int8Builder*>(builder);
+                return DecodeFunc([field_builder](::avro::Decoder* decoder) -> arrow::Status {
+                    return AppendNarrowedInt<arrow::Int8Builder, int8_t>(field_builder,
+                                                                         decoder->decodeInt());
+                });
+            } else if (read_type == arrow::Type::type::INT16) {
+                auto* field_builder = arrow::internal::checked_cast<arrow::Int16Builder*>(builder);
+                return DecodeFunc([field_builder](::avro::Decoder* decoder) -> arrow::Status {
+                    return AppendNarrowedInt<arrow::Int16Builder, int16_t>(field_builder,
+                                                                           decoder->decodeInt());
+                });
+            } else if (read_type == arrow::Type::type::INT32) {
+                auto* field_builder = arrow::internal::checked_cast<arrow::Int32Builder*>(builder);
+                return DecodeFunc([field_builder](::avro::Decoder* decoder) -> arrow::Status {
+                    return field_builder->Append(decoder->decodeInt());
+                });
+            }
+            return TypeMismatch(avro_node, builder);
+        }
+        case ::avro::AVRO_LONG: {
+            if (read_type != arrow::Type::type::INT64) {
+                return TypeMismatch(avro_node, builder);
+            }
+            auto* field_builder = arrow::internal::checked_cast<arrow::Int64Builder*>(builder);
+            return DecodeFunc([field_builder](::avro::Decoder* decoder) -> arrow::Status {
+                return field_builder->Append(decoder->decodeLong());
+            });
+        }
+        case ::avro::AVRO_FLOAT: {
+            if (read_type != arrow::Type::type::FLOAT) {
+                return TypeMismatch(avro_node, builder);
+            }
+            auto* field_builder = arrow::internal::checked_cast<arrow::FloatBuilder*>(builder);
+            return DecodeFunc([field_builder](::avro::Decoder* decoder) -> arrow::Status {
+                return field_builder->Append(decoder->decodeFloat());
+            });
+        }
+        case ::avro::AVRO_DOUBLE: {
+            if (read_type != arrow::Type::type::DOUBLE) {
+                return TypeMismatch(avro_node, builder);
+            }
+            auto* field_builder = arrow::internal::checked_cast<arrow::DoubleBuilder*>(builder);
+            return DecodeFunc([field_builder](::avro::Decoder* decoder) -> arrow::Status {
+                return field_builder->Append(decoder->decodeDouble());
+            });
+        }
+        case ::avro::AVRO_STRING: {
+            if (read_type != arrow::Type::type::STRING) {
+                return TypeMismatch(avro_node, builder);
+            }
+            auto* field_builder = arrow::internal::checked_cast<arrow::BinaryBuilder*>(builder);
+            std::string* buffer = &string_buffer_;
+            return DecodeFunc([field_builder, buffer](::avro::Decoder* decoder) -> arrow::Status {
+                decoder->decodeString(*buffer);
+                return field_builder->Append(buffer->data(), buffer->size());
+            });
+        }
+        case ::avro::AVRO_BYTES: {
+            if (read_type != arrow::Type::type::BINARY) {
+                return TypeMismatch(avro_node, builder);
+            }
+            auto* field_builder = arrow::internal::checked_cast<arrow::BinaryBuilder*>(builder);
+            std::vector<uint8_t>* buffer = &bytes_buffer_;
+            return DecodeFunc([field_builder, buffer](::avro::Decoder* decoder) -> arrow::Status {
+                decoder->decodeBytes(*buffer);
+                return field_builder->Append(buffer->data(), buffer->size());
+            });
+        }
+        case ::avro::AVRO_ARRAY: {
+            if (read_type != arrow::Type::type::LIST) {
+                return TypeMismatch(avro_node, builder);
+            }
+            auto* list_builder = arrow::internal::checked_cast<arrow::ListBuilder*>(builder);
+            PAIMON_ASSIGN_OR_RAISE(
+                DecodeFunc value_func,
+                CompileNode(avro_node->leafAt(0), list_builder->value_builder()));
+            return DecodeFunc(
+                [list_builder, value_func](::avro::Decoder* decoder) -> arrow::Status {
+                    ARROW_RETURN_NOT_OK(list_builder->Append());
+                    for (size_t n = decoder->arrayStart(); n != 0; n = decoder->arrayNext()) {
+                        for (size_t i = 0; i < n; i++) {
+                            ARROW_RETURN_NOT_OK(value_func(decoder));
+                        }
+                    }
+                    return arrow::Status::OK();
+                });
+        }
+        case ::avro::AVRO_MAP: {
+            if (read_type != arrow::Type::type::MAP) {
+                return TypeMismatch(avro_node, builder);
+            }
+            auto* map_builder = arrow::internal::checked_cast<arrow::MapBuilder*>(builder);
+            PAIMON_ASSIGN_OR_RAISE(DecodeFunc key_func,
+                                   CompileNode(avro_node->leafAt(0), map_builder->key_builder()));
+            PAIMON_ASSIGN_OR_RAISE(DecodeFunc item_func,
+                                   CompileNode(avro_node->leafAt(1), map_builder->item_builder()));
+            return DecodeFunc(
+                [map_builder, key_func, item_func](::avro::Decoder* decoder) -> arrow::Status {
+                    ARROW_RETURN_NOT_OK(map_builder->Append());
+                    for (size_t n = decoder->mapStart(); n != 0; n = decoder->mapNext()) {
+                        for (size_t i = 0; i < n; i++) {
+                            ARROW_RETURN_NOT_OK(key_func(decoder));
+                            ARROW_RETURN_NOT_OK(item_func(decoder));
+                        }
+                    }
+                    return arrow::Status::OK();
+                });
+        }
+        case ::avro::AVRO_RECORD: {
+            if (read_type != arrow::Type::type::STRUCT) {
+                return TypeMismatch(avro_node, builder);
+            }
+            return CompileRecord(avro_node,
+                                 arrow::internal::checked_cast<arrow::StructBuilder*>(builder));
+        }
+        default:
+            return Status::TypeError("Unknown Avro type kind: ", toString(type));
+    }
+}
+
+Result<AvroDirectDecoder::DecodeFunc> AvroDirectDecoder::CompileRecord(
+    const ::avro::NodePtr& avro_node, arrow::StructBuilder* builder) {
+    const auto& struct_type = arrow::internal::checked_cast<const arrow::StructType&>(
+        *builder->type());
+    std::vector<bool> matched(struct_type.num_fields(), false);
+    // fields must be decoded in the order of the file schema, whatever the read order is
+    std::vector<DecodeFunc> field_funcs;
+    field_funcs.reserve(avro_node->leaves());
+    for (size_t i = 0; i < avro_node->leaves(); i++) {
+        int32_t read_index = struct_type.GetFieldIndex(avro_node->nameAt(i));
+        if (read_index < 0) {
+            field_funcs.push_back(CompileSkip(avro_node->leafAt(i)));
+            continue;
+        }
+        PAIMON_ASSIGN_OR_RAISE(
+            DecodeFunc field_func,
+            CompileNode(avro_node->leafAt(i), builder->field_builder(read_index)));
+        field_funcs.push_back(std::move(field_func));
+        matched[read_index] = true;
+    }
+    for (int32_t i = 0; i < struct_type.num_fields(); i++) {
+        if (!matched[i]) {
+            return Status::Invalid(fmt::format("field {} of read type {} not found in avro file",
+                                               struct_type.field(i)->name(),
+                                               struct_type.ToString()));
+        }
+    }
+    return DecodeFunc([builder, field_funcs](::avro::Decoder* decoder) -> arrow::Status {
+        ARROW_RETURN_NOT_OK(builder->Append());
+        for (const auto& field_func : field_funcs) {
+            ARROW_RETURN_NOT_OK(field_func(decoder));
+        }
+        return arrow::Status::OK();
+    });
+}
+
+Result<AvroDirectDecoder::DecodeFunc> AvroDirectDecoder::CompileTimestamp(
+    const ::avro::NodePtr& avro_node, arrow::ArrayBuilder* builder) {
+    if (avro_node->type() != ::avro::AVRO_LONG ||
+        builder->type()->id() != arrow::Type::type::TIMESTAMP) {
+        return TypeMismatch(avro_node, builder);
+    }
+    DateTimeUtils::TimeType src_type;
+    switch (avro_node->logicalType().type()) {
+        case ::avro::LogicalType::Type::TIMESTAMP_MILLIS:
+        case ::avro::LogicalType::Type::LOCAL_TIMESTAMP_MILLIS:
+            src_type = DateTimeUtils::MILLISECOND;
+            break;
+        case ::avro::LogicalType::Type::TIMESTAMP_MICROS:
+        case ::avro::LogicalType::Type::LOCAL_TIMESTAMP_MICROS:
+            src_type = DateTimeUtils::MICROSECOND;
+            break;
+        default:
+            src_type = DateTimeUtils::NANOSECOND;
+            break;
+    }
+    auto* field_builder = arrow::internal::checked_cast<arrow::TimestampBuilder*>(builder);
+    auto ts_type = arrow::internal::checked_pointer_cast<arrow::TimestampType>(builder->type());
+    DateTimeUtils::TimeType dst_type = DateTimeUtils::GetTimeTypeFromArrowType(ts_type);
+    if (src_type == dst_type) {
+        return DecodeFunc([field_builder](::avro::Decoder* decoder) -> arrow::Status {
+            return field_builder->Append(decoder->decodeLong());
+        });
+    }
+    // e.g., a timestamp with second precision is stored as millis in avro
+    return DecodeFunc(
+        [field_builder, src_type, dst_type](::avro::Decoder* decoder) -> arrow::Status {
+            auto [millisecond, nano_of_millisecond] = DateTimeUtils::TimestampConverter(
+                decoder->decodeLong(), src_type, DateTimeUtils::MILLISECOND,
+                DateTimeUtils::NANOSECOND);
+            Timestamp timestamp(millisecond, static_cast<int32_t>(nano_of_millisecond));
+            return field_builder->Append(DateTimeUtils::TimestampToInteger(timestamp, dst_type));
+        });
+}
+
+AvroDirectDecoder::DecodeFunc AvroDirectDecoder::CompileSkip(const ::avro::NodePtr& avro_node) {
+    // skipped values are walked on the schema at runtime, which also copes with recursive types
+    return DecodeFunc([avro_node](::avro::Decoder* decoder) -> arrow::Status {
+        return SkipValue(avro_node, decoder);
+    });
+}
+
+arrow::Status AvroDirectDecoder::SkipValue(const ::avro::NodePtr& avro_node,
+                                           ::avro::Decoder* decoder) {
+    switch (avro_node->type()) {
+        case ::avro::AVRO_NULL:
+            decoder->decodeNull();
+            break;
+        case ::avro::AVRO_BOOL:
+            decoder->decodeBool();
+            break;
+        case ::avro::AVRO_INT:
+            decoder->decodeInt();
+            break;
+        case ::avro::AVRO_LONG:
+            decoder->decodeLong();
+            break;
+        case ::avro::AVRO_FLOAT:
+            decoder->decodeFloat();
+            break;
+        case ::avro::AVRO_DOUBLE:
+            decoder->decodeDouble();
+            break;
+        case ::avro::AVRO_STRING:
+            decoder->skipString();
+            break;
+        case ::avro::AVRO_BYTES:
+            decoder->skipBytes();
+            break;
+        case ::avro::AVRO_FIXED:
+            decoder->skipFixed(avro_node->fixedSize());
+            break;
+        case ::avro::AVRO_ENUM:
+            decoder->decodeEnum();
+            break;
+        case ::avro::AVRO_ARRAY:
+            // skipArray() skips whole blocks when their byte size is known, otherwise returns the
+            // number of items which must be skipped one by one
+            for (size_t n = decoder->skipArray(); n != 0; n = decoder->skipArray()) {
+                for (size_t i = 0; i < n; i++) {
+                    ARROW_RETURN_NOT_OK(SkipValue(avro_node->leafAt(0), decoder));
+                }
+            }
+            break;
+        case ::avro::AVRO_MAP:
+            for (size_t n = decoder->skipMap(); n != 0; n = decoder->skipMap()) {
+                for (size_t i = 0; i < n; i++) {
+                    decoder->skipString();
+                    ARROW_RETURN_NOT_OK(SkipValue(avro_node->leafAt(1), decoder));
+                }
+            }
+            break;
+        case ::avro::AVRO_RECORD:
+            for (size_t i = 0; i < avro_node->leaves(); i++) {
+                ARROW_RETURN_NOT_OK(SkipValue(avro_node->leafAt(i), decoder));
+            }
+            break;
+        case ::avro::AVRO_UNION: {
+            size_t branch = decoder->decodeUnionIndex();
+            if (PAIMON_UNLIKELY(branch >= avro_node->leaves())) {
+                return arrow::Status::Invalid(
+                    fmt::format("invalid avro union branch {} of {} branches", branch,
+                                avro_node->leaves()));
+            }
+            return SkipValue(avro_node->leafAt(branch), decoder);
+        }
+        case ::avro::AVRO_SYMBOLIC:
+            return SkipValue(::avro::resolveSymbol(avro_node), decoder);
+        default:
+            return arrow::Status::TypeError(
+                fmt::format("Unknown Avro type kind: {}", toString(avro_node->type())));
+    }
+    return arrow::Status::OK();
+}
+
+Status AvroDirectDecoder::TypeMismatch(const ::avro::NodePtr& avro_node,
+                                       const arrow::ArrayBuilder* builder) {
+    return Status::TypeError(fmt::format("cannot read avro type {} as {}",
+                                         ::avro::toString(avro_node->type()),
+                                         builder->type()->ToString()));
+}
+
+}  // namespace paimon::avro
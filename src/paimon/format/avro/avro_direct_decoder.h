@@ -0,0 +1,91 @@
+/*
+ * Copyright 2024-present Alibaba Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "arrow/api.h"
+#include "avro/Decoder.hh"
+#include "avro/Node.hh"
+#include "avro/ValidSchema.hh"
+#include "paimon/reader/batch_reader.h"
+#include "paimon/result.h"
+
+namespace paimon {
+class MemoryPool;
+}  // namespace paimon
+
+namespace paimon::avro {
+
+/// Decodes avro binary records straight into arrow builders.
+///
+/// The decoding plan is compiled once from the writer schema of the file and the read type,
+/// so decoding needs neither an intermediate `::avro::GenericDatum` per record nor a schema
+/// walk per value. Fields of the file which are not in the read type are skipped in the binary
+/// stream without being materialized, nested records can be projected as well.
+class AvroDirectDecoder {
+ public:
+    /// @param file_schema The writer schema of the avro file.
+    /// @param read_type The struct type to read, its fields are matched by name with the fields
+    /// of the file schema.
+    static Result<std::unique_ptr<AvroDirectDecoder>> Create(
+        const ::avro::ValidSchema& file_schema, const std::shared_ptr<arrow::DataType>& read_type,
+        const std::shared_ptr<MemoryPool>& pool);
+
+    /// Decodes the next record from `decoder` and appends it to the current batch.
+    Status Decode(::avro::Decoder* decoder);
+
+    /// Finishes the current batch, the decoder is ready for the next batch afterwards.
+    Result<BatchReader::ReadBatch> Finish();
+
+    int64_t Length() const {
+        return array_builder_->length();
+    }
+
+ private:
+    using DecodeFunc = std::function<arrow::Status(::avro::Decoder* decoder)>;
+
+    AvroDirectDecoder(std::unique_ptr<arrow::MemoryPool>&& arrow_pool,
+                      std::unique_ptr<arrow::StructBuilder>&& array_builder);
+
+    Result<DecodeFunc> CompileRoot(const ::avro::NodePtr& avro_node);
+    Result<DecodeFunc> CompileNode(const ::avro::NodePtr& avro_node, arrow::ArrayBuilder* builder);
+    Result<DecodeFunc> CompileValue(const ::avro::NodePtr& avro_node, arrow::ArrayBuilder* builder);
+    Result<DecodeFunc> CompileRecord(const ::avro::NodePtr& avro_node,
+                                     arrow::StructBuilder* builder);
+    Result<DecodeFunc> CompileTimestamp(const ::avro::NodePtr& avro_node,
+                                        arrow::ArrayBuilder* builder);
+
+    static DecodeFunc CompileSkip(const ::avro::NodePtr& avro_node);
+    static arrow::Status SkipValue(const ::avro::NodePtr& avro_node, ::avro::Decoder* decoder);
+
+    static Status TypeMismatch(const ::avro::NodePtr& avro_node,
+                               const arrow::ArrayBuilder* builder);
+
+    std::unique_ptr<arrow::MemoryPool> arrow_pool_;
+    std::unique_ptr<arrow::StructBuilder> array_builder_;
+    DecodeFunc decode_func_;
+    // reused by string, bytes and decimal values to avoid an allocation per value
+    std::string string_buffer_;
+    std::vector<uint8_t> bytes_buffer_;
+};
+
+}  // namespace paimon::avro
@@ -0,0 +1,175 @@
+/*
+ * Copyright 2024-present Alibaba Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "paimon/format/avro/avro_direct_decoder.h"
+
+#include <memory>
+#include <string>
+#include <utility>
+
+#include "arrow/api.h"
+#include "arrow/c/abi.h"
+#include "arrow/c/bridge.h"
+#include "arrow/ipc/json_simple.h"
+#include "avro/Compiler.hh"
+#include "avro/Decoder.hh"
+#include "avro/Encoder.hh"
+#include "avro/Stream.hh"
+#include "avro/ValidSchema.hh"
+#include "gtest/gtest.h"
+#include "paimon/format/avro/avro_schema_converter.h"
+#include "paimon/memory/memory_pool.h"
+#include "paimon/status.h"
+#include "paimon/testing/utils/testharness.h"
+
+namespace paimon::avro::test {
+
+class AvroDirectDecoderTest : public ::testing::Test {
+ public:
+    void SetUp() override {
+        file_schema_ = ::avro::compileJsonSchemaFromString(R"({
+            "type": "record", "name": "record", "fields": [
+                {"name": "f0", "type": "int"},
+                {"name": "f1", "type": ["null", "string"]},
+                {"name": "f2", "type": {"type": "array", "items": "long"}},
+                {"name": "f3", "type": {"type": "map", "values": ["null", "int"]}},
+                {"name": "f4", "type": {"type": "record", "name": "inner", "fields": [
+                    {"name": "a", "type": "boolean"},
+                    {"name": "b", "type": "double"}]}},
+                {"name": "f5", "type": {"type": "long", "logicalType": "timestamp-millis"}}
+            ]})");
+
+        out_ = ::avro::memoryOutputStream();
+        ::avro::EncoderPtr encoder = ::avro::binaryEncoder();
+        encoder->init(*out_);
+        // [1, "a", [1, 2], {"k": 7}, {true, 1.5}, 1500]
+        encoder->encodeInt(1);
+        encoder->encodeUnionIndex(1);
+        encoder->encodeString("a");
+        encoder->arrayStart();
+        encoder->setItemCount(2);
+        encoder->startItem();
+        encoder->encodeLong(1);
+        encoder->startItem();
+        encoder->encodeLong(2);
+        encoder->arrayEnd();
+        encoder->mapStart();
+        encoder->setItemCount(1);
+        encoder->startItem();
+        encoder->encodeString("k");
+        encoder->encodeUnionIndex(1);
+        encoder->encodeInt(7);
+        encoder->mapEnd();
+        encoder->encodeBool(true);
+        encoder->encodeDouble(1.5);
+        encoder->encodeLong(1500);
+        // [-2, null, [], {"x": null}, {false, 2.5}, 3000]
+        encoder->encodeInt(-2);
+        encoder->encodeUnionIndex(0);
+        encoder->encodeNull();
+        encoder->arrayStart();
+        encoder->arrayEnd();
+        encoder->mapStart();
+        encoder->setItemCount(1);
+        encoder->startItem();
+        encoder->encodeString("x");
+        encoder->encodeUnionIndex(0);
+        encoder->encodeNull();
+        encoder->mapEnd();
+        encoder->encodeBool(false);
+        encoder->encodeDouble(2.5);
+        encoder->encodeLong(3000);
+        encoder->flush();
+    }
+
+    std::shared_ptr<arrow::Array> DecodeAll(AvroDirectDecoder* direct_decoder) const {
+        auto in = ::avro::memoryInputStream(*out_);
+        ::avro::DecoderPtr decoder = ::avro::binaryDecoder();
+        decoder->init(*in);
+        for (int32_t i = 0; i < 2; i++) {
+            EXPECT_OK(direct_decoder->Decode(decoder.get()));
+        }
+        EXPECT_EQ(2, direct_decoder->Length());
+        EXPECT_OK_AND_ASSIGN(auto read_batch, direct_decoder->Finish());
+        EXPECT_EQ(0, direct_decoder->Length());
+        auto [c_array, c_schema] = std::move(read_batch);
+        return arrow::ImportArray(c_array.get(), c_schema.get()).ValueOrDie();
+    }
+
+ protected:
+    ::avro::ValidSchema file_schema_;
+    std::unique_ptr<::avro::OutputStream> out_;
+};
+
+TEST_F(AvroDirectDecoderTest, TestReadAllFields) {
+    ASSERT_OK_AND_ASSIGN(std::shared_ptr<arrow::DataType> read_type,
+                         AvroSchemaConverter::AvroSchemaToArrowDataType(file_schema_));
+    ASSERT_OK_AND_ASSIGN(auto direct_decoder,
+                         AvroDirectDecoder::Create(file_schema_, read_type, GetDefaultPool()));
+    auto expected = arrow::ipc::internal::json::ArrayFromJSON(read_type, R"([
+        [1, "a", [1, 2], [["k", 7]], [true, 1.5], 1500],
+        [-2, null, [], [["x", null]], [false, 2.5], 3000]
+    ])")
+                        .ValueOrDie();
+    // decoder is reusable after a batch is finished
+    for (int32_t round = 0; round < 2; round++) {
+        auto result = DecodeAll(direct_decoder.get());
+        ASSERT_TRUE(expected->Equals(result)) << result->ToString();
+    }
+}
+
+TEST_F(AvroDirectDecoderTest, TestProjection) {
+    // reorder fields, skip f0, f2, f3 and f4.a, and read timestamp stored as millis as seconds
+    auto read_type = arrow::struct_(
+        {arrow::field("f5", arrow::timestamp(arrow::TimeUnit::SECOND)),
+         arrow::field("f4", arrow::struct_({arrow::field("b", arrow::float64())})),
+         arrow::field("f1", arrow::utf8())});
+    ASSERT_OK_AND_ASSIGN(auto direct_decoder,
+                         AvroDirectDecoder::Create(file_schema_, read_type, GetDefaultPool()));
+    auto result = DecodeAll(direct_decoder.get());
+    auto expected = arrow::ipc::internal::json::ArrayFromJSON(read_type, R"([
+        [1, [1.5], "a"],
+        [3, [2.5], null]
+    ])")
+                        .ValueOrDie();
+    ASSERT_TRUE(expected->Equals(result)) << result->ToString();
+}
+
+TEST_F(AvroDirectDecoderTest, TestReadNarrowInt) {
+    for (const auto& type : {arrow::int8(), arrow::int16()}) {
+        auto read_type = arrow::struct_({arrow::field("f0", type)});
+        ASSERT_OK_AND_ASSIGN(auto direct_decoder,
+                             AvroDirectDecoder::Create(file_schema_, read_type, GetDefaultPool()));
+        auto result = DecodeAll(direct_decoder.get());
+        auto expected =
+            arrow::ipc::internal::json::ArrayFromJSON(read_type, "[[1], [-2]]").ValueOrDie();
+        ASSERT_TRUE(expected->Equals(result)) << result->ToString();
+    }
+}
+
+TEST_F(AvroDirectDecoderTest, TestInvalidReadType) {
+    auto pool = GetDefaultPool();
+    auto missing_field = arrow::struct_({arrow::field("f9", arrow::int32())});
+    ASSERT_NOK_WITH_MSG(AvroDirectDecoder::Create(file_schema_, missing_field, pool),
+                        "field f9 of read type");
+    auto mismatched_type = arrow::struct_({arrow::field("f0", arrow::utf8())});
+    ASSERT_NOK_WITH_MSG(AvroDirectDecoder::Create(file_schema_, mismatched_type, pool),
+                        "cannot read avro type int as string");
+    ASSERT_NOK_WITH_MSG(AvroDirectDecoder::Create(file_schema_, arrow::int32(), pool),
+                        "avro read type must be struct");
+}
+
+}  // namespace paimon::avro::test
@@ -21,8 +21,8 @@
 #include <vector>
 
 #include "arrow/c/bridge.h"
-#include "avro/Generic.hh"
-#include "avro/GenericDatum.hh"
+#include "avro/Decoder.hh"
+#include "avro/Exception.hh"
 #include "fmt/format.h"
 #include "paimon/common/utils/arrow/status_utils.h"
 #include "paimon/format/avro/avro_schema_converter.h"
@@ -30,12 +30,14 @@
 
 namespace paimon::avro {
 
-AvroFileBatchReader::AvroFileBatchReader(
-    std::unique_ptr<::avro::DataFileReader<::avro::GenericDatum>>&& reader,
-    std::unique_ptr<AvroRecordConverter>&& record_converter, int32_t batch_size)
+AvroFileBatchReader::AvroFileBatchReader(std::unique_ptr<::avro::DataFileReaderBase>&& reader,
+                                         std::unique_ptr<AvroDirectDecoder>&& decoder,
+                                         int32_t batch_size,
+                                         const std::shared_ptr<MemoryPool>& pool)
     : reader_(std::move(reader)),
-      record_converter_(std::move(record_converter)),
-      batch_size_(batch_size) {}
+      decoder_(std::move(decoder)),
+      batch_size_(batch_size),
+      pool_(pool) {}
 
 AvroFileBatchReader::~AvroFileBatchReader() {
     DoClose();
@@ -49,44 +51,37 @@ void AvroFileBatchReader::DoClose() {
 }
 
 Result<std::unique_ptr<AvroFileBatchReader>> AvroFileBatchReader::Create(
-    std::unique_ptr<::avro::DataFileReader<::avro::GenericDatum>>&& reader, int32_t batch_size,
+    std::unique_ptr<::avro::DataFileReaderBase>&& reader, int32_t batch_size,
     const std::shared_ptr<MemoryPool>& pool) {
     if (batch_size <= 0) {
         return Status::Invalid(
             fmt::format("invalid batch size {}, must be larger than 0", batch_size));
     }
-    const auto& avro_read_schema = reader->readerSchema();
+    // records are decoded with the writer schema, read all fields of the file by default
+    const auto& avro_file_schema = reader->dataSchema();
     PAIMON_ASSIGN_OR_RAISE(std::shared_ptr<::arrow::DataType> arrow_data_type,
-                           AvroSchemaConverter::AvroSchemaToArrowDataType(avro_read_schema));
-    PAIMON_ASSIGN_OR_RAISE(std::unique_ptr<AvroRecordConverter> record_converter,
-                           AvroRecordConverter::Create(arrow_data_type, pool));
+                           AvroSchemaConverter::AvroSchemaToArrowDataType(avro_file_schema));
+    PAIMON_ASSIGN_OR_RAISE(std::unique_ptr<AvroDirectDecoder> decoder,
+                           AvroDirectDecoder::Create(avro_file_schema, arrow_data_type, pool));
     return std::unique_ptr<AvroFileBatchReader>(
-        new AvroFileBatchReader(std::move(reader), std::move(record_converter), batch_size));
+        new AvroFileBatchReader(std::move(reader), std::move(decoder), batch_size, pool));
 }
 
 Result<BatchReader::ReadBatch> AvroFileBatchReader::NextBatch() {
-    std::vector<::avro::GenericDatum> datums;
-    datums.reserve(batch_size_);
     try {
+        ::avro::Decoder& decoder = reader_->decoder();
         for (int32_t i = 0; i < batch_size_; i++) {
-            ::avro::GenericDatum datum(reader_->readerSchema());
-            if (!reader_->read(datum)) {
+            if (!reader_->hasMore()) {
                 // reach eof
                 break;
             }
-            if (datum.type() != ::avro::AVRO_RECORD) {
-                return Status::Invalid(
-                    fmt::format("avro reader next batch failed. invalid datum type: {}",
-                                ::avro::toString(datum.type())));
-            }
-            datums.emplace_back(datum);
+            reader_->decr();
+            PAIMON_RETURN_NOT_OK(decoder_->Decode(&decoder));
         }
-        if (datums.empty()) {
+        if (decoder_->Length() == 0) {
             return BatchReader::MakeEofBatch();
         }
-        // TODO(jinli.zjw) when support SetReadSchema(), may need convert file timestamp (milli) to
-        // target read type timestamp(second)
-        return record_converter_->NextBatch(datums);
+        return decoder_->Finish();
     } catch (const ::avro::Exception& e) {
         return Status::Invalid(fmt::format("avro reader next batch failed. {}", e.what()));
     } catch (const std::exception& e) {
@@ -99,8 +94,27 @@ Result<BatchReader::ReadBatch> AvroFileBatchReader::NextBatch() {
 Status AvroFileBatchReader::SetReadSchema(::ArrowSchema* read_schema,
                                           const std::shared_ptr<Predicate>& predicate,
                                           const std::optional<RoaringBitmap32>& selection_bitmap) {
-    assert(false);
-    return Status::NotImplemented("avro reader not support set read schema");
+    if (!read_schema) {
+        return Status::Invalid("SetReadSchema failed: read schema cannot be nullptr");
+    }
+    if (selection_bitmap) {
+        return Status::NotImplemented("avro reader not support selection bitmap");
+    }
+    PAIMON_ASSIGN_OR_RAISE_FROM_ARROW(std::shared_ptr<arrow::Schema> arrow_schema,
+                                      arrow::ImportSchema(read_schema));
+    try {
+        PAIMON_ASSIGN_OR_RAISE(decoder_,
+                               AvroDirectDecoder::Create(reader_->dataSchema(),
+                                                         arrow::struct_(arrow_schema->fields()),
+                                                         pool_));
+    } catch (const ::avro::Exception& e) {
+        return Status::Invalid(fmt::format("avro reader set read schema failed. {}", e.what()));
+    } catch (const std::exception& e) {
+        return Status::Invalid(fmt::format("avro reader set read schema failed. {}", e.what()));
+    } catch (...) {
+        return Status::Invalid("avro reader set read schema failed. unknown error");
+    }
+    return Status::OK();
 }
 
 Result<std::unique_ptr<::ArrowSchema>> AvroFileBatchReader::GetFileSchema() const {
@@ -200,6 +200,46 @@ TEST_F(AvroFileBatchReaderTest, TestReadAllTypes) {
     ASSERT_TRUE(expected_array->Equals(result_array)) << result_array->ToString();
 }
 
+TEST_F(AvroFileBatchReaderTest, TestSetReadSchema) {
+    std::string file_path = PathUtil::JoinPath(dir_->Str(), "file.avro");
+    arrow::FieldVector fields = {
+        arrow::field("f0", arrow::int32()), arrow::field("f1", arrow::utf8()),
+        arrow::field("f2", arrow::int64()), arrow::field("f3", arrow::float64())};
+    std::shared_ptr<arrow::Array> src_array =
+        arrow::ipc::internal::json::ArrayFromJSON(arrow::struct_(fields), R"([
+        [1, "a", 10, 1.5],
+        [2, null, 20, null],
+        [3, "c", null, 3.5]
+    ])")
+            .ValueOr(nullptr);
+    ASSERT_TRUE(src_array);
+    WriteData(src_array, file_path);
+
+    ASSERT_OK_AND_ASSIGN(auto reader_builder, file_format_->CreateReaderBuilder(/*batch_size=*/2));
+    ASSERT_OK_AND_ASSIGN(std::shared_ptr<InputStream> in, fs_->Open(file_path));
+    ASSERT_OK_AND_ASSIGN(auto batch_reader, reader_builder->Build(in));
+
+    arrow::FieldVector read_fields = {fields[3], fields[1]};
+    ::ArrowSchema c_read_schema;
+    ASSERT_TRUE(arrow::ExportSchema(arrow::Schema(read_fields), &c_read_schema).ok());
+    ASSERT_OK(batch_reader->SetReadSchema(&c_read_schema, /*predicate=*/nullptr,
+                                          /*selection_bitmap=*/std::nullopt));
+    ASSERT_OK_AND_ASSIGN(auto result_array,
+                         ::paimon::test::ReadResultCollector::CollectResult(batch_reader.get()));
+    std::shared_ptr<arrow::ChunkedArray> expected_array;
+    auto array_status = arrow::ipc::internal::json::ChunkedArrayFromJSON(
+        arrow::struct_(read_fields), {R"([[1.5, "a"], [null, null], [3.5, "c"]])"},
+        &expected_array);
+    ASSERT_TRUE(array_status.ok()) << array_status.ToString();
+    ASSERT_TRUE(result_array->Equals(expected_array)) << result_array->ToString();
+
+    arrow::FieldVector non_exist_fields = {arrow::field("f4", arrow::int32())};
+    ASSERT_TRUE(arrow::ExportSchema(arrow::Schema(non_exist_fields), &c_read_schema).ok());
+    ASSERT_NOK_WITH_MSG(batch_reader->SetReadSchema(&c_read_schema, /*predicate=*/nullptr,
+                                                    /*selection_bitmap=*/std::nullopt),
+                        "field f4 of read type");
+}
+
 TEST_P(AvroFileBatchReaderTest, TestReadTimestampTypes) {
     auto enable_tz = GetParam();
     std::string timezone_str = enable_tz ? "Asia/Tokyo" : "Asia/Shanghai";
@@ -41,13 +41,15 @@ class AvroSchemaConverter {
     static Result<std::shared_ptr<arrow::DataType>> GetArrowType(const ::avro::NodePtr& avro_node,
                                                                  bool* nullable);
 
+    /// Returns true if `avro_node` is a nullable union of [null, type], which is the only kind
+    /// of union supported.
+    static Result<bool> CheckUnionType(const ::avro::NodePtr& avro_node);
+
  private:
     static Result<::avro::Schema> ArrowTypeToAvroSchema(const std::shared_ptr<arrow::Field>& field);
 
     static ::avro::Schema NullableSchema(const ::avro::Schema& schema);
 
-    static Result<bool> CheckUnionType(const ::avro::NodePtr& avro_node);
-
     static Result<std::shared_ptr<arrow::Field>> GetArrowField(const std::string& name,
                                                                const ::avro::NodePtr& avro_node);
 };
@@ -0,0 +1,537 @@
+/*
+ * Copyright 2024-present Alibaba Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "paimon/format/parquet/page_index_filter.h"
+
+#include <algorithm>
+#include <cmath>
+#include <exception>
+#include <iterator>
+#include <optional>
+#include <string_view>
+#include <type_traits>
+
+#include "fmt/format.h"
+#include "paimon/defs.h"
+#include "paimon/predicate/compound_predicate.h"
+#include "paimon/predicate/function.h"
+#include "paimon/predicate/literal.h"
+#include "parquet/bloom_filter.h"
+#include "parquet/bloom_filter_reader.h"
+#include "parquet/file_reader.h"
+#include "parquet/metadata.h"
+#include "parquet/page_index.h"
+#include "parquet/schema.h"
+#include "parquet/types.h"
+
+namespace paimon::parquet {
+namespace {
+template <typename T>
+std::optional<T> ConvertLiteral(const Literal& literal);
+
+template <>
+std::optional<int32_t> ConvertLiteral<int32_t>(const Literal& literal) {
+    switch (literal.GetType()) {
+        case FieldType::TINYINT:
+            return static_cast<int32_t>(literal.GetValue<int8_t>());
+        case FieldType::SMALLINT:
+            return static_cast<int32_t>(literal.GetValue<int16_t>());
+        case FieldType::INT:
+        case FieldType::DATE:
+            return literal.GetValue<int32_t>();
+        default:
+            return std::nullopt;
+    }
+}
+
+template <>
+std::optional<int64_t> ConvertLiteral<int64_t>(const Literal& literal) {
+    if (literal.GetType() == FieldType::BIGINT) {
+        return literal.GetValue<int64_t>();
+    }
+    return std::nullopt;
+}
+
+template <>
+std::optional<float> ConvertLiteral<float>(const Literal& literal) {
+    if (literal.GetType() == FieldType::FLOAT) {
+        return literal.GetValue<float>();
+    }
+    return std::nullopt;
+}
+
+template <>
+std::optional<double> ConvertLiteral<double>(const Literal& literal) {
+    if (literal.GetType() == FieldType::DOUBLE) {
+        return literal.GetValue<double>();
+    }
+    return std::nullopt;
+}
+
+template <>
+std::optional<std::string> ConvertLiteral<std::string>(const Literal& literal) {
+    if (literal.GetType() == FieldType::STRING) {
+        return literal.GetValue<std::string>();
+    }
+    return std::nullopt;
+}
+
+/// @return std::nullopt if any literal is null or can not be compared with the column.
+template <typename T>
+std::optional<std::vector<T>> ConvertLiterals(const std::vector<Literal>& literals) {
+    std::vector<T> result;
+    result.reserve(literals.size());
+    for (const auto& literal : literals) {
+        if (literal.IsNull()) {
+            return std::nullopt;
+        }
+        std::optional<T> value = ConvertLiteral<T>(literal);
+        if (!value) {
+            return std::nullopt;
+        }
+        result.push_back(std::move(value).value());
+    }
+    return result;
+}
+
+template <typename T>
+bool IsNaN(const T& value) {
+    if constexpr (std::is_floating_point_v<T>) {
+        return std::isnan(value);
+    } else {
+        return false;
+    }
+}
+
+template <typename T>
+T ToComparable(const T& value) {
+    return value;
+}
+
+std::string_view ToComparable(const ::parquet::ByteArray& value) {
+    return std::string_view(reinterpret_cast<const char*>(value.ptr), value.len);
+}
+
+/// @return whether a non-null page with values in [min, max] might contain rows matching
+/// `function_type` with `literals`.
+template <typename T>
+bool PageMightMatch(Function::Type function_type, const T& min, const T& max,
+                    const std::vector<T>& literals) {
+    // NaN is not ordered, it is excluded from min/max values
+    if (IsNaN(min) || IsNaN(max) ||
+        std::any_of(literals.begin(), literals.end(), [](const T& v) { return IsNaN(v); })) {
+        return true;
+    }
+    switch (function_type) {
+        case Function::Type::EQUAL:
+        case Function::Type::IN:
+            return std::any_of(literals.begin(), literals.end(),
+                               [&](const T& v) { return !(v < min) && !(max < v); });
+        case Function::Type::NOT_EQUAL:
+        case Function::Type::NOT_IN:
+            // only a page whose values all equal to one of the literals can be skipped
+            return !(min == max && std::any_of(literals.begin(), literals.end(),
+                                               [&](const T& v) { return v == min; }));
+        case Function::Type::LESS_THAN:
+            return min < literals[0];
+        case Function::Type::LESS_OR_EQUAL:
+            return !(literals[0] < min);
+        case Function::Type::GREATER_THAN:
+            return literals[0] < max;
+        case Function::Type::GREATER_OR_EQUAL:
+            return !(max < literals[0]);
+        default:
+            return true;
+    }
+}
+
+/// Evaluates the pages of a column of parquet type `DType` whose values compare as `T`.
+/// @return false if the pages can not be evaluated.
+template <typename DType, typename T>
+bool EvaluatePageValues(const ::parquet::ColumnIndex& column_index, Function::Type function_type,
+                        const std::vector<T>& literals, std::vector<bool>* might_match) {
+    const auto* typed_column_index =
+        dynamic_cast<const ::parquet::TypedColumnIndex<DType>*>(&column_index);
+    if (!typed_column_index || literals.empty()) {
+        return false;
+    }
+    const auto& null_pages = column_index.null_pages();
+    const auto& min_values = typed_column_index->min_values();
+    const auto& max_values = typed_column_index->max_values();
+    if (min_values.size() != null_pages.size() || max_values.size() != null_pages.size()) {
+        return false;
+    }
+    for (size_t i = 0; i < null_pages.size(); i++) {
+        // comparison with null is never true
+        (*might_match)[i] =
+            !null_pages[i] && PageMightMatch<T>(function_type, ToComparable(min_values[i]),
+                                                ToComparable(max_values[i]), literals);
+    }
+    return true;
+}
+
+template <typename DType, typename T>
+bool EvaluatePages(const ::parquet::ColumnIndex& column_index, const LeafPredicate& leaf_predicate,
+                   std::vector<bool>* might_match) {
+    auto function_type = leaf_predicate.GetFunction().GetType();
+    if constexpr (std::is_same_v<T, std::string_view>) {
+        // page values point into the column index, literals are owned here
+        std::optional<std::vector<std::string>> literals =
+            ConvertLiterals<std::string>(leaf_predicate.Literals());
+        if (!literals) {
+            return false;
+        }
+        std::vector<std::string_view> literal_views(literals.value().begin(),
+                                                    literals.value().end());
+        return EvaluatePageValues<DType, T>(column_index, function_type, literal_views,
+                                            might_match);
+    } else {
+        std::optional<std::vector<T>> literals = ConvertLiterals<T>(leaf_predicate.Literals());
+        if (!literals) {
+            return false;
+        }
+        return EvaluatePageValues<DType, T>(column_index, function_type, literals.value(),
+                                            might_match);
+    }
+}
+
+uint64_t Hash(const ::parquet::BloomFilter& bloom_filter, const std::string& value) {
+    ::parquet::ByteArray byte_array(static_cast<uint32_t>(value.size()),
+                                    reinterpret_cast<const uint8_t*>(value.data()));
+    return bloom_filter.Hash(&byte_array);
+}
+
+template <typename T>
+uint64_t Hash(const ::parquet::BloomFilter& bloom_filter, const T& value) {
+    return bloom_filter.Hash(value);
+}
+
+/// @return false only if none of the literals is in `bloom_filter`.
+template <typename T>
+bool MightContainAny(const ::parquet::BloomFilter& bloom_filter,
+                     const std::vector<Literal>& literals) {
+    std::optional<std::vector<T>> values = ConvertLiterals<T>(literals);
+    if (!values || values.value().empty()) {
+        return true;
+    }
+    return std::any_of(values.value().begin(), values.value().end(), [&](const T& value) {
+        return bloom_filter.FindHash(Hash(bloom_filter, value));
+    });
+}
+}  // namespace
+
+PageIndexFilter::PageIndexFilter(::parquet::ParquetFileReader* file_reader,
+                                 const std::vector<std::pair<uint64_t, uint64_t>>& row_group_ranges,
+                                 bool page_index_enabled, bool bloom_filter_enabled)
+    : file_reader_(file_reader),
+      row_group_ranges_(row_group_ranges),
+      page_index_enabled_(page_index_enabled),
+      bloom_filter_enabled_(bloom_filter_enabled) {}
+
+Result<std::vector<int32_t>> PageIndexFilter::FilterRowGroups(
+    const std::shared_ptr<Predicate>& predicate, const std::vector<int32_t>& src_row_groups) {
+    std::vector<int32_t> columns;
+    CollectColumns(predicate, &columns);
+    if (columns.empty() || (!page_index_enabled_ && !bloom_filter_enabled_)) {
+        return src_row_groups;
+    }
+    std::vector<int32_t> target_row_groups;
+    target_row_groups.reserve(src_row_groups.size());
+    try {
+        if (page_index_enabled_) {
+            if (auto page_index_reader = file_reader_->GetPageIndexReader()) {
+                // coalesce the reads of page indexes of all row groups to evaluate
+                page_index_reader->WillNeed(
+                    src_row_groups, columns,
+                    ::parquet::PageIndexSelection{/*column_index=*/true, /*offset_index=*/true});
+            }
+        }
+        for (int32_t row_group : src_row_groups) {
+            PAIMON_ASSIGN_OR_RAISE(RowRanges row_ranges,
+                                   InnerCalculateRowRanges(predicate, row_group));
+            if (!row_ranges.empty()) {
+                target_row_groups.push_back(row_group);
+            }
+        }
+    } catch (const std::exception& e) {
+        return Status::Invalid(
+            fmt::format("filter row groups by page index failed, with {} error", e.what()));
+    } catch (...) {
+        return Status::UnknownError("filter row groups by page index failed, with unknown error");
+    }
+    return target_row_groups;
+}
+
+Result<RowRanges> PageIndexFilter::CalculateRowRanges(const std::shared_ptr<Predicate>& predicate,
+                                                      int32_t row_group) {
+    if (row_group < 0 || static_cast<size_t>(row_group) >= row_group_ranges_.size()) {
+        return Status::Invalid(fmt::format("row group {} is out of bound {}", row_group,
+                                           row_group_ranges_.size()));
+    }
+    try {
+        return InnerCalculateRowRanges(predicate, row_group);
+    } catch (const std::exception& e) {
+        return Status::Invalid(
+            fmt::format("calculate row ranges by page index failed, with {} error", e.what()));
+    } catch (...) {
+        return Status::UnknownError(
+            "calculate row ranges by page index failed, with unknown error");
+    }
+}
+
+Result<RowRanges> PageIndexFilter::InnerCalculateRowRanges(
+    const std::shared_ptr<Predicate>& predicate, int32_t row_group) {
+    if (auto leaf_predicate = std::dynamic_pointer_cast<LeafPredicate>(predicate)) {
+        return CalculateLeafRowRanges(*leaf_predicate, row_group);
+    }
+    auto compound_predicate = std::dynamic_pointer_cast<CompoundPredicate>(predicate);
+    if (!compound_predicate || compound_predicate->Children().empty()) {
+        return AllRows(row_group);
+    }
+    auto function_type = compound_predicate->GetFunction().GetType();
+    if (function_type != Function::Type::AND && function_type != Function::Type::OR) {
+        return AllRows(row_group);
+    }
+    std::optional<RowRanges> result;
+    for (const auto& child : compound_predicate->Children()) {
+        PAIMON_ASSIGN_OR_RAISE(RowRanges child_ranges, InnerCalculateRowRanges(child, row_group));
+        if (!result) {
+            result = std::move(child_ranges);
+        } else if (function_type == Function::Type::AND) {
+            result = Intersection(result.value(), child_ranges);
+        } else {
+            result = Union(result.value(), child_ranges);
+        }
+        if (function_type == Function::Type::AND && result.value().empty()) {
+            break;
+        }
+    }
+    return std::move(result).value();
+}
+
+Result<RowRanges> PageIndexFilter::CalculateLeafRowRanges(const LeafPredicate& leaf_predicate,
+                                                          int32_t row_group) {
+    int32_t column = FindColumn(leaf_predicate.FieldName());
+    if (column < 0) {
+        return AllRows(row_group);
+    }
+    auto function_type = leaf_predicate.GetFunction().GetType();
+    if (bloom_filter_enabled_ &&
+        (function_type == Function::Type::EQUAL || function_type == Function::Type::IN)) {
+        PAIMON_ASSIGN_OR_RAISE(bool might_contain,
+                               MightContainByBloomFilter(leaf_predicate, row_group, column));
+        if (!might_contain) {
+            return RowRanges();
+        }
+    }
+    if (page_index_enabled_) {
+        return CalculatePageRowRanges(leaf_predicate, row_group, column);
+    }
+    return AllRows(row_group);
+}
+
+Result<bool> PageIndexFilter::MightContainByBloomFilter(const LeafPredicate& leaf_predicate,
+                                                        int32_t row_group, int32_t column) const {
+    std::shared_ptr<::parquet::RowGroupBloomFilterReader> row_group_reader =
+        file_reader_->GetBloomFilterReader().RowGroup(row_group);
+    if (!row_group_reader) {
+        return true;
+    }
+    std::unique_ptr<::parquet::BloomFilter> bloom_filter =
+        row_group_reader->GetColumnBloomFilter(column);
+    if (!bloom_filter) {
+        return true;
+    }
+    const auto& literals = leaf_predicate.Literals();
+    switch (file_reader_->metadata()->schema()->Column(column)->physical_type()) {
+        case ::parquet::Type::INT32:
+            return MightContainAny<int32_t>(*bloom_filter, literals);
+        case ::parquet::Type::INT64:
+            return MightContainAny<int64_t>(*bloom_filter, literals);
+        case ::parquet::Type::FLOAT:
+            return MightContainAny<float>(*bloom_filter, literals);
+        case ::parquet::Type::DOUBLE:
+            return MightContainAny<double>(*bloom_filter, literals);
+        case ::parquet::Type::BYTE_ARRAY:
+            return MightContainAny<std::string>(*bloom_filter, literals);
+        default:
+            return true;
+    }
+}
+
+Result<RowRanges> PageIndexFilter::CalculatePageRowRanges(const LeafPredicate& leaf_predicate,
+                                                          int32_t row_group, int32_t column) {
+    auto iter = page_index_readers_.find(row_group);
+    if (iter == page_index_readers_.end()) {
+        std::shared_ptr<::parquet::PageIndexReader> page_index_reader =
+            file_reader_->GetPageIndexReader();
+        iter = page_index_readers_
+                   .emplace(row_group,
+                            page_index_reader ? page_index_reader->RowGroup(row_group) : nullptr)
+                   .first;
+    }
+    const auto& row_group_reader = iter->second;
+    if (!row_group_reader) {
+        return AllRows(row_group);
+    }
+    std::shared_ptr<::parquet::ColumnIndex> column_index =
+        row_group_reader->GetColumnIndex(column);
+    std::shared_ptr<::parquet::OffsetIndex> offset_index =
+        row_group_reader->GetOffsetIndex(column);
+    if (!column_index || !offset_index) {
+        return AllRows(row_group);
+    }
+    const auto& page_locations = offset_index->page_locations();
+    const auto& null_pages = column_index->null_pages();
+    if (page_locations.empty() || page_locations.size() != null_pages.size()) {
+        return AllRows(row_group);
+    }
+
+    size_t page_count = page_locations.size();
+    std::vector<bool> might_match(page_count, true);
+    switch (leaf_predicate.GetFunction().GetType()) {
+        case Function::Type::IS_NULL: {
+            bool has_null_counts = column_index->has_null_counts();
+            for (size_t i = 0; i < page_count; i++) {
+                might_match[i] =
+                    null_pages[i] || !has_null_counts || column_index->null_counts()[i] > 0;
+            }
+            break;
+        }
+        case Function::Type::IS_NOT_NULL: {
+            for (size_t i = 0; i < page_count; i++) {
+                might_match[i] = !null_pages[i];
+            }
+            break;
+        }
+        default: {
+            const ::parquet::ColumnDescriptor* descr =
+                file_reader_->metadata()->schema()->Column(column);
+            bool evaluated = false;
+            switch (descr->physical_type()) {
+                case ::parquet::Type::INT32:
+                    evaluated = descr->sort_order() == ::parquet::SortOrder::SIGNED &&
+                                EvaluatePages<::parquet::Int32Type, int32_t>(
+                                    *column_index, leaf_predicate, &might_match);
+                    break;
+                case ::parquet::Type::INT64:
+                    evaluated = descr->sort_order() == ::parquet::SortOrder::SIGNED &&
+                                EvaluatePages<::parquet::Int64Type, int64_t>(
+                                    *column_index, leaf_predicate, &might_match);
+                    break;
+                case ::parquet::Type::FLOAT:
+                    evaluated = EvaluatePages<::parquet::FloatType, float>(
+                        *column_index, leaf_predicate, &might_match);
+                    break;
+                case ::parquet::Type::DOUBLE:
+                    evaluated = EvaluatePages<::parquet::DoubleType, double>(
+                        *column_index, leaf_predicate, &might_match);
+                    break;
+                case ::parquet::Type::BYTE_ARRAY:
+                    evaluated = descr->sort_order() == ::parquet::SortOrder::UNSIGNED &&
+                                EvaluatePages<::parquet::ByteArrayType, std::string_view>(
+                                    *column_index, leaf_predicate, &might_match);
+                    break;
+                default:
+                    break;
+            }
+            if (!evaluated) {
+                return AllRows(row_group);
+            }
+        }
+    }
+
+    // first_row_index of page locations is relative to the row group
+    const auto& [row_group_start, row_group_end] = row_group_ranges_[row_group];
+    RowRanges row_ranges;
+    for (size_t i = 0; i < page_count; i++) {
+        if (!might_match[i]) {
+            continue;
+        }
+        uint64_t start = row_group_start + page_locations[i].first_row_index;
+        uint64_t end = i + 1 < page_count ? row_group_start + page_locations[i + 1].first_row_index
+                                          : row_group_end;
+        if (!row_ranges.empty() && row_ranges.back().second == start) {
+            row_ranges.back().second = end;
+        } else {
+            row_ranges.emplace_back(start, end);
+        }
+    }
+    return row_ranges;
+}
+
+int32_t PageIndexFilter::FindColumn(const std::string& field_name) const {
+    const ::parquet::SchemaDescriptor* schema = file_reader_->metadata()->schema();
+    int32_t column = schema->ColumnIndex(field_name);
+    if (column < 0 || schema->Column(column)->max_repetition_level() != 0 ||
+        schema->GetColumnRoot(column) != schema->Column(column)->schema_node().get()) {
+        // only top-level primitive columns are evaluated
+        return -1;
+    }
+    return column;
+}
+
+void PageIndexFilter::CollectColumns(const std::shared_ptr<Predicate>& predicate,
+                                     std::vector<int32_t>* columns) const {
+    if (auto leaf_predicate = std::dynamic_pointer_cast<LeafPredicate>(predicate)) {
+        int32_t column = FindColumn(leaf_predicate->FieldName());
+        if (column >= 0 && std::find(columns->begin(), columns->end(), column) == columns->end()) {
+            columns->push_back(column);
+        }
+        return;
+    }
+    if (auto compound_predicate = std::dynamic_pointer_cast<CompoundPredicate>(predicate)) {
+        for (const auto& child : compound_predicate->Children()) {
+            CollectColumns(child, columns);
+        }
+    }
+}
+
+RowRanges PageIndexFilter::Union(const RowRanges& left, const RowRanges& right) {
+    RowRanges merged;
+    merged.reserve(left.size() + right.size());
+    std::merge(left.begin(), left.end(), right.begin(), right.end(), std::back_inserter(merged));
+    RowRanges result;
+    for (const auto& range : merged) {
+        if (!result.empty() && range.first <= result.back().second) {
+            result.back().second = std::max(result.back().second, range.second);
+        } else {
+            result.push_back(range);
+        }
+    }
+    return result;
+}
+
+RowRanges PageIndexFilter::Intersection(const RowRanges& left, const RowRanges& right) {
+    RowRanges result;
+    size_t i = 0;
+    size_t j = 0;
+    while (i < left.size() && j < right.size()) {
+        uint64_t start = std::max(left[i].first, right[j].first);
+        uint64_t end = std::min(left[i].second, right[j].second);
+        if (start < end) {
+            result.emplace_back(start, end);
+        }
+        if (left[i].second < right[j].second) {
+            i++;
+        } else {
+            j++;
+        }
+    }
+    return result;
+}
+
+}  // namespace paimon::parquet
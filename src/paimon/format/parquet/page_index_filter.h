@@ -0,0 +1,97 @@
+/*
+ * Copyright 2024-present Alibaba Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "paimon/predicate/leaf_predicate.h"
+#include "paimon/predicate/predicate.h"
+#include "paimon/result.h"
+#include "paimon/status.h"
+
+namespace parquet {
+class ParquetFileReader;
+class RowGroupPageIndexReader;
+}  // namespace parquet
+
+namespace paimon::parquet {
+
+/// Sorted and disjoint row ranges [start_row_idx, end_row_idx) of a parquet file.
+using RowRanges = std::vector<std::pair<uint64_t, uint64_t>>;
+
+/// Evaluates a predicate against the page index (column index and offset index) and the bloom
+/// filters of a parquet file. Column chunk statistics only describe a whole row group, while the
+/// column index keeps min/max values and null counts of every page, so rows of a row group that
+/// cannot match the predicate are located at page granularity. Bloom filters are consulted for
+/// EQUAL and IN predicates.
+///
+/// Only top-level columns of INT32, INT64, FLOAT, DOUBLE and BYTE_ARRAY (string) are evaluated,
+/// leaves on other columns match all rows.
+class PageIndexFilter {
+ public:
+    /// @param row_group_ranges [start_row_idx, end_row_idx) of every row group of the file.
+    PageIndexFilter(::parquet::ParquetFileReader* file_reader,
+                    const std::vector<std::pair<uint64_t, uint64_t>>& row_group_ranges,
+                    bool page_index_enabled, bool bloom_filter_enabled);
+
+    /// @return the row groups of `src_row_groups` which may contain rows matching `predicate`.
+    Result<std::vector<int32_t>> FilterRowGroups(const std::shared_ptr<Predicate>& predicate,
+                                                 const std::vector<int32_t>& src_row_groups);
+
+    /// @return the rows of `row_group` which may match `predicate`, empty if none can match.
+    Result<RowRanges> CalculateRowRanges(const std::shared_ptr<Predicate>& predicate,
+                                         int32_t row_group);
+
+    static RowRanges Union(const RowRanges& left, const RowRanges& right);
+    static RowRanges Intersection(const RowRanges& left, const RowRanges& right);
+
+ private:
+    Result<RowRanges> InnerCalculateRowRanges(const std::shared_ptr<Predicate>& predicate,
+                                              int32_t row_group);
+    Result<RowRanges> CalculateLeafRowRanges(const LeafPredicate& leaf_predicate,
+                                             int32_t row_group);
+    Result<bool> MightContainByBloomFilter(const LeafPredicate& leaf_predicate,
+                                           int32_t row_group, int32_t column) const;
+    Result<RowRanges> CalculatePageRowRanges(const LeafPredicate& leaf_predicate,
+                                             int32_t row_group, int32_t column);
+
+    /// @return index of the top-level leaf column named `field_name`, or -1 if not found.
+    int32_t FindColumn(const std::string& field_name) const;
+
+    /// Collects the leaf columns referenced by `predicate`.
+    void CollectColumns(const std::shared_ptr<Predicate>& predicate,
+                        std::vector<int32_t>* columns) const;
+
+    RowRanges AllRows(int32_t row_group) const {
+        return {row_group_ranges_[row_group]};
+    }
+
+ private:
+    ::parquet::ParquetFileReader* file_reader_;
+    std::vector<std::pair<uint64_t, uint64_t>> row_group_ranges_;
+    bool page_index_enabled_;
+    bool bloom_filter_enabled_;
+    // page index readers of row groups, read once per row group
+    std::map<int32_t, std::shared_ptr<::parquet::RowGroupPageIndexReader>> page_index_readers_;
+};
+
+}  // namespace paimon::parquet
@@ -0,0 +1,296 @@
+/*
+ * Copyright 2024-present Alibaba Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "paimon/format/parquet/page_index_filter.h"
+
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "arrow/api.h"
+#include "arrow/array/builder_binary.h"
+#include "arrow/array/builder_nested.h"
+#include "arrow/array/builder_primitive.h"
+#include "arrow/c/abi.h"
+#include "arrow/c/bridge.h"
+#include "fmt/format.h"
+#include "gtest/gtest.h"
+#include "paimon/common/utils/arrow/mem_utils.h"
+#include "paimon/defs.h"
+#include "paimon/format/parquet/parquet_file_batch_reader.h"
+#include "paimon/format/parquet/parquet_format_defs.h"
+#include "paimon/format/parquet/parquet_format_writer.h"
+#include "paimon/format/parquet/parquet_input_stream_impl.h"
+#include "paimon/fs/file_system.h"
+#include "paimon/memory/memory_pool.h"
+#include "paimon/predicate/function.h"
+#include "paimon/predicate/literal.h"
+#include "paimon/predicate/predicate_builder.h"
+#include "paimon/testing/utils/read_result_collector.h"
+#include "paimon/testing/utils/testharness.h"
+#include "parquet/file_reader.h"
+#include "parquet/properties.h"
+
+namespace paimon::parquet::test {
+
+class PageIndexFilterTest : public ::testing::Test {
+ public:
+    void SetUp() override {
+        arrow_pool_ = GetArrowPool(GetDefaultPool());
+        dir_ = paimon::test::UniqueTestDirectory::Create();
+        ASSERT_TRUE(dir_);
+        fs_ = dir_->GetFileSystem();
+        file_name_ = dir_->Str() + "/test.parquet";
+
+        // f0: 0, 1, ..., 99
+        // f1: "s00", "s01", ..., "s99"
+        // f2: 99, 98, ..., 0
+        fields_ = {arrow::field("f0", arrow::int32()), arrow::field("f1", arrow::utf8()),
+                   arrow::field("f2", arrow::int64())};
+        arrow::StructBuilder struct_builder(
+            arrow::struct_(fields_), arrow::default_memory_pool(),
+            {std::make_shared<arrow::Int32Builder>(), std::make_shared<arrow::StringBuilder>(),
+             std::make_shared<arrow::Int64Builder>()});
+        auto f0_builder = static_cast<arrow::Int32Builder*>(struct_builder.field_builder(0));
+        auto f1_builder = static_cast<arrow::StringBuilder*>(struct_builder.field_builder(1));
+        auto f2_builder = static_cast<arrow::Int64Builder*>(struct_builder.field_builder(2));
+        for (int32_t i = 0; i < 100; i++) {
+            ASSERT_TRUE(struct_builder.Append().ok());
+            ASSERT_TRUE(f0_builder->Append(i).ok());
+            ASSERT_TRUE(f1_builder->Append(fmt::format("s{:02d}", i)).ok());
+            ASSERT_TRUE(f2_builder->Append(99 - i).ok());
+        }
+        ASSERT_TRUE(struct_builder.Finish(&src_array_).ok());
+    }
+
+    // 2 row groups of 50 rows, each has 5 pages of 10 rows
+    void WriteFile(bool enable_page_index) const {
+        ASSERT_OK_AND_ASSIGN(std::shared_ptr<OutputStream> out,
+                             fs_->Create(file_name_, /*overwrite=*/true));
+        ::parquet::WriterProperties::Builder builder;
+        builder.write_batch_size(10);
+        builder.data_pagesize(1);
+        builder.max_row_group_length(50);
+        builder.disable_dictionary();
+        enable_page_index ? builder.enable_write_page_index() : builder.disable_write_page_index();
+        ASSERT_OK_AND_ASSIGN(auto format_writer,
+                             ParquetFormatWriter::Create(out, arrow::schema(fields_),
+                                                         builder.build(), arrow_pool_));
+        auto arrow_array = std::make_unique<ArrowArray>();
+        ASSERT_TRUE(arrow::ExportArray(*src_array_, arrow_array.get()).ok());
+        ASSERT_OK(format_writer->AddBatch(arrow_array.get()));
+        ASSERT_OK(format_writer->Finish());
+        ASSERT_OK(out->Close());
+    }
+
+    std::unique_ptr<::parquet::ParquetFileReader> OpenFile() const {
+        return ::parquet::ParquetFileReader::OpenFile(file_name_);
+    }
+
+    std::unique_ptr<ParquetFileBatchReader> CreateBatchReader(
+        const std::map<std::string, std::string>& options,
+        const std::shared_ptr<Predicate>& predicate) const {
+        EXPECT_OK_AND_ASSIGN(std::shared_ptr<InputStream> in, fs_->Open(file_name_));
+        EXPECT_OK_AND_ASSIGN(uint64_t length, in->Length());
+        auto in_stream = std::make_shared<ParquetInputStreamImpl>(in, arrow_pool_, length);
+        EXPECT_OK_AND_ASSIGN(auto batch_reader,
+                             ParquetFileBatchReader::Create(std::move(in_stream), arrow_pool_,
+                                                            options, /*batch_size=*/10));
+        auto c_schema = std::make_unique<ArrowSchema>();
+        EXPECT_TRUE(arrow::ExportSchema(*arrow::schema(fields_), c_schema.get()).ok());
+        EXPECT_OK(batch_reader->SetReadSchema(c_schema.get(), predicate,
+                                              /*selection_bitmap=*/std::nullopt));
+        return batch_reader;
+    }
+
+    static std::shared_ptr<Predicate> IntPredicate(Function::Type type, int32_t value) {
+        switch (type) {
+            case Function::Type::EQUAL:
+                return PredicateBuilder::Equal(0, "f0", FieldType::INT, Literal(value));
+            case Function::Type::LESS_THAN:
+                return PredicateBuilder::LessThan(0, "f0", FieldType::INT, Literal(value));
+            case Function::Type::GREATER_OR_EQUAL:
+                return PredicateBuilder::GreaterOrEqual(0, "f0", FieldType::INT, Literal(value));
+            case Function::Type::GREATER_THAN:
+                return PredicateBuilder::GreaterThan(0, "f0", FieldType::INT, Literal(value));
+            default:
+                return nullptr;
+        }
+    }
+
+ protected:
+    std::shared_ptr<arrow::MemoryPool> arrow_pool_;
+    std::unique_ptr<paimon::test::UniqueTestDirectory> dir_;
+    std::shared_ptr<FileSystem> fs_;
+    std::string file_name_;
+    arrow::FieldVector fields_;
+    std::shared_ptr<arrow::Array> src_array_;
+};
+
+TEST_F(PageIndexFilterTest, TestUnionAndIntersection) {
+    RowRanges left = {{0, 10}, {20, 30}, {50, 60}};
+    RowRanges right = {{5, 20}, {25, 40}};
+    ASSERT_EQ(PageIndexFilter::Union(left, right), RowRanges({{0, 40}, {50, 60}}));
+    ASSERT_EQ(PageIndexFilter::Intersection(left, right), RowRanges({{5, 10}, {25, 30}}));
+    ASSERT_EQ(PageIndexFilter::Union(left, {}), left);
+    ASSERT_TRUE(PageIndexFilter::Intersection(left, {}).empty());
+    ASSERT_TRUE(PageIndexFilter::Intersection({{0, 10}}, {{10, 20}}).empty());
+}
+
+TEST_F(PageIndexFilterTest, TestCalculateRowRanges) {
+    WriteFile(/*enable_page_index=*/true);
+    auto file_reader = OpenFile();
+    PageIndexFilter filter(file_reader.get(), {{0, 50}, {50, 100}}, /*page_index_enabled=*/true,
+                           /*bloom_filter_enabled=*/true);
+    {
+        auto predicate = IntPredicate(Function::Type::EQUAL, 23);
+        ASSERT_OK_AND_ASSIGN(RowRanges ranges, filter.CalculateRowRanges(predicate, 0));
+        ASSERT_EQ(ranges, RowRanges({{20, 30}}));
+        ASSERT_OK_AND_ASSIGN(ranges, filter.CalculateRowRanges(predicate, 1));
+        ASSERT_TRUE(ranges.empty());
+    }
+    {
+        auto predicate = IntPredicate(Function::Type::GREATER_OR_EQUAL, 45);
+        ASSERT_OK_AND_ASSIGN(RowRanges ranges, filter.CalculateRowRanges(predicate, 0));
+        ASSERT_EQ(ranges, RowRanges({{40, 50}}));
+        ASSERT_OK_AND_ASSIGN(ranges, filter.CalculateRowRanges(predicate, 1));
+        ASSERT_EQ(ranges, RowRanges({{50, 100}}));
+    }
+    {
+        auto predicate = PredicateBuilder::In(0, "f0", FieldType::INT, {Literal(5), Literal(77)});
+        ASSERT_OK_AND_ASSIGN(RowRanges ranges, filter.CalculateRowRanges(predicate, 0));
+        ASSERT_EQ(ranges, RowRanges({{0, 10}}));
+        ASSERT_OK_AND_ASSIGN(ranges, filter.CalculateRowRanges(predicate, 1));
+        ASSERT_EQ(ranges, RowRanges({{70, 80}}));
+    }
+    {
+        ASSERT_OK_AND_ASSIGN(
+            auto predicate, PredicateBuilder::Or({IntPredicate(Function::Type::LESS_THAN, 5),
+                                                  IntPredicate(Function::Type::GREATER_THAN, 95)}));
+        ASSERT_OK_AND_ASSIGN(RowRanges ranges, filter.CalculateRowRanges(predicate, 0));
+        ASSERT_EQ(ranges, RowRanges({{0, 10}}));
+        ASSERT_OK_AND_ASSIGN(ranges, filter.CalculateRowRanges(predicate, 1));
+        ASSERT_EQ(ranges, RowRanges({{90, 100}}));
+    }
+    {
+        // "s295" falls in the gap between page ["s20", "s29"] and page ["s30", "s39"]
+        auto predicate = PredicateBuilder::Equal(1, "f1", FieldType::STRING,
+                                                 Literal(FieldType::STRING, "s295", 4));
+        ASSERT_OK_AND_ASSIGN(RowRanges ranges, filter.CalculateRowRanges(predicate, 0));
+        ASSERT_TRUE(ranges.empty());
+        predicate = PredicateBuilder::LessOrEqual(1, "f1", FieldType::STRING,
+                                                  Literal(FieldType::STRING, "s15", 3));
+        ASSERT_OK_AND_ASSIGN(ranges, filter.CalculateRowRanges(predicate, 0));
+        ASSERT_EQ(ranges, RowRanges({{0, 20}}));
+    }
+    {
+        // f0 < 10 and f2 < 60 match different pages of row group 0
+        ASSERT_OK_AND_ASSIGN(
+            auto predicate,
+            PredicateBuilder::And({IntPredicate(Function::Type::LESS_THAN, 10),
+                                   PredicateBuilder::LessThan(2, "f2", FieldType::BIGINT,
+                                                              Literal(static_cast<int64_t>(60)))}));
+        ASSERT_OK_AND_ASSIGN(RowRanges ranges, filter.CalculateRowRanges(predicate, 0));
+        ASSERT_TRUE(ranges.empty());
+    }
+    {
+        auto predicate = PredicateBuilder::IsNull(0, "f0", FieldType::INT);
+        ASSERT_OK_AND_ASSIGN(RowRanges ranges, filter.CalculateRowRanges(predicate, 0));
+        ASSERT_TRUE(ranges.empty());
+        predicate = PredicateBuilder::IsNotNull(0, "f0", FieldType::INT);
+        ASSERT_OK_AND_ASSIGN(ranges, filter.CalculateRowRanges(predicate, 0));
+        ASSERT_EQ(ranges, RowRanges({{0, 50}}));
+    }
+    {
+        // unknown field and mismatched literal type match all rows
+        auto predicate = PredicateBuilder::Equal(3, "f3", FieldType::INT, Literal(1));
+        ASSERT_OK_AND_ASSIGN(RowRanges ranges, filter.CalculateRowRanges(predicate, 0));
+        ASSERT_EQ(ranges, RowRanges({{0, 50}}));
+        predicate = PredicateBuilder::Equal(0, "f0", FieldType::BIGINT,
+                                            Literal(static_cast<int64_t>(1000)));
+        ASSERT_OK_AND_ASSIGN(ranges, filter.CalculateRowRanges(predicate, 0));
+        ASSERT_EQ(ranges, RowRanges({{0, 50}}));
+    }
+    ASSERT_NOK_WITH_MSG(filter.CalculateRowRanges(IntPredicate(Function::Type::EQUAL, 1), 2),
+                        "row group 2 is out of bound 2");
+}
+
+TEST_F(PageIndexFilterTest, TestFilterRowGroups) {
+    WriteFile(/*enable_page_index=*/true);
+    auto file_reader = OpenFile();
+    PageIndexFilter filter(file_reader.get(), {{0, 50}, {50, 100}}, /*page_index_enabled=*/true,
+                           /*bloom_filter_enabled=*/true);
+    auto predicate = PredicateBuilder::In(
+        1, "f1", FieldType::STRING,
+        {Literal(FieldType::STRING, "s295", 4), Literal(FieldType::STRING, "s77", 3)});
+    ASSERT_OK_AND_ASSIGN(std::vector<int32_t> row_groups,
+                         filter.FilterRowGroups(predicate, {0, 1}));
+    ASSERT_EQ(row_groups, std::vector<int32_t>({1}));
+    ASSERT_OK_AND_ASSIGN(row_groups, filter.FilterRowGroups(predicate, {0}));
+    ASSERT_TRUE(row_groups.empty());
+
+    PageIndexFilter disabled_filter(file_reader.get(), {{0, 50}, {50, 100}},
+                                    /*page_index_enabled=*/false,
+                                    /*bloom_filter_enabled=*/false);
+    ASSERT_OK_AND_ASSIGN(row_groups, disabled_filter.FilterRowGroups(predicate, {0, 1}));
+    ASSERT_EQ(row_groups, std::vector<int32_t>({0, 1}));
+}
+
+TEST_F(PageIndexFilterTest, TestFileWithoutPageIndex) {
+    WriteFile(/*enable_page_index=*/false);
+    auto file_reader = OpenFile();
+    PageIndexFilter filter(file_reader.get(), {{0, 50}, {50, 100}}, /*page_index_enabled=*/true,
+                           /*bloom_filter_enabled=*/true);
+    auto predicate = IntPredicate(Function::Type::EQUAL, 23);
+    ASSERT_OK_AND_ASSIGN(RowRanges ranges, filter.CalculateRowRanges(predicate, 1));
+    ASSERT_EQ(ranges, RowRanges({{50, 100}}));
+    ASSERT_OK_AND_ASSIGN(std::vector<int32_t> row_groups,
+                         filter.FilterRowGroups(predicate, {0, 1}));
+    ASSERT_EQ(row_groups, std::vector<int32_t>({0, 1}));
+}
+
+TEST_F(PageIndexFilterTest, TestPushDownToBatchReader) {
+    WriteFile(/*enable_page_index=*/true);
+    // row group statistics can not prune row group 0: f1 in ["s00", "s49"]
+    auto predicate = PredicateBuilder::Equal(1, "f1", FieldType::STRING,
+                                             Literal(FieldType::STRING, "s295", 4));
+    {
+        auto batch_reader = CreateBatchReader(/*options=*/{}, predicate);
+        bool need_prefetch = false;
+        ASSERT_OK_AND_ASSIGN(auto read_ranges, batch_reader->GenReadRanges(&need_prefetch));
+        ASSERT_TRUE(read_ranges.empty());
+        ASSERT_OK_AND_ASSIGN(auto result,
+                             paimon::test::ReadResultCollector::CollectResult(batch_reader.get()));
+        ASSERT_FALSE(result);
+    }
+    {
+        std::map<std::string, std::string> options = {
+            {PARQUET_FILTER_COLUMN_INDEX_ENABLED, "false"}};
+        auto batch_reader = CreateBatchReader(options, predicate);
+        bool need_prefetch = false;
+        ASSERT_OK_AND_ASSIGN(auto read_ranges, batch_reader->GenReadRanges(&need_prefetch));
+        ASSERT_EQ(read_ranges, (std::vector<std::pair<uint64_t, uint64_t>>({{0, 50}})));
+        ASSERT_OK_AND_ASSIGN(auto result,
+                             paimon::test::ReadResultCollector::CollectResult(batch_reader.get()));
+        ASSERT_TRUE(result);
+        ASSERT_EQ(result->length(), 50);
+    }
+}
+
+}  // namespace paimon::parquet::test
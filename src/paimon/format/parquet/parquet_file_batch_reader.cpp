@@ -37,6 +37,7 @@
 #include "paimon/common/metrics/metrics_impl.h"
 #include "paimon/common/utils/arrow/status_utils.h"
 #include "paimon/common/utils/options_utils.h"
+#include "paimon/format/parquet/page_index_filter.h"
 #include "paimon/format/parquet/parquet_field_id_converter.h"
 #include "paimon/format/parquet/parquet_format_defs.h"
 #include "paimon/format/parquet/parquet_timestamp_converter.h"
@@ -141,6 +142,7 @@ Status ParquetFileBatchReader::SetReadSchema(
     if (predicate) {
         PAIMON_ASSIGN_OR_RAISE(row_groups,
                                FilterRowGroupsByPredicate(predicate, file_schema, row_groups));
+        PAIMON_ASSIGN_OR_RAISE(row_groups, FilterRowGroupsByPageIndex(predicate, row_groups));
     }
     if (selection_bitmap) {
         PAIMON_ASSIGN_OR_RAISE(row_groups,
@@ -199,6 +201,32 @@ Result<std::vector<int32_t>> ParquetFileBatchReader::FilterRowGroupsByPredicate(
     return target_row_groups;
 }
 
+Result<std::vector<int32_t>> ParquetFileBatchReader::FilterRowGroupsByPageIndex(
+    const std::shared_ptr<Predicate>& predicate, const std::vector<int32_t>& src_row_groups) const {
+    PAIMON_ASSIGN_OR_RAISE(bool column_index_enabled,
+                           OptionsUtils::GetValueFromMap<bool>(
+                               options_, PARQUET_FILTER_COLUMN_INDEX_ENABLED,
+                               DEFAULT_PARQUET_FILTER_COLUMN_INDEX_ENABLED));
+    PAIMON_ASSIGN_OR_RAISE(
+        bool bloom_filter_enabled,
+        OptionsUtils::GetValueFromMap<bool>(options_, PARQUET_FILTER_BLOOM_ENABLED,
+                                            DEFAULT_PARQUET_FILTER_BLOOM_ENABLED));
+    PAIMON_ASSIGN_OR_RAISE(
+        uint32_t predicate_node_count_limit,
+        OptionsUtils::GetValueFromMap<uint32_t>(options_, PARQUET_READ_PREDICATE_NODE_COUNT_LIMIT,
+                                                DEFAULT_PARQUET_READ_PREDICATE_NODE_COUNT_LIMIT));
+    uint32_t predicate_node_count = 0;
+    PredicateConverter::CollectNodeCount(predicate, &predicate_node_count);
+    if ((!column_index_enabled && !bloom_filter_enabled) || src_row_groups.empty() ||
+        predicate_node_count > predicate_node_count_limit) {
+        return src_row_groups;
+    }
+    PageIndexFilter page_index_filter(reader_->GetFileReader()->parquet_reader(),
+                                      reader_->GetAllRowGroupRanges(), column_index_enabled,
+                                      bloom_filter_enabled);
+    return page_index_filter.FilterRowGroups(predicate, src_row_groups);
+}
+
 Result<std::vector<int32_t>> ParquetFileBatchReader::FilterRowGroupsByBitmap(
     const RoaringBitmap32& bitmap, const std::vector<int32_t>& src_row_groups) const {
     if (bitmap.IsEmpty()) {
@@ -249,7 +277,9 @@ Result<BatchReader::ReadBatch> ParquetFileBatchReader::NextBatch() {
 Result<std::vector<std::pair<uint64_t, uint64_t>>> ParquetFileBatchReader::GenReadRanges(
     bool* need_prefetch) const {
     *need_prefetch = true;
-    return reader_->GetAllRowGroupRanges();
+    // row groups pruned by predicate, page index or bitmap are not dispatched to prefetch readers
+    return reader_->GetRowGroupRanges(
+        std::set<int32_t>(read_row_groups_.begin(), read_row_groups_.end()));
 }
 
 Result<::parquet::ReaderProperties> ParquetFileBatchReader::CreateReaderProperties(
@@ -158,6 +158,11 @@ class ParquetFileBatchReader : public PrefetchFileBatchReader {
         const std::shared_ptr<arrow::Schema> file_schema,
         const std::vector<int32_t>& src_row_groups) const;
 
+    // precondition: predicate supposed not be empty
+    Result<std::vector<int32_t>> FilterRowGroupsByPageIndex(
+        const std::shared_ptr<Predicate>& predicate,
+        const std::vector<int32_t>& src_row_groups) const;
+
     Result<std::vector<int32_t>> FilterRowGroupsByBitmap(
         const RoaringBitmap32& bitmap, const std::vector<int32_t>& src_row_groups) const;
 
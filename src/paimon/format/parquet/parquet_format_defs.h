@@ -30,6 +30,9 @@ static inline const char PARQUET_WRITE_MAX_ROW_GROUP_LENGTH[] =
     "parquet.write.max-row-group-length";
 static constexpr int64_t DEFAULT_PARQUET_WRITE_MAX_ROW_GROUP_LENGTH =
     std::numeric_limits<int64_t>::max();
+// Arrow does not write page index (column index and offset index) by default
+static inline const char PARQUET_WRITE_PAGE_INDEX_ENABLED[] = "parquet.write.page-index.enabled";
+static constexpr bool DEFAULT_PARQUET_WRITE_PAGE_INDEX_ENABLED = false;
 static inline const char PARQUET_COMPRESSION_CODEC_ZSTD_LEVEL[] =
     "parquet.compression.codec.zstd.level";
 static inline const char PARQUET_COMPRESSION_CODEC_ZLIB_LEVEL[] = "zlib.compress.level";
@@ -44,6 +47,14 @@ static inline const char PARQUET_READ_CACHE_OPTION_PREFETCH_LIMIT[] =
 static inline const char PARQUET_READ_CACHE_OPTION_RANGE_SIZE_LIMIT[] =
     "parquet.read.cache-option.range-size-limit";
 
+// prune row groups with the column index and offset index of pages, and with bloom filters for
+// EQUAL and IN predicates
+static inline const char PARQUET_FILTER_COLUMN_INDEX_ENABLED[] =
+    "parquet.filter.columnindex.enabled";
+static constexpr bool DEFAULT_PARQUET_FILTER_COLUMN_INDEX_ENABLED = true;
+static inline const char PARQUET_FILTER_BLOOM_ENABLED[] = "parquet.filter.bloom.enabled";
+static constexpr bool DEFAULT_PARQUET_FILTER_BLOOM_ENABLED = true;
+
 // stack-overflow may happen while the number of predicate node is too large, limit the number of
 // predicate nodes. Predicate will not be pushdown when exceed limit.
 static inline const char PARQUET_READ_PREDICATE_NODE_COUNT_LIMIT[] =
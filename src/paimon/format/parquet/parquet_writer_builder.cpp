@@ -90,6 +90,11 @@ Result<std::shared_ptr<::parquet::WriterProperties>> ParquetWriterBuilder::Prepa
         OptionsUtils::GetValueFromMap<int64_t>(options_, PARQUET_DICTIONARY_PAGE_SIZE,
                                                ::parquet::DEFAULT_DICTIONARY_PAGE_SIZE_LIMIT));
     builder.dictionary_pagesize_limit(dictionary_page_size);
+    PAIMON_ASSIGN_OR_RAISE(bool enable_page_index,
+                           OptionsUtils::GetValueFromMap<bool>(
+                               options_, PARQUET_WRITE_PAGE_INDEX_ENABLED,
+                               DEFAULT_PARQUET_WRITE_PAGE_INDEX_ENABLED));
+    enable_page_index ? builder.enable_write_page_index() : builder.disable_write_page_index();
     PAIMON_ASSIGN_OR_RAISE(std::string writer_version,
                            OptionsUtils::GetValueFromMap<std::string>(
                                options_, PARQUET_WRITER_VERSION, std::string("PARQUET_2_0")));
@@ -50,6 +50,7 @@ TEST(ParquetWriterBuilderTest, DefaultPrepareWriterProperties) {
     ASSERT_EQ(1024, properties->write_batch_size());
     ASSERT_EQ(1, properties->default_column_properties().compression_level());
     ASSERT_TRUE(properties->store_decimal_as_integer());
+    ASSERT_FALSE(properties->page_index_enabled());
 }
 
 TEST(ParquetWriterBuilderTest, PrepareWriterProperties) {
@@ -61,6 +62,7 @@ TEST(ParquetWriterBuilderTest, PrepareWriterProperties) {
     options[PARQUET_WRITER_VERSION] = "PARQUET_2_0";
     options[PARQUET_COMPRESSION_CODEC_ZSTD_LEVEL] = "3";
     options[PARQUET_BLOCK_SIZE] = "2048";
+    options[PARQUET_WRITE_PAGE_INDEX_ENABLED] = "true";
     options[Options::FILE_FORMAT] = "parquet";
     options[Options::MANIFEST_FORMAT] = "parquet";
     ParquetWriterBuilder builder(schema, /*batch_size=*/1024 * 1024, options);
@@ -73,6 +75,7 @@ TEST(ParquetWriterBuilderTest, PrepareWriterProperties) {
     ASSERT_EQ(2048, properties->max_row_group_size());
     ASSERT_EQ(1024 * 1024, properties->write_batch_size());
     ASSERT_EQ(3, properties->default_column_properties().compression_level());
+    ASSERT_TRUE(properties->page_index_enabled());
 }
 
 TEST(ParquetWriterBuilderTest, PrepareWriterPropertiesWithZstdLevelPriority) {
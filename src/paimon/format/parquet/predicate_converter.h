@@ -51,12 +51,14 @@ class PredicateConverter {
 
     static arrow::compute::Expression AlwaysTrue();
 
+    // add the number of nodes of predicate to node_count, IN and NOT_IN count one node for each
+    // literal
+    static void CollectNodeCount(const std::shared_ptr<Predicate>& predicate, uint32_t* node_count);
+
  private:
     static Result<arrow::compute::Expression> InnerConvert(
         const std::shared_ptr<Predicate>& predicate);
 
-    static void CollectNodeCount(const std::shared_ptr<Predicate>& predicate, uint32_t* node_count);
-
     static Result<arrow::compute::Expression> ConvertCompound(
         const std::shared_ptr<CompoundPredicate>& compound_predicate);
 
@@ -0,0 +1,114 @@
+/*
+ * Copyright 2024-present Alibaba Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "paimon/fs/local/local_async_reader.h"
+
+#include <algorithm>
+#include <map>
+#include <utility>
+
+namespace paimon {
+
+LocalAsyncReader::LocalAsyncReader(uint32_t thread_count, uint32_t queue_depth)
+    : thread_count_(std::max<uint32_t>(thread_count, 1)),
+      queue_depth_(std::max<uint32_t>(queue_depth, 1)) {}
+
+LocalAsyncReader::~LocalAsyncReader() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stopped_ = true;
+    }
+    cv_.notify_all();
+    for (auto& thread : threads_) {
+        if (thread.joinable()) {
+            thread.join();
+        }
+    }
+}
+
+std::shared_ptr<LocalAsyncReader> LocalAsyncReader::GetDefault() {
+    return GetShared(DEFAULT_THREAD_COUNT, DEFAULT_QUEUE_DEPTH);
+}
+
+std::shared_ptr<LocalAsyncReader> LocalAsyncReader::GetShared(uint32_t thread_count,
+                                                              uint32_t queue_depth) {
+    static std::mutex readers_mutex;
+    static std::map<std::pair<uint32_t, uint32_t>, std::shared_ptr<LocalAsyncReader>> readers;
+    std::pair<uint32_t, uint32_t> key(std::max<uint32_t>(thread_count, 1),
+                                      std::max<uint32_t>(queue_depth, 1));
+    std::lock_guard<std::mutex> lock(readers_mutex);
+    auto& reader = readers[key];
+    if (reader == nullptr) {
+        reader = std::make_shared<LocalAsyncReader>(key.first, key.second);
+    }
+    return reader;
+}
+
+bool LocalAsyncReader::TrySubmit(std::function<void()>& read) {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (stopped_ || pending_ >= queue_depth_) {
+            return false;
+        }
+        if (threads_.empty()) {
+            StartThreads();
+        }
+        ++pending_;
+        queue_.push_back(std::move(read));
+    }
+    cv_.notify_one();
+    return true;
+}
+
+void LocalAsyncReader::StartThreads() {
+    // the threads block on `mutex_` until the caller releases it
+    threads_.reserve(thread_count_);
+    for (uint32_t i = 0; i < thread_count_; ++i) {
+        threads_.emplace_back([this]() { WorkerLoop(); });
+    }
+}
+
+void LocalAsyncReader::WorkerLoop() {
+    std::vector<std::function<void()>> batch;
+    batch.reserve(MAX_BATCH_SIZE);
+    while (true) {
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            cv_.wait(lock, [this]() { return stopped_ || !queue_.empty(); });
+            if (queue_.empty()) {
+                // stopped and drained
+                return;
+            }
+            // leave some reads to the other threads if they are idle
+            size_t batch_size = std::min(
+                MAX_BATCH_SIZE, std::max<size_t>(queue_.size() / thread_count_, 1));
+            for (size_t i = 0; i < batch_size; ++i) {
+                batch.push_back(std::move(queue_.front()));
+                queue_.pop_front();
+            }
+        }
+        for (auto& read : batch) {
+            read();
+        }
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            pending_ -= batch.size();
+        }
+        batch.clear();
+    }
+}
+
+}  // namespace paimon
@@ -0,0 +1,81 @@
+/*
+ * Copyright 2024-present Alibaba Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace paimon {
+
+/// Runs the reads of `LocalInputStream::ReadAsync` on a small pool of I/O threads, so that reads
+/// of local files overlap with decoding on the caller. At most `queue_depth` reads are queued or
+/// running at a time. A read submitted beyond that is rejected and the caller runs it inline, so
+/// a callback issuing further reads never blocks on a full queue. The I/O threads are started by
+/// the first submitted read, so a reader no stream reads asynchronously from costs no threads.
+class LocalAsyncReader {
+ public:
+    static constexpr uint32_t DEFAULT_THREAD_COUNT = 4;
+    static constexpr uint32_t DEFAULT_QUEUE_DEPTH = 64;
+
+    LocalAsyncReader(uint32_t thread_count, uint32_t queue_depth);
+    /// Runs the reads still queued, then joins the I/O threads.
+    ~LocalAsyncReader();
+
+    LocalAsyncReader(const LocalAsyncReader&) = delete;
+    LocalAsyncReader& operator=(const LocalAsyncReader&) = delete;
+
+    /// @return the reader shared by local file systems created without explicit options, with
+    /// `DEFAULT_THREAD_COUNT` threads and `DEFAULT_QUEUE_DEPTH`.
+    static std::shared_ptr<LocalAsyncReader> GetDefault();
+
+    /// @return the reader with `thread_count` threads and `queue_depth` shared by all local file
+    /// systems of the process configured with them.
+    static std::shared_ptr<LocalAsyncReader> GetShared(uint32_t thread_count, uint32_t queue_depth);
+
+    /// @return false if `queue_depth` reads are already pending, `read` is left untouched then.
+    bool TrySubmit(std::function<void()>& read);
+
+    uint32_t GetQueueDepth() const {
+        return queue_depth_;
+    }
+
+ private:
+    // an I/O thread takes up to this many queued reads per wakeup
+    static constexpr size_t MAX_BATCH_SIZE = 8;
+
+    // must be called with `mutex_` held
+    void StartThreads();
+    void WorkerLoop();
+
+    const uint32_t thread_count_;
+    const uint32_t queue_depth_;
+    std::mutex mutex_;
+    std::condition_variable cv_;
+    std::deque<std::function<void()>> queue_;
+    // queued and running reads
+    uint32_t pending_ = 0;
+    bool stopped_ = false;
+    std::vector<std::thread> threads_;
+};
+
+}  // namespace paimon
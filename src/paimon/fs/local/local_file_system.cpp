@@ -52,10 +52,22 @@ Result<std::unique_ptr<InputStream>> LocalFileSystem::Open(const std::string& pa
         return Status::NotExist(fmt::format("File '{}' not exists", path));
     }
     PAIMON_ASSIGN_OR_RAISE(LocalFile file, ToFile(path));
-    PAIMON_ASSIGN_OR_RAISE(std::unique_ptr<LocalInputStream> in, LocalInputStream::Create(file));
+    std::shared_ptr<LocalMappedFile> mapped_file;
+    if (mmap_enabled_ && IsMappable(file.GetAbsolutePath())) {
+        PAIMON_ASSIGN_OR_RAISE(mapped_file, LocalMappedFile::Open(file.GetAbsolutePath()));
+    }
+    PAIMON_ASSIGN_OR_RAISE(std::unique_ptr<LocalInputStream> in,
+                           LocalInputStream::Create(file, async_reader_, mapped_file));
     return in;
 }
 
+bool LocalFileSystem::IsMappable(const std::string& path) {
+    // manifests, manifest lists, index manifests and index files (e.g. deletion vectors) are
+    // never rewritten once committed, data files and snapshot hints are read with pread
+    std::string name = PathUtil::GetName(path);
+    return StringUtils::StartsWith(name, "manifest-") || StringUtils::StartsWith(name, "index-");
+}
+
 Result<std::unique_ptr<OutputStream>> LocalFileSystem::Create(const std::string& path,
                                                               bool overwrite) const {
     PAIMON_ASSIGN_OR_RAISE(bool is_exist, Exists(path));
@@ -232,12 +244,27 @@ Status LocalFileSystem::Rename(const std::string& src, const std::string& dst) c
 }
 
 // input stream
-Result<std::unique_ptr<LocalInputStream>> LocalInputStream::Create(LocalFile& file) {
+Result<std::unique_ptr<LocalInputStream>> LocalInputStream::Create(
+    LocalFile& file, const std::shared_ptr<LocalAsyncReader>& async_reader,
+    const std::shared_ptr<LocalMappedFile>& mapped_file) {
     PAIMON_RETURN_NOT_OK(file.OpenFile(/*is_read_file=*/true));
-    return std::unique_ptr<LocalInputStream>(new LocalInputStream(file));
+    return std::unique_ptr<LocalInputStream>(
+        new LocalInputStream(file, async_reader, mapped_file));
+}
+
+LocalInputStream::LocalInputStream(const LocalFile& file,
+                                   const std::shared_ptr<LocalAsyncReader>& async_reader,
+                                   const std::shared_ptr<LocalMappedFile>& mapped_file)
+    : file_(file), async_reader_(async_reader), mapped_file_(mapped_file) {}
+
+LocalInputStream::~LocalInputStream() {
+    WaitForPendingReads();
 }
 
-LocalInputStream::LocalInputStream(const LocalFile& file) : file_(file) {}
+void LocalInputStream::WaitForPendingReads() {
+    std::unique_lock<std::mutex> lock(pending_reads_mutex_);
+    pending_reads_cv_.wait(lock, [this]() { return pending_reads_ == 0; });
+}
 
 Status LocalInputStream::Seek(int64_t offset, SeekOrigin origin) {
     if (origin != FS_SEEK_SET && origin != FS_SEEK_CUR && origin != FS_SEEK_END) {
@@ -273,6 +300,10 @@ Result<int32_t> LocalInputStream::Read(char* buffer, uint32_t size) {
 }
 
 Result<int32_t> LocalInputStream::Read(char* buffer, uint32_t size, uint64_t offset) {
+    if (mapped_file_) {
+        PAIMON_RETURN_NOT_OK(mapped_file_->Read(buffer, size, offset));
+        return static_cast<int32_t>(size);
+    }
     PAIMON_ASSIGN_OR_RAISE(int32_t read_length, file_.Read(buffer, size, offset));
     if (read_length != static_cast<int32_t>(size)) {
         return Status::IOError(fmt::format("file '{}' read size {} != expected {}",
@@ -283,14 +314,44 @@ Result<int32_t> LocalInputStream::Read(char* buffer, uint32_t size, uint64_t off
 
 void LocalInputStream::ReadAsync(char* buffer, uint32_t size, uint64_t offset,
                                  std::function<void(Status)>&& callback) {
-    Result<int32_t> read_size = Read(buffer, size, offset);
-    Status status = Status::OK();
-    if (!read_size.ok()) {
-        status = read_size.status();
-    } else {
-        assert(read_size.value() == static_cast<int32_t>(size));
+    auto read = [this, buffer, size, offset, callback = std::move(callback)]() {
+        Result<int32_t> read_size = Read(buffer, size, offset);
+        Status status = Status::OK();
+        if (!read_size.ok()) {
+            status = read_size.status();
+        } else {
+            assert(read_size.value() == static_cast<int32_t>(size));
+        }
+        callback(status);
+    };
+    if (async_reader_ == nullptr || mapped_file_) {
+        // a copy from the mapping is not worth a thread switch
+        read();
+        return;
+    }
+    {
+        std::lock_guard<std::mutex> lock(pending_reads_mutex_);
+        ++pending_reads_;
+    }
+    std::function<void()> task = [this, read = std::move(read)]() {
+        read();
+        // notify under the lock, the stream may be destroyed as soon as it is released
+        std::lock_guard<std::mutex> lock(pending_reads_mutex_);
+        if (--pending_reads_ == 0) {
+            pending_reads_cv_.notify_all();
+        }
+    };
+    if (!async_reader_->TrySubmit(task)) {
+        // the queue is full, read on the calling thread instead of waiting for a slot
+        task();
+    }
+}
+
+Result<std::shared_ptr<Bytes>> LocalInputStream::ReadView(uint32_t size, uint64_t offset) {
+    if (mapped_file_ == nullptr) {
+        return std::shared_ptr<Bytes>();
     }
-    callback(status);
+    return mapped_file_->View(size, offset);
 }
 
 Result<uint64_t> LocalInputStream::Length() const {
@@ -298,6 +359,7 @@ Result<uint64_t> LocalInputStream::Length() const {
 }
 
 Status LocalInputStream::Close() {
+    WaitForPendingReads();
     return file_.Close();
 }
 
@@ -17,6 +17,7 @@
 #pragma once
 
 #include <cassert>
+#include <condition_variable>
 #include <cstdint>
 #include <functional>
 #include <memory>
@@ -24,8 +25,11 @@
 #include <string>
 #include <vector>
 
+#include "paimon/common/io/zero_copy_input_stream.h"
 #include "paimon/fs/file_system.h"
+#include "paimon/fs/local/local_async_reader.h"
 #include "paimon/fs/local/local_file.h"
+#include "paimon/fs/local/local_mapped_file.h"
 #include "paimon/result.h"
 #include "paimon/status.h"
 
@@ -34,7 +38,15 @@ namespace paimon {
 // `FileSystem` for local file.
 class LocalFileSystem : public FileSystem {
  public:
-    LocalFileSystem() = default;
+    LocalFileSystem() : LocalFileSystem(LocalAsyncReader::GetDefault()) {}
+    /// @param async_reader runs `ReadAsync` of the opened input streams, null to read
+    /// synchronously on the calling thread.
+    /// @param mmap_enabled whether immutable metadata files are memory mapped when opened, so
+    /// that positional reads copy from the page cache and zero copy views can be handed out, see
+    /// `IsMappable()`. Other files are always read with pread.
+    explicit LocalFileSystem(const std::shared_ptr<LocalAsyncReader>& async_reader,
+                             bool mmap_enabled = false)
+        : async_reader_(async_reader), mmap_enabled_(mmap_enabled) {}
     ~LocalFileSystem() override = default;
 
     Result<std::unique_ptr<InputStream>> Open(const std::string& path) const override;
@@ -57,6 +69,10 @@ class LocalFileSystem : public FileSystem {
     /// the latter returns `false` for `isDirectory` judgement.
     Result<LocalFile> ToFile(const std::string& path) const;
 
+    /// Whether the file at `path` is memory mapped if mmap is enabled: manifest files, manifest
+    /// lists, index manifests and index files such as deletion vectors.
+    static bool IsMappable(const std::string& path);
+
  private:
     // the lock to ensure atomic renaming
     static const std::mutex RENAME_LOCK;
@@ -64,11 +80,20 @@ class LocalFileSystem : public FileSystem {
     Status Delete(const LocalFile& f, bool recursive = true) const;
     std::string GetParentPath(const std::string& path) const;
     Status MkdirsInternal(const LocalFile& file) const;
+
+    std::shared_ptr<LocalAsyncReader> async_reader_;
+    bool mmap_enabled_;
 };
 
-class LocalInputStream : public InputStream {
+class LocalInputStream : public InputStream, public ZeroCopyInputStream {
  public:
-    static Result<std::unique_ptr<LocalInputStream>> Create(LocalFile& file);
+    /// @param mapped_file the mapping of `file` positional reads are served from, may be null.
+    static Result<std::unique_ptr<LocalInputStream>> Create(
+        LocalFile& file, const std::shared_ptr<LocalAsyncReader>& async_reader,
+        const std::shared_ptr<LocalMappedFile>& mapped_file);
+
+    /// Waits for the pending async reads.
+    ~LocalInputStream() override;
 
     Status Seek(int64_t offset, SeekOrigin origin) override;
     Result<int64_t> GetPos() const override;
@@ -76,6 +101,7 @@ class LocalInputStream : public InputStream {
     Result<int32_t> Read(char* buffer, uint32_t size, uint64_t offset) override;
     void ReadAsync(char* buffer, uint32_t size, uint64_t offset,
                    std::function<void(Status)>&& callback) override;
+    Result<std::shared_ptr<Bytes>> ReadView(uint32_t size, uint64_t offset) override;
 
     Status Close() override;
     Result<std::string> GetUri() const override {
@@ -84,9 +110,17 @@ class LocalInputStream : public InputStream {
     Result<uint64_t> Length() const override;
 
  private:
-    explicit LocalInputStream(const LocalFile& file);
+    LocalInputStream(const LocalFile& file, const std::shared_ptr<LocalAsyncReader>& async_reader,
+                     const std::shared_ptr<LocalMappedFile>& mapped_file);
+
+    void WaitForPendingReads();
 
     LocalFile file_;
+    std::shared_ptr<LocalAsyncReader> async_reader_;
+    std::shared_ptr<LocalMappedFile> mapped_file_;
+    std::mutex pending_reads_mutex_;
+    std::condition_variable pending_reads_cv_;
+    int64_t pending_reads_ = 0;
 };
 
 class LocalOutputStream : public OutputStream {
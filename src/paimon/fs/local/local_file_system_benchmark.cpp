@@ -0,0 +1,81 @@
+/*
+ * Copyright 2024-present Alibaba Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <future>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "paimon/fs/local/local_async_reader.h"
+#include "paimon/fs/local/local_file_system.h"
+#include "paimon/testing/utils/testharness.h"
+
+namespace paimon::test {
+// Reports the time of reading a file in chunks and decoding every chunk on the caller, with
+// synchronous reads and with reads on I/O threads overlapping the decode.
+TEST(LocalFileSystemBenchmark, AsyncReadThroughput) {
+    auto dir = UniqueTestDirectory::Create();
+    ASSERT_TRUE(dir);
+    LocalFileSystem sync_fs(/*async_reader=*/nullptr);
+    std::string path = dir->Str() + "/file.data";
+    constexpr uint32_t kChunkSize = 256 * 1024;
+    constexpr uint32_t kChunkCount = 64;
+    std::string content(kChunkCount * kChunkSize, '\0');
+    for (size_t i = 0; i < content.size(); ++i) {
+        content[i] = static_cast<char>('a' + i % 26);
+    }
+    ASSERT_OK(sync_fs.WriteFile(path, content, /*overwrite=*/true));
+
+    for (uint32_t thread_count : {0, 1, 4}) {
+        LocalFileSystem fs(thread_count == 0
+                               ? nullptr
+                               : std::make_shared<LocalAsyncReader>(
+                                     thread_count, LocalAsyncReader::DEFAULT_QUEUE_DEPTH));
+        ASSERT_OK_AND_ASSIGN(auto in, fs.Open(path));
+        std::string read_content(content.size(), '\0');
+        auto start = std::chrono::steady_clock::now();
+        std::vector<std::future<Status>> futures;
+        for (uint32_t i = 0; i < kChunkCount; ++i) {
+            auto promise = std::make_shared<std::promise<Status>>();
+            futures.push_back(promise->get_future());
+            in->ReadAsync(read_content.data() + i * kChunkSize, kChunkSize,
+                          static_cast<uint64_t>(i) * kChunkSize,
+                          [promise](Status status) { promise->set_value(status); });
+        }
+        uint64_t checksum = 0;
+        for (uint32_t i = 0; i < kChunkCount; ++i) {
+            ASSERT_OK(futures[i].get());
+            for (uint32_t j = 0; j < kChunkSize; ++j) {
+                checksum = checksum * 31 + read_content[i * kChunkSize + j];
+            }
+        }
+        auto elapsed = std::chrono::duration_cast<std::chrono::microseconds>(
+                           std::chrono::steady_clock::now() - start)
+                           .count();
+        ASSERT_OK(in->Close());
+        ASSERT_EQ(content, read_content);
+        std::cout << "io threads " << thread_count << ": " << elapsed << " us, "
+                  << content.size() / std::max<int64_t>(elapsed, 1) << " MB/s, checksum "
+                  << checksum << std::endl;
+    }
+}
+
+}  // namespace paimon::test
@@ -16,11 +16,47 @@
 
 #include "paimon/fs/local/local_file_system_factory.h"
 
+#include "fmt/format.h"
+#include "paimon/common/utils/options_utils.h"
 #include "paimon/factories/factory.h"
+#include "paimon/status.h"
 
 namespace paimon {
 
 const char LocalFileSystemFactory::IDENTIFIER[] = "local";
+const char LocalFileSystemFactory::ASYNC_READ_THREAD_COUNT[] = "fs.local.async-read.thread-count";
+const char LocalFileSystemFactory::ASYNC_READ_QUEUE_DEPTH[] = "fs.local.async-read.queue-depth";
+const char LocalFileSystemFactory::MMAP_ENABLED[] = "fs.local.mmap.enabled";
+
+Result<std::unique_ptr<FileSystem>> LocalFileSystemFactory::Create(
+    const std::string& path, const std::map<std::string, std::string>& options) const {
+    PAIMON_ASSIGN_OR_RAISE(bool mmap_enabled,
+                           OptionsUtils::GetValueFromMap<bool>(options, MMAP_ENABLED, false));
+    if (options.find(ASYNC_READ_THREAD_COUNT) == options.end() &&
+        options.find(ASYNC_READ_QUEUE_DEPTH) == options.end()) {
+        return std::make_unique<LocalFileSystem>(LocalAsyncReader::GetDefault(), mmap_enabled);
+    }
+    PAIMON_ASSIGN_OR_RAISE(
+        int32_t thread_count,
+        OptionsUtils::GetValueFromMap<int32_t>(options, ASYNC_READ_THREAD_COUNT,
+                                               LocalAsyncReader::DEFAULT_THREAD_COUNT));
+    PAIMON_ASSIGN_OR_RAISE(
+        int32_t queue_depth,
+        OptionsUtils::GetValueFromMap<int32_t>(options, ASYNC_READ_QUEUE_DEPTH,
+                                               LocalAsyncReader::DEFAULT_QUEUE_DEPTH));
+    if (thread_count < 0 || queue_depth <= 0) {
+        return Status::Invalid(fmt::format("invalid {} {} or {} {} for local file system",
+                                           ASYNC_READ_THREAD_COUNT, thread_count,
+                                           ASYNC_READ_QUEUE_DEPTH, queue_depth));
+    }
+    if (thread_count == 0) {
+        return std::make_unique<LocalFileSystem>(/*async_reader=*/nullptr, mmap_enabled);
+    }
+    return std::make_unique<LocalFileSystem>(
+        LocalAsyncReader::GetShared(static_cast<uint32_t>(thread_count),
+                                    static_cast<uint32_t>(queue_depth)),
+        mmap_enabled);
+}
 
 REGISTER_PAIMON_FACTORY(LocalFileSystemFactory);
 
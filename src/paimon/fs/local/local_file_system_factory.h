@@ -31,15 +31,22 @@ class FileSystem;
 class LocalFileSystemFactory : public FileSystemFactory {
  public:
     static const char IDENTIFIER[];
+    /// Number of I/O threads running `ReadAsync` of local input streams, 0 to read synchronously
+    /// on the calling thread. File systems with the same thread count and queue depth share their
+    /// I/O threads, which are only started by the first async read.
+    static const char ASYNC_READ_THREAD_COUNT[];
+    /// Maximum number of queued and running async reads, further reads run on the calling thread.
+    static const char ASYNC_READ_QUEUE_DEPTH[];
+    /// Whether opened manifest and index files (e.g. deletion vectors) are memory mapped, false
+    /// by default. These files are immutable, all other files are read with pread.
+    static const char MMAP_ENABLED[];
 
     const char* Identifier() const override {
         return IDENTIFIER;
     }
 
     Result<std::unique_ptr<FileSystem>> Create(
-        const std::string& path, const std::map<std::string, std::string>& options) const override {
-        return std::make_unique<LocalFileSystem>();
-    }
+        const std::string& path, const std::map<std::string, std::string>& options) const override;
 };
 
 }  // namespace paimon
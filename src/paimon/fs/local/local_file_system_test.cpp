@@ -0,0 +1,303 @@
+/*
+ * Copyright 2024-present Alibaba Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "paimon/fs/local/local_file_system.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <future>
+#include <map>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "paimon/common/io/zero_copy_input_stream.h"
+#include "paimon/fs/local/local_async_reader.h"
+#include "paimon/fs/local/local_file_system_factory.h"
+#include "paimon/testing/utils/testharness.h"
+
+namespace paimon::test {
+namespace {
+std::string WriteTestFile(FileSystem* fs, const std::string& path, size_t length) {
+    std::string content(length, '\0');
+    for (size_t i = 0; i < length; ++i) {
+        content[i] = static_cast<char>('a' + i % 26);
+    }
+    EXPECT_OK(fs->WriteFile(path, content, /*overwrite=*/true));
+    return content;
+}
+
+// issues all chunks with ReadAsync and waits for them, returns the first error
+Status ReadChunks(InputStream* in, char* buffer, uint64_t length, uint32_t chunk_size,
+                  const std::function<void(uint64_t)>& on_chunk = nullptr) {
+    std::vector<std::future<Status>> futures;
+    for (uint64_t offset = 0; offset < length; offset += chunk_size) {
+        auto size = static_cast<uint32_t>(std::min<uint64_t>(chunk_size, length - offset));
+        auto promise = std::make_shared<std::promise<Status>>();
+        futures.push_back(promise->get_future());
+        in->ReadAsync(buffer + offset, size, offset, [promise, on_chunk, offset](Status status) {
+            if (on_chunk) {
+                on_chunk(offset);
+            }
+            promise->set_value(status);
+        });
+    }
+    Status result = Status::OK();
+    for (auto& future : futures) {
+        Status status = future.get();
+        if (result.ok() && !status.ok()) {
+            result = status;
+        }
+    }
+    return result;
+}
+}  // namespace
+
+TEST(LocalFileSystemTest, TestAsyncReadOnIOThreads) {
+    auto dir = UniqueTestDirectory::Create();
+    ASSERT_TRUE(dir);
+    LocalFileSystem fs(std::make_shared<LocalAsyncReader>(/*thread_count=*/2,
+                                                          /*queue_depth=*/4));
+    std::string path = dir->Str() + "/file.data";
+    std::string content = WriteTestFile(&fs, path, 100 * 1024 + 17);
+
+    ASSERT_OK_AND_ASSIGN(auto in, fs.Open(path));
+    std::string read_content(content.size(), '\0');
+    auto caller = std::this_thread::get_id();
+    std::atomic<int32_t> async_chunks = 0;
+    ASSERT_OK(ReadChunks(in.get(), read_content.data(), content.size(), /*chunk_size=*/1024,
+                         [&](uint64_t) {
+                             if (std::this_thread::get_id() != caller) {
+                                 ++async_chunks;
+                             }
+                         }));
+    ASSERT_EQ(content, read_content);
+    // reads beyond the queue depth run on the caller, the others on the I/O threads
+    ASSERT_GT(async_chunks.load(), 0);
+    ASSERT_OK(in->Close());
+}
+
+TEST(LocalFileSystemTest, TestAsyncReadInCallback) {
+    auto dir = UniqueTestDirectory::Create();
+    ASSERT_TRUE(dir);
+    LocalFileSystem fs(std::make_shared<LocalAsyncReader>(/*thread_count=*/1,
+                                                          /*queue_depth=*/1));
+    std::string path = dir->Str() + "/file.data";
+    std::string content = WriteTestFile(&fs, path, 64);
+
+    // a callback issuing the next read must not block on the full queue
+    ASSERT_OK_AND_ASSIGN(auto in, fs.Open(path));
+    std::string read_content(content.size(), '\0');
+    std::promise<Status> promise;
+    std::function<void(uint64_t)> read_next = [&](uint64_t offset) {
+        in->ReadAsync(read_content.data() + offset, 8, offset, [&, offset](Status status) {
+            if (!status.ok() || offset + 8 == content.size()) {
+                promise.set_value(status);
+                return;
+            }
+            read_next(offset + 8);
+        });
+    };
+    read_next(0);
+    ASSERT_OK(promise.get_future().get());
+    ASSERT_EQ(content, read_content);
+    ASSERT_OK(in->Close());
+}
+
+TEST(LocalFileSystemTest, TestCloseWaitsForPendingReads) {
+    auto dir = UniqueTestDirectory::Create();
+    ASSERT_TRUE(dir);
+    LocalFileSystem fs(std::make_shared<LocalAsyncReader>(/*thread_count=*/4,
+                                                          /*queue_depth=*/64));
+    std::string path = dir->Str() + "/file.data";
+    std::string content = WriteTestFile(&fs, path, 64 * 1024);
+
+    std::string read_content(content.size(), '\0');
+    std::atomic<int32_t> finished = 0;
+    int32_t chunk_count = 0;
+    {
+        ASSERT_OK_AND_ASSIGN(auto in, fs.Open(path));
+        for (uint64_t offset = 0; offset < content.size(); offset += 1024) {
+            ++chunk_count;
+            in->ReadAsync(read_content.data() + offset, 1024, offset, [&](Status status) {
+                EXPECT_OK(status);
+                ++finished;
+            });
+        }
+        ASSERT_OK(in->Close());
+        ASSERT_EQ(chunk_count, finished.load());
+    }
+    ASSERT_EQ(content, read_content);
+}
+
+TEST(LocalFileSystemTest, TestAsyncReaderStartsThreadsLazily) {
+    auto dir = UniqueTestDirectory::Create();
+    ASSERT_TRUE(dir);
+    auto async_reader = std::make_shared<LocalAsyncReader>(/*thread_count=*/2, /*queue_depth=*/4);
+    LocalFileSystem fs(async_reader);
+    std::string path = dir->Str() + "/file.data";
+    std::string content = WriteTestFile(&fs, path, 4096);
+
+    // synchronous reads never start the I/O threads
+    ASSERT_OK_AND_ASSIGN(auto in, fs.Open(path));
+    std::string read_content(content.size(), '\0');
+    ASSERT_OK(in->Read(read_content.data(), read_content.size(), /*offset=*/0));
+    ASSERT_TRUE(async_reader->threads_.empty());
+
+    ASSERT_OK(ReadChunks(in.get(), read_content.data(), content.size(), /*chunk_size=*/1024));
+    ASSERT_EQ(content, read_content);
+    ASSERT_EQ(2, async_reader->threads_.size());
+    ASSERT_OK(in->Close());
+}
+
+TEST(LocalFileSystemTest, TestFactoryOptions) {
+    LocalFileSystemFactory factory;
+    ASSERT_OK(factory.Create("/tmp", {}));
+    ASSERT_OK(factory.Create("/tmp", {{LocalFileSystemFactory::ASYNC_READ_THREAD_COUNT, "0"}}));
+    ASSERT_OK(factory.Create("/tmp", {{LocalFileSystemFactory::ASYNC_READ_THREAD_COUNT, "2"},
+                                      {LocalFileSystemFactory::ASYNC_READ_QUEUE_DEPTH, "16"}}));
+    ASSERT_NOK(factory.Create("/tmp", {{LocalFileSystemFactory::ASYNC_READ_THREAD_COUNT, "-1"}}));
+    ASSERT_NOK(factory.Create("/tmp", {{LocalFileSystemFactory::ASYNC_READ_QUEUE_DEPTH, "0"}}));
+    ASSERT_NOK(factory.Create("/tmp", {{LocalFileSystemFactory::ASYNC_READ_QUEUE_DEPTH, "x"}}));
+
+    // file systems with the same async read options share the I/O threads
+    auto get_async_reader = [](const std::unique_ptr<FileSystem>& fs) {
+        auto local_fs = dynamic_cast<LocalFileSystem*>(fs.get());
+        EXPECT_TRUE(local_fs);
+        return local_fs ? local_fs->async_reader_ : nullptr;
+    };
+    std::map<std::string, std::string> options = {
+        {LocalFileSystemFactory::ASYNC_READ_THREAD_COUNT, "3"},
+        {LocalFileSystemFactory::ASYNC_READ_QUEUE_DEPTH, "7"}};
+    ASSERT_OK_AND_ASSIGN(auto fs1, factory.Create("/tmp", options));
+    ASSERT_OK_AND_ASSIGN(auto fs2, factory.Create("/tmp", options));
+    ASSERT_OK_AND_ASSIGN(
+        auto fs3,
+        factory.Create("/tmp", {{LocalFileSystemFactory::ASYNC_READ_THREAD_COUNT, "3"}}));
+    ASSERT_OK_AND_ASSIGN(auto default_fs, factory.Create("/tmp", {}));
+    ASSERT_TRUE(get_async_reader(fs1));
+    ASSERT_EQ(get_async_reader(fs1), get_async_reader(fs2));
+    ASSERT_NE(get_async_reader(fs1), get_async_reader(fs3));
+    ASSERT_EQ(LocalAsyncReader::GetDefault(), get_async_reader(default_fs));
+
+    // with 0 threads the callback runs inline
+    auto dir = UniqueTestDirectory::Create();
+    ASSERT_TRUE(dir);
+    ASSERT_OK_AND_ASSIGN(
+        auto fs,
+        factory.Create(dir->Str(), {{LocalFileSystemFactory::ASYNC_READ_THREAD_COUNT, "0"}}));
+    std::string path = dir->Str() + "/file.data";
+    std::string content = WriteTestFile(fs.get(), path, 32);
+    ASSERT_OK_AND_ASSIGN(auto in, fs->Open(path));
+    std::string read_content(content.size(), '\0');
+    bool called = false;
+    in->ReadAsync(read_content.data(), read_content.size(), /*offset=*/0, [&](Status status) {
+        EXPECT_OK(status);
+        called = true;
+    });
+    ASSERT_TRUE(called);
+    ASSERT_EQ(content, read_content);
+    ASSERT_OK(in->Close());
+}
+
+TEST(LocalFileSystemTest, TestMmapRead) {
+    auto dir = UniqueTestDirectory::Create();
+    ASSERT_TRUE(dir);
+    LocalFileSystem fs(/*async_reader=*/nullptr, /*mmap_enabled=*/true);
+    std::string path = dir->Str() + "/manifest/manifest-list-4e7c0b5a-0";
+    std::string content = WriteTestFile(&fs, path, 4096 + 5);
+
+    std::shared_ptr<Bytes> view;
+    {
+        ASSERT_OK_AND_ASSIGN(auto in, fs.Open(path));
+        std::string read_content(100, '\0');
+        ASSERT_OK_AND_ASSIGN(int32_t read_size,
+                             in->Read(read_content.data(), read_content.size(), /*offset=*/4000));
+        ASSERT_EQ(100, read_size);
+        ASSERT_EQ(content.substr(4000, 100), read_content);
+        ASSERT_NOK(in->Read(read_content.data(), read_content.size(), /*offset=*/4050));
+
+        // sequential reads are not affected by the mapping
+        ASSERT_OK(in->Seek(10, FS_SEEK_SET));
+        ASSERT_OK(in->Read(read_content.data(), 10));
+        ASSERT_EQ(content.substr(10, 10), read_content.substr(0, 10));
+
+        auto* zero_copy_in = ZeroCopyInputStream::From(in.get());
+        ASSERT_TRUE(zero_copy_in);
+        ASSERT_OK_AND_ASSIGN(view, zero_copy_in->ReadView(/*size=*/64, /*offset=*/4041));
+        ASSERT_TRUE(view);
+        ASSERT_NOK(zero_copy_in->ReadView(/*size=*/65, /*offset=*/4041));
+
+        // streams of the same file share the mapping
+        ASSERT_OK_AND_ASSIGN(auto in2, fs.Open(path));
+        ASSERT_OK_AND_ASSIGN(std::shared_ptr<Bytes> view2,
+                             ZeroCopyInputStream::From(in2.get())->ReadView(64, 4041));
+        ASSERT_EQ(view->data(), view2->data());
+        ASSERT_OK(in2->Close());
+        ASSERT_OK(in->Close());
+    }
+    // the view pins the mapping after the streams are closed
+    ASSERT_EQ(content.substr(4041, 64), std::string(view->data(), view->size()));
+}
+
+TEST(LocalFileSystemTest, TestMmapDisabled) {
+    auto dir = UniqueTestDirectory::Create();
+    ASSERT_TRUE(dir);
+    LocalFileSystem fs(/*async_reader=*/nullptr);
+    std::string path = dir->Str() + "/file.data";
+    WriteTestFile(&fs, path, 16);
+    ASSERT_OK_AND_ASSIGN(auto in, fs.Open(path));
+    ASSERT_OK_AND_ASSIGN(std::shared_ptr<Bytes> view,
+                         ZeroCopyInputStream::From(in.get())->ReadView(8, 0));
+    ASSERT_FALSE(view);
+
+    // empty files cannot be mapped and are read as usual
+    LocalFileSystem mmap_fs(/*async_reader=*/nullptr, /*mmap_enabled=*/true);
+    std::string empty_path = dir->Str() + "/index/index-empty-0";
+    WriteTestFile(&mmap_fs, empty_path, 0);
+    ASSERT_OK_AND_ASSIGN(auto empty_in, mmap_fs.Open(empty_path));
+    ASSERT_OK_AND_ASSIGN(view, ZeroCopyInputStream::From(empty_in.get())->ReadView(0, 0));
+    ASSERT_FALSE(view);
+
+    // only immutable manifest and index files are mapped, other files are read with pread
+    ASSERT_TRUE(LocalFileSystem::IsMappable(dir->Str() + "/manifest/manifest-4e7c0b5a-0"));
+    ASSERT_TRUE(LocalFileSystem::IsMappable(dir->Str() + "/manifest/index-manifest-4e7c0b5a-0"));
+    ASSERT_TRUE(LocalFileSystem::IsMappable(dir->Str() + "/index/index-4e7c0b5a-0"));
+    ASSERT_FALSE(LocalFileSystem::IsMappable(dir->Str() + "/bucket-0/data-4e7c0b5a-0.orc"));
+    ASSERT_FALSE(LocalFileSystem::IsMappable(dir->Str() + "/snapshot/LATEST"));
+    ASSERT_FALSE(
+        LocalFileSystem::IsMappable(dir->Str() + "/manifest/.manifest-4e7c0b5a-0.uuid.tmp"));
+    std::string data_path = dir->Str() + "/bucket-0/data-4e7c0b5a-0.orc";
+    std::string content = WriteTestFile(&mmap_fs, data_path, 16);
+    ASSERT_OK_AND_ASSIGN(auto data_in, mmap_fs.Open(data_path));
+    ASSERT_OK_AND_ASSIGN(view, ZeroCopyInputStream::From(data_in.get())->ReadView(8, 0));
+    ASSERT_FALSE(view);
+    std::string read_content(8, '\0');
+    ASSERT_OK_AND_ASSIGN(int32_t read_size,
+                         data_in->Read(read_content.data(), read_content.size(), /*offset=*/4));
+    ASSERT_EQ(8, read_size);
+    ASSERT_EQ(content.substr(4, 8), read_content);
+
+    LocalFileSystemFactory factory;
+    ASSERT_OK(factory.Create(dir->Str(), {{LocalFileSystemFactory::MMAP_ENABLED, "true"}}));
+    ASSERT_NOK(factory.Create(dir->Str(), {{LocalFileSystemFactory::MMAP_ENABLED, "yes?"}}));
+}
+
+}  // namespace paimon::test
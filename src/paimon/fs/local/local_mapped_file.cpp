@@ -0,0 +1,158 @@
+/*
+ * Copyright 2024-present Alibaba Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "paimon/fs/local/local_mapped_file.h"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <cstring>
+#include <map>
+#include <mutex>
+#include <tuple>
+#include <utility>
+
+#include "fmt/format.h"
+#include "paimon/memory/memory_pool.h"
+
+namespace paimon {
+namespace {
+// Views do not own the mapped memory, returning it to this pool does nothing.
+class MappedMemoryPool : public MemoryPool {
+ public:
+    void* Malloc(uint64_t size, uint64_t alignment) override {
+        return nullptr;
+    }
+    void* Realloc(void* p, size_t old_size, size_t new_size, uint64_t alignment) override {
+        return nullptr;
+    }
+    void Free(void* p, uint64_t size) override {}
+    uint64_t CurrentUsage() const override {
+        return 0;
+    }
+    uint64_t MaxMemoryUsage() const override {
+        return 0;
+    }
+};
+
+MappedMemoryPool* GetMappedMemoryPool() {
+    static MappedMemoryPool pool;
+    return &pool;
+}
+
+struct MappingKey {
+    std::string path;
+    uint64_t length;
+    int64_t mtime_sec;
+    int64_t mtime_nsec;
+
+    bool operator<(const MappingKey& other) const {
+        return std::tie(path, length, mtime_sec, mtime_nsec) <
+               std::tie(other.path, other.length, other.mtime_sec, other.mtime_nsec);
+    }
+};
+
+// live mappings shared by the streams opening the same file
+std::mutex& GetRegistryMutex() {
+    static std::mutex mutex;
+    return mutex;
+}
+
+std::map<MappingKey, std::weak_ptr<LocalMappedFile>>& GetRegistry() {
+    static std::map<MappingKey, std::weak_ptr<LocalMappedFile>> registry;
+    return registry;
+}
+}  // namespace
+
+Result<std::shared_ptr<LocalMappedFile>> LocalMappedFile::Open(const std::string& path) {
+    int32_t fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd == -1) {
+        return Status::IOError(
+            fmt::format("open file '{}' for mmap fail, ec: {}", path, std::strerror(errno)));
+    }
+    struct stat st;
+    if (::fstat(fd, &st) != 0) {
+        int32_t cur_errno = errno;
+        ::close(fd);
+        return Status::IOError(
+            fmt::format("stat file '{}' for mmap fail, ec: {}", path, std::strerror(cur_errno)));
+    }
+    auto length = static_cast<uint64_t>(st.st_size);
+    if (length == 0) {
+        ::close(fd);
+        return std::shared_ptr<LocalMappedFile>();
+    }
+    MappingKey key{path, length, static_cast<int64_t>(st.st_mtim.tv_sec),
+                   static_cast<int64_t>(st.st_mtim.tv_nsec)};
+    std::lock_guard<std::mutex> lock(GetRegistryMutex());
+    auto& registry = GetRegistry();
+    auto iter = registry.find(key);
+    if (iter != registry.end()) {
+        if (auto mapped_file = iter->second.lock()) {
+            ::close(fd);
+            return mapped_file;
+        }
+    }
+    void* data = ::mmap(nullptr, length, PROT_READ, MAP_SHARED, fd, 0);
+    int32_t cur_errno = errno;
+    // the mapping stays valid after the descriptor is closed
+    ::close(fd);
+    if (data == MAP_FAILED) {
+        return Status::IOError(
+            fmt::format("mmap file '{}' fail, ec: {}", path, std::strerror(cur_errno)));
+    }
+    std::shared_ptr<LocalMappedFile> mapped_file(
+        new LocalMappedFile(path, static_cast<char*>(data), length));
+    // drop the entries of released mappings while holding the lock anyway
+    for (auto it = registry.begin(); it != registry.end();) {
+        it = it->second.expired() ? registry.erase(it) : std::next(it);
+    }
+    registry[key] = mapped_file;
+    return mapped_file;
+}
+
+LocalMappedFile::LocalMappedFile(const std::string& path, char* data, uint64_t length)
+    : path_(path), data_(data), length_(length) {}
+
+LocalMappedFile::~LocalMappedFile() {
+    ::munmap(data_, length_);
+}
+
+Status LocalMappedFile::CheckRange(uint32_t size, uint64_t offset) const {
+    if (offset > length_ || size > length_ - offset) {
+        return Status::IOError(fmt::format("file '{}' read size {} at offset {} exceeds length {}",
+                                           path_, size, offset, length_));
+    }
+    return Status::OK();
+}
+
+Status LocalMappedFile::Read(char* buffer, uint32_t size, uint64_t offset) const {
+    PAIMON_RETURN_NOT_OK(CheckRange(size, offset));
+    std::memcpy(buffer, data_ + offset, size);
+    return Status::OK();
+}
+
+Result<std::shared_ptr<Bytes>> LocalMappedFile::View(uint32_t size, uint64_t offset) {
+    PAIMON_RETURN_NOT_OK(CheckRange(size, offset));
+    auto self = shared_from_this();
+    return std::shared_ptr<Bytes>(new Bytes(data_ + offset, size, GetMappedMemoryPool()),
+                                  [self](Bytes* bytes) { delete bytes; });
+}
+
+}  // namespace paimon
@@ -0,0 +1,63 @@
+/*
+ * Copyright 2024-present Alibaba Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <string>
+
+#include "paimon/memory/bytes.h"
+#include "paimon/result.h"
+#include "paimon/status.h"
+
+namespace paimon {
+
+/// A read-only memory mapping of a whole local file. Input streams opening the same unchanged
+/// file share one mapping, and views handed out by `View()` pin it until they are released, so
+/// reads of immutable files become page cache hits without copies or pool allocations.
+class LocalMappedFile : public std::enable_shared_from_this<LocalMappedFile> {
+ public:
+    /// @return the mapping of `path`, shared with live mappings of the file if its length and
+    /// modification time did not change; nullptr for an empty file, which cannot be mapped.
+    static Result<std::shared_ptr<LocalMappedFile>> Open(const std::string& path);
+
+    ~LocalMappedFile();
+
+    LocalMappedFile(const LocalMappedFile&) = delete;
+    LocalMappedFile& operator=(const LocalMappedFile&) = delete;
+
+    uint64_t Length() const {
+        return length_;
+    }
+
+    /// Copies `size` bytes at `offset` into `buffer`.
+    Status Read(char* buffer, uint32_t size, uint64_t offset) const;
+
+    /// @return a view of `size` bytes at `offset` pinning this mapping.
+    Result<std::shared_ptr<Bytes>> View(uint32_t size, uint64_t offset);
+
+ private:
+    LocalMappedFile(const std::string& path, char* data, uint64_t length);
+
+    Status CheckRange(uint32_t size, uint64_t offset) const;
+
+    const std::string path_;
+    char* const data_;
+    const uint64_t length_;
+};
+
+}  // namespace paimon
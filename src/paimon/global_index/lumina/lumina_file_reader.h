@@ -17,6 +17,7 @@
 #pragma once
 
 #include <algorithm>
+#include <functional>
 #include <limits>
 #include <memory>
 #include <utility>
@@ -90,9 +91,12 @@ class LuminaFileReader : public ::lumina::io::FileReader {
         auto ctx = std::make_shared<ReadContext>(
             ReadContext{data, size, offset, std::move(call_back), in_});
 
-        // recursive lambda to read next chunk
-        std::function<void()> read_next;
-        read_next = [ctx, max_read_size = max_read_size_, &read_next]() {
+        // recursive lambda to read next chunk, the callback of a pending read keeps it alive as
+        // the read may complete after ReadAsync() returns, the lambda only refers to itself
+        // weakly to avoid a reference cycle
+        auto read_next = std::make_shared<std::function<void()>>();
+        std::weak_ptr<std::function<void()>> weak_read_next = read_next;
+        *read_next = [ctx, max_read_size = max_read_size_, weak_read_next]() {
             if (ctx->remaining == 0) {
                 // all done
                 ctx->final_call_back(::lumina::core::Status::Ok());
@@ -104,8 +108,9 @@ class LuminaFileReader : public ::lumina::io::FileReader {
             auto safe_size = static_cast<int32_t>(chunk_size);
 
             // issue async read for this chunk
+            std::shared_ptr<std::function<void()>> self = weak_read_next.lock();
             ctx->in->ReadAsync(ctx->current_data, safe_size, ctx->current_offset,
-                               [ctx, safe_size, read_next](const Status& status) {
+                               [ctx, safe_size, self](const Status& status) {
                                    if (!status.ok()) {
                                        // propagate error immediately
                                        ctx->final_call_back(PaimonToLuminaStatus(status));
@@ -117,12 +122,12 @@ class LuminaFileReader : public ::lumina::io::FileReader {
                                    ctx->remaining -= safe_size;
 
                                    // continue with next chunk
-                                   read_next();
+                                   (*self)();
                                });
         };
 
         // start the first read
-        read_next();
+        (*read_next)();
     }
 
     ::lumina::core::Status Close() noexcept override {